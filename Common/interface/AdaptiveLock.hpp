@@ -0,0 +1,387 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of ThreadingTools::AdaptiveLock and ThreadingTools::AdaptiveRWLock classes
+
+#include <atomic>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#    include <immintrin.h>
+#endif
+
+namespace ThreadingTools
+{
+
+/// Lock contention statistics
+struct LockContentionStats
+{
+    /// The total number of times the lock was acquired.
+    Diligent::Uint64 NumAcquisitions = 0;
+
+    /// The total number of spin iterations performed while waiting for the lock.
+    Diligent::Uint64 NumSpins = 0;
+
+    /// The total number of times a thread was parked by the OS while waiting for the lock.
+    Diligent::Uint64 NumParks = 0;
+};
+
+
+/// Helper class that implements exponential backoff for spin loops.
+class SpinBackoff
+{
+public:
+    /// Maximum number of pause instructions executed in a single Pause() call.
+    static constexpr Diligent::Uint32 MaxPauseCount = 64;
+
+    /// Executes the current number of pause instructions and doubles it.
+    void Pause() noexcept
+    {
+        for (Diligent::Uint32 i = 0; i < m_PauseCount; ++i)
+            CpuPause();
+        if (m_PauseCount < MaxPauseCount)
+            m_PauseCount *= 2;
+    }
+
+    /// Hints the processor that the thread is in a spin-wait loop.
+    static void CpuPause() noexcept
+    {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        _mm_pause();
+#elif (defined(__arm__) || defined(__aarch64__)) && (defined(__GNUC__) || defined(__clang__))
+        __asm__ __volatile__("yield");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+private:
+    Diligent::Uint32 m_PauseCount = 1;
+};
+
+
+/// Parks the calling thread while the value at the given address is equal to ExpectedValue.
+/// The function may return spuriously, so the caller must re-check the condition.
+/// On Linux and Android the function uses futexes; on other platforms it falls back to
+/// a hashed table of condition variables.
+void ParkThread(std::atomic<Diligent::Uint32>& Address, Diligent::Uint32 ExpectedValue) noexcept;
+
+/// Wakes all threads parked on the given address.
+void UnparkThreads(std::atomic<Diligent::Uint32>& Address) noexcept;
+
+/// Wakes at most one thread parked on the given address.
+void UnparkOneThread(std::atomic<Diligent::Uint32>& Address) noexcept;
+
+
+/// Adaptive mutual exclusion lock.
+
+/// The lock first tries to acquire the flag by spinning with an exponential backoff
+/// and the processor pause instruction, and after the spin budget is exhausted parks the
+/// thread in the OS until the owner releases the lock. Unlike LockHelper, the lock does not
+/// burn CPU when the system is oversubscribed.
+///
+/// The uncontended Lock()/Unlock() pair costs a single atomic exchange each.
+class AdaptiveLock
+{
+public:
+    /// Default number of spin iterations before the thread is parked.
+    static constexpr Diligent::Uint32 DefaultSpinCount = 64;
+
+    explicit AdaptiveLock(Diligent::Uint32 SpinCount = DefaultSpinCount) noexcept :
+        m_SpinCount{SpinCount}
+    {}
+
+    // clang-format off
+    AdaptiveLock           (const AdaptiveLock&)  = delete;
+    AdaptiveLock           (      AdaptiveLock&&) = delete;
+    AdaptiveLock& operator=(const AdaptiveLock&)  = delete;
+    AdaptiveLock& operator=(      AdaptiveLock&&) = delete;
+    // clang-format on
+
+    ~AdaptiveLock()
+    {
+        VERIFY(m_State.load() == STATE_UNLOCKED, "Destroying locked lock");
+    }
+
+    bool TryLock() noexcept
+    {
+        Diligent::Uint32 Expected = STATE_UNLOCKED;
+        if (m_State.compare_exchange_strong(Expected, STATE_LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            OnAcquired(0, 0);
+            return true;
+        }
+        return false;
+    }
+
+    void Lock() noexcept
+    {
+        Diligent::Uint32 Expected = STATE_UNLOCKED;
+        if (m_State.compare_exchange_strong(Expected, STATE_LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+            OnAcquired(0, 0);
+        else
+            LockContended();
+    }
+
+    void Unlock() noexcept
+    {
+        VERIFY(m_State.load(std::memory_order_relaxed) != STATE_UNLOCKED, "The lock is not locked");
+        if (m_State.exchange(STATE_UNLOCKED, std::memory_order_release) == STATE_LOCKED_PARKED)
+            UnparkOneThread(m_State);
+    }
+
+    bool IsLocked() const noexcept
+    {
+        return m_State.load(std::memory_order_relaxed) != STATE_UNLOCKED;
+    }
+
+    /// Returns the lock contention statistics.
+
+    /// \note The values are updated while the lock is held and may be
+    ///       slightly out of date when read without holding the lock.
+    LockContentionStats GetStats() const noexcept
+    {
+        LockContentionStats Stats;
+        Stats.NumAcquisitions = m_NumAcquisitions.load(std::memory_order_relaxed);
+        Stats.NumSpins        = m_NumSpins.load(std::memory_order_relaxed);
+        Stats.NumParks        = m_NumParks.load(std::memory_order_relaxed);
+        return Stats;
+    }
+
+    /// Resets the lock contention statistics.
+
+    /// \note The method should not be called while other threads use the lock.
+    void ResetStats() noexcept
+    {
+        m_NumAcquisitions.store(0, std::memory_order_relaxed);
+        m_NumSpins.store(0, std::memory_order_relaxed);
+        m_NumParks.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    enum : Diligent::Uint32
+    {
+        STATE_UNLOCKED      = 0,
+        STATE_LOCKED        = 1,
+        STATE_LOCKED_PARKED = 2 // Locked, and there may be parked threads
+    };
+
+    void LockContended() noexcept;
+
+    void OnAcquired(Diligent::Uint32 NumSpins, Diligent::Uint32 NumParks) noexcept
+    {
+        // The counters are only modified by the thread that holds the lock, so there
+        // is no need for expensive read-modify-write operations.
+        m_NumAcquisitions.store(m_NumAcquisitions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (NumSpins != 0)
+            m_NumSpins.store(m_NumSpins.load(std::memory_order_relaxed) + NumSpins, std::memory_order_relaxed);
+        if (NumParks != 0)
+            m_NumParks.store(m_NumParks.load(std::memory_order_relaxed) + NumParks, std::memory_order_relaxed);
+    }
+
+    std::atomic<Diligent::Uint32> m_State{STATE_UNLOCKED};
+    const Diligent::Uint32        m_SpinCount;
+
+    std::atomic<Diligent::Uint64> m_NumAcquisitions{0};
+    std::atomic<Diligent::Uint64> m_NumSpins{0};
+    std::atomic<Diligent::Uint64> m_NumParks{0};
+};
+
+
+/// Adaptive reader-writer lock.
+
+/// Any number of readers may hold the lock simultaneously, while a writer requires exclusive
+/// access. Waiting threads spin with an exponential backoff and are then parked in the OS.
+/// The lock does not prefer writers, so a continuous stream of readers may delay a writer;
+/// it is intended for read-mostly data such as caches and registries.
+class AdaptiveRWLock
+{
+public:
+    static constexpr Diligent::Uint32 DefaultSpinCount = 64;
+
+    explicit AdaptiveRWLock(Diligent::Uint32 SpinCount = DefaultSpinCount) noexcept :
+        m_SpinCount{SpinCount}
+    {}
+
+    // clang-format off
+    AdaptiveRWLock           (const AdaptiveRWLock&)  = delete;
+    AdaptiveRWLock           (      AdaptiveRWLock&&) = delete;
+    AdaptiveRWLock& operator=(const AdaptiveRWLock&)  = delete;
+    AdaptiveRWLock& operator=(      AdaptiveRWLock&&) = delete;
+    // clang-format on
+
+    ~AdaptiveRWLock()
+    {
+        VERIFY((m_State.load() & (WRITER_BIT | READER_MASK)) == 0, "Destroying locked lock");
+    }
+
+    bool TryLock() noexcept
+    {
+        auto State = m_State.load(std::memory_order_relaxed);
+        if ((State & (WRITER_BIT | READER_MASK)) == 0 &&
+            m_State.compare_exchange_strong(State, State | WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            m_NumAcquisitions.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    bool TryLockShared() noexcept
+    {
+        auto State = m_State.load(std::memory_order_relaxed);
+        if ((State & WRITER_BIT) == 0 &&
+            m_State.compare_exchange_strong(State, State + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            m_NumAcquisitions.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /// Acquires exclusive (writer) access.
+    void Lock() noexcept
+    {
+        if (!TryLock())
+            LockContended(false);
+    }
+
+    /// Acquires shared (reader) access.
+    void LockShared() noexcept
+    {
+        if (!TryLockShared())
+            LockContended(true);
+    }
+
+    void Unlock() noexcept
+    {
+        VERIFY((m_State.load(std::memory_order_relaxed) & WRITER_BIT) != 0, "The lock is not locked for writing");
+        auto PrevState = m_State.fetch_and(~(WRITER_BIT | PARKED_BIT), std::memory_order_release);
+        if (PrevState & PARKED_BIT)
+            UnparkThreads(m_State);
+    }
+
+    void UnlockShared() noexcept
+    {
+        VERIFY((m_State.load(std::memory_order_relaxed) & READER_MASK) != 0, "The lock is not locked for reading");
+        auto PrevState = m_State.fetch_sub(1, std::memory_order_release);
+        // Only writers may be parked while readers hold the lock, so
+        // the last reader has to wake them up.
+        if ((PrevState & READER_MASK) == 1 && (PrevState & PARKED_BIT) != 0)
+        {
+            if (m_State.fetch_and(~PARKED_BIT, std::memory_order_relaxed) & PARKED_BIT)
+                UnparkThreads(m_State);
+        }
+    }
+
+    LockContentionStats GetStats() const noexcept
+    {
+        LockContentionStats Stats;
+        Stats.NumAcquisitions = m_NumAcquisitions.load(std::memory_order_relaxed);
+        Stats.NumSpins        = m_NumSpins.load(std::memory_order_relaxed);
+        Stats.NumParks        = m_NumParks.load(std::memory_order_relaxed);
+        return Stats;
+    }
+
+    void ResetStats() noexcept
+    {
+        m_NumAcquisitions.store(0, std::memory_order_relaxed);
+        m_NumSpins.store(0, std::memory_order_relaxed);
+        m_NumParks.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr Diligent::Uint32 WRITER_BIT  = 0x80000000u;
+    static constexpr Diligent::Uint32 PARKED_BIT  = 0x40000000u;
+    static constexpr Diligent::Uint32 READER_MASK = 0x3FFFFFFFu;
+
+    void LockContended(bool Shared) noexcept;
+
+    std::atomic<Diligent::Uint32> m_State{0};
+    const Diligent::Uint32        m_SpinCount;
+
+    std::atomic<Diligent::Uint64> m_NumAcquisitions{0};
+    std::atomic<Diligent::Uint64> m_NumSpins{0};
+    std::atomic<Diligent::Uint64> m_NumParks{0};
+};
+
+
+/// RAII helper that holds exclusive access to AdaptiveLock or AdaptiveRWLock.
+template <typename LockType>
+class ExclusiveLockGuard
+{
+public:
+    explicit ExclusiveLockGuard(LockType& Lock) noexcept :
+        m_Lock{Lock}
+    {
+        m_Lock.Lock();
+    }
+
+    ~ExclusiveLockGuard()
+    {
+        m_Lock.Unlock();
+    }
+
+    // clang-format off
+    ExclusiveLockGuard           (const ExclusiveLockGuard&) = delete;
+    ExclusiveLockGuard& operator=(const ExclusiveLockGuard&) = delete;
+    // clang-format on
+
+private:
+    LockType& m_Lock;
+};
+
+/// RAII helper that holds shared access to AdaptiveRWLock.
+class SharedLockGuard
+{
+public:
+    explicit SharedLockGuard(AdaptiveRWLock& Lock) noexcept :
+        m_Lock{Lock}
+    {
+        m_Lock.LockShared();
+    }
+
+    ~SharedLockGuard()
+    {
+        m_Lock.UnlockShared();
+    }
+
+    // clang-format off
+    SharedLockGuard           (const SharedLockGuard&) = delete;
+    SharedLockGuard& operator=(const SharedLockGuard&) = delete;
+    // clang-format on
+
+private:
+    AdaptiveRWLock& m_Lock;
+};
+
+} // namespace ThreadingTools
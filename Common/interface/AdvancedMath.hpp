@@ -348,6 +348,372 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt& ViewFrustumExt,
     return BoxVisibility::Intersecting;
 }
 
+/// Tests an array of bounding boxes against the view frustum.
+/// For every box, the result is the same as the one returned by GetBoxVisibility(ViewFrustum, Box, PlaneFlags).
+/// The frustum planes are prepared once for the whole array, and when SIMD is available,
+/// every box is tested against four planes at a time.
+inline void GetBoxesVisibility(const ViewFrustum&  ViewFrustum,
+                               const BoundBox*     pBoxes,
+                               size_t              NumBoxes,
+                               BoxVisibility*      pVisibilities,
+                               FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+#if DILIGENT_SSE_MATH || DILIGENT_NEON_MATH
+    // Planes in structure-of-arrays layout. Disabled planes as well as two padding
+    // planes are replaced with the plane that every box is fully in front of.
+    float Nx[8], Ny[8], Nz[8], D[8];
+
+    const Plane3D* pPlanes = reinterpret_cast<const Plane3D*>(&ViewFrustum);
+    for (int i = 0; i < 8; ++i)
+    {
+        if (i < 6 && (PlaneFlags & (1 << i)) != 0)
+        {
+            Nx[i] = pPlanes[i].Normal.x;
+            Ny[i] = pPlanes[i].Normal.y;
+            Nz[i] = pPlanes[i].Normal.z;
+            D[i]  = pPlanes[i].Distance;
+        }
+        else
+        {
+            Nx[i] = Ny[i] = Nz[i] = 0;
+            D[i]                  = 1;
+        }
+    }
+
+#    if DILIGENT_SSE_MATH
+    const __m128 Zero = _mm_setzero_ps();
+
+    __m128 PlaneNx[2], PlaneNy[2], PlaneNz[2], PlaneD[2], PosX[2], PosY[2], PosZ[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        PlaneNx[i] = _mm_loadu_ps(Nx + i * 4);
+        PlaneNy[i] = _mm_loadu_ps(Ny + i * 4);
+        PlaneNz[i] = _mm_loadu_ps(Nz + i * 4);
+        PlaneD[i]  = _mm_loadu_ps(D + i * 4);
+        PosX[i]    = _mm_cmpgt_ps(PlaneNx[i], Zero);
+        PosY[i]    = _mm_cmpgt_ps(PlaneNy[i], Zero);
+        PosZ[i]    = _mm_cmpgt_ps(PlaneNz[i], Zero);
+    }
+
+    // Returns a where Mask is set and b otherwise
+    const auto Select = [](__m128 Mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(Mask, a), _mm_andnot_ps(Mask, b));
+    };
+
+    for (size_t box = 0; box < NumBoxes; ++box)
+    {
+        const BoundBox& Box = pBoxes[box];
+
+        const __m128 MinX = _mm_set1_ps(Box.Min.x);
+        const __m128 MinY = _mm_set1_ps(Box.Min.y);
+        const __m128 MinZ = _mm_set1_ps(Box.Min.z);
+        const __m128 MaxX = _mm_set1_ps(Box.Max.x);
+        const __m128 MaxY = _mm_set1_ps(Box.Max.y);
+        const __m128 MaxZ = _mm_set1_ps(Box.Max.z);
+
+        int OutsideMask = 0;
+        int InsideMask  = 0;
+        for (int i = 0; i < 2; ++i)
+        {
+            // Same operations as in GetBoxVisibilityAgainstPlane()
+            __m128 DMax = _mm_mul_ps(PlaneNx[i], Select(PosX[i], MaxX, MinX));
+            DMax        = _mm_add_ps(DMax, _mm_mul_ps(PlaneNy[i], Select(PosY[i], MaxY, MinY)));
+            DMax        = _mm_add_ps(DMax, _mm_mul_ps(PlaneNz[i], Select(PosZ[i], MaxZ, MinZ)));
+            DMax        = _mm_add_ps(DMax, PlaneD[i]);
+
+            __m128 DMin = _mm_mul_ps(PlaneNx[i], Select(PosX[i], MinX, MaxX));
+            DMin        = _mm_add_ps(DMin, _mm_mul_ps(PlaneNy[i], Select(PosY[i], MinY, MaxY)));
+            DMin        = _mm_add_ps(DMin, _mm_mul_ps(PlaneNz[i], Select(PosZ[i], MinZ, MaxZ)));
+            DMin        = _mm_add_ps(DMin, PlaneD[i]);
+
+            OutsideMask |= _mm_movemask_ps(_mm_cmplt_ps(DMax, Zero)) << (i * 4);
+            InsideMask |= _mm_movemask_ps(_mm_cmpgt_ps(DMin, Zero)) << (i * 4);
+        }
+#    else
+    const float32x4_t Zero = vdupq_n_f32(0);
+
+    float32x4_t PlaneNx[2], PlaneNy[2], PlaneNz[2], PlaneD[2];
+    uint32x4_t  PosX[2], PosY[2], PosZ[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        PlaneNx[i] = vld1q_f32(Nx + i * 4);
+        PlaneNy[i] = vld1q_f32(Ny + i * 4);
+        PlaneNz[i] = vld1q_f32(Nz + i * 4);
+        PlaneD[i]  = vld1q_f32(D + i * 4);
+        PosX[i]    = vcgtq_f32(PlaneNx[i], Zero);
+        PosY[i]    = vcgtq_f32(PlaneNy[i], Zero);
+        PosZ[i]    = vcgtq_f32(PlaneNz[i], Zero);
+    }
+
+    // Converts the comparison result to the bit mask
+    const auto MoveMask = [](uint32x4_t Mask) {
+        return static_cast<int>((vgetq_lane_u32(Mask, 0) & 1u) |
+                                (vgetq_lane_u32(Mask, 1) & 2u) |
+                                (vgetq_lane_u32(Mask, 2) & 4u) |
+                                (vgetq_lane_u32(Mask, 3) & 8u));
+    };
+
+    for (size_t box = 0; box < NumBoxes; ++box)
+    {
+        const BoundBox& Box = pBoxes[box];
+
+        const float32x4_t MinX = vdupq_n_f32(Box.Min.x);
+        const float32x4_t MinY = vdupq_n_f32(Box.Min.y);
+        const float32x4_t MinZ = vdupq_n_f32(Box.Min.z);
+        const float32x4_t MaxX = vdupq_n_f32(Box.Max.x);
+        const float32x4_t MaxY = vdupq_n_f32(Box.Max.y);
+        const float32x4_t MaxZ = vdupq_n_f32(Box.Max.z);
+
+        int OutsideMask = 0;
+        int InsideMask  = 0;
+        for (int i = 0; i < 2; ++i)
+        {
+            // Same operations as in GetBoxVisibilityAgainstPlane()
+            float32x4_t DMax = vmulq_f32(PlaneNx[i], vbslq_f32(PosX[i], MaxX, MinX));
+            DMax             = vaddq_f32(DMax, vmulq_f32(PlaneNy[i], vbslq_f32(PosY[i], MaxY, MinY)));
+            DMax             = vaddq_f32(DMax, vmulq_f32(PlaneNz[i], vbslq_f32(PosZ[i], MaxZ, MinZ)));
+            DMax             = vaddq_f32(DMax, PlaneD[i]);
+
+            float32x4_t DMin = vmulq_f32(PlaneNx[i], vbslq_f32(PosX[i], MinX, MaxX));
+            DMin             = vaddq_f32(DMin, vmulq_f32(PlaneNy[i], vbslq_f32(PosY[i], MinY, MaxY)));
+            DMin             = vaddq_f32(DMin, vmulq_f32(PlaneNz[i], vbslq_f32(PosZ[i], MinZ, MaxZ)));
+            DMin             = vaddq_f32(DMin, PlaneD[i]);
+
+            OutsideMask |= MoveMask(vcltq_f32(DMax, Zero)) << (i * 4);
+            InsideMask |= MoveMask(vcgtq_f32(DMin, Zero)) << (i * 4);
+        }
+#    endif
+
+        if (OutsideMask != 0)
+            pVisibilities[box] = BoxVisibility::Invisible;
+        else if (InsideMask == 0xFF)
+            pVisibilities[box] = BoxVisibility::FullyVisible;
+        else
+            pVisibilities[box] = BoxVisibility::Intersecting;
+    }
+#else
+    for (size_t box = 0; box < NumBoxes; ++box)
+        pVisibilities[box] = GetBoxVisibility(ViewFrustum, pBoxes[box], PlaneFlags);
+#endif
+}
+
+/// Tests an array of bounding boxes against the extended view frustum.
+/// For every box, the result is the same as the one returned by GetBoxVisibility(ViewFrustumExt, Box, PlaneFlags).
+inline void GetBoxesVisibility(const ViewFrustumExt& ViewFrustumExt,
+                               const BoundBox*       pBoxes,
+                               size_t                NumBoxes,
+                               BoxVisibility*        pVisibilities,
+                               FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    GetBoxesVisibility(static_cast<const ViewFrustum&>(ViewFrustumExt), pBoxes, NumBoxes, pVisibilities, PlaneFlags);
+    if ((PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) != FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+        return;
+
+    // Only boxes that intersect the frustum planes need the additional frustum corner test
+    for (size_t box = 0; box < NumBoxes; ++box)
+    {
+        if (pVisibilities[box] == BoxVisibility::Intersecting)
+            pVisibilities[box] = GetBoxVisibility(ViewFrustumExt, pBoxes[box], PlaneFlags);
+    }
+}
+
+/// Array of axis-aligned bounding boxes stored in structure-of-arrays layout.
+/// Every coordinate array must contain at least NumBoxes elements.
+struct BoundBoxArraySoA
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+
+    size_t NumBoxes = 0;
+};
+
+/// Tests an array of bounding boxes stored in structure-of-arrays layout against the view frustum.
+
+/// \param [in]  ViewFrustum       - View frustum to test the boxes against.
+/// \param [in]  Boxes             - Bounding boxes in SoA layout.
+/// \param [out] pVisibleMask      - Bit mask, where bit i is set if box i is not BoxVisibility::Invisible.
+///                                  The array must contain at least (Boxes.NumBoxes + 31) / 32 elements.
+/// \param [out] pFullyVisibleMask - Optional bit mask, where bit i is set if box i is BoxVisibility::FullyVisible.
+///                                  If not null, must contain the same number of elements as pVisibleMask.
+/// \param [in]  PlaneFlags        - Frustum planes to test the boxes against.
+///
+/// \remarks  For every box, the result is the same as the one returned by GetBoxVisibility(ViewFrustum, Box, PlaneFlags).
+///           Every plane is tested against 4 (8 with AVX) boxes at a time.
+inline void GetBoxesVisibility(const ViewFrustum&      ViewFrustum,
+                               const BoundBoxArraySoA& Boxes,
+                               Uint32*                 pVisibleMask,
+                               Uint32*                 pFullyVisibleMask = nullptr,
+                               FRUSTUM_PLANE_FLAGS     PlaneFlags        = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    // For every plane, select the coordinate arrays of the box corners that are farthest
+    // and nearest along the plane normal (see GetBoxVisibilityAgainstPlane()).
+    struct PlaneInfo
+    {
+        float        Nx, Ny, Nz, D;
+        const float *pFarX, *pFarY, *pFarZ;
+        const float *pNearX, *pNearY, *pNearZ;
+    };
+    PlaneInfo Planes[6];
+    int       NumPlanes = 0;
+
+    const Plane3D* pPlanes = reinterpret_cast<const Plane3D*>(&ViewFrustum);
+    for (int iViewFrustumPlane = 0; iViewFrustumPlane < 6; ++iViewFrustumPlane)
+    {
+        if ((PlaneFlags & (1 << iViewFrustumPlane)) == 0)
+            continue;
+
+        const Plane3D& Plane = pPlanes[iViewFrustumPlane];
+
+        auto& Info  = Planes[NumPlanes++];
+        Info.Nx     = Plane.Normal.x;
+        Info.Ny     = Plane.Normal.y;
+        Info.Nz     = Plane.Normal.z;
+        Info.D      = Plane.Distance;
+        Info.pFarX  = Plane.Normal.x > 0 ? Boxes.MaxX : Boxes.MinX;
+        Info.pFarY  = Plane.Normal.y > 0 ? Boxes.MaxY : Boxes.MinY;
+        Info.pFarZ  = Plane.Normal.z > 0 ? Boxes.MaxZ : Boxes.MinZ;
+        Info.pNearX = Plane.Normal.x > 0 ? Boxes.MinX : Boxes.MaxX;
+        Info.pNearY = Plane.Normal.y > 0 ? Boxes.MinY : Boxes.MaxY;
+        Info.pNearZ = Plane.Normal.z > 0 ? Boxes.MinZ : Boxes.MaxZ;
+    }
+
+    const size_t NumBoxes = Boxes.NumBoxes;
+    const size_t NumWords = (NumBoxes + 31) / 32;
+    for (size_t i = 0; i < NumWords; ++i)
+    {
+        pVisibleMask[i] = 0;
+        if (pFullyVisibleMask != nullptr)
+            pFullyVisibleMask[i] = 0;
+    }
+
+    // Writes visibility bits for NumBits boxes starting with FirstBox. Since the batch size
+    // divides 32, all bits of one batch always go to the same mask element.
+    const auto WriteBits = [&](size_t FirstBox, Uint32 OutsideBits, Uint32 InsideBits, Uint32 NumBits) {
+        const Uint32 BatchMask = (NumBits < 32) ? ((1u << NumBits) - 1u) : ~0u;
+        const auto   Shift     = static_cast<Uint32>(FirstBox % 32);
+        pVisibleMask[FirstBox / 32] |= (~OutsideBits & BatchMask) << Shift;
+        if (pFullyVisibleMask != nullptr)
+            pFullyVisibleMask[FirstBox / 32] |= (InsideBits & ~OutsideBits & BatchMask) << Shift;
+    };
+
+    size_t box = 0;
+#if DILIGENT_AVX_MATH
+    for (; box + 8 <= NumBoxes; box += 8)
+    {
+        const __m256 Zero    = _mm256_setzero_ps();
+        __m256       Outside = _mm256_setzero_ps();
+        __m256       Inside  = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < NumPlanes; ++p)
+        {
+            const auto&  Plane = Planes[p];
+            const __m256 Nx    = _mm256_set1_ps(Plane.Nx);
+            const __m256 Ny    = _mm256_set1_ps(Plane.Ny);
+            const __m256 Nz    = _mm256_set1_ps(Plane.Nz);
+            const __m256 D     = _mm256_set1_ps(Plane.D);
+
+            __m256 DMax = _mm256_mul_ps(_mm256_loadu_ps(Plane.pFarX + box), Nx);
+            DMax        = _mm256_add_ps(DMax, _mm256_mul_ps(_mm256_loadu_ps(Plane.pFarY + box), Ny));
+            DMax        = _mm256_add_ps(DMax, _mm256_mul_ps(_mm256_loadu_ps(Plane.pFarZ + box), Nz));
+            DMax        = _mm256_add_ps(DMax, D);
+
+            __m256 DMin = _mm256_mul_ps(_mm256_loadu_ps(Plane.pNearX + box), Nx);
+            DMin        = _mm256_add_ps(DMin, _mm256_mul_ps(_mm256_loadu_ps(Plane.pNearY + box), Ny));
+            DMin        = _mm256_add_ps(DMin, _mm256_mul_ps(_mm256_loadu_ps(Plane.pNearZ + box), Nz));
+            DMin        = _mm256_add_ps(DMin, D);
+
+            Outside = _mm256_or_ps(Outside, _mm256_cmp_ps(DMax, Zero, _CMP_LT_OQ));
+            Inside  = _mm256_and_ps(Inside, _mm256_cmp_ps(DMin, Zero, _CMP_GT_OQ));
+        }
+        WriteBits(box, static_cast<Uint32>(_mm256_movemask_ps(Outside)), static_cast<Uint32>(_mm256_movemask_ps(Inside)), 8);
+    }
+#endif
+
+#if DILIGENT_SSE_MATH
+    for (; box + 4 <= NumBoxes; box += 4)
+    {
+        const __m128 Zero    = _mm_setzero_ps();
+        __m128       Outside = _mm_setzero_ps();
+        __m128       Inside  = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < NumPlanes; ++p)
+        {
+            const auto&  Plane = Planes[p];
+            const __m128 Nx    = _mm_set1_ps(Plane.Nx);
+            const __m128 Ny    = _mm_set1_ps(Plane.Ny);
+            const __m128 Nz    = _mm_set1_ps(Plane.Nz);
+            const __m128 D     = _mm_set1_ps(Plane.D);
+
+            __m128 DMax = _mm_mul_ps(_mm_loadu_ps(Plane.pFarX + box), Nx);
+            DMax        = _mm_add_ps(DMax, _mm_mul_ps(_mm_loadu_ps(Plane.pFarY + box), Ny));
+            DMax        = _mm_add_ps(DMax, _mm_mul_ps(_mm_loadu_ps(Plane.pFarZ + box), Nz));
+            DMax        = _mm_add_ps(DMax, D);
+
+            __m128 DMin = _mm_mul_ps(_mm_loadu_ps(Plane.pNearX + box), Nx);
+            DMin        = _mm_add_ps(DMin, _mm_mul_ps(_mm_loadu_ps(Plane.pNearY + box), Ny));
+            DMin        = _mm_add_ps(DMin, _mm_mul_ps(_mm_loadu_ps(Plane.pNearZ + box), Nz));
+            DMin        = _mm_add_ps(DMin, D);
+
+            Outside = _mm_or_ps(Outside, _mm_cmplt_ps(DMax, Zero));
+            Inside  = _mm_and_ps(Inside, _mm_cmpgt_ps(DMin, Zero));
+        }
+        WriteBits(box, static_cast<Uint32>(_mm_movemask_ps(Outside)), static_cast<Uint32>(_mm_movemask_ps(Inside)), 4);
+    }
+#elif DILIGENT_NEON_MATH
+    for (; box + 4 <= NumBoxes; box += 4)
+    {
+        const float32x4_t Zero    = vdupq_n_f32(0);
+        uint32x4_t        Outside = vdupq_n_u32(0);
+        uint32x4_t        Inside  = vdupq_n_u32(~0u);
+        for (int p = 0; p < NumPlanes; ++p)
+        {
+            const auto& Plane = Planes[p];
+
+            float32x4_t DMax = vmulq_n_f32(vld1q_f32(Plane.pFarX + box), Plane.Nx);
+            DMax             = vaddq_f32(DMax, vmulq_n_f32(vld1q_f32(Plane.pFarY + box), Plane.Ny));
+            DMax             = vaddq_f32(DMax, vmulq_n_f32(vld1q_f32(Plane.pFarZ + box), Plane.Nz));
+            DMax             = vaddq_f32(DMax, vdupq_n_f32(Plane.D));
+
+            float32x4_t DMin = vmulq_n_f32(vld1q_f32(Plane.pNearX + box), Plane.Nx);
+            DMin             = vaddq_f32(DMin, vmulq_n_f32(vld1q_f32(Plane.pNearY + box), Plane.Ny));
+            DMin             = vaddq_f32(DMin, vmulq_n_f32(vld1q_f32(Plane.pNearZ + box), Plane.Nz));
+            DMin             = vaddq_f32(DMin, vdupq_n_f32(Plane.D));
+
+            Outside = vorrq_u32(Outside, vcltq_f32(DMax, Zero));
+            Inside  = vandq_u32(Inside, vcgtq_f32(DMin, Zero));
+        }
+
+        // Converts the comparison result to the bit mask
+        const auto MoveMask = [](uint32x4_t Mask) {
+            return (vgetq_lane_u32(Mask, 0) & 1u) |
+                (vgetq_lane_u32(Mask, 1) & 2u) |
+                (vgetq_lane_u32(Mask, 2) & 4u) |
+                (vgetq_lane_u32(Mask, 3) & 8u);
+        };
+        WriteBits(box, MoveMask(Outside), MoveMask(Inside), 4);
+    }
+#endif
+
+    for (; box < NumBoxes; ++box)
+    {
+        bool IsOutside = false;
+        bool IsInside  = true;
+        for (int p = 0; p < NumPlanes && !IsOutside; ++p)
+        {
+            const auto& Plane = Planes[p];
+
+            float DMax = Plane.pFarX[box] * Plane.Nx + Plane.pFarY[box] * Plane.Ny + Plane.pFarZ[box] * Plane.Nz + Plane.D;
+            float DMin = Plane.pNearX[box] * Plane.Nx + Plane.pNearY[box] * Plane.Ny + Plane.pNearZ[box] * Plane.Nz + Plane.D;
+
+            IsOutside = DMax < 0;
+            IsInside  = IsInside && DMin > 0;
+        }
+        WriteBits(box, IsOutside ? 1u : 0u, IsInside ? 1u : 0u, 1);
+    }
+}
+
 inline float GetPointToBoxDistance(const BoundBox& BndBox, const float3& Pos)
 {
     VERIFY_EXPR(BndBox.Max.x >= BndBox.Min.x &&
@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::AsyncFileReader class
+
+#include <memory>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Async file reader initialization attributes
+struct AsyncFileReaderCreateInfo
+{
+    /// The number of worker threads that run completion callbacks and, when io_uring is not
+    /// used, read the files. 0 selects the number of hardware threads, but no more than 4.
+    Uint32 NumThreads = 0;
+
+    /// The maximum number of reads that are simultaneously in flight in the io_uring queue.
+    Uint32 QueueDepth = 64;
+
+    /// Whether to read the files through io_uring on Linux when the kernel supports it.
+    /// If io_uring is not available, the files are read by the worker threads.
+    bool UseIOUring = true;
+};
+
+
+/// Reads batches of files asynchronously.
+
+/// Files are read entirely into data blobs. On Linux, the reads are submitted to the kernel through
+/// io_uring by a single I/O thread, so that many files are read in parallel without occupying worker
+/// threads. On other platforms, or if io_uring is not available, the files are read by a pool of worker
+/// threads. Completion callbacks are always invoked by the worker threads, so processing of the files
+/// that have been read (e.g. shader compilation) overlaps with reading of the rest of the batch.
+class AsyncFileReader
+{
+public:
+    /// Completion callback type.
+
+    /// \param [in] FileIndex - Index of the file in the batch.
+    /// \param [in] Path      - Path to the file.
+    /// \param [in] pData     - Contents of the file, or null if the file could not be read.
+    ///
+    /// \remarks The callback is called from a worker thread. Callbacks of different files
+    ///          may run concurrently and in any order. The callback may start new reads,
+    ///          but must not call WaitIdle().
+    using CallbackType = std::function<void(Uint32 FileIndex, const Char* Path, IDataBlob* pData)>;
+
+    explicit AsyncFileReader(const AsyncFileReaderCreateInfo& CI = AsyncFileReaderCreateInfo{});
+
+    /// Waits for all pending reads to complete.
+    ~AsyncFileReader();
+
+    // clang-format off
+    AsyncFileReader           (const AsyncFileReader&)  = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&)  = delete;
+    AsyncFileReader           (AsyncFileReader&&)       = delete;
+    AsyncFileReader& operator=(AsyncFileReader&&)       = delete;
+    // clang-format on
+
+    /// Enqueues reads of a batch of files and returns immediately.
+
+    /// \param [in] Paths    - Paths to the files. The strings are copied and do not need to outlive the call.
+    /// \param [in] NumFiles - The number of files in the batch.
+    /// \param [in] Callback - Callback that is called once for every file in the batch when it has been read.
+    void ReadFiles(const Char* const* Paths, Uint32 NumFiles, CallbackType Callback);
+
+    /// Blocks until all enqueued reads have completed and their callbacks have returned.
+    void WaitIdle();
+
+    /// Returns the number of files whose callbacks have not returned yet.
+    Uint32 GetNumPendingReads() const;
+
+    /// Returns true if the files are read through io_uring.
+    ///
+    /// \remarks If io_uring fails with an unrecoverable error, the reads that are in flight
+    ///          complete with null data, and all further reads are performed by the worker threads.
+    bool IsUsingIOUring() const;
+
+private:
+    struct ReadRequest;
+    class IOUringQueue;
+
+    void WorkerThreadFunc();
+    // Hands the request over to the worker threads. The file is read
+    // by the worker thread if it has not been read by the I/O thread.
+    void OnReadCompleted(std::unique_ptr<ReadRequest>&& pRequest);
+
+    static void ReadFile(ReadRequest& Request);
+
+    mutable std::mutex                       m_Mtx;
+    std::condition_variable                  m_WorkCV;
+    std::condition_variable                  m_IdleCV;
+    std::deque<std::unique_ptr<ReadRequest>> m_WorkQueue;
+    Uint32                                   m_NumPendingReads = 0;
+    bool                                     m_Stop            = false;
+
+    std::vector<std::thread>      m_WorkerThreads;
+    std::unique_ptr<IOUringQueue> m_IOUring;
+};
+
+} // namespace Diligent
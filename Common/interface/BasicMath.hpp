@@ -53,6 +53,34 @@
 
 #include "HashUtils.hpp"
 
+// Core float4 and float4x4 operations as well as batched transforms use SSE (AVX when
+// enabled by the compiler) or NEON intrinsics when they are available.
+// Define DILIGENT_NO_SIMD_MATH to force the portable scalar implementation.
+#if !defined(DILIGENT_NO_SIMD_MATH)
+#    if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#        define DILIGENT_SSE_MATH 1
+#        if defined(__AVX__)
+#            define DILIGENT_AVX_MATH 1
+#            include <immintrin.h>
+#        else
+#            include <emmintrin.h>
+#        endif
+#    elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#        define DILIGENT_NEON_MATH 1
+#        include <arm_neon.h>
+#    endif
+#endif
+
+#ifndef DILIGENT_SSE_MATH
+#    define DILIGENT_SSE_MATH 0
+#endif
+#ifndef DILIGENT_AVX_MATH
+#    define DILIGENT_AVX_MATH 0
+#endif
+#ifndef DILIGENT_NEON_MATH
+#    define DILIGENT_NEON_MATH 0
+#endif
+
 #ifdef _MSC_VER
 #    pragma warning(push)
 #    pragma warning(disable : 4201) // nonstandard extension used: nameless struct/union
@@ -1561,6 +1589,144 @@ template <class T> struct Matrix4x4
     }
 };
 
+#if DILIGENT_SSE_MATH || DILIGENT_NEON_MATH
+
+// Implementation details of the SIMD specializations below
+namespace SIMDDetail
+{
+
+#    if DILIGENT_SSE_MATH
+
+// Returns v.x * r0 + v.y * r1 + v.z * r2 + v.w * r3. The operations are performed in
+// the same order as in the scalar code, so the results are bit-exact.
+inline __m128 LinearCombineSSE(__m128 v, __m128 r0, __m128 r1, __m128 r2, __m128 r3)
+{
+    __m128 res = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+    res        = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+    res        = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+    res        = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r3));
+    return res;
+}
+
+#        if DILIGENT_AVX_MATH
+// Loads four floats into both halves of a 256-bit register
+inline __m256 BroadcastFloat4AVX(const float* p)
+{
+    __m128 v = _mm_loadu_ps(p);
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(v), v, 1);
+}
+
+// Same as LinearCombineSSE, but processes two vectors stored in the lower and upper halves of v
+inline __m256 LinearCombineAVX(__m256 v, __m256 r0, __m256 r1, __m256 r2, __m256 r3)
+{
+    __m256 res = _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+    res        = _mm256_add_ps(res, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+    res        = _mm256_add_ps(res, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+    res        = _mm256_add_ps(res, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r3));
+    return res;
+}
+#        endif
+
+// Multiplies 4x4 matrix pointed to by pM1 by the matrix whose rows are m2r0 ... m2r3.
+// pOut may be equal to pM1.
+inline void MulMatrixSSE(const float* pM1, __m128 m2r0, __m128 m2r1, __m128 m2r2, __m128 m2r3, float* pOut)
+{
+    for (int i = 0; i < 4; ++i)
+        _mm_storeu_ps(pOut + i * 4, LinearCombineSSE(_mm_loadu_ps(pM1 + i * 4), m2r0, m2r1, m2r2, m2r3));
+}
+
+#    elif DILIGENT_NEON_MATH
+
+// Returns v.x * r0 + v.y * r1 + v.z * r2 + v.w * r3
+inline float32x4_t LinearCombineNEON(float32x4_t v, float32x4_t r0, float32x4_t r1, float32x4_t r2, float32x4_t r3)
+{
+    float32x4_t res = vmulq_n_f32(r0, vgetq_lane_f32(v, 0));
+    res             = vaddq_f32(res, vmulq_n_f32(r1, vgetq_lane_f32(v, 1)));
+    res             = vaddq_f32(res, vmulq_n_f32(r2, vgetq_lane_f32(v, 2)));
+    res             = vaddq_f32(res, vmulq_n_f32(r3, vgetq_lane_f32(v, 3)));
+    return res;
+}
+
+// Multiplies 4x4 matrix pointed to by pM1 by the matrix whose rows are m2r0 ... m2r3.
+// pOut may be equal to pM1.
+inline void MulMatrixNEON(const float* pM1, float32x4_t m2r0, float32x4_t m2r1, float32x4_t m2r2, float32x4_t m2r3, float* pOut)
+{
+    for (int i = 0; i < 4; ++i)
+        vst1q_f32(pOut + i * 4, LinearCombineNEON(vld1q_f32(pM1 + i * 4), m2r0, m2r1, m2r2, m2r3));
+}
+
+#    endif
+
+} // namespace SIMDDetail
+
+#endif
+
+#if DILIGENT_SSE_MATH || DILIGENT_NEON_MATH
+
+// SIMD specializations of the core float4 and float4x4 operations
+
+template <>
+inline Vector4<float> Vector4<float>::operator*(const Matrix4x4<float>& m) const
+{
+    Vector4<float> out;
+#    if DILIGENT_SSE_MATH
+    _mm_storeu_ps(out.Data(), SIMDDetail::LinearCombineSSE(_mm_loadu_ps(Data()), _mm_loadu_ps(m[0]), _mm_loadu_ps(m[1]), _mm_loadu_ps(m[2]), _mm_loadu_ps(m[3])));
+#    else
+    vst1q_f32(out.Data(), SIMDDetail::LinearCombineNEON(vld1q_f32(Data()), vld1q_f32(m[0]), vld1q_f32(m[1]), vld1q_f32(m[2]), vld1q_f32(m[3])));
+#    endif
+    return out;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Mul(const Matrix4x4<float>& m1, const Matrix4x4<float>& m2)
+{
+    Matrix4x4<float> mOut;
+#    if DILIGENT_AVX_MATH
+    const __m256 m2r0 = SIMDDetail::BroadcastFloat4AVX(m2[0]);
+    const __m256 m2r1 = SIMDDetail::BroadcastFloat4AVX(m2[1]);
+    const __m256 m2r2 = SIMDDetail::BroadcastFloat4AVX(m2[2]);
+    const __m256 m2r3 = SIMDDetail::BroadcastFloat4AVX(m2[3]);
+    // Process two rows at a time
+    _mm256_storeu_ps(mOut[0], SIMDDetail::LinearCombineAVX(_mm256_loadu_ps(m1[0]), m2r0, m2r1, m2r2, m2r3));
+    _mm256_storeu_ps(mOut[2], SIMDDetail::LinearCombineAVX(_mm256_loadu_ps(m1[2]), m2r0, m2r1, m2r2, m2r3));
+#    elif DILIGENT_SSE_MATH
+    SIMDDetail::MulMatrixSSE(m1.Data(), _mm_loadu_ps(m2[0]), _mm_loadu_ps(m2[1]), _mm_loadu_ps(m2[2]), _mm_loadu_ps(m2[3]), mOut.Data());
+#    else
+    SIMDDetail::MulMatrixNEON(m1.Data(), vld1q_f32(m2[0]), vld1q_f32(m2[1]), vld1q_f32(m2[2]), vld1q_f32(m2[3]), mOut.Data());
+#    endif
+    return mOut;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Transpose() const
+{
+    Matrix4x4<float> mOut;
+#    if DILIGENT_SSE_MATH
+    __m128 r0 = _mm_loadu_ps(m[0]);
+    __m128 r1 = _mm_loadu_ps(m[1]);
+    __m128 r2 = _mm_loadu_ps(m[2]);
+    __m128 r3 = _mm_loadu_ps(m[3]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(mOut[0], r0);
+    _mm_storeu_ps(mOut[1], r1);
+    _mm_storeu_ps(mOut[2], r2);
+    _mm_storeu_ps(mOut[3], r3);
+#    else
+    // t01.val[0] = {_11, _21, _13, _23}, t01.val[1] = {_12, _22, _14, _24}
+    const float32x4x2_t t01 = vtrnq_f32(vld1q_f32(m[0]), vld1q_f32(m[1]));
+    // t23.val[0] = {_31, _41, _33, _43}, t23.val[1] = {_32, _42, _34, _44}
+    const float32x4x2_t t23 = vtrnq_f32(vld1q_f32(m[2]), vld1q_f32(m[3]));
+    vst1q_f32(mOut[0], vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+    vst1q_f32(mOut[1], vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+    vst1q_f32(mOut[2], vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+    vst1q_f32(mOut[3], vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+#    endif
+    return mOut;
+}
+
+#endif
+
+
 // Template Vector Operations
 
 
@@ -1723,6 +1889,14 @@ Vector4<T> operator*(const Matrix4x4<T>& m, const Vector4<T>& v)
     return out;
 }
 
+#if DILIGENT_SSE_MATH || DILIGENT_NEON_MATH
+inline Vector4<float> operator*(const Matrix4x4<float>& m, const Vector4<float>& v)
+{
+    // m * v == v * transpose(m), and the products are summed in the same order
+    return v * m.Transpose();
+}
+#endif
+
 template <class T>
 Vector3<T> operator*(const Matrix3x3<T>& m, Vector3<T>& v)
 {
@@ -1769,6 +1943,138 @@ using double4x4 = Matrix4x4<double>;
 using double3x3 = Matrix3x3<double>;
 using double2x2 = Matrix2x2<double>;
 
+static_assert(sizeof(float4) == sizeof(float) * 4, "float4 arrays must be tightly packed");
+static_assert(sizeof(float4x4) == sizeof(float) * 16, "float4x4 arrays must be tightly packed");
+
+/// Transforms an array of vectors by the matrix: pDst[i] = pSrc[i] * m.
+/// The results are identical to those produced by the float4 * float4x4 operator.
+/// pSrc and pDst may point to the same array.
+inline void TransformVectors(const float4* pSrc, float4* pDst, size_t Count, const float4x4& m)
+{
+#if DILIGENT_SSE_MATH
+    size_t i = 0;
+#    if DILIGENT_AVX_MATH
+    {
+        const __m256 r0 = SIMDDetail::BroadcastFloat4AVX(m[0]);
+        const __m256 r1 = SIMDDetail::BroadcastFloat4AVX(m[1]);
+        const __m256 r2 = SIMDDetail::BroadcastFloat4AVX(m[2]);
+        const __m256 r3 = SIMDDetail::BroadcastFloat4AVX(m[3]);
+        for (; i + 2 <= Count; i += 2)
+            _mm256_storeu_ps(pDst[i].Data(), SIMDDetail::LinearCombineAVX(_mm256_loadu_ps(pSrc[i].Data()), r0, r1, r2, r3));
+    }
+#    endif
+    const __m128 r0 = _mm_loadu_ps(m[0]);
+    const __m128 r1 = _mm_loadu_ps(m[1]);
+    const __m128 r2 = _mm_loadu_ps(m[2]);
+    const __m128 r3 = _mm_loadu_ps(m[3]);
+    for (; i < Count; ++i)
+        _mm_storeu_ps(pDst[i].Data(), SIMDDetail::LinearCombineSSE(_mm_loadu_ps(pSrc[i].Data()), r0, r1, r2, r3));
+#elif DILIGENT_NEON_MATH
+    const float32x4_t r0 = vld1q_f32(m[0]);
+    const float32x4_t r1 = vld1q_f32(m[1]);
+    const float32x4_t r2 = vld1q_f32(m[2]);
+    const float32x4_t r3 = vld1q_f32(m[3]);
+    for (size_t i = 0; i < Count; ++i)
+        vst1q_f32(pDst[i].Data(), SIMDDetail::LinearCombineNEON(vld1q_f32(pSrc[i].Data()), r0, r1, r2, r3));
+#else
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = pSrc[i] * m;
+#endif
+}
+
+/// Transforms an array of points by the matrix and performs perspective division.
+/// The results are identical to those produced by the float3 * float4x4 operator.
+/// pSrc and pDst may point to the same array.
+inline void TransformPoints(const float3* pSrc, float3* pDst, size_t Count, const float4x4& m)
+{
+#if DILIGENT_SSE_MATH || DILIGENT_NEON_MATH
+#    if DILIGENT_SSE_MATH
+    const __m128 r0 = _mm_loadu_ps(m[0]);
+    const __m128 r1 = _mm_loadu_ps(m[1]);
+    const __m128 r2 = _mm_loadu_ps(m[2]);
+    const __m128 r3 = _mm_loadu_ps(m[3]);
+#    else
+    const float32x4_t r0 = vld1q_f32(m[0]);
+    const float32x4_t r1 = vld1q_f32(m[1]);
+    const float32x4_t r2 = vld1q_f32(m[2]);
+    const float32x4_t r3 = vld1q_f32(m[3]);
+#    endif
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const float3& Src = pSrc[i];
+
+        float Res[4];
+#    if DILIGENT_SSE_MATH
+        // w == 1, so w * r3 == r3
+        __m128 v = _mm_mul_ps(_mm_set1_ps(Src.x), r0);
+        v        = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(Src.y), r1));
+        v        = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(Src.z), r2));
+        v        = _mm_add_ps(v, r3);
+        v        = _mm_div_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+        _mm_storeu_ps(Res, v);
+#    else
+        float32x4_t v = vmulq_n_f32(r0, Src.x);
+        v             = vaddq_f32(v, vmulq_n_f32(r1, Src.y));
+        v             = vaddq_f32(v, vmulq_n_f32(r2, Src.z));
+        v             = vaddq_f32(v, r3);
+        vst1q_f32(Res, v);
+        Res[0] /= Res[3];
+        Res[1] /= Res[3];
+        Res[2] /= Res[3];
+#    endif
+        pDst[i] = float3{Res[0], Res[1], Res[2]};
+    }
+#else
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = pSrc[i] * m;
+#endif
+}
+
+/// Multiplies arrays of matrices: pDst[i] = pLHS[i] * pRHS[i].
+/// pDst may point to the same array as pLHS or pRHS.
+inline void MultiplyMatrices(const float4x4* pLHS, const float4x4* pRHS, float4x4* pDst, size_t Count)
+{
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = float4x4::Mul(pLHS[i], pRHS[i]);
+}
+
+/// Multiplies every matrix in the array by the same matrix: pDst[i] = pSrc[i] * RHS.
+/// pDst may point to the same array as pSrc.
+inline void MultiplyMatrices(const float4x4* pSrc, const float4x4& RHS, float4x4* pDst, size_t Count)
+{
+#if DILIGENT_AVX_MATH
+    const __m256 r0 = SIMDDetail::BroadcastFloat4AVX(RHS[0]);
+    const __m256 r1 = SIMDDetail::BroadcastFloat4AVX(RHS[1]);
+    const __m256 r2 = SIMDDetail::BroadcastFloat4AVX(RHS[2]);
+    const __m256 r3 = SIMDDetail::BroadcastFloat4AVX(RHS[3]);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const __m256 Rows01 = SIMDDetail::LinearCombineAVX(_mm256_loadu_ps(pSrc[i][0]), r0, r1, r2, r3);
+        const __m256 Rows23 = SIMDDetail::LinearCombineAVX(_mm256_loadu_ps(pSrc[i][2]), r0, r1, r2, r3);
+        _mm256_storeu_ps(pDst[i][0], Rows01);
+        _mm256_storeu_ps(pDst[i][2], Rows23);
+    }
+#elif DILIGENT_SSE_MATH
+    const __m128 r0 = _mm_loadu_ps(RHS[0]);
+    const __m128 r1 = _mm_loadu_ps(RHS[1]);
+    const __m128 r2 = _mm_loadu_ps(RHS[2]);
+    const __m128 r3 = _mm_loadu_ps(RHS[3]);
+    for (size_t i = 0; i < Count; ++i)
+        SIMDDetail::MulMatrixSSE(pSrc[i].Data(), r0, r1, r2, r3, pDst[i].Data());
+#elif DILIGENT_NEON_MATH
+    const float32x4_t r0 = vld1q_f32(RHS[0]);
+    const float32x4_t r1 = vld1q_f32(RHS[1]);
+    const float32x4_t r2 = vld1q_f32(RHS[2]);
+    const float32x4_t r3 = vld1q_f32(RHS[3]);
+    for (size_t i = 0; i < Count; ++i)
+        SIMDDetail::MulMatrixNEON(pSrc[i].Data(), r0, r1, r2, r3, pDst[i].Data());
+#else
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = pSrc[i] * RHS;
+#endif
+}
+
+
 
 struct Quaternion
 {
@@ -0,0 +1,277 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BoundingVolumeHierarchy class
+
+#include <vector>
+
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+/// Bounding volume hierarchy over a set of axis-aligned bounding boxes.
+
+/// The hierarchy is built using the binned surface area heuristic (SAH) and is stored
+/// as a flat array of nodes in depth-first order: the left child of every interior node
+/// immediately follows its parent, and only the index of the right child is stored.
+/// Nodes are 32 bytes, so two of them fit into a cache line.
+class BoundingVolumeHierarchy
+{
+public:
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    struct Node
+    {
+        /// Bounding box of all primitives in the node's subtree.
+        BoundBox Box;
+
+        /// For an interior node - index of the right child node.
+        /// For a leaf node - index of the first primitive in the primitive index array.
+        Uint32 Offset = 0;
+
+        /// The number of primitives in a leaf node, zero for interior nodes.
+        Uint16 NumPrimitives = 0;
+
+        /// For an interior node - the axis the primitives were split along.
+        Uint16 SplitAxis = 0;
+
+        bool IsLeaf() const { return NumPrimitives != 0; }
+    };
+    static_assert(sizeof(Node) == 32, "Unexpected node size");
+
+    /// Builds the hierarchy over the given bounding boxes. Primitive indices
+    /// reported by the queries are the indices of the boxes in this array.
+    void Build(const BoundBox* pBoxes, Uint32 NumBoxes, Uint32 MaxLeafSize = 4);
+
+    void Clear();
+
+    /// Enumerates all primitives whose bounding boxes are not invisible by the view frustum.
+
+    /// \param [in] Frustum    - View frustum.
+    /// \param [in] Callback   - Callback function that will be called as Callback(Uint32 PrimitiveIndex, BoxVisibility Visibility)
+    ///                          for every primitive whose box is visible. Visibility is the same as the one
+    ///                          returned by GetBoxVisibility(Frustum, PrimitiveBox, PlaneFlags).
+    /// \param [in] PlaneFlags - Frustum planes to test the boxes against.
+    ///
+    /// \remarks When a node is fully inside a frustum plane, the plane is not tested for any node
+    ///          in its subtree. Subtrees that are fully inside the frustum are enumerated without tests.
+    template <typename CallbackType>
+    void QueryFrustum(const ViewFrustum& Frustum, CallbackType Callback, FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) const;
+
+    /// Appends indices of all primitives that are not invisible by the frustum to the Primitives vector.
+    void GetVisiblePrimitives(const ViewFrustum& Frustum, std::vector<Uint32>& Primitives, FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) const;
+
+    /// Finds the closest primitive intersected by the ray.
+
+    /// \param [in]  RayOrigin          - Ray origin.
+    /// \param [in]  RayDirection       - Ray direction.
+    /// \param [in]  IntersectPrimitive - Callback function that will be called as IntersectPrimitive(Uint32 PrimitiveIndex)
+    ///                                   for primitives whose boxes are hit by the ray. The function must return the
+    ///                                   distance along the ray to the intersection, or +FLT_MAX if there is none.
+    /// \param [out] HitDistance        - Distance to the closest intersection.
+    /// \param [out] HitPrimitive       - Index of the closest intersected primitive, or InvalidIndex.
+    ///
+    /// \return     true if the ray intersects any primitive, and false otherwise.
+    ///
+    /// \remarks    Intersections behind the ray origin are ignored. Child nodes are visited
+    ///             front to back, and nodes farther than the current closest hit are skipped.
+    template <typename IntersectCallbackType>
+    bool IntersectRay(const float3&         RayOrigin,
+                      const float3&         RayDirection,
+                      IntersectCallbackType IntersectPrimitive,
+                      float&                HitDistance,
+                      Uint32&               HitPrimitive) const;
+
+    /// Finds the closest triangle intersected by the ray using IntersectRayTriangle().
+    /// The hierarchy must have been built over the triangle bounding boxes, where
+    /// triangle i is formed by vertices pIndices[i*3], pIndices[i*3+1] and pIndices[i*3+2].
+    bool IntersectRayTriangles(const float3& RayOrigin,
+                               const float3& RayDirection,
+                               const float3* pVertices,
+                               const Uint32* pIndices,
+                               float&        HitDistance,
+                               Uint32&       HitTriangle,
+                               bool          CullBackFace = false) const;
+
+    const std::vector<Node>& GetNodes() const { return m_Nodes; }
+
+    /// Returns primitive indices in the order they are referenced by the leaf nodes.
+    const std::vector<Uint32>& GetPrimitiveIndices() const { return m_PrimitiveIndices; }
+
+private:
+    struct BuildContext;
+    Uint32 BuildNode(BuildContext& Ctx, Uint32 Begin, Uint32 End, Uint32 Depth);
+
+    // The traversal stack depth limit. The build switches to median splits deep in
+    // the tree, which guarantees that the hierarchy never exceeds this depth.
+    static constexpr Uint32 MaxTreeDepth = 128;
+
+    std::vector<Node>     m_Nodes;
+    std::vector<Uint32>   m_PrimitiveIndices;
+    std::vector<BoundBox> m_PrimitiveBoxes; // Primitive boxes in the order of m_PrimitiveIndices
+};
+
+
+template <typename CallbackType>
+void BoundingVolumeHierarchy::QueryFrustum(const ViewFrustum& Frustum, CallbackType Callback, FRUSTUM_PLANE_FLAGS PlaneFlags) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    const Plane3D* pPlanes = reinterpret_cast<const Plane3D*>(&Frustum);
+
+    // Returns the box visibility and removes the planes the box is fully inside of from PlaneFlags
+    const auto TestBox = [pPlanes](const BoundBox& Box, FRUSTUM_PLANE_FLAGS& Flags) {
+        for (int iPlane = 0; iPlane < 6; ++iPlane)
+        {
+            const auto PlaneFlag = static_cast<FRUSTUM_PLANE_FLAGS>(1 << iPlane);
+            if ((Flags & PlaneFlag) == 0)
+                continue;
+
+            auto Visibility = GetBoxVisibilityAgainstPlane(pPlanes[iPlane], Box);
+            if (Visibility == BoxVisibility::Invisible)
+                return BoxVisibility::Invisible;
+
+            if (Visibility == BoxVisibility::FullyVisible)
+                Flags &= ~PlaneFlag;
+        }
+        return Flags == FRUSTUM_PLANE_FLAG_NONE ? BoxVisibility::FullyVisible : BoxVisibility::Intersecting;
+    };
+
+    struct StackEntry
+    {
+        Uint32              NodeIdx;
+        FRUSTUM_PLANE_FLAGS PlaneFlags;
+    };
+    StackEntry Stack[MaxTreeDepth];
+    Uint32     StackSize = 0;
+
+    Stack[StackSize++] = {0, PlaneFlags};
+    while (StackSize > 0)
+    {
+        const auto  Entry = Stack[--StackSize];
+        const Node& N     = m_Nodes[Entry.NodeIdx];
+
+        FRUSTUM_PLANE_FLAGS NodePlaneFlags = Entry.PlaneFlags;
+        if (NodePlaneFlags != FRUSTUM_PLANE_FLAG_NONE && TestBox(N.Box, NodePlaneFlags) == BoxVisibility::Invisible)
+            continue;
+
+        if (N.IsLeaf())
+        {
+            for (Uint32 i = N.Offset; i < N.Offset + N.NumPrimitives; ++i)
+            {
+                FRUSTUM_PLANE_FLAGS PrimPlaneFlags = NodePlaneFlags;
+
+                const auto Visibility = PrimPlaneFlags != FRUSTUM_PLANE_FLAG_NONE ?
+                    TestBox(m_PrimitiveBoxes[i], PrimPlaneFlags) :
+                    BoxVisibility::FullyVisible;
+                if (Visibility != BoxVisibility::Invisible)
+                    Callback(m_PrimitiveIndices[i], Visibility);
+            }
+        }
+        else
+        {
+            VERIFY_EXPR(StackSize + 2 <= MaxTreeDepth);
+            Stack[StackSize++] = {N.Offset, NodePlaneFlags};
+            Stack[StackSize++] = {Entry.NodeIdx + 1, NodePlaneFlags};
+        }
+    }
+}
+
+
+template <typename IntersectCallbackType>
+bool BoundingVolumeHierarchy::IntersectRay(const float3&         RayOrigin,
+                                           const float3&         RayDirection,
+                                           IntersectCallbackType IntersectPrimitive,
+                                           float&                HitDistance,
+                                           Uint32&               HitPrimitive) const
+{
+    HitDistance  = +FLT_MAX;
+    HitPrimitive = InvalidIndex;
+
+    float EnterDist, ExitDist;
+    if (m_Nodes.empty() || !IntersectRayAABB(RayOrigin, RayDirection, m_Nodes[0].Box, EnterDist, ExitDist))
+        return false;
+
+    struct StackEntry
+    {
+        Uint32 NodeIdx;
+        float  EnterDist;
+    };
+    StackEntry Stack[MaxTreeDepth];
+    Uint32     StackSize = 0;
+
+    Stack[StackSize++] = {0, EnterDist};
+    while (StackSize > 0)
+    {
+        const auto Entry = Stack[--StackSize];
+        if (Entry.EnterDist > HitDistance)
+            continue;
+
+        const Node& N = m_Nodes[Entry.NodeIdx];
+        if (N.IsLeaf())
+        {
+            for (Uint32 i = N.Offset; i < N.Offset + N.NumPrimitives; ++i)
+            {
+                const auto Dist = IntersectPrimitive(m_PrimitiveIndices[i]);
+                if (Dist >= 0 && Dist < HitDistance)
+                {
+                    HitDistance  = Dist;
+                    HitPrimitive = m_PrimitiveIndices[i];
+                }
+            }
+        }
+        else
+        {
+            const Uint32 Children[] = {Entry.NodeIdx + 1, N.Offset};
+
+            float ChildEnterDist[2];
+            bool  IsChildHit[2];
+            for (int c = 0; c < 2; ++c)
+            {
+                IsChildHit[c] = IntersectRayAABB(RayOrigin, RayDirection, m_Nodes[Children[c]].Box, ChildEnterDist[c], ExitDist) &&
+                    ChildEnterDist[c] <= HitDistance;
+            }
+
+            // Push the farther child first so that the closer one is visited first
+            const int First = (IsChildHit[0] && IsChildHit[1] && ChildEnterDist[1] < ChildEnterDist[0]) ? 1 : 0;
+            VERIFY_EXPR(StackSize + 2 <= MaxTreeDepth);
+            if (IsChildHit[1 - First])
+                Stack[StackSize++] = {Children[1 - First], ChildEnterDist[1 - First]};
+            if (IsChildHit[First])
+                Stack[StackSize++] = {Children[First], ChildEnterDist[First]};
+        }
+    }
+
+    return HitPrimitive != InvalidIndex;
+}
+
+} // namespace Diligent
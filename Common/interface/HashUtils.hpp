@@ -117,6 +117,15 @@ public:
         }
     }
 
+    // This constructor keeps pointer to the string and uses the hash that was
+    // computed by CStringHash<Char> in advance (zero means the hash is unknown).
+    HashMapStringKey(const Char* Str, bool bMakeCopy, size_t StrHash) :
+        HashMapStringKey{Str, bMakeCopy}
+    {
+        VERIFY(StrHash == 0 || StrHash == CStringHash<Char>()(Str), "Precomputed hash does not match the string");
+        Hash = StrHash;
+    }
+
     explicit // Make this constructor explicit to avoid unintentional string copies
         HashMapStringKey(const String& Str) :
         StrPtr{nullptr},
@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::StringInternTable and Diligent::InternedString classes
+
+#include <vector>
+#include <unordered_set>
+#include <atomic>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "HashUtils.hpp"
+#include "StringPool.hpp"
+#include "AdaptiveLock.hpp"
+
+namespace Diligent
+{
+
+/// Handle of a string interned by Diligent::StringInternTable.
+
+/// Handles of equal strings interned by the same table are equal, so they are compared by pointer.
+/// The hash of the string is computed by CStringHash<Char> once when the string is interned and is
+/// stored in the table next to the string, so the handle is the size of a pointer.
+class InternedString
+{
+public:
+    InternedString() noexcept {}
+
+    const Char* GetStr() const noexcept { return m_Str; }
+
+    /// Returns the hash of the string computed by CStringHash<Char>.
+    size_t GetHash() const noexcept
+    {
+        return m_Str != nullptr ? reinterpret_cast<const size_t*>(m_Str)[-1] : 0;
+    }
+
+    explicit operator bool() const noexcept { return m_Str != nullptr; }
+
+    bool operator==(const InternedString& rhs) const noexcept { return m_Str == rhs.m_Str; }
+    bool operator!=(const InternedString& rhs) const noexcept { return m_Str != rhs.m_Str; }
+
+    struct Hasher
+    {
+        size_t operator()(const InternedString& Str) const noexcept
+        {
+            return Str.GetHash();
+        }
+    };
+
+private:
+    friend class StringInternTable;
+
+    explicit InternedString(const Char* Str) noexcept :
+        m_Str{Str}
+    {}
+
+    const Char* m_Str = nullptr;
+};
+
+
+/// Thread-safe string interning table.
+
+/// The table stores a single copy of every distinct string in pages of StringPool memory and returns
+/// stable handles to it. Strings are never removed while the table is alive. The table is split into
+/// shards that are protected by separate reader-writer locks, so that threads interning different
+/// strings rarely contend, and lookups of strings that have already been interned only take a shared lock.
+class StringInternTable
+{
+public:
+    /// \param [in] PageSize - Size of the memory pages that store the strings, in bytes.
+    explicit StringInternTable(size_t PageSize = 4096);
+    ~StringInternTable();
+
+    // clang-format off
+    StringInternTable           (const StringInternTable&) = delete;
+    StringInternTable& operator=(const StringInternTable&) = delete;
+    StringInternTable           (StringInternTable&&)      = delete;
+    StringInternTable& operator=(StringInternTable&&)      = delete;
+    // clang-format on
+
+    /// Interns the string and returns its handle.
+    InternedString Intern(const Char* Str);
+
+    /// Interns the string whose hash has been computed by CStringHash<Char> in advance.
+    InternedString Intern(const Char* Str, size_t Hash);
+
+    /// Returns the handle of the string if it has been interned, and a null handle otherwise.
+    InternedString Find(const Char* Str) const;
+
+    /// Returns the hash of the string that has been returned by InternedString::GetStr().
+    static size_t GetInternedHash(const Char* InternedStr) noexcept
+    {
+        VERIFY(InternedStr == nullptr || reinterpret_cast<const size_t*>(InternedStr)[-1] == CStringHash<Char>{}(InternedStr),
+               "The string has not been interned");
+        return InternedStr != nullptr ? reinterpret_cast<const size_t*>(InternedStr)[-1] : 0;
+    }
+
+    /// Returns the number of distinct strings in the table.
+    size_t GetNumStrings() const;
+
+    /// Returns the total size of the memory pages allocated by the table, in bytes.
+    size_t GetMemorySize() const;
+
+    /// Returns the process-wide table that is used for shader resource names and shader macros.
+    static StringInternTable& GetGlobal();
+
+private:
+    static constexpr size_t NumShards = 16;
+
+    struct Shard
+    {
+        mutable ThreadingTools::AdaptiveRWLock Lock;
+
+        // Keys point to the strings in the pages and do not own them
+        std::unordered_set<HashMapStringKey, HashMapStringKey::Hasher> Strings;
+
+        std::vector<StringPool> Pages;
+    };
+
+    Shard& GetShard(size_t Hash) const
+    {
+        // Low bits are used by the hash set buckets
+        return m_Shards[(Hash >> 24) % NumShards];
+    }
+
+    const Char* AddString(Shard& Shard, const Char* Str, size_t Hash);
+
+    const size_t  m_PageSize;
+    mutable Shard m_Shards[NumShards];
+};
+
+} // namespace Diligent
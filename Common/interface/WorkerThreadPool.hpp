@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::WorkerThreadPool class
+
+#include <memory>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// A pool of persistent worker threads that run data-parallel loops.
+
+/// The threads are started once and are reused by all loops, so that short
+/// operations, e.g. conversion of an image, do not pay the cost of starting threads.
+class WorkerThreadPool
+{
+public:
+    /// Starts NumThreads worker threads. 0 threads is valid: all tasks then run on the calling thread.
+    explicit WorkerThreadPool(Uint32 NumThreads);
+
+    /// Waits for the worker threads to finish their current tasks and stops them.
+    ~WorkerThreadPool();
+
+    // clang-format off
+    WorkerThreadPool           (const WorkerThreadPool&)  = delete;
+    WorkerThreadPool& operator=(const WorkerThreadPool&)  = delete;
+    WorkerThreadPool           (WorkerThreadPool&&)       = delete;
+    WorkerThreadPool& operator=(WorkerThreadPool&&)       = delete;
+    // clang-format on
+
+    /// Calls Func(Task) for every Task in [0, NumTasks) and returns when all calls have returned.
+
+    /// \remarks The calling thread runs the tasks together with the worker threads, so the function
+    ///          makes progress even if all workers are busy, and it may be called from a task.
+    ///          The tasks may run concurrently and in any order.
+    void ParallelFor(Uint32 NumTasks, const std::function<void(Uint32 Task)>& Func);
+
+    /// Returns the number of worker threads.
+    Uint32 GetNumThreads() const { return static_cast<Uint32>(m_Threads.size()); }
+
+    /// Returns the process-wide pool that is created on first use and has one
+    /// worker thread per hardware thread, except the one of the calling thread.
+    static WorkerThreadPool& GetDefault();
+
+private:
+    struct Job;
+
+    void WorkerThreadFunc();
+
+    std::mutex                       m_Mtx;
+    std::condition_variable          m_CV;
+    std::deque<std::shared_ptr<Job>> m_Queue;
+    bool                             m_Stop = false;
+    std::vector<std::thread>         m_Threads;
+};
+
+} // namespace Diligent
@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "AdaptiveLock.hpp"
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+#    include <climits>
+#    include <unistd.h>
+#    include <sys/syscall.h>
+#    include <linux/futex.h>
+#else
+#    include <mutex>
+#    include <condition_variable>
+#endif
+
+namespace ThreadingTools
+{
+
+using namespace Diligent;
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+
+static_assert(sizeof(std::atomic<Uint32>) == sizeof(Uint32), "Futex requires std::atomic<Uint32> to have the same layout as Uint32");
+
+static void Futex(std::atomic<Uint32>& Address, int Op, Uint32 Value)
+{
+    syscall(SYS_futex, reinterpret_cast<Uint32*>(&Address), Op, Value, nullptr, nullptr, 0);
+}
+
+void ParkThread(std::atomic<Uint32>& Address, Uint32 ExpectedValue) noexcept
+{
+    // The kernel atomically checks that the value is still equal to ExpectedValue
+    // before putting the thread to sleep, so the wake-up can't be lost.
+    Futex(Address, FUTEX_WAIT_PRIVATE, ExpectedValue);
+}
+
+void UnparkThreads(std::atomic<Uint32>& Address) noexcept
+{
+    Futex(Address, FUTEX_WAKE_PRIVATE, INT_MAX);
+}
+
+void UnparkOneThread(std::atomic<Uint32>& Address) noexcept
+{
+    Futex(Address, FUTEX_WAKE_PRIVATE, 1);
+}
+
+#else
+
+namespace
+{
+
+struct ParkingBucket
+{
+    std::mutex              Mtx;
+    std::condition_variable CondVar;
+};
+
+ParkingBucket& GetParkingBucket(const void* Address)
+{
+    static constexpr size_t NumBuckets = 64;
+    static ParkingBucket    Buckets[NumBuckets];
+
+    const auto Hash = reinterpret_cast<size_t>(Address) >> 3;
+    return Buckets[(Hash ^ (Hash >> 6)) % NumBuckets];
+}
+
+} // namespace
+
+void ParkThread(std::atomic<Uint32>& Address, Uint32 ExpectedValue) noexcept
+{
+    auto& Bucket = GetParkingBucket(&Address);
+
+    std::unique_lock<std::mutex> Lock{Bucket.Mtx};
+    // The value is always modified before the bucket mutex is acquired by the waking
+    // thread, so if it is still equal to ExpectedValue, the notification can't be missed.
+    if (Address.load() == ExpectedValue)
+        Bucket.CondVar.wait(Lock);
+}
+
+void UnparkThreads(std::atomic<Uint32>& Address) noexcept
+{
+    auto& Bucket = GetParkingBucket(&Address);
+    {
+        std::lock_guard<std::mutex> Lock{Bucket.Mtx};
+    }
+    Bucket.CondVar.notify_all();
+}
+
+void UnparkOneThread(std::atomic<Uint32>& Address) noexcept
+{
+    // The bucket may be shared by threads parked on different addresses, so
+    // notifying a single thread may wake up the wrong one.
+    UnparkThreads(Address);
+}
+
+#endif
+
+
+void AdaptiveLock::LockContended() noexcept
+{
+    Uint32      NumSpins = 0;
+    Uint32      NumParks = 0;
+    SpinBackoff Backoff;
+    while (NumSpins < m_SpinCount)
+    {
+        ++NumSpins;
+        Backoff.Pause();
+        // Only try to acquire the lock when it looks free to avoid
+        // bouncing the cache line between the cores.
+        auto State = m_State.load(std::memory_order_relaxed);
+        if (State == STATE_UNLOCKED &&
+            m_State.compare_exchange_weak(State, STATE_LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            OnAcquired(NumSpins, NumParks);
+            return;
+        }
+    }
+
+    // Spin budget is exhausted. Mark the lock as having parked threads and go to sleep.
+    // If the lock has been released in the meantime, the exchange acquires it (in the parked
+    // state, which may result in one unnecessary wake-up when the lock is released).
+    while (m_State.exchange(STATE_LOCKED_PARKED, std::memory_order_acquire) != STATE_UNLOCKED)
+    {
+        ++NumParks;
+        ParkThread(m_State, STATE_LOCKED_PARKED);
+    }
+    OnAcquired(NumSpins, NumParks);
+}
+
+
+void AdaptiveRWLock::LockContended(bool Shared) noexcept
+{
+    // Readers are only blocked by a writer, while a writer is blocked by everyone
+    const Uint32 BlockingMask = Shared ? WRITER_BIT : (WRITER_BIT | READER_MASK);
+
+    Uint32      NumSpins = 0;
+    Uint32      NumParks = 0;
+    SpinBackoff Backoff;
+    while (true)
+    {
+        auto State = m_State.load(std::memory_order_relaxed);
+        if ((State & BlockingMask) == 0)
+        {
+            const auto NewState = Shared ? State + 1 : (State | WRITER_BIT);
+            if (m_State.compare_exchange_weak(State, NewState, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+            else
+                continue;
+        }
+
+        if (NumSpins < m_SpinCount)
+        {
+            ++NumSpins;
+            Backoff.Pause();
+            continue;
+        }
+
+        // Set the parked flag so that the owner wakes us up when it releases the lock
+        if ((State & PARKED_BIT) == 0 &&
+            !m_State.compare_exchange_weak(State, State | PARKED_BIT, std::memory_order_relaxed, std::memory_order_relaxed))
+            continue;
+
+        ++NumParks;
+        ParkThread(m_State, State | PARKED_BIT);
+    }
+
+    m_NumAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    m_NumSpins.fetch_add(NumSpins, std::memory_order_relaxed);
+    if (NumParks != 0)
+        m_NumParks.fetch_add(NumParks, std::memory_order_relaxed);
+}
+
+} // namespace ThreadingTools
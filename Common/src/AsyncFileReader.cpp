@@ -0,0 +1,628 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "AsyncFileReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+
+#if PLATFORM_LINUX && defined(__has_include)
+#    if __has_include(<linux/io_uring.h>)
+#        include <linux/io_uring.h>
+#        include <sys/syscall.h>
+#        include <sys/mman.h>
+#        include <sys/stat.h>
+#        include <sys/uio.h>
+#        include <fcntl.h>
+#        include <unistd.h>
+#        include <cerrno>
+#        if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#            define IO_URING_SUPPORTED 1
+#        endif
+#    endif
+#endif
+
+#ifndef IO_URING_SUPPORTED
+#    define IO_URING_SUPPORTED 0
+#endif
+
+namespace Diligent
+{
+
+struct AsyncFileReader::ReadRequest
+{
+    String Path;
+    Uint32 FileIndex = 0;
+
+    std::shared_ptr<CallbackType> pCallback;
+
+    // Null if the file could not be read
+    RefCntAutoPtr<IDataBlob> pData;
+
+    // Whether the file has been read by the I/O thread
+    bool IsRead = false;
+
+#if IO_URING_SUPPORTED
+    int    fd     = -1;
+    size_t Offset = 0;
+    iovec  IOVec  = {};
+
+    // Index of the request in IOUringQueue::m_ReadsInFlight
+    size_t InFlightIndex = 0;
+#endif
+};
+
+
+#if IO_URING_SUPPORTED
+
+// Minimal io_uring submission/completion queue owned by a single I/O thread.
+// The rings are accessed directly as described in the io_uring(7) man page.
+class AsyncFileReader::IOUringQueue
+{
+public:
+    IOUringQueue(AsyncFileReader& Reader, Uint32 QueueDepth) :
+        m_Reader{Reader}
+    {
+        io_uring_params Params;
+        memset(&Params, 0, sizeof(Params));
+        m_RingFd = static_cast<int>(syscall(__NR_io_uring_setup, std::max(QueueDepth, 1u), &Params));
+        if (m_RingFd < 0)
+        {
+            LOG_INFO_MESSAGE("io_uring is not available (", strerror(errno), "). Files will be read by the worker threads.");
+            return;
+        }
+
+        m_SQRingSize = Params.sq_off.array + Params.sq_entries * sizeof(unsigned);
+        m_CQRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+
+        bool SingleMmap = false;
+#    ifdef IORING_FEAT_SINGLE_MMAP
+        SingleMmap = (Params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (SingleMmap)
+            m_SQRingSize = m_CQRingSize = std::max(m_SQRingSize, m_CQRingSize);
+#    endif
+
+        m_pSQRing = mmap(nullptr, m_SQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_SQ_RING);
+        if (m_pSQRing == MAP_FAILED)
+        {
+            m_pSQRing = nullptr;
+            Destroy();
+            return;
+        }
+
+        if (SingleMmap)
+        {
+            m_pCQRing = m_pSQRing;
+        }
+        else
+        {
+            m_pCQRing = mmap(nullptr, m_CQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_CQ_RING);
+            if (m_pCQRing == MAP_FAILED)
+            {
+                m_pCQRing = nullptr;
+                Destroy();
+                return;
+            }
+        }
+
+        m_SQEsSize  = Params.sq_entries * sizeof(io_uring_sqe);
+        void* pSQEs = mmap(nullptr, m_SQEsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_SQES);
+        if (pSQEs == MAP_FAILED)
+        {
+            Destroy();
+            return;
+        }
+        m_SQEs = static_cast<io_uring_sqe*>(pSQEs);
+
+        auto* pSQRing = static_cast<Uint8*>(m_pSQRing);
+        auto* pCQRing = static_cast<Uint8*>(m_pCQRing);
+
+        m_SQTail  = reinterpret_cast<unsigned*>(pSQRing + Params.sq_off.tail);
+        m_SQMask  = *reinterpret_cast<unsigned*>(pSQRing + Params.sq_off.ring_mask);
+        m_SQArray = reinterpret_cast<unsigned*>(pSQRing + Params.sq_off.array);
+        m_CQHead  = reinterpret_cast<unsigned*>(pCQRing + Params.cq_off.head);
+        m_CQTail  = reinterpret_cast<unsigned*>(pCQRing + Params.cq_off.tail);
+        m_CQMask  = *reinterpret_cast<unsigned*>(pCQRing + Params.cq_off.ring_mask);
+        m_CQEs    = reinterpret_cast<io_uring_cqe*>(pCQRing + Params.cq_off.cqes);
+
+        // The completion queue is at least twice as large as the submission queue, so limiting
+        // the number of reads in flight by the submission queue size prevents its overflow.
+        m_MaxReadsInFlight = Params.sq_entries;
+
+        m_Thread = std::thread{&IOUringQueue::ThreadFunc, this};
+    }
+
+    ~IOUringQueue()
+    {
+        if (m_Thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> Lock{m_Mtx};
+                m_Stop = true;
+            }
+            m_CV.notify_one();
+            m_Thread.join();
+        }
+        VERIFY(m_Queue.empty(), "All reads must be completed before the queue is destroyed");
+        Destroy();
+    }
+
+    bool IsValid() const
+    {
+        return m_SQEs != nullptr;
+    }
+
+    // Returns true if the I/O thread has stopped after an unrecoverable io_uring error
+    bool HasFailed() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_Failed;
+    }
+
+    // Takes the requests and returns true, or returns false and leaves
+    // the requests intact if the queue has failed.
+    bool Enqueue(std::vector<std::unique_ptr<ReadRequest>>& Requests)
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            if (m_Failed)
+                return false;
+            for (auto& pRequest : Requests)
+                m_Queue.emplace_back(std::move(pRequest));
+        }
+        m_CV.notify_one();
+        return true;
+    }
+
+private:
+    void Destroy()
+    {
+        if (m_SQEs != nullptr)
+            munmap(m_SQEs, m_SQEsSize);
+        if (m_pCQRing != nullptr && m_pCQRing != m_pSQRing)
+            munmap(m_pCQRing, m_CQRingSize);
+        if (m_pSQRing != nullptr)
+            munmap(m_pSQRing, m_SQRingSize);
+        if (m_RingFd >= 0)
+            close(m_RingFd);
+
+        m_SQEs    = nullptr;
+        m_pCQRing = nullptr;
+        m_pSQRing = nullptr;
+        m_RingFd  = -1;
+    }
+
+    static bool OpenFile(ReadRequest& Request)
+    {
+        // Resolve the path the same way as FileWrapper does
+        auto FullPath = FileSystem::GetFullPath(Request.Path.c_str());
+        FileSystem::CorrectSlashes(FullPath, FileSystem::GetSlashSymbol());
+
+        Request.fd = open(FullPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (Request.fd < 0)
+        {
+            LOG_ERROR_MESSAGE("Failed to open file ", FullPath, "\nThe following error occured: ", strerror(errno));
+            return false;
+        }
+
+        struct stat FileStat;
+        if (fstat(Request.fd, &FileStat) != 0 || !S_ISREG(FileStat.st_mode))
+        {
+            LOG_ERROR_MESSAGE("Failed to query the size of file ", FullPath);
+            close(Request.fd);
+            Request.fd = -1;
+            return false;
+        }
+
+        Request.pData = MakeNewRCObj<DataBlobImpl>()(static_cast<size_t>(FileStat.st_size));
+        return true;
+    }
+
+    static void CloseFile(ReadRequest& Request)
+    {
+        if (Request.fd >= 0)
+        {
+            close(Request.fd);
+            Request.fd = -1;
+        }
+    }
+
+    void PrepareRead(ReadRequest& Request)
+    {
+        // The I/O thread is the only producer, so the tail does not need to be loaded atomically
+        const auto Tail  = *m_SQTail;
+        const auto Index = Tail & m_SQMask;
+
+        auto& SQE = m_SQEs[Index];
+        memset(&SQE, 0, sizeof(SQE));
+
+        Request.IOVec.iov_base = static_cast<Uint8*>(Request.pData->GetDataPtr()) + Request.Offset;
+        Request.IOVec.iov_len  = Request.pData->GetSize() - Request.Offset;
+
+        SQE.opcode    = IORING_OP_READV;
+        SQE.fd        = Request.fd;
+        SQE.addr      = reinterpret_cast<Uint64>(&Request.IOVec);
+        SQE.len       = 1;
+        SQE.off       = Request.Offset;
+        SQE.user_data = reinterpret_cast<Uint64>(&Request);
+
+        m_SQArray[Index] = Index;
+        // Make the entry visible to the kernel before the tail is updated
+        __atomic_store_n(m_SQTail, Tail + 1, __ATOMIC_RELEASE);
+        ++m_NumUnsubmitted;
+    }
+
+    void AddReadInFlight(std::unique_ptr<ReadRequest>&& pRequest)
+    {
+        // The request is owned by the ring until its read completes
+        pRequest->InFlightIndex = m_ReadsInFlight.size();
+        m_ReadsInFlight.emplace_back(pRequest.release());
+        PrepareRead(*m_ReadsInFlight.back());
+    }
+
+    void CompleteRead(ReadRequest* pRequest, bool Succeeded)
+    {
+        VERIFY_EXPR(pRequest->InFlightIndex < m_ReadsInFlight.size() && m_ReadsInFlight[pRequest->InFlightIndex] == pRequest);
+        m_ReadsInFlight[pRequest->InFlightIndex]                = m_ReadsInFlight.back();
+        m_ReadsInFlight[pRequest->InFlightIndex]->InFlightIndex = pRequest->InFlightIndex;
+        m_ReadsInFlight.pop_back();
+
+        std::unique_ptr<ReadRequest> pReq{pRequest};
+        CloseFile(*pReq);
+        if (!Succeeded)
+            pReq->pData.Release();
+        pReq->IsRead = true;
+        m_Reader.OnReadCompleted(std::move(pReq));
+    }
+
+    void ReapCompletions()
+    {
+        auto       Head = *m_CQHead;
+        const auto Tail = __atomic_load_n(m_CQTail, __ATOMIC_ACQUIRE);
+        for (; Head != Tail; ++Head)
+        {
+            const auto& CQE      = m_CQEs[Head & m_CQMask];
+            auto*       pRequest = reinterpret_cast<ReadRequest*>(CQE.user_data);
+            const auto  Res      = CQE.res;
+
+            if (Res == -EINTR || Res == -EAGAIN)
+            {
+                PrepareRead(*pRequest);
+            }
+            else if (Res < 0)
+            {
+                LOG_ERROR_MESSAGE("Failed to read file ", pRequest->Path, "\nThe following error occured: ", strerror(-Res));
+                CompleteRead(pRequest, false);
+            }
+            else if (Res == 0)
+            {
+                LOG_ERROR_MESSAGE("Unexpected end of file ", pRequest->Path, ". The file may have been truncated while it was being read.");
+                CompleteRead(pRequest, false);
+            }
+            else
+            {
+                pRequest->Offset += static_cast<size_t>(Res);
+                if (pRequest->Offset < pRequest->pData->GetSize())
+                    PrepareRead(*pRequest); // Short read
+                else
+                    CompleteRead(pRequest, true);
+            }
+        }
+        __atomic_store_n(m_CQHead, Head, __ATOMIC_RELEASE);
+    }
+
+    // Called by the I/O thread when io_uring_enter fails with an unrecoverable error.
+    // Completes all reads in flight as failed and hands the queued requests over to the worker threads.
+    void OnRingFailed()
+    {
+        std::deque<std::unique_ptr<ReadRequest>> QueuedRequests;
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_Failed = true;
+            QueuedRequests.swap(m_Queue);
+        }
+
+        while (!m_ReadsInFlight.empty())
+        {
+            auto* pRequest = m_ReadsInFlight.back();
+            LOG_ERROR_MESSAGE("Failed to read file ", pRequest->Path, ": the io_uring queue has failed.");
+            // The kernel may still be writing to the buffer, so it is kept alive until the ring is closed
+            m_AbandonedBuffers.emplace_back(pRequest->pData);
+            CompleteRead(pRequest, false);
+        }
+        m_NumUnsubmitted = 0;
+
+        // The requests have not been started and will be read by the worker threads
+        for (auto& pRequest : QueuedRequests)
+            m_Reader.OnReadCompleted(std::move(pRequest));
+    }
+
+    void ThreadFunc()
+    {
+        std::vector<std::unique_ptr<ReadRequest>> NewRequests;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> Lock{m_Mtx};
+                if (m_ReadsInFlight.empty())
+                    m_CV.wait(Lock, [this]() { return m_Stop || !m_Queue.empty(); });
+
+                if (m_ReadsInFlight.empty() && m_Queue.empty())
+                {
+                    VERIFY_EXPR(m_Stop);
+                    break;
+                }
+
+                while (!m_Queue.empty() && m_ReadsInFlight.size() + NewRequests.size() < m_MaxReadsInFlight)
+                {
+                    NewRequests.emplace_back(std::move(m_Queue.front()));
+                    m_Queue.pop_front();
+                }
+            }
+
+            for (auto& pRequest : NewRequests)
+            {
+                if (!OpenFile(*pRequest))
+                {
+                    pRequest->IsRead = true;
+                    m_Reader.OnReadCompleted(std::move(pRequest));
+                }
+                else if (pRequest->pData->GetSize() == 0)
+                {
+                    CloseFile(*pRequest);
+                    pRequest->IsRead = true;
+                    m_Reader.OnReadCompleted(std::move(pRequest));
+                }
+                else
+                {
+                    AddReadInFlight(std::move(pRequest));
+                }
+            }
+            NewRequests.clear();
+
+            if (!m_ReadsInFlight.empty())
+            {
+                // Submit new reads and wait for at least one of the reads to complete
+                auto Res = syscall(__NR_io_uring_enter, m_RingFd, m_NumUnsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (Res >= 0)
+                {
+                    VERIFY_EXPR(static_cast<Uint32>(Res) <= m_NumUnsubmitted);
+                    m_NumUnsubmitted -= static_cast<Uint32>(Res);
+                }
+                else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                {
+                    LOG_ERROR_MESSAGE("io_uring_enter failed: ", strerror(errno), ". Files will be read by the worker threads.");
+                    ReapCompletions();
+                    OnRingFailed();
+                    break;
+                }
+                ReapCompletions();
+            }
+        }
+    }
+
+    AsyncFileReader& m_Reader;
+
+    int           m_RingFd     = -1;
+    void*         m_pSQRing    = nullptr;
+    void*         m_pCQRing    = nullptr;
+    size_t        m_SQRingSize = 0;
+    size_t        m_CQRingSize = 0;
+    size_t        m_SQEsSize   = 0;
+    io_uring_sqe* m_SQEs       = nullptr;
+
+    unsigned*     m_SQTail  = nullptr;
+    unsigned      m_SQMask  = 0;
+    unsigned*     m_SQArray = nullptr;
+    unsigned*     m_CQHead  = nullptr;
+    unsigned*     m_CQTail  = nullptr;
+    unsigned      m_CQMask  = 0;
+    io_uring_cqe* m_CQEs    = nullptr;
+
+    // Accessed by the I/O thread only
+    Uint32                                m_MaxReadsInFlight = 0;
+    Uint32                                m_NumUnsubmitted   = 0;
+    std::vector<ReadRequest*>             m_ReadsInFlight;
+    std::vector<RefCntAutoPtr<IDataBlob>> m_AbandonedBuffers;
+
+    mutable std::mutex                       m_Mtx;
+    std::condition_variable                  m_CV;
+    std::deque<std::unique_ptr<ReadRequest>> m_Queue;
+    bool                                     m_Stop   = false;
+    bool                                     m_Failed = false;
+
+    std::thread m_Thread;
+};
+
+#else
+
+class AsyncFileReader::IOUringQueue
+{
+public:
+    IOUringQueue(AsyncFileReader&, Uint32) {}
+
+    bool IsValid() const { return false; }
+
+    bool HasFailed() const { return true; }
+
+    bool Enqueue(std::vector<std::unique_ptr<ReadRequest>>&)
+    {
+        UNEXPECTED("io_uring is not supported on this platform");
+        return false;
+    }
+};
+
+#endif
+
+
+AsyncFileReader::AsyncFileReader(const AsyncFileReaderCreateInfo& CI)
+{
+    if (CI.UseIOUring)
+    {
+        m_IOUring.reset(new IOUringQueue{*this, CI.QueueDepth});
+        if (!m_IOUring->IsValid())
+            m_IOUring.reset();
+    }
+
+    auto NumThreads = CI.NumThreads;
+    if (NumThreads == 0)
+        NumThreads = std::max(std::min(std::thread::hardware_concurrency(), 4u), 1u);
+
+    m_WorkerThreads.reserve(NumThreads);
+    for (Uint32 i = 0; i < NumThreads; ++i)
+        m_WorkerThreads.emplace_back(&AsyncFileReader::WorkerThreadFunc, this);
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+    WaitIdle();
+
+    // Stop the I/O thread first as it posts completed reads to the worker threads
+    m_IOUring.reset();
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Stop = true;
+    }
+    m_WorkCV.notify_all();
+    for (auto& Thread : m_WorkerThreads)
+        Thread.join();
+}
+
+void AsyncFileReader::ReadFiles(const Char* const* Paths, Uint32 NumFiles, CallbackType Callback)
+{
+    if (NumFiles == 0)
+        return;
+
+    VERIFY_EXPR(Paths != nullptr && Callback);
+    auto pCallback = std::make_shared<CallbackType>(std::move(Callback));
+
+    std::vector<std::unique_ptr<ReadRequest>> Requests(NumFiles);
+    for (Uint32 i = 0; i < NumFiles; ++i)
+    {
+        auto& pRequest = Requests[i];
+        pRequest.reset(new ReadRequest);
+        VERIFY_EXPR(Paths[i] != nullptr);
+        pRequest->Path      = Paths[i];
+        pRequest->FileIndex = i;
+        pRequest->pCallback = pCallback;
+    }
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_NumPendingReads += NumFiles;
+    }
+
+    // The queue rejects the requests if it has failed
+    if (m_IOUring && m_IOUring->Enqueue(Requests))
+        return;
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        for (auto& pRequest : Requests)
+            m_WorkQueue.emplace_back(std::move(pRequest));
+    }
+    m_WorkCV.notify_all();
+}
+
+bool AsyncFileReader::IsUsingIOUring() const
+{
+    return m_IOUring && !m_IOUring->HasFailed();
+}
+
+void AsyncFileReader::WaitIdle()
+{
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+    m_IdleCV.wait(Lock, [this]() { return m_NumPendingReads == 0; });
+}
+
+Uint32 AsyncFileReader::GetNumPendingReads() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_NumPendingReads;
+}
+
+void AsyncFileReader::OnReadCompleted(std::unique_ptr<ReadRequest>&& pRequest)
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_WorkQueue.emplace_back(std::move(pRequest));
+    }
+    m_WorkCV.notify_one();
+}
+
+void AsyncFileReader::ReadFile(ReadRequest& Request)
+{
+    FileWrapper File{Request.Path.c_str(), EFileAccessMode::Read};
+    if (!File)
+        return;
+
+    const auto Size = File->GetSize();
+
+    RefCntAutoPtr<IDataBlob> pData{MakeNewRCObj<DataBlobImpl>()(Size)};
+    if (Size == 0 || File->Read(pData->GetDataPtr(), Size))
+        Request.pData = std::move(pData);
+    else
+        LOG_ERROR_MESSAGE("Failed to read file ", Request.Path);
+}
+
+void AsyncFileReader::WorkerThreadFunc()
+{
+    while (true)
+    {
+        std::unique_ptr<ReadRequest> pRequest;
+        {
+            std::unique_lock<std::mutex> Lock{m_Mtx};
+            m_WorkCV.wait(Lock, [this]() { return m_Stop || !m_WorkQueue.empty(); });
+            if (m_WorkQueue.empty())
+                break;
+
+            pRequest = std::move(m_WorkQueue.front());
+            m_WorkQueue.pop_front();
+        }
+
+        if (!pRequest->IsRead)
+            ReadFile(*pRequest);
+
+        (*pRequest->pCallback)(pRequest->FileIndex, pRequest->Path.c_str(), pRequest->pData);
+        pRequest.reset();
+
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            VERIFY_EXPR(m_NumPendingReads > 0);
+            if (--m_NumPendingReads == 0)
+                m_IdleCV.notify_all();
+        }
+    }
+}
+
+} // namespace Diligent
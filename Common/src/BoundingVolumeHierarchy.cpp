@@ -0,0 +1,283 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "BoundingVolumeHierarchy.hpp"
+
+#include <algorithm>
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Half of the box surface area, which is sufficient for the SAH cost comparison
+float GetHalfSurfaceArea(const BoundBox& Box)
+{
+    const float3 Size = Box.Max - Box.Min;
+    return Size.x * Size.y + Size.y * Size.z + Size.z * Size.x;
+}
+
+BoundBox GetEmptyBox()
+{
+    return BoundBox{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+}
+
+void ExpandBox(BoundBox& Box, const float3& Min, const float3& Max)
+{
+    Box.Min = std::min(Box.Min, Min);
+    Box.Max = std::max(Box.Max, Max);
+}
+
+} // namespace
+
+struct BoundingVolumeHierarchy::BuildContext
+{
+    static constexpr Uint32 NumBins = 16;
+
+    // Below this depth, primitives are split at the median to bound the tree depth
+    static constexpr Uint32 MaxSAHDepth = 64;
+
+    // The cost of traversing a node relative to the cost of intersecting a primitive
+    static constexpr float TraversalCost = 1.f;
+
+    const BoundBox* pBoxes      = nullptr;
+    Uint32          MaxLeafSize = 0;
+
+    std::vector<float3> Centroids;
+};
+
+void BoundingVolumeHierarchy::Clear()
+{
+    m_Nodes.clear();
+    m_PrimitiveIndices.clear();
+    m_PrimitiveBoxes.clear();
+}
+
+void BoundingVolumeHierarchy::Build(const BoundBox* pBoxes, Uint32 NumBoxes, Uint32 MaxLeafSize)
+{
+    Clear();
+    if (NumBoxes == 0)
+        return;
+
+    VERIFY(pBoxes != nullptr, "Bounding boxes must not be null");
+    MaxLeafSize = std::min(std::max(MaxLeafSize, 1u), 255u);
+
+    BuildContext Ctx;
+    Ctx.pBoxes      = pBoxes;
+    Ctx.MaxLeafSize = MaxLeafSize;
+    Ctx.Centroids.resize(NumBoxes);
+    m_PrimitiveIndices.resize(NumBoxes);
+    for (Uint32 i = 0; i < NumBoxes; ++i)
+    {
+        Ctx.Centroids[i]      = (pBoxes[i].Min + pBoxes[i].Max) * 0.5f;
+        m_PrimitiveIndices[i] = i;
+    }
+
+    // A binary tree with at most MaxLeafSize primitives per leaf never has more than 2*N-1 nodes
+    m_Nodes.reserve(size_t{NumBoxes} * 2 - 1);
+    BuildNode(Ctx, 0, NumBoxes, 0);
+    m_Nodes.shrink_to_fit();
+
+    m_PrimitiveBoxes.resize(NumBoxes);
+    for (Uint32 i = 0; i < NumBoxes; ++i)
+        m_PrimitiveBoxes[i] = pBoxes[m_PrimitiveIndices[i]];
+}
+
+Uint32 BoundingVolumeHierarchy::BuildNode(BuildContext& Ctx, Uint32 Begin, Uint32 End, Uint32 Depth)
+{
+    VERIFY_EXPR(End > Begin);
+    VERIFY(Depth < MaxTreeDepth - 2, "The tree is too deep");
+
+    const auto NodeIdx = static_cast<Uint32>(m_Nodes.size());
+    m_Nodes.emplace_back();
+
+    const Uint32 NumPrims = End - Begin;
+
+    BoundBox NodeBox     = GetEmptyBox();
+    BoundBox CentroidBox = GetEmptyBox();
+    for (Uint32 i = Begin; i < End; ++i)
+    {
+        const auto  PrimIdx  = m_PrimitiveIndices[i];
+        const auto& Centroid = Ctx.Centroids[PrimIdx];
+        ExpandBox(NodeBox, Ctx.pBoxes[PrimIdx].Min, Ctx.pBoxes[PrimIdx].Max);
+        ExpandBox(CentroidBox, Centroid, Centroid);
+    }
+    m_Nodes[NodeIdx].Box = NodeBox;
+
+    const auto MakeLeaf = [&]() {
+        auto& Leaf         = m_Nodes[NodeIdx];
+        Leaf.Offset        = Begin;
+        Leaf.NumPrimitives = static_cast<Uint16>(NumPrims);
+        return NodeIdx;
+    };
+
+    if (NumPrims == 1)
+        return MakeLeaf();
+
+    const float3 CentroidExtent = CentroidBox.Max - CentroidBox.Min;
+
+    int   SplitAxis = CentroidExtent.x >= CentroidExtent.y && CentroidExtent.x >= CentroidExtent.z ? 0 : (CentroidExtent.y >= CentroidExtent.z ? 1 : 2);
+    Int32 SplitBin  = -1;
+    float BestCost  = +FLT_MAX;
+    auto  GetBinIdx = [&](const float3& Centroid, int Axis) {
+        const auto Scale = static_cast<float>(BuildContext::NumBins) / CentroidExtent[Axis];
+        const auto Bin   = static_cast<Int32>((Centroid[Axis] - CentroidBox.Min[Axis]) * Scale);
+        return std::min(std::max(Bin, 0), static_cast<Int32>(BuildContext::NumBins) - 1);
+    };
+
+    if (Depth < BuildContext::MaxSAHDepth)
+    {
+        // Binned SAH: evaluate NumBins-1 split candidates along every axis
+        for (int Axis = 0; Axis < 3; ++Axis)
+        {
+            if (CentroidExtent[Axis] <= 0)
+                continue;
+
+            BoundBox BinBoxes[BuildContext::NumBins];
+            Uint32   BinCounts[BuildContext::NumBins] = {};
+            for (auto& Box : BinBoxes)
+                Box = GetEmptyBox();
+
+            for (Uint32 i = Begin; i < End; ++i)
+            {
+                const auto PrimIdx = m_PrimitiveIndices[i];
+                const auto Bin     = GetBinIdx(Ctx.Centroids[PrimIdx], Axis);
+                ExpandBox(BinBoxes[Bin], Ctx.pBoxes[PrimIdx].Min, Ctx.pBoxes[PrimIdx].Max);
+                ++BinCounts[Bin];
+            }
+
+            // Sweep from the right to compute the costs of the right parts
+            float    RightArea[BuildContext::NumBins];
+            Uint32   RightCount[BuildContext::NumBins];
+            BoundBox RightBox   = GetEmptyBox();
+            Uint32   RightPrims = 0;
+            for (Uint32 b = BuildContext::NumBins - 1; b > 0; --b)
+            {
+                ExpandBox(RightBox, BinBoxes[b].Min, BinBoxes[b].Max);
+                RightPrims += BinCounts[b];
+                RightArea[b]  = RightPrims > 0 ? GetHalfSurfaceArea(RightBox) : 0;
+                RightCount[b] = RightPrims;
+            }
+
+            BoundBox LeftBox   = GetEmptyBox();
+            Uint32   LeftPrims = 0;
+            for (Uint32 b = 0; b < BuildContext::NumBins - 1; ++b)
+            {
+                ExpandBox(LeftBox, BinBoxes[b].Min, BinBoxes[b].Max);
+                LeftPrims += BinCounts[b];
+                if (LeftPrims == 0 || RightCount[b + 1] == 0)
+                    continue;
+
+                const float Cost = GetHalfSurfaceArea(LeftBox) * LeftPrims + RightArea[b + 1] * RightCount[b + 1];
+                if (Cost < BestCost)
+                {
+                    BestCost  = Cost;
+                    SplitAxis = Axis;
+                    SplitBin  = static_cast<Int32>(b);
+                }
+            }
+        }
+
+        if (NumPrims <= Ctx.MaxLeafSize)
+        {
+            // Compare the split cost with the cost of intersecting all primitives in the leaf
+            const float NodeArea = GetHalfSurfaceArea(NodeBox);
+            const float LeafCost = static_cast<float>(NumPrims);
+            if (SplitBin < 0 || NodeArea <= 0 || BuildContext::TraversalCost + BestCost / NodeArea >= LeafCost)
+                return MakeLeaf();
+        }
+    }
+    else if (NumPrims <= Ctx.MaxLeafSize)
+    {
+        return MakeLeaf();
+    }
+
+    auto* const pFirst = m_PrimitiveIndices.data() + Begin;
+    auto* const pLast  = m_PrimitiveIndices.data() + End;
+
+    Uint32 Mid = Begin;
+    if (SplitBin >= 0)
+    {
+        const auto* pMid = std::partition(pFirst, pLast, [&](Uint32 PrimIdx) {
+            return GetBinIdx(Ctx.Centroids[PrimIdx], SplitAxis) <= SplitBin;
+        });
+        Mid              = static_cast<Uint32>(pMid - m_PrimitiveIndices.data());
+    }
+
+    if (Mid == Begin || Mid == End)
+    {
+        // SAH split is not available (all centroids coincide or the tree is too deep):
+        // split the primitives in two equal halves
+        Mid = Begin + NumPrims / 2;
+        std::nth_element(pFirst, m_PrimitiveIndices.data() + Mid, pLast, [&](Uint32 PrimIdx0, Uint32 PrimIdx1) {
+            return Ctx.Centroids[PrimIdx0][SplitAxis] < Ctx.Centroids[PrimIdx1][SplitAxis];
+        });
+    }
+
+    m_Nodes[NodeIdx].SplitAxis = static_cast<Uint16>(SplitAxis);
+
+    // The left child immediately follows the parent
+    BuildNode(Ctx, Begin, Mid, Depth + 1);
+    const auto RightChildIdx = BuildNode(Ctx, Mid, End, Depth + 1);
+
+    m_Nodes[NodeIdx].Offset = RightChildIdx;
+    return NodeIdx;
+}
+
+void BoundingVolumeHierarchy::GetVisiblePrimitives(const ViewFrustum& Frustum, std::vector<Uint32>& Primitives, FRUSTUM_PLANE_FLAGS PlaneFlags) const
+{
+    QueryFrustum(
+        Frustum,
+        [&Primitives](Uint32 PrimitiveIndex, BoxVisibility) {
+            Primitives.push_back(PrimitiveIndex);
+        },
+        PlaneFlags);
+}
+
+bool BoundingVolumeHierarchy::IntersectRayTriangles(const float3& RayOrigin,
+                                                    const float3& RayDirection,
+                                                    const float3* pVertices,
+                                                    const Uint32* pIndices,
+                                                    float&        HitDistance,
+                                                    Uint32&       HitTriangle,
+                                                    bool          CullBackFace) const
+{
+    VERIFY_EXPR(pVertices != nullptr && pIndices != nullptr);
+    return IntersectRay(
+        RayOrigin, RayDirection,
+        [&](Uint32 Triangle) {
+            const auto* pTriIndices = pIndices + size_t{Triangle} * 3;
+            return IntersectRayTriangle(pVertices[pTriIndices[0]], pVertices[pTriIndices[1]], pVertices[pTriIndices[2]],
+                                        RayOrigin, RayDirection, CullBackFace);
+        },
+        HitDistance, HitTriangle);
+}
+
+} // namespace Diligent
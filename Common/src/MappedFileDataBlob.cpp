@@ -0,0 +1,112 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "MappedFileDataBlob.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "FileWrapper.hpp"
+
+namespace Diligent
+{
+
+MappedFileDataBlob::MappedFileDataBlob(IReferenceCounters* pRefCounters, const Char* Path) :
+    TBase{pRefCounters}
+{
+    VERIFY_EXPR(Path != nullptr);
+
+    m_IsValid = FileSystem::MapFile(Path, m_pMappedData, m_MappedSize);
+    if (!m_IsValid)
+    {
+        // Memory mapping is not available - read the entire file instead
+        FileWrapper File{Path, EFileAccessMode::Read};
+        if (File)
+        {
+            m_DataBuff.resize(File->GetSize());
+            m_IsValid = m_DataBuff.empty() || File->Read(m_DataBuff.data(), m_DataBuff.size());
+            if (!m_IsValid)
+            {
+                LOG_ERROR_MESSAGE("Failed to read file ", Path);
+                m_DataBuff.clear();
+            }
+        }
+    }
+}
+
+MappedFileDataBlob::~MappedFileDataBlob()
+{
+    ReleaseMapping();
+}
+
+IMPLEMENT_QUERY_INTERFACE(MappedFileDataBlob, IID_DataBlob, TBase)
+
+void MappedFileDataBlob::ReleaseMapping()
+{
+    if (m_pMappedData != nullptr)
+    {
+        FileSystem::UnmapFile(m_pMappedData, m_MappedSize);
+        m_pMappedData = nullptr;
+        m_MappedSize  = 0;
+    }
+}
+
+void MappedFileDataBlob::Resize(size_t NewSize)
+{
+    if (m_pMappedData != nullptr)
+    {
+        if (NewSize == m_MappedSize)
+            return;
+
+        m_DataBuff.resize(NewSize);
+        memcpy(m_DataBuff.data(), m_pMappedData, std::min(NewSize, m_MappedSize));
+        ReleaseMapping();
+    }
+    else
+    {
+        m_DataBuff.resize(NewSize);
+    }
+}
+
+size_t MappedFileDataBlob::GetSize() const
+{
+    return m_pMappedData != nullptr ? m_MappedSize : m_DataBuff.size();
+}
+
+void* MappedFileDataBlob::GetDataPtr()
+{
+    return m_pMappedData != nullptr ? m_pMappedData : m_DataBuff.data();
+}
+
+const void* MappedFileDataBlob::GetConstDataPtr() const
+{
+    return m_pMappedData != nullptr ? m_pMappedData : m_DataBuff.data();
+}
+
+} // namespace Diligent
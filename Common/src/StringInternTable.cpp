@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "StringInternTable.hpp"
+
+#include <algorithm>
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+StringInternTable::StringInternTable(size_t PageSize) :
+    m_PageSize{PageSize}
+{
+}
+
+StringInternTable::~StringInternTable()
+{
+}
+
+InternedString StringInternTable::Intern(const Char* Str)
+{
+    VERIFY(Str != nullptr, "String must not be null");
+    return Intern(Str, CStringHash<Char>{}(Str));
+}
+
+InternedString StringInternTable::Intern(const Char* Str, size_t Hash)
+{
+    VERIFY(Str != nullptr, "String must not be null");
+    VERIFY(Hash == CStringHash<Char>{}(Str), "Incorrect string hash");
+
+    auto& Shard = GetShard(Hash);
+
+    // The key does not copy the string
+    HashMapStringKey Key{Str, false, Hash};
+    {
+        ThreadingTools::SharedLockGuard Lock{Shard.Lock};
+
+        auto it = Shard.Strings.find(Key);
+        if (it != Shard.Strings.end())
+            return InternedString{it->GetStr()};
+    }
+
+    ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveRWLock> Lock{Shard.Lock};
+
+    // Another thread may have added the string while the lock was released
+    auto it = Shard.Strings.find(Key);
+    if (it != Shard.Strings.end())
+        return InternedString{it->GetStr()};
+
+    return InternedString{AddString(Shard, Str, Hash)};
+}
+
+const Char* StringInternTable::AddString(Shard& Shard, const Char* Str, size_t Hash)
+{
+    // Every string is preceded by its hash
+    const auto Len       = strlen(Str);
+    const auto EntrySize = sizeof(size_t) + (Len + 1) * sizeof(Char);
+
+    auto* pPage = !Shard.Pages.empty() ? &Shard.Pages.back() : nullptr;
+    if (pPage != nullptr)
+    {
+        // Skip the bytes needed to align the hash
+        const auto* pCurr   = pPage->Allocate(0);
+        const auto  Padding = Align(reinterpret_cast<size_t>(pCurr), alignof(size_t)) - reinterpret_cast<size_t>(pCurr);
+        if (pPage->GetRemainingSize() >= Padding + EntrySize)
+            pPage->Allocate(Padding);
+        else
+            pPage = nullptr;
+    }
+
+    if (pPage == nullptr)
+    {
+        Shard.Pages.emplace_back();
+        pPage = &Shard.Pages.back();
+        // Page memory is allocated by the default allocator and is aligned for size_t
+        pPage->Reserve(std::max(m_PageSize, EntrySize), DefaultRawMemoryAllocator::GetAllocator());
+    }
+
+    auto* pEntry = pPage->Allocate(EntrySize);
+    memcpy(pEntry, &Hash, sizeof(Hash));
+    auto* pStr = pEntry + sizeof(size_t);
+    memcpy(pStr, Str, (Len + 1) * sizeof(Char));
+
+    Shard.Strings.emplace(pStr, false, Hash);
+
+    return pStr;
+}
+
+InternedString StringInternTable::Find(const Char* Str) const
+{
+    VERIFY(Str != nullptr, "String must not be null");
+
+    const auto Hash  = CStringHash<Char>{}(Str);
+    auto&      Shard = GetShard(Hash);
+
+    ThreadingTools::SharedLockGuard Lock{Shard.Lock};
+
+    auto it = Shard.Strings.find(HashMapStringKey{Str, false, Hash});
+    return it != Shard.Strings.end() ? InternedString{it->GetStr()} : InternedString{};
+}
+
+size_t StringInternTable::GetNumStrings() const
+{
+    size_t NumStrings = 0;
+    for (auto& Shard : m_Shards)
+    {
+        ThreadingTools::SharedLockGuard Lock{Shard.Lock};
+        NumStrings += Shard.Strings.size();
+    }
+    return NumStrings;
+}
+
+size_t StringInternTable::GetMemorySize() const
+{
+    size_t MemorySize = 0;
+    for (auto& Shard : m_Shards)
+    {
+        ThreadingTools::SharedLockGuard Lock{Shard.Lock};
+        for (const auto& Page : Shard.Pages)
+            MemorySize += Page.GetUsedSize() + Page.GetRemainingSize();
+    }
+    return MemorySize;
+}
+
+StringInternTable& StringInternTable::GetGlobal()
+{
+    static StringInternTable GlobalTable;
+    return GlobalTable;
+}
+
+} // namespace Diligent
@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "WorkerThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Diligent
+{
+
+struct WorkerThreadPool::Job
+{
+    Job(Uint32 _NumTasks, const std::function<void(Uint32)>& _Func) :
+        NumTasks{_NumTasks},
+        Func{_Func}
+    {}
+
+    // Runs the tasks that have not been started yet
+    void Run()
+    {
+        Uint32 NumRun = 0;
+        // Func is only accessed while there are unfinished tasks, i.e. before ParallelFor returns.
+        for (auto Task = NextTask.fetch_add(1); Task < NumTasks; Task = NextTask.fetch_add(1))
+        {
+            Func(Task);
+            ++NumRun;
+        }
+
+        if (NumRun > 0 && NumCompleted.fetch_add(NumRun) + NumRun == NumTasks)
+        {
+            std::lock_guard<std::mutex> Lock{Mtx};
+            CompletedCV.notify_all();
+        }
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> Lock{Mtx};
+        CompletedCV.wait(Lock, [this]() { return NumCompleted.load() == NumTasks; });
+    }
+
+    const Uint32                       NumTasks;
+    const std::function<void(Uint32)>& Func;
+
+    std::atomic<Uint32> NextTask{0};
+    std::atomic<Uint32> NumCompleted{0};
+
+    std::mutex              Mtx;
+    std::condition_variable CompletedCV;
+};
+
+WorkerThreadPool::WorkerThreadPool(Uint32 NumThreads)
+{
+    m_Threads.reserve(NumThreads);
+    for (Uint32 i = 0; i < NumThreads; ++i)
+        m_Threads.emplace_back(&WorkerThreadPool::WorkerThreadFunc, this);
+}
+
+WorkerThreadPool::~WorkerThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Stop = true;
+    }
+    m_CV.notify_all();
+    for (auto& Thread : m_Threads)
+        Thread.join();
+}
+
+void WorkerThreadPool::ParallelFor(Uint32 NumTasks, const std::function<void(Uint32)>& Func)
+{
+    if (NumTasks == 0)
+        return;
+
+    const auto NumHelpers = std::min(NumTasks - 1, GetNumThreads());
+    if (NumHelpers == 0)
+    {
+        for (Uint32 Task = 0; Task < NumTasks; ++Task)
+            Func(Task);
+        return;
+    }
+
+    // The job is shared with the workers, which may pick it up after all tasks have completed
+    auto pJob = std::make_shared<Job>(NumTasks, Func);
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        for (Uint32 i = 0; i < NumHelpers; ++i)
+            m_Queue.emplace_back(pJob);
+    }
+    if (NumHelpers == 1)
+        m_CV.notify_one();
+    else
+        m_CV.notify_all();
+
+    pJob->Run();
+    pJob->Wait();
+}
+
+void WorkerThreadPool::WorkerThreadFunc()
+{
+    while (true)
+    {
+        std::shared_ptr<Job> pJob;
+        {
+            std::unique_lock<std::mutex> Lock{m_Mtx};
+            m_CV.wait(Lock, [this]() { return m_Stop || !m_Queue.empty(); });
+            if (m_Queue.empty())
+                break;
+
+            pJob = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        pJob->Run();
+    }
+}
+
+WorkerThreadPool& WorkerThreadPool::GetDefault()
+{
+    static WorkerThreadPool DefaultPool{std::max(std::thread::hardware_concurrency(), 1u) - 1};
+    return DefaultPool;
+}
+
+} // namespace Diligent
@@ -35,6 +35,9 @@
 //   m_MemoryBuffer                                                                                                              m_TotalResources
 //    |                                                                                                                             |                                       |
 //    | Uniform Buffers | Storage Buffers | Storage Images | Sampled Images | Atomic Counters | Separate Samplers | Separate Images |   Stage Inputs   |   Resource Names   |
+//
+//    Names of the resources are interned in the global StringInternTable, so that they are shared by all shaders,
+//    and Resource Names only store the combined sampler suffix, the shader name and stage input semantics.
 
 #include <memory>
 #include <vector>
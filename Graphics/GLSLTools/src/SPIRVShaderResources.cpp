@@ -32,6 +32,7 @@
 #include "ShaderBase.hpp"
 #include "GraphicsAccessories.hpp"
 #include "StringTools.hpp"
+#include "StringInternTable.hpp"
 #include "Align.hpp"
 
 namespace Diligent
@@ -241,24 +242,9 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
     // The SPIR-V is now parsed, and we can perform reflection on it.
     diligent_spirv_cross::ShaderResources resources = Compiler.get_shader_resources();
 
+    // Resource names are interned in the global table and are shared by all shaders,
+    // so that the pool only stores the suffix, the shader name and the input semantics.
     size_t ResourceNamesPoolSize = 0;
-    for (const auto& ub : resources.uniform_buffers)
-        ResourceNamesPoolSize += GetUBName(Compiler, ub, ParsedIRSource).length() + 1;
-    for (auto* pResType :
-         {
-             &resources.storage_buffers,
-             &resources.storage_images,
-             &resources.sampled_images,
-             &resources.atomic_counters,
-             &resources.separate_images,
-             &resources.separate_samplers
-             //clang-format off
-         })
-    //clang-format on
-    {
-        for (const auto& res : *pResType)
-            ResourceNamesPoolSize += res.name.length() + 1;
-    }
 
     if (CombinedSamplerSuffix != nullptr)
     {
@@ -319,6 +305,8 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
     ResCounters.NumSepImgs   = static_cast<Uint32>(resources.separate_images.size());
     Initialize(Allocator, ResCounters, NumShaderStageInputs, ResourceNamesPoolSize);
 
+    auto& NamesTable = StringInternTable::GetGlobal();
+
     {
         Uint32 CurrUB = 0;
         for (const auto& UB : resources.uniform_buffers)
@@ -327,7 +315,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
             new (&GetUB(CurrUB++))
                 SPIRVShaderResourceAttribs(Compiler,
                                            UB,
-                                           m_ResourceNames.CopyString(name),
+                                           NamesTable.Intern(name.c_str()).GetStr(),
                                            SPIRVShaderResourceAttribs::ResourceType::UniformBuffer);
         }
         VERIFY_EXPR(CurrUB == GetNumUBs());
@@ -345,7 +333,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
             new (&GetSB(CurrSB++))
                 SPIRVShaderResourceAttribs(Compiler,
                                            SB,
-                                           m_ResourceNames.CopyString(SB.name),
+                                           NamesTable.Intern(SB.name.c_str()).GetStr(),
                                            ResType);
         }
         VERIFY_EXPR(CurrSB == GetNumSBs());
@@ -362,7 +350,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
             new (&GetSmpldImg(CurrSmplImg++))
                 SPIRVShaderResourceAttribs(Compiler,
                                            SmplImg,
-                                           m_ResourceNames.CopyString(SmplImg.name),
+                                           NamesTable.Intern(SmplImg.name.c_str()).GetStr(),
                                            ResType);
         }
         VERIFY_EXPR(CurrSmplImg == GetNumSmpldImgs());
@@ -379,7 +367,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
             new (&GetImg(CurrImg++))
                 SPIRVShaderResourceAttribs(Compiler,
                                            Img,
-                                           m_ResourceNames.CopyString(Img.name),
+                                           NamesTable.Intern(Img.name.c_str()).GetStr(),
                                            ResType);
         }
         VERIFY_EXPR(CurrImg == GetNumImgs());
@@ -392,7 +380,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
             new (&GetAC(CurrAC++))
                 SPIRVShaderResourceAttribs(Compiler,
                                            AC,
-                                           m_ResourceNames.CopyString(AC.name),
+                                           NamesTable.Intern(AC.name.c_str()).GetStr(),
                                            SPIRVShaderResourceAttribs::ResourceType::AtomicCounter);
         }
         VERIFY_EXPR(CurrAC == GetNumACs());
@@ -405,7 +393,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
             new (&GetSepSmplr(CurrSepSmpl++))
                 SPIRVShaderResourceAttribs(Compiler,
                                            SepSam,
-                                           m_ResourceNames.CopyString(SepSam.name),
+                                           NamesTable.Intern(SepSam.name.c_str()).GetStr(),
                                            SPIRVShaderResourceAttribs::ResourceType::SeparateSampler);
         }
         VERIFY_EXPR(CurrSepSmpl == GetNumSepSmplrs());
@@ -447,7 +435,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
             auto* pNewSepImg = new (&GetSepImg(CurrSepImg++))
                 SPIRVShaderResourceAttribs(Compiler,
                                            SepImg,
-                                           m_ResourceNames.CopyString(SepImg.name),
+                                           NamesTable.Intern(SepImg.name.c_str()).GetStr(),
                                            ResType,
                                            SamplerInd);
             if (ResType == SPIRVShaderResourceAttribs::ResourceType::SeparateImage && pNewSepImg->IsValidSepSamplerAssigned())
@@ -29,6 +29,8 @@
 
 #include <cmath>
 #include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/FlagEnum.h"
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
@@ -57,4 +59,92 @@ inline float FastSRGBToLinear(float x)
     return x * (x * (x * 0.305306011f + 0.682171111f) + 0.012522878f);
 }
 
+/// Converts 16-bit half-precision floating-point value to 32-bit float.
+float HalfToFloat(Uint16 Half);
+
+/// Converts 32-bit float to 16-bit half-precision floating-point value
+/// rounding to nearest even. Values out of range are converted to infinity.
+Uint16 FloatToHalf(float Value);
+
+
+/// Color conversion flags
+enum COLOR_CONVERSION_FLAGS : Uint32
+{
+    COLOR_CONVERSION_FLAG_NONE = 0x00,
+
+    /// Multiply color components by alpha. For sRGB formats, premultiplication
+    /// is performed in linear space.
+    COLOR_CONVERSION_FLAG_PREMULTIPLY_ALPHA = 0x01
+};
+DEFINE_FLAG_ENUM_OPERATORS(COLOR_CONVERSION_FLAGS);
+
+/// Returns true if pixels can be converted between the two formats by ConvertPixels() and ConvertImage().
+
+/// Supported formats are TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_BGRA8_UNORM,
+/// TEX_FORMAT_BGRA8_UNORM_SRGB, TEX_FORMAT_RGBA16_FLOAT and TEX_FORMAT_RGBA32_FLOAT, in any combination.
+bool IsColorConversionSupported(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat);
+
+/// Converts a row of pixels from one format to another.
+
+/// \param [in]  pSrc      - Source pixels.
+/// \param [in]  SrcFormat - Source pixel format.
+/// \param [out] pDst      - Destination pixels. The memory must not overlap the source pixels
+///                          unless pSrc == pDst and both formats have the same pixel size.
+/// \param [in]  DstFormat - Destination pixel format.
+/// \param [in]  NumPixels - The number of pixels to convert.
+/// \param [in]  Flags     - Conversion flags, see Diligent::COLOR_CONVERSION_FLAGS.
+///
+/// \return true if the conversion is supported, and false otherwise.
+///
+/// \remarks    sRGB-encoded components are converted to linear space when the destination format is not sRGB,
+///             and vice versa. Floating-point values are clamped to [0, 1] and rounded to nearest when
+///             converted to 8-bit normalized formats.
+bool ConvertPixels(const void*            pSrc,
+                   TEXTURE_FORMAT         SrcFormat,
+                   void*                  pDst,
+                   TEXTURE_FORMAT         DstFormat,
+                   Uint32                 NumPixels,
+                   COLOR_CONVERSION_FLAGS Flags = COLOR_CONVERSION_FLAG_NONE);
+
+/// Image color conversion attributes
+struct ColorConversionAttribs
+{
+    /// Source image data
+    const void* pSrcData = nullptr;
+
+    /// Source row stride, in bytes
+    Uint32 SrcStride = 0;
+
+    /// Source image format
+    TEXTURE_FORMAT SrcFormat = TEX_FORMAT_UNKNOWN;
+
+    /// Destination image data
+    void* pDstData = nullptr;
+
+    /// Destination row stride, in bytes
+    Uint32 DstStride = 0;
+
+    /// Destination image format
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// Image width
+    Uint32 Width = 0;
+
+    /// Image height
+    Uint32 Height = 0;
+
+    /// Conversion flags
+    COLOR_CONVERSION_FLAGS Flags = COLOR_CONVERSION_FLAG_NONE;
+
+    /// The maximum number of threads to use, including the calling thread.
+    /// The worker threads are taken from WorkerThreadPool::GetDefault().
+    /// 0 means the number of hardware threads. Small images are always
+    /// converted on the calling thread.
+    Uint32 MaxThreads = 0;
+};
+
+/// Converts the image from one format to another, see ConvertPixels().
+/// Large images are split into bands of rows that are converted in parallel.
+bool ConvertImage(const ColorConversionAttribs& Attribs);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
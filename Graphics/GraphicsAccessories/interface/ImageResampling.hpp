@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// CPU image resampling and mip chain generation
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/FlagEnum.h"
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+
+/// Image resampling filter
+enum IMAGE_FILTER_TYPE : Uint8
+{
+    /// Box filter. When the image is minified, every destination pixel is the average
+    /// of the source pixels it covers, weighted by the coverage area.
+    IMAGE_FILTER_BOX = 0,
+
+    /// Kaiser-windowed sinc filter with the radius of 3 pixels and alpha of 4.
+    IMAGE_FILTER_KAISER,
+
+    /// Lanczos filter with the radius of 3 pixels.
+    IMAGE_FILTER_LANCZOS,
+
+    IMAGE_FILTER_COUNT
+};
+
+/// Image resampling flags
+enum IMAGE_RESAMPLING_FLAGS : Uint32
+{
+    IMAGE_RESAMPLING_FLAG_NONE = 0x00,
+
+    /// Multiply color components by alpha before filtering and divide them by
+    /// the filtered alpha afterwards. This prevents the colors of transparent
+    /// pixels from bleeding into opaque ones. Only affects four-component formats.
+    IMAGE_RESAMPLING_FLAG_PREMULTIPLY_ALPHA = 0x01,
+
+    /// Treat RGB components of UNORM formats as sRGB-encoded values.
+    /// Components of _SRGB formats are always filtered in linear space.
+    IMAGE_RESAMPLING_FLAG_SRGB = 0x02
+};
+DEFINE_FLAG_ENUM_OPERATORS(IMAGE_RESAMPLING_FLAGS);
+
+/// Returns true if images of the given format can be processed by ResampleImage() and GenerateMipChain().
+
+/// All uncompressed formats whose components have the same size and type are supported,
+/// including depth formats without stencil. Compressed and packed formats
+/// (e.g. TEX_FORMAT_RGB10A2_UNORM, TEX_FORMAT_R11G11B10_FLOAT) are not supported.
+bool IsImageResamplingSupported(TEXTURE_FORMAT Format);
+
+/// Image resampling attributes
+struct ImageResamplingAttribs
+{
+    /// Source image data
+    const void* pSrcData = nullptr;
+
+    /// Source row stride, in bytes
+    Uint32 SrcStride = 0;
+
+    /// Source image width
+    Uint32 SrcWidth = 0;
+
+    /// Source image height
+    Uint32 SrcHeight = 0;
+
+    /// Destination image data. The memory must not overlap the source data.
+    void* pDstData = nullptr;
+
+    /// Destination row stride, in bytes
+    Uint32 DstStride = 0;
+
+    /// Destination image width
+    Uint32 DstWidth = 0;
+
+    /// Destination image height
+    Uint32 DstHeight = 0;
+
+    /// Format of the source and destination images
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// Resampling filter
+    IMAGE_FILTER_TYPE Filter = IMAGE_FILTER_BOX;
+
+    /// Address mode used to fetch the pixels outside of the source image.
+    /// TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_WRAP and TEXTURE_ADDRESS_MIRROR are supported.
+    TEXTURE_ADDRESS_MODE AddressMode = TEXTURE_ADDRESS_CLAMP;
+
+    /// Resampling flags
+    IMAGE_RESAMPLING_FLAGS Flags = IMAGE_RESAMPLING_FLAG_NONE;
+
+    /// The maximum number of threads to use, including the calling thread.
+    /// 0 means the number of hardware threads. Small images are always
+    /// processed on the calling thread.
+    Uint32 MaxThreads = 0;
+};
+
+/// Resamples the image to the new size using the separable filter.
+
+/// \remarks    Pixels are decoded to 32-bit floats, filtered horizontally and then vertically,
+///             and encoded back to the image format. Values are clamped to the range of the format.
+///             sRGB-encoded components are filtered in linear space.
+///             32-bit integer components are filtered with single precision, so values above 2^24 may lose precision.
+///             The filter kernels are processed with SSE or NEON instructions when they are available.
+///             Large images are split into bands of rows that are processed in parallel.
+bool ResampleImage(const ImageResamplingAttribs& Attribs);
+
+/// Mip level data
+struct MipLevelData
+{
+    /// Mip level data
+    void* pData = nullptr;
+
+    /// Row stride, in bytes
+    Uint32 Stride = 0;
+};
+
+/// Mip chain generation attributes
+struct MipChainGenerationAttribs
+{
+    /// Most detailed mip level data
+    const void* pSrcData = nullptr;
+
+    /// Most detailed mip level row stride, in bytes
+    Uint32 SrcStride = 0;
+
+    /// Most detailed mip level width
+    Uint32 Width = 0;
+
+    /// Most detailed mip level height
+    Uint32 Height = 0;
+
+    /// Image format
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// The number of mip levels to generate, not counting the most detailed level.
+    /// Must not exceed ComputeMipLevelsCount(Width, Height) - 1.
+    Uint32 NumMipLevels = 0;
+
+    /// Pointer to the array of NumMipLevels mip level data descriptions.
+    /// Element i describes mip level i + 1, whose size is max(Width >> (i + 1), 1) x max(Height >> (i + 1), 1).
+    const MipLevelData* pMipLevels = nullptr;
+
+    /// Resampling filter
+    IMAGE_FILTER_TYPE Filter = IMAGE_FILTER_BOX;
+
+    /// Address mode, see Diligent::ImageResamplingAttribs::AddressMode.
+    TEXTURE_ADDRESS_MODE AddressMode = TEXTURE_ADDRESS_CLAMP;
+
+    /// Resampling flags
+    IMAGE_RESAMPLING_FLAGS Flags = IMAGE_RESAMPLING_FLAG_NONE;
+
+    /// The maximum number of threads to use, see Diligent::ImageResamplingAttribs::MaxThreads.
+    Uint32 MaxThreads = 0;
+};
+
+/// Generates the mip chain of the image, see ResampleImage().
+
+/// Similar to IDeviceContext::GenerateMips(), every mip level is computed from the previous one.
+/// With the box filter, the previous level is read from its stored data. Kaiser and Lanczos
+/// filters use the unquantized pixels of the previous level to avoid accumulating errors.
+bool GenerateMipChain(const MipChainGenerationAttribs& Attribs);
+
+} // namespace Diligent
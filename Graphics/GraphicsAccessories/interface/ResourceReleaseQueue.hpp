@@ -34,16 +34,121 @@
 /// Implementation of Diligent::ResourceReleaseQueue class
 
 #include <mutex>
-#include <deque>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <new>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
 #include "../../../Common/interface/STDAllocator.hpp"
+#include "../../../Common/interface/AdaptiveLock.hpp"
+#include "../../../Common/interface/DefaultRawMemoryAllocator.hpp"
 #include "../../../Platforms/interface/Atomics.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
 {
 
+/// Lock-free pool of fixed-size memory blocks.
+
+/// Freed blocks are pushed to the shared free list with a single compare-exchange.
+/// An allocating thread takes the entire shared list at once and keeps it in its
+/// thread-local cache, so that blocks are never popped from the shared list one by one,
+/// which avoids the ABA problem. Memory pages are never returned to the system.
+///
+/// \tparam BlockSize - Size of the memory block, must be a multiple of the pointer size.
+template <size_t BlockSize>
+class StaleResourceBlockPool
+{
+public:
+    static constexpr size_t PageSize        = 16384;
+    static constexpr size_t NumBlocksInPage = BlockSize < PageSize ? PageSize / BlockSize : 1;
+
+    static void* Allocate()
+    {
+        auto& Cache = GetThreadCache();
+        if (Cache.pHead == nullptr)
+        {
+            Cache.pHead = GetSharedFreeList().exchange(nullptr, std::memory_order_acquire);
+            if (Cache.pHead == nullptr)
+                Cache.pHead = AllocatePage();
+        }
+
+        auto* pBlock = Cache.pHead;
+        Cache.pHead  = pBlock->pNext;
+        return pBlock;
+    }
+
+    static void Free(void* Ptr)
+    {
+        VERIFY_EXPR(Ptr != nullptr);
+        auto* pBlock = static_cast<FreeBlock*>(Ptr);
+        PushToSharedList(pBlock, pBlock);
+    }
+
+private:
+    static_assert(BlockSize >= sizeof(void*) && BlockSize % sizeof(void*) == 0, "Block size must be a multiple of the pointer size");
+
+    struct FreeBlock
+    {
+        FreeBlock* pNext;
+    };
+
+    struct ThreadCache
+    {
+        ~ThreadCache()
+        {
+            // Return blocks cached by the exiting thread to the shared list
+            if (pHead != nullptr)
+            {
+                auto* pTail = pHead;
+                while (pTail->pNext != nullptr)
+                    pTail = pTail->pNext;
+                PushToSharedList(pHead, pTail);
+            }
+        }
+
+        FreeBlock* pHead = nullptr;
+    };
+
+    static std::atomic<FreeBlock*>& GetSharedFreeList()
+    {
+        static std::atomic<FreeBlock*> SharedFreeList{nullptr};
+        return SharedFreeList;
+    }
+
+    static ThreadCache& GetThreadCache()
+    {
+        static thread_local ThreadCache Cache;
+        return Cache;
+    }
+
+    static void PushToSharedList(FreeBlock* pHead, FreeBlock* pTail)
+    {
+        auto& SharedFreeList = GetSharedFreeList();
+
+        pTail->pNext = SharedFreeList.load(std::memory_order_relaxed);
+        while (!SharedFreeList.compare_exchange_weak(pTail->pNext, pHead, std::memory_order_release, std::memory_order_relaxed))
+        {}
+    }
+
+    static FreeBlock* AllocatePage()
+    {
+        // The page is intentionally never released: blocks may be freed by other threads
+        // at any time, including static destruction.
+        auto* pPage = reinterpret_cast<Uint8*>(
+            DefaultRawMemoryAllocator::GetAllocator().Allocate(BlockSize * NumBlocksInPage, "Stale resource pool page", __FILE__, __LINE__));
+        for (size_t i = 0; i < NumBlocksInPage; ++i)
+        {
+            auto* pBlock  = reinterpret_cast<FreeBlock*>(pPage + i * BlockSize);
+            pBlock->pNext = i + 1 < NumBlocksInPage ? reinterpret_cast<FreeBlock*>(pPage + (i + 1) * BlockSize) : nullptr;
+        }
+        return reinterpret_cast<FreeBlock*>(pPage);
+    }
+};
+
+
 /// Helper class that wraps stale resources of different types
 class DynamicStaleResourceWrapper final
 {
@@ -63,6 +168,8 @@ public:
     //  |  AtomicLong          m_RefCounter                |         |______________________________________________|
     //  |__________________________________________________|
     //
+    // Specific stale resource objects are allocated from StaleResourceBlockPool
+    // rather than from the global heap.
 
     template <typename ResourceType, typename = typename std::enable_if<std::is_object<ResourceType>::value>::type>
     static DynamicStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences)
@@ -85,7 +192,7 @@ public:
 
             virtual void Release() override final
             {
-                delete this;
+                DestroyPooledObject(this);
             }
 
         private:
@@ -112,7 +219,7 @@ public:
             {
                 if (Atomics::AtomicDecrement(m_RefCounter) == 0)
                 {
-                    delete this;
+                    DestroyPooledObject(this);
                 }
             }
 
@@ -123,8 +230,8 @@ public:
 
         return DynamicStaleResourceWrapper{
             NumReferences == 1 ?
-                static_cast<StaleResourceBase*>(new SpecificStaleResource{std::move(Resource)}) :
-                static_cast<StaleResourceBase*>(new SpecificSharedStaleResource{std::move(Resource), NumReferences})};
+                static_cast<StaleResourceBase*>(NewPooledObject<SpecificStaleResource>(std::move(Resource))) :
+                static_cast<StaleResourceBase*>(NewPooledObject<SpecificSharedStaleResource>(std::move(Resource), NumReferences))};
     }
 
     DynamicStaleResourceWrapper(DynamicStaleResourceWrapper&& rhs) noexcept :
@@ -138,9 +245,20 @@ public:
     {
     }
 
+    DynamicStaleResourceWrapper& operator=(DynamicStaleResourceWrapper&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            if (m_pStaleResource != nullptr)
+                m_pStaleResource->Release();
+            m_pStaleResource     = rhs.m_pStaleResource;
+            rhs.m_pStaleResource = nullptr;
+        }
+        return *this;
+    }
+
     // clang-format off
     DynamicStaleResourceWrapper& operator = (const DynamicStaleResourceWrapper&)  = delete;
-    DynamicStaleResourceWrapper& operator = (      DynamicStaleResourceWrapper&&) = delete;
     // clang-format on
 
     void GiveUpOwnership()
@@ -162,6 +280,34 @@ private:
         virtual void Release()       = 0;
     };
 
+    // Pools are shared by all objects whose sizes round up to the same block size
+    template <typename ObjectType>
+    using ObjectBlockPool = StaleResourceBlockPool<(sizeof(ObjectType) + 15) / 16 * 16>;
+
+    template <typename ObjectType, typename... CtorArgTypes>
+    static ObjectType* NewPooledObject(CtorArgTypes&&... CtorArgs)
+    {
+        static_assert(alignof(ObjectType) <= 16, "Pooled stale resource objects must not be over-aligned");
+
+        void* pRawMem = ObjectBlockPool<ObjectType>::Allocate();
+        try
+        {
+            return new (pRawMem) ObjectType{std::forward<CtorArgTypes>(CtorArgs)...};
+        }
+        catch (...)
+        {
+            ObjectBlockPool<ObjectType>::Free(pRawMem);
+            throw;
+        }
+    }
+
+    template <typename ObjectType>
+    static void DestroyPooledObject(ObjectType* pObject)
+    {
+        pObject->~ObjectType();
+        ObjectBlockPool<ObjectType>::Free(pObject);
+    }
+
     DynamicStaleResourceWrapper(StaleResourceBase* pStaleResource) :
         m_pStaleResource(pStaleResource)
     {}
@@ -216,22 +362,46 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// Released and discarded resources are first appended to one of the per-thread buffers, which are
+/// protected by light-weight locks that are practically never contended. The buffers are merged
+/// into the stale objects and release queues by DiscardStaleResources() and Purge().
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
 {
 public:
+    /// The number of per-thread buffers. Threads are assigned to the buffers in a round-robin fashion.
+    static constexpr Uint32 NumThreadBuffers = 16;
+
     // clang-format off
     ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
-    {}
+        m_Allocator     (Allocator),
+        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for vector<ReleaseQueueElemType>")),
+        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for vector<ReleaseQueueElemType>"))
+    // clang-format on
+    {
+        m_ThreadBuffers = reinterpret_cast<ThreadBuffer*>(
+            m_Allocator.Allocate(sizeof(ThreadBuffer) * NumThreadBuffers, "Memory for ResourceReleaseQueue thread buffers", __FILE__, __LINE__));
+        for (Uint32 i = 0; i < NumThreadBuffers; ++i)
+            new (m_ThreadBuffers + i) ThreadBuffer{m_Allocator};
+    }
+
+    // clang-format off
+    ResourceReleaseQueue           (const ResourceReleaseQueue&) = delete;
+    ResourceReleaseQueue           (ResourceReleaseQueue&&)      = delete;
+    ResourceReleaseQueue& operator=(const ResourceReleaseQueue&) = delete;
+    ResourceReleaseQueue& operator=(ResourceReleaseQueue&&)      = delete;
     // clang-format on
 
     ~ResourceReleaseQueue()
     {
-        DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
-        DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
+        DEV_CHECK_ERR(GetStaleResourceCount() == 0, "Not all stale objects were destroyed");
+        DEV_CHECK_ERR(GetPendingReleaseResourceCount() == 0, "Release queue is not empty");
+
+        for (Uint32 i = 0; i < NumThreadBuffers; ++i)
+            m_ThreadBuffers[i].~ThreadBuffer();
+        m_Allocator.Free(m_ThreadBuffers);
     }
 
     /// Creates a resource wrapper for the specific resource type
@@ -257,8 +427,12 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(ResourceWrapperType&& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+        auto& Buffer = GetThreadBuffer();
+        {
+            ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveLock> Guard{Buffer.Lock};
+            Buffer.StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+            m_NumStaleResources.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
     /// Moves a copy of the resource wrapper to the stale resources queue
@@ -266,8 +440,12 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(const ResourceWrapperType& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, Wrapper);
+        auto& Buffer = GetThreadBuffer();
+        {
+            ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveLock> Guard{Buffer.Lock};
+            Buffer.StaleResources.emplace_back(NextCommandListNumber, Wrapper);
+            m_NumStaleResources.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
     /// Adds a resource directly to the release queue
@@ -284,8 +462,12 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(ResourceWrapperType&& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
+        auto& Buffer = GetThreadBuffer();
+        {
+            ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveLock> Guard{Buffer.Lock};
+            Buffer.ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
+            m_NumPendingReleaseResources.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
     /// Adds a copy of the resource wrapper directly to the release queue
@@ -293,8 +475,12 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(const ResourceWrapperType& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, Wrapper);
+        auto& Buffer = GetThreadBuffer();
+        {
+            ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveLock> Guard{Buffer.Lock};
+            Buffer.ReleaseQueue.emplace_back(FenceValue, Wrapper);
+            m_NumPendingReleaseResources.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
     /// Adds multiple resources directly to the release queue
@@ -303,11 +489,17 @@ public:
     template <typename ResourceType, typename IteratorType>
     void DiscardResources(Uint64 FenceValue, IteratorType Iterator)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        ResourceType                Resource;
-        while (Iterator(Resource))
+        auto&  Buffer       = GetThreadBuffer();
+        size_t NumDiscarded = 0;
         {
-            m_ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1));
+            ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveLock> Guard{Buffer.Lock};
+            ResourceType                                                     Resource;
+            while (Iterator(Resource))
+            {
+                Buffer.ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1));
+                ++NumDiscarded;
+            }
+            m_NumPendingReleaseResources.fetch_add(NumDiscarded, std::memory_order_relaxed);
         }
     }
 
@@ -320,21 +512,32 @@ public:
     ///                                      is greater or equal to the fence value associated with the resource
     void DiscardStaleResources(Uint64 SubmittedCmdBuffNumber, Uint64 FenceValue)
     {
+        std::lock_guard<std::mutex> QueueLock(m_QueueMutex);
+        MergeThreadBuffers(&ThreadBuffer::StaleResources, m_StaleResources);
+
         // Only discard these stale objects that were released before CmdBuffNumber
-        // was executed
-        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        while (!m_StaleResources.empty())
+        // was executed. Objects released by different threads may come out of order,
+        // so the entire list is scanned.
+        size_t NumRemaining = 0;
+        size_t NumDiscarded = 0;
+        for (auto& StaleObj : m_StaleResources)
         {
-            auto& FirstStaleObj = m_StaleResources.front();
-            if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
+            if (StaleObj.first <= SubmittedCmdBuffNumber)
             {
-                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
-                m_StaleResources.pop_front();
+                m_ReleaseQueue.emplace_back(FenceValue, std::move(StaleObj.second));
+                ++NumDiscarded;
             }
             else
-                break;
+            {
+                if (&m_StaleResources[NumRemaining] != &StaleObj)
+                    m_StaleResources[NumRemaining] = std::move(StaleObj);
+                ++NumRemaining;
+            }
         }
+        m_StaleResources.erase(m_StaleResources.begin() + NumRemaining, m_StaleResources.end());
+
+        m_NumStaleResources.fetch_sub(NumDiscarded, std::memory_order_relaxed);
+        m_NumPendingReleaseResources.fetch_add(NumDiscarded, std::memory_order_relaxed);
     }
 
 
@@ -343,39 +546,89 @@ public:
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
     void Purge(Uint64 CompletedFenceValue)
     {
-        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        std::lock_guard<std::mutex> QueueLock(m_QueueMutex);
+        MergeThreadBuffers(&ThreadBuffer::ReleaseQueue, m_ReleaseQueue);
 
         // Release all objects whose associated fence value is at most CompletedFenceValue
         // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
-        while (!m_ReleaseQueue.empty())
-        {
-            auto& FirstObj = m_ReleaseQueue.front();
-            if (FirstObj.first <= CompletedFenceValue)
-                m_ReleaseQueue.pop_front();
-            else
-                break;
-        }
+        auto RemainingEnd = std::remove_if(m_ReleaseQueue.begin(), m_ReleaseQueue.end(),
+                                           [CompletedFenceValue](const ReleaseQueueElemType& Obj) //
+                                           {
+                                               return Obj.first <= CompletedFenceValue;
+                                           });
+
+        const auto NumPurged = static_cast<size_t>(std::distance(RemainingEnd, m_ReleaseQueue.end()));
+        m_ReleaseQueue.erase(RemainingEnd, m_ReleaseQueue.end());
+        m_NumPendingReleaseResources.fetch_sub(NumPurged, std::memory_order_relaxed);
     }
 
     /// Returns the number of stale resources
     size_t GetStaleResourceCount() const
     {
-        return m_StaleResources.size();
+        return m_NumStaleResources.load(std::memory_order_relaxed);
     }
 
     /// Returns the number of resources pending release
     size_t GetPendingReleaseResourceCount() const
     {
-        return m_ReleaseQueue.size();
+        return m_NumPendingReleaseResources.load(std::memory_order_relaxed);
     }
 
 private:
-    std::mutex m_ReleaseQueueMutex;
     using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
+    using ReleaseQueueType     = std::vector<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>>;
+
+    struct ThreadBuffer
+    {
+        // clang-format off
+        ThreadBuffer(IMemoryAllocator& Allocator) :
+            StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for vector<ReleaseQueueElemType>")),
+            ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for vector<ReleaseQueueElemType>"))
+        {}
+        // clang-format on
+
+        ThreadingTools::AdaptiveLock Lock;
+
+        ReleaseQueueType StaleResources;
+        ReleaseQueueType ReleaseQueue;
+    };
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        static std::atomic<Uint32> NextThreadBufferIndex{0};
+        static thread_local Uint32 ThreadBufferIndex = NextThreadBufferIndex.fetch_add(1, std::memory_order_relaxed) % NumThreadBuffers;
+        return m_ThreadBuffers[ThreadBufferIndex];
+    }
+
+    // Moves the contents of the per-thread buffers into the destination queue. The buffers keep
+    // their capacity, so after warm-up no memory is allocated when resources are released.
+    void MergeThreadBuffers(ReleaseQueueType ThreadBuffer::*pBufferQueue, ReleaseQueueType& DstQueue)
+    {
+        for (Uint32 i = 0; i < NumThreadBuffers; ++i)
+        {
+            auto&                                                            Buffer = m_ThreadBuffers[i];
+            ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveLock> Guard{Buffer.Lock};
+
+            auto& SrcQueue = Buffer.*pBufferQueue;
+            if (SrcQueue.empty())
+                continue;
+
+            DstQueue.insert(DstQueue.end(), std::make_move_iterator(SrcQueue.begin()), std::make_move_iterator(SrcQueue.end()));
+            SrcQueue.clear();
+        }
+    }
+
+    IMemoryAllocator& m_Allocator;
+
+    // Protects the merged stale objects and release queues
+    std::mutex       m_QueueMutex;
+    ReleaseQueueType m_ReleaseQueue;
+    ReleaseQueueType m_StaleResources;
+
+    ThreadBuffer* m_ThreadBuffers = nullptr;
 
-    std::mutex                                                                 m_StaleObjectsMutex;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+    std::atomic<size_t> m_NumStaleResources{0};
+    std::atomic<size_t> m_NumPendingReleaseResources{0};
 };
 
 } // namespace Diligent
@@ -27,7 +27,17 @@
 
 #include <array>
 #include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "BasicMath.hpp"
+#include "WorkerThreadPool.hpp"
+
+#if defined(__F16C__)
+#    include <immintrin.h>
+#endif
 
 namespace Diligent
 {
@@ -89,4 +99,610 @@ float SRGBToLinear(Uint8 x)
     return map[x];
 }
 
+float HalfToFloat(Uint16 Half)
+{
+    const Uint32 Sign = Uint32{Half & 0x8000u} << 16u;
+    Uint32       Exp  = (Half >> 10u) & 0x1Fu;
+    Uint32       Mant = Half & 0x3FFu;
+
+    Uint32 Bits = 0;
+    if (Exp == 0x1F)
+    {
+        // Infinity or NaN
+        Bits = Sign | 0x7F800000u | (Mant << 13u);
+    }
+    else if (Exp != 0)
+    {
+        // Normalized value: rebias the exponent from 15 to 127
+        Bits = Sign | ((Exp + (127 - 15)) << 23u) | (Mant << 13u);
+    }
+    else if (Mant != 0)
+    {
+        // Denormalized half is a normalized float
+        Exp = 127 - 14;
+        while ((Mant & 0x400u) == 0)
+        {
+            Mant <<= 1u;
+            --Exp;
+        }
+        Bits = Sign | (Exp << 23u) | ((Mant & 0x3FFu) << 13u);
+    }
+    else
+    {
+        // Signed zero
+        Bits = Sign;
+    }
+
+    float Value;
+    memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+Uint16 FloatToHalf(float Value)
+{
+    Uint32 Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+
+    const Uint32 Sign = (Bits >> 16u) & 0x8000u;
+    const Uint32 Abs  = Bits & 0x7FFFFFFFu;
+
+    Uint32 Half = 0;
+    if (Abs >= 0x7F800000u)
+    {
+        // Infinity or NaN
+        Half = 0x7C00u | (Abs > 0x7F800000u ? 0x200u : 0u);
+    }
+    else if (Abs >= 0x477FF000u)
+    {
+        // Values that are not less than 65520 round to infinity
+        Half = 0x7C00u;
+    }
+    else if (Abs >= 0x38800000u)
+    {
+        // Normalized value: rebias the exponent from 127 to 15 and round to nearest even
+        Half             = (Abs - ((127u - 15u) << 23u)) >> 13u;
+        const Uint32 Rem = Abs & 0x1FFFu;
+        if (Rem > 0x1000u || (Rem == 0x1000u && (Half & 1u) != 0))
+            ++Half;
+    }
+    else if (Abs > 0x33000000u)
+    {
+        // Denormalized half. Values that are not greater than 2^-25 round to zero.
+        const Uint32 Exp     = Abs >> 23u;
+        const Uint32 Mant    = (Abs & 0x7FFFFFu) | 0x800000u;
+        const Uint32 Shift   = 126u - Exp;
+        const Uint32 Rem     = Mant & ((1u << Shift) - 1u);
+        const Uint32 HalfWay = 1u << (Shift - 1u);
+        Half                 = Mant >> Shift;
+        if (Rem > HalfWay || (Rem == HalfWay && (Half & 1u) != 0))
+            ++Half;
+    }
+
+    return static_cast<Uint16>(Sign | Half);
+}
+
+
+namespace
+{
+
+enum PIXEL_LAYOUT : Uint8
+{
+    PIXEL_LAYOUT_UNKNOWN = 0,
+    PIXEL_LAYOUT_RGBA8,
+    PIXEL_LAYOUT_BGRA8,
+    PIXEL_LAYOUT_RGBA16F,
+    PIXEL_LAYOUT_RGBA32F
+};
+
+struct ConversionFormatInfo
+{
+    PIXEL_LAYOUT Layout    = PIXEL_LAYOUT_UNKNOWN;
+    bool         IsSRGB    = false;
+    Uint32       PixelSize = 0;
+
+    bool Is8Bit() const { return Layout == PIXEL_LAYOUT_RGBA8 || Layout == PIXEL_LAYOUT_BGRA8; }
+};
+
+ConversionFormatInfo GetConversionFormatInfo(TEXTURE_FORMAT Format)
+{
+    ConversionFormatInfo Info;
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+    if (FmtAttribs.NumComponents != 4 || FmtAttribs.IsTypeless)
+        return Info;
+
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+        case COMPONENT_TYPE_UNORM_SRGB:
+            if (Format == TEX_FORMAT_RGBA8_UNORM || Format == TEX_FORMAT_RGBA8_UNORM_SRGB)
+                Info.Layout = PIXEL_LAYOUT_RGBA8;
+            else if (Format == TEX_FORMAT_BGRA8_UNORM || Format == TEX_FORMAT_BGRA8_UNORM_SRGB)
+                Info.Layout = PIXEL_LAYOUT_BGRA8;
+            Info.IsSRGB = FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB;
+            break;
+
+        case COMPONENT_TYPE_FLOAT:
+            if (FmtAttribs.ComponentSize == 2)
+                Info.Layout = PIXEL_LAYOUT_RGBA16F;
+            else if (FmtAttribs.ComponentSize == 4)
+                Info.Layout = PIXEL_LAYOUT_RGBA32F;
+            break;
+
+        default:
+            break;
+    }
+
+    if (Info.Layout != PIXEL_LAYOUT_UNKNOWN)
+        Info.PixelSize = FmtAttribs.GetElementSize();
+
+    return Info;
+}
+
+inline Uint8 FloatToUnorm8(float x)
+{
+    return static_cast<Uint8>(clamp(x, 0.f, 1.f) * 255.f + 0.5f);
+}
+
+// Lookup tables shared by all conversion routines
+class ColorConversionTables
+{
+public:
+    ColorConversionTables() noexcept
+    {
+        // Linear value thresholds between consecutive 8-bit sRGB codes
+        for (Uint32 i = 0; i < m_LinearToSRGBThresholds.size(); ++i)
+            m_LinearToSRGBThresholds[i] = SRGBToLinear((static_cast<float>(i) + 0.5f) / 255.f);
+
+        for (Uint32 i = 0; i < 256; ++i)
+        {
+            m_SRGBToLinear[i]   = SRGBToLinear(static_cast<float>(i) / 255.f);
+            m_SRGB8ToLinear8[i] = FloatToUnorm8(m_SRGBToLinear[i]);
+            m_Linear8ToSRGB8[i] = LinearToSRGB8(static_cast<float>(i) / 255.f);
+        }
+    }
+
+    float SRGB8ToLinear(Uint8 x) const
+    {
+        return m_SRGBToLinear[x];
+    }
+
+    Uint8 LinearToSRGB8(float x) const
+    {
+        return static_cast<Uint8>(std::upper_bound(m_LinearToSRGBThresholds.begin(), m_LinearToSRGBThresholds.end(), x) - m_LinearToSRGBThresholds.begin());
+    }
+
+    const Uint8* GetSRGB8ToLinear8() const { return m_SRGB8ToLinear8.data(); }
+    const Uint8* GetLinear8ToSRGB8() const { return m_Linear8ToSRGB8.data(); }
+
+private:
+    std::array<float, 255> m_LinearToSRGBThresholds;
+    std::array<float, 256> m_SRGBToLinear;
+    std::array<Uint8, 256> m_SRGB8ToLinear8;
+    std::array<Uint8, 256> m_Linear8ToSRGB8;
+};
+
+const ColorConversionTables& GetColorConversionTables()
+{
+    static const ColorConversionTables Tables;
+    return Tables;
+}
+
+
+// Swaps red and blue channels of 8-bit pixels
+void SwizzleRB8(const Uint8* pSrc, Uint8* pDst, Uint32 NumPixels)
+{
+    size_t i = 0;
+#if DILIGENT_SSE_MATH
+    const __m128i GAMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    const __m128i RBMask = _mm_set1_epi32(0xFF);
+    for (; i + 4 <= NumPixels; i += 4)
+    {
+        const __m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i * 4));
+
+        __m128i Res = _mm_and_si128(Pixels, GAMask);
+        Res         = _mm_or_si128(Res, _mm_and_si128(_mm_srli_epi32(Pixels, 16), RBMask));
+        Res         = _mm_or_si128(Res, _mm_slli_epi32(_mm_and_si128(Pixels, RBMask), 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i * 4), Res);
+    }
+#elif DILIGENT_NEON_MATH
+    for (; i + 16 <= NumPixels; i += 16)
+    {
+        uint8x16x4_t Pixels = vld4q_u8(pSrc + i * 4);
+        std::swap(Pixels.val[0], Pixels.val[2]);
+        vst4q_u8(pDst + i * 4, Pixels);
+    }
+#endif
+    for (; i < NumPixels; ++i)
+    {
+        const Uint8 R = pSrc[i * 4 + 0];
+        const Uint8 G = pSrc[i * 4 + 1];
+        const Uint8 B = pSrc[i * 4 + 2];
+        const Uint8 A = pSrc[i * 4 + 3];
+
+        pDst[i * 4 + 0] = B;
+        pDst[i * 4 + 1] = G;
+        pDst[i * 4 + 2] = R;
+        pDst[i * 4 + 3] = A;
+    }
+}
+
+// Multiplies color channels of 8-bit pixels by alpha: c = round(c * a / 255)
+void PremultiplyAlpha8(Uint8* pPixels, Uint32 NumPixels)
+{
+    // For 16-bit t = c * a + 128, (t + (t >> 8)) >> 8 == round(c * a / 255)
+    size_t i = 0;
+#if DILIGENT_SSE_MATH
+    const __m128i Zero     = _mm_setzero_si128();
+    const __m128i Round    = _mm_set1_epi16(128);
+    const __m128i RGBMask  = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m128i Alpha255 = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+
+    // Premultiplies two pixels expanded to 16 bits
+    const auto Premultiply = [&](__m128i Pixels) {
+        __m128i Alpha = _mm_shufflelo_epi16(Pixels, _MM_SHUFFLE(3, 3, 3, 3));
+        Alpha         = _mm_shufflehi_epi16(Alpha, _MM_SHUFFLE(3, 3, 3, 3));
+        // Alpha channel is multiplied by 255, which leaves it unchanged
+        Alpha = _mm_or_si128(_mm_and_si128(Alpha, RGBMask), Alpha255);
+
+        __m128i t = _mm_add_epi16(_mm_mullo_epi16(Pixels, Alpha), Round);
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    };
+
+    for (; i + 4 <= NumPixels; i += 4)
+    {
+        __m128i* pData  = reinterpret_cast<__m128i*>(pPixels + i * 4);
+        __m128i  Pixels = _mm_loadu_si128(pData);
+
+        const __m128i Lo = Premultiply(_mm_unpacklo_epi8(Pixels, Zero));
+        const __m128i Hi = Premultiply(_mm_unpackhi_epi8(Pixels, Zero));
+        _mm_storeu_si128(pData, _mm_packus_epi16(Lo, Hi));
+    }
+#elif DILIGENT_NEON_MATH
+    const uint16x8_t Round = vdupq_n_u16(128);
+    for (; i + 8 <= NumPixels; i += 8)
+    {
+        uint8x8x4_t Pixels = vld4_u8(pPixels + i * 4);
+        for (int c = 0; c < 3; ++c)
+        {
+            const uint16x8_t t = vaddq_u16(vmull_u8(Pixels.val[c], Pixels.val[3]), Round);
+            Pixels.val[c]      = vshrn_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8);
+        }
+        vst4_u8(pPixels + i * 4, Pixels);
+    }
+#endif
+    for (; i < NumPixels; ++i)
+    {
+        Uint8*       pPixel = pPixels + i * 4;
+        const Uint32 Alpha  = pPixel[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            const Uint32 t = Uint32{pPixel[c]} * Alpha + 128u;
+            pPixel[c]      = static_cast<Uint8>((t + (t >> 8u)) >> 8u);
+        }
+    }
+}
+
+// Converts 8-bit pixels to 8-bit pixels
+void ConvertPixels8(const Uint8* pSrc, const ConversionFormatInfo& SrcInfo, Uint8* pDst, const ConversionFormatInfo& DstInfo, Uint32 NumPixels, bool Premultiply)
+{
+    if (SrcInfo.Layout != DstInfo.Layout)
+        SwizzleRB8(pSrc, pDst, NumPixels);
+    else if (pSrc != pDst)
+        memcpy(pDst, pSrc, size_t{NumPixels} * 4);
+
+    if (SrcInfo.IsSRGB != DstInfo.IsSRGB)
+    {
+        const auto&  Tables = GetColorConversionTables();
+        const Uint8* pLUT   = SrcInfo.IsSRGB ? Tables.GetSRGB8ToLinear8() : Tables.GetLinear8ToSRGB8();
+        for (size_t i = 0; i < NumPixels; ++i)
+        {
+            Uint8* pPixel = pDst + i * 4;
+            pPixel[0]     = pLUT[pPixel[0]];
+            pPixel[1]     = pLUT[pPixel[1]];
+            pPixel[2]     = pLUT[pPixel[2]];
+        }
+    }
+
+    if (Premultiply)
+    {
+        VERIFY(!SrcInfo.IsSRGB && !DstInfo.IsSRGB, "sRGB pixels must be premultiplied in linear space");
+        PremultiplyAlpha8(pDst, NumPixels);
+    }
+}
+
+// Decodes pixels into linear RGBA32F values
+void DecodePixels(const Uint8* pSrc, const ConversionFormatInfo& SrcInfo, float* pDst, Uint32 NumPixels)
+{
+    switch (SrcInfo.Layout)
+    {
+        case PIXEL_LAYOUT_RGBA32F:
+            memcpy(pDst, pSrc, size_t{NumPixels} * 16);
+            break;
+
+        case PIXEL_LAYOUT_RGBA16F:
+        {
+            const auto* pHalfs = reinterpret_cast<const Uint16*>(pSrc);
+            Uint32      i      = 0;
+#if defined(__F16C__)
+            for (; i < NumPixels; ++i)
+                _mm_storeu_ps(pDst + i * 4, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pHalfs + i * 4))));
+#endif
+            for (Uint32 c = i * 4; c < NumPixels * 4; ++c)
+                pDst[c] = HalfToFloat(pHalfs[c]);
+            break;
+        }
+
+        case PIXEL_LAYOUT_RGBA8:
+        case PIXEL_LAYOUT_BGRA8:
+        {
+            if (SrcInfo.IsSRGB)
+            {
+                const auto& Tables = GetColorConversionTables();
+                for (Uint32 i = 0; i < NumPixels; ++i)
+                {
+                    pDst[i * 4 + 0] = Tables.SRGB8ToLinear(pSrc[i * 4 + 0]);
+                    pDst[i * 4 + 1] = Tables.SRGB8ToLinear(pSrc[i * 4 + 1]);
+                    pDst[i * 4 + 2] = Tables.SRGB8ToLinear(pSrc[i * 4 + 2]);
+                    pDst[i * 4 + 3] = static_cast<float>(pSrc[i * 4 + 3]) / 255.f;
+                }
+            }
+            else
+            {
+                Uint32 i = 0;
+#if DILIGENT_SSE_MATH
+                const __m128i Zero  = _mm_setzero_si128();
+                const __m128  Scale = _mm_set1_ps(255.f);
+                for (; i + 4 <= NumPixels; i += 4)
+                {
+                    const __m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i * 4));
+                    const __m128i Lo     = _mm_unpacklo_epi8(Pixels, Zero);
+                    const __m128i Hi     = _mm_unpackhi_epi8(Pixels, Zero);
+                    _mm_storeu_ps(pDst + i * 4 + 0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(Lo, Zero)), Scale));
+                    _mm_storeu_ps(pDst + i * 4 + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(Lo, Zero)), Scale));
+                    _mm_storeu_ps(pDst + i * 4 + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(Hi, Zero)), Scale));
+                    _mm_storeu_ps(pDst + i * 4 + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(Hi, Zero)), Scale));
+                }
+#endif
+                for (Uint32 c = i * 4; c < NumPixels * 4; ++c)
+                    pDst[c] = static_cast<float>(pSrc[c]) / 255.f;
+            }
+
+            if (SrcInfo.Layout == PIXEL_LAYOUT_BGRA8)
+            {
+                for (Uint32 i = 0; i < NumPixels; ++i)
+                    std::swap(pDst[i * 4 + 0], pDst[i * 4 + 2]);
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected pixel layout");
+    }
+}
+
+void PremultiplyAlpha32F(float* pPixels, Uint32 NumPixels)
+{
+    Uint32 i = 0;
+#if DILIGENT_SSE_MATH
+    const __m128 One = _mm_setr_ps(0, 0, 0, 1);
+    for (; i < NumPixels; ++i)
+    {
+        const __m128 Pixel = _mm_loadu_ps(pPixels + i * 4);
+        // {a, a, a, 1}
+        const __m128 Alpha = _mm_shuffle_ps(Pixel, _mm_unpackhi_ps(Pixel, One), _MM_SHUFFLE(3, 2, 3, 3));
+        _mm_storeu_ps(pPixels + i * 4, _mm_mul_ps(Pixel, Alpha));
+    }
+#endif
+    for (; i < NumPixels; ++i)
+    {
+        float* pPixel = pPixels + i * 4;
+        pPixel[0] *= pPixel[3];
+        pPixel[1] *= pPixel[3];
+        pPixel[2] *= pPixel[3];
+    }
+}
+
+// Encodes linear RGBA32F values. The source values may be modified.
+void EncodePixels(float* pSrc, Uint8* pDst, const ConversionFormatInfo& DstInfo, Uint32 NumPixels)
+{
+    switch (DstInfo.Layout)
+    {
+        case PIXEL_LAYOUT_RGBA32F:
+            memcpy(pDst, pSrc, size_t{NumPixels} * 16);
+            break;
+
+        case PIXEL_LAYOUT_RGBA16F:
+        {
+            auto*  pHalfs = reinterpret_cast<Uint16*>(pDst);
+            Uint32 i      = 0;
+#if defined(__F16C__)
+            for (; i < NumPixels; ++i)
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(pHalfs + i * 4), _mm_cvtps_ph(_mm_loadu_ps(pSrc + i * 4), _MM_FROUND_TO_NEAREST_INT));
+#endif
+            for (Uint32 c = i * 4; c < NumPixels * 4; ++c)
+                pHalfs[c] = FloatToHalf(pSrc[c]);
+            break;
+        }
+
+        case PIXEL_LAYOUT_RGBA8:
+        case PIXEL_LAYOUT_BGRA8:
+        {
+            if (DstInfo.Layout == PIXEL_LAYOUT_BGRA8)
+            {
+                for (Uint32 i = 0; i < NumPixels; ++i)
+                    std::swap(pSrc[i * 4 + 0], pSrc[i * 4 + 2]);
+            }
+
+            if (DstInfo.IsSRGB)
+            {
+                const auto& Tables = GetColorConversionTables();
+                for (Uint32 i = 0; i < NumPixels; ++i)
+                {
+                    pDst[i * 4 + 0] = Tables.LinearToSRGB8(pSrc[i * 4 + 0]);
+                    pDst[i * 4 + 1] = Tables.LinearToSRGB8(pSrc[i * 4 + 1]);
+                    pDst[i * 4 + 2] = Tables.LinearToSRGB8(pSrc[i * 4 + 2]);
+                    pDst[i * 4 + 3] = FloatToUnorm8(pSrc[i * 4 + 3]);
+                }
+            }
+            else
+            {
+                Uint32 i = 0;
+#if DILIGENT_SSE_MATH
+                const __m128 Zero  = _mm_setzero_ps();
+                const __m128 One   = _mm_set1_ps(1.f);
+                const __m128 Scale = _mm_set1_ps(255.f);
+                const __m128 Half  = _mm_set1_ps(0.5f);
+
+                const auto ToUnorm = [&](const float* pValues) {
+                    const __m128 v = _mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pValues), Zero), One), Scale), Half);
+                    return _mm_cvttps_epi32(v);
+                };
+                for (; i + 4 <= NumPixels; i += 4)
+                {
+                    const __m128i Lo = _mm_packs_epi32(ToUnorm(pSrc + i * 4 + 0), ToUnorm(pSrc + i * 4 + 4));
+                    const __m128i Hi = _mm_packs_epi32(ToUnorm(pSrc + i * 4 + 8), ToUnorm(pSrc + i * 4 + 12));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i * 4), _mm_packus_epi16(Lo, Hi));
+                }
+#endif
+                for (Uint32 c = i * 4; c < NumPixels * 4; ++c)
+                    pDst[c] = FloatToUnorm8(pSrc[c]);
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected pixel layout");
+    }
+}
+
+void ConvertPixelsImpl(const Uint8*                pSrc,
+                       const ConversionFormatInfo& SrcInfo,
+                       Uint8*                      pDst,
+                       const ConversionFormatInfo& DstInfo,
+                       Uint32                      NumPixels,
+                       COLOR_CONVERSION_FLAGS      Flags)
+{
+    const bool Premultiply = (Flags & COLOR_CONVERSION_FLAG_PREMULTIPLY_ALPHA) != 0;
+
+    // 8-bit to 8-bit conversions do not need intermediate floating-point representation,
+    // unless sRGB values need to be premultiplied in linear space.
+    if (SrcInfo.Is8Bit() && DstInfo.Is8Bit() && !(Premultiply && (SrcInfo.IsSRGB || DstInfo.IsSRGB)))
+    {
+        ConvertPixels8(pSrc, SrcInfo, pDst, DstInfo, NumPixels, Premultiply);
+        return;
+    }
+
+    if (SrcInfo.Layout == DstInfo.Layout && SrcInfo.IsSRGB == DstInfo.IsSRGB && !Premultiply)
+    {
+        if (pSrc != pDst)
+            memcpy(pDst, pSrc, size_t{NumPixels} * SrcInfo.PixelSize);
+        return;
+    }
+
+    // Convert the pixels in chunks that fit into the L1 cache
+    static constexpr Uint32 ChunkSize = 256;
+
+    float Chunk[ChunkSize * 4];
+    for (Uint32 i = 0; i < NumPixels; i += ChunkSize)
+    {
+        const Uint32 NumChunkPixels = std::min(ChunkSize, NumPixels - i);
+        DecodePixels(pSrc + size_t{i} * SrcInfo.PixelSize, SrcInfo, Chunk, NumChunkPixels);
+        if (Premultiply)
+            PremultiplyAlpha32F(Chunk, NumChunkPixels);
+        EncodePixels(Chunk, pDst + size_t{i} * DstInfo.PixelSize, DstInfo, NumChunkPixels);
+    }
+}
+
+} // namespace
+
+bool IsColorConversionSupported(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat)
+{
+    return GetConversionFormatInfo(SrcFormat).Layout != PIXEL_LAYOUT_UNKNOWN &&
+        GetConversionFormatInfo(DstFormat).Layout != PIXEL_LAYOUT_UNKNOWN;
+}
+
+bool ConvertPixels(const void*            pSrc,
+                   TEXTURE_FORMAT         SrcFormat,
+                   void*                  pDst,
+                   TEXTURE_FORMAT         DstFormat,
+                   Uint32                 NumPixels,
+                   COLOR_CONVERSION_FLAGS Flags)
+{
+    const auto SrcInfo = GetConversionFormatInfo(SrcFormat);
+    const auto DstInfo = GetConversionFormatInfo(DstFormat);
+    if (SrcInfo.Layout == PIXEL_LAYOUT_UNKNOWN || DstInfo.Layout == PIXEL_LAYOUT_UNKNOWN)
+    {
+        LOG_ERROR_MESSAGE("Conversion from ", GetTextureFormatAttribs(SrcFormat).Name, " to ", GetTextureFormatAttribs(DstFormat).Name, " is not supported");
+        return false;
+    }
+    VERIFY(pSrc != pDst || SrcInfo.PixelSize == DstInfo.PixelSize, "In-place conversion requires the formats to have the same pixel size");
+
+    ConvertPixelsImpl(static_cast<const Uint8*>(pSrc), SrcInfo, static_cast<Uint8*>(pDst), DstInfo, NumPixels, Flags);
+    return true;
+}
+
+bool ConvertImage(const ColorConversionAttribs& Attribs)
+{
+    const auto SrcInfo = GetConversionFormatInfo(Attribs.SrcFormat);
+    const auto DstInfo = GetConversionFormatInfo(Attribs.DstFormat);
+    if (SrcInfo.Layout == PIXEL_LAYOUT_UNKNOWN || DstInfo.Layout == PIXEL_LAYOUT_UNKNOWN)
+    {
+        LOG_ERROR_MESSAGE("Conversion from ", GetTextureFormatAttribs(Attribs.SrcFormat).Name, " to ", GetTextureFormatAttribs(Attribs.DstFormat).Name, " is not supported");
+        return false;
+    }
+
+    if (Attribs.Width == 0 || Attribs.Height == 0)
+        return true;
+
+    if (Attribs.pSrcData == nullptr || Attribs.pDstData == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Source and destination data must not be null");
+        return false;
+    }
+
+    if (Attribs.SrcStride < Uint64{Attribs.Width} * SrcInfo.PixelSize || Attribs.DstStride < Uint64{Attribs.Width} * DstInfo.PixelSize)
+    {
+        LOG_ERROR_MESSAGE("Row strides are too small for the image width");
+        return false;
+    }
+
+    const auto* pSrc = static_cast<const Uint8*>(Attribs.pSrcData);
+    auto*       pDst = static_cast<Uint8*>(Attribs.pDstData);
+
+    const auto ConvertRows = [&](Uint32 StartRow, Uint32 EndRow) {
+        for (Uint32 row = StartRow; row < EndRow; ++row)
+        {
+            ConvertPixelsImpl(pSrc + size_t{row} * Attribs.SrcStride, SrcInfo,
+                              pDst + size_t{row} * Attribs.DstStride, DstInfo,
+                              Attribs.Width, Attribs.Flags);
+        }
+    };
+
+    // Do not split images that are converted faster than the work is distributed between threads
+    static constexpr Uint32 MinPixelsPerThread = 128 * 1024;
+
+    auto&        ThreadPool = WorkerThreadPool::GetDefault();
+    const Uint64 NumPixels  = Uint64{Attribs.Width} * Attribs.Height;
+
+    Uint32 NumThreads = Attribs.MaxThreads != 0 ? Attribs.MaxThreads : ThreadPool.GetNumThreads() + 1;
+    NumThreads        = static_cast<Uint32>(std::min(Uint64{NumThreads}, std::max(NumPixels / MinPixelsPerThread, Uint64{1})));
+    NumThreads        = std::min(NumThreads, Attribs.Height);
+    if (NumThreads <= 1)
+    {
+        ConvertRows(0, Attribs.Height);
+        return true;
+    }
+
+    // Split the image into bands of rows that are converted by the calling thread and the thread pool
+    const Uint32 RowsPerBand = (Attribs.Height + NumThreads - 1) / NumThreads;
+    const Uint32 NumBands    = (Attribs.Height + RowsPerBand - 1) / RowsPerBand;
+    ThreadPool.ParallelFor(NumBands, [&](Uint32 Band) {
+        const Uint32 StartRow = Band * RowsPerBand;
+        ConvertRows(StartRow, std::min(StartRow + RowsPerBand, Attribs.Height));
+    });
+
+    return true;
+}
+
 } // namespace Diligent
@@ -0,0 +1,814 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "ImageResampling.hpp"
+#include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "BasicMath.hpp"
+#include "WorkerThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct ResamplingFormatInfo
+{
+    COMPONENT_TYPE ComponentType = COMPONENT_TYPE_UNDEFINED;
+    Uint32         ComponentSize = 0;
+    Uint32         NumComponents = 0;
+
+    // Whether RGB components are sRGB-encoded
+    bool IsSRGB = false;
+
+    // Whether the fourth component is alpha
+    bool HasAlpha = false;
+
+    Uint32 GetPixelSize() const { return ComponentSize * NumComponents; }
+};
+
+bool GetResamplingFormatInfo(TEXTURE_FORMAT Format, IMAGE_RESAMPLING_FLAGS Flags, ResamplingFormatInfo& Info)
+{
+    if (Format == TEX_FORMAT_UNKNOWN || Format >= TEX_FORMAT_NUM_FORMATS)
+        return false;
+
+    // Packed formats that are described as having separate components
+    if (Format == TEX_FORMAT_R1_UNORM || Format == TEX_FORMAT_RG8_B8G8_UNORM || Format == TEX_FORMAT_G8R8_G8B8_UNORM)
+        return false;
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+    if (FmtAttribs.IsTypeless || FmtAttribs.NumComponents == 0 || FmtAttribs.NumComponents > 4)
+        return false;
+
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+            if (FmtAttribs.ComponentSize != 1 && FmtAttribs.ComponentSize != 2)
+                return false;
+            Info.IsSRGB = (Flags & IMAGE_RESAMPLING_FLAG_SRGB) != 0 && FmtAttribs.NumComponents >= 3;
+            break;
+
+        case COMPONENT_TYPE_UNORM_SRGB:
+            if (FmtAttribs.ComponentSize != 1)
+                return false;
+            Info.IsSRGB = true;
+            break;
+
+        case COMPONENT_TYPE_SNORM:
+            if (FmtAttribs.ComponentSize != 1 && FmtAttribs.ComponentSize != 2)
+                return false;
+            break;
+
+        case COMPONENT_TYPE_FLOAT:
+            if (FmtAttribs.ComponentSize != 2 && FmtAttribs.ComponentSize != 4)
+                return false;
+            break;
+
+        case COMPONENT_TYPE_UINT:
+        case COMPONENT_TYPE_SINT:
+            if (FmtAttribs.ComponentSize != 1 && FmtAttribs.ComponentSize != 2 && FmtAttribs.ComponentSize != 4)
+                return false;
+            break;
+
+        case COMPONENT_TYPE_DEPTH:
+            // D16_UNORM and D32_FLOAT
+            break;
+
+        default:
+            return false;
+    }
+
+    Info.ComponentType = FmtAttribs.ComponentType;
+    Info.ComponentSize = FmtAttribs.ComponentSize;
+    Info.NumComponents = FmtAttribs.NumComponents;
+    Info.HasAlpha      = FmtAttribs.NumComponents == 4 && Format != TEX_FORMAT_BGRX8_UNORM && Format != TEX_FORMAT_BGRX8_UNORM_SRGB;
+    if (Info.ComponentType == COMPONENT_TYPE_DEPTH)
+        Info.ComponentType = Info.ComponentSize == 2 ? COMPONENT_TYPE_UNORM : COMPONENT_TYPE_FLOAT;
+
+    return true;
+}
+
+
+// Filter kernels
+
+double Sinc(double x)
+{
+    if (std::abs(x) < 1e-6)
+        return 1.0;
+    x *= PI;
+    return std::sin(x) / x;
+}
+
+// Modified Bessel function of the first kind of order zero
+double BesselI0(double x)
+{
+    double Sum  = 1.0;
+    double Term = 1.0;
+    for (int k = 1; k < 32; ++k)
+    {
+        const double t = x / (2.0 * k);
+        Term *= t * t;
+        Sum += Term;
+        if (Term < Sum * 1e-12)
+            break;
+    }
+    return Sum;
+}
+
+static constexpr double KaiserRadius  = 3.0;
+static constexpr double KaiserAlpha   = 4.0;
+static constexpr double LanczosRadius = 3.0;
+
+double KaiserKernel(double x)
+{
+    if (std::abs(x) >= KaiserRadius)
+        return 0.0;
+    const double r = x / KaiserRadius;
+    return Sinc(x) * BesselI0(KaiserAlpha * std::sqrt(1.0 - r * r)) / BesselI0(KaiserAlpha);
+}
+
+double LanczosKernel(double x)
+{
+    if (std::abs(x) >= LanczosRadius)
+        return 0.0;
+    return Sinc(x) * Sinc(x / LanczosRadius);
+}
+
+Int32 AddressCoord(Int32 i, Int32 Size, TEXTURE_ADDRESS_MODE AddressMode)
+{
+    if (i >= 0 && i < Size)
+        return i;
+
+    switch (AddressMode)
+    {
+        case TEXTURE_ADDRESS_WRAP:
+            i = i % Size;
+            return i < 0 ? i + Size : i;
+
+        case TEXTURE_ADDRESS_MIRROR:
+            i = i % (Size * 2);
+            i = i < 0 ? i + Size * 2 : i;
+            return i >= Size ? (Size * 2 - 1) - i : i;
+
+        default:
+            return clamp(i, 0, Size - 1);
+    }
+}
+
+// Filter taps for one dimension. Every destination pixel uses NumTaps source pixels;
+// unused taps have zero weight.
+struct FilterTaps
+{
+    Uint32             NumTaps = 0;
+    std::vector<Int32> Indices;
+    std::vector<float> Weights;
+};
+
+FilterTaps ComputeFilterTaps(Uint32 SrcSize, Uint32 DstSize, IMAGE_FILTER_TYPE Filter, TEXTURE_ADDRESS_MODE AddressMode)
+{
+    const double Scale = static_cast<double>(SrcSize) / static_cast<double>(DstSize);
+    // When the image is minified, the kernel is stretched to cover all source pixels
+    const double FilterScale = std::max(Scale, 1.0);
+    const double Radius      = (Filter == IMAGE_FILTER_BOX ? 0.5 : (Filter == IMAGE_FILTER_KAISER ? KaiserRadius : LanczosRadius)) * FilterScale;
+
+    FilterTaps Taps;
+    Taps.NumTaps = static_cast<Uint32>(std::ceil(Radius * 2.0)) + 1;
+    Taps.Indices.resize(size_t{DstSize} * Taps.NumTaps);
+    Taps.Weights.resize(size_t{DstSize} * Taps.NumTaps);
+
+    std::vector<double> Weights(Taps.NumTaps);
+    for (Uint32 x = 0; x < DstSize; ++x)
+    {
+        const double Center = (x + 0.5) * Scale;
+        const auto   First  = static_cast<Int32>(std::floor(Center - Radius));
+
+        double TotalWeight = 0;
+        for (Uint32 t = 0; t < Taps.NumTaps; ++t)
+        {
+            const double PixelStart = First + static_cast<Int32>(t);
+            double       Weight     = 0;
+            if (Filter == IMAGE_FILTER_BOX)
+            {
+                // The weight is the area of the pixel covered by the filter
+                Weight = std::max(std::min(PixelStart + 1.0, Center + Radius) - std::max(PixelStart, Center - Radius), 0.0);
+            }
+            else
+            {
+                const double d = (PixelStart + 0.5 - Center) / FilterScale;
+                Weight         = Filter == IMAGE_FILTER_KAISER ? KaiserKernel(d) : LanczosKernel(d);
+            }
+            Weights[t] = Weight;
+            TotalWeight += Weight;
+        }
+        VERIFY_EXPR(TotalWeight > 0);
+
+        for (Uint32 t = 0; t < Taps.NumTaps; ++t)
+        {
+            Taps.Indices[size_t{x} * Taps.NumTaps + t] = AddressCoord(First + static_cast<Int32>(t), static_cast<Int32>(SrcSize), AddressMode);
+            Taps.Weights[size_t{x} * Taps.NumTaps + t] = static_cast<float>(Weights[t] / TotalWeight);
+        }
+    }
+
+    return Taps;
+}
+
+
+// Pixel decoding and encoding. Pixels are always expanded to four float components.
+
+class SRGBEncodingTable
+{
+public:
+    SRGBEncodingTable()
+    {
+        // Value k is encoded for linear values in [SRGBToLinear((k - 0.5) / 255), SRGBToLinear((k + 0.5) / 255))
+        for (Uint32 k = 1; k < 256; ++k)
+            m_Thresholds[k - 1] = SRGBToLinear((static_cast<float>(k) - 0.5f) / 255.f);
+    }
+
+    Uint8 Encode(float x) const
+    {
+        return static_cast<Uint8>(std::upper_bound(m_Thresholds, m_Thresholds + 255, x) - m_Thresholds);
+    }
+
+private:
+    float m_Thresholds[255] = {};
+};
+
+const SRGBEncodingTable& GetSRGBEncodingTable()
+{
+    static const SRGBEncodingTable Table;
+    return Table;
+}
+
+template <typename ComponentType>
+float DecodeNorm(ComponentType Value)
+{
+    static constexpr float MaxValue = static_cast<float>(std::numeric_limits<ComponentType>::max());
+    return std::is_signed<ComponentType>::value ?
+        std::max(static_cast<float>(Value) / MaxValue, -1.f) :
+        static_cast<float>(Value) / MaxValue;
+}
+
+template <typename ComponentType>
+ComponentType EncodeNorm(float Value)
+{
+    static constexpr float MaxValue = static_cast<float>(std::numeric_limits<ComponentType>::max());
+    return std::is_signed<ComponentType>::value ?
+        static_cast<ComponentType>(clamp(Value, -1.f, 1.f) * MaxValue + (Value >= 0 ? 0.5f : -0.5f)) :
+        static_cast<ComponentType>(clamp(Value, 0.f, 1.f) * MaxValue + 0.5f);
+}
+
+template <typename ComponentType>
+ComponentType EncodeInt(float Value)
+{
+    const double Rounded = std::floor(static_cast<double>(Value) + 0.5);
+    return static_cast<ComponentType>(clamp(Rounded,
+                                            static_cast<double>(std::numeric_limits<ComponentType>::min()),
+                                            static_cast<double>(std::numeric_limits<ComponentType>::max())));
+}
+
+template <typename ComponentType, typename DecodeFuncType>
+void DecodeComponents(const void* pSrc, Uint32 NumComponents, float* pDst, Uint32 NumPixels, DecodeFuncType Decode)
+{
+    const auto* pSrcComps = static_cast<const ComponentType*>(pSrc);
+    for (Uint32 i = 0; i < NumPixels; ++i)
+    {
+        for (Uint32 c = 0; c < NumComponents; ++c)
+            pDst[i * 4 + c] = Decode(pSrcComps[i * NumComponents + c]);
+    }
+}
+
+template <typename ComponentType, typename EncodeFuncType>
+void EncodeComponents(const float* pSrc, Uint32 NumComponents, void* pDst, Uint32 NumPixels, EncodeFuncType Encode)
+{
+    auto* pDstComps = static_cast<ComponentType*>(pDst);
+    for (Uint32 i = 0; i < NumPixels; ++i)
+    {
+        for (Uint32 c = 0; c < NumComponents; ++c)
+            pDstComps[i * NumComponents + c] = Encode(pSrc[i * 4 + c]);
+    }
+}
+
+void DecodeRow(const void* pSrc, const ResamplingFormatInfo& Info, float* pDst, Uint32 NumPixels, bool Premultiply)
+{
+    // Missing components default to (0, 0, 0, 1)
+    if (Info.NumComponents < 4)
+    {
+        for (Uint32 i = 0; i < NumPixels; ++i)
+        {
+            pDst[i * 4 + 0] = 0;
+            pDst[i * 4 + 1] = 0;
+            pDst[i * 4 + 2] = 0;
+            pDst[i * 4 + 3] = 1;
+        }
+    }
+
+    const auto NumComps = Info.NumComponents;
+    switch (Info.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+        case COMPONENT_TYPE_UNORM_SRGB:
+            if (Info.ComponentSize == 1)
+            {
+                if (Info.IsSRGB)
+                {
+                    const auto* pSrcComps = static_cast<const Uint8*>(pSrc);
+                    for (Uint32 i = 0; i < NumPixels; ++i)
+                    {
+                        for (Uint32 c = 0; c < NumComps; ++c)
+                        {
+                            const auto Value = pSrcComps[i * NumComps + c];
+                            pDst[i * 4 + c]  = c < 3 ? SRGBToLinear(Value) : DecodeNorm<Uint8>(Value);
+                        }
+                    }
+                }
+                else
+                    DecodeComponents<Uint8>(pSrc, NumComps, pDst, NumPixels, DecodeNorm<Uint8>);
+            }
+            else
+            {
+                DecodeComponents<Uint16>(pSrc, NumComps, pDst, NumPixels, DecodeNorm<Uint16>);
+                if (Info.IsSRGB)
+                {
+                    for (Uint32 i = 0; i < NumPixels; ++i)
+                    {
+                        for (Uint32 c = 0; c < 3; ++c)
+                            pDst[i * 4 + c] = SRGBToLinear(pDst[i * 4 + c]);
+                    }
+                }
+            }
+            break;
+
+        case COMPONENT_TYPE_SNORM:
+            if (Info.ComponentSize == 1)
+                DecodeComponents<Int8>(pSrc, NumComps, pDst, NumPixels, DecodeNorm<Int8>);
+            else
+                DecodeComponents<Int16>(pSrc, NumComps, pDst, NumPixels, DecodeNorm<Int16>);
+            break;
+
+        case COMPONENT_TYPE_FLOAT:
+            if (Info.ComponentSize == 2)
+                DecodeComponents<Uint16>(pSrc, NumComps, pDst, NumPixels, HalfToFloat);
+            else if (NumComps == 4)
+                memcpy(pDst, pSrc, size_t{NumPixels} * 16);
+            else
+                DecodeComponents<float>(pSrc, NumComps, pDst, NumPixels, [](float f) { return f; });
+            break;
+
+        case COMPONENT_TYPE_UINT:
+        case COMPONENT_TYPE_SINT:
+        {
+            const auto ToFloat = [](double v) {
+                return static_cast<float>(v);
+            };
+            const bool IsSigned = Info.ComponentType == COMPONENT_TYPE_SINT;
+            switch (Info.ComponentSize)
+            {
+                // clang-format off
+                case 1: IsSigned ? DecodeComponents<Int8> (pSrc, NumComps, pDst, NumPixels, ToFloat) : DecodeComponents<Uint8> (pSrc, NumComps, pDst, NumPixels, ToFloat); break;
+                case 2: IsSigned ? DecodeComponents<Int16>(pSrc, NumComps, pDst, NumPixels, ToFloat) : DecodeComponents<Uint16>(pSrc, NumComps, pDst, NumPixels, ToFloat); break;
+                case 4: IsSigned ? DecodeComponents<Int32>(pSrc, NumComps, pDst, NumPixels, ToFloat) : DecodeComponents<Uint32>(pSrc, NumComps, pDst, NumPixels, ToFloat); break;
+                // clang-format on
+                default: UNEXPECTED("Unexpected component size");
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected component type");
+    }
+
+    if (Premultiply)
+    {
+        for (Uint32 i = 0; i < NumPixels; ++i)
+        {
+            const float Alpha = pDst[i * 4 + 3];
+            pDst[i * 4 + 0] *= Alpha;
+            pDst[i * 4 + 1] *= Alpha;
+            pDst[i * 4 + 2] *= Alpha;
+        }
+    }
+}
+
+void EncodeRow(float* pSrc, const ResamplingFormatInfo& Info, void* pDst, Uint32 NumPixels, bool Premultiply)
+{
+    if (Premultiply)
+    {
+        for (Uint32 i = 0; i < NumPixels; ++i)
+        {
+            const float Alpha = pSrc[i * 4 + 3];
+            const float Scale = Alpha > 0 ? 1.f / Alpha : 0.f;
+            pSrc[i * 4 + 0] *= Scale;
+            pSrc[i * 4 + 1] *= Scale;
+            pSrc[i * 4 + 2] *= Scale;
+        }
+    }
+
+    const auto NumComps = Info.NumComponents;
+    switch (Info.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+        case COMPONENT_TYPE_UNORM_SRGB:
+            if (Info.ComponentSize == 1)
+            {
+                if (Info.IsSRGB)
+                {
+                    const auto& Table     = GetSRGBEncodingTable();
+                    auto*       pDstComps = static_cast<Uint8*>(pDst);
+                    for (Uint32 i = 0; i < NumPixels; ++i)
+                    {
+                        for (Uint32 c = 0; c < NumComps; ++c)
+                        {
+                            const auto Value            = pSrc[i * 4 + c];
+                            pDstComps[i * NumComps + c] = c < 3 ? Table.Encode(Value) : EncodeNorm<Uint8>(Value);
+                        }
+                    }
+                }
+                else
+                    EncodeComponents<Uint8>(pSrc, NumComps, pDst, NumPixels, EncodeNorm<Uint8>);
+            }
+            else
+            {
+                if (Info.IsSRGB)
+                {
+                    for (Uint32 i = 0; i < NumPixels; ++i)
+                    {
+                        for (Uint32 c = 0; c < 3; ++c)
+                            pSrc[i * 4 + c] = LinearToSRGB(std::max(pSrc[i * 4 + c], 0.f));
+                    }
+                }
+                EncodeComponents<Uint16>(pSrc, NumComps, pDst, NumPixels, EncodeNorm<Uint16>);
+            }
+            break;
+
+        case COMPONENT_TYPE_SNORM:
+            if (Info.ComponentSize == 1)
+                EncodeComponents<Int8>(pSrc, NumComps, pDst, NumPixels, EncodeNorm<Int8>);
+            else
+                EncodeComponents<Int16>(pSrc, NumComps, pDst, NumPixels, EncodeNorm<Int16>);
+            break;
+
+        case COMPONENT_TYPE_FLOAT:
+            if (Info.ComponentSize == 2)
+                EncodeComponents<Uint16>(pSrc, NumComps, pDst, NumPixels, FloatToHalf);
+            else if (NumComps == 4)
+                memcpy(pDst, pSrc, size_t{NumPixels} * 16);
+            else
+                EncodeComponents<float>(pSrc, NumComps, pDst, NumPixels, [](float f) { return f; });
+            break;
+
+        case COMPONENT_TYPE_UINT:
+        case COMPONENT_TYPE_SINT:
+        {
+            const bool IsSigned = Info.ComponentType == COMPONENT_TYPE_SINT;
+            switch (Info.ComponentSize)
+            {
+                // clang-format off
+                case 1: IsSigned ? EncodeComponents<Int8> (pSrc, NumComps, pDst, NumPixels, EncodeInt<Int8>)  : EncodeComponents<Uint8> (pSrc, NumComps, pDst, NumPixels, EncodeInt<Uint8>);  break;
+                case 2: IsSigned ? EncodeComponents<Int16>(pSrc, NumComps, pDst, NumPixels, EncodeInt<Int16>) : EncodeComponents<Uint16>(pSrc, NumComps, pDst, NumPixels, EncodeInt<Uint16>); break;
+                case 4: IsSigned ? EncodeComponents<Int32>(pSrc, NumComps, pDst, NumPixels, EncodeInt<Int32>) : EncodeComponents<Uint32>(pSrc, NumComps, pDst, NumPixels, EncodeInt<Uint32>); break;
+                // clang-format on
+                default: UNEXPECTED("Unexpected component size");
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected component type");
+    }
+}
+
+
+// Filter kernels. Every pixel is four floats, which maps to one SSE/NEON register.
+// Products are accumulated in the order of the taps, so the SIMD and scalar paths
+// produce identical results.
+
+void FilterRowHorz(const float* pSrc, float* pDst, const FilterTaps& Taps, Uint32 DstWidth)
+{
+    const auto* pIndices = Taps.Indices.data();
+    const auto* pWeights = Taps.Weights.data();
+    for (Uint32 x = 0; x < DstWidth; ++x, pIndices += Taps.NumTaps, pWeights += Taps.NumTaps)
+    {
+#if DILIGENT_SSE_MATH
+        __m128 Sum = _mm_setzero_ps();
+        for (Uint32 t = 0; t < Taps.NumTaps; ++t)
+            Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_set1_ps(pWeights[t]), _mm_loadu_ps(pSrc + pIndices[t] * 4)));
+        _mm_storeu_ps(pDst + x * 4, Sum);
+#elif DILIGENT_NEON_MATH
+        float32x4_t Sum = vdupq_n_f32(0);
+        for (Uint32 t = 0; t < Taps.NumTaps; ++t)
+            Sum = vaddq_f32(Sum, vmulq_n_f32(vld1q_f32(pSrc + pIndices[t] * 4), pWeights[t]));
+        vst1q_f32(pDst + x * 4, Sum);
+#else
+        float Sum[4] = {};
+        for (Uint32 t = 0; t < Taps.NumTaps; ++t)
+        {
+            const float* pSrcPixel = pSrc + pIndices[t] * 4;
+            for (Uint32 c = 0; c < 4; ++c)
+                Sum[c] = Sum[c] + pWeights[t] * pSrcPixel[c];
+        }
+        memcpy(pDst + x * 4, Sum, sizeof(Sum));
+#endif
+    }
+}
+
+void AccumulateRow(float* pDst, const float* pSrc, float Weight, Uint32 NumFloats)
+{
+    Uint32 i = 0;
+#if DILIGENT_SSE_MATH
+    const __m128 w = _mm_set1_ps(Weight);
+    for (; i + 4 <= NumFloats; i += 4)
+        _mm_storeu_ps(pDst + i, _mm_add_ps(_mm_loadu_ps(pDst + i), _mm_mul_ps(w, _mm_loadu_ps(pSrc + i))));
+#elif DILIGENT_NEON_MATH
+    for (; i + 4 <= NumFloats; i += 4)
+        vst1q_f32(pDst + i, vaddq_f32(vld1q_f32(pDst + i), vmulq_n_f32(vld1q_f32(pSrc + i), Weight)));
+#endif
+    for (; i < NumFloats; ++i)
+        pDst[i] = pDst[i] + Weight * pSrc[i];
+}
+
+
+// If pSrcFloat is not null, the source pixels are read from it instead of decoding the source image.
+// If pDstFloat is not null, the filtered pixels are also written to it before they are encoded.
+// Both buffers contain tightly packed four-component pixels in linear (and premultiplied, if
+// requested) space.
+class ImageResampler
+{
+public:
+    ImageResampler(const ImageResamplingAttribs& Attribs, const ResamplingFormatInfo& FmtInfo, const float* pSrcFloat, float* pDstFloat) :
+        m_Attribs{Attribs},
+        m_FmtInfo{FmtInfo},
+        m_Premultiply{(Attribs.Flags & IMAGE_RESAMPLING_FLAG_PREMULTIPLY_ALPHA) != 0 && FmtInfo.HasAlpha},
+        m_TapsX{ComputeFilterTaps(Attribs.SrcWidth, Attribs.DstWidth, Attribs.Filter, Attribs.AddressMode)},
+        m_TapsY{ComputeFilterTaps(Attribs.SrcHeight, Attribs.DstHeight, Attribs.Filter, Attribs.AddressMode)},
+        m_pSrcFloat{pSrcFloat},
+        m_pDstFloat{pDstFloat}
+    {}
+
+    Uint32 GetNumTapsY() const { return m_TapsY.NumTaps; }
+
+    // Resamples destination rows [StartRow, EndRow). The method may be called from multiple threads.
+    void ProcessRows(Uint32 StartRow, Uint32 EndRow) const
+    {
+        const auto DstWidth = m_Attribs.DstWidth;
+
+        // Horizontally filtered source rows are cached, so that every source row is decoded
+        // and filtered only once when destination rows are processed in order.
+        const Uint32        NumSlots = m_TapsY.NumTaps + 1;
+        std::vector<float>  SlotData(size_t{NumSlots} * DstWidth * 4);
+        std::vector<Int32>  SlotRow(NumSlots, -1);
+        std::vector<Uint32> SlotStamp(NumSlots, ~0u);
+        Uint32              NextSlot = 0;
+
+        std::vector<float> DecodedRow(m_pSrcFloat == nullptr ? size_t{m_Attribs.SrcWidth} * 4 : 0);
+        std::vector<float> DstRow(size_t{DstWidth} * 4);
+
+        const auto GetFilteredRow = [&](Int32 SrcRow, Uint32 Stamp) -> const float* {
+            for (Uint32 s = 0; s < NumSlots; ++s)
+            {
+                if (SlotRow[s] == SrcRow)
+                {
+                    SlotStamp[s] = Stamp;
+                    return &SlotData[size_t{s} * DstWidth * 4];
+                }
+            }
+
+            // Do not evict the rows used by the current destination row
+            while (SlotStamp[NextSlot] == Stamp)
+                NextSlot = (NextSlot + 1) % NumSlots;
+
+            const float* pDecodedRow = nullptr;
+            if (m_pSrcFloat != nullptr)
+            {
+                pDecodedRow = m_pSrcFloat + static_cast<size_t>(SrcRow) * m_Attribs.SrcWidth * 4;
+            }
+            else
+            {
+                const auto* pSrcRow = static_cast<const Uint8*>(m_Attribs.pSrcData) + size_t{m_Attribs.SrcStride} * SrcRow;
+                DecodeRow(pSrcRow, m_FmtInfo, DecodedRow.data(), m_Attribs.SrcWidth, m_Premultiply);
+                pDecodedRow = DecodedRow.data();
+            }
+
+            auto* pSlotData = &SlotData[size_t{NextSlot} * DstWidth * 4];
+            FilterRowHorz(pDecodedRow, pSlotData, m_TapsX, DstWidth);
+            SlotRow[NextSlot]   = SrcRow;
+            SlotStamp[NextSlot] = Stamp;
+            NextSlot            = (NextSlot + 1) % NumSlots;
+            return pSlotData;
+        };
+
+        for (Uint32 y = StartRow; y < EndRow; ++y)
+        {
+            std::fill(DstRow.begin(), DstRow.end(), 0.f);
+            for (Uint32 t = 0; t < m_TapsY.NumTaps; ++t)
+            {
+                const auto Weight = m_TapsY.Weights[size_t{y} * m_TapsY.NumTaps + t];
+                if (Weight == 0)
+                    continue;
+
+                const auto* pFilteredRow = GetFilteredRow(m_TapsY.Indices[size_t{y} * m_TapsY.NumTaps + t], y);
+                AccumulateRow(DstRow.data(), pFilteredRow, Weight, DstWidth * 4);
+            }
+
+            if (m_pDstFloat != nullptr)
+                memcpy(m_pDstFloat + size_t{y} * DstWidth * 4, DstRow.data(), size_t{DstWidth} * 16);
+
+            auto* pDstRow = static_cast<Uint8*>(m_Attribs.pDstData) + size_t{m_Attribs.DstStride} * y;
+            EncodeRow(DstRow.data(), m_FmtInfo, pDstRow, DstWidth, m_Premultiply);
+        }
+    }
+
+private:
+    const ImageResamplingAttribs& m_Attribs;
+    const ResamplingFormatInfo&   m_FmtInfo;
+    const bool                    m_Premultiply;
+    const FilterTaps              m_TapsX;
+    const FilterTaps              m_TapsY;
+    const float* const            m_pSrcFloat;
+    float* const                  m_pDstFloat;
+};
+
+bool ResampleImageImpl(const ImageResamplingAttribs& Attribs, const float* pSrcFloat, float* pDstFloat)
+{
+    ResamplingFormatInfo FmtInfo;
+    if (!GetResamplingFormatInfo(Attribs.Format, Attribs.Flags, FmtInfo))
+    {
+        LOG_ERROR_MESSAGE("Resampling of ", GetTextureFormatAttribs(Attribs.Format).Name, " images is not supported");
+        return false;
+    }
+
+    if (Attribs.Filter >= IMAGE_FILTER_COUNT)
+    {
+        LOG_ERROR_MESSAGE("Unknown image filter type");
+        return false;
+    }
+
+    if (Attribs.AddressMode != TEXTURE_ADDRESS_CLAMP && Attribs.AddressMode != TEXTURE_ADDRESS_WRAP && Attribs.AddressMode != TEXTURE_ADDRESS_MIRROR)
+    {
+        LOG_ERROR_MESSAGE("Only clamp, wrap and mirror address modes are supported");
+        return false;
+    }
+
+    if (Attribs.DstWidth == 0 || Attribs.DstHeight == 0)
+        return true;
+
+    if (Attribs.SrcWidth == 0 || Attribs.SrcHeight == 0 || Attribs.pSrcData == nullptr || Attribs.pDstData == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Source and destination data must not be null");
+        return false;
+    }
+
+    const auto PixelSize = FmtInfo.GetPixelSize();
+    if (Attribs.SrcStride < Attribs.SrcWidth * PixelSize || Attribs.DstStride < Attribs.DstWidth * PixelSize)
+    {
+        LOG_ERROR_MESSAGE("Row strides are too small for the image width");
+        return false;
+    }
+
+    const ImageResampler Resampler{Attribs, FmtInfo, pSrcFloat, pDstFloat};
+
+    // Do not split images that are processed faster than the work is distributed between threads
+    static constexpr Uint32 MinPixelsPerThread = 64 * 1024;
+
+    auto&        ThreadPool = WorkerThreadPool::GetDefault();
+    const Uint64 NumPixels  = Uint64{Attribs.DstWidth} * Attribs.DstHeight * Resampler.GetNumTapsY();
+
+    Uint32 NumThreads = Attribs.MaxThreads != 0 ? Attribs.MaxThreads : ThreadPool.GetNumThreads() + 1;
+    NumThreads        = static_cast<Uint32>(std::min(Uint64{NumThreads}, std::max(NumPixels / MinPixelsPerThread, Uint64{1})));
+    NumThreads        = std::min(NumThreads, Attribs.DstHeight);
+    if (NumThreads <= 1)
+    {
+        Resampler.ProcessRows(0, Attribs.DstHeight);
+        return true;
+    }
+
+    // Split the image into bands of rows that are processed by the calling thread and the thread pool
+    const Uint32 RowsPerBand = (Attribs.DstHeight + NumThreads - 1) / NumThreads;
+    const Uint32 NumBands    = (Attribs.DstHeight + RowsPerBand - 1) / RowsPerBand;
+    ThreadPool.ParallelFor(NumBands, [&](Uint32 Band) {
+        const Uint32 StartRow = Band * RowsPerBand;
+        Resampler.ProcessRows(StartRow, std::min(StartRow + RowsPerBand, Attribs.DstHeight));
+    });
+
+    return true;
+}
+
+} // namespace
+
+bool IsImageResamplingSupported(TEXTURE_FORMAT Format)
+{
+    ResamplingFormatInfo FmtInfo;
+    return GetResamplingFormatInfo(Format, IMAGE_RESAMPLING_FLAG_NONE, FmtInfo);
+}
+
+bool ResampleImage(const ImageResamplingAttribs& Attribs)
+{
+    return ResampleImageImpl(Attribs, nullptr, nullptr);
+}
+
+bool GenerateMipChain(const MipChainGenerationAttribs& Attribs)
+{
+    if (Attribs.NumMipLevels == 0)
+        return true;
+
+    if (Attribs.pMipLevels == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Mip level data must not be null");
+        return false;
+    }
+
+    if (Attribs.Width == 0 || Attribs.Height == 0)
+    {
+        LOG_ERROR_MESSAGE("Image size must not be zero");
+        return false;
+    }
+
+    const auto MaxMipLevels = ComputeMipLevelsCount(Attribs.Width, Attribs.Height) - 1;
+    if (Attribs.NumMipLevels > MaxMipLevels)
+    {
+        LOG_ERROR_MESSAGE("The number of mip levels (", Attribs.NumMipLevels, ") exceeds the number of levels in the full mip chain of a ",
+                          Attribs.Width, "x", Attribs.Height, " image (", MaxMipLevels, ")");
+        return false;
+    }
+
+    // Kaiser and Lanczos filters have negative lobes, so quantizing and clamping every level would
+    // accumulate ringing and rounding errors. These filters compute every level from the unquantized
+    // pixels of the previous level. The box filter uses the stored previous level, like GenerateMips().
+    const bool         UseFloatChain = Attribs.Filter != IMAGE_FILTER_BOX;
+    std::vector<float> FloatLevels[2];
+
+    ImageResamplingAttribs ResampleAttribs;
+    ResampleAttribs.pSrcData    = Attribs.pSrcData;
+    ResampleAttribs.SrcStride   = Attribs.SrcStride;
+    ResampleAttribs.SrcWidth    = Attribs.Width;
+    ResampleAttribs.SrcHeight   = Attribs.Height;
+    ResampleAttribs.Format      = Attribs.Format;
+    ResampleAttribs.Filter      = Attribs.Filter;
+    ResampleAttribs.AddressMode = Attribs.AddressMode;
+    ResampleAttribs.Flags       = Attribs.Flags;
+    ResampleAttribs.MaxThreads  = Attribs.MaxThreads;
+
+    for (Uint32 Mip = 0; Mip < Attribs.NumMipLevels; ++Mip)
+    {
+        const auto& MipLevel = Attribs.pMipLevels[Mip];
+
+        ResampleAttribs.pDstData  = MipLevel.pData;
+        ResampleAttribs.DstStride = MipLevel.Stride;
+        ResampleAttribs.DstWidth  = std::max(Attribs.Width >> (Mip + 1), 1u);
+        ResampleAttribs.DstHeight = std::max(Attribs.Height >> (Mip + 1), 1u);
+
+        const float* pSrcFloat = nullptr;
+        float*       pDstFloat = nullptr;
+        if (UseFloatChain)
+        {
+            auto& DstLevel = FloatLevels[Mip % 2];
+            DstLevel.resize(size_t{ResampleAttribs.DstWidth} * ResampleAttribs.DstHeight * 4);
+            pDstFloat = DstLevel.data();
+            if (Mip > 0)
+                pSrcFloat = FloatLevels[(Mip + 1) % 2].data();
+        }
+        if (!ResampleImageImpl(ResampleAttribs, pSrcFloat, pDstFloat))
+            return false;
+
+        // The next level is computed from this one
+        ResampleAttribs.pSrcData  = ResampleAttribs.pDstData;
+        ResampleAttribs.SrcStride = ResampleAttribs.DstStride;
+        ResampleAttribs.SrcWidth  = ResampleAttribs.DstWidth;
+        ResampleAttribs.SrcHeight = ResampleAttribs.DstHeight;
+    }
+
+    return true;
+}
+
+} // namespace Diligent
@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BoundObjectPtr and Diligent::FrameRetainedObjects classes
+
+#include <vector>
+#include <array>
+
+#include "Object.h"
+#include "RefCntAutoPtr.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Pointer to an object bound to the device context.
+
+/// Depending on the binding mode of the context, the pointer either keeps a strong reference
+/// to the object (similar to RefCntAutoPtr), or a raw pointer. In the latter case, the context
+/// keeps the object alive through its frame retention list (see Diligent::FrameRetainedObjects).
+template <typename T>
+class BoundObjectPtr
+{
+public:
+    BoundObjectPtr() noexcept {}
+
+    ~BoundObjectPtr()
+    {
+        Release();
+    }
+
+    // clang-format off
+    BoundObjectPtr           (const BoundObjectPtr&) = delete;
+    BoundObjectPtr& operator=(const BoundObjectPtr&) = delete;
+    // clang-format on
+
+    BoundObjectPtr(BoundObjectPtr&& Other) noexcept :
+        // clang-format off
+        m_pObject {Other.m_pObject },
+        m_IsStrong{Other.m_IsStrong}
+    // clang-format on
+    {
+        Other.m_pObject  = nullptr;
+        Other.m_IsStrong = false;
+    }
+
+    BoundObjectPtr& operator=(BoundObjectPtr&& Other) noexcept
+    {
+        if (this != &Other)
+        {
+            Release();
+            m_pObject        = Other.m_pObject;
+            m_IsStrong       = Other.m_IsStrong;
+            Other.m_pObject  = nullptr;
+            Other.m_IsStrong = false;
+        }
+        return *this;
+    }
+
+    /// Binds the object. If KeepStrongReference is false, the caller is responsible
+    /// for keeping the object alive while it is bound.
+    void Set(T* pObject, bool KeepStrongReference)
+    {
+        if (pObject == m_pObject && KeepStrongReference == m_IsStrong)
+            return;
+
+        // Add reference to the new object before releasing the old one as they may be the same object
+        if (pObject != nullptr && KeepStrongReference)
+            pObject->AddRef();
+        Release();
+        m_pObject  = pObject;
+        m_IsStrong = pObject != nullptr && KeepStrongReference;
+    }
+
+    void Release()
+    {
+        if (m_pObject != nullptr && m_IsStrong)
+            m_pObject->Release();
+        m_pObject  = nullptr;
+        m_IsStrong = false;
+    }
+
+    BoundObjectPtr& operator=(std::nullptr_t)
+    {
+        Release();
+        return *this;
+    }
+
+    bool IsStrong() const { return m_IsStrong; }
+
+    T* RawPtr() const { return m_pObject; }
+
+    template <typename DstType>
+    DstType* RawPtr() const { return static_cast<DstType*>(m_pObject); }
+
+    operator T*() const { return m_pObject; }
+
+    T* operator->() const { return m_pObject; }
+
+    T& operator*() const { return *m_pObject; }
+
+    bool operator!() const { return m_pObject == nullptr; }
+
+private:
+    T*   m_pObject  = nullptr;
+    bool m_IsStrong = false;
+};
+
+
+/// List of objects that were bound to the device context during the frame.
+
+/// Every object is added to the list (and its reference counter is incremented) once per frame
+/// rather than every time it is bound. To find out if the object is already in the list, a small
+/// direct-mapped table of recently retained pointers is used. A table miss results in a duplicate
+/// entry, which only costs one extra reference.
+class FrameRetainedObjects
+{
+public:
+    using ObjectList = std::vector<RefCntAutoPtr<IObject>>;
+
+    FrameRetainedObjects()
+    {
+        m_RecentObjects.fill(nullptr);
+    }
+
+    // clang-format off
+    FrameRetainedObjects           (const FrameRetainedObjects&) = delete;
+    FrameRetainedObjects           (FrameRetainedObjects&&)      = delete;
+    FrameRetainedObjects& operator=(const FrameRetainedObjects&) = delete;
+    FrameRetainedObjects& operator=(FrameRetainedObjects&&)      = delete;
+    // clang-format on
+
+    void Retain(IObject* pObject)
+    {
+        VERIFY_EXPR(pObject != nullptr);
+        // Objects are allocated with at least 16-byte alignment, so discard the low bits
+        const auto Slot = (reinterpret_cast<size_t>(pObject) >> 4) % RecentObjectsTableSize;
+        if (m_RecentObjects[Slot] == pObject)
+            return;
+
+        m_RecentObjects[Slot] = pObject;
+        m_Objects.emplace_back(pObject);
+    }
+
+    /// Moves all retained objects to Objects and starts a new frame.
+    void ExtractObjects(ObjectList& Objects)
+    {
+        VERIFY(Objects.empty(), "The list must be empty");
+        Objects.reserve(m_Objects.size());
+        m_Objects.swap(Objects);
+        m_RecentObjects.fill(nullptr);
+    }
+
+    size_t GetNumObjects() const { return m_Objects.size(); }
+
+private:
+    static constexpr size_t RecentObjectsTableSize = 256;
+
+    std::array<const IObject*, RecentObjectsTableSize> m_RecentObjects;
+
+    ObjectList m_Objects;
+};
+
+} // namespace Diligent
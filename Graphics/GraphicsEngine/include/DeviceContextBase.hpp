@@ -31,6 +31,8 @@
 /// Implementation of the Diligent::DeviceContextBase template class and related structures
 
 #include <unordered_map>
+#include <vector>
+#include <algorithm>
 
 #include "DeviceContext.h"
 #include "DeviceObjectBase.hpp"
@@ -41,6 +43,12 @@
 #include "ValidatedCast.hpp"
 #include "GraphicsAccessories.hpp"
 #include "TextureBase.hpp"
+#include "BoundObjectPtr.hpp"
+
+#ifndef DILIGENT_CONTEXT_STATS
+// Device context statistics are enabled unless the build system explicitly disables them
+#    define DILIGENT_CONTEXT_STATS 1
+#endif
 
 namespace Diligent
 {
@@ -51,9 +59,9 @@ struct VertexStreamInfo
 {
     VertexStreamInfo() {}
 
-    /// Strong reference to the buffer object
-    RefCntAutoPtr<BufferImplType> pBuffer;
-    Uint32                        Offset = 0; ///< Offset in bytes
+    /// Reference to the buffer object (see BoundObjectPtr)
+    BoundObjectPtr<BufferImplType> pBuffer;
+    Uint32                         Offset = 0; ///< Offset in bytes
 };
 
 /// Base implementation of the device context.
@@ -65,6 +73,9 @@ struct VertexStreamInfo
 ///          the pipeline: buffers, states, samplers, shaders, etc.
 ///          The context also keeps strong references to the device and
 ///          the swap chain.
+///          When frame-retained bindings are enabled (see IDeviceContext::SetFrameRetainedBindingsEnabled()),
+///          the context keeps raw pointers to the bound objects instead and adds every object to
+///          the frame retention list once per frame.
 template <typename BaseInterface, typename ImplementationTraits>
 class DeviceContextBase : public ObjectBase<BaseInterface>
 {
@@ -197,6 +208,35 @@ public:
 
     bool IsDeferred() const { return m_bIsDeferred; }
 
+    /// Implementation of IDeviceContext::GetStats().
+    virtual const DeviceContextStats& DILIGENT_CALL_TYPE GetStats() const override final { return m_Stats; }
+
+    /// Implementation of IDeviceContext::ResetStats().
+    virtual void DILIGENT_CALL_TYPE ResetStats() override final { m_Stats = DeviceContextStats{}; }
+
+    /// Implementation of IDeviceContext::SetStateFilteringEnabled().
+    virtual void DILIGENT_CALL_TYPE SetStateFilteringEnabled(bool Enable) override final
+    {
+        m_StateFilteringEnabled = Enable;
+        if (!m_StateFilteringEnabled)
+            ResetCommittedShaderResources();
+    }
+
+    /// Implementation of IDeviceContext::SetFrameRetainedBindingsEnabled().
+    virtual void DILIGENT_CALL_TYPE SetFrameRetainedBindingsEnabled(bool Enable) override final;
+
+    /// Base implementation of IDeviceContext::SubmitDrawPackets(); sorts the packets and
+    /// executes them through the regular context methods with redundant state filtering enabled.
+    virtual void DILIGENT_CALL_TYPE SubmitDrawPackets(const SubmitDrawPacketsAttribs& Attribs) override final;
+
+    /// Base implementation of IDeviceContext::MultiDrawIndirect(); executes the draws one by one
+    /// through IDeviceContext::DrawIndirect(). Backends with native support override this method.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override;
+
+    /// Base implementation of IDeviceContext::MultiDrawIndexedIndirect(); executes the draws one by one
+    /// through IDeviceContext::DrawIndexedIndirect(). Backends with native support override this method.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override;
+
     /// Checks if a texture is bound as a render target or depth-stencil buffer and
     /// resets render targets if it is.
     bool UnbindTextureFromFramebuffer(TextureImplType* pTexture, bool bShowMessage);
@@ -225,16 +265,100 @@ protected:
 
     bool EndQuery(IQuery* pQuery, int);
 
+    bool BeginDebugGroup(const Char* Name, int);
+
+    bool EndDebugGroup(int);
+
+    /// Returns true if redundant state filtering is enabled and the vertex buffers
+    /// being set are identical to the ones already bound to the context.
+    bool IsRedundantVertexBuffers(Uint32                         StartSlot,
+                                  Uint32                         NumBuffersSet,
+                                  IBuffer**                      ppBuffers,
+                                  const Uint32*                  pOffsets,
+                                  RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                  SET_VERTEX_BUFFERS_FLAGS       Flags) const;
+
+    /// Returns true if redundant state filtering is enabled and the index buffer
+    /// being set is identical to the one already bound to the context.
+    bool IsRedundantIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) const;
+
+    /// Returns true if redundant state filtering is enabled and the viewports
+    /// being set are identical to the current viewports.
+    bool IsRedundantViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight) const;
+
+    /// Returns true if redundant state filtering is enabled and the scissor rects
+    /// being set are identical to the current scissor rects.
+    bool IsRedundantScissorRects(Uint32 NumRects, const Rect* pRects) const;
+
+    /// Returns true if redundant state filtering is enabled and the shader resource binding
+    /// has already been committed since the current pipeline state was set. Commits of
+    /// pipelines with dynamic variables are never redundant as the variables may have changed.
+    bool IsRedundantShaderResourceCommit(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) const;
+
+    /// Returns the stride between consecutive indirect draw commands, resolving zero to the tightly packed size.
+    static Uint32 GetIndirectDrawArgsStride(Uint32 Stride, bool Indexed)
+    {
+        // DrawIndirect arguments are {NumVertices, NumInstances, StartVertex, FirstInstance},
+        // DrawIndexedIndirect arguments are {NumIndices, NumInstances, FirstIndex, BaseVertex, FirstInstance}
+        return Stride != 0 ? Stride : static_cast<Uint32>(sizeof(Uint32) * (Indexed ? 5 : 4));
+    }
+
+    void ResetCommittedShaderResources()
+    {
+        m_pCommittedSRB.Release();
+        m_ShaderResourcesCommitted = false;
+    }
+
+    /// Binds the object using the current binding mode of the context.
+    template <typename ObjectType>
+    void BindObject(BoundObjectPtr<ObjectType>& Binding, ObjectType* pObject)
+    {
+        if (m_FrameRetainedBindingsEnabled && pObject != nullptr)
+        {
+            // Increment the reference counter only the first time the object is bound during the frame
+            m_FrameRetainedObjects.Retain(pObject);
+            Binding.Set(pObject, false);
+        }
+        else
+        {
+            Binding.Set(pObject, true);
+        }
+    }
+
+    /// Moves the objects retained during the current frame to Objects and retains the
+    /// objects that stay bound to the context for the next frame. Backends must call this method
+    /// from FinishFrame() and release the objects once the GPU is done with the frame.
+    void ExtractFrameRetainedObjects(FrameRetainedObjects::ObjectList& Objects);
+
+    /// Increments the statistics counter; compiles to nothing when statistics are disabled.
+    void UpdateStats(Uint32 DeviceContextStats::*pCounter, Uint32 Value = 1)
+    {
+#if DILIGENT_CONTEXT_STATS
+        m_Stats.*pCounter += Value;
+#endif
+    }
+
+    void UpdateStats(Uint64 DeviceContextStats::*pCounter, Uint64 Value)
+    {
+#if DILIGENT_CONTEXT_STATS
+        m_Stats.*pCounter += Value;
+#endif
+    }
+
 #ifdef DILIGENT_DEVELOPMENT
     // clang-format off
     bool DvpVerifyDrawArguments               (const DrawAttribs&                Attribs)const;
     bool DvpVerifyDrawIndexedArguments        (const DrawIndexedAttribs&         Attribs)const;
     bool DvpVerifyDrawIndirectArguments       (const DrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer)const;
     bool DvpVerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const;
+    bool DvpVerifyMultiDrawIndirectArguments       (const MultiDrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer)const;
+    bool DvpVerifyMultiDrawIndexedIndirectArguments(const MultiDrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const;
 
     bool DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs)const;
     bool DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const;
 
+    bool DvpVerifyMultiDrawParams(const char* CmdName, DRAW_FLAGS Flags, Uint32 Stride, Uint32 MinStride, const IBuffer* pCountBuffer)const;
+
     void DvpVerifyRenderTargets()const;
     void DvpVerifyStateTransitionDesc(const StateTransitionDesc& Barrier)const;
     bool DvpVerifyTextureState(const TextureImplType& Texture, RESOURCE_STATE RequiredState, const char* OperationName)const;
@@ -244,6 +368,8 @@ protected:
     bool DvpVerifyDrawIndexedArguments        (const DrawIndexedAttribs&         Attribs)const {return true;}
     bool DvpVerifyDrawIndirectArguments       (const DrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer)const {return true;}
     bool DvpVerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const {return true;}
+    bool DvpVerifyMultiDrawIndirectArguments       (const MultiDrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer)const {return true;}
+    bool DvpVerifyMultiDrawIndexedIndirectArguments(const MultiDrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const {return true;}
 
     bool DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs)const {return true;}
     bool DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const {return true;}
@@ -264,15 +390,15 @@ protected:
     /// Number of bound vertex streams
     Uint32 m_NumVertexStreams = 0;
 
-    /// Strong reference to the bound pipeline state object.
+    /// Reference to the bound pipeline state object.
     /// Use final PSO implementation type to avoid virtual calls to AddRef()/Release().
-    /// We need to keep strong reference as we examine previous pipeline state in
+    /// We need to keep the object alive as we examine previous pipeline state in
     /// SetPipelineState()
-    RefCntAutoPtr<PipelineStateImplType> m_pPipelineState;
+    BoundObjectPtr<PipelineStateImplType> m_pPipelineState;
 
-    /// Strong reference to the bound index buffer.
+    /// Reference to the bound index buffer.
     /// Use final buffer implementation type to avoid virtual calls to AddRef()/Release()
-    RefCntAutoPtr<BufferImplType> m_pIndexBuffer;
+    BoundObjectPtr<BufferImplType> m_pIndexBuffer;
 
     /// Offset from the beginning of the index buffer to the start of the index data, in bytes.
     Uint32 m_IndexDataStartOffset = 0;
@@ -293,9 +419,9 @@ protected:
     /// Number of current scissor rects
     Uint32 m_NumScissorRects = 0;
 
-    /// Vector of strong references to the bound render targets.
+    /// Vector of references to the bound render targets.
     /// Use final texture view implementation type to avoid virtual calls to AddRef()/Release()
-    RefCntAutoPtr<TextureViewImplType> m_pBoundRenderTargets[MAX_RENDER_TARGETS];
+    BoundObjectPtr<TextureViewImplType> m_pBoundRenderTargets[MAX_RENDER_TARGETS];
     /// Number of bound render targets
     Uint32 m_NumBoundRenderTargets = 0;
     /// Width of the currently bound framebuffer
@@ -305,12 +431,59 @@ protected:
     /// Number of array slices in the currently bound framebuffer
     Uint32 m_FramebufferSlices = 0;
 
-    /// Strong references to the bound depth stencil view.
+    /// Reference to the bound depth stencil view.
     /// Use final texture view implementation type to avoid virtual calls to AddRef()/Release()
-    RefCntAutoPtr<TextureViewImplType> m_pBoundDepthStencil;
+    BoundObjectPtr<TextureViewImplType> m_pBoundDepthStencil;
 
     const bool m_bIsDeferred = false;
 
+    /// Number of debug groups that have been begun, but not ended
+    Uint32 m_DebugGroupDepth = 0;
+
+    DeviceContextStats m_Stats;
+
+    /// Indicates if redundant state changes are filtered out (see IDeviceContext::SetStateFilteringEnabled())
+    bool m_StateFilteringEnabled = false;
+
+    /// Indicates if shader resources have been committed since the current pipeline state was set.
+    /// Only tracked when redundant state filtering is enabled.
+    bool m_ShaderResourcesCommitted = false;
+
+    /// Shader resource binding that was last committed for the current pipeline state.
+    /// Only tracked when redundant state filtering is enabled.
+    BoundObjectPtr<IShaderResourceBinding> m_pCommittedSRB;
+
+    /// Indicates if the context keeps raw pointers to the bound objects and retains
+    /// them once per frame (see IDeviceContext::SetFrameRetainedBindingsEnabled())
+    bool m_FrameRetainedBindingsEnabled = false;
+
+    /// Objects bound to the context during the current frame when frame-retained bindings are enabled
+    FrameRetainedObjects m_FrameRetainedObjects;
+
+    struct DrawPacketSortKey
+    {
+        Int32       PSOId;
+        const void* pSRB;
+        Int32       IndexBufferId;
+        Int32       VertexBufferId;
+        Uint32      PacketIndex;
+
+        bool operator<(const DrawPacketSortKey& RHS) const
+        {
+            if (PSOId != RHS.PSOId)
+                return PSOId < RHS.PSOId;
+            if (pSRB != RHS.pSRB)
+                return std::less<const void*>{}(pSRB, RHS.pSRB);
+            if (IndexBufferId != RHS.IndexBufferId)
+                return IndexBufferId < RHS.IndexBufferId;
+            if (VertexBufferId != RHS.VertexBufferId)
+                return VertexBufferId < RHS.VertexBufferId;
+            return PacketIndex < RHS.PacketIndex;
+        }
+    };
+    /// Scratch array that is reused by SubmitDrawPackets() to avoid allocations
+    std::vector<DrawPacketSortKey> m_DrawPacketKeys;
+
 #ifdef DILIGENT_DEBUG
     // std::unordered_map is unbelievably slow. Keeping track of mapped buffers
     // in release builds is not feasible
@@ -361,9 +534,9 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
 
     for (Uint32 Buff = 0; Buff < NumBuffersSet; ++Buff)
     {
-        auto& CurrStream   = m_VertexStreams[StartSlot + Buff];
-        CurrStream.pBuffer = ppBuffers ? ValidatedCast<BufferImplType>(ppBuffers[Buff]) : nullptr;
-        CurrStream.Offset  = pOffsets ? pOffsets[Buff] : 0;
+        auto& CurrStream = m_VertexStreams[StartSlot + Buff];
+        BindObject(CurrStream.pBuffer, ppBuffers ? ValidatedCast<BufferImplType>(ppBuffers[Buff]) : nullptr);
+        CurrStream.Offset = pOffsets ? pOffsets[Buff] : 0;
 #ifdef DILIGENT_DEVELOPMENT
         if (CurrStream.pBuffer)
         {
@@ -384,7 +557,9 @@ template <typename BaseInterface, typename ImplementationTraits>
 inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     SetPipelineState(PipelineStateImplType* pPipelineState, int /*Dummy*/)
 {
-    m_pPipelineState = pPipelineState;
+    BindObject(m_pPipelineState, pPipelineState);
+    ResetCommittedShaderResources();
+    UpdateStats(&DeviceContextStats::NumPipelineStateChanges);
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -407,9 +582,227 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
         }
     }
 #endif
+    if (m_StateFilteringEnabled)
+    {
+        BindObject(m_pCommittedSRB, pShaderResourceBinding);
+        m_ShaderResourcesCommitted = true;
+    }
+    UpdateStats(&DeviceContextStats::NumShaderResourceCommits);
     return true;
 }
 
+template <typename BaseInterface, typename ImplementationTraits>
+bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    IsRedundantVertexBuffers(Uint32                         StartSlot,
+                             Uint32                         NumBuffersSet,
+                             IBuffer**                      ppBuffers,
+                             const Uint32*                  pOffsets,
+                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                             SET_VERTEX_BUFFERS_FLAGS       Flags) const
+{
+    // Buffers that are transitioned may need a barrier even if they are already bound
+    if (!m_StateFilteringEnabled || StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+        return false;
+
+    if (StartSlot + NumBuffersSet > MAX_BUFFER_SLOTS)
+        return false;
+
+    if (Flags & SET_VERTEX_BUFFERS_FLAG_RESET)
+    {
+        // All slots that are not being set must already be empty
+        if (m_NumVertexStreams > StartSlot + NumBuffersSet)
+            return false;
+        for (Uint32 s = 0; s < StartSlot; ++s)
+        {
+            if (m_VertexStreams[s].pBuffer)
+                return false;
+        }
+    }
+
+    // Context keeps strong references to the bound buffers, so the objects
+    // cannot be released and the pointers can be compared directly.
+    for (Uint32 Buff = 0; Buff < NumBuffersSet; ++Buff)
+    {
+        const auto& CurrStream = m_VertexStreams[StartSlot + Buff];
+
+        IBuffer* pBuffer = ppBuffers ? ppBuffers[Buff] : nullptr;
+        Uint32   Offset  = pOffsets ? pOffsets[Buff] : 0;
+        if (static_cast<const IBuffer*>(CurrStream.pBuffer.RawPtr()) != pBuffer || CurrStream.Offset != Offset)
+            return false;
+    }
+
+    return true;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    IsRedundantIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) const
+{
+    if (!m_StateFilteringEnabled || StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+        return false;
+
+    return static_cast<const IBuffer*>(m_pIndexBuffer.RawPtr()) == pIndexBuffer && m_IndexDataStartOffset == ByteOffset;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    IsRedundantViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight) const
+{
+    if (!m_StateFilteringEnabled || NumViewports != m_NumViewports || NumViewports > MAX_VIEWPORTS)
+        return false;
+
+    if (RTWidth == 0 || RTHeight == 0)
+    {
+        RTWidth  = m_FramebufferWidth;
+        RTHeight = m_FramebufferHeight;
+    }
+
+    Viewport DefaultVP(0, 0, static_cast<float>(RTWidth), static_cast<float>(RTHeight));
+    if (NumViewports == 1 && pViewports == nullptr)
+        pViewports = &DefaultVP;
+
+    for (Uint32 vp = 0; vp < NumViewports; ++vp)
+    {
+        if (!(m_Viewports[vp] == pViewports[vp]))
+            return false;
+    }
+
+    return true;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    IsRedundantScissorRects(Uint32 NumRects, const Rect* pRects) const
+{
+    if (!m_StateFilteringEnabled || NumRects != m_NumScissorRects || NumRects > MAX_VIEWPORTS)
+        return false;
+
+    for (Uint32 sr = 0; sr < NumRects; ++sr)
+    {
+        if (!(m_ScissorRects[sr] == pRects[sr]))
+            return false;
+    }
+
+    return true;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    IsRedundantShaderResourceCommit(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) const
+{
+    if (!m_StateFilteringEnabled || StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+        return false;
+
+    return m_pPipelineState && m_ShaderResourcesCommitted && m_pCommittedSRB == pShaderResourceBinding &&
+        !m_pPipelineState->HasDynamicVariables();
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+void DeviceContextBase<BaseInterface, ImplementationTraits>::SubmitDrawPackets(const SubmitDrawPacketsAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.NumPackets == 0 || Attribs.pPackets != nullptr, "pPackets must not be null when NumPackets is not zero");
+    if (Attribs.NumPackets == 0 || Attribs.pPackets == nullptr)
+        return;
+
+    m_DrawPacketKeys.clear();
+    m_DrawPacketKeys.reserve(Attribs.NumPackets);
+    for (Uint32 i = 0; i < Attribs.NumPackets; ++i)
+    {
+        const auto& Packet = Attribs.pPackets[i];
+
+        DrawPacketSortKey Key{};
+        Key.PacketIndex = i;
+        if (Attribs.SortByState)
+        {
+            Key.PSOId          = Packet.pPipelineState != nullptr ? Packet.pPipelineState->GetUniqueID() : 0;
+            Key.pSRB           = Packet.pSRB;
+            Key.IndexBufferId  = Packet.pIndexBuffer != nullptr ? Packet.pIndexBuffer->GetUniqueID() : 0;
+            Key.VertexBufferId = (Packet.NumVertexBuffers > 0 && Packet.ppVertexBuffers[0] != nullptr) ? Packet.ppVertexBuffers[0]->GetUniqueID() : 0;
+        }
+        m_DrawPacketKeys.push_back(Key);
+    }
+
+    if (Attribs.SortByState)
+        std::sort(m_DrawPacketKeys.begin(), m_DrawPacketKeys.end());
+
+    // Call the methods through the interface to use the backend implementations
+    IDeviceContext* pThis = this;
+
+    const auto StateFilteringEnabled = m_StateFilteringEnabled;
+    m_StateFilteringEnabled          = true;
+    for (const auto& Key : m_DrawPacketKeys)
+    {
+        const auto& Packet = Attribs.pPackets[Key.PacketIndex];
+        if (Packet.pPipelineState == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Pipeline state of draw packet ", Key.PacketIndex, " is null");
+            continue;
+        }
+
+        pThis->SetPipelineState(Packet.pPipelineState);
+        pThis->SetVertexBuffers(0, Packet.NumVertexBuffers, Packet.ppVertexBuffers, Packet.pVertexOffsets, Attribs.StateTransitionMode, SET_VERTEX_BUFFERS_FLAG_RESET);
+        if (Packet.pIndexBuffer != nullptr)
+            pThis->SetIndexBuffer(Packet.pIndexBuffer, Packet.IndexBufferOffset, Attribs.StateTransitionMode);
+        pThis->CommitShaderResources(Packet.pSRB, Attribs.StateTransitionMode);
+
+        if (Packet.pIndexBuffer != nullptr)
+            pThis->DrawIndexed(Packet.IndexedAttribs);
+        else
+            pThis->Draw(Packet.NonIndexedAttribs);
+    }
+    SetStateFilteringEnabled(StateFilteringEnabled);
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+void DeviceContextBase<BaseInterface, ImplementationTraits>::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyMultiDrawIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    if (Attribs.pCountBuffer != nullptr)
+    {
+        // Emulating the count buffer would require reading it back on the CPU
+        LOG_ERROR_MESSAGE("MultiDrawIndirect: indirect draw count is not supported by this device.");
+        return;
+    }
+
+    IDeviceContext*     pThis = this;
+    DrawIndirectAttribs DrawAttribs{Attribs.Flags, Attribs.IndirectAttribsBufferStateTransitionMode, Attribs.IndirectDrawArgsOffset};
+    const auto          Stride = GetIndirectDrawArgsStride(Attribs.IndirectDrawArgsStride, false);
+    for (Uint32 draw = 0; draw < Attribs.DrawCount; ++draw)
+    {
+        pThis->DrawIndirect(DrawAttribs, pAttribsBuffer);
+        // The buffer is already in the required state after the first draw
+        if (DrawAttribs.IndirectAttribsBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+            DrawAttribs.IndirectAttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+        DrawAttribs.IndirectDrawArgsOffset += Stride;
+    }
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+void DeviceContextBase<BaseInterface, ImplementationTraits>::MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyMultiDrawIndexedIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    if (Attribs.pCountBuffer != nullptr)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexedIndirect: indirect draw count is not supported by this device.");
+        return;
+    }
+
+    IDeviceContext*            pThis = this;
+    DrawIndexedIndirectAttribs DrawAttribs{Attribs.IndexType, Attribs.Flags, Attribs.IndirectAttribsBufferStateTransitionMode, Attribs.IndirectDrawArgsOffset};
+    const auto                 Stride = GetIndirectDrawArgsStride(Attribs.IndirectDrawArgsStride, true);
+    for (Uint32 draw = 0; draw < Attribs.DrawCount; ++draw)
+    {
+        pThis->DrawIndexedIndirect(DrawAttribs, pAttribsBuffer);
+        if (DrawAttribs.IndirectAttribsBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+            DrawAttribs.IndirectAttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+        DrawAttribs.IndirectDrawArgsOffset += Stride;
+    }
+}
+
 template <typename BaseInterface, typename ImplementationTraits>
 inline void DeviceContextBase<BaseInterface, ImplementationTraits>::InvalidateState()
 {
@@ -420,7 +813,7 @@ template <typename BaseInterface, typename ImplementationTraits>
 inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    m_pIndexBuffer         = ValidatedCast<BufferImplType>(pIndexBuffer);
+    BindObject(m_pIndexBuffer, ValidatedCast<BufferImplType>(pIndexBuffer));
     m_IndexDataStartOffset = ByteOffset;
 #ifdef DILIGENT_DEVELOPMENT
     if (m_pIndexBuffer)
@@ -488,7 +881,7 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
         RTHeight = m_FramebufferHeight;
     }
 
-    VERIFY(NumViewports < MAX_VIEWPORTS, "Number of viewports (", NumViewports, ") exceeds the limit (", MAX_VIEWPORTS, ")");
+    VERIFY(NumViewports <= MAX_VIEWPORTS, "Number of viewports (", NumViewports, ") exceeds the limit (", MAX_VIEWPORTS, ")");
     m_NumViewports = std::min(MAX_VIEWPORTS, NumViewports);
 
     Viewport DefaultVP(0, 0, static_cast<float>(RTWidth), static_cast<float>(RTHeight));
@@ -528,7 +921,7 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
         RTHeight = m_FramebufferHeight;
     }
 
-    VERIFY(NumRects < MAX_VIEWPORTS, "Number of scissor rects (", NumRects, ") exceeds the limit (", MAX_VIEWPORTS, ")");
+    VERIFY(NumRects <= MAX_VIEWPORTS, "Number of scissor rects (", NumRects, ") exceeds the limit (", MAX_VIEWPORTS, ")");
     m_NumScissorRects = std::min(MAX_VIEWPORTS, NumRects);
 
     for (Uint32 sr = 0; sr < m_NumScissorRects; ++sr)
@@ -596,13 +989,12 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
             }
         }
 
-        // Here both views are certainly live objects, since we store
-        // strong references to all bound render targets. So we
-        // can safely compare pointers.
+        // Here both views are certainly live objects, since all bound render
+        // targets are kept alive by the context. So we can safely compare pointers.
         if (m_pBoundRenderTargets[rt] != pRTView)
         {
-            m_pBoundRenderTargets[rt] = ValidatedCast<TextureViewImplType>(pRTView);
-            bBindRenderTargets        = true;
+            BindObject(m_pBoundRenderTargets[rt], ValidatedCast<TextureViewImplType>(pRTView));
+            bBindRenderTargets = true;
         }
     }
 
@@ -639,8 +1031,8 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
 
     if (m_pBoundDepthStencil != pDepthStencil)
     {
-        m_pBoundDepthStencil = ValidatedCast<TextureViewImplType>(pDepthStencil);
-        bBindRenderTargets   = true;
+        BindObject(m_pBoundDepthStencil, ValidatedCast<TextureViewImplType>(pDepthStencil));
+        bBindRenderTargets = true;
     }
 
 
@@ -660,7 +1052,7 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
         for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
         {
             VERIFY(ppRTVs[rt] == nullptr, "Non-null pointer found in RTV array element #", rt);
-            auto pBoundRTV = m_pBoundRenderTargets[rt];
+            auto* pBoundRTV = m_pBoundRenderTargets[rt].RawPtr();
             if (pBoundRTV)
                 pBoundRTV->QueryInterface(IID_TextureView, reinterpret_cast<IObject**>(ppRTVs + rt));
             else
@@ -683,6 +1075,56 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     }
 }
 
+template <typename BaseInterface, typename ImplementationTraits>
+void DeviceContextBase<BaseInterface, ImplementationTraits>::SetFrameRetainedBindingsEnabled(bool Enable)
+{
+    if (m_FrameRetainedBindingsEnabled == Enable)
+        return;
+
+    m_FrameRetainedBindingsEnabled = Enable;
+
+    // Rebind all objects to switch them to the new binding mode
+    for (Uint32 stream = 0; stream < m_NumVertexStreams; ++stream)
+        BindObject(m_VertexStreams[stream].pBuffer, m_VertexStreams[stream].pBuffer.RawPtr());
+    BindObject(m_pPipelineState, m_pPipelineState.RawPtr());
+    BindObject(m_pIndexBuffer, m_pIndexBuffer.RawPtr());
+    for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+        BindObject(m_pBoundRenderTargets[rt], m_pBoundRenderTargets[rt].RawPtr());
+    BindObject(m_pBoundDepthStencil, m_pBoundDepthStencil.RawPtr());
+    BindObject(m_pCommittedSRB, m_pCommittedSRB.RawPtr());
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+void DeviceContextBase<BaseInterface, ImplementationTraits>::ExtractFrameRetainedObjects(FrameRetainedObjects::ObjectList& Objects)
+{
+    m_FrameRetainedObjects.ExtractObjects(Objects);
+
+    // Objects that remain bound must stay alive during the next frame
+    auto RetainBoundObject = [this](IObject* pObject) //
+    {
+        if (pObject != nullptr)
+            m_FrameRetainedObjects.Retain(pObject);
+    };
+    for (Uint32 stream = 0; stream < m_NumVertexStreams; ++stream)
+    {
+        if (!m_VertexStreams[stream].pBuffer.IsStrong())
+            RetainBoundObject(m_VertexStreams[stream].pBuffer);
+    }
+    if (!m_pPipelineState.IsStrong())
+        RetainBoundObject(m_pPipelineState);
+    if (!m_pIndexBuffer.IsStrong())
+        RetainBoundObject(m_pIndexBuffer);
+    for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+    {
+        if (!m_pBoundRenderTargets[rt].IsStrong())
+            RetainBoundObject(m_pBoundRenderTargets[rt]);
+    }
+    if (!m_pBoundDepthStencil.IsStrong())
+        RetainBoundObject(m_pBoundDepthStencil);
+    if (!m_pCommittedSRB.IsStrong())
+        RetainBoundObject(m_pCommittedSRB);
+}
+
 template <typename BaseInterface, typename ImplementationTraits>
 inline void DeviceContextBase<BaseInterface, ImplementationTraits>::ClearStateCache()
 {
@@ -698,6 +1140,7 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::ClearStateCa
     m_NumVertexStreams = 0;
 
     m_pPipelineState.Release();
+    ResetCommittedShaderResources();
 
     m_pIndexBuffer.Release();
     m_IndexDataStartOffset = 0;
@@ -952,6 +1395,32 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::EndQuery(IQu
     return true;
 }
 
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::BeginDebugGroup(const Char* Name, int)
+{
+    if (Name == nullptr)
+    {
+        LOG_ERROR_MESSAGE("IDeviceContext::BeginDebugGroup: Name must not be null");
+        return false;
+    }
+
+    ++m_DebugGroupDepth;
+    return true;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::EndDebugGroup(int)
+{
+    if (m_DebugGroupDepth == 0)
+    {
+        LOG_ERROR_MESSAGE("IDeviceContext::EndDebugGroup: there is no debug group to end");
+        return false;
+    }
+
+    --m_DebugGroupDepth;
+    return true;
+}
+
 template <typename BaseInterface, typename ImplementationTraits>
 inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     UpdateBuffer(IBuffer* pBuffer, Uint32 Offset, Uint32 Size, const void* pData, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
@@ -965,6 +1434,7 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
         DEV_CHECK_ERR(Size + Offset <= BuffDesc.uiSizeInBytes, "Unable to update buffer '", BuffDesc.Name, "': Update region [", Offset, ",", Size + Offset, ") is out of buffer bounds [0,", BuffDesc.uiSizeInBytes, ")");
     }
 #endif
+    UpdateStats(&DeviceContextStats::UploadBytes, Uint64{Size});
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -1063,6 +1533,27 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
 {
     VERIFY(pTexture != nullptr, "pTexture must not be null");
     ValidateUpdateTextureParams(pTexture->GetDesc(), MipLevel, Slice, DstBox, SubresData);
+
+#if DILIGENT_CONTEXT_STATS
+    if (SubresData.pData != nullptr)
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(pTexture->GetDesc().Format);
+
+        Uint64 RowSize  = 0;
+        Uint64 RowCount = 0;
+        if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+        {
+            RowSize  = Uint64{(DstBox.MaxX - DstBox.MinX + FmtAttribs.BlockWidth - 1u) / FmtAttribs.BlockWidth} * FmtAttribs.ComponentSize;
+            RowCount = (DstBox.MaxY - DstBox.MinY + FmtAttribs.BlockHeight - 1u) / FmtAttribs.BlockHeight;
+        }
+        else
+        {
+            RowSize  = Uint64{DstBox.MaxX - DstBox.MinX} * FmtAttribs.ComponentSize * FmtAttribs.NumComponents;
+            RowCount = DstBox.MaxY - DstBox.MinY;
+        }
+        UpdateStats(&DeviceContextStats::UploadBytes, RowSize * RowCount * (DstBox.MaxZ - DstBox.MinZ));
+    }
+#endif
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -1320,6 +1811,61 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
     return true;
 }
 
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    DvpVerifyMultiDrawParams(const char* CmdName, DRAW_FLAGS Flags, Uint32 Stride, Uint32 MinStride, const IBuffer* pCountBuffer) const
+{
+    if ((Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return true;
+
+    if (Stride != 0 && (Stride < MinStride || (Stride % 4) != 0))
+    {
+        LOG_ERROR_MESSAGE(CmdName, " command arguments are invalid: indirect draw arguments stride (", Stride,
+                          ") must be a multiple of 4 that is not less than ", MinStride, ".");
+        return false;
+    }
+
+    if (pCountBuffer != nullptr)
+    {
+        if (!m_pDevice->GetDeviceCaps().Features.IndirectDrawCount)
+        {
+            LOG_ERROR_MESSAGE(CmdName, " command arguments are invalid: count buffer requires IndirectDrawCount device feature.");
+            return false;
+        }
+
+        if ((pCountBuffer->GetDesc().BindFlags & BIND_INDIRECT_DRAW_ARGS) == 0)
+        {
+            LOG_ERROR_MESSAGE(CmdName, " command arguments are invalid: count buffer '",
+                              pCountBuffer->GetDesc().Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    DvpVerifyMultiDrawIndirectArguments(const MultiDrawIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer) const
+{
+    DrawIndirectAttribs DrawAttribs{Attribs.Flags, Attribs.IndirectAttribsBufferStateTransitionMode, Attribs.IndirectDrawArgsOffset};
+    if (!DvpVerifyDrawIndirectArguments(DrawAttribs, pAttribsBuffer))
+        return false;
+
+    return DvpVerifyMultiDrawParams("MultiDrawIndirect", Attribs.Flags, Attribs.IndirectDrawArgsStride, GetIndirectDrawArgsStride(0, false), Attribs.pCountBuffer);
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    DvpVerifyMultiDrawIndexedIndirectArguments(const MultiDrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer) const
+{
+    DrawIndexedIndirectAttribs DrawAttribs{Attribs.IndexType, Attribs.Flags, Attribs.IndirectAttribsBufferStateTransitionMode, Attribs.IndirectDrawArgsOffset};
+    if (!DvpVerifyDrawIndexedIndirectArguments(DrawAttribs, pAttribsBuffer))
+        return false;
+
+    return DvpVerifyMultiDrawParams("MultiDrawIndexedIndirect", Attribs.Flags, Attribs.IndirectDrawArgsStride, GetIndirectDrawArgsStride(0, true), Attribs.pCountBuffer);
+}
+
 template <typename BaseInterface, typename ImplementationTraits>
 inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     DvpVerifyRenderTargets() const
@@ -71,10 +71,15 @@ public:
     {
         const auto& SrcLayout      = PSODesc.ResourceLayout;
         size_t      StringPoolSize = 0;
+        m_HasDynamicVariables      = SrcLayout.DefaultVariableType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
         if (SrcLayout.Variables != nullptr)
         {
             for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
+            {
                 StringPoolSize += strlen(SrcLayout.Variables[i].Name) + 1;
+                if (SrcLayout.Variables[i].Type == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                    m_HasDynamicVariables = true;
+            }
         }
 
         if (SrcLayout.StaticSamplers != nullptr)
@@ -368,6 +373,9 @@ public:
         return ValidatedCast<ShaderType>(m_ppShaders[ShaderInd]);
     }
 
+    /// Returns true if the resource layout of the pipeline may contain dynamic variables.
+    bool HasDynamicVariables() const { return m_HasDynamicVariables; }
+
     // This function only compares shader resource layout hashes, so
     // it can potentially give false negatives
     bool IsIncompatibleWith(const IPipelineState* pPSO) const
@@ -392,6 +400,8 @@ protected:
     IShader* m_ppShaders[5]             = {}; ///< Array of pointers to the shaders used by this PSO
     size_t   m_ShaderResourceLayoutHash = 0;  ///< Hash computed from the shader resource layout
 
+    bool m_HasDynamicVariables = false; ///< Whether the resource layout may contain dynamic variables
+
 private:
     void CheckRasterizerStateDesc() const
     {
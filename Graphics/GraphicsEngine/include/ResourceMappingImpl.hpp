@@ -35,6 +35,8 @@
 #include <unordered_map>
 #include "HashUtils.hpp"
 #include "STDAllocator.hpp"
+#include "AdaptiveLock.hpp"
+#include "RefCntAutoPtr.hpp"
 
 namespace Diligent
 {
@@ -46,6 +48,12 @@ struct ResMappingHashKey
     {
     }
 
+    ResMappingHashKey(const Char* Str, size_t StrHash, Uint32 ArrInd) :
+        StrKey{Str, false, StrHash},
+        ArrayIndex{ArrInd}
+    {
+    }
+
     ResMappingHashKey(ResMappingHashKey&& rhs) :
         StrKey{std::move(rhs.StrKey)},
         ArrayIndex{rhs.ArrayIndex}
@@ -134,10 +142,18 @@ public:
     /// Returns number of resources in the resource mapping.
     virtual size_t DILIGENT_CALL_TYPE GetSize() override final;
 
+    /// Implementation of IResourceMapping::GetResources()
+    virtual void DILIGENT_CALL_TYPE GetResources(Uint32                           NumResources,
+                                                 const ResourceMappingLookupInfo* pLookupInfo,
+                                                 IDeviceObject**                  ppResources) override final;
+
 private:
-    ThreadingTools::LockHelper Lock();
+    IDeviceObject* FindResource(const ResMappingHashKey& Key);
+
+    // Resources are looked up far more often than they are added or removed,
+    // so readers must not block each other.
+    ThreadingTools::AdaptiveRWLock m_Lock;
 
-    ThreadingTools::LockFlag                                                                                                                                               m_LockFlag;
     typedef std::pair<const ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>                                                                                               HashTableElem;
     std::unordered_map<ResMappingHashKey, RefCntAutoPtr<IDeviceObject>, std::hash<ResMappingHashKey>, std::equal_to<ResMappingHashKey>, STDAllocatorRawMem<HashTableElem>> m_HashTable;
 };
@@ -34,7 +34,9 @@
 
 #include "ShaderResourceVariable.h"
 #include "PipelineState.h"
+#include "ResourceMapping.h"
 #include "StringTools.hpp"
+#include "HashUtils.hpp"
 #include "GraphicsAccessories.hpp"
 
 namespace Diligent
@@ -325,6 +327,74 @@ inline void VerifyAndCorrectSetArrayArguments(const char* Name, Uint32 ArraySize
     }
 }
 
+/// Helper class that collects resource mapping lookups for shader variables and
+/// resolves all of them with a single IResourceMapping::GetResources() call.
+
+/// Shader resource layouts first add lookups for all variables that need to be bound,
+/// resolve the batch, and then traverse the variables again in the same order consuming
+/// the results with ConsumeNext().
+class ResourceMappingBatch
+{
+public:
+    ResourceMappingBatch() = default;
+
+    // clang-format off
+    ResourceMappingBatch           (const ResourceMappingBatch&) = delete;
+    ResourceMappingBatch& operator=(const ResourceMappingBatch&) = delete;
+    // clang-format on
+
+    ~ResourceMappingBatch()
+    {
+        for (auto* pResource : m_Resources)
+        {
+            if (pResource != nullptr)
+                pResource->Release();
+        }
+    }
+
+    /// Adds a lookup for the element ArrayIndex of the variable pVariable.
+
+    /// \param [in] pVariable  - Variable identifier that is used by ConsumeNext().
+    /// \param [in] Name       - Variable name.
+    /// \param [in] NameHash   - Variable name hash computed by CStringHash<Char>, or 0.
+    /// \param [in] ArrayIndex - Array element index.
+    void AddLookup(const void* pVariable, const Char* Name, size_t NameHash, Uint32 ArrayIndex)
+    {
+        VERIFY(m_Resources.empty(), "Lookups can't be added after the batch has been resolved");
+        m_Lookups.emplace_back(Name, ArrayIndex, NameHash);
+        m_Variables.push_back(pVariable);
+    }
+
+    /// Looks up all resources in the resource mapping.
+    void Resolve(IResourceMapping& ResourceMapping)
+    {
+        VERIFY(m_Resources.empty(), "The batch has already been resolved");
+        m_Resources.resize(m_Lookups.size());
+        if (!m_Lookups.empty())
+            ResourceMapping.GetResources(static_cast<Uint32>(m_Lookups.size()), m_Lookups.data(), m_Resources.data());
+    }
+
+    /// If the next lookup in the batch was added for the element ArrayIndex of the variable pVariable,
+    /// writes the resolved resource (which may be null) to pResource, advances to the next lookup
+    /// and returns true. Otherwise, returns false.
+    bool ConsumeNext(const void* pVariable, Uint32 ArrayIndex, IDeviceObject*& pResource)
+    {
+        if (m_NextLookup >= m_Lookups.size() ||
+            m_Variables[m_NextLookup] != pVariable ||
+            m_Lookups[m_NextLookup].ArrayIndex != ArrayIndex)
+            return false;
+
+        pResource = m_Resources[m_NextLookup++];
+        return true;
+    }
+
+private:
+    std::vector<ResourceMappingLookupInfo> m_Lookups;
+    std::vector<const void*>               m_Variables;
+    std::vector<IDeviceObject*>            m_Resources;
+    size_t                                 m_NextLookup = 0;
+};
+
 struct DefaultShaderVariableIDComparator
 {
     bool operator()(const INTERFACE_ID& IID) const
@@ -33,6 +33,7 @@
 #include "DeviceObject.h"
 #include <unordered_map>
 #include "STDAllocator.hpp"
+#include "AdaptiveLock.hpp"
 
 namespace Diligent
 {
@@ -94,7 +95,7 @@ public:
     /// cost to it.
     void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
     {
-        ThreadingTools::LockHelper Lock(m_LockFlag);
+        ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveLock> Lock{m_Lock};
 
         // If the number of outstanding deleted objects reached the threshold value,
         // purge the registry. Since we have exclusive access now, it is safe
@@ -136,7 +137,7 @@ public:
     {
         VERIFY(*ppObject == nullptr, "Overwriting reference to existing object may cause memory leaks");
         *ppObject = nullptr;
-        ThreadingTools::LockHelper Lock(m_LockFlag);
+        ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveLock> Lock{m_Lock};
 
         auto It = m_DescToObjHashMap.find(Desc);
         if (It != m_DescToObjHashMap.end())
@@ -197,8 +198,8 @@ public:
     }
 
 private:
-    /// Lock flag to protect the m_DescToObjHashMap
-    ThreadingTools::LockFlag m_LockFlag;
+    /// Lock to protect the m_DescToObjHashMap
+    ThreadingTools::AdaptiveLock m_Lock;
 
     /// Nmber of outstanding deleted objects that have not been purged
     Atomics::AtomicLong m_NumDeletedObjects;
@@ -164,6 +164,15 @@ struct DeviceFeatures
 
     /// Specifies whether all the extended UAV texture formats are available in shader code.
     Bool TextureUAVExtendedFormats         DEFAULT_INITIALIZER(False);
+
+    /// Indicates if device natively supports executing multiple indirect draws with a single command.
+    /// When the feature is not supported, IDeviceContext::MultiDrawIndirect() and
+    /// IDeviceContext::MultiDrawIndexedIndirect() are emulated by a sequence of individual indirect draws.
+    Bool MultiDrawIndirect                 DEFAULT_INITIALIZER(False);
+
+    /// Indicates if device supports reading the number of draws of a multi-draw indirect
+    /// command from a buffer.
+    Bool IndirectDrawCount                 DEFAULT_INITIALIZER(False);
 };
 typedef struct DeviceFeatures DeviceFeatures;
 
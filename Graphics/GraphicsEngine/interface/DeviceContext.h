@@ -362,6 +362,145 @@ struct DrawIndexedIndirectAttribs
 };
 typedef struct DrawIndexedIndirectAttribs DrawIndexedIndirectAttribs;
 
+/// Defines the multi-draw indirect command attributes.
+
+/// This structure is used by IDeviceContext::MultiDrawIndirect().
+struct MultiDrawIndirectAttribs
+{
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags                DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// State transition mode for indirect draw arguments buffer.
+    RESOURCE_STATE_TRANSITION_MODE IndirectAttribsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the buffer to the location of the first draw command attributes.
+    Uint32 IndirectDrawArgsOffset   DEFAULT_INITIALIZER(0);
+
+    /// The number of draws to execute. When pCountBuffer is not null,
+    /// this is the maximum number of draws that may be executed.
+    Uint32 DrawCount                DEFAULT_INITIALIZER(1);
+
+    /// Stride, in bytes, between consecutive draw command attributes.
+    /// Zero means that the attributes are tightly packed (16 bytes per draw).
+    Uint32 IndirectDrawArgsStride   DEFAULT_INITIALIZER(0);
+
+    /// Optional buffer that contains the actual number of draws as a 32-bit unsigned integer.
+    /// The buffer must be created with Diligent::BIND_INDIRECT_DRAW_ARGS flag.
+    /// Requires DeviceFeatures::IndirectDrawCount feature.
+    IBuffer* pCountBuffer           DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the count buffer to the location of the draw count.
+    Uint32 CountBufferOffset        DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the count buffer.
+    RESOURCE_STATE_TRANSITION_MODE CountBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values
+
+    /// Default values:
+    /// Member                                   | Default value
+    /// -----------------------------------------|--------------------------------------
+    /// Flags                                    | DRAW_FLAG_NONE
+    /// IndirectAttribsBufferStateTransitionMode | RESOURCE_STATE_TRANSITION_MODE_NONE
+    /// IndirectDrawArgsOffset                   | 0
+    /// DrawCount                                | 1
+    /// IndirectDrawArgsStride                   | 0
+    /// pCountBuffer                             | nullptr
+    /// CountBufferOffset                        | 0
+    /// CountBufferStateTransitionMode           | RESOURCE_STATE_TRANSITION_MODE_NONE
+    MultiDrawIndirectAttribs()noexcept{}
+
+    /// Initializes the structure members with user-specified values.
+    MultiDrawIndirectAttribs(DRAW_FLAGS                     _Flags,
+                             RESOURCE_STATE_TRANSITION_MODE _IndirectAttribsBufferStateTransitionMode,
+                             Uint32                         _DrawCount,
+                             Uint32                         _IndirectDrawArgsStride = 0,
+                             Uint32                         _IndirectDrawArgsOffset = 0)noexcept :
+        Flags                                   {_Flags                                   },
+        IndirectAttribsBufferStateTransitionMode{_IndirectAttribsBufferStateTransitionMode},
+        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  },
+        DrawCount                               {_DrawCount                               },
+        IndirectDrawArgsStride                  {_IndirectDrawArgsStride                  }
+    {}
+#endif
+};
+typedef struct MultiDrawIndirectAttribs MultiDrawIndirectAttribs;
+
+/// Defines the indexed multi-draw indirect command attributes.
+
+/// This structure is used by IDeviceContext::MultiDrawIndexedIndirect().
+struct MultiDrawIndexedIndirectAttribs
+{
+    /// The type of the elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE IndexType            DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags                DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// State transition mode for indirect draw arguments buffer.
+    RESOURCE_STATE_TRANSITION_MODE IndirectAttribsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the buffer to the location of the first draw command attributes.
+    Uint32 IndirectDrawArgsOffset   DEFAULT_INITIALIZER(0);
+
+    /// The number of draws to execute. When pCountBuffer is not null,
+    /// this is the maximum number of draws that may be executed.
+    Uint32 DrawCount                DEFAULT_INITIALIZER(1);
+
+    /// Stride, in bytes, between consecutive draw command attributes.
+    /// Zero means that the attributes are tightly packed (20 bytes per draw).
+    Uint32 IndirectDrawArgsStride   DEFAULT_INITIALIZER(0);
+
+    /// Optional buffer that contains the actual number of draws as a 32-bit unsigned integer.
+    /// The buffer must be created with Diligent::BIND_INDIRECT_DRAW_ARGS flag.
+    /// Requires DeviceFeatures::IndirectDrawCount feature.
+    IBuffer* pCountBuffer           DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the count buffer to the location of the draw count.
+    Uint32 CountBufferOffset        DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the count buffer.
+    RESOURCE_STATE_TRANSITION_MODE CountBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values
+
+    /// Default values:
+    /// Member                                   | Default value
+    /// -----------------------------------------|--------------------------------------
+    /// IndexType                                | VT_UNDEFINED
+    /// Flags                                    | DRAW_FLAG_NONE
+    /// IndirectAttribsBufferStateTransitionMode | RESOURCE_STATE_TRANSITION_MODE_NONE
+    /// IndirectDrawArgsOffset                   | 0
+    /// DrawCount                                | 1
+    /// IndirectDrawArgsStride                   | 0
+    /// pCountBuffer                             | nullptr
+    /// CountBufferOffset                        | 0
+    /// CountBufferStateTransitionMode           | RESOURCE_STATE_TRANSITION_MODE_NONE
+    MultiDrawIndexedIndirectAttribs()noexcept{}
+
+    /// Initializes the structure members with user-specified values.
+    MultiDrawIndexedIndirectAttribs(VALUE_TYPE                     _IndexType,
+                                    DRAW_FLAGS                     _Flags,
+                                    RESOURCE_STATE_TRANSITION_MODE _IndirectAttribsBufferStateTransitionMode,
+                                    Uint32                         _DrawCount,
+                                    Uint32                         _IndirectDrawArgsStride = 0,
+                                    Uint32                         _IndirectDrawArgsOffset = 0)noexcept :
+        IndexType                               {_IndexType                               },
+        Flags                                   {_Flags                                   },
+        IndirectAttribsBufferStateTransitionMode{_IndirectAttribsBufferStateTransitionMode},
+        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  },
+        DrawCount                               {_DrawCount                               },
+        IndirectDrawArgsStride                  {_IndirectDrawArgsStride                  }
+    {}
+#endif
+};
+typedef struct MultiDrawIndexedIndirectAttribs MultiDrawIndexedIndirectAttribs;
+
 /// Defines which parts of the depth-stencil buffer to clear.
 
 /// These flags are used by IDeviceContext::ClearDepthStencil().
@@ -512,6 +651,17 @@ struct Viewport
     {}
 
     Viewport()noexcept{}
+
+    /// Comparison operator tests if two structures are equivalent
+    bool operator == (const Viewport& RHS)const
+    {
+        return TopLeftX == RHS.TopLeftX &&
+               TopLeftY == RHS.TopLeftY &&
+               Width    == RHS.Width    &&
+               Height   == RHS.Height   &&
+               MinDepth == RHS.MinDepth &&
+               MaxDepth == RHS.MaxDepth;
+    }
 #endif
 };
 typedef struct Viewport Viewport;
@@ -546,6 +696,15 @@ struct Rect
     {
         return right > left && bottom > top;
     }
+
+    /// Comparison operator tests if two structures are equivalent
+    bool operator == (const Rect& RHS)const
+    {
+        return left   == RHS.left  &&
+               top    == RHS.top   &&
+               right  == RHS.right &&
+               bottom == RHS.bottom;
+    }
 #endif
 };
 typedef struct Rect Rect;
@@ -609,6 +768,112 @@ struct CopyTextureAttribs
 };
 typedef struct CopyTextureAttribs CopyTextureAttribs;
 
+
+/// Describes a single draw command submitted with IDeviceContext::SubmitDrawPackets().
+
+/// A draw packet contains all states that are required to issue a draw command. The packet does not
+/// keep strong references to the objects, so they must be kept alive by the application until
+/// IDeviceContext::SubmitDrawPackets() returns.
+struct DrawPacket
+{
+    /// Pipeline state to use for the draw command. Must not be null.
+    IPipelineState*         pPipelineState      DEFAULT_INITIALIZER(nullptr);
+
+    /// Shader resource binding to commit before the draw command, or null if the
+    /// pipeline does not use shader resources.
+    IShaderResourceBinding* pSRB                DEFAULT_INITIALIZER(nullptr);
+
+    /// Number of vertex buffers in ppVertexBuffers array. The buffers are bound starting
+    /// with slot 0, and all other slots are reset.
+    Uint32                  NumVertexBuffers    DEFAULT_INITIALIZER(0);
+
+    /// Pointer to the array of NumVertexBuffers vertex buffers.
+    IBuffer**               ppVertexBuffers     DEFAULT_INITIALIZER(nullptr);
+
+    /// Pointer to the array of NumVertexBuffers offsets, or null to use zero offsets.
+    Uint32*                 pVertexOffsets      DEFAULT_INITIALIZER(nullptr);
+
+    /// Index buffer. If not null, IndexedAttribs are used to issue an indexed draw command.
+    /// Otherwise, NonIndexedAttribs are used to issue a non-indexed draw command.
+    IBuffer*                pIndexBuffer        DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the index buffer to the start of the index data, in bytes.
+    Uint32                  IndexBufferOffset   DEFAULT_INITIALIZER(0);
+
+    /// Attributes of the non-indexed draw command (used when pIndexBuffer is null).
+    DrawAttribs             NonIndexedAttribs;
+
+    /// Attributes of the indexed draw command (used when pIndexBuffer is not null).
+    DrawIndexedAttribs      IndexedAttribs;
+};
+typedef struct DrawPacket DrawPacket;
+
+
+/// Describes the parameters of IDeviceContext::SubmitDrawPackets() command.
+struct SubmitDrawPacketsAttribs
+{
+    /// Pointer to the array of NumPackets draw packets.
+    const DrawPacket*              pPackets            DEFAULT_INITIALIZER(nullptr);
+
+    /// Number of draw packets in pPackets array.
+    Uint32                         NumPackets          DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the vertex buffers, index buffers and shader resources
+    /// used by the packets (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
+    /// \remarks Redundant state changes can only be filtered out when the mode is
+    ///          RESOURCE_STATE_TRANSITION_MODE_VERIFY or RESOURCE_STATE_TRANSITION_MODE_NONE.
+    ///          Use IDeviceContext::TransitionResourceStates() to transition all resources
+    ///          to required states before submitting the packets.
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// If true, the packets are executed in the order of their state key (pipeline state,
+    /// shader resource binding, index buffer and the first vertex buffer) to minimize the number
+    /// of state changes. Packets with identical state keys keep their relative order.
+    /// If false, the packets are executed in the order they appear in the array.
+    Bool                           SortByState         DEFAULT_INITIALIZER(True);
+};
+typedef struct SubmitDrawPacketsAttribs SubmitDrawPacketsAttribs;
+
+
+/// Device context command statistics.
+
+/// The statistics are accumulated by the context until IDeviceContext::ResetStats() is called.
+/// When the engine is built with DILIGENT_NO_CONTEXT_STATS CMake option, statistics are not collected
+/// and all counters stay zero.
+struct DeviceContextStats
+{
+    /// Number of draw commands (Draw, DrawIndexed, DrawIndirect, DrawIndexedIndirect, MultiDrawIndirect,
+    /// MultiDrawIndexedIndirect). A native multi-draw command is counted once regardless of the number of draws.
+    Uint32 NumDrawCommands              DEFAULT_INITIALIZER(0);
+
+    /// Number of dispatch commands (DispatchCompute, DispatchComputeIndirect).
+    Uint32 NumDispatchCommands          DEFAULT_INITIALIZER(0);
+
+    /// Number of times a different pipeline state was bound.
+    Uint32 NumPipelineStateChanges      DEFAULT_INITIALIZER(0);
+
+    /// Number of shader resource binding commits.
+    Uint32 NumShaderResourceCommits     DEFAULT_INITIALIZER(0);
+
+    /// Number of descriptor sets allocated by the context (Vulkan only).
+    Uint32 NumDescriptorSetAllocations  DEFAULT_INITIALIZER(0);
+
+    /// Number of resource barriers recorded by the context.
+    /// In OpenGL backend, this is the number of glMemoryBarrier() calls.
+    Uint32 NumBarriers                  DEFAULT_INITIALIZER(0);
+
+    /// Number of render passes begun by the context.
+    /// In OpenGL backend, this is the number of framebuffer bindings.
+    Uint32 NumRenderPasses              DEFAULT_INITIALIZER(0);
+
+    /// Number of bytes allocated from the dynamic heap for dynamic buffers and other transient data.
+    Uint64 DynamicHeapBytes             DEFAULT_INITIALIZER(0);
+
+    /// Number of bytes uploaded to GPU resources with UpdateBuffer() and UpdateTexture().
+    Uint64 UploadBytes                  DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceContextStats DeviceContextStats;
+
 #define DILIGENT_INTERFACE_NAME IDeviceContext
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -932,6 +1197,37 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                              IBuffer*                             pAttribsBuffer) PURE;
 
 
+    /// Executes multiple indirect draw commands.
+
+    /// \param [in] Attribs        - Structure describing the command attributes, see Diligent::MultiDrawIndirectAttribs for details.
+    /// \param [in] pAttribsBuffer - Pointer to the buffer, from which indirect draw attributes will be read.
+    ///
+    /// \remarks  Attributes of Attribs.DrawCount draw commands are read from the buffer starting at
+    ///           Attribs.IndirectDrawArgsOffset and separated by Attribs.IndirectDrawArgsStride bytes.
+    ///           If Attribs.pCountBuffer is not null, the actual number of draws is read from that buffer
+    ///           and is clamped to Attribs.DrawCount. This requires DeviceFeatures::IndirectDrawCount feature.
+    ///
+    ///           If the device does not support DeviceFeatures::MultiDrawIndirect feature, the command
+    ///           is executed as a sequence of individual indirect draw commands.
+    ///
+    ///           State transition rules are the same as for IDeviceContext::DrawIndirect(), and
+    ///           also apply to the count buffer.
+    VIRTUAL void METHOD(MultiDrawIndirect)(THIS_
+                                           const MultiDrawIndirectAttribs REF Attribs,
+                                           IBuffer*                           pAttribsBuffer) PURE;
+
+
+    /// Executes multiple indexed indirect draw commands.
+
+    /// \param [in] Attribs        - Structure describing the command attributes, see Diligent::MultiDrawIndexedIndirectAttribs for details.
+    /// \param [in] pAttribsBuffer - Pointer to the buffer, from which indirect draw attributes will be read.
+    ///
+    /// \remarks  See remarks for IDeviceContext::MultiDrawIndirect().
+    VIRTUAL void METHOD(MultiDrawIndexedIndirect)(THIS_
+                                                  const MultiDrawIndexedIndirectAttribs REF Attribs,
+                                                  IBuffer*                                  pAttribsBuffer) PURE;
+
+
     /// Executes a dispatch compute command.
     
     /// \param [in] Attribs - Dispatch command attributes, see Diligent::DispatchComputeAttribs for details.
@@ -1316,6 +1612,98 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                                    ITexture*                                  pSrcTexture,
                                                    ITexture*                                  pDstTexture,
                                                    const ResolveTextureSubresourceAttribs REF ResolveAttribs) PURE;
+
+
+    /// Begins a named debug group.
+
+    /// \param [in] Name   - Name of the debug group.
+    /// \param [in] pColor - Optional pointer to the RGBA color of the group, may be null.
+    /// \remarks Debug groups can be nested and are displayed by external graphics debugging and
+    ///          profiling tools (RenderDoc, Nsight, PIX, etc.). Every call to BeginDebugGroup() must be
+    ///          matched by a call to EndDebugGroup() on the same context. Groups are silently
+    ///          ignored when the backend or the driver does not support them.
+    VIRTUAL void METHOD(BeginDebugGroup)(THIS_
+                                         const Char*  Name,
+                                         const float* pColor DEFAULT_VALUE(nullptr)) PURE;
+
+
+    /// Ends the debug group that was last begun by BeginDebugGroup().
+    VIRTUAL void METHOD(EndDebugGroup)(THIS) PURE;
+
+
+    /// Inserts a debug label into the command stream.
+
+    /// \param [in] Label  - Label text.
+    /// \param [in] pColor - Optional pointer to the RGBA color of the label, may be null.
+    VIRTUAL void METHOD(InsertDebugLabel)(THIS_
+                                          const Char*  Label,
+                                          const float* pColor DEFAULT_VALUE(nullptr)) PURE;
+
+
+    /// Returns command statistics accumulated by the context since the last call to ResetStats().
+    VIRTUAL const DeviceContextStats REF METHOD(GetStats)(THIS) CONST PURE;
+
+
+    /// Resets command statistics of the context.
+
+    /// \remarks   Statistics are not reset automatically. To get per-frame statistics, an application
+    ///             should call ResetStats() at the beginning of every frame.
+    VIRTUAL void METHOD(ResetStats)(THIS) PURE;
+
+
+    /// Enables or disables redundant state filtering.
+
+    /// \param [in] Enable - Whether to enable redundant state filtering.
+    ///
+    /// \remarks    When the filtering is enabled, the context skips SetVertexBuffers(), SetIndexBuffer(),
+    ///             SetViewports() and SetScissorRects() calls that bind the same objects and values that
+    ///             are already bound. In Vulkan and OpenGL backends, CommitShaderResources() calls that commit
+    ///             the same shader resource binding again are skipped as well, unless the pipeline state
+    ///             has dynamic shader variables. Pipeline state changes are always filtered.
+    ///
+    ///             A call is only skipped if its state transition mode is not RESOURCE_STATE_TRANSITION_MODE_TRANSITION.
+    ///             Contents of dynamic buffers mapped between the commits are always used by the next draw call.
+    ///
+    ///             The filtering is disabled by default.
+    VIRTUAL void METHOD(SetStateFilteringEnabled)(THIS_
+                                                  bool Enable) PURE;
+
+
+    /// Enables or disables frame-retained resource bindings.
+
+    /// \param [in] Enable - Whether to enable frame-retained bindings.
+    ///
+    /// \remarks   By default, the context keeps a strong reference to every bound pipeline state,
+    ///             shader resource binding, vertex and index buffer, render target and depth-stencil view,
+    ///             so every bind and unbind increments and decrements the reference counter of the object.
+    ///             When frame-retained bindings are enabled, the context keeps raw pointers to the bound
+    ///             objects instead and increments the reference counter of every object only the first
+    ///             time the object is bound during the frame. The references are released in FinishFrame():
+    ///             in Direct3D12 and Vulkan backends, they are released once the GPU completes the command
+    ///             buffers submitted during the frame. Objects that remain bound when the frame is finished
+    ///             are retained for the next frame.
+    ///
+    ///             An application that enables frame-retained bindings must call FinishFrame() regularly,
+    ///             otherwise all objects ever bound to the context are kept alive.
+    ///
+    ///             Frame-retained bindings are disabled by default.
+    VIRTUAL void METHOD(SetFrameRetainedBindingsEnabled)(THIS_
+                                                         bool Enable) PURE;
+
+
+    /// Executes an array of draw packets.
+
+    /// \param [in] Attribs - Submission attributes, see Diligent::SubmitDrawPacketsAttribs for details.
+    ///
+    /// \remarks    For every packet, the context sets the pipeline state, vertex and index buffers,
+    ///             commits the shader resources and issues the draw command. Redundant state changes between
+    ///             consecutive packets are filtered out regardless of SetStateFilteringEnabled() setting.
+    ///
+    ///             Render targets, viewports and scissor rects must be set by the application before
+    ///             the packets are submitted. After the method returns, the states of the last executed packet
+    ///             remain bound to the context.
+    VIRTUAL void METHOD(SubmitDrawPackets)(THIS_
+                                           const SubmitDrawPacketsAttribs REF Attribs) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -1340,6 +1728,8 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_DrawIndexed(This, ...)               CALL_IFACE_METHOD(DeviceContext, DrawIndexed,               This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndirect(This, ...)              CALL_IFACE_METHOD(DeviceContext, DrawIndirect,              This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndexedIndirect(This, ...)       CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirect,       This, __VA_ARGS__)
+#    define IDeviceContext_MultiDrawIndirect(This, ...)         CALL_IFACE_METHOD(DeviceContext, MultiDrawIndirect,         This, __VA_ARGS__)
+#    define IDeviceContext_MultiDrawIndexedIndirect(This, ...)  CALL_IFACE_METHOD(DeviceContext, MultiDrawIndexedIndirect,  This, __VA_ARGS__)
 #    define IDeviceContext_DispatchCompute(This, ...)           CALL_IFACE_METHOD(DeviceContext, DispatchCompute,           This, __VA_ARGS__)
 #    define IDeviceContext_DispatchComputeIndirect(This, ...)   CALL_IFACE_METHOD(DeviceContext, DispatchComputeIndirect,   This, __VA_ARGS__)
 #    define IDeviceContext_ClearDepthStencil(This, ...)         CALL_IFACE_METHOD(DeviceContext, ClearDepthStencil,         This, __VA_ARGS__)
@@ -1364,6 +1754,14 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_FinishFrame(This)                    CALL_IFACE_METHOD(DeviceContext, FinishFrame,               This)
 #    define IDeviceContext_TransitionResourceStates(This, ...)  CALL_IFACE_METHOD(DeviceContext, TransitionResourceStates,  This, __VA_ARGS__)
 #    define IDeviceContext_ResolveTextureSubresource(This, ...) CALL_IFACE_METHOD(DeviceContext, ResolveTextureSubresource, This, __VA_ARGS__)
+#    define IDeviceContext_BeginDebugGroup(This, ...)           CALL_IFACE_METHOD(DeviceContext, BeginDebugGroup,           This, __VA_ARGS__)
+#    define IDeviceContext_EndDebugGroup(This)                  CALL_IFACE_METHOD(DeviceContext, EndDebugGroup,             This)
+#    define IDeviceContext_InsertDebugLabel(This, ...)          CALL_IFACE_METHOD(DeviceContext, InsertDebugLabel,          This, __VA_ARGS__)
+#    define IDeviceContext_GetStats(This)                       CALL_IFACE_METHOD(DeviceContext, GetStats,                  This)
+#    define IDeviceContext_ResetStats(This)                     CALL_IFACE_METHOD(DeviceContext, ResetStats,                This)
+#    define IDeviceContext_SetStateFilteringEnabled(This, ...)  CALL_IFACE_METHOD(DeviceContext, SetStateFilteringEnabled,  This, __VA_ARGS__)
+#    define IDeviceContext_SetFrameRetainedBindingsEnabled(This, ...) CALL_IFACE_METHOD(DeviceContext, SetFrameRetainedBindingsEnabled, This, __VA_ARGS__)
+#    define IDeviceContext_SubmitDrawPackets(This, ...)         CALL_IFACE_METHOD(DeviceContext, SubmitDrawPackets,         This, __VA_ARGS__)
 
 // clang-format on
 
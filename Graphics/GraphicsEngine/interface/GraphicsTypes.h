@@ -909,12 +909,22 @@ DILIGENT_TYPED_ENUM(COMPARISON_FUNCTION, Uint8)
 /// The enumeration is used by TextureDesc to describe misc texture flags
 DILIGENT_TYPED_ENUM(MISC_TEXTURE_FLAGS, Uint8)
 {
-    MISC_TEXTURE_FLAG_NONE          = 0x00,
+    MISC_TEXTURE_FLAG_NONE             = 0x00,
 
     /// Allow automatic mipmap generation with ITextureView::GenerateMips()
 
     /// \note A texture must be created with BIND_RENDER_TARGET bind flag
-    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01
+    MISC_TEXTURE_FLAG_GENERATE_MIPS    = 0x01,
+
+    /// Do not clear the texture when it is created without initial data
+
+    /// \note  The texture is created in RESOURCE_STATE_UNDEFINED state and its contents are undefined
+    ///        until they are written, e.g. by a clear, a draw or a copy command. Use this flag for
+    ///        render targets and UAV textures that are fully overwritten before they are read.
+    ///        Vulkan backend clears textures created without initial data unless this flag
+    ///        is specified or EngineVkCreateInfo::ClearUninitializedTextures is false.
+    ///        Other backends ignore this flag.
+    MISC_TEXTURE_FLAG_NO_INITIAL_CLEAR = 0x02
 };
 DEFINE_FLAG_ENUM_OPERATORS(MISC_TEXTURE_FLAGS)
 
@@ -1363,7 +1373,8 @@ struct EngineCreateInfo
     /// Number of deferred contexts to create when initializing the engine. If non-zero number 
     /// is given, pointers to the contexts are written to ppContexts array by the engine factory 
     /// functions (IEngineFactoryD3D11::CreateDeviceAndContextsD3D11,
-    /// IEngineFactoryD3D12::CreateDeviceAndContextsD3D12, and IEngineFactoryVk::CreateDeviceAndContextsVk)
+    /// IEngineFactoryD3D12::CreateDeviceAndContextsD3D12, IEngineFactoryVk::CreateDeviceAndContextsVk,
+    /// IEngineFactoryOpenGL::CreateDeviceAndSwapChainGL and IEngineFactoryOpenGL::AttachToActiveGLContext)
     /// starting at position 1.
     Uint32                   NumDeferredContexts  DEFAULT_INITIALIZER(0);
 };
@@ -1381,6 +1392,29 @@ struct EngineGLCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// provide additional runtime checking, validation, and logging
     /// functionality while possibly incurring performance penalties
     bool CreateDebugContext     DEFAULT_INITIALIZER(false);
+
+    /// Size of the persistently mapped dynamic heap that is used to suballocate memory
+    /// for dynamic uniform buffers mapped with MAP_FLAG_DISCARD.
+
+    /// The heap requires OpenGL 4.4 or GL_ARB_buffer_storage extension. When the size is zero
+    /// or buffer storage is not available (e.g. in GLES), dynamic buffers are updated through
+    /// buffer orphaning. Similar to Vulkan and Direct3D12 backends, the contents of
+    /// a dynamic buffer allocated in the heap are only valid until the end of the frame
+    /// (see IDeviceContext::FinishFrame()), so the buffer must be mapped every frame it is used.
+    Uint32 DynamicHeapSize      DEFAULT_INITIALIZER(0);
+
+    /// Path to the directory where linked program binaries are cached between runs.
+
+    /// When the path is not null, the engine retrieves the binary of every program it links
+    /// with glGetProgramBinary() and saves it to the directory. Next time the same program is
+    /// requested, the binary is loaded with glProgramBinary() instead of linking the program.
+    /// When separable programs are supported, shaders whose programs are found in the cache
+    /// are not compiled either. The binaries are identified by the full shader sources (including
+    /// macros) and the GL vendor, renderer and version strings, so a driver update invalidates
+    /// the cache.
+    /// The directory must exist. The cache requires OpenGL 4.1, OpenGLES 3.0 or
+    /// GL_ARB_get_program_binary extension.
+    const Char* ProgramBinaryCacheDir DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct EngineGLCreateInfo EngineGLCreateInfo;
 
@@ -1630,7 +1664,21 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 
     /// Enable Vulkan validation layers.
     bool EnableValidation                       DEFAULT_INITIALIZER(false);
-        
+
+    /// Clear textures that are created without initial data. Uninitialized textures
+    /// are reported by Vulkan validation layers when they are read. If this member is false,
+    /// textures without initial data are created in RESOURCE_STATE_UNDEFINED state
+    /// and nothing is submitted to the GPU, see MISC_TEXTURE_FLAG_NO_INITIAL_CLEAR.
+    bool ClearUninitializedTextures             DEFAULT_INITIALIZER(true);
+
+    /// Create a dedicated transfer queue that executes initial data uploads and
+    /// copies scheduled with IRenderDeviceVk::CopyTextureOnTransferQueue().
+    /// A queue from a transfer-only queue family is preferred; if the device does not expose one,
+    /// a second queue of the graphics queue family is created. If neither is available,
+    /// all uploads are executed by the graphics queue. When attaching to an existing
+    /// Vulkan device, the second command queue, if provided, is used as the transfer queue.
+    bool EnableTransferQueue                    DEFAULT_INITIALIZER(false);
+
     /// Number of global Vulkan extensions
     Uint32             GlobalExtensionCount     DEFAULT_INITIALIZER(0);
 
@@ -1697,6 +1745,18 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// the global dynamic heap to perform lock-free dynamic suballocations
     Uint32 DynamicHeapPageSize              DEFAULT_INITIALIZER(256 << 10);
 
+    /// The maximum total size of initial data, in bytes, that buffer and texture constructors
+    /// record into one command buffer before it is submitted to the GPU. Uploads and initial clears
+    /// of many resources are batched to avoid submitting a command buffer per resource.
+    /// Pending uploads are also submitted when the immediate context submits its commands
+    /// or when IRenderDeviceVk::FlushInitialDataUploads() is called.
+    /// 0 submits every upload immediately.
+    Uint32 InitialDataUploadBatchSize       DEFAULT_INITIALIZER(32 << 20);
+
+    /// The maximum time, in milliseconds, that initial data uploads may be pending before
+    /// the batch is submitted. The limit is checked when a new upload is recorded.
+    Uint32 InitialDataUploadMaxDelay        DEFAULT_INITIALIZER(16);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[5]
 #if DILIGENT_CPP_INTERFACE
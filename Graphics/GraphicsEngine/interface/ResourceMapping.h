@@ -90,6 +90,35 @@ struct ResourceMappingDesc
 };
 typedef struct ResourceMappingDesc ResourceMappingDesc;
 
+
+/// Describes a single resource lookup performed by IResourceMapping::GetResources()
+struct ResourceMappingLookupInfo
+{
+    /// Resource name
+    const Char* Name DEFAULT_INITIALIZER(nullptr);
+
+    /// For arrays, index of the array element
+    Uint32 ArrayIndex DEFAULT_INITIALIZER(0);
+
+    /// Optional hash of the resource name computed by Diligent::CStringHash<Char>.
+    /// If zero, the hash will be computed by the resource mapping.
+    size_t NameHash DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    ResourceMappingLookupInfo() noexcept
+    {}
+
+    ResourceMappingLookupInfo(const Char* _Name,
+                              Uint32      _ArrayIndex = 0,
+                              size_t      _NameHash   = 0) noexcept :
+        Name{_Name},
+        ArrayIndex{_ArrayIndex},
+        NameHash{_NameHash}
+    {}
+#endif
+};
+typedef struct ResourceMappingLookupInfo ResourceMappingLookupInfo;
+
 #define DILIGENT_INTERFACE_NAME IResourceMapping
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -166,6 +195,23 @@ DILIGENT_BEGIN_INTERFACE(IResourceMapping, IObject)
 
     /// Returns the size of the resource mapping, i.e. the number of objects.
     VIRTUAL size_t METHOD(GetSize)(THIS) PURE;
+
+    /// Finds multiple resources in the mapping.
+
+    /// \param [in]  NumResources - The number of resources to find.
+    /// \param [in]  pLookupInfo  - Pointer to the array of NumResources lookup info structures,
+    ///                             see Diligent::ResourceMappingLookupInfo.
+    /// \param [out] ppResources  - Pointer to the array of NumResources memory locations where the
+    ///                             pointers to the found objects will be written. If no object is found
+    ///                             for a lookup, nullptr will be written.
+    /// \remarks The method is equivalent to calling GetResource() for every lookup, but
+    ///          only synchronizes with other threads once for the entire batch.\n
+    ///          The method increases the reference counter of every returned object,
+    ///          so Release() must be called.
+    VIRTUAL void METHOD(GetResources)(THIS_
+                                      Uint32                           NumResources,
+                                      const ResourceMappingLookupInfo* pLookupInfo,
+                                      IDeviceObject**                  ppResources) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -180,6 +226,7 @@ DILIGENT_END_INTERFACE
 #    define IResourceMapping_RemoveResourceByName(This, ...) CALL_IFACE_METHOD(ResourceMapping, RemoveResourceByName, This, __VA_ARGS__)
 #    define IResourceMapping_GetResource(This, ...)          CALL_IFACE_METHOD(ResourceMapping, GetResource,          This, __VA_ARGS__)
 #    define IResourceMapping_GetSize(This)                   CALL_IFACE_METHOD(ResourceMapping, GetSize,              This)
+#    define IResourceMapping_GetResources(This, ...)         CALL_IFACE_METHOD(ResourceMapping, GetResources,         This, __VA_ARGS__)
 
 // clang-format on
 
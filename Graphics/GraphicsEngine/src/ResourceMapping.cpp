@@ -39,17 +39,12 @@ ResourceMappingImpl::~ResourceMappingImpl()
 
 IMPLEMENT_QUERY_INTERFACE(ResourceMappingImpl, IID_ResourceMapping, TObjectBase)
 
-ThreadingTools::LockHelper ResourceMappingImpl::Lock()
-{
-    return ThreadingTools::LockHelper(m_LockFlag);
-}
-
 void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex, IDeviceObject* const* ppObjects, Uint32 NumElements, bool bIsUnique)
 {
     if (Name == nullptr || *Name == 0)
         return;
 
-    auto LockHelper = Lock();
+    ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveRWLock> Lock{m_Lock};
     for (Uint32 Elem = 0; Elem < NumElements; ++Elem)
     {
         auto* pObject = ppObjects[Elem];
@@ -85,7 +80,7 @@ void ResourceMappingImpl::RemoveResourceByName(const Char* Name, Uint32 ArrayInd
     if (*Name == 0)
         return;
 
-    auto LockHelper = Lock();
+    ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveRWLock> Lock{m_Lock};
     // Remove object with the given name
     // Name will be implicitly converted to HashMapStringKey without making a copy
     m_HashTable.erase(ResMappingHashKey(Name, false, ArrayIndex));
@@ -104,21 +99,51 @@ void ResourceMappingImpl::GetResource(const Char* Name, IDeviceObject** ppResour
     VERIFY(*ppResource == nullptr, "Overwriting reference to existing object may cause memory leaks");
     *ppResource = nullptr;
 
-    auto LockHelper = Lock();
+    ThreadingTools::SharedLockGuard Lock{m_Lock};
 
     // Find an object with the requested name
     // Name will be implicitly converted to HashMapStringKey without making a copy
-    auto It = m_HashTable.find(ResMappingHashKey(Name, false, ArrayIndex));
-    if (It != m_HashTable.end())
+    *ppResource = FindResource(ResMappingHashKey(Name, false, ArrayIndex));
+}
+
+void ResourceMappingImpl::GetResources(Uint32 NumResources, const ResourceMappingLookupInfo* pLookupInfo, IDeviceObject** ppResources)
+{
+    if (NumResources == 0)
+        return;
+
+    VERIFY(pLookupInfo != nullptr && ppResources != nullptr, "Null pointer provided");
+    if (pLookupInfo == nullptr || ppResources == nullptr)
+        return;
+
+    ThreadingTools::SharedLockGuard Lock{m_Lock};
+    for (Uint32 i = 0; i < NumResources; ++i)
     {
-        *ppResource = It->second.RawPtr();
-        if (*ppResource)
-            (*ppResource)->AddRef();
+        const auto& LookupInfo = pLookupInfo[i];
+        VERIFY(ppResources[i] == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+        ppResources[i] = nullptr;
+        if (LookupInfo.Name == nullptr || *LookupInfo.Name == 0)
+            continue;
+
+        ppResources[i] = FindResource(ResMappingHashKey(LookupInfo.Name, LookupInfo.NameHash, LookupInfo.ArrayIndex));
     }
 }
 
+IDeviceObject* ResourceMappingImpl::FindResource(const ResMappingHashKey& Key)
+{
+    auto It = m_HashTable.find(Key);
+    if (It == m_HashTable.end())
+        return nullptr;
+
+    auto* pObject = It->second.RawPtr();
+    if (pObject != nullptr)
+        pObject->AddRef();
+    return pObject;
+}
+
 size_t ResourceMappingImpl::GetSize()
 {
+    ThreadingTools::SharedLockGuard Lock{m_Lock};
     return m_HashTable.size();
 }
 } // namespace Diligent
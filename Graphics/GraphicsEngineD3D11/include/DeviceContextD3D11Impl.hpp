@@ -206,6 +206,15 @@ public:
                                                               ITexture*                               pDstTexture,
                                                               const ResolveTextureSubresourceAttribs& ResolveAttribs) override final;
 
+    /// Implementation of IDeviceContext::BeginDebugGroup() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE BeginDebugGroup(const Char* Name, const float* pColor) override final;
+
+    /// Implementation of IDeviceContext::EndDebugGroup() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE EndDebugGroup() override final;
+
+    /// Implementation of IDeviceContext::InsertDebugLabel() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE InsertDebugLabel(const Char* Label, const float* pColor) override final;
+
     /// Implementation of IDeviceContext::FinishCommandList() in Direct3D11 backend.
     void DILIGENT_CALL_TYPE FinishCommandList(class ICommandList** ppCommandList) override final;
 
@@ -303,6 +312,12 @@ private:
 
     CComPtr<ID3D11DeviceContext> m_pd3d11DeviceContext; ///< D3D11 device context
 
+#if D3D11_VERSION >= 1
+    /// User-defined annotation interface used to emit debug groups and markers.
+    /// May be null if the interface is not supported by the context.
+    CComPtr<ID3DUserDefinedAnnotation> m_pd3dAnnotation;
+#endif
+
     // clang-format off
 
     /// An array of D3D11 constant buffers committed to D3D11 device context,
@@ -42,6 +42,7 @@
 #include "RenderDeviceD3D11Impl.hpp"
 #include "FenceD3D11Impl.hpp"
 #include "QueryD3D11Impl.hpp"
+#include "StringTools.hpp"
 
 namespace Diligent
 {
@@ -63,6 +64,9 @@ DeviceContextD3D11Impl::DeviceContextD3D11Impl(IReferenceCounters*
     m_CmdListAllocator   {GetRawAllocator(), sizeof(CommandListD3D11Impl), 64}
 // clang-format on
 {
+#if D3D11_VERSION >= 1
+    m_pd3d11DeviceContext->QueryInterface(__uuidof(ID3DUserDefinedAnnotation), reinterpret_cast<void**>(&m_pd3dAnnotation));
+#endif
 }
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextD3D11Impl, IID_DeviceContextD3D11, TDeviceContextBase)
@@ -1157,6 +1161,11 @@ void DeviceContextD3D11Impl::FinishFrame()
         m_ActiveDisjointQuery->IsEnded = true;
         m_ActiveDisjointQuery.reset();
     }
+
+    // D3D11 runtime keeps resources alive while they are used by the GPU,
+    // so the objects retained during the frame can be released right away.
+    FrameRetainedObjects::ObjectList RetainedObjects;
+    ExtractFrameRetainedObjects(RetainedObjects);
 }
 
 void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         StartSlot,
@@ -1166,6 +1175,9 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsRedundantVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
     {
@@ -1198,6 +1210,9 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
 
 void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsRedundantIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
 
     if (m_pIndexBuffer)
@@ -1227,6 +1242,9 @@ void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOf
 
 void DeviceContextD3D11Impl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsRedundantViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
+
     static_assert(MAX_VIEWPORTS >= D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
     TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
 
@@ -1248,6 +1266,9 @@ void DeviceContextD3D11Impl::SetViewports(Uint32 NumViewports, const Viewport* p
 
 void DeviceContextD3D11Impl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsRedundantScissorRects(NumRects, pRects))
+        return;
+
     static_assert(MAX_VIEWPORTS >= D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
     TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
 
@@ -2092,6 +2113,37 @@ void DeviceContextD3D11Impl::ResolveTextureSubresource(ITexture*
     m_pd3d11DeviceContext->ResolveSubresource(pDstTexD3D11->GetD3D11Texture(), DstSubresIndex, pSrcTexD3D11->GetD3D11Texture(), SrcSubresIndex, DXGIFmt);
 }
 
+void DeviceContextD3D11Impl::BeginDebugGroup(const Char* Name, const float* pColor)
+{
+    if (!TDeviceContextBase::BeginDebugGroup(Name, 0))
+        return;
+
+#if D3D11_VERSION >= 1
+    if (m_pd3dAnnotation)
+        m_pd3dAnnotation->BeginEvent(WidenString(Name).c_str());
+#endif
+}
+
+void DeviceContextD3D11Impl::EndDebugGroup()
+{
+    if (!TDeviceContextBase::EndDebugGroup(0))
+        return;
+
+#if D3D11_VERSION >= 1
+    if (m_pd3dAnnotation)
+        m_pd3dAnnotation->EndEvent();
+#endif
+}
+
+void DeviceContextD3D11Impl::InsertDebugLabel(const Char* Label, const float* pColor)
+{
+    VERIFY(Label != nullptr, "Label must not be null");
+#if D3D11_VERSION >= 1
+    if (m_pd3dAnnotation)
+        m_pd3dAnnotation->SetMarker(WidenString(Label).c_str());
+#endif
+}
+
 // clang-format off
 #ifdef VERIFY_CONTEXT_BINDINGS
     DEFINE_D3D11CTX_FUNC_POINTERS(GetCBMethods,      GetConstantBuffers)
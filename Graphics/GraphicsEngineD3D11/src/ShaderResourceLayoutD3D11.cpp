@@ -611,19 +611,39 @@ public:
     }
 
     template <typename ResourceType>
-    void Bind(ResourceType& Res)
+    void AddLookups(ResourceType& Res)
     {
         if ((Flags & (1 << Res.GetType())) == 0)
             return;
 
+        const auto* VarName  = Res.m_Attribs.Name;
+        const auto  NameHash = CStringHash<Char>{}(VarName);
         for (Uint16 elem = 0; elem < Res.m_Attribs.BindCount; ++elem)
         {
             if ((Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) && Res.IsBound(elem))
                 continue;
 
-            const auto*                  VarName = Res.m_Attribs.Name;
-            RefCntAutoPtr<IDeviceObject> pRes;
-            ResourceMapping.GetResource(VarName, &pRes, elem);
+            Batch.AddLookup(&Res, VarName, NameHash, elem);
+        }
+    }
+
+    void ResolveLookups()
+    {
+        Batch.Resolve(ResourceMapping);
+    }
+
+    template <typename ResourceType>
+    void Bind(ResourceType& Res)
+    {
+        if ((Flags & (1 << Res.GetType())) == 0)
+            return;
+
+        for (Uint16 elem = 0; elem < Res.m_Attribs.BindCount; ++elem)
+        {
+            IDeviceObject* pRes = nullptr;
+            if (!Batch.ConsumeNext(&Res, elem, pRes))
+                continue;
+
             if (pRes)
             {
                 //  Call non-virtual function
@@ -633,7 +653,7 @@ public:
             {
                 if ((Flags & BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED) && !Res.IsBound(elem))
                 {
-                    LOG_ERROR_MESSAGE("Unable to bind resource to shader variable '", VarName,
+                    LOG_ERROR_MESSAGE("Unable to bind resource to shader variable '", Res.m_Attribs.Name,
                                       "': resource is not found in the resource mapping");
                 }
             }
@@ -641,8 +661,9 @@ public:
     }
 
 private:
-    IResourceMapping& ResourceMapping;
-    const Uint32      Flags;
+    IResourceMapping&    ResourceMapping;
+    const Uint32         Flags;
+    ResourceMappingBatch Batch;
 };
 
 void ShaderResourceLayoutD3D11::BindResources(IResourceMapping*               pResourceMapping,
@@ -662,6 +683,44 @@ void ShaderResourceLayoutD3D11::BindResources(IResourceMapping*               pR
 
     BindResourceHelper BindResHelper(*pResourceMapping, Flags);
 
+    // Look up all resources in the resource mapping at once
+    // clang-format off
+    HandleResources(
+        [&](ConstBuffBindInfo& cb)
+        {
+            BindResHelper.AddLookups(cb);
+        },
+
+        [&](TexSRVBindInfo& ts)
+        {
+            BindResHelper.AddLookups(ts);
+        },
+
+        [&](TexUAVBindInfo& uav)
+        {
+            BindResHelper.AddLookups(uav);
+        },
+
+        [&](BuffSRVBindInfo& srv)
+        {
+            BindResHelper.AddLookups(srv);
+        },
+
+        [&](BuffUAVBindInfo& uav)
+        {
+            BindResHelper.AddLookups(uav);
+        },
+
+        [&](SamplerBindInfo& sam)
+        {
+            if (!m_pResources->IsUsingCombinedTextureSamplers())
+                BindResHelper.AddLookups(sam);
+        }
+    );
+    // clang-format on
+
+    BindResHelper.ResolveLookups();
+
     // clang-format off
     HandleResources(
         [&](ConstBuffBindInfo& cb)
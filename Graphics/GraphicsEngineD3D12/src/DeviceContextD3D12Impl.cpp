@@ -768,6 +768,9 @@ void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsRedundantVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
 
     auto& CmdCtx = GetCmdContext();
@@ -792,6 +795,9 @@ void DeviceContextD3D12Impl::InvalidateState()
 
 void DeviceContextD3D12Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsRedundantIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     if (m_pIndexBuffer)
     {
@@ -822,6 +828,9 @@ void DeviceContextD3D12Impl::CommitViewports()
 
 void DeviceContextD3D12Impl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsRedundantViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
+
     static_assert(MAX_VIEWPORTS >= D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
     TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
@@ -882,6 +891,9 @@ void DeviceContextD3D12Impl::CommitScissorRects(GraphicsContext& GraphCtx, bool
 
 void DeviceContextD3D12Impl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsRedundantScissorRects(NumRects, pRects))
+        return;
+
     const Uint32 MaxScissorRects = D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
     VERIFY(NumRects < MaxScissorRects, "Too many scissor rects are being set");
     NumRects = std::min(NumRects, MaxScissorRects);
@@ -1836,4 +1848,29 @@ void DeviceContextD3D12Impl::ResolveTextureSubresource(ITexture*
 
     CmdCtx.ResolveSubresource(pDstTexD3D12->GetD3D12Resource(), DstSubresIndex, pSrcTexD3D12->GetD3D12Resource(), SrcSubresIndex, DXGIFmt);
 }
+
+// Metadata value that PIX and other tools use to identify ANSI event strings
+static constexpr UINT PIX_EVENT_ANSI_VERSION = 1;
+
+void DeviceContextD3D12Impl::BeginDebugGroup(const Char* Name, const float* pColor)
+{
+    if (!TDeviceContextBase::BeginDebugGroup(Name, 0))
+        return;
+
+    GetCmdContext().GetCommandList()->BeginEvent(PIX_EVENT_ANSI_VERSION, Name, static_cast<UINT>(strlen(Name) + 1));
+}
+
+void DeviceContextD3D12Impl::EndDebugGroup()
+{
+    if (!TDeviceContextBase::EndDebugGroup(0))
+        return;
+
+    GetCmdContext().GetCommandList()->EndEvent();
+}
+
+void DeviceContextD3D12Impl::InsertDebugLabel(const Char* Label, const float* pColor)
+{
+    VERIFY(Label != nullptr, "Label must not be null");
+    GetCmdContext().GetCommandList()->SetMarker(PIX_EVENT_ANSI_VERSION, Label, static_cast<UINT>(strlen(Label) + 1));
+}
 } // namespace Diligent
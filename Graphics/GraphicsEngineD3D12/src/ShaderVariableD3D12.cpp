@@ -178,22 +178,42 @@ void ShaderVariableManagerD3D12::BindResources(IResourceMapping* pResourceMappin
     if ((Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0)
         Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
 
+    // Look up all resources in the resource mapping at once
+    ResourceMappingBatch Batch;
     for (Uint32 v = 0; v < m_NumVariables; ++v)
     {
-        auto&       Var = m_pVariables[v];
+        const auto& Var = m_pVariables[v];
         const auto& Res = Var.m_Resource;
 
         if ((Flags & (1 << Res.GetVariableType())) == 0)
             continue;
 
+        const auto NameHash = CStringHash<Char>{}(Res.Attribs.Name);
         for (Uint32 ArrInd = 0; ArrInd < Res.Attribs.BindCount; ++ArrInd)
         {
             if ((Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) && Res.IsBound(ArrInd, m_ResourceCache))
                 continue;
 
-            RefCntAutoPtr<IDeviceObject> pObj;
-            VERIFY_EXPR(pResourceMapping != nullptr);
-            pResourceMapping->GetResource(Res.Attribs.Name, &pObj, ArrInd);
+            Batch.AddLookup(&Var, Res.Attribs.Name, NameHash, ArrInd);
+        }
+    }
+    VERIFY_EXPR(pResourceMapping != nullptr);
+    Batch.Resolve(*pResourceMapping);
+
+    for (Uint32 v = 0; v < m_NumVariables; ++v)
+    {
+        const auto& Var = m_pVariables[v];
+        const auto& Res = Var.m_Resource;
+
+        if ((Flags & (1 << Res.GetVariableType())) == 0)
+            continue;
+
+        for (Uint32 ArrInd = 0; ArrInd < Res.Attribs.BindCount; ++ArrInd)
+        {
+            IDeviceObject* pObj = nullptr;
+            if (!Batch.ConsumeNext(&Var, ArrInd, pObj))
+                continue;
+
             if (pObj)
             {
                 //  Call non-virtual function
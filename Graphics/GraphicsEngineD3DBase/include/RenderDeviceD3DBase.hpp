@@ -176,6 +176,8 @@ public:
         Features.TextureCompressionBC          = True;
         Features.PixelUAVWritesAndAtomics      = True;
         Features.TextureUAVExtendedFormats     = True;
+        Features.MultiDrawIndirect             = False; // Multi-draw commands are emulated
+        Features.IndirectDrawCount             = False;
     }
 };
 
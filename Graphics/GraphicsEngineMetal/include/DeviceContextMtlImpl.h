@@ -157,6 +157,12 @@ public:
                                            ITexture*                               pDstTexture,
                                            const ResolveTextureSubresourceAttribs& ResolveAttribs) override final;
 
+    virtual void BeginDebugGroup(const Char* Name, const float* pColor) override final;
+
+    virtual void EndDebugGroup() override final;
+
+    virtual void InsertDebugLabel(const Char* Label, const float* pColor) override final;
+
     void FinishCommandList(class ICommandList** ppCommandList) override final;
 
     virtual void ExecuteCommandList(class ICommandList* pCommandList) override final;
@@ -80,6 +80,21 @@ namespace Diligent
         LOG_ERROR_MESSAGE("DeviceContextMtlImpl::ResolveTextureSubresource() is not implemented");
     }
 
+    // Debug groups are only tracked until Metal command encoders are implemented
+    void DeviceContextMtlImpl::BeginDebugGroup(const Char* Name, const float* pColor)
+    {
+        TDeviceContextBase::BeginDebugGroup(Name, 0);
+    }
+
+    void DeviceContextMtlImpl::EndDebugGroup()
+    {
+        TDeviceContextBase::EndDebugGroup(0);
+    }
+
+    void DeviceContextMtlImpl::InsertDebugLabel(const Char* Label, const float* pColor)
+    {
+    }
+
     void DeviceContextMtlImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
     {
         if (!TDeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
@@ -97,6 +97,15 @@ protected:
     // Should be called at the end of FinishFrame()
     void EndFrame()
     {
+        {
+            // Objects retained by frame-retained bindings are released once all
+            // command buffers submitted during the frame have completed execution.
+            FrameRetainedObjects::ObjectList RetainedObjects;
+            this->ExtractFrameRetainedObjects(RetainedObjects);
+            if (!RetainedObjects.empty() && m_SubmittedBuffersCmdQueueMask != 0)
+                this->m_pDevice->SafeReleaseDeviceObject(std::move(RetainedObjects), m_SubmittedBuffersCmdQueueMask);
+        }
+
         if (this->m_bIsDeferred)
         {
             // For deferred context, reset submitted cmd queue mask
@@ -35,6 +35,7 @@
 #include "BufferViewGLImpl.hpp"
 #include "RenderDeviceGLImpl.hpp"
 #include "GLContextState.hpp"
+#include "GLDynamicHeap.hpp"
 
 namespace Diligent
 {
@@ -78,6 +79,17 @@ public:
 
     const GLObjectWrappers::GLBufferObj& GetGLHandle() { return m_GlBuffer; }
 
+    /// Returns true if the buffer contents can be suballocated from the context dynamic heap when
+    /// the buffer is mapped with MAP_FLAG_DISCARD. Only dynamic uniform buffers are eligible as they
+    /// are bound through glBindBufferRange(). Vertex and index buffers are referenced by VAOs and
+    /// keep using buffer orphaning.
+    bool IsDynamicHeapCompatible() const
+    {
+        return m_Desc.Usage == USAGE_DYNAMIC && m_Desc.BindFlags == BIND_UNIFORM_BUFFER;
+    }
+
+    const GLDynamicAllocation& GetDynamicAllocation() const { return m_DynamicAllocation; }
+
     /// Implementation of IBufferGL::GetGLBufferHandle().
     virtual GLuint DILIGENT_CALL_TYPE GetGLBufferHandle() override final { return GetGLHandle(); }
 
@@ -96,6 +108,11 @@ private:
     GLObjectWrappers::GLBufferObj m_GlBuffer;
     const Uint32                  m_BindTarget;
     const GLenum                  m_GLUsageHint;
+
+    // Region of the dynamic heap that holds the buffer contents since the last time
+    // the buffer was mapped with MAP_FLAG_DISCARD
+    GLDynamicAllocation m_DynamicAllocation;
+    bool                m_IsMappedFromDynamicHeap = false;
 };
 
 } // namespace Diligent
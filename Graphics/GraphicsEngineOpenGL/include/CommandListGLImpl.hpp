@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CommandListGLImpl class
+
+#include "CommandListBase.hpp"
+#include "RenderDeviceGLImpl.hpp"
+#include "GLCommandStream.hpp"
+
+namespace Diligent
+{
+
+/// Command list implementation in OpenGL backend.
+
+/// The command list owns the command stream recorded by the deferred context
+/// and keeps the context alive as the stream memory is allocated from it.
+class CommandListGLImpl final : public CommandListBase<ICommandList, RenderDeviceGLImpl>
+{
+public:
+    using TCommandListBase = CommandListBase<ICommandList, RenderDeviceGLImpl>;
+
+    CommandListGLImpl(IReferenceCounters* pRefCounters,
+                      RenderDeviceGLImpl* pDevice,
+                      IDeviceContext*     pDeferredCtx,
+                      GLCommandStream&&   CommandStream) :
+        // clang-format off
+        TCommandListBase{pRefCounters, pDevice},
+        m_pDeferredCtx  {pDeferredCtx},
+        m_CommandStream {std::move(CommandStream)}
+    // clang-format on
+    {
+    }
+
+    ~CommandListGLImpl()
+    {
+        // A command list may be released without being executed
+        Close();
+    }
+
+    const GLCommandStream& GetCommandStream() const { return m_CommandStream; }
+
+    /// Releases the objects referenced by the commands and returns the stream memory to the
+    /// deferred context. The command list can't be executed again after it has been closed.
+    void Close()
+    {
+        m_CommandStream.Clear();
+        m_pDeferredCtx.Release();
+    }
+
+private:
+    RefCntAutoPtr<IDeviceContext> m_pDeferredCtx;
+    GLCommandStream               m_CommandStream; // Must be declared after m_pDeferredCtx
+};
+
+} // namespace Diligent
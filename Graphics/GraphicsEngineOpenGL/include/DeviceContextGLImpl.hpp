@@ -36,6 +36,7 @@
 #include "TextureBaseGL.hpp"
 #include "QueryGLImpl.hpp"
 #include "PipelineStateGLImpl.hpp"
+#include "GLDynamicHeap.hpp"
 
 namespace Diligent
 {
@@ -55,7 +56,10 @@ class DeviceContextGLImpl final : public DeviceContextBase<IDeviceContextGL, Dev
 public:
     using TDeviceContextBase = DeviceContextBase<IDeviceContextGL, DeviceContextGLImplTraits>;
 
-    DeviceContextGLImpl(IReferenceCounters* pRefCounters, RenderDeviceGLImpl* pDeviceGL, bool bIsDeferred);
+    DeviceContextGLImpl(IReferenceCounters*       pRefCounters,
+                        RenderDeviceGLImpl*       pDeviceGL,
+                        bool                      bIsDeferred,
+                        const EngineGLCreateInfo& EngineCI);
 
     /// Queries the specific interface, see IObject::QueryInterface() for details.
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
@@ -120,6 +124,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndirect() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndirect       (const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexedIndirect() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
 
     /// Implementation of IDeviceContext::DispatchCompute() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DispatchCompute        (const DispatchComputeAttribs& Attribs) override final;
@@ -200,6 +208,15 @@ public:
                                                               ITexture*                               pDstTexture,
                                                               const ResolveTextureSubresourceAttribs& ResolveAttribs) override final;
 
+    /// Implementation of IDeviceContext::BeginDebugGroup() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE BeginDebugGroup(const Char* Name, const float* pColor) override final;
+
+    /// Implementation of IDeviceContext::EndDebugGroup() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE EndDebugGroup() override final;
+
+    /// Implementation of IDeviceContext::InsertDebugLabel() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE InsertDebugLabel(const Char* Label, const float* pColor) override final;
+
     /// Implementation of IDeviceContext::FinishCommandList() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE FinishCommandList(class ICommandList** ppCommandList) override final;
 
@@ -249,6 +266,9 @@ private:
     __forceinline void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenum& GlTopology);
     __forceinline void PrepareForIndexedDraw(VALUE_TYPE IndexType, Uint32 FirstIndexLocation, GLenum& GLIndexType, Uint32& FirstIndexByteOffset);
     __forceinline void PrepareForIndirectDraw(IBuffer* pAttribsBuffer);
+    __forceinline void PrepareForIndirectDrawCount(IBuffer* pCountBuffer);
+    __forceinline void PrepareForDispatch();
+    __forceinline void BindDynamicUniformBuffers();
     __forceinline void PostDraw();
 
     Uint32 m_CommitedResourcesTentativeBarriers = 0;
@@ -256,11 +276,48 @@ private:
     std::vector<class TextureBaseGL*> m_BoundWritableTextures;
     std::vector<class BufferGLImpl*>  m_BoundWritableBuffers;
 
+    // Scratch arrays that hold program resources before they are bound by the multi-bind methods
+    // of the context state. Null elements indicate unbound resource slots.
+    std::vector<const GLObjectWrappers::GLTextureObj*> m_MultiBindTextures;
+    std::vector<GLenum>                                m_MultiBindTexTargets;
+    std::vector<const GLObjectWrappers::GLSamplerObj*> m_MultiBindSamplers;
+    std::vector<const GLObjectWrappers::GLBufferObj*>  m_MultiBindBuffers;
+    std::vector<GLintptr>                              m_MultiBindOffsets;
+    std::vector<GLsizeiptr>                            m_MultiBindSizes;
+
+    const GLObjectWrappers::GLSamplerObj m_NullSampler{false};
+
     RefCntAutoPtr<ISwapChainGL> m_pSwapChain;
 
     bool m_IsDefaultFBOBound = false;
 
     GLObjectWrappers::GLFrameBufferObj m_DefaultFBO;
+
+    // Persistently mapped heap for dynamic uniform buffers. Null if the heap is disabled or
+    // persistent buffer mapping is not supported, in which case buffer orphaning is used.
+    std::unique_ptr<GLDynamicHeap> m_DynamicHeap;
+
+    // Dynamic uniform buffers bound by the last committed shader resource binding. Mapping any of them
+    // with MAP_FLAG_DISCARD moves it to a new dynamic heap range, so the slots are re-bound before the
+    // next draw or dispatch command.
+    struct CommittedDynamicUB
+    {
+        CommittedDynamicUB(Uint32        _Slot,
+                           BufferGLImpl* _pBuffer) :
+            // clang-format off
+            Slot   {_Slot},
+            pBuffer{_pBuffer}
+        // clang-format on
+        {}
+        Uint32                      Slot = 0;
+        RefCntAutoPtr<BufferGLImpl> pBuffer;
+    };
+    std::vector<CommittedDynamicUB> m_CommittedDynamicUBs;
+
+    bool m_DynamicUBsDirty = false;
+
+    // Indicates if KHR_debug groups and markers are available
+    const bool m_DebugGroupsSupported;
 };
 
 } // namespace Diligent
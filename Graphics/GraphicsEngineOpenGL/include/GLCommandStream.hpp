@@ -0,0 +1,446 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLCommandStream class
+
+#include <type_traits>
+#include <new>
+#include <cstring>
+
+#include "DeviceContext.h"
+#include "MemoryAllocator.h"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Commands that can be recorded by a deferred context in OpenGL backend
+enum class GLCommandType : Uint32
+{
+    SetPipelineState,
+    CommitShaderResources,
+    SetStencilRef,
+    SetBlendFactors,
+    SetVertexBuffers,
+    InvalidateState,
+    SetIndexBuffer,
+    SetViewports,
+    SetScissorRects,
+    SetRenderTargets,
+    Draw,
+    DrawIndexed,
+    DrawIndirect,
+    DrawIndexedIndirect,
+    MultiDrawIndirect,
+    MultiDrawIndexedIndirect,
+    DispatchCompute,
+    DispatchComputeIndirect,
+    ClearDepthStencil,
+    ClearRenderTarget,
+    UpdateBuffer,
+    CopyBuffer,
+    WriteDynamicBuffer,
+    UpdateTexture,
+    CopyTexture,
+    GenerateMips,
+    ResolveTextureSubresource,
+    BeginDebugGroup,
+    EndDebugGroup,
+    InsertDebugLabel
+};
+
+// Command packets are plain data structures. All pointers reference either the memory owned by
+// the command stream (arrays, strings, update data) or objects retained by the stream.
+namespace GLCommands
+{
+
+// clang-format off
+struct SetPipelineState          { static constexpr GLCommandType Type = GLCommandType::SetPipelineState;          IPipelineState* pPSO; };
+struct CommitShaderResources     { static constexpr GLCommandType Type = GLCommandType::CommitShaderResources;     IShaderResourceBinding* pSRB; RESOURCE_STATE_TRANSITION_MODE Mode; };
+struct SetStencilRef             { static constexpr GLCommandType Type = GLCommandType::SetStencilRef;             Uint32 StencilRef; };
+struct SetBlendFactors           { static constexpr GLCommandType Type = GLCommandType::SetBlendFactors;           const float* pBlendFactors; };
+struct InvalidateState           { static constexpr GLCommandType Type = GLCommandType::InvalidateState; };
+struct SetIndexBuffer            { static constexpr GLCommandType Type = GLCommandType::SetIndexBuffer;            IBuffer* pBuffer; Uint32 ByteOffset; RESOURCE_STATE_TRANSITION_MODE Mode; };
+struct Draw                      { static constexpr GLCommandType Type = GLCommandType::Draw;                      DrawAttribs Attribs; };
+struct DrawIndexed               { static constexpr GLCommandType Type = GLCommandType::DrawIndexed;               DrawIndexedAttribs Attribs; };
+struct DrawIndirect              { static constexpr GLCommandType Type = GLCommandType::DrawIndirect;              DrawIndirectAttribs Attribs; IBuffer* pAttribsBuffer; };
+struct DrawIndexedIndirect       { static constexpr GLCommandType Type = GLCommandType::DrawIndexedIndirect;       DrawIndexedIndirectAttribs Attribs; IBuffer* pAttribsBuffer; };
+struct MultiDrawIndirect         { static constexpr GLCommandType Type = GLCommandType::MultiDrawIndirect;         MultiDrawIndirectAttribs Attribs; IBuffer* pAttribsBuffer; };
+struct MultiDrawIndexedIndirect  { static constexpr GLCommandType Type = GLCommandType::MultiDrawIndexedIndirect;  MultiDrawIndexedIndirectAttribs Attribs; IBuffer* pAttribsBuffer; };
+struct DispatchCompute           { static constexpr GLCommandType Type = GLCommandType::DispatchCompute;           DispatchComputeAttribs Attribs; };
+struct DispatchComputeIndirect   { static constexpr GLCommandType Type = GLCommandType::DispatchComputeIndirect;   DispatchComputeIndirectAttribs Attribs; IBuffer* pAttribsBuffer; };
+struct GenerateMips              { static constexpr GLCommandType Type = GLCommandType::GenerateMips;              ITextureView* pView; };
+struct EndDebugGroup             { static constexpr GLCommandType Type = GLCommandType::EndDebugGroup; };
+// clang-format on
+
+struct SetVertexBuffers
+{
+    static constexpr GLCommandType Type = GLCommandType::SetVertexBuffers;
+
+    Uint32                         StartSlot;
+    Uint32                         NumBuffers;
+    IBuffer**                      ppBuffers;
+    Uint32*                        pOffsets;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+    SET_VERTEX_BUFFERS_FLAGS       Flags;
+};
+
+struct SetViewports
+{
+    static constexpr GLCommandType Type = GLCommandType::SetViewports;
+
+    Uint32          NumViewports;
+    const Viewport* pViewports;
+    Uint32          RTWidth;
+    Uint32          RTHeight;
+};
+
+struct SetScissorRects
+{
+    static constexpr GLCommandType Type = GLCommandType::SetScissorRects;
+
+    Uint32      NumRects;
+    const Rect* pRects;
+    Uint32      RTWidth;
+    Uint32      RTHeight;
+};
+
+struct SetRenderTargets
+{
+    static constexpr GLCommandType Type = GLCommandType::SetRenderTargets;
+
+    Uint32                         NumRenderTargets;
+    ITextureView**                 ppRenderTargets;
+    ITextureView*                  pDepthStencil;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct ClearDepthStencil
+{
+    static constexpr GLCommandType Type = GLCommandType::ClearDepthStencil;
+
+    ITextureView*                  pView;
+    CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags;
+    float                          fDepth;
+    Uint8                          Stencil;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct ClearRenderTarget
+{
+    static constexpr GLCommandType Type = GLCommandType::ClearRenderTarget;
+
+    ITextureView*                  pView;
+    const float*                   RGBA;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct UpdateBuffer
+{
+    static constexpr GLCommandType Type = GLCommandType::UpdateBuffer;
+
+    IBuffer*                       pBuffer;
+    Uint32                         Offset;
+    Uint32                         Size;
+    const void*                    pData;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct CopyBuffer
+{
+    static constexpr GLCommandType Type = GLCommandType::CopyBuffer;
+
+    IBuffer*                       pSrcBuffer;
+    Uint32                         SrcOffset;
+    RESOURCE_STATE_TRANSITION_MODE SrcMode;
+    IBuffer*                       pDstBuffer;
+    Uint32                         DstOffset;
+    Uint32                         Size;
+    RESOURCE_STATE_TRANSITION_MODE DstMode;
+};
+
+// Contents of a dynamic buffer that was mapped by the deferred context. The data is
+// written to the buffer through MapBuffer(MAP_FLAG_DISCARD) when the command is executed.
+struct WriteDynamicBuffer
+{
+    static constexpr GLCommandType Type = GLCommandType::WriteDynamicBuffer;
+
+    IBuffer*    pBuffer;
+    const void* pData;
+    Uint32      Size;
+};
+
+struct UpdateTexture
+{
+    static constexpr GLCommandType Type = GLCommandType::UpdateTexture;
+
+    ITexture*                      pTexture;
+    Uint32                         MipLevel;
+    Uint32                         Slice;
+    Box                            DstBox;
+    TextureSubResData              SubresData;
+    RESOURCE_STATE_TRANSITION_MODE SrcBufferMode;
+    RESOURCE_STATE_TRANSITION_MODE TextureMode;
+};
+
+struct CopyTexture
+{
+    static constexpr GLCommandType Type = GLCommandType::CopyTexture;
+
+    CopyTextureAttribs Attribs;
+};
+
+struct ResolveTextureSubresource
+{
+    static constexpr GLCommandType Type = GLCommandType::ResolveTextureSubresource;
+
+    ITexture*                        pSrcTexture;
+    ITexture*                        pDstTexture;
+    ResolveTextureSubresourceAttribs Attribs;
+};
+
+struct BeginDebugGroup
+{
+    static constexpr GLCommandType Type = GLCommandType::BeginDebugGroup;
+
+    const Char*  Name;
+    const float* pColor;
+};
+
+struct InsertDebugLabel
+{
+    static constexpr GLCommandType Type = GLCommandType::InsertDebugLabel;
+
+    const Char*  Label;
+    const float* pColor;
+};
+
+} // namespace GLCommands
+
+
+/// Compact command stream recorded by a deferred context in OpenGL backend.
+
+/// The stream consists of three arenas built from fixed-size chunks: the command packets,
+/// the auxiliary data referenced by the packets (arrays, strings, buffer and texture
+/// contents), and the objects referenced by the packets. The chunks are allocated from
+/// the chunk allocator provided at construction time, so recording commands does not
+/// touch the heap once the allocator pages have been created. Every object referenced by a
+/// command is retained when the command is recorded and released when the stream is cleared.
+class GLCommandStream
+{
+public:
+    /// Size of the memory chunk requested from the chunk allocator
+    static constexpr size_t ChunkSize = 16 << 10;
+
+    explicit GLCommandStream(IMemoryAllocator& ChunkAllocator) noexcept :
+        m_pChunkAllocator{&ChunkAllocator}
+    {}
+
+    GLCommandStream(GLCommandStream&& Stream) noexcept;
+
+    ~GLCommandStream()
+    {
+        Clear();
+    }
+
+    // clang-format off
+    GLCommandStream           (const GLCommandStream&)  = delete;
+    GLCommandStream& operator=(const GLCommandStream&)  = delete;
+    GLCommandStream& operator=(GLCommandStream&&)       = delete;
+    // clang-format on
+
+    /// Appends a new command packet to the stream and returns the reference to it.
+    template <typename CommandType>
+    CommandType& AddCommand()
+    {
+        static_assert(std::is_trivially_destructible<CommandType>::value, "Command packets must be trivially destructible");
+        static_assert(alignof(CommandType) <= CommandAlignment, "Command packet alignment exceeds the stream alignment");
+
+        constexpr auto PacketSize = AlignCommandSize(sizeof(CommandHeader)) + AlignCommandSize(sizeof(CommandType));
+
+        auto* pPacket = reinterpret_cast<Uint8*>(m_Commands.Allocate(PacketSize, CommandAlignment, *m_pChunkAllocator));
+        new (pPacket) CommandHeader{CommandType::Type, static_cast<Uint32>(PacketSize)};
+        ++m_NumCommands;
+        return *new (pPacket + AlignCommandSize(sizeof(CommandHeader))) CommandType{};
+    }
+
+    /// Allocates memory for the command data that stays valid until the stream is cleared.
+    void* AllocateData(size_t Size, size_t Alignment = CommandAlignment)
+    {
+        return m_Data.Allocate(Size, Alignment, *m_pChunkAllocator);
+    }
+
+    /// Copies the array to the memory owned by the stream. Returns null if the source array is null.
+    template <typename Type>
+    Type* CopyArray(const Type* pSrc, size_t Count)
+    {
+        static_assert(std::is_trivially_copyable<Type>::value, "Only trivially copyable types can be copied to the stream");
+        if (pSrc == nullptr || Count == 0)
+            return nullptr;
+        auto* pDst = reinterpret_cast<Type*>(AllocateData(sizeof(Type) * Count, alignof(Type)));
+        memcpy(pDst, pSrc, sizeof(Type) * Count);
+        return pDst;
+    }
+
+    /// Copies the null-terminated string to the memory owned by the stream.
+    const Char* CopyString(const Char* Str);
+
+    /// Adds a strong reference to the object that is released when the stream is cleared.
+    /// Returns the object pointer to facilitate initialization of command packets.
+    template <typename ObjectType>
+    ObjectType* RetainObject(ObjectType* pObject)
+    {
+        if (pObject != nullptr)
+        {
+            pObject->AddRef();
+            auto* ppSlot = reinterpret_cast<IObject**>(m_Objects.Allocate(sizeof(IObject*), alignof(IObject*), *m_pChunkAllocator));
+            *ppSlot      = pObject;
+        }
+        return pObject;
+    }
+
+    /// Calls Handler(const CommandType&) for every command packet in the order they were recorded.
+    /// The handler is a generic functor that provides an overload for every command type.
+    template <typename HandlerType>
+    void ProcessCommands(HandlerType&& Handler) const;
+
+    /// Releases all retained objects and returns all chunks to the allocator.
+    void Clear();
+
+    Uint32 GetNumCommands() const { return m_NumCommands; }
+
+    bool IsEmpty() const { return m_NumCommands == 0; }
+
+private:
+    static constexpr size_t CommandAlignment = 8;
+
+    static constexpr size_t AlignCommandSize(size_t Size)
+    {
+        return (Size + (CommandAlignment - 1)) & ~(CommandAlignment - 1);
+    }
+
+    struct CommandHeader
+    {
+        GLCommandType Type;
+        Uint32        Size; // Packet size including the header
+    };
+
+    struct Chunk
+    {
+        Chunk* pNext;
+        size_t Capacity; // Size of the memory that follows the chunk header
+        size_t Size;     // Used memory size
+        bool   IsLarge;  // Large chunks are allocated from the raw allocator
+    };
+
+    // Chunk data starts at the 16-byte aligned offset after the chunk header
+    static constexpr size_t ChunkDataOffset = (sizeof(Chunk) + 15) & ~size_t{15};
+
+    // Singly-linked list of chunks that memory is linearly allocated from
+    struct ChunkList
+    {
+        Chunk* pFirst = nullptr;
+        Chunk* pLast  = nullptr;
+
+        void* Allocate(size_t Size, size_t Alignment, IMemoryAllocator& ChunkAllocator);
+        void  Free(IMemoryAllocator& ChunkAllocator);
+    };
+
+    IMemoryAllocator* m_pChunkAllocator;
+
+    ChunkList m_Commands;
+    ChunkList m_Data;
+    ChunkList m_Objects;
+
+    Uint32 m_NumCommands = 0;
+};
+
+
+template <typename HandlerType>
+void GLCommandStream::ProcessCommands(HandlerType&& Handler) const
+{
+#define PROCESS_GL_COMMAND(CmdType)                                       \
+    case GLCommandType::CmdType:                                          \
+        Handler(*reinterpret_cast<const GLCommands::CmdType*>(pCmdData)); \
+        break
+
+    for (const auto* pChunk = m_Commands.pFirst; pChunk != nullptr; pChunk = pChunk->pNext)
+    {
+        const auto* pData    = reinterpret_cast<const Uint8*>(pChunk) + ChunkDataOffset;
+        const auto* pDataEnd = pData + pChunk->Size;
+        while (pData < pDataEnd)
+        {
+            const auto& Header   = *reinterpret_cast<const CommandHeader*>(pData);
+            const auto* pCmdData = pData + AlignCommandSize(sizeof(CommandHeader));
+            switch (Header.Type)
+            {
+                PROCESS_GL_COMMAND(SetPipelineState);
+                PROCESS_GL_COMMAND(CommitShaderResources);
+                PROCESS_GL_COMMAND(SetStencilRef);
+                PROCESS_GL_COMMAND(SetBlendFactors);
+                PROCESS_GL_COMMAND(SetVertexBuffers);
+                PROCESS_GL_COMMAND(InvalidateState);
+                PROCESS_GL_COMMAND(SetIndexBuffer);
+                PROCESS_GL_COMMAND(SetViewports);
+                PROCESS_GL_COMMAND(SetScissorRects);
+                PROCESS_GL_COMMAND(SetRenderTargets);
+                PROCESS_GL_COMMAND(Draw);
+                PROCESS_GL_COMMAND(DrawIndexed);
+                PROCESS_GL_COMMAND(DrawIndirect);
+                PROCESS_GL_COMMAND(DrawIndexedIndirect);
+                PROCESS_GL_COMMAND(MultiDrawIndirect);
+                PROCESS_GL_COMMAND(MultiDrawIndexedIndirect);
+                PROCESS_GL_COMMAND(DispatchCompute);
+                PROCESS_GL_COMMAND(DispatchComputeIndirect);
+                PROCESS_GL_COMMAND(ClearDepthStencil);
+                PROCESS_GL_COMMAND(ClearRenderTarget);
+                PROCESS_GL_COMMAND(UpdateBuffer);
+                PROCESS_GL_COMMAND(CopyBuffer);
+                PROCESS_GL_COMMAND(WriteDynamicBuffer);
+                PROCESS_GL_COMMAND(UpdateTexture);
+                PROCESS_GL_COMMAND(CopyTexture);
+                PROCESS_GL_COMMAND(GenerateMips);
+                PROCESS_GL_COMMAND(ResolveTextureSubresource);
+                PROCESS_GL_COMMAND(BeginDebugGroup);
+                PROCESS_GL_COMMAND(EndDebugGroup);
+                PROCESS_GL_COMMAND(InsertDebugLabel);
+
+                default:
+                    UNEXPECTED("Unknown command type");
+            }
+            VERIFY_EXPR(Header.Size != 0);
+            pData += Header.Size;
+        }
+    }
+
+#undef PROCESS_GL_COMMAND
+}
+
+} // namespace Diligent
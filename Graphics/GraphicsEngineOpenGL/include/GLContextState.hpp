@@ -48,13 +48,21 @@ public:
     void BindFBO           (const GLObjectWrappers::GLFrameBufferObj& FBO);
     void SetActiveTexture  (Int32 Index);
     void BindTexture       (Int32 Index, GLenum BindTarget, const GLObjectWrappers::GLTextureObj& Tex);
-    void BindUniformBuffer (Int32 Index,       const GLObjectWrappers::GLBufferObj& Buff);
+    void BindUniformBuffer (Int32 Index,       const GLObjectWrappers::GLBufferObj& Buff, GLintptr Offset = 0, GLsizeiptr Size = 0);
     void BindBuffer        (GLenum BindTarget, const GLObjectWrappers::GLBufferObj& Buff, bool ResetVAO);
     void BindSampler       (Uint32 Index,      const GLObjectWrappers::GLSamplerObj& GLSampler);
     void BindImage         (Uint32 Index, class TextureViewGLImpl* pTexView, GLint MipLevel, GLboolean IsLayered, GLint Layer, GLenum Access, GLenum Format);
     void BindImage         (Uint32 Index, class BufferViewGLImpl* pBuffView, GLenum Access, GLenum Format);
     void BindStorageBlock  (Int32 Index, const GLObjectWrappers::GLBufferObj& Buff, GLintptr Offset, GLsizeiptr Size);
 
+    // Bind objects to the range of slots [First, First + Count). Null pointers indicate slots that
+    // must be left unchanged. When GL_ARB_multi_bind is supported, every run of consecutive slots that
+    // contains modified bindings is set by a single glBind*s() call. Otherwise, the slots are bound one by one.
+    void BindTextures      (Uint32 First, Uint32 Count, const GLObjectWrappers::GLTextureObj* const ppTextures[], const GLenum BindTargets[]);
+    void BindSamplers      (Uint32 First, Uint32 Count, const GLObjectWrappers::GLSamplerObj* const ppSamplers[]);
+    void BindUniformBuffers(Uint32 First, Uint32 Count, const GLObjectWrappers::GLBufferObj*  const ppBuffers[], const GLintptr Offsets[], const GLsizeiptr Sizes[]);
+    void BindStorageBlocks (Uint32 First, Uint32 Count, const GLObjectWrappers::GLBufferObj*  const ppBuffers[], const GLintptr Offsets[], const GLsizeiptr Sizes[]);
+
     void EnsureMemoryBarrier(Uint32 RequiredBarriers, class AsyncWritableResource *pRes = nullptr);
     void SetPendingMemoryBarriers(Uint32 PendingBarriers);
     
@@ -109,9 +117,20 @@ public:
         GLint m_iMaxCombinedTexUnits      = 0;
         GLint m_iMaxDrawBuffers           = 0;
         GLint m_iMaxUniformBufferBindings = 0;
+        bool  bMultiBindSupported         = false;
     };
     const ContextCaps& GetContextCaps() { return m_Caps; }
 
+    Uint32 GetPendingMemoryBarriers() const { return m_PendingMemoryBarriers; }
+
+    // Returns the number of glMemoryBarrier() calls executed since the last call to this method
+    Uint32 ExtractNumExecutedMemoryBarriers()
+    {
+        auto NumBarriers            = m_NumExecutedMemoryBarriers;
+        m_NumExecutedMemoryBarriers = 0;
+        return NumBarriers;
+    }
+
 private:
     // It is unsafe to use GL handle to keep track of bound objects
     // When an object is released, GL is free to reuse its handle for
@@ -126,7 +145,6 @@ private:
     UniqueIdentifier              m_FBOId        = -1;
     std::vector<UniqueIdentifier> m_BoundTextures;
     std::vector<UniqueIdentifier> m_BoundSamplers;
-    std::vector<UniqueIdentifier> m_BoundUniformBuffers;
 
     struct BoundImageInfo
     {
@@ -169,12 +187,13 @@ private:
     };
     std::vector<BoundImageInfo> m_BoundImages;
 
-    struct BoundSSBOInfo
+    // Zero size indicates that the whole buffer is bound
+    struct BoundBufferRangeInfo
     {
-        BoundSSBOInfo() {}
-        BoundSSBOInfo(UniqueIdentifier _BufferID,
-                      GLintptr         _Offset,
-                      GLsizeiptr       _Size) :
+        BoundBufferRangeInfo() {}
+        BoundBufferRangeInfo(UniqueIdentifier _BufferID,
+                             GLintptr         _Offset,
+                             GLsizeiptr       _Size) :
             // clang-format off
             BufferID{_BufferID},
             Offset  {_Offset},
@@ -185,7 +204,7 @@ private:
         GLintptr         Offset   = 0;
         GLsizeiptr       Size     = 0;
 
-        bool operator==(const BoundSSBOInfo& rhs) const
+        bool operator==(const BoundBufferRangeInfo& rhs) const
         {
             // clang-format off
             return BufferID == rhs.BufferID &&
@@ -194,9 +213,14 @@ private:
             // clang-format on
         }
     };
-    std::vector<BoundSSBOInfo> m_BoundStorageBlocks;
+    std::vector<BoundBufferRangeInfo> m_BoundUniformBuffers;
+    std::vector<BoundBufferRangeInfo> m_BoundStorageBlocks;
+
+    // Scratch space for GL handles passed to multi-bind functions
+    std::vector<GLuint> m_MultiBindHandles;
 
-    Uint32 m_PendingMemoryBarriers = 0;
+    Uint32 m_PendingMemoryBarriers     = 0;
+    Uint32 m_NumExecutedMemoryBarriers = 0;
 
     class EnableStateHelper
     {
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLDynamicHeap class
+
+#include <deque>
+#include "RingBuffer.hpp"
+#include "GLObjectWrapper.hpp"
+
+namespace Diligent
+{
+
+class GLDynamicHeap;
+class GLContextState;
+class RenderDeviceGLImpl;
+
+/// Region of the dynamic heap that holds the contents of a dynamic buffer.
+struct GLDynamicAllocation
+{
+    GLDynamicHeap* pHeap       = nullptr;
+    Uint32         Offset      = 0; // Offset from the start of the heap buffer
+    Uint32         Size        = 0; // Size of the buffer data
+    void*          pCPUAddress = nullptr;
+#ifdef DILIGENT_DEVELOPMENT
+    Uint64 dvpFrameNumber = 0;
+#endif
+
+    bool IsValid() const
+    {
+        return pHeap != nullptr;
+    }
+};
+
+// Dynamic heap is used by the device context to allocate space for dynamic buffers
+// mapped with MAP_FLAG_DISCARD. This avoids orphaning the buffer storage through
+// glMapBufferRange(GL_MAP_INVALIDATE_BUFFER_BIT) every time the buffer is mapped,
+// which typically requires a round-trip to the driver.
+//
+// The heap uses a single buffer created with glBufferStorage() that is persistently and
+// coherently mapped once at initialization. Memory is suballocated from the buffer in
+// a ring fashion. Every frame is protected by a fence, and space is reclaimed when the
+// fence is signaled, similar to Vulkan dynamic heap.
+//
+//   _________________________________________________________________________
+//  |                                                                         |
+//  |                             GLDynamicHeap                               |
+//  |                                                                         |
+//  |  || Frame N-2 | Frame N-1 |  Frame N (current)  |       free       ||   |
+//  |________A______________A______________|_________________________________|
+//           |              |              |
+//      glFenceSync()  glFenceSync()   Allocate()
+//
+class GLDynamicHeap
+{
+public:
+    GLDynamicHeap(GLContextState& CtxState, Uint32 Size);
+    ~GLDynamicHeap();
+
+    // clang-format off
+    GLDynamicHeap            (const GLDynamicHeap&)  = delete;
+    GLDynamicHeap            (      GLDynamicHeap&&) = delete;
+    GLDynamicHeap& operator= (const GLDynamicHeap&)  = delete;
+    GLDynamicHeap& operator= (      GLDynamicHeap&&) = delete;
+    // clang-format on
+
+    /// Returns true if the device supports persistently mapped buffers.
+    static bool IsSupported(RenderDeviceGLImpl& DeviceGL);
+
+    /// Allocates the space for the buffer data. Returns invalid allocation if the heap is full.
+    GLDynamicAllocation Allocate(Uint32 SizeInBytes);
+
+    /// Closes the current frame and releases the space occupied by completed frames.
+    void FinishFrame();
+
+    const GLObjectWrappers::GLBufferObj& GetGLBuffer() const { return m_GLBuffer; }
+
+    Uint64 GetFrameNumber() const { return m_FrameNumber; }
+
+private:
+    void ReleaseCompletedFrames(bool WaitForOldestFrame);
+
+    GLObjectWrappers::GLBufferObj m_GLBuffer;
+    Uint8*                        m_CPUAddress = nullptr;
+    Uint32                        m_Alignment  = 256;
+
+    RingBuffer m_RingBuffer;
+
+    std::deque<std::pair<Uint64, GLObjectWrappers::GLSyncObj>> m_PendingFrames;
+
+    // Fence value 0 is reserved for 'no frames completed'
+    Uint64 m_FrameNumber          = 1;
+    Uint64 m_CompletedFrameNumber = 0;
+    bool   m_HeapFullWarningShown = false;
+};
+
+} // namespace Diligent
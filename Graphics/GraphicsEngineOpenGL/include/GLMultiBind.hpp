@@ -0,0 +1,70 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+enum class MultiBindSlotState
+{
+    Skipped,
+    Unchanged,
+    Modified
+};
+
+// Calls BindRange() for every run of consecutive non-skipped slots that contains at
+// least one modified binding. The range starts at the first and ends at the last modified
+// slot of the run. Unchanged slots inside the range are rebound, which is cheaper than
+// splitting the multi-bind call.
+template <typename UpdateSlotType, typename BindRangeType>
+void ProcessMultiBindSlots(Uint32 First, Uint32 Count, UpdateSlotType UpdateSlot, BindRangeType BindRange)
+{
+    constexpr Uint32 InvalidSlot = ~0u;
+
+    Uint32 FirstModified = InvalidSlot;
+    Uint32 LastModified  = InvalidSlot;
+    for (Uint32 Slot = First; Slot <= First + Count; ++Slot)
+    {
+        auto State = Slot < First + Count ? UpdateSlot(Slot) : MultiBindSlotState::Skipped;
+        if (State == MultiBindSlotState::Modified)
+        {
+            if (FirstModified == InvalidSlot)
+                FirstModified = Slot;
+            LastModified = Slot;
+        }
+        else if (State == MultiBindSlotState::Skipped && FirstModified != InvalidSlot)
+        {
+            BindRange(FirstModified, LastModified - FirstModified + 1);
+            FirstModified = InvalidSlot;
+        }
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLProgramBinaryCache class
+
+#include <vector>
+#include <sstream>
+#include <iomanip>
+
+#include "Shader.h"
+#include "FileSystem.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceGLImpl;
+
+// Program binary cache stores linked programs on disk so that shader compilation and
+// program linking can be skipped next time the application starts.
+//
+// Every program is identified by its signature that contains the full GLSL source of all
+// program stages (the source includes all macros and the engine-generated header). Programs
+// are stored in separate files named after the hash of the signature and the driver
+// identification string (GL vendor, renderer and version). The file also contains the
+// signature and the driver string themselves, which are compared on load, so a hash
+// collision or a binary produced by a different driver is never submitted to GL. A binary
+// may still be rejected by the driver (e.g. after an update that did not change the version
+// string), in which case the program is linked from the source and the file is overwritten.
+class GLProgramBinaryCache
+{
+public:
+    /// Program signature that uniquely identifies the program in the cache.
+    class ProgramSignature
+    {
+    public:
+        explicit ProgramSignature(bool IsSeparableProgram) :
+            m_Str{IsSeparableProgram ? "separable" : "linked"}
+        {}
+
+        /// Adds the program stage. The source length is recorded so that the
+        /// concatenated sources of different programs can never be equal.
+        void AddStage(SHADER_TYPE ShaderType, const String& GLSLSource)
+        {
+            m_Str.append("\nstage ");
+            m_Str.append(std::to_string(static_cast<Uint32>(ShaderType)));
+            m_Str.push_back(' ');
+            m_Str.append(std::to_string(GLSLSource.length()));
+            m_Str.push_back('\n');
+            m_Str.append(GLSLSource);
+        }
+
+        const String& GetString() const { return m_Str; }
+
+    private:
+        String m_Str;
+    };
+
+    /// Program binary retrieved with glGetProgramBinary().
+    struct ProgramBinary
+    {
+        GLenum             Format = 0;
+        std::vector<Uint8> Data;
+    };
+
+    GLProgramBinaryCache(const Char* CacheDir, const String& DriverId) :
+        m_CacheDir{CacheDir},
+        m_DriverId{DriverId}
+    {
+        VERIFY_EXPR(CacheDir != nullptr);
+    }
+
+    // clang-format off
+    GLProgramBinaryCache            (const GLProgramBinaryCache&)  = delete;
+    GLProgramBinaryCache            (      GLProgramBinaryCache&&) = delete;
+    GLProgramBinaryCache& operator= (const GLProgramBinaryCache&)  = delete;
+    GLProgramBinaryCache& operator= (      GLProgramBinaryCache&&) = delete;
+    // clang-format on
+
+    /// Returns true if the device supports retrieving and loading program binaries.
+    static bool IsSupported(RenderDeviceGLImpl& DeviceGL);
+
+    /// Returns the identification string of the driver of the current GL context.
+    static String GetDriverId()
+    {
+        return GetGLString(GL_VENDOR) + '\n' + GetGLString(GL_RENDERER) + '\n' + GetGLString(GL_VERSION);
+    }
+
+    /// Returns the path of the file that stores the program with the given signature.
+    String GetFilePath(const ProgramSignature& Signature) const
+    {
+        const auto Key = ComputeFNV1aHash(Signature.GetString(), ComputeFNV1aHash(m_DriverId));
+
+        std::stringstream PathSS;
+        PathSS << m_CacheDir;
+        if (!m_CacheDir.empty() && m_CacheDir.back() != '/' && m_CacheDir.back() != '\\')
+            PathSS << FileSystem::GetSlashSymbol();
+        PathSS << std::hex << std::setw(16) << std::setfill('0') << Key << ".glbin";
+        return PathSS.str();
+    }
+
+    /// Reads the program binary with the given signature from the cache.
+
+    /// Returns false if there is no binary for the signature in the cache or if the
+    /// file was written for a different program or by a different driver.
+    bool ReadBinary(const ProgramSignature& Signature, ProgramBinary& Binary) const;
+
+    /// Writes the program binary to the cache.
+    bool WriteBinary(const ProgramSignature& Signature, const ProgramBinary& Binary) const;
+
+    /// Loads the program binary with the given signature into the program object using glProgramBinary().
+
+    /// Returns false if there is no binary for the signature in the cache. If the function returns true,
+    /// the caller must check GL_LINK_STATUS of the program as the driver may reject the binary.
+    bool Load(const ProgramSignature& Signature, GLuint GLProgram) const;
+
+    /// Retrieves the binary of the linked program and writes it to the cache.
+    void Store(const ProgramSignature& Signature, GLuint GLProgram) const;
+
+private:
+    static String GetGLString(GLenum Name)
+    {
+        const auto* Str = reinterpret_cast<const char*>(glGetString(Name));
+        return Str != nullptr ? String{Str} : String{};
+    }
+
+    // 64-bit FNV-1a hash. Unlike std::hash, the result does not depend on the
+    // standard library implementation or the target architecture.
+    static Uint64 ComputeFNV1aHash(const String& Str, Uint64 Hash = 0xcbf29ce484222325ull)
+    {
+        for (auto c : Str)
+        {
+            Hash ^= static_cast<Uint8>(c);
+            Hash *= 0x100000001b3ull;
+        }
+        return Hash;
+    }
+
+    const String m_CacheDir;
+    const String m_DriverId;
+};
+
+} // namespace Diligent
@@ -32,17 +32,19 @@
 //
 //       m_UniformBuffers        m_Samplers                 m_Images                   m_StorageBlocks
 //        |                       |                          |                          |                         |                  |
-//        |  UB[0]  ... UB[Nu-1]  |  Sam[0]  ...  Sam[Ns-1]  |  Img[0]  ...  Img[Ni-1]  |  SB[0]  ...  SB[Nsb-1]  |  Resource Names  |
+//        |  UB[0]  ... UB[Nu-1]  |  Sam[0]  ...  Sam[Ns-1]  |  Img[0]  ...  Img[Ni-1]  |  SB[0]  ...  SB[Nsb-1]  |
 //
 //  Nu  - number of uniform buffers
 //  Ns  - number of samplers
 //  Ni  - number of images
 //  Nsb - number of storage blocks
+//
+// Resource names are interned in the global StringInternTable and are shared by all programs.
 
 #include <vector>
 
 #include "Object.h"
-#include "StringPool.hpp"
+#include "StringInternTable.hpp"
 #include "HashUtils.hpp"
 #include "ShaderResourceVariableBase.hpp"
 
@@ -101,11 +103,11 @@ public:
         }
 
         GLResourceAttribs(const GLResourceAttribs& Attribs,
-                          StringPool&              NamesPool) noexcept :
+                          StringInternTable&       NamesTable) noexcept :
             // clang-format off
             GLResourceAttribs
             {
-                NamesPool.CopyString(Attribs.Name),
+                NamesTable.Intern(Attribs.Name).GetStr(),
                 Attribs.ShaderStages,
                 Attribs.ResourceType,
                 Attribs.Binding,
@@ -168,8 +170,8 @@ public:
         {}
 
         UniformBufferInfo(const UniformBufferInfo& UB,
-                          StringPool&              NamesPool)noexcept :
-            GLResourceAttribs{UB, NamesPool},
+                          StringInternTable&       NamesTable)noexcept :
+            GLResourceAttribs{UB, NamesTable},
             UBIndex          {UB.UBIndex   }
         {}
         // clang-format on
@@ -211,8 +213,8 @@ public:
         {}
 
         SamplerInfo(const SamplerInfo& Sam,
-                    StringPool&        NamesPool)noexcept :
-            GLResourceAttribs{Sam, NamesPool},
+                    StringInternTable& NamesTable)noexcept :
+            GLResourceAttribs{Sam, NamesTable},
             Location         {Sam.Location   },
             SamplerType      {Sam.SamplerType}
         {}
@@ -256,9 +258,9 @@ public:
             ImageType        {_ImageType}
         {}
 
-        ImageInfo(const ImageInfo& Img, 
-                  StringPool&      NamesPool)noexcept :
-            GLResourceAttribs{Img, NamesPool},
+        ImageInfo(const ImageInfo&   Img,
+                  StringInternTable& NamesTable)noexcept :
+            GLResourceAttribs{Img, NamesTable},
             Location         {Img.Location },
             ImageType        {Img.ImageType}
         {}
@@ -301,8 +303,8 @@ public:
         {}
 
         StorageBlockInfo(const StorageBlockInfo& SB,
-                         StringPool&             NamesPool)noexcept :
-            GLResourceAttribs{SB, NamesPool},
+                         StringInternTable&      NamesTable)noexcept :
+            GLResourceAttribs{SB, NamesTable},
             SBIndex          {SB.SBIndex}
         {}
 
@@ -492,7 +494,7 @@ private:
 
     // Memory layout:
     // 
-    //  |  Uniform buffers  |   Samplers  |   Images   |   Storage Blocks   |    String Pool Data   |
+    //  |  Uniform buffers  |   Samplers  |   Images   |   Storage Blocks   |
     //
 
     UniformBufferInfo*  m_UniformBuffers = nullptr;
@@ -500,7 +502,6 @@ private:
     ImageInfo*          m_Images         = nullptr;
     StorageBlockInfo*   m_StorageBlocks  = nullptr;
 
-    StringPool          m_StringPool;
 
     Uint32              m_NumUniformBuffers = 0;
     Uint32              m_NumSamplers       = 0;
@@ -1185,6 +1185,16 @@ extern PFNGLDRAWELEMENTSBASEVERTEXPROC glDrawElementsBaseVertex;
     typedef void (GL_APIENTRY* PFNGLDEBUGMESSAGECALLBACKPROC) (GLDEBUGPROC callback, const void *userParam);
     extern PFNGLDEBUGMESSAGECALLBACKPROC glDebugMessageCallback;
 
+    #define LOAD_DEBUG_GROUP_FUNCTIONS
+    typedef void (GL_APIENTRY* PFNGLPUSHDEBUGGROUPPROC) (GLenum source, GLuint id, GLsizei length, const GLchar *message);
+    extern PFNGLPUSHDEBUGGROUPPROC glPushDebugGroup;
+
+    typedef void (GL_APIENTRY* PFNGLPOPDEBUGGROUPPROC) (void);
+    extern PFNGLPOPDEBUGGROUPPROC glPopDebugGroup;
+
+    typedef void (GL_APIENTRY* PFNGLDEBUGMESSAGEINSERTPROC) (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *buf);
+    extern PFNGLDEBUGMESSAGEINSERTPROC glDebugMessageInsert;
+
 #endif
 
 void LoadGLFunctions();
@@ -34,6 +34,7 @@
 #include "BaseInterfacesGL.h"
 #include "FBOCache.hpp"
 #include "TexRegionRender.hpp"
+#include "GLProgramBinaryCache.hpp"
 
 enum class GPU_VENDOR
 {
@@ -139,6 +140,8 @@ public:
 
     const GPUInfo& GetGPUInfo() { return m_GPUInfo; }
 
+    bool CheckExtension(const Char* ExtensionString);
+
     FBOCache& GetFBOCache(GLContext::NativeGLContextType Context);
     void      OnReleaseTexture(ITexture* pTexture);
 
@@ -151,6 +154,13 @@ public:
 
     void InitTexRegionRender();
 
+    /// Returns the program binary cache or null if the cache is disabled or not supported.
+    GLProgramBinaryCache* GetProgramBinaryCache() { return m_pProgramBinaryCache.get(); }
+
+    /// Returns true if the driver compiles shaders and links programs in background threads
+    /// (GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile).
+    bool IsParallelShaderCompilationEnabled() const { return m_ParallelShaderCompilation; }
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -176,9 +186,12 @@ protected:
 
     std::unique_ptr<TexRegionRender> m_pTexRegionRender;
 
+    std::unique_ptr<GLProgramBinaryCache> m_pProgramBinaryCache;
+
+    bool m_ParallelShaderCompilation = false;
+
 private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
-    bool         CheckExtension(const Char* ExtensionString);
     void         FlagSupportedTexFormats();
     void         QueryDeviceCaps();
 };
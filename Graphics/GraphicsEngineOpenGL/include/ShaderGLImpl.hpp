@@ -27,12 +27,15 @@
 
 #pragma once
 
+#include <memory>
+
 #include "BaseInterfacesGL.h"
 #include "ShaderGL.h"
 #include "ShaderBase.hpp"
 #include "RenderDevice.h"
 #include "GLObjectWrapper.hpp"
 #include "RenderDeviceGLImpl.hpp"
+#include "GLProgramBinaryCache.hpp"
 #include "GLProgramResources.hpp"
 
 namespace Diligent
@@ -92,9 +95,51 @@ public:
     /// Implementation of IShader::GetResource() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDesc) const override final;
 
+    /// Program whose linking was started by BeginLinkProgram().
+    struct PendingProgram
+    {
+        GLObjectWrappers::GLProgramObj Program{false};
+
+        // Program signature in the binary cache, null if the cache is disabled
+        std::unique_ptr<GLProgramBinaryCache::ProgramSignature> pSignature;
+
+        bool IsSeparable     = false;
+        bool LoadedFromCache = false;
+    };
+
+    /// Starts linking the program. The program is loaded from the program binary cache when possible.
+
+    /// The function does not query the link status, so when the driver supports parallel shader
+    /// compilation, multiple programs can be compiled and linked in the background before
+    /// FinishLinkProgram() is called for each of them.
+    static PendingProgram BeginLinkProgram(IShader** ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
+
+    /// Waits for the program to be linked, reports errors and stores the program binary in the cache.
+    static GLObjectWrappers::GLProgramObj FinishLinkProgram(PendingProgram& Pending, IShader** ppShaders, Uint32 NumShaders);
+
     static GLObjectWrappers::GLProgramObj LinkProgram(IShader** ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
 
 private:
+    enum class CompileStatus : Uint8
+    {
+        NotCompiled,
+        Pending,
+        Succeeded
+    };
+
+    GLuint GetCompiledGLShader();
+    void   Compile();
+    void   CheckCompileStatus(IDataBlob** ppCompilerOutput);
+
+    static void AttachShadersAndLink(GLuint GLProg, IShader** ppShaders, Uint32 NumShaders);
+
+    // GLSL source is kept until the shader is successfully compiled. When the program binary
+    // cache is enabled, the source is kept for the lifetime of the shader as it identifies
+    // the programs in the cache, and the shader may never be compiled if all programs that
+    // use it are found in the cache.
+    String        m_GLSLSource;
+    CompileStatus m_CompileStatus = CompileStatus::NotCompiled;
+
     GLObjectWrappers::GLShaderObj m_GLShaderObj;
     GLProgramResources            m_Resources;
 };
@@ -72,7 +72,7 @@ DILIGENT_BEGIN_INTERFACE(IEngineFactoryOpenGL, IEngineFactory)
     VIRTUAL void METHOD(CreateDeviceAndSwapChainGL)(THIS_
                                                     const EngineGLCreateInfo REF EngineCI,
                                                     IRenderDevice**              ppDevice,
-                                                    IDeviceContext**             ppImmediateContext,
+                                                    IDeviceContext**             ppContexts,
                                                     const SwapChainDesc REF      SCDesc,
                                                     ISwapChain**                 ppSwapChain) PURE;
 
@@ -82,7 +82,7 @@ DILIGENT_BEGIN_INTERFACE(IEngineFactoryOpenGL, IEngineFactory)
     VIRTUAL void METHOD(AttachToActiveGLContext)(THIS_
                                                  const EngineGLCreateInfo REF EngineCI,
                                                  IRenderDevice**              ppDevice,
-                                                 IDeviceContext**             ppImmediateContext) PURE;
+                                                 IDeviceContext**             ppContexts) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -248,8 +248,27 @@ void BufferGLImpl::CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL,
     // the purposes of copying or staging data without disturbing OpenGL state or needing to keep track of
     // what was bound to the target before your copy.
     constexpr bool ResetVAO = false; // No need to reset VAO for READ/WRITE targets
-    CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, m_GlBuffer, ResetVAO);
-    CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.m_GlBuffer, ResetVAO);
+    if (m_DynamicAllocation.IsValid())
+    {
+        // Buffer contents live in the dynamic heap
+        CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, m_DynamicAllocation.pHeap->GetGLBuffer(), ResetVAO);
+        DstOffset += m_DynamicAllocation.Offset;
+    }
+    else
+    {
+        CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, m_GlBuffer, ResetVAO);
+    }
+
+    const auto& SrcDynAlloc = SrcBufferGL.m_DynamicAllocation;
+    if (SrcDynAlloc.IsValid())
+    {
+        CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcDynAlloc.pHeap->GetGLBuffer(), ResetVAO);
+        SrcOffset += SrcDynAlloc.Offset;
+    }
+    else
+    {
+        CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.m_GlBuffer, ResetVAO);
+    }
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, SrcOffset, DstOffset, Size);
     CHECK_GL_ERROR("glCopyBufferSubData() failed");
     CtxState.BindBuffer(GL_COPY_READ_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
@@ -0,0 +1,583 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <algorithm>
+
+#include "DeferredContextGLImpl.hpp"
+#include "CommandListGLImpl.hpp"
+#include "RenderDeviceGLImpl.hpp"
+#include "TextureViewGLImpl.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+DeferredContextGLImpl::DeferredContextGLImpl(IReferenceCounters* pRefCounters,
+                                             RenderDeviceGLImpl* pDeviceGL) :
+    // clang-format off
+    TDeviceContextBase
+    {
+        pRefCounters,
+        pDeviceGL,
+        true
+    },
+    m_CmdStreamChunkAllocator{GetRawAllocator(), GLCommandStream::ChunkSize, 16},
+    m_CmdListAllocator       {GetRawAllocator(), sizeof(CommandListGLImpl), 64},
+    m_CommandStream          {m_CmdStreamChunkAllocator}
+// clang-format on
+{
+    m_MappedBuffers.reserve(8);
+}
+
+IMPLEMENT_QUERY_INTERFACE(DeferredContextGLImpl, IID_DeviceContextGL, TDeviceContextBase)
+
+
+void DeferredContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
+{
+    auto* pPipelineStateGLImpl = ValidatedCast<PipelineStateGLImpl>(pPipelineState);
+    if (PipelineStateGLImpl::IsSameObject(m_pPipelineState, pPipelineStateGLImpl))
+        return;
+
+    TDeviceContextBase::SetPipelineState(pPipelineStateGLImpl, 0 /*Dummy*/);
+
+    auto& Cmd = m_CommandStream.AddCommand<GLCommands::SetPipelineState>();
+    Cmd.pPSO  = m_CommandStream.RetainObject(pPipelineState);
+}
+
+void DeferredContextGLImpl::TransitionShaderResources(IPipelineState* pPipelineState, IShaderResourceBinding* pShaderResourceBinding)
+{
+}
+
+void DeferredContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    // Redundant commits are not filtered out here as the immediate context may
+    // need to commit the resources again to execute pending memory barriers
+    if (!TDeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0))
+        return;
+
+    auto& Cmd = m_CommandStream.AddCommand<GLCommands::CommitShaderResources>();
+    Cmd.pSRB  = m_CommandStream.RetainObject(pShaderResourceBinding);
+    Cmd.Mode  = StateTransitionMode;
+}
+
+void DeferredContextGLImpl::SetStencilRef(Uint32 StencilRef)
+{
+    if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
+    {
+        m_CommandStream.AddCommand<GLCommands::SetStencilRef>().StencilRef = StencilRef;
+    }
+}
+
+void DeferredContextGLImpl::SetBlendFactors(const float* pBlendFactors)
+{
+    if (TDeviceContextBase::SetBlendFactors(pBlendFactors, 0))
+    {
+        m_CommandStream.AddCommand<GLCommands::SetBlendFactors>().pBlendFactors = m_CommandStream.CopyArray(pBlendFactors, 4);
+    }
+}
+
+void DeferredContextGLImpl::SetVertexBuffers(Uint32                         StartSlot,
+                                             Uint32                         NumBuffersSet,
+                                             IBuffer**                      ppBuffers,
+                                             Uint32*                        pOffsets,
+                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                             SET_VERTEX_BUFFERS_FLAGS       Flags)
+{
+    if (IsRedundantVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags))
+        return;
+
+    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+
+    auto& Cmd      = m_CommandStream.AddCommand<GLCommands::SetVertexBuffers>();
+    Cmd.StartSlot  = StartSlot;
+    Cmd.NumBuffers = NumBuffersSet;
+    Cmd.ppBuffers  = m_CommandStream.CopyArray(ppBuffers, NumBuffersSet);
+    Cmd.pOffsets   = m_CommandStream.CopyArray(pOffsets, NumBuffersSet);
+    Cmd.Mode       = StateTransitionMode;
+    Cmd.Flags      = Flags;
+    if (Cmd.ppBuffers != nullptr)
+    {
+        for (Uint32 i = 0; i < NumBuffersSet; ++i)
+            m_CommandStream.RetainObject(Cmd.ppBuffers[i]);
+    }
+}
+
+void DeferredContextGLImpl::InvalidateState()
+{
+    TDeviceContextBase::InvalidateState();
+    m_CommandStream.AddCommand<GLCommands::InvalidateState>();
+}
+
+void DeferredContextGLImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (IsRedundantIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode))
+        return;
+
+    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+
+    auto& Cmd      = m_CommandStream.AddCommand<GLCommands::SetIndexBuffer>();
+    Cmd.pBuffer    = m_CommandStream.RetainObject(pIndexBuffer);
+    Cmd.ByteOffset = ByteOffset;
+    Cmd.Mode       = StateTransitionMode;
+}
+
+void DeferredContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
+{
+    if (IsRedundantViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
+
+    // Base implementation resolves default viewport and render target size from the
+    // currently bound render targets, which will be the same when the commands are executed
+    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+
+    auto& Cmd        = m_CommandStream.AddCommand<GLCommands::SetViewports>();
+    Cmd.NumViewports = m_NumViewports;
+    Cmd.pViewports   = m_CommandStream.CopyArray(m_Viewports, m_NumViewports);
+    Cmd.RTWidth      = RTWidth;
+    Cmd.RTHeight     = RTHeight;
+}
+
+void DeferredContextGLImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
+{
+    if (IsRedundantScissorRects(NumRects, pRects))
+        return;
+
+    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+
+    auto& Cmd    = m_CommandStream.AddCommand<GLCommands::SetScissorRects>();
+    Cmd.NumRects = m_NumScissorRects;
+    Cmd.pRects   = m_CommandStream.CopyArray(m_ScissorRects, m_NumScissorRects);
+    Cmd.RTWidth  = RTWidth;
+    Cmd.RTHeight = RTHeight;
+}
+
+void DeferredContextGLImpl::SetRenderTargets(Uint32                         NumRenderTargets,
+                                             ITextureView*                  ppRenderTargets[],
+                                             ITextureView*                  pDepthStencil,
+                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (!TDeviceContextBase::SetRenderTargets(NumRenderTargets, ppRenderTargets, pDepthStencil))
+        return;
+
+    auto& Cmd            = m_CommandStream.AddCommand<GLCommands::SetRenderTargets>();
+    Cmd.NumRenderTargets = NumRenderTargets;
+    Cmd.ppRenderTargets  = m_CommandStream.CopyArray(ppRenderTargets, NumRenderTargets);
+    Cmd.pDepthStencil    = m_CommandStream.RetainObject(pDepthStencil);
+    Cmd.Mode             = StateTransitionMode;
+    if (Cmd.ppRenderTargets != nullptr)
+    {
+        for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
+            m_CommandStream.RetainObject(Cmd.ppRenderTargets[rt]);
+    }
+}
+
+void DeferredContextGLImpl::Draw(const DrawAttribs& Attribs)
+{
+    if (!DvpVerifyDrawArguments(Attribs))
+        return;
+
+    m_CommandStream.AddCommand<GLCommands::Draw>().Attribs = Attribs;
+}
+
+void DeferredContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
+{
+    if (!DvpVerifyDrawIndexedArguments(Attribs))
+        return;
+
+    m_CommandStream.AddCommand<GLCommands::DrawIndexed>().Attribs = Attribs;
+}
+
+void DeferredContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    auto& Cmd          = m_CommandStream.AddCommand<GLCommands::DrawIndirect>();
+    Cmd.Attribs        = Attribs;
+    Cmd.pAttribsBuffer = m_CommandStream.RetainObject(pAttribsBuffer);
+}
+
+void DeferredContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyDrawIndexedIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    auto& Cmd          = m_CommandStream.AddCommand<GLCommands::DrawIndexedIndirect>();
+    Cmd.Attribs        = Attribs;
+    Cmd.pAttribsBuffer = m_CommandStream.RetainObject(pAttribsBuffer);
+}
+
+void DeferredContextGLImpl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyMultiDrawIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    auto& Cmd          = m_CommandStream.AddCommand<GLCommands::MultiDrawIndirect>();
+    Cmd.Attribs        = Attribs;
+    Cmd.pAttribsBuffer = m_CommandStream.RetainObject(pAttribsBuffer);
+    m_CommandStream.RetainObject(Attribs.pCountBuffer);
+}
+
+void DeferredContextGLImpl::MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyMultiDrawIndexedIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    auto& Cmd          = m_CommandStream.AddCommand<GLCommands::MultiDrawIndexedIndirect>();
+    Cmd.Attribs        = Attribs;
+    Cmd.pAttribsBuffer = m_CommandStream.RetainObject(pAttribsBuffer);
+    m_CommandStream.RetainObject(Attribs.pCountBuffer);
+}
+
+void DeferredContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
+{
+    if (!DvpVerifyDispatchArguments(Attribs))
+        return;
+
+    m_CommandStream.AddCommand<GLCommands::DispatchCompute>().Attribs = Attribs;
+}
+
+void DeferredContextGLImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyDispatchIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    auto& Cmd          = m_CommandStream.AddCommand<GLCommands::DispatchComputeIndirect>();
+    Cmd.Attribs        = Attribs;
+    Cmd.pAttribsBuffer = m_CommandStream.RetainObject(pAttribsBuffer);
+}
+
+void DeferredContextGLImpl::ClearDepthStencil(ITextureView*                  pView,
+                                              CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
+                                              float                          fDepth,
+                                              Uint8                          Stencil,
+                                              RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (!TDeviceContextBase::ClearDepthStencil(pView))
+        return;
+
+    auto& Cmd      = m_CommandStream.AddCommand<GLCommands::ClearDepthStencil>();
+    Cmd.pView      = m_CommandStream.RetainObject(pView);
+    Cmd.ClearFlags = ClearFlags;
+    Cmd.fDepth     = fDepth;
+    Cmd.Stencil    = Stencil;
+    Cmd.Mode       = StateTransitionMode;
+}
+
+void DeferredContextGLImpl::ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (!TDeviceContextBase::ClearRenderTarget(pView))
+        return;
+
+    auto& Cmd = m_CommandStream.AddCommand<GLCommands::ClearRenderTarget>();
+    Cmd.pView = m_CommandStream.RetainObject(pView);
+    Cmd.RGBA  = m_CommandStream.CopyArray(RGBA, 4);
+    Cmd.Mode  = StateTransitionMode;
+}
+
+void DeferredContextGLImpl::UpdateBuffer(IBuffer*                       pBuffer,
+                                         Uint32                         Offset,
+                                         Uint32                         Size,
+                                         const void*                    pData,
+                                         RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    TDeviceContextBase::UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
+
+    auto& Cmd   = m_CommandStream.AddCommand<GLCommands::UpdateBuffer>();
+    Cmd.pBuffer = m_CommandStream.RetainObject(pBuffer);
+    Cmd.Offset  = Offset;
+    Cmd.Size    = Size;
+    Cmd.pData   = m_CommandStream.CopyArray(static_cast<const Uint8*>(pData), Size);
+    Cmd.Mode    = StateTransitionMode;
+}
+
+void DeferredContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
+                                       Uint32                         SrcOffset,
+                                       RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+                                       IBuffer*                       pDstBuffer,
+                                       Uint32                         DstOffset,
+                                       Uint32                         Size,
+                                       RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
+{
+    TDeviceContextBase::CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
+
+    auto& Cmd      = m_CommandStream.AddCommand<GLCommands::CopyBuffer>();
+    Cmd.pSrcBuffer = m_CommandStream.RetainObject(pSrcBuffer);
+    Cmd.SrcOffset  = SrcOffset;
+    Cmd.SrcMode    = SrcBufferTransitionMode;
+    Cmd.pDstBuffer = m_CommandStream.RetainObject(pDstBuffer);
+    Cmd.DstOffset  = DstOffset;
+    Cmd.Size       = Size;
+    Cmd.DstMode    = DstBufferTransitionMode;
+}
+
+void DeferredContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
+{
+    TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
+
+    const auto& BuffDesc = pBuffer->GetDesc();
+    if (MapType != MAP_WRITE || BuffDesc.Usage != USAGE_DYNAMIC || (MapFlags & MAP_FLAG_DISCARD) == 0)
+    {
+        LOG_ERROR_MESSAGE("Failed to map buffer '", BuffDesc.Name, "': deferred contexts in OpenGL backend can only map dynamic buffers for writing with MAP_FLAG_DISCARD flag");
+        return;
+    }
+
+    // The data is written to the stream memory and copied to the buffer when the command list is executed
+    pMappedData = m_CommandStream.AllocateData(BuffDesc.uiSizeInBytes, 16);
+    m_MappedBuffers.emplace_back(pBuffer, pMappedData);
+}
+
+void DeferredContextGLImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
+{
+    TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
+
+    auto MappedBufferIt = std::find_if(m_MappedBuffers.begin(), m_MappedBuffers.end(),
+                                       [pBuffer](const std::pair<IBuffer*, void*>& MappedBuffer) {
+                                           return MappedBuffer.first == pBuffer;
+                                       });
+    if (MappedBufferIt == m_MappedBuffers.end())
+    {
+        LOG_ERROR_MESSAGE("Buffer '", pBuffer->GetDesc().Name, "' has not been mapped by this deferred context");
+        return;
+    }
+
+    auto& Cmd   = m_CommandStream.AddCommand<GLCommands::WriteDynamicBuffer>();
+    Cmd.pBuffer = m_CommandStream.RetainObject(pBuffer);
+    Cmd.pData   = MappedBufferIt->second;
+    Cmd.Size    = pBuffer->GetDesc().uiSizeInBytes;
+    m_MappedBuffers.erase(MappedBufferIt);
+}
+
+void DeferredContextGLImpl::UpdateTexture(ITexture*                      pTexture,
+                                          Uint32                         MipLevel,
+                                          Uint32                         Slice,
+                                          const Box&                     DstBox,
+                                          const TextureSubResData&       SubresData,
+                                          RESOURCE_STATE_TRANSITION_MODE SrcBufferStateTransitionMode,
+                                          RESOURCE_STATE_TRANSITION_MODE TextureStateTransitionMode)
+{
+    TDeviceContextBase::UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, SrcBufferStateTransitionMode, TextureStateTransitionMode);
+
+    auto& Cmd         = m_CommandStream.AddCommand<GLCommands::UpdateTexture>();
+    Cmd.pTexture      = m_CommandStream.RetainObject(pTexture);
+    Cmd.MipLevel      = MipLevel;
+    Cmd.Slice         = Slice;
+    Cmd.DstBox        = DstBox;
+    Cmd.SubresData    = SubresData;
+    Cmd.SrcBufferMode = SrcBufferStateTransitionMode;
+    Cmd.TextureMode   = TextureStateTransitionMode;
+
+    if (SubresData.pSrcBuffer != nullptr)
+    {
+        m_CommandStream.RetainObject(SubresData.pSrcBuffer);
+        return;
+    }
+
+    // Copy the rows of the update region to the stream memory
+    const auto& FmtAttribs = GetTextureFormatAttribs(pTexture->GetDesc().Format);
+
+    size_t RowSize  = 0;
+    Uint32 RowCount = 0;
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+    {
+        RowSize  = size_t{(DstBox.MaxX - DstBox.MinX + FmtAttribs.BlockWidth - 1u) / FmtAttribs.BlockWidth} * FmtAttribs.ComponentSize;
+        RowCount = (DstBox.MaxY - DstBox.MinY + FmtAttribs.BlockHeight - 1u) / FmtAttribs.BlockHeight;
+    }
+    else
+    {
+        RowSize  = size_t{DstBox.MaxX - DstBox.MinX} * FmtAttribs.ComponentSize * FmtAttribs.NumComponents;
+        RowCount = DstBox.MaxY - DstBox.MinY;
+    }
+    const Uint32 DepthSlices = DstBox.MaxZ - DstBox.MinZ;
+
+    // Pixel unpack alignment is 4 in OpenGL backend, so rows that are not 4-byte aligned keep the original stride
+    const size_t DstStride      = (RowSize % 4 == 0) ? RowSize : size_t{SubresData.Stride};
+    const size_t DstDepthStride = DstStride * RowCount;
+
+    auto* pDstData = reinterpret_cast<Uint8*>(m_CommandStream.AllocateData(DstDepthStride * DepthSlices, 16));
+    for (Uint32 z = 0; z < DepthSlices; ++z)
+    {
+        for (Uint32 row = 0; row < RowCount; ++row)
+        {
+            const auto* pSrcRow = reinterpret_cast<const Uint8*>(SubresData.pData) + z * SubresData.DepthStride + row * SubresData.Stride;
+            memcpy(pDstData + z * DstDepthStride + row * DstStride, pSrcRow, RowSize);
+        }
+    }
+    Cmd.SubresData.pData       = pDstData;
+    Cmd.SubresData.Stride      = static_cast<Uint32>(DstStride);
+    Cmd.SubresData.DepthStride = static_cast<Uint32>(DstDepthStride);
+}
+
+void DeferredContextGLImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
+{
+    TDeviceContextBase::CopyTexture(CopyAttribs);
+
+    auto& Cmd           = m_CommandStream.AddCommand<GLCommands::CopyTexture>();
+    Cmd.Attribs         = CopyAttribs;
+    Cmd.Attribs.pSrcBox = m_CommandStream.CopyArray(CopyAttribs.pSrcBox, 1);
+    m_CommandStream.RetainObject(CopyAttribs.pSrcTexture);
+    m_CommandStream.RetainObject(CopyAttribs.pDstTexture);
+}
+
+void DeferredContextGLImpl::MapTextureSubresource(ITexture*                 pTexture,
+                                                  Uint32                    MipLevel,
+                                                  Uint32                    ArraySlice,
+                                                  MAP_TYPE                  MapType,
+                                                  MAP_FLAGS                 MapFlags,
+                                                  const Box*                pMapRegion,
+                                                  MappedTextureSubresource& MappedData)
+{
+    TDeviceContextBase::MapTextureSubresource(pTexture, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
+    LOG_ERROR_MESSAGE("Texture mapping is not supported by deferred contexts in OpenGL backend");
+    MappedData = MappedTextureSubresource{};
+}
+
+void DeferredContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 MipLevel, Uint32 ArraySlice)
+{
+    TDeviceContextBase::UnmapTextureSubresource(pTexture, MipLevel, ArraySlice);
+    LOG_ERROR_MESSAGE("Texture mapping is not supported by deferred contexts in OpenGL backend");
+}
+
+void DeferredContextGLImpl::GenerateMips(ITextureView* pTexView)
+{
+    TDeviceContextBase::GenerateMips(pTexView);
+    m_CommandStream.AddCommand<GLCommands::GenerateMips>().pView = m_CommandStream.RetainObject(pTexView);
+}
+
+void DeferredContextGLImpl::FinishFrame()
+{
+    // Recorded commands keep their own references to the objects
+    FrameRetainedObjects::ObjectList RetainedObjects;
+    ExtractFrameRetainedObjects(RetainedObjects);
+}
+
+void DeferredContextGLImpl::TransitionResourceStates(Uint32 BarrierCount, StateTransitionDesc* pResourceBarriers)
+{
+}
+
+void DeferredContextGLImpl::ResolveTextureSubresource(ITexture*                               pSrcTexture,
+                                                      ITexture*                               pDstTexture,
+                                                      const ResolveTextureSubresourceAttribs& ResolveAttribs)
+{
+    TDeviceContextBase::ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
+
+    auto& Cmd       = m_CommandStream.AddCommand<GLCommands::ResolveTextureSubresource>();
+    Cmd.pSrcTexture = m_CommandStream.RetainObject(pSrcTexture);
+    Cmd.pDstTexture = m_CommandStream.RetainObject(pDstTexture);
+    Cmd.Attribs     = ResolveAttribs;
+}
+
+void DeferredContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
+{
+    if (!TDeviceContextBase::BeginDebugGroup(Name, 0))
+        return;
+
+    auto& Cmd  = m_CommandStream.AddCommand<GLCommands::BeginDebugGroup>();
+    Cmd.Name   = m_CommandStream.CopyString(Name);
+    Cmd.pColor = m_CommandStream.CopyArray(pColor, 4);
+}
+
+void DeferredContextGLImpl::EndDebugGroup()
+{
+    if (!TDeviceContextBase::EndDebugGroup(0))
+        return;
+
+    m_CommandStream.AddCommand<GLCommands::EndDebugGroup>();
+}
+
+void DeferredContextGLImpl::InsertDebugLabel(const Char* Label, const float* pColor)
+{
+    VERIFY(Label != nullptr, "Label must not be null");
+
+    auto& Cmd  = m_CommandStream.AddCommand<GLCommands::InsertDebugLabel>();
+    Cmd.Label  = m_CommandStream.CopyString(Label);
+    Cmd.pColor = m_CommandStream.CopyArray(pColor, 4);
+}
+
+void DeferredContextGLImpl::FinishCommandList(class ICommandList** ppCommandList)
+{
+    DEV_CHECK_ERR(m_MappedBuffers.empty(), "All buffers mapped by the deferred context must be unmapped before the command list is finished");
+
+    CommandListGLImpl* pCmdListGL(NEW_RC_OBJ(m_CmdListAllocator, "CommandListGLImpl instance", CommandListGLImpl)(m_pDevice, this, std::move(m_CommandStream)));
+    pCmdListGL->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
+
+    m_MappedBuffers.clear();
+
+    // Only reset the cached state as there are no commands to invalidate the state for
+    TDeviceContextBase::InvalidateState();
+}
+
+void DeferredContextGLImpl::ExecuteCommandList(class ICommandList* pCommandList)
+{
+    LOG_ERROR_MESSAGE("Only immediate context can execute command list");
+}
+
+void DeferredContextGLImpl::SignalFence(IFence* pFence, Uint64 Value)
+{
+    LOG_ERROR_MESSAGE("Fence can only be signaled from immediate context");
+}
+
+void DeferredContextGLImpl::WaitForFence(IFence* pFence, Uint64 Value, bool FlushContext)
+{
+    LOG_ERROR_MESSAGE("Fence can only be waited from immediate context");
+}
+
+void DeferredContextGLImpl::WaitForIdle()
+{
+    LOG_ERROR_MESSAGE("Only immediate contexts can be idled");
+}
+
+void DeferredContextGLImpl::BeginQuery(IQuery* pQuery)
+{
+    // Base implementation reports the error
+    TDeviceContextBase::BeginQuery(pQuery, 0);
+}
+
+void DeferredContextGLImpl::EndQuery(IQuery* pQuery)
+{
+    TDeviceContextBase::EndQuery(pQuery, 0);
+}
+
+void DeferredContextGLImpl::Flush()
+{
+    LOG_ERROR_MESSAGE("Flush() should only be called for immediate contexts");
+}
+
+bool DeferredContextGLImpl::UpdateCurrentGLContext()
+{
+    LOG_ERROR_MESSAGE("Deferred contexts are not associated with a GL context");
+    return false;
+}
+
+void DeferredContextGLImpl::SetSwapChain(ISwapChainGL* pSwapChain)
+{
+    LOG_ERROR_MESSAGE("Swap chain can only be set for immediate context");
+}
+
+} // namespace Diligent
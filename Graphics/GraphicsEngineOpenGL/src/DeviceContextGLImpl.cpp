@@ -49,13 +49,31 @@
 #include "PipelineStateGLImpl.hpp"
 #include "FenceGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
+#include "CommandListGLImpl.hpp"
 
 using namespace std;
 
 namespace Diligent
 {
 
-DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters* pRefCounters, class RenderDeviceGLImpl* pDeviceGL, bool bIsDeferred) :
+static bool AreDebugGroupsSupported(RenderDeviceGLImpl& DeviceGL)
+{
+#if PLATFORM_IOS
+    return false;
+#else
+    const auto& DeviceCaps = DeviceGL.GetDeviceCaps();
+    if (DeviceCaps.DevType == RENDER_DEVICE_TYPE_GL && (DeviceCaps.MajorVersion > 4 || (DeviceCaps.MajorVersion == 4 && DeviceCaps.MinorVersion >= 3)))
+        return true;
+    if (DeviceCaps.DevType == RENDER_DEVICE_TYPE_GLES && (DeviceCaps.MajorVersion > 3 || (DeviceCaps.MajorVersion == 3 && DeviceCaps.MinorVersion >= 2)))
+        return true;
+    return DeviceGL.CheckExtension("GL_KHR_debug");
+#endif
+}
+
+DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters*       pRefCounters,
+                                         RenderDeviceGLImpl*       pDeviceGL,
+                                         bool                      bIsDeferred,
+                                         const EngineGLCreateInfo& EngineCI) :
     // clang-format off
     TDeviceContextBase
     {
@@ -65,11 +83,31 @@ DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters* pRefCounters, class
     },
     m_ContextState                       {pDeviceGL},
     m_CommitedResourcesTentativeBarriers {0        },
-    m_DefaultFBO                         {false    }
+    m_DefaultFBO                         {false    },
+    m_DebugGroupsSupported               {AreDebugGroupsSupported(*pDeviceGL)}
 // clang-format on
 {
     m_BoundWritableTextures.reserve(16);
     m_BoundWritableBuffers.reserve(16);
+
+    if (EngineCI.DynamicHeapSize != 0)
+    {
+        if (GLDynamicHeap::IsSupported(*pDeviceGL))
+        {
+            try
+            {
+                m_DynamicHeap.reset(new GLDynamicHeap{m_ContextState, EngineCI.DynamicHeapSize});
+            }
+            catch (const std::runtime_error&)
+            {
+                LOG_WARNING_MESSAGE("Failed to create dynamic heap. Dynamic buffers will be updated through buffer orphaning.");
+            }
+        }
+        else
+        {
+            LOG_INFO_MESSAGE("Persistently mapped buffers are not supported by the device. Dynamic buffers will be updated through buffer orphaning.");
+        }
+    }
 }
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceContextBase)
@@ -151,6 +189,11 @@ void DeviceContextGLImpl::TransitionShaderResources(IPipelineState* pPipelineSta
 
 void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    // Resources stay bound to the GL context, but pending memory barriers
+    // may only be executed when the resources are bound again
+    if (m_ContextState.GetPendingMemoryBarriers() == 0 && IsRedundantShaderResourceCommit(pShaderResourceBinding, StateTransitionMode))
+        return;
+
     if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0))
         return;
 
@@ -187,6 +230,9 @@ void DeviceContextGLImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsRedundantVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     m_ContextState.InvalidateVAO();
 }
@@ -198,17 +244,25 @@ void DeviceContextGLImpl::InvalidateState()
     m_ContextState.Invalidate();
     m_BoundWritableTextures.clear();
     m_BoundWritableBuffers.clear();
+    m_CommittedDynamicUBs.clear();
+    m_DynamicUBsDirty   = false;
     m_IsDefaultFBOBound = false;
 }
 
 void DeviceContextGLImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsRedundantIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsRedundantViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
+
     TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
 
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
@@ -272,6 +326,9 @@ void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pVie
 
 void DeviceContextGLImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsRedundantScissorRects(NumRects, pRects))
+        return;
+
     TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
 
     VERIFY(NumRects == m_NumScissorRects, "Unexpected number of scissor rects");
@@ -364,6 +421,7 @@ void DeviceContextGLImpl::CommitRenderTargets()
         // Binding a new framebuffer will NOT affect the mask.
         m_ContextState.BindFBO(FBO);
     }
+    UpdateStats(&DeviceContextStats::NumRenderPasses);
     // Set the viewport to match the render target size
     SetViewports(1, nullptr, 0, 0);
 }
@@ -424,8 +482,19 @@ void DeviceContextGLImpl::BindProgramResources(Uint32& NewMemoryBarriers, IShade
     VERIFY_EXPR(m_BoundWritableTextures.empty());
     VERIFY_EXPR(m_BoundWritableBuffers.empty());
 
-    for (Uint32 ub = 0; ub < ResourceCache.GetUBCount(); ++ub)
+    // Uniform buffers, textures, samplers and storage blocks are collected into arrays first
+    // and then bound by the context state with as few multi-bind calls as possible
+    m_CommittedDynamicUBs.clear();
+    m_DynamicUBsDirty = false;
+
+    const auto NumUBs = ResourceCache.GetUBCount();
+    m_MultiBindBuffers.resize(NumUBs);
+    m_MultiBindOffsets.resize(NumUBs);
+    m_MultiBindSizes.resize(NumUBs);
+    for (Uint32 ub = 0; ub < NumUBs; ++ub)
     {
+        m_MultiBindBuffers[ub] = nullptr;
+
         const auto& UB = ResourceCache.GetConstUB(ub);
         if (!UB.pBuffer)
             continue;
@@ -436,12 +505,40 @@ void DeviceContextGLImpl::BindProgramResources(Uint32& NewMemoryBarriers, IShade
                                     // will reflect data written by shaders prior to the barrier
             m_ContextState);
 
-        m_ContextState.BindUniformBuffer(ub, pBufferGL->m_GlBuffer);
-        //glBindBufferRange(GL_UNIFORM_BUFFER, it->Index, pBufferGL->m_GlBuffer, 0, pBufferGL->GetDesc().uiSizeInBytes);
-    }
+        if (m_DynamicHeap && pBufferGL->IsDynamicHeapCompatible())
+            m_CommittedDynamicUBs.emplace_back(ub, pBufferGL);
 
-    for (Uint32 s = 0; s < ResourceCache.GetSamplerCount(); ++s)
+        const auto& DynAlloc = pBufferGL->GetDynamicAllocation();
+        if (DynAlloc.IsValid())
+        {
+#ifdef DILIGENT_DEVELOPMENT
+            DEV_CHECK_ERR(DynAlloc.dvpFrameNumber == DynAlloc.pHeap->GetFrameNumber(),
+                          "Dynamic buffer '", pBufferGL->GetDesc().Name, "' was last mapped in frame ", DynAlloc.dvpFrameNumber,
+                          ", but current frame is ", DynAlloc.pHeap->GetFrameNumber(), ". Dynamic buffers allocated in the dynamic heap must be mapped in every frame they are used.");
+#endif
+            m_MultiBindBuffers[ub] = &DynAlloc.pHeap->GetGLBuffer();
+            m_MultiBindOffsets[ub] = DynAlloc.Offset;
+            m_MultiBindSizes[ub]   = DynAlloc.Size;
+        }
+        else
+        {
+            m_MultiBindBuffers[ub] = &pBufferGL->m_GlBuffer;
+            m_MultiBindOffsets[ub] = 0;
+            m_MultiBindSizes[ub]   = pBufferGL->GetDesc().uiSizeInBytes;
+        }
+    }
+    if (NumUBs != 0)
+        m_ContextState.BindUniformBuffers(0, NumUBs, m_MultiBindBuffers.data(), m_MultiBindOffsets.data(), m_MultiBindSizes.data());
+
+    const auto NumSamplers = ResourceCache.GetSamplerCount();
+    m_MultiBindTextures.resize(NumSamplers);
+    m_MultiBindTexTargets.resize(NumSamplers);
+    m_MultiBindSamplers.resize(NumSamplers);
+    for (Uint32 s = 0; s < NumSamplers; ++s)
     {
+        m_MultiBindTextures[s] = nullptr;
+        m_MultiBindSamplers[s] = nullptr;
+
         const auto& Sam = ResourceCache.GetConstSampler(s);
         if (!Sam.pView)
             continue;
@@ -452,7 +549,8 @@ void DeviceContextGLImpl::BindProgramResources(Uint32& NewMemoryBarriers, IShade
             auto* pTexViewGL = Sam.pView.RawPtr<TextureViewGLImpl>();
             auto* pTextureGL = ValidatedCast<TextureBaseGL>(Sam.pTexture);
             VERIFY_EXPR(pTextureGL == pTexViewGL->GetTexture());
-            m_ContextState.BindTexture(s, pTexViewGL->GetBindTarget(), pTexViewGL->GetHandle());
+            m_MultiBindTextures[s]   = &pTexViewGL->GetHandle();
+            m_MultiBindTexTargets[s] = pTexViewGL->GetBindTarget();
 
             pTextureGL->TextureMemoryBarrier(
                 GL_TEXTURE_FETCH_BARRIER_BIT, // Texture fetches from shaders, including fetches from buffer object
@@ -460,14 +558,7 @@ void DeviceContextGLImpl::BindProgramResources(Uint32& NewMemoryBarriers, IShade
                                               // written by shaders prior to the barrier
                 m_ContextState);
 
-            if (Sam.pSampler)
-            {
-                m_ContextState.BindSampler(s, Sam.pSampler->GetHandle());
-            }
-            else
-            {
-                m_ContextState.BindSampler(s, GLObjectWrappers::GLSamplerObj(false));
-            }
+            m_MultiBindSamplers[s] = Sam.pSampler ? &Sam.pSampler->GetHandle() : &m_NullSampler;
         }
         else if (Sam.pBuffer != nullptr)
         {
@@ -475,8 +566,9 @@ void DeviceContextGLImpl::BindProgramResources(Uint32& NewMemoryBarriers, IShade
             auto* pBufferGL  = ValidatedCast<BufferGLImpl>(Sam.pBuffer);
             VERIFY_EXPR(pBufferGL == pBufViewGL->GetBuffer());
 
-            m_ContextState.BindTexture(s, GL_TEXTURE_BUFFER, pBufViewGL->GetTexBufferHandle());
-            m_ContextState.BindSampler(s, GLObjectWrappers::GLSamplerObj(false)); // Use default texture sampling parameters
+            m_MultiBindTextures[s]   = &pBufViewGL->GetTexBufferHandle();
+            m_MultiBindTexTargets[s] = GL_TEXTURE_BUFFER;
+            m_MultiBindSamplers[s]   = &m_NullSampler; // Use default texture sampling parameters
 
             pBufferGL->BufferMemoryBarrier(
                 GL_TEXTURE_FETCH_BARRIER_BIT, // Texture fetches from shaders, including fetches from buffer object
@@ -485,6 +577,11 @@ void DeviceContextGLImpl::BindProgramResources(Uint32& NewMemoryBarriers, IShade
                 m_ContextState);
         }
     }
+    if (NumSamplers != 0)
+    {
+        m_ContextState.BindTextures(0, NumSamplers, m_MultiBindTextures.data(), m_MultiBindTexTargets.data());
+        m_ContextState.BindSamplers(0, NumSamplers, m_MultiBindSamplers.data());
+    }
 
 #if GL_ARB_shader_image_load_store
     for (Uint32 img = 0; img < ResourceCache.GetImageCount(); ++img)
@@ -575,11 +672,17 @@ void DeviceContextGLImpl::BindProgramResources(Uint32& NewMemoryBarriers, IShade
 
 
 #if GL_ARB_shader_storage_buffer_object
-    for (Uint32 ssbo = 0; ssbo < ResourceCache.GetSSBOCount(); ++ssbo)
+    const auto NumSSBOs = ResourceCache.GetSSBOCount();
+    m_MultiBindBuffers.resize(NumSSBOs);
+    m_MultiBindOffsets.resize(NumSSBOs);
+    m_MultiBindSizes.resize(NumSSBOs);
+    for (Uint32 ssbo = 0; ssbo < NumSSBOs; ++ssbo)
     {
+        m_MultiBindBuffers[ssbo] = nullptr;
+
         const auto& SSBO = ResourceCache.GetConstSSBO(ssbo);
         if (!SSBO.pBufferView)
-            return;
+            continue;
 
         auto*       pBufferViewGL = SSBO.pBufferView.RawPtr<BufferViewGLImpl>();
         const auto& ViewDesc      = pBufferViewGL->GetDesc();
@@ -591,11 +694,15 @@ void DeviceContextGLImpl::BindProgramResources(Uint32& NewMemoryBarriers, IShade
                                            // will reflect writes prior to the barrier
             m_ContextState);
 
-        m_ContextState.BindStorageBlock(ssbo, pBufferGL->m_GlBuffer, ViewDesc.ByteOffset, ViewDesc.ByteWidth);
+        m_MultiBindBuffers[ssbo] = &pBufferGL->m_GlBuffer;
+        m_MultiBindOffsets[ssbo] = ViewDesc.ByteOffset;
+        m_MultiBindSizes[ssbo]   = ViewDesc.ByteWidth;
 
         if (ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS)
             m_BoundWritableBuffers.push_back(pBufferGL);
     }
+    if (NumSSBOs != 0)
+        m_ContextState.BindStorageBlocks(0, NumSSBOs, m_MultiBindBuffers.data(), m_MultiBindOffsets.data(), m_MultiBindSizes.data());
 #endif
 
 
@@ -662,6 +769,7 @@ void DeviceContextGLImpl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenu
 #endif
 
     m_pPipelineState->CommitProgram(m_ContextState);
+    BindDynamicUniformBuffers();
 
     auto        CurrNativeGLContext = m_pDevice->m_GLContext.GetCurrentNativeGLContext();
     const auto& PipelineDesc        = m_pPipelineState->GetDesc().GraphicsPipeline;
@@ -701,6 +809,29 @@ void DeviceContextGLImpl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenu
     }
 }
 
+void DeviceContextGLImpl::PrepareForDispatch()
+{
+    m_pPipelineState->CommitProgram(m_ContextState);
+    BindDynamicUniformBuffers();
+}
+
+void DeviceContextGLImpl::BindDynamicUniformBuffers()
+{
+    if (!m_DynamicUBsDirty)
+        return;
+
+    for (const auto& UB : m_CommittedDynamicUBs)
+    {
+        // The context state skips the slots whose buffer range has not changed
+        const auto& DynAlloc = UB.pBuffer->GetDynamicAllocation();
+        if (DynAlloc.IsValid())
+            m_ContextState.BindUniformBuffer(UB.Slot, DynAlloc.pHeap->GetGLBuffer(), DynAlloc.Offset, DynAlloc.Size);
+        else
+            m_ContextState.BindUniformBuffer(UB.Slot, UB.pBuffer->m_GlBuffer, 0, UB.pBuffer->GetDesc().uiSizeInBytes);
+    }
+    m_DynamicUBsDirty = false;
+}
+
 void DeviceContextGLImpl::PrepareForIndexedDraw(VALUE_TYPE IndexType, Uint32 FirstIndexLocation, GLenum& GLIndexType, Uint32& FirstIndexByteOffset)
 {
     GLIndexType = TypeToGLType(IndexType);
@@ -718,6 +849,8 @@ void DeviceContextGLImpl::PostDraw()
     // AFTER the actual draw/dispatch command is executed.
     m_ContextState.SetPendingMemoryBarriers(m_CommitedResourcesTentativeBarriers);
     m_CommitedResourcesTentativeBarriers = 0;
+
+    UpdateStats(&DeviceContextStats::NumBarriers, m_ContextState.ExtractNumExecutedMemoryBarriers());
 }
 
 void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
@@ -740,6 +873,7 @@ void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
         glDrawArrays(GlTopology, Attribs.StartVertexLocation, Attribs.NumVertices);
     }
     DEV_CHECK_GL_ERROR("OpenGL draw command failed");
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
 
     PostDraw();
 }
@@ -785,6 +919,7 @@ void DeviceContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
             glDrawElements(GlTopology, Attribs.NumIndices, GLIndexType, reinterpret_cast<GLvoid*>(static_cast<size_t>(FirstIndexByteOffset)));
     }
     DEV_CHECK_GL_ERROR("OpenGL draw command failed");
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
 
     PostDraw();
 }
@@ -808,6 +943,17 @@ void DeviceContextGLImpl::PrepareForIndirectDraw(IBuffer* pAttribsBuffer)
 #endif
 }
 
+void DeviceContextGLImpl::PrepareForIndirectDrawCount(IBuffer* pCountBuffer)
+{
+#if GL_ARB_indirect_parameters
+    auto* pCountBufferGL = ValidatedCast<BufferGLImpl>(pCountBuffer);
+    // GL_COMMAND_BARRIER_BIT also covers the GL_PARAMETER_BUFFER binding
+    pCountBufferGL->BufferMemoryBarrier(GL_COMMAND_BARRIER_BIT, m_ContextState);
+    constexpr bool ResetVAO = false; // GL_PARAMETER_BUFFER does not affect VAO
+    m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, pCountBufferGL->m_GlBuffer, ResetVAO);
+#endif
+}
+
 void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     if (!DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer))
@@ -829,6 +975,7 @@ void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuff
     glDrawArraysIndirect(GlTopology, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)));
     // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
     DEV_CHECK_GL_ERROR("glDrawArraysIndirect() failed");
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
 
     constexpr bool ResetVAO = false; // GL_DRAW_INDIRECT_BUFFER does not affect VAO
     m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
@@ -864,6 +1011,7 @@ void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
     glDrawElementsIndirect(GlTopology, GLIndexType, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)));
     // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
     DEV_CHECK_GL_ERROR("glDrawElementsIndirect() failed");
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
 
     constexpr bool ResetVAO = false; // GL_DISPATCH_INDIRECT_BUFFER does not affect VAO
     m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
@@ -874,6 +1022,110 @@ void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 #endif
 }
 
+void DeviceContextGLImpl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+#if GL_ARB_multi_draw_indirect
+    const auto& Features = m_pDevice->GetDeviceCaps().Features;
+    if (Attribs.pCountBuffer == nullptr && !Features.MultiDrawIndirect)
+    {
+        // Execute the draws one by one
+        TDeviceContextBase::MultiDrawIndirect(Attribs, pAttribsBuffer);
+        return;
+    }
+
+    if (!DvpVerifyMultiDrawIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    if (Attribs.pCountBuffer != nullptr && !Features.IndirectDrawCount)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndirect: indirect draw count is not supported by this device.");
+        return;
+    }
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, false, GlTopology);
+    PrepareForIndirectDraw(pAttribsBuffer);
+
+    constexpr bool ResetVAO    = false; // GL_DRAW_INDIRECT_BUFFER and GL_PARAMETER_BUFFER do not affect VAO
+    const auto*    pArgsOffset = reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset));
+    const auto     Stride      = static_cast<GLsizei>(GetIndirectDrawArgsStride(Attribs.IndirectDrawArgsStride, false));
+    if (Attribs.pCountBuffer != nullptr)
+    {
+#    if GL_ARB_indirect_parameters
+        PrepareForIndirectDrawCount(Attribs.pCountBuffer);
+        glMultiDrawArraysIndirectCountARB(GlTopology, pArgsOffset, static_cast<GLintptr>(Attribs.CountBufferOffset), Attribs.DrawCount, Stride);
+        DEV_CHECK_GL_ERROR("glMultiDrawArraysIndirectCountARB() failed");
+        m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+#    endif
+    }
+    else
+    {
+        glMultiDrawArraysIndirect(GlTopology, pArgsOffset, Attribs.DrawCount, Stride);
+        DEV_CHECK_GL_ERROR("glMultiDrawArraysIndirect() failed");
+    }
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
+
+    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    PostDraw();
+#else
+    TDeviceContextBase::MultiDrawIndirect(Attribs, pAttribsBuffer);
+#endif
+}
+
+void DeviceContextGLImpl::MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+#if GL_ARB_multi_draw_indirect
+    const auto& Features = m_pDevice->GetDeviceCaps().Features;
+    if (Attribs.pCountBuffer == nullptr && !Features.MultiDrawIndirect)
+    {
+        TDeviceContextBase::MultiDrawIndexedIndirect(Attribs, pAttribsBuffer);
+        return;
+    }
+
+    if (!DvpVerifyMultiDrawIndexedIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    if (Attribs.pCountBuffer != nullptr && !Features.IndirectDrawCount)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexedIndirect: indirect draw count is not supported by this device.");
+        return;
+    }
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, true, GlTopology);
+    GLenum GLIndexType;
+    Uint32 FirstIndexByteOffset;
+    PrepareForIndexedDraw(Attribs.IndexType, 0, GLIndexType, FirstIndexByteOffset);
+    PrepareForIndirectDraw(pAttribsBuffer);
+
+    constexpr bool ResetVAO    = false;
+    const auto*    pArgsOffset = reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset));
+    const auto     Stride      = static_cast<GLsizei>(GetIndirectDrawArgsStride(Attribs.IndirectDrawArgsStride, true));
+    if (Attribs.pCountBuffer != nullptr)
+    {
+#    if GL_ARB_indirect_parameters
+        PrepareForIndirectDrawCount(Attribs.pCountBuffer);
+        glMultiDrawElementsIndirectCountARB(GlTopology, GLIndexType, pArgsOffset, static_cast<GLintptr>(Attribs.CountBufferOffset), Attribs.DrawCount, Stride);
+        DEV_CHECK_GL_ERROR("glMultiDrawElementsIndirectCountARB() failed");
+        m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+#    endif
+    }
+    else
+    {
+        glMultiDrawElementsIndirect(GlTopology, GLIndexType, pArgsOffset, Attribs.DrawCount, Stride);
+        DEV_CHECK_GL_ERROR("glMultiDrawElementsIndirect() failed");
+    }
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
+
+    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    PostDraw();
+#else
+    TDeviceContextBase::MultiDrawIndexedIndirect(Attribs, pAttribsBuffer);
+#endif
+}
+
 
 void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
@@ -881,9 +1133,10 @@ void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
         return;
 
 #if GL_ARB_compute_shader
-    m_pPipelineState->CommitProgram(m_ContextState);
+    PrepareForDispatch();
     glDispatchCompute(Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ);
     CHECK_GL_ERROR("glDispatchCompute() failed");
+    UpdateStats(&DeviceContextStats::NumDispatchCommands);
 
     PostDraw();
 #else
@@ -897,7 +1150,7 @@ void DeviceContextGLImpl::DispatchComputeIndirect(const DispatchComputeIndirectA
         return;
 
 #if GL_ARB_compute_shader
-    m_pPipelineState->CommitProgram(m_ContextState);
+    PrepareForDispatch();
 
     auto* pBufferGL = ValidatedCast<BufferGLImpl>(pAttribsBuffer);
     pBufferGL->BufferMemoryBarrier(
@@ -914,6 +1167,7 @@ void DeviceContextGLImpl::DispatchComputeIndirect(const DispatchComputeIndirectA
 
     glDispatchComputeIndirect(Attribs.DispatchArgsByteOffset);
     CHECK_GL_ERROR("glDispatchComputeIndirect() failed");
+    UpdateStats(&DeviceContextStats::NumDispatchCommands);
 
     m_ContextState.BindBuffer(GL_DISPATCH_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
 
@@ -1025,16 +1279,97 @@ void DeviceContextGLImpl::Flush()
 
 void DeviceContextGLImpl::FinishFrame()
 {
+    if (m_DynamicHeap)
+        m_DynamicHeap->FinishFrame();
+
+    // GL objects are kept alive by the driver while they are used by the GPU,
+    // so the objects retained during the frame can be released right away.
+    FrameRetainedObjects::ObjectList RetainedObjects;
+    ExtractFrameRetainedObjects(RetainedObjects);
 }
 
 void DeviceContextGLImpl::FinishCommandList(class ICommandList** ppCommandList)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    LOG_ERROR_MESSAGE("Command lists can only be finished by deferred contexts");
 }
 
+namespace
+{
+
+// Executes the commands recorded by a deferred context through the methods of the immediate context
+class GLCommandExecutor
+{
+public:
+    explicit GLCommandExecutor(DeviceContextGLImpl& Ctx) :
+        m_Ctx{Ctx}
+    {}
+
+    // clang-format off
+    void operator()(const GLCommands::SetPipelineState&          Cmd) const { m_Ctx.SetPipelineState(Cmd.pPSO); }
+    void operator()(const GLCommands::CommitShaderResources&     Cmd) const { m_Ctx.CommitShaderResources(Cmd.pSRB, Cmd.Mode); }
+    void operator()(const GLCommands::SetStencilRef&             Cmd) const { m_Ctx.SetStencilRef(Cmd.StencilRef); }
+    void operator()(const GLCommands::SetBlendFactors&           Cmd) const { m_Ctx.SetBlendFactors(Cmd.pBlendFactors); }
+    void operator()(const GLCommands::SetVertexBuffers&          Cmd) const { m_Ctx.SetVertexBuffers(Cmd.StartSlot, Cmd.NumBuffers, Cmd.ppBuffers, Cmd.pOffsets, Cmd.Mode, Cmd.Flags); }
+    void operator()(const GLCommands::InvalidateState&              ) const { m_Ctx.InvalidateState(); }
+    void operator()(const GLCommands::SetIndexBuffer&            Cmd) const { m_Ctx.SetIndexBuffer(Cmd.pBuffer, Cmd.ByteOffset, Cmd.Mode); }
+    void operator()(const GLCommands::SetViewports&              Cmd) const { m_Ctx.SetViewports(Cmd.NumViewports, Cmd.pViewports, Cmd.RTWidth, Cmd.RTHeight); }
+    void operator()(const GLCommands::SetScissorRects&           Cmd) const { m_Ctx.SetScissorRects(Cmd.NumRects, Cmd.pRects, Cmd.RTWidth, Cmd.RTHeight); }
+    void operator()(const GLCommands::SetRenderTargets&          Cmd) const { m_Ctx.SetRenderTargets(Cmd.NumRenderTargets, Cmd.ppRenderTargets, Cmd.pDepthStencil, Cmd.Mode); }
+    void operator()(const GLCommands::Draw&                      Cmd) const { m_Ctx.Draw(Cmd.Attribs); }
+    void operator()(const GLCommands::DrawIndexed&               Cmd) const { m_Ctx.DrawIndexed(Cmd.Attribs); }
+    void operator()(const GLCommands::DrawIndirect&              Cmd) const { m_Ctx.DrawIndirect(Cmd.Attribs, Cmd.pAttribsBuffer); }
+    void operator()(const GLCommands::DrawIndexedIndirect&       Cmd) const { m_Ctx.DrawIndexedIndirect(Cmd.Attribs, Cmd.pAttribsBuffer); }
+    void operator()(const GLCommands::MultiDrawIndirect&         Cmd) const { m_Ctx.MultiDrawIndirect(Cmd.Attribs, Cmd.pAttribsBuffer); }
+    void operator()(const GLCommands::MultiDrawIndexedIndirect&  Cmd) const { m_Ctx.MultiDrawIndexedIndirect(Cmd.Attribs, Cmd.pAttribsBuffer); }
+    void operator()(const GLCommands::DispatchCompute&           Cmd) const { m_Ctx.DispatchCompute(Cmd.Attribs); }
+    void operator()(const GLCommands::DispatchComputeIndirect&   Cmd) const { m_Ctx.DispatchComputeIndirect(Cmd.Attribs, Cmd.pAttribsBuffer); }
+    void operator()(const GLCommands::ClearDepthStencil&         Cmd) const { m_Ctx.ClearDepthStencil(Cmd.pView, Cmd.ClearFlags, Cmd.fDepth, Cmd.Stencil, Cmd.Mode); }
+    void operator()(const GLCommands::ClearRenderTarget&         Cmd) const { m_Ctx.ClearRenderTarget(Cmd.pView, Cmd.RGBA, Cmd.Mode); }
+    void operator()(const GLCommands::UpdateBuffer&              Cmd) const { m_Ctx.UpdateBuffer(Cmd.pBuffer, Cmd.Offset, Cmd.Size, Cmd.pData, Cmd.Mode); }
+    void operator()(const GLCommands::CopyBuffer&                Cmd) const { m_Ctx.CopyBuffer(Cmd.pSrcBuffer, Cmd.SrcOffset, Cmd.SrcMode, Cmd.pDstBuffer, Cmd.DstOffset, Cmd.Size, Cmd.DstMode); }
+    void operator()(const GLCommands::UpdateTexture&             Cmd) const { m_Ctx.UpdateTexture(Cmd.pTexture, Cmd.MipLevel, Cmd.Slice, Cmd.DstBox, Cmd.SubresData, Cmd.SrcBufferMode, Cmd.TextureMode); }
+    void operator()(const GLCommands::CopyTexture&               Cmd) const { m_Ctx.CopyTexture(Cmd.Attribs); }
+    void operator()(const GLCommands::GenerateMips&              Cmd) const { m_Ctx.GenerateMips(Cmd.pView); }
+    void operator()(const GLCommands::ResolveTextureSubresource& Cmd) const { m_Ctx.ResolveTextureSubresource(Cmd.pSrcTexture, Cmd.pDstTexture, Cmd.Attribs); }
+    void operator()(const GLCommands::BeginDebugGroup&           Cmd) const { m_Ctx.BeginDebugGroup(Cmd.Name, Cmd.pColor); }
+    void operator()(const GLCommands::EndDebugGroup&                ) const { m_Ctx.EndDebugGroup(); }
+    void operator()(const GLCommands::InsertDebugLabel&          Cmd) const { m_Ctx.InsertDebugLabel(Cmd.Label, Cmd.pColor); }
+    // clang-format on
+
+    void operator()(const GLCommands::WriteDynamicBuffer& Cmd) const
+    {
+        PVoid pMappedData = nullptr;
+        m_Ctx.MapBuffer(Cmd.pBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pMappedData);
+        if (pMappedData != nullptr)
+            memcpy(pMappedData, Cmd.pData, Cmd.Size);
+        m_Ctx.UnmapBuffer(Cmd.pBuffer, MAP_WRITE);
+    }
+
+private:
+    DeviceContextGLImpl& m_Ctx;
+};
+
+} // namespace
+
 void DeviceContextGLImpl::ExecuteCommandList(class ICommandList* pCommandList)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    if (m_bIsDeferred)
+    {
+        LOG_ERROR_MESSAGE("Only immediate context can execute command list");
+        return;
+    }
+
+    auto* pCmdListGL = ValidatedCast<CommandListGLImpl>(pCommandList);
+
+    // Commands are recorded by the deferred context starting from the default state
+    InvalidateState();
+
+    pCmdListGL->GetCommandStream().ProcessCommands(GLCommandExecutor{*this});
+
+    // Similar to other backends, the context returns to the default state after the command list is executed
+    InvalidateState();
+
+    pCmdListGL->Close();
 }
 
 void DeviceContextGLImpl::SignalFence(IFence* pFence, Uint64 Value)
@@ -1185,13 +1520,44 @@ void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAG
 {
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto* pBufferGL = ValidatedCast<BufferGLImpl>(pBuffer);
+    if (m_DynamicHeap && MapType == MAP_WRITE && pBufferGL->IsDynamicHeapCompatible())
+    {
+        auto& DynAlloc = pBufferGL->m_DynamicAllocation;
+        // With MAP_FLAG_NO_OVERWRITE, keep writing to the region allocated by the last MAP_FLAG_DISCARD
+        if ((MapFlags & MAP_FLAG_DISCARD) != 0)
+        {
+            DynAlloc = m_DynamicHeap->Allocate(pBufferGL->GetDesc().uiSizeInBytes);
+            // The buffer is moved to a new range (or to its own storage if the heap is exhausted),
+            // so the committed uniform buffer bindings must be updated before the next draw
+            m_DynamicUBsDirty = m_DynamicUBsDirty || !m_CommittedDynamicUBs.empty();
+        }
+
+        if (DynAlloc.IsValid())
+        {
+            pMappedData                          = DynAlloc.pCPUAddress;
+            pBufferGL->m_IsMappedFromDynamicHeap = true;
+            if ((MapFlags & MAP_FLAG_DISCARD) != 0)
+                UpdateStats(&DeviceContextStats::DynamicHeapBytes, Uint64{DynAlloc.Size});
+            return;
+        }
+        // The heap is exhausted - fall back to orphaning the buffer's own storage
+    }
+
     pBufferGL->Map(m_ContextState, MapType, MapFlags, pMappedData);
+    if (MapType == MAP_WRITE && (MapFlags & MAP_FLAG_DISCARD) != 0 && pBufferGL->GetDesc().Usage == USAGE_DYNAMIC)
+        UpdateStats(&DeviceContextStats::DynamicHeapBytes, Uint64{pBufferGL->GetDesc().uiSizeInBytes});
 }
 
 void DeviceContextGLImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto* pBufferGL = ValidatedCast<BufferGLImpl>(pBuffer);
+    if (pBufferGL->m_IsMappedFromDynamicHeap)
+    {
+        // Dynamic heap is persistently and coherently mapped, so there is nothing to unmap
+        pBufferGL->m_IsMappedFromDynamicHeap = false;
+        return;
+    }
     pBufferGL->Unmap(m_ContextState);
 }
 
@@ -1457,4 +1823,36 @@ void DeviceContextGLImpl::ResolveTextureSubresource(ITexture*
     CommitRenderTargets();
 }
 
+void DeviceContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
+{
+    if (!TDeviceContextBase::BeginDebugGroup(Name, 0))
+        return;
+
+#if !PLATFORM_IOS
+    // OpenGL debug groups do not have a color
+    if (m_DebugGroupsSupported)
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, Name);
+#endif
+}
+
+void DeviceContextGLImpl::EndDebugGroup()
+{
+    if (!TDeviceContextBase::EndDebugGroup(0))
+        return;
+
+#if !PLATFORM_IOS
+    if (m_DebugGroupsSupported)
+        glPopDebugGroup();
+#endif
+}
+
+void DeviceContextGLImpl::InsertDebugLabel(const Char* Label, const float* pColor)
+{
+    VERIFY(Label != nullptr, "Label must not be null");
+#if !PLATFORM_IOS
+    if (m_DebugGroupsSupported)
+        glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_MARKER, 0, GL_DEBUG_SEVERITY_NOTIFICATION, -1, Label);
+#endif
+}
+
 } // namespace Diligent
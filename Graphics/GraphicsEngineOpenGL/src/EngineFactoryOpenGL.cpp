@@ -32,6 +32,7 @@
 #include "EngineFactoryOpenGL.h"
 #include "RenderDeviceGLImpl.hpp"
 #include "DeviceContextGLImpl.hpp"
+#include "DeferredContextGLImpl.hpp"
 #include "EngineMemory.h"
 #include "HLSL2GLSLConverterObject.hpp"
 #include "EngineFactoryBase.hpp"
@@ -81,7 +82,7 @@ public:
 
     virtual void DILIGENT_CALL_TYPE CreateDeviceAndSwapChainGL(const EngineGLCreateInfo& EngineCI,
                                                                IRenderDevice**           ppDevice,
-                                                               IDeviceContext**          ppImmediateContext,
+                                                               IDeviceContext**          ppContexts,
                                                                const SwapChainDesc&      SCDesc,
                                                                ISwapChain**              ppSwapChain) override final;
 
@@ -89,7 +90,7 @@ public:
 
     virtual void DILIGENT_CALL_TYPE AttachToActiveGLContext(const EngineGLCreateInfo& EngineCI,
                                                             IRenderDevice**           ppDevice,
-                                                            IDeviceContext**          ppImmediateContext) override final;
+                                                            IDeviceContext**          ppContexts) override final;
 
 #if PLATFORM_ANDROID
     virtual void InitAndroidFileSystem(struct ANativeActivity* NativeActivity,
@@ -105,14 +106,16 @@ public:
 /// \param [in] EngineCI - Engine creation attributes.
 /// \param [out] ppDevice - Address of the memory location where pointer to
 ///                         the created device will be written.
-/// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+/// \param [out] ppContexts - Address of the memory location where pointers to
+///                           the contexts will be written. Immediate context goes at
+///                           position 0. If EngineCI.NumDeferredContexts > 0,
+///                           pointers to the deferred contexts are written afterwards.
 /// \param [in] SCDesc - Swap chain description.
 /// \param [out] ppSwapChain    - Address of the memory location where pointer to the new
 ///                               swap chain will be written.
 void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInfo& EngineCI,
                                                          IRenderDevice**           ppDevice,
-                                                         IDeviceContext**          ppImmediateContext,
+                                                         IDeviceContext**          ppContexts,
                                                          const SwapChainDesc&      SCDesc,
                                                          ISwapChain**              ppSwapChain)
 {
@@ -125,18 +128,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         return;
     }
 
-    VERIFY(ppDevice && ppImmediateContext && ppSwapChain, "Null pointer provided");
-    if (!ppDevice || !ppImmediateContext || !ppSwapChain)
+    VERIFY(ppDevice && ppContexts && ppSwapChain, "Null pointer provided");
+    if (!ppDevice || !ppContexts || !ppSwapChain)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_WARNING_MESSAGE("OpenGL back-end does not support deferred contexts");
-    }
-
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
-    *ppSwapChain        = nullptr;
+    *ppDevice    = nullptr;
+    *ppSwapChain = nullptr;
+    memset(ppContexts, 0, sizeof(*ppContexts) * (1 + EngineCI.NumDeferredContexts));
 
     try
     {
@@ -146,12 +144,21 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         RenderDeviceGLImpl* pRenderDeviceOpenGL(NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(RawMemAllocator, this, EngineCI, &SCDesc));
         pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
 
-        DeviceContextGLImpl* pDeviceContextOpenGL(NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, false));
+        DeviceContextGLImpl* pDeviceContextOpenGL(NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, false, EngineCI));
         // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
         // keep a weak reference to the context
-        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
+        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts));
         pRenderDeviceOpenGL->SetImmediateContext(pDeviceContextOpenGL);
 
+        for (Uint32 DeferredCtx = 0; DeferredCtx < EngineCI.NumDeferredContexts; ++DeferredCtx)
+        {
+            RefCntAutoPtr<DeferredContextGLImpl> pDeferredCtxGL(NEW_RC_OBJ(RawMemAllocator, "DeferredContextGLImpl instance", DeferredContextGLImpl)(pRenderDeviceOpenGL));
+            // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
+            // keep a weak reference to the context
+            pDeferredCtxGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + 1 + DeferredCtx));
+            pRenderDeviceOpenGL->SetDeferredContext(DeferredCtx, pDeferredCtxGL);
+        }
+
         // Need to create immediate context first
         pRenderDeviceOpenGL->InitTexRegionRender();
 
@@ -168,10 +175,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppContexts[ctx] != nullptr)
+            {
+                ppContexts[ctx]->Release();
+                ppContexts[ctx] = nullptr;
+            }
         }
 
         if (*ppSwapChain)
@@ -190,11 +200,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
 /// \param [in] EngineCI - Engine creation attributes.
 /// \param [out] ppDevice - Address of the memory location where pointer to
 ///                         the created device will be written.
-/// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+/// \param [out] ppContexts - Address of the memory location where pointers to
+///                           the contexts will be written. Immediate context goes at
+///                           position 0. If EngineCI.NumDeferredContexts > 0,
+///                           pointers to the deferred contexts are written afterwards.
 void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo& EngineCI,
                                                       IRenderDevice**           ppDevice,
-                                                      IDeviceContext**          ppImmediateContext)
+                                                      IDeviceContext**          ppContexts)
 {
     if (EngineCI.DebugMessageCallback != nullptr)
         SetDebugMessageCallback(EngineCI.DebugMessageCallback);
@@ -205,17 +217,12 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         return;
     }
 
-    VERIFY(ppDevice && ppImmediateContext, "Null pointer provided");
-    if (!ppDevice || !ppImmediateContext)
+    VERIFY(ppDevice && ppContexts, "Null pointer provided");
+    if (!ppDevice || !ppContexts)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_WARNING_MESSAGE("OpenGL back-end does not support deferred contexts");
-    }
-
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
+    *ppDevice = nullptr;
+    memset(ppContexts, 0, sizeof(*ppContexts) * (1 + EngineCI.NumDeferredContexts));
 
     try
     {
@@ -225,11 +232,20 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         RenderDeviceGLImpl* pRenderDeviceOpenGL(NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(RawMemAllocator, this, EngineCI));
         pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
 
-        DeviceContextGLImpl* pDeviceContextOpenGL(NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, false));
+        DeviceContextGLImpl* pDeviceContextOpenGL(NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, false, EngineCI));
         // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
         // keep a weak reference to the context
-        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
+        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts));
         pRenderDeviceOpenGL->SetImmediateContext(pDeviceContextOpenGL);
+
+        for (Uint32 DeferredCtx = 0; DeferredCtx < EngineCI.NumDeferredContexts; ++DeferredCtx)
+        {
+            RefCntAutoPtr<DeferredContextGLImpl> pDeferredCtxGL(NEW_RC_OBJ(RawMemAllocator, "DeferredContextGLImpl instance", DeferredContextGLImpl)(pRenderDeviceOpenGL));
+            // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
+            // keep a weak reference to the context
+            pDeferredCtxGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + 1 + DeferredCtx));
+            pRenderDeviceOpenGL->SetDeferredContext(DeferredCtx, pDeferredCtxGL);
+        }
     }
     catch (const std::runtime_error&)
     {
@@ -239,10 +255,13 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppContexts[ctx] != nullptr)
+            {
+                ppContexts[ctx]->Release();
+                ppContexts[ctx] = nullptr;
+            }
         }
 
         LOG_ERROR("Failed to initialize OpenGL-based render device");
@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GLCommandStream.hpp"
+#include "FixedBlockMemoryAllocator.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+constexpr size_t GLCommandStream::ChunkSize;
+constexpr size_t GLCommandStream::CommandAlignment;
+constexpr size_t GLCommandStream::ChunkDataOffset;
+
+GLCommandStream::GLCommandStream(GLCommandStream&& Stream) noexcept :
+    // clang-format off
+    m_pChunkAllocator{Stream.m_pChunkAllocator},
+    m_Commands       {Stream.m_Commands       },
+    m_Data           {Stream.m_Data           },
+    m_Objects        {Stream.m_Objects        },
+    m_NumCommands    {Stream.m_NumCommands    }
+// clang-format on
+{
+    Stream.m_Commands    = ChunkList{};
+    Stream.m_Data        = ChunkList{};
+    Stream.m_Objects     = ChunkList{};
+    Stream.m_NumCommands = 0;
+}
+
+void* GLCommandStream::ChunkList::Allocate(size_t Size, size_t Alignment, IMemoryAllocator& ChunkAllocator)
+{
+    VERIFY(IsPowerOfTwo(Alignment) && Alignment <= 16, "Alignment (", Alignment, ") must be a power of two not greater than 16");
+
+    if (pLast != nullptr)
+    {
+        auto Offset = Align(pLast->Size, Alignment);
+        if (Offset + Size <= pLast->Capacity)
+        {
+            pLast->Size = Offset + Size;
+            return reinterpret_cast<Uint8*>(pLast) + ChunkDataOffset + Offset;
+        }
+    }
+
+    Chunk* pNewChunk = nullptr;
+    if (ChunkDataOffset + Size <= ChunkSize)
+    {
+        pNewChunk           = reinterpret_cast<Chunk*>(ChunkAllocator.Allocate(ChunkSize, "GL command stream chunk", __FILE__, __LINE__));
+        pNewChunk->Capacity = ChunkSize - ChunkDataOffset;
+        pNewChunk->IsLarge  = false;
+    }
+    else
+    {
+        // Data that does not fit into a regular chunk (e.g. large buffer updates)
+        // is placed into a dedicated chunk allocated from the raw allocator
+        pNewChunk           = reinterpret_cast<Chunk*>(GetRawAllocator().Allocate(ChunkDataOffset + Size, "GL command stream large chunk", __FILE__, __LINE__));
+        pNewChunk->Capacity = Size;
+        pNewChunk->IsLarge  = true;
+    }
+    pNewChunk->pNext = nullptr;
+    pNewChunk->Size  = Size;
+
+    if (pLast != nullptr)
+        pLast->pNext = pNewChunk;
+    else
+        pFirst = pNewChunk;
+    pLast = pNewChunk;
+
+    return reinterpret_cast<Uint8*>(pNewChunk) + ChunkDataOffset;
+}
+
+void GLCommandStream::ChunkList::Free(IMemoryAllocator& ChunkAllocator)
+{
+    auto* pChunk = pFirst;
+    while (pChunk != nullptr)
+    {
+        auto* pNext = pChunk->pNext;
+        if (pChunk->IsLarge)
+            GetRawAllocator().Free(pChunk);
+        else
+            ChunkAllocator.Free(pChunk);
+        pChunk = pNext;
+    }
+    pFirst = nullptr;
+    pLast  = nullptr;
+}
+
+const Char* GLCommandStream::CopyString(const Char* Str)
+{
+    VERIFY_EXPR(Str != nullptr);
+    auto  LenWithZeroTerm = strlen(Str) + 1;
+    auto* pDst            = reinterpret_cast<Char*>(AllocateData(LenWithZeroTerm, 1));
+    memcpy(pDst, Str, LenWithZeroTerm);
+    return pDst;
+}
+
+void GLCommandStream::Clear()
+{
+    for (auto* pChunk = m_Objects.pFirst; pChunk != nullptr; pChunk = pChunk->pNext)
+    {
+        auto** ppObjects  = reinterpret_cast<IObject**>(reinterpret_cast<Uint8*>(pChunk) + ChunkDataOffset);
+        auto   NumObjects = pChunk->Size / sizeof(IObject*);
+        for (size_t i = 0; i < NumObjects; ++i)
+            ppObjects[i]->Release();
+    }
+
+    m_Commands.Free(*m_pChunkAllocator);
+    m_Data.Free(*m_pChunkAllocator);
+    m_Objects.Free(*m_pChunkAllocator);
+    m_NumCommands = 0;
+}
+
+} // namespace Diligent
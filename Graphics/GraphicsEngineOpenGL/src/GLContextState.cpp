@@ -28,6 +28,7 @@
 #include "pch.h"
 
 #include "GLContextState.hpp"
+#include "GLMultiBind.hpp"
 #include "TextureBaseGL.hpp"
 #include "SamplerGLImpl.hpp"
 #include "AsyncWritableResource.hpp"
@@ -61,6 +62,15 @@ GLContextState::GLContextState(RenderDeviceGLImpl* pDeviceGL)
         VERIFY_EXPR(m_Caps.m_iMaxUniformBufferBindings > 0);
     }
 
+#if GL_ARB_multi_bind
+    if (DeviceCaps.DevType == RENDER_DEVICE_TYPE_GL)
+    {
+        m_Caps.bMultiBindSupported =
+            DeviceCaps.MajorVersion > 4 || (DeviceCaps.MajorVersion == 4 && DeviceCaps.MinorVersion >= 4) ||
+            pDeviceGL->CheckExtension("GL_ARB_multi_bind");
+    }
+#endif
+
     m_BoundTextures.reserve(m_Caps.m_iMaxCombinedTexUnits);
     m_BoundSamplers.reserve(32);
     m_BoundImages.reserve(32);
@@ -295,16 +305,29 @@ void GLContextState::BindImage(Uint32 Index, BufferViewGLImpl* pBuffView, GLenum
 #endif
 }
 
-void GLContextState::BindUniformBuffer(Int32 Index, const GLObjectWrappers::GLBufferObj& Buff)
+void GLContextState::BindUniformBuffer(Int32 Index, const GLObjectWrappers::GLBufferObj& Buff, GLintptr Offset, GLsizeiptr Size)
 {
     VERIFY(0 <= Index && Index < m_Caps.m_iMaxUniformBufferBindings, "Uniform buffer index is out of range");
 
-    GLuint GLBufferHandle = Buff;
-    if (UpdateBoundObjectsArr(m_BoundUniformBuffers, Index, Buff, GLBufferHandle))
+    BoundBufferRangeInfo NewUBInfo{Buff.GetUniqueID(), Offset, Size};
+    if (Index >= static_cast<Int32>(m_BoundUniformBuffers.size()))
+        m_BoundUniformBuffers.resize(Index + 1);
+
+    if (!(m_BoundUniformBuffers[Index] == NewUBInfo))
     {
-        // In addition to binding buffer to the indexed buffer binding target, glBindBufferBase also binds
-        // buffer to the generic buffer binding point specified by target.
-        glBindBufferBase(GL_UNIFORM_BUFFER, Index, GLBufferHandle);
+        m_BoundUniformBuffers[Index] = NewUBInfo;
+        GLuint GLBufferHandle        = Buff;
+        // In addition to binding buffer to the indexed buffer binding target, glBindBufferBase and
+        // glBindBufferRange also bind buffer to the generic buffer binding point specified by target.
+        if (Size == 0)
+        {
+            VERIFY(Offset == 0, "Offset must be zero when the whole buffer is bound");
+            glBindBufferBase(GL_UNIFORM_BUFFER, Index, GLBufferHandle);
+        }
+        else
+        {
+            glBindBufferRange(GL_UNIFORM_BUFFER, Index, GLBufferHandle, Offset, Size);
+        }
         DEV_CHECK_GL_ERROR("Failed to bind uniform buffer to slot ", Index);
     }
 }
@@ -312,7 +335,7 @@ void GLContextState::BindUniformBuffer(Int32 Index, const GLObjectWrappers::GLBu
 void GLContextState::BindStorageBlock(Int32 Index, const GLObjectWrappers::GLBufferObj& Buff, GLintptr Offset, GLsizeiptr Size)
 {
 #if GL_ARB_shader_storage_buffer_object
-    BoundSSBOInfo NewSSBOInfo{Buff.GetUniqueID(), Offset, Size};
+    BoundBufferRangeInfo NewSSBOInfo{Buff.GetUniqueID(), Offset, Size};
     if (Index >= static_cast<Int32>(m_BoundStorageBlocks.size()))
         m_BoundStorageBlocks.resize(Index + 1);
 
@@ -330,6 +353,159 @@ void GLContextState::BindStorageBlock(Int32 Index, const GLObjectWrappers::GLBuf
 #endif
 }
 
+void GLContextState::BindTextures(Uint32 First, Uint32 Count, const GLObjectWrappers::GLTextureObj* const ppTextures[], const GLenum BindTargets[])
+{
+    VERIFY(First + Count <= static_cast<Uint32>(m_Caps.m_iMaxCombinedTexUnits), "Texture unit is out of range");
+
+#if GL_ARB_multi_bind
+    if (m_Caps.bMultiBindSupported)
+    {
+        m_MultiBindHandles.resize(Count);
+        ProcessMultiBindSlots(
+            First, Count,
+            [&](Uint32 Slot) -> MultiBindSlotState //
+            {
+                const auto* pTexture = ppTextures[Slot - First];
+                if (pTexture == nullptr)
+                    return MultiBindSlotState::Skipped;
+                return UpdateBoundObjectsArr(m_BoundTextures, Slot, *pTexture, m_MultiBindHandles[Slot - First]) ?
+                    MultiBindSlotState::Modified :
+                    MultiBindSlotState::Unchanged;
+            },
+            [&](Uint32 RangeFirst, Uint32 RangeCount) //
+            {
+                // glBindTextures() binds every texture to the target it was created with and
+                // does not modify the active texture unit
+                glBindTextures(RangeFirst, RangeCount, &m_MultiBindHandles[RangeFirst - First]);
+                DEV_CHECK_GL_ERROR("Failed to bind textures to slots ", RangeFirst, "..", RangeFirst + RangeCount - 1);
+            });
+        return;
+    }
+#endif
+
+    for (Uint32 i = 0; i < Count; ++i)
+    {
+        if (ppTextures[i] != nullptr)
+            BindTexture(First + i, BindTargets[i], *ppTextures[i]);
+    }
+}
+
+void GLContextState::BindSamplers(Uint32 First, Uint32 Count, const GLObjectWrappers::GLSamplerObj* const ppSamplers[])
+{
+#if GL_ARB_multi_bind
+    if (m_Caps.bMultiBindSupported)
+    {
+        m_MultiBindHandles.resize(Count);
+        ProcessMultiBindSlots(
+            First, Count,
+            [&](Uint32 Slot) -> MultiBindSlotState //
+            {
+                const auto* pSampler = ppSamplers[Slot - First];
+                if (pSampler == nullptr)
+                    return MultiBindSlotState::Skipped;
+                return UpdateBoundObjectsArr(m_BoundSamplers, Slot, *pSampler, m_MultiBindHandles[Slot - First]) ?
+                    MultiBindSlotState::Modified :
+                    MultiBindSlotState::Unchanged;
+            },
+            [&](Uint32 RangeFirst, Uint32 RangeCount) //
+            {
+                glBindSamplers(RangeFirst, RangeCount, &m_MultiBindHandles[RangeFirst - First]);
+                DEV_CHECK_GL_ERROR("Failed to bind samplers to slots ", RangeFirst, "..", RangeFirst + RangeCount - 1);
+            });
+        return;
+    }
+#endif
+
+    for (Uint32 i = 0; i < Count; ++i)
+    {
+        if (ppSamplers[i] != nullptr)
+            BindSampler(First + i, *ppSamplers[i]);
+    }
+}
+
+void GLContextState::BindUniformBuffers(Uint32 First, Uint32 Count, const GLObjectWrappers::GLBufferObj* const ppBuffers[], const GLintptr Offsets[], const GLsizeiptr Sizes[])
+{
+    VERIFY(First + Count <= static_cast<Uint32>(m_Caps.m_iMaxUniformBufferBindings), "Uniform buffer index is out of range");
+
+#if GL_ARB_multi_bind
+    if (m_Caps.bMultiBindSupported)
+    {
+        if (m_BoundUniformBuffers.size() < First + Count)
+            m_BoundUniformBuffers.resize(First + Count);
+        m_MultiBindHandles.resize(Count);
+        ProcessMultiBindSlots(
+            First, Count,
+            [&](Uint32 Slot) -> MultiBindSlotState //
+            {
+                const auto  Idx     = Slot - First;
+                const auto* pBuffer = ppBuffers[Idx];
+                if (pBuffer == nullptr)
+                    return MultiBindSlotState::Skipped;
+                VERIFY(Sizes[Idx] != 0, "Buffer size must not be zero when binding multiple uniform buffers");
+                m_MultiBindHandles[Idx] = *pBuffer;
+                BoundBufferRangeInfo NewUBInfo{pBuffer->GetUniqueID(), Offsets[Idx], Sizes[Idx]};
+                if (m_BoundUniformBuffers[Slot] == NewUBInfo)
+                    return MultiBindSlotState::Unchanged;
+                m_BoundUniformBuffers[Slot] = NewUBInfo;
+                return MultiBindSlotState::Modified;
+            },
+            [&](Uint32 RangeFirst, Uint32 RangeCount) //
+            {
+                const auto Idx = RangeFirst - First;
+                glBindBuffersRange(GL_UNIFORM_BUFFER, RangeFirst, RangeCount, &m_MultiBindHandles[Idx], &Offsets[Idx], &Sizes[Idx]);
+                DEV_CHECK_GL_ERROR("Failed to bind uniform buffers to slots ", RangeFirst, "..", RangeFirst + RangeCount - 1);
+            });
+        return;
+    }
+#endif
+
+    for (Uint32 i = 0; i < Count; ++i)
+    {
+        if (ppBuffers[i] != nullptr)
+            BindUniformBuffer(First + i, *ppBuffers[i], Offsets[i], Sizes[i]);
+    }
+}
+
+void GLContextState::BindStorageBlocks(Uint32 First, Uint32 Count, const GLObjectWrappers::GLBufferObj* const ppBuffers[], const GLintptr Offsets[], const GLsizeiptr Sizes[])
+{
+#if GL_ARB_multi_bind
+    if (m_Caps.bMultiBindSupported)
+    {
+        if (m_BoundStorageBlocks.size() < First + Count)
+            m_BoundStorageBlocks.resize(First + Count);
+        m_MultiBindHandles.resize(Count);
+        ProcessMultiBindSlots(
+            First, Count,
+            [&](Uint32 Slot) -> MultiBindSlotState //
+            {
+                const auto  Idx     = Slot - First;
+                const auto* pBuffer = ppBuffers[Idx];
+                if (pBuffer == nullptr)
+                    return MultiBindSlotState::Skipped;
+                m_MultiBindHandles[Idx] = *pBuffer;
+                BoundBufferRangeInfo NewSSBOInfo{pBuffer->GetUniqueID(), Offsets[Idx], Sizes[Idx]};
+                if (m_BoundStorageBlocks[Slot] == NewSSBOInfo)
+                    return MultiBindSlotState::Unchanged;
+                m_BoundStorageBlocks[Slot] = NewSSBOInfo;
+                return MultiBindSlotState::Modified;
+            },
+            [&](Uint32 RangeFirst, Uint32 RangeCount) //
+            {
+                const auto Idx = RangeFirst - First;
+                glBindBuffersRange(GL_SHADER_STORAGE_BUFFER, RangeFirst, RangeCount, &m_MultiBindHandles[Idx], &Offsets[Idx], &Sizes[Idx]);
+                DEV_CHECK_GL_ERROR("Failed to bind shader storage blocks to slots ", RangeFirst, "..", RangeFirst + RangeCount - 1);
+            });
+        return;
+    }
+#endif
+
+    for (Uint32 i = 0; i < Count; ++i)
+    {
+        if (ppBuffers[i] != nullptr)
+            BindStorageBlock(First + i, *ppBuffers[i], Offsets[i], Sizes[i]);
+    }
+}
+
 void GLContextState::BindBuffer(GLenum BindTarget, const GLObjectWrappers::GLBufferObj& Buff, bool ResetVAO)
 {
     // Binding ARRAY_BUFFER or ELEMENT_ARRAY_BUFFER affects currently bound VAO
@@ -387,6 +563,7 @@ void GLContextState::EnsureMemoryBarrier(Uint32 RequiredBarriers, AsyncWritableR
         glMemoryBarrier(RequiredBarriers);
         DEV_CHECK_GL_ERROR("glMemoryBarrier() failed");
         m_PendingMemoryBarriers &= ~RequiredBarriers;
+        ++m_NumExecutedMemoryBarriers;
     }
 
     // Leave only these barriers that are still pending
@@ -0,0 +1,167 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GLDynamicHeap.hpp"
+#include "RenderDeviceGLImpl.hpp"
+#include "GLContextState.hpp"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+bool GLDynamicHeap::IsSupported(RenderDeviceGLImpl& DeviceGL)
+{
+#if GL_ARB_buffer_storage
+    const auto& DeviceCaps = DeviceGL.GetDeviceCaps();
+    // GLES contexts do not support glBufferStorage() without GL_EXT_buffer_storage extension
+    if (DeviceCaps.DevType != RENDER_DEVICE_TYPE_GL)
+        return false;
+    if (DeviceCaps.MajorVersion > 4 || (DeviceCaps.MajorVersion == 4 && DeviceCaps.MinorVersion >= 4))
+        return true;
+    return DeviceGL.CheckExtension("GL_ARB_buffer_storage");
+#else
+    return false;
+#endif
+}
+
+GLDynamicHeap::GLDynamicHeap(GLContextState& CtxState, Uint32 Size) :
+    // clang-format off
+    m_GLBuffer  {true                     },
+    m_RingBuffer{Size, GetRawAllocator()}
+// clang-format on
+{
+    GLint Alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &Alignment);
+    CHECK_GL_ERROR("Failed to get uniform buffer offset alignment");
+    if (Alignment > 0)
+        m_Alignment = std::max(static_cast<Uint32>(Alignment), m_Alignment);
+    VERIFY(IsPowerOfTwo(m_Alignment), "Uniform buffer offset alignment (", m_Alignment, ") is not power of two");
+
+#if GL_ARB_buffer_storage
+    constexpr GLbitfield StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    constexpr bool ResetVAO = false; // No need to reset VAO for COPY_WRITE target
+    CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, m_GLBuffer, ResetVAO);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, Size, nullptr, StorageFlags);
+    if (glGetError() == GL_NO_ERROR)
+    {
+        // With GL_MAP_COHERENT_BIT, writes to the mapped memory become visible to the
+        // server without explicit flushes, so the buffer can stay mapped for its lifetime.
+        m_CPUAddress = reinterpret_cast<Uint8*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, Size, StorageFlags));
+        CHECK_GL_ERROR("Failed to persistently map dynamic heap buffer");
+    }
+    CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+#endif
+
+    if (m_CPUAddress == nullptr)
+        LOG_ERROR_AND_THROW("Failed to create persistently mapped dynamic heap buffer of size ", Size);
+
+    LOG_INFO_MESSAGE("Created persistently mapped dynamic heap (", Size >> 10, " KB)");
+}
+
+GLDynamicHeap::~GLDynamicHeap()
+{
+    // The buffer is about to be deleted, so all frames can be released. OpenGL keeps the storage
+    // alive until the GPU has finished using it.
+    m_RingBuffer.FinishCurrentFrame(m_FrameNumber);
+    m_RingBuffer.ReleaseCompletedFrames(m_FrameNumber);
+    m_PendingFrames.clear();
+}
+
+GLDynamicAllocation GLDynamicHeap::Allocate(Uint32 SizeInBytes)
+{
+    VERIFY_EXPR(SizeInBytes > 0);
+
+    auto Offset = m_RingBuffer.Allocate(SizeInBytes, m_Alignment);
+    if (Offset == RingBuffer::InvalidOffset)
+    {
+        // Reclaim the space of the frames that have completed since the last FinishFrame()
+        ReleaseCompletedFrames(false);
+        Offset = m_RingBuffer.Allocate(SizeInBytes, m_Alignment);
+
+        // Space held by the current frame cannot be reclaimed, so wait for the previous frames only
+        while (Offset == RingBuffer::InvalidOffset && !m_PendingFrames.empty())
+        {
+            ReleaseCompletedFrames(true);
+            Offset = m_RingBuffer.Allocate(SizeInBytes, m_Alignment);
+        }
+    }
+
+    if (Offset == RingBuffer::InvalidOffset)
+    {
+        if (!m_HeapFullWarningShown)
+        {
+            LOG_WARNING_MESSAGE("Dynamic heap of size ", m_RingBuffer.GetMaxSize(), " is exhausted by the current frame. "
+                                                                                    "Dynamic buffers will fall back to buffer orphaning. Consider increasing EngineGLCreateInfo::DynamicHeapSize.");
+            m_HeapFullWarningShown = true;
+        }
+        return GLDynamicAllocation{};
+    }
+
+    GLDynamicAllocation Allocation;
+    Allocation.pHeap       = this;
+    Allocation.Offset      = static_cast<Uint32>(Offset);
+    Allocation.Size        = SizeInBytes;
+    Allocation.pCPUAddress = m_CPUAddress + Offset;
+#ifdef DILIGENT_DEVELOPMENT
+    Allocation.dvpFrameNumber = m_FrameNumber;
+#endif
+    return Allocation;
+}
+
+void GLDynamicHeap::FinishFrame()
+{
+    m_RingBuffer.FinishCurrentFrame(m_FrameNumber);
+    m_PendingFrames.emplace_back(m_FrameNumber, GLObjectWrappers::GLSyncObj{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+    ++m_FrameNumber;
+
+    ReleaseCompletedFrames(false);
+}
+
+void GLDynamicHeap::ReleaseCompletedFrames(bool WaitForOldestFrame)
+{
+    while (!m_PendingFrames.empty())
+    {
+        auto& FrameFence = m_PendingFrames.front();
+
+        auto res = WaitForOldestFrame ?
+            glClientWaitSync(FrameFence.second, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max()) :
+            glClientWaitSync(FrameFence.second, 0, 0);
+        if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED)
+            break;
+
+        m_CompletedFrameNumber = FrameFence.first;
+        m_PendingFrames.pop_front();
+        WaitForOldestFrame = false;
+    }
+
+    m_RingBuffer.ReleaseCompletedFrames(m_CompletedFrameNumber);
+}
+
+} // namespace Diligent
@@ -393,22 +393,40 @@ public:
     }
 
     template <typename ResourceType>
-    void Bind(ResourceType& Res)
+    void AddLookups(ResourceType& Res)
     {
-        if ((Flags & (1 << Res.GetType())) == 0)
+        if ((Flags & (1 << Res.GetType())) == 0 || (Res.m_Attribs.ShaderStages & ShaderStage) == 0)
             return;
 
+        const auto* VarName = Res.m_Attribs.Name;
+        // Resource names are interned, so their hashes have been computed in advance
+        const auto NameHash = StringInternTable::GetInternedHash(VarName);
         for (Uint16 elem = 0; elem < Res.m_Attribs.ArraySize; ++elem)
         {
-            if ((Res.m_Attribs.ShaderStages & ShaderStage) == 0)
+            if ((Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) && Res.IsBound(elem))
                 continue;
 
-            if ((Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) && Res.IsBound(elem))
+            Batch.AddLookup(&Res, VarName, NameHash, elem);
+        }
+    }
+
+    void ResolveLookups()
+    {
+        Batch.Resolve(ResourceMapping);
+    }
+
+    template <typename ResourceType>
+    void Bind(ResourceType& Res)
+    {
+        if ((Flags & (1 << Res.GetType())) == 0 || (Res.m_Attribs.ShaderStages & ShaderStage) == 0)
+            return;
+
+        for (Uint16 elem = 0; elem < Res.m_Attribs.ArraySize; ++elem)
+        {
+            IDeviceObject* pRes = nullptr;
+            if (!Batch.ConsumeNext(&Res, elem, pRes))
                 continue;
 
-            const auto*                  VarName = Res.m_Attribs.Name;
-            RefCntAutoPtr<IDeviceObject> pRes;
-            ResourceMapping.GetResource(VarName, &pRes, elem);
             if (pRes)
             {
                 //  Call non-virtual function
@@ -417,15 +435,16 @@ public:
             else
             {
                 if ((Flags & BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED) && !Res.IsBound(elem))
-                    LOG_ERROR_MESSAGE("Unable to bind resource to shader variable '", VarName, "': resource is not found in the resource mapping");
+                    LOG_ERROR_MESSAGE("Unable to bind resource to shader variable '", Res.m_Attribs.Name, "': resource is not found in the resource mapping");
             }
         }
     }
 
 private:
-    IResourceMapping& ResourceMapping;
-    const SHADER_TYPE ShaderStage;
-    const Uint32      Flags;
+    IResourceMapping&    ResourceMapping;
+    const SHADER_TYPE    ShaderStage;
+    const Uint32         Flags;
+    ResourceMappingBatch Batch;
 };
 
 
@@ -444,6 +463,33 @@ void GLPipelineResourceLayout::BindResources(SHADER_TYPE ShaderStage, IResourceM
 
     BindResourceHelper BindResHelper(*pResourceMapping, ShaderStage, Flags);
 
+    // Look up all resources in the resource mapping at once
+    // clang-format off
+    HandleResources(
+        [&](UniformBuffBindInfo& ub)
+        {
+            BindResHelper.AddLookups(ub);
+        },
+
+        [&](SamplerBindInfo& sam)
+        {
+            BindResHelper.AddLookups(sam);
+        },
+
+        [&](ImageBindInfo& img)
+        {
+            BindResHelper.AddLookups(img);
+        },
+
+        [&](StorageBufferBindInfo& ssbo)
+        {
+            BindResHelper.AddLookups(ssbo);
+        }
+    );
+    // clang-format on
+
+    BindResHelper.ResolveLookups();
+
     // clang-format off
     HandleResources(
         [&](UniformBuffBindInfo& ub)
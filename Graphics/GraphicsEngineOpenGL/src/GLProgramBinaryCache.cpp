@@ -0,0 +1,193 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <cstring>
+
+#include "GLProgramBinaryCache.hpp"
+#include "RenderDeviceGLImpl.hpp"
+#include "FileWrapper.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct ProgramBinaryFileHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x42504744; // 'DGPB'
+    static constexpr Uint32 ExpectedVersion = 2;
+
+    Uint32 Magic         = ExpectedMagic;
+    Uint32 Version       = ExpectedVersion;
+    Uint32 DriverIdSize  = 0;
+    Uint32 SignatureSize = 0;
+    Uint32 BinaryFormat  = 0;
+    Uint32 BinarySize    = 0;
+};
+// The header is followed by the driver id, the program signature and the program binary
+
+} // namespace
+
+bool GLProgramBinaryCache::IsSupported(RenderDeviceGLImpl& DeviceGL)
+{
+    const auto& DeviceCaps = DeviceGL.GetDeviceCaps();
+
+    bool BinariesSupported = false;
+    if (DeviceCaps.DevType == RENDER_DEVICE_TYPE_GL)
+    {
+        BinariesSupported =
+            (DeviceCaps.MajorVersion > 4 || (DeviceCaps.MajorVersion == 4 && DeviceCaps.MinorVersion >= 1)) ||
+            DeviceGL.CheckExtension("GL_ARB_get_program_binary");
+    }
+    else
+    {
+        BinariesSupported = DeviceCaps.MajorVersion >= 3;
+    }
+    if (!BinariesSupported)
+        return false;
+
+    // The driver may support the entry points, but expose no binary formats (e.g. Mesa without shader cache)
+    GLint NumFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumFormats);
+    CHECK_GL_ERROR("Failed to get the number of program binary formats");
+    return NumFormats > 0;
+}
+
+bool GLProgramBinaryCache::ReadBinary(const ProgramSignature& Signature, ProgramBinary& Binary) const
+{
+    const auto FilePath = GetFilePath(Signature);
+    // Check if the file exists first as opening a non-existent file produces an error message
+    if (!FileSystem::FileExists(FilePath.c_str()))
+        return false;
+
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Read};
+    if (!File)
+        return false;
+
+    const auto FileSize = File->GetSize();
+
+    ProgramBinaryFileHeader Header;
+    if (FileSize < sizeof(Header) || !File->Read(&Header, sizeof(Header)))
+        return false;
+
+    const auto& SignatureStr = Signature.GetString();
+    if (Header.Magic != ProgramBinaryFileHeader::ExpectedMagic ||
+        Header.Version != ProgramBinaryFileHeader::ExpectedVersion ||
+        Header.DriverIdSize != m_DriverId.length() ||
+        Header.SignatureSize != SignatureStr.length() ||
+        FileSize != sizeof(Header) + size_t{Header.DriverIdSize} + size_t{Header.SignatureSize} + size_t{Header.BinarySize})
+    {
+        LOG_INFO_MESSAGE("Program binary '", FilePath, "' is stale or corrupted and will be replaced");
+        return false;
+    }
+
+    // Compare the full driver id and signature to never load the binary of another program
+    std::vector<char> Identity(Header.DriverIdSize + Header.SignatureSize);
+    if (!Identity.empty() && !File->Read(Identity.data(), Identity.size()))
+        return false;
+    if (memcmp(Identity.data(), m_DriverId.data(), m_DriverId.length()) != 0 ||
+        memcmp(Identity.data() + m_DriverId.length(), SignatureStr.data(), SignatureStr.length()) != 0)
+    {
+        LOG_INFO_MESSAGE("Program binary '", FilePath, "' belongs to a different program or driver and will be replaced");
+        return false;
+    }
+
+    Binary.Format = Header.BinaryFormat;
+    Binary.Data.resize(Header.BinarySize);
+    if (!Binary.Data.empty() && !File->Read(Binary.Data.data(), Binary.Data.size()))
+        return false;
+
+    return true;
+}
+
+bool GLProgramBinaryCache::WriteBinary(const ProgramSignature& Signature, const ProgramBinary& Binary) const
+{
+    const auto& SignatureStr = Signature.GetString();
+
+    ProgramBinaryFileHeader Header;
+    Header.DriverIdSize  = static_cast<Uint32>(m_DriverId.length());
+    Header.SignatureSize = static_cast<Uint32>(SignatureStr.length());
+    Header.BinaryFormat  = Binary.Format;
+    Header.BinarySize    = static_cast<Uint32>(Binary.Data.size());
+
+    const auto  FilePath = GetFilePath(Signature);
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_WARNING_MESSAGE("Failed to open program binary file '", FilePath, "' for writing");
+        return false;
+    }
+
+    if (!File->Write(&Header, sizeof(Header)) ||
+        !File->Write(m_DriverId.data(), m_DriverId.length()) ||
+        !File->Write(SignatureStr.data(), SignatureStr.length()) ||
+        !File->Write(Binary.Data.data(), Binary.Data.size()))
+    {
+        LOG_WARNING_MESSAGE("Failed to write program binary file '", FilePath, '\'');
+        return false;
+    }
+
+    return true;
+}
+
+bool GLProgramBinaryCache::Load(const ProgramSignature& Signature, GLuint GLProgram) const
+{
+    ProgramBinary Binary;
+    if (!ReadBinary(Signature, Binary))
+        return false;
+
+    glProgramBinary(GLProgram, Binary.Format, Binary.Data.data(), static_cast<GLsizei>(Binary.Data.size()));
+    // GL_INVALID_ENUM is generated if the binary format is not supported by the driver anymore
+    return glGetError() == GL_NO_ERROR;
+}
+
+void GLProgramBinaryCache::Store(const ProgramSignature& Signature, GLuint GLProgram) const
+{
+    GLint BinaryLength = 0;
+    glGetProgramiv(GLProgram, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    CHECK_GL_ERROR("Failed to get program binary length");
+    if (BinaryLength <= 0)
+        return;
+
+    ProgramBinary Binary;
+    Binary.Data.resize(static_cast<size_t>(BinaryLength));
+    GLsizei BytesWritten = 0;
+    glGetProgramBinary(GLProgram, BinaryLength, &BytesWritten, &Binary.Format, Binary.Data.data());
+    if (glGetError() != GL_NO_ERROR || BytesWritten <= 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to retrieve program binary");
+        return;
+    }
+    Binary.Data.resize(static_cast<size_t>(BytesWritten));
+
+    WriteBinary(Signature, Binary);
+}
+
+} // namespace Diligent
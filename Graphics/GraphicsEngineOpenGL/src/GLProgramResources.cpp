@@ -44,7 +44,6 @@ GLProgramResources::GLProgramResources(GLProgramResources&& Program) noexcept :
     m_Samplers         {Program.m_Samplers             },
     m_Images           {Program.m_Images               },
     m_StorageBlocks    {Program.m_StorageBlocks        },
-    m_StringPool       {std::move(Program.m_StringPool)},
     m_NumUniformBuffers{Program.m_NumUniformBuffers    },
     m_NumSamplers      {Program.m_NumSamplers          },
     m_NumImages        {Program.m_NumImages            },        
@@ -81,29 +80,6 @@ void GLProgramResources::AllocateResources(std::vector<UniformBufferInfo>& Unifo
     m_NumImages         = static_cast<Uint32>(Images.size());
     m_NumStorageBlocks  = static_cast<Uint32>(StorageBlocks.size());
 
-    size_t StringPoolDataSize = 0;
-    for (const auto& ub : UniformBlocks)
-    {
-        StringPoolDataSize += strlen(ub.Name) + 1;
-    }
-
-    for (const auto& sam : Samplers)
-    {
-        StringPoolDataSize += strlen(sam.Name) + 1;
-    }
-
-    for (const auto& img : Images)
-    {
-        StringPoolDataSize += strlen(img.Name) + 1;
-    }
-
-    for (const auto& sb : StorageBlocks)
-    {
-        StringPoolDataSize += strlen(sb.Name) + 1;
-    }
-
-    auto AlignedStringPoolDataSize = Align(StringPoolDataSize, sizeof(void*));
-
     // clang-format off
     size_t TotalMemorySize = 
         m_NumUniformBuffers * sizeof(UniformBufferInfo) + 
@@ -127,8 +103,6 @@ void GLProgramResources::AllocateResources(std::vector<UniformBufferInfo>& Unifo
         return;
     }
 
-    TotalMemorySize += AlignedStringPoolDataSize * sizeof(Char);
-
     auto& MemAllocator = GetRawAllocator();
     void* RawMemory    = ALLOCATE_RAW(MemAllocator, "Memory buffer for GLProgramResources", TotalMemorySize);
 
@@ -137,37 +111,34 @@ void GLProgramResources::AllocateResources(std::vector<UniformBufferInfo>& Unifo
     m_Samplers       = reinterpret_cast<SamplerInfo*>     (m_UniformBuffers + m_NumUniformBuffers);
     m_Images         = reinterpret_cast<ImageInfo*>       (m_Samplers       + m_NumSamplers);
     m_StorageBlocks  = reinterpret_cast<StorageBlockInfo*>(m_Images         + m_NumImages);
-    void* EndOfResourceData =                              m_StorageBlocks + m_NumStorageBlocks;
-    Char* StringPoolData = reinterpret_cast<Char*>(EndOfResourceData);
     // clang-format on
 
-    m_StringPool.AssignMemory(StringPoolData, StringPoolDataSize);
+    // Names are interned rather than copied, so that they are shared by all programs
+    auto& NamesTable = StringInternTable::GetGlobal();
 
     for (Uint32 ub = 0; ub < m_NumUniformBuffers; ++ub)
     {
         auto& SrcUB = UniformBlocks[ub];
-        new (m_UniformBuffers + ub) UniformBufferInfo{SrcUB, m_StringPool};
+        new (m_UniformBuffers + ub) UniformBufferInfo{SrcUB, NamesTable};
     }
 
     for (Uint32 s = 0; s < m_NumSamplers; ++s)
     {
         auto& SrcSam = Samplers[s];
-        new (m_Samplers + s) SamplerInfo{SrcSam, m_StringPool};
+        new (m_Samplers + s) SamplerInfo{SrcSam, NamesTable};
     }
 
     for (Uint32 img = 0; img < m_NumImages; ++img)
     {
         auto& SrcImg = Images[img];
-        new (m_Images + img) ImageInfo{SrcImg, m_StringPool};
+        new (m_Images + img) ImageInfo{SrcImg, NamesTable};
     }
 
     for (Uint32 sb = 0; sb < m_NumStorageBlocks; ++sb)
     {
         auto& SrcSB = StorageBlocks[sb];
-        new (m_StorageBlocks + sb) StorageBlockInfo{SrcSB, m_StringPool};
+        new (m_StorageBlocks + sb) StorageBlockInfo{SrcSB, NamesTable};
     }
-
-    VERIFY_EXPR(m_StringPool.GetRemainingSize() == 0);
 }
 
 GLProgramResources::~GLProgramResources()
@@ -199,6 +199,12 @@
     DECLARE_GL_FUNCTION( glDebugMessageCallback, PFNGLDEBUGMESSAGECALLBACKPROC, GLDEBUGPROC callback, const void *userParam)
 #endif
 
+#ifdef LOAD_DEBUG_GROUP_FUNCTIONS
+    DECLARE_GL_FUNCTION( glPushDebugGroup,     PFNGLPUSHDEBUGGROUPPROC,     GLenum source, GLuint id, GLsizei length, const GLchar *message)
+    DECLARE_GL_FUNCTION( glPopDebugGroup,      PFNGLPOPDEBUGGROUPPROC)
+    DECLARE_GL_FUNCTION( glDebugMessageInsert, PFNGLDEBUGMESSAGEINSERTPROC, GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *buf)
+#endif
+
 void LoadGLFunctions()
 {
 
@@ -366,4 +372,10 @@ Func = (FuncType)eglGetProcAddress( #Func );\
 #ifdef LOAD_DEBUG_MESSAGE_CALLBACK
     LOAD_GL_FUNCTION( glDebugMessageCallback, PFNGLDEBUGMESSAGECALLBACKPROC)
 #endif
+
+#ifdef LOAD_DEBUG_GROUP_FUNCTIONS
+    LOAD_GL_FUNCTION( glPushDebugGroup,     PFNGLPUSHDEBUGGROUPPROC)
+    LOAD_GL_FUNCTION( glPopDebugGroup,      PFNGLPOPDEBUGGROUPPROC)
+    LOAD_GL_FUNCTION( glDebugMessageInsert, PFNGLDEBUGMESSAGEINSERTPROC)
+#endif
 }
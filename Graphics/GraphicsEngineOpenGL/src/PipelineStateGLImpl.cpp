@@ -85,11 +85,19 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*            pRefCoun
             m_ShaderResourceLayoutHash = 0;
             m_ProgramResources.resize(m_NumShaders);
             m_GLPrograms.reserve(m_NumShaders);
+
+            // Start linking all programs before querying the status of any of them, so that
+            // the driver can compile and link them in parallel when it supports it.
+            std::vector<ShaderGLImpl::PendingProgram> PendingPrograms;
+            PendingPrograms.reserve(m_NumShaders);
+            for (Uint32 i = 0; i < m_NumShaders; ++i)
+                PendingPrograms.emplace_back(ShaderGLImpl::BeginLinkProgram(&m_ppShaders[i], 1, true));
+
             for (Uint32 i = 0; i < m_NumShaders; ++i)
             {
                 auto*       pShaderGL  = GetShader<ShaderGLImpl>(i);
                 const auto& ShaderDesc = pShaderGL->GetDesc();
-                m_GLPrograms.emplace_back(ShaderGLImpl::LinkProgram(&m_ppShaders[i], 1, true));
+                m_GLPrograms.emplace_back(ShaderGLImpl::FinishLinkProgram(PendingPrograms[i], &m_ppShaders[i], 1));
                 // Load uniforms and assign bindings
                 m_ProgramResources[i].LoadUniforms(ShaderDesc.ShaderType, m_GLPrograms[i], GLState,
                                                    m_TotalUniformBufferBindings,
@@ -63,7 +63,7 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         pRefCounters,
         RawMemAllocator,
         pEngineFactory,
-        0,
+        InitAttribs.NumDeferredContexts,
         DeviceObjectSizes
         {
             sizeof(TextureBaseGL),
@@ -163,6 +163,8 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         Features.MultiViewport                 = IsGL41OrAbove || CheckExtension("GL_ARB_viewport_array");
         Features.PixelUAVWritesAndAtomics      = IsGL42OrAbove || CheckExtension("GL_ARB_shader_image_load_store");
         Features.TextureUAVExtendedFormats     = False;
+        Features.MultiDrawIndirect             = IsGL43OrAbove || CheckExtension("GL_ARB_multi_draw_indirect");
+        Features.IndirectDrawCount             = CheckExtension("GL_ARB_indirect_parameters"); // Core 4.6 entry points are not used
 
 
         TexCaps.MaxTexture1DDimension     = MaxTextureSize;
@@ -209,6 +211,8 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         Features.MultiViewport                 = strstr(Extensions, "viewport_array");
         Features.PixelUAVWritesAndAtomics      = IsGLES31OrAbove || strstr(Extensions, "shader_image_load_store");
         Features.TextureUAVExtendedFormats     = False;
+        Features.MultiDrawIndirect             = False; // Multi-draw commands are emulated
+        Features.IndirectDrawCount             = False;
 
 
         TexCaps.MaxTexture1DDimension     = 0; // Not supported in GLES 3.2
@@ -232,6 +236,31 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
     const bool bS3TC = CheckExtension("GL_EXT_texture_compression_s3tc");
 
     Features.TextureCompressionBC = bRGTC && bBPTC && bS3TC;
+
+#if defined(GLEW_KHR_parallel_shader_compile) && defined(GLEW_ARB_parallel_shader_compile)
+    // Let the driver use as many compiler threads as it wants. glCompileShader() and glLinkProgram()
+    // then return immediately, and the calls only block when the status of the object is queried.
+    if (GLEW_KHR_parallel_shader_compile && glMaxShaderCompilerThreadsKHR != nullptr)
+    {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        m_ParallelShaderCompilation = glGetError() == GL_NO_ERROR;
+    }
+    else if (GLEW_ARB_parallel_shader_compile && glMaxShaderCompilerThreadsARB != nullptr)
+    {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        m_ParallelShaderCompilation = glGetError() == GL_NO_ERROR;
+    }
+#endif
+    if (m_ParallelShaderCompilation)
+        LOG_INFO_MESSAGE("Parallel shader compilation is enabled");
+
+    if (InitAttribs.ProgramBinaryCacheDir != nullptr)
+    {
+        if (GLProgramBinaryCache::IsSupported(*this))
+            m_pProgramBinaryCache.reset(new GLProgramBinaryCache{InitAttribs.ProgramBinaryCacheDir, GLProgramBinaryCache::GetDriverId()});
+        else
+            LOG_WARNING_MESSAGE("Program binaries are not supported by the device. Program binary cache will be disabled.");
+    }
 }
 
 RenderDeviceGLImpl::~RenderDeviceGLImpl()
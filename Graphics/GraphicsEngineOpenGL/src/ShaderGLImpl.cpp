@@ -50,12 +50,52 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
         CreationAttribs.Desc,
         bIsDeviceInternal
     },
-    m_GLShaderObj{true, GLObjectWrappers::GLShaderObjCreateReleaseHelper{GetGLShaderType(m_Desc.ShaderType)}}
+    m_GLShaderObj{false, GLObjectWrappers::GLShaderObjCreateReleaseHelper{GetGLShaderType(m_Desc.ShaderType)}}
 // clang-format on
 {
     const auto& deviceCaps = pDeviceGL->GetDeviceCaps();
 
-    auto GLSLSource = BuildGLSLSourceString(CreationAttribs, deviceCaps, TargetGLSLCompiler::driver);
+    m_GLSLSource = BuildGLSLSourceString(CreationAttribs, deviceCaps, TargetGLSLCompiler::driver);
+
+    if (deviceCaps.Features.SeparablePrograms)
+    {
+        // The program is loaded from the binary cache when possible. The cache entry contains the
+        // full shader source, so in this case the source has been successfully compiled before
+        // and is not compiled again. Otherwise, the compile status is checked before the link
+        // status, so CreateShader() fails on invalid source as it does without the cache.
+        IShader* ThisShader[] = {this};
+        auto     Pending      = BeginLinkProgram(ThisShader, 1, true);
+        CheckCompileStatus(CreationAttribs.ppCompilerOutput);
+        auto Program = FinishLinkProgram(Pending, ThisShader, 1);
+
+        Uint32 UniformBufferBinding = 0;
+        Uint32 SamplerBinding       = 0;
+        Uint32 ImageBinding         = 0;
+        Uint32 StorageBufferBinding = 0;
+        auto   pImmediateCtx        = m_pDevice->GetImmediateContext();
+        VERIFY_EXPR(pImmediateCtx);
+        auto& GLState = pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState();
+        m_Resources.LoadUniforms(m_Desc.ShaderType, Program, GLState, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding);
+    }
+    else
+    {
+        Compile();
+        CheckCompileStatus(CreationAttribs.ppCompilerOutput);
+    }
+}
+
+ShaderGLImpl::~ShaderGLImpl()
+{
+}
+
+IMPLEMENT_QUERY_INTERFACE(ShaderGLImpl, IID_ShaderGL, TShaderBase)
+
+
+void ShaderGLImpl::Compile()
+{
+    VERIFY(m_CompileStatus == CompileStatus::NotCompiled, "The shader has already been compiled");
+
+    m_GLShaderObj.Create();
 
     // Note: there is a simpler way to create the program:
     //m_uiShaderSeparateProg = glCreateShaderProgramv(GL_VERTEX_SHADER, _countof(ShaderStrings), ShaderStrings);
@@ -71,24 +111,38 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     // Each element in the length array may contain the length of the corresponding string
     // (the null character is not counted as part of the string length).
     // Not specifying lengths causes shader compilation errors on Android
-    const char* ShaderStrings[] = {GLSLSource.c_str()};
-    GLint       Lenghts[]       = {static_cast<GLint>(GLSLSource.length())};
+    const char* ShaderStrings[] = {m_GLSLSource.c_str()};
+    GLint       Lenghts[]       = {static_cast<GLint>(m_GLSLSource.length())};
 
     // Provide source strings (the strings will be saved in internal OpenGL memory)
     glShaderSource(m_GLShaderObj, _countof(ShaderStrings), ShaderStrings, Lenghts);
     // When the shader is compiled, it will be compiled as if all of the given strings were concatenated end-to-end.
     glCompileShader(m_GLShaderObj);
+
+    m_CompileStatus = CompileStatus::Pending;
+}
+
+GLuint ShaderGLImpl::GetCompiledGLShader()
+{
+    if (m_CompileStatus == CompileStatus::NotCompiled)
+        Compile();
+    return m_GLShaderObj;
+}
+
+void ShaderGLImpl::CheckCompileStatus(IDataBlob** ppCompilerOutput)
+{
+    if (m_CompileStatus != CompileStatus::Pending)
+        return;
+
     GLint compiled = GL_FALSE;
     // Get compilation status
     glGetShaderiv(m_GLShaderObj, GL_COMPILE_STATUS, &compiled);
     if (!compiled)
     {
-        std::string FullSource;
-        for (const auto* str : ShaderStrings)
-            FullSource.append(str);
+        const auto& FullSource = m_GLSLSource;
 
         std::stringstream ErrorMsgSS;
-        ErrorMsgSS << "Failed to compile shader file '" << (CreationAttribs.Desc.Name != nullptr ? CreationAttribs.Desc.Name : "") << '\'' << std::endl;
+        ErrorMsgSS << "Failed to compile shader file '" << (m_Desc.Name != nullptr ? m_Desc.Name : "") << '\'' << std::endl;
         int infoLogLen = 0;
         // The function glGetShaderiv() tells how many bytes to allocate; the length includes the NULL terminator.
         glGetShaderiv(m_GLShaderObj, GL_INFO_LOG_LENGTH, &infoLogLen);
@@ -106,7 +160,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
                        << infoLog.data() << std::endl;
         }
 
-        if (CreationAttribs.ppCompilerOutput != nullptr)
+        if (ppCompilerOutput != nullptr)
         {
             // infoLogLen accounts for null terminator
             auto* pOutputDataBlob = MakeNewRCObj<DataBlobImpl>()(infoLogLen + FullSource.length() + 1);
@@ -114,7 +168,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
             if (infoLogLen > 0)
                 memcpy(DataPtr, infoLog.data(), infoLogLen);
             memcpy(DataPtr + infoLogLen, FullSource.data(), FullSource.length() + 1);
-            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(CreationAttribs.ppCompilerOutput));
+            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppCompilerOutput));
         }
         else
         {
@@ -127,42 +181,19 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
         LOG_ERROR_AND_THROW(ErrorMsgSS.str().c_str());
     }
 
-    if (deviceCaps.Features.SeparablePrograms)
-    {
-        IShader*                       ThisShader[]         = {this};
-        GLObjectWrappers::GLProgramObj Program              = LinkProgram(ThisShader, 1, true);
-        Uint32                         UniformBufferBinding = 0;
-        Uint32                         SamplerBinding       = 0;
-        Uint32                         ImageBinding         = 0;
-        Uint32                         StorageBufferBinding = 0;
-        auto                           pImmediateCtx        = m_pDevice->GetImmediateContext();
-        VERIFY_EXPR(pImmediateCtx);
-        auto& GLState = pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState();
-        m_Resources.LoadUniforms(m_Desc.ShaderType, Program, GLState, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding);
-    }
-}
-
-ShaderGLImpl::~ShaderGLImpl()
-{
+    m_CompileStatus = CompileStatus::Succeeded;
+    // The source is not needed anymore unless it identifies programs in the binary cache
+    if (m_pDevice->GetProgramBinaryCache() == nullptr)
+        String{}.swap(m_GLSLSource);
 }
 
-IMPLEMENT_QUERY_INTERFACE(ShaderGLImpl, IID_ShaderGL, TShaderBase)
 
-
-GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(IShader** ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
+void ShaderGLImpl::AttachShadersAndLink(GLuint GLProg, IShader** ppShaders, Uint32 NumShaders)
 {
-    VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
-
-    GLObjectWrappers::GLProgramObj GLProg(true);
-
-    // GL_PROGRAM_SEPARABLE parameter must be set before linking!
-    if (IsSeparableProgram)
-        glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
-
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
         auto* pCurrShader = ValidatedCast<ShaderGLImpl>(ppShaders[i]);
-        glAttachShader(GLProg, pCurrShader->m_GLShaderObj);
+        glAttachShader(GLProg, pCurrShader->GetCompiledGLShader());
         CHECK_GL_ERROR("glAttachShader() failed");
     }
 
@@ -178,9 +209,75 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(IShader** ppShaders, Ui
     //of the inputs on the interface will be undefined.
     glLinkProgram(GLProg);
     CHECK_GL_ERROR("glLinkProgram() failed");
+}
+
+ShaderGLImpl::PendingProgram ShaderGLImpl::BeginLinkProgram(IShader** ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
+{
+    VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
+    VERIFY_EXPR(NumShaders > 0);
+
+    PendingProgram Pending;
+    Pending.Program.Create();
+    Pending.IsSeparable = IsSeparableProgram;
+
+    // GL_PROGRAM_SEPARABLE parameter must be set before linking or loading the binary!
+    if (IsSeparableProgram)
+        glProgramParameteri(Pending.Program, GL_PROGRAM_SEPARABLE, GL_TRUE);
+
+    auto* pBinaryCache = ValidatedCast<ShaderGLImpl>(ppShaders[0])->GetDevice()->GetProgramBinaryCache();
+    if (pBinaryCache != nullptr)
+    {
+        Pending.pSignature.reset(new GLProgramBinaryCache::ProgramSignature{IsSeparableProgram});
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            const auto* pShaderGL = ValidatedCast<const ShaderGLImpl>(ppShaders[i]);
+            Pending.pSignature->AddStage(pShaderGL->m_Desc.ShaderType, pShaderGL->m_GLSLSource);
+        }
+
+        if (pBinaryCache->Load(*Pending.pSignature, Pending.Program))
+        {
+            Pending.LoadedFromCache = true;
+            return Pending;
+        }
+
+        glProgramParameteri(Pending.Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    AttachShadersAndLink(Pending.Program, ppShaders, NumShaders);
+
+    return Pending;
+}
+
+GLObjectWrappers::GLProgramObj ShaderGLImpl::FinishLinkProgram(PendingProgram& Pending, IShader** ppShaders, Uint32 NumShaders)
+{
+    const GLuint GLProg = Pending.Program;
+
     int IsLinked = GL_FALSE;
     glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
     CHECK_GL_ERROR("glGetProgramiv() failed");
+
+    if (Pending.LoadedFromCache)
+    {
+        if (IsLinked)
+            return std::move(Pending.Program);
+
+        // The driver may reject the binary, e.g. after an update. Link the program from the
+        // source; the program object remains valid after glProgramBinary() fails.
+        LOG_INFO_MESSAGE("Program binary was rejected by the driver. The program will be linked from the source.");
+        Pending.LoadedFromCache = false;
+        glProgramParameteri(GLProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        AttachShadersAndLink(GLProg, ppShaders, NumShaders);
+        glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
+        CHECK_GL_ERROR("glGetProgramiv() failed");
+    }
+
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        // Compile errors are more informative than the link error. If the
+        // program was linked successfully, this does not block.
+        ValidatedCast<ShaderGLImpl>(ppShaders[i])->CheckCompileStatus(nullptr);
+    }
+
     if (!IsLinked)
     {
         int LengthWithNull = 0, Length = 0;
@@ -205,7 +302,20 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(IShader** ppShaders, Ui
         CHECK_GL_ERROR("glDetachShader() failed");
     }
 
-    return GLProg;
+    if (IsLinked && Pending.pSignature)
+    {
+        auto* pBinaryCache = ValidatedCast<ShaderGLImpl>(ppShaders[0])->GetDevice()->GetProgramBinaryCache();
+        VERIFY_EXPR(pBinaryCache != nullptr);
+        pBinaryCache->Store(*Pending.pSignature, GLProg);
+    }
+
+    return std::move(Pending.Program);
+}
+
+GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(IShader** ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
+{
+    auto Pending = BeginLinkProgram(ppShaders, NumShaders, IsSeparableProgram);
+    return FinishLinkProgram(Pending, ppShaders, NumShaders);
 }
 
 Uint32 ShaderGLImpl::GetResourceCount() const
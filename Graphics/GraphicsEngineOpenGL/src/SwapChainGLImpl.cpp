@@ -106,12 +106,14 @@ void SwapChainGLImpl::Present(Uint32 SyncInterval)
 #    error Unsupported platform
 #endif
 
-    // Unbind back buffer from device context to be consistent with other backends
     if (auto pDeviceContext = m_wpDeviceContext.Lock())
     {
         auto* pDeviceCtxGl = pDeviceContext.RawPtr<DeviceContextGLImpl>();
-        auto* pBackBuffer  = ValidatedCast<TextureBaseGL>(m_pRenderTargetView->GetTexture());
+        // Unbind back buffer from device context to be consistent with other backends
+        auto* pBackBuffer = ValidatedCast<TextureBaseGL>(m_pRenderTargetView->GetTexture());
         pDeviceCtxGl->UnbindTextureFromFramebuffer(pBackBuffer, false);
+        // Release the dynamic heap space used by the frame
+        pDeviceCtxGl->FinishFrame();
     }
 }
 
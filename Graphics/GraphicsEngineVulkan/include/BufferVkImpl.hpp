@@ -117,6 +117,9 @@ public:
         return reinterpret_cast<Uint8*>(m_MemoryAllocation.Page->GetCPUMemory()) + m_BufferMemoryAlignedOffset;
     }
 
+    // Returns the id of the initial data upload, see InitialDataUploader::GetUploadFenceValue()
+    Uint64 GetInitialDataUploadId() const { return m_InitialDataUploadId; }
+
 private:
     friend class DeviceContextVkImpl;
 
@@ -126,6 +129,7 @@ private:
 
     Uint32       m_DynamicOffsetAlignment    = 0;
     VkDeviceSize m_BufferMemoryAlignedOffset = 0;
+    Uint64       m_InitialDataUploadId       = 0;
 
     std::vector<VulkanDynamicAllocation, STDAllocatorRawMem<VulkanDynamicAllocation>> m_DynamicAllocations;
 
@@ -49,7 +49,8 @@ public:
 
     CommandQueueVkImpl(IReferenceCounters*                                   pRefCounters,
                        std::shared_ptr<VulkanUtilities::VulkanLogicalDevice> LogicalDevice,
-                       uint32_t                                              QueueFamilyIndex);
+                       uint32_t                                              QueueFamilyIndex,
+                       uint32_t                                              QueueIndex = 0);
     ~CommandQueueVkImpl();
 
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
@@ -143,6 +143,12 @@ public:
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
 
+    /// Implementation of IDeviceContext::MultiDrawIndirect() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+
+    /// Implementation of IDeviceContext::MultiDrawIndexedIndirect() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+
     /// Implementation of IDeviceContext::DispatchCompute() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DispatchCompute        (const DispatchComputeAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DispatchComputeIndirect() in Vulkan backend.
@@ -320,10 +326,20 @@ public:
                                                               ITexture*                               pDstTexture,
                                                               const ResolveTextureSubresourceAttribs& ResolveAttribs) override final;
 
+    /// Implementation of IDeviceContext::BeginDebugGroup() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE BeginDebugGroup(const Char* Name, const float* pColor) override final;
+
+    /// Implementation of IDeviceContext::EndDebugGroup() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE EndDebugGroup() override final;
+
+    /// Implementation of IDeviceContext::InsertDebugLabel() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE InsertDebugLabel(const Char* Label, const float* pColor) override final;
+
     VkDescriptorSet AllocateDynamicDescriptorSet(VkDescriptorSetLayout SetLayout, const char* DebugName = "")
     {
         // Descriptor pools are externally synchronized, meaning that the application must not allocate
         // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
+        UpdateStats(&DeviceContextStats::NumDescriptorSetAllocations);
         return m_DynamicDescrSetAllocator.Allocate(SetLayout, DebugName);
     }
 
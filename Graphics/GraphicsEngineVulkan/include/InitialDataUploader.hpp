@@ -0,0 +1,243 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::InitialDataUploader class
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "BasicTypes.h"
+#include "RenderDeviceVk.h"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "VulkanUtilities/VulkanMemoryManager.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Batches initial data uploads and initial layout transitions of buffers and textures.
+
+/// Resource constructors record their copy or clear commands into a command buffer shared with
+/// other resources instead of submitting a command buffer each. The batch is submitted when its
+/// total upload size or age exceeds the limits, when the immediate context submits its commands,
+/// or when Flush() is called explicitly.
+///
+/// If the device has a transfer queue, commands that the transfer queue family supports are recorded
+/// into a separate command buffer that is executed by the transfer queue. The graphics queue waits
+/// for it through a semaphore and acquires ownership of the written resources if the queue families
+/// differ, so that all uploads are complete when subsequent graphics queue commands start.
+class InitialDataUploader
+{
+public:
+    InitialDataUploader(RenderDeviceVkImpl& DeviceVkImpl,
+                        Uint32              CmdQueueIndex,
+                        Uint32              TransferQueueIndex,
+                        Uint64              MaxBatchSize,
+                        Uint32              MaxBatchDelay) noexcept;
+
+    // clang-format off
+    InitialDataUploader             (const InitialDataUploader&)  = delete;
+    InitialDataUploader             (      InitialDataUploader&&) = delete;
+    InitialDataUploader& operator = (const InitialDataUploader&)  = delete;
+    InitialDataUploader& operator = (      InitialDataUploader&&) = delete;
+    // clang-format on
+
+    ~InitialDataUploader();
+
+    /// Resource written by the recorded commands
+    struct UploadTarget
+    {
+        VkBuffer           vkBuffer   = VK_NULL_HANDLE;
+        VkImage            vkImage    = VK_NULL_HANDLE;
+        VkImageAspectFlags AspectMask = 0;
+
+        // Queue capabilities any of which is sufficient to execute the commands.
+        // Copies only require transfer queues, clears require graphics or compute queues.
+        VkQueueFlags QueueFlags = VK_QUEUE_TRANSFER_BIT;
+
+        static UploadTarget Buffer(VkBuffer vkBuffer)
+        {
+            UploadTarget Target;
+            Target.vkBuffer = vkBuffer;
+            return Target;
+        }
+
+        static UploadTarget Image(VkImage vkImage, VkImageAspectFlags AspectMask, VkQueueFlags QueueFlags = VK_QUEUE_TRANSFER_BIT)
+        {
+            UploadTarget Target;
+            Target.vkImage    = vkImage;
+            Target.AspectMask = AspectMask;
+            Target.QueueFlags = QueueFlags;
+            return Target;
+        }
+    };
+
+    /// Records commands that initialize a resource into the current batch.
+
+    /// \param [in] Target         - Resource written by the commands. The resource must be left
+    ///                              in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL layout (images) and
+    ///                              must only be written by transfer operations.
+    /// \param [in] RecordCommands - Function that records the commands into the command buffer
+    ///                              passed as the only argument. The function is called while
+    ///                              the batch is locked and must not throw.
+    /// \param [in] UploadSize     - Size of the uploaded data that counts towards the batch size limit.
+    /// \param [in] StagingBuffer  - Staging buffer the data is copied from, may be empty.
+    /// \param [in] StagingMemory  - Memory of the staging buffer, may be empty.
+    ///
+    /// \return     Upload id that can be passed to GetUploadFenceValue().
+    ///
+    /// \remarks    The staging buffer and its memory are released once the GPU has executed the batch.
+    template <typename RecordCommandsType>
+    Uint64 RecordUpload(const UploadTarget&                       Target,
+                        RecordCommandsType                        RecordCommands,
+                        Uint64                                    UploadSize,
+                        VulkanUtilities::BufferWrapper&&          StagingBuffer,
+                        VulkanUtilities::VulkanMemoryAllocation&& StagingMemory)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        const auto                  QueueId = SelectQueue(Target.QueueFlags);
+        RecordCommands(GetBatchCommandBuffer(QueueId));
+        if (QueueId == BATCH_QUEUE_TRANSFER)
+            AddTransferQueueTarget(Target);
+        return AddUpload(QueueId, UploadSize, std::move(StagingBuffer), std::move(StagingMemory));
+    }
+
+    /// Records a copy into an image on the transfer queue, if the image can be written by it.
+
+    /// \param [in] vkImage        - Destination image.
+    /// \param [in] AspectMask     - Image aspect mask.
+    /// \param [in] IsUninitialized- Whether the image has never been used by the GPU.
+    /// \param [in] RecordCommands - Function that records the commands. It takes the command buffer and
+    ///                              a flag indicating that the image must be transitioned from
+    ///                              VK_IMAGE_LAYOUT_UNDEFINED to VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL layout.
+    /// \param [in] UploadSize     - Size of the copied data that counts towards the batch size limit.
+    ///
+    /// \return     Upload id, or zero if there is no transfer queue or the image has been used by another
+    ///             queue and cannot be written by the transfer queue without an ownership transfer.
+    template <typename RecordCommandsType>
+    Uint64 RecordTransferQueueCopy(VkImage            vkImage,
+                                   VkImageAspectFlags AspectMask,
+                                   bool               IsUninitialized,
+                                   RecordCommandsType RecordCommands,
+                                   Uint64             UploadSize)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        if (!HasTransferQueue())
+            return 0;
+
+        const bool IsPending = IsPendingOnTransferQueue(vkImage);
+        if (!IsPending && !IsUninitialized)
+            return 0;
+
+        RecordCommands(GetBatchCommandBuffer(BATCH_QUEUE_TRANSFER), !IsPending);
+        if (!IsPending)
+            AddTransferQueueTarget(UploadTarget::Image(vkImage, AspectMask));
+        return AddUpload(BATCH_QUEUE_TRANSFER, UploadSize, VulkanUtilities::BufferWrapper{}, VulkanUtilities::VulkanMemoryAllocation{});
+    }
+
+    /// Submits the pending batch, if any, and returns the fence value that the command queue
+    /// will signal when all uploads submitted so far are complete.
+    Uint64 Flush();
+
+    /// Returns the fence value that the command queue will signal when the upload is complete,
+    /// or zero if the upload is known to be complete. If the upload is pending, the batch is submitted.
+    Uint64 GetUploadFenceValue(Uint64 UploadId);
+
+    bool HasTransferQueue() const { return m_TransferQueueIndex != m_CmdQueueIndex; }
+
+    /// Returns transfer queue statistics, see IRenderDeviceVk::GetTransferQueueStats().
+    void GetTransferQueueStats(TransferQueueStatsVk& Stats);
+
+private:
+    enum BATCH_QUEUE : Uint32
+    {
+        BATCH_QUEUE_GRAPHICS = 0,
+        BATCH_QUEUE_TRANSFER,
+        BATCH_QUEUE_COUNT
+    };
+
+    // The following methods must be called while m_Mutex is locked
+    BATCH_QUEUE     SelectQueue(VkQueueFlags RequiredQueueFlags) const;
+    VkCommandBuffer GetBatchCommandBuffer(BATCH_QUEUE QueueId);
+    bool            IsPendingOnTransferQueue(VkImage vkImage) const;
+    void            AddTransferQueueTarget(const UploadTarget& Target);
+    Uint64          AddUpload(BATCH_QUEUE QueueId, Uint64 UploadSize, VulkanUtilities::BufferWrapper&& StagingBuffer, VulkanUtilities::VulkanMemoryAllocation&& StagingMemory);
+    void            SubmitBatch();
+    void            UpdateTransferQueueBusyTime(std::chrono::steady_clock::time_point Now);
+
+    RenderDeviceVkImpl&             m_DeviceVkImpl;
+    const Uint32                    m_CmdQueueIndex;
+    const Uint32                    m_TransferQueueIndex;
+    const Uint64                    m_MaxBatchSize;
+    const std::chrono::milliseconds m_MaxBatchDelay;
+
+    // Queue families of the graphics and transfer queues and capabilities of the transfer queue family
+    const Uint32       m_QueueFamilyIndex;
+    const Uint32       m_TransferQueueFamilyIndex;
+    const VkQueueFlags m_TransferQueueFlags;
+
+    std::mutex m_Mutex;
+
+    // Current batch
+    struct BatchCommandBuffer
+    {
+        VulkanUtilities::CommandPoolWrapper CmdPool;
+        VkCommandBuffer                     vkCmdBuff = VK_NULL_HANDLE;
+    };
+    BatchCommandBuffer                                   m_CmdBuffs[BATCH_QUEUE_COUNT];
+    Uint64                                               m_BatchId   = 1;
+    Uint64                                               m_BatchSize = 0;
+    std::chrono::steady_clock::time_point                m_BatchStartTime;
+    std::vector<VulkanUtilities::BufferWrapper>          m_StagingBuffers;
+    std::vector<VulkanUtilities::VulkanMemoryAllocation> m_StagingMemory;
+
+    // Resources written by the transfer queue in the current batch. The same barriers are used to
+    // release ownership on the transfer queue and acquire it on the graphics queue.
+    std::vector<VkImageMemoryBarrier>  m_TransferImageBarriers;
+    std::vector<VkBufferMemoryBarrier> m_TransferBufferBarriers;
+
+    // Batches that have been submitted, but may not have been completed by the GPU yet: {batch id, fence value}
+    std::deque<std::pair<Uint64, Uint64>> m_SubmittedBatches;
+
+    Uint64 m_LastSubmittedFenceValue = 0;
+
+    // Transfer queue statistics
+    TransferQueueStatsVk                        m_TransferStats;
+    const std::chrono::steady_clock::time_point m_CreationTime;
+    std::chrono::steady_clock::time_point       m_TransferBusyStartTime;
+    std::chrono::duration<double>               m_TransferBusyTime{0};
+    Uint64                                      m_LastTransferFenceValue = 0;
+    bool                                        m_IsTransferQueueBusy    = false;
+};
+
+} // namespace Diligent
@@ -48,6 +48,7 @@
 #include "FramebufferCache.hpp"
 #include "RenderPassCache.hpp"
 #include "CommandPoolManager.hpp"
+#include "InitialDataUploader.hpp"
 
 namespace Diligent
 {
@@ -119,6 +120,18 @@ public:
                                                                    RESOURCE_STATE    InitialState,
                                                                    IBuffer**         ppBuffer) override final;
 
+    /// Implementation of IRenderDeviceVk::FlushInitialDataUploads().
+    virtual Uint64 DILIGENT_CALL_TYPE FlushInitialDataUploads() override final;
+
+    /// Implementation of IRenderDeviceVk::GetInitialDataFenceValue().
+    virtual Uint64 DILIGENT_CALL_TYPE GetInitialDataFenceValue(IDeviceObject* pResource) override final;
+
+    /// Implementation of IRenderDeviceVk::CopyTextureOnTransferQueue().
+    virtual Bool DILIGENT_CALL_TYPE CopyTextureOnTransferQueue(const CopyTextureAttribs& CopyAttribs) override final;
+
+    /// Implementation of IRenderDeviceVk::GetTransferQueueStats().
+    virtual void DILIGENT_CALL_TYPE GetTransferQueueStats(TransferQueueStatsVk& Stats) override final;
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
@@ -126,8 +139,14 @@ public:
     // The method returns fence value associated with the submitted command buffer
     Uint64 ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmitInfo& SubmitInfo, class DeviceContextVkImpl* pImmediateCtx, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pSignalFences);
 
-    void AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName = nullptr);
-    void ExecuteAndDisposeTransientCmdBuff(Uint32 QueueIndex, VkCommandBuffer vkCmdBuff, VulkanUtilities::CommandPoolWrapper&& CmdPool);
+    // QueueIndex is the index of the queue the command buffer will be submitted to
+    void AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName = nullptr, Uint32 QueueIndex = 0);
+    // Returns the fence value associated with the submitted command buffer
+    Uint64 ExecuteAndDisposeTransientCmdBuff(Uint32                                QueueIndex,
+                                             VkCommandBuffer                       vkCmdBuff,
+                                             VulkanUtilities::CommandPoolWrapper&& CmdPool,
+                                             VkSemaphore                           WaitSemaphore   = VK_NULL_HANDLE,
+                                             VkSemaphore                           SignalSemaphore = VK_NULL_HANDLE);
 
     /// Implementation of IRenderDevice::ReleaseStaleResources() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final;
@@ -154,11 +173,23 @@ public:
 
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
+    InitialDataUploader& GetInitialDataUploader() { return m_InitialDataUploader; }
+
+    const EngineVkCreateInfo& GetEngineAttribs() const { return m_EngineAttribs; }
+
     void FlushStaleResources(Uint32 CmdQueueIndex);
 
+    // Returns the index of the dedicated transfer queue, or 0 if the device does not have one
+    Uint32 GetTransferQueueIndex() const { return m_TransferQueueIndex; }
+
 private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
 
+    CommandPoolManager& GetTransientCmdPoolMgr(Uint32 QueueIndex)
+    {
+        return (QueueIndex != 0 && QueueIndex == m_TransferQueueIndex) ? m_TransferCmdPoolMgr : m_TransientCmdPoolMgr;
+    }
+
     // Submits command buffer for execution to the command queue
     // Returns the submitted command buffer number and the fence value
     // Parameters:
@@ -172,6 +203,10 @@ private:
 
     EngineVkCreateInfo m_EngineAttribs;
 
+    // Index of the command queue that executes initial data uploads and transfer queue copies,
+    // or 0 if the device does not have a dedicated transfer queue.
+    const Uint32 m_TransferQueueIndex;
+
     FramebufferCache       m_FramebufferCache;
     RenderPassCache        m_RenderPassCache;
     DescriptorSetAllocator m_DescriptorSetAllocator;
@@ -181,10 +216,16 @@ private:
     // issue copy commands. Vulkan requires that every command pool is used by one thread
     // at a time, so every constructor must allocate command buffer from its own pool.
     CommandPoolManager m_TransientCmdPoolMgr;
+    // Transient command pools of the transfer queue family used by the initial data uploader
+    CommandPoolManager m_TransferCmdPoolMgr;
 
     VulkanUtilities::VulkanMemoryManager m_MemoryMgr;
 
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
+
+    // Buffer and texture constructors record initial data uploads into command buffers
+    // shared by many resources to avoid submitting a command buffer per resource.
+    InitialDataUploader m_InitialDataUploader;
 };
 
 } // namespace Diligent
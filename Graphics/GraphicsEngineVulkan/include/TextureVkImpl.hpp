@@ -44,6 +44,14 @@ class FixedBlockMemoryAllocator;
 
 Uint32 GetStagingDataOffset(const TextureDesc& TexDesc, Uint32 ArraySlice, Uint32 MipLevel, Uint32 Alignment = 4);
 
+// Returns the buffer-image copy region for the given mip level and array slice
+VkBufferImageCopy GetBufferImageCopyInfo(Uint32             BufferOffset,
+                                         Uint32             BufferRowStrideInTexels,
+                                         const TextureDesc& TexDesc,
+                                         const Box&         Region,
+                                         Uint32             MipLevel,
+                                         Uint32             ArraySlice);
+
 /// Texture object implementation in Vulkan backend.
 class TextureVkImpl final : public TextureBase<ITextureVk, RenderDeviceVkImpl, TextureViewVkImpl, FixedBlockMemoryAllocator>
 {
@@ -101,6 +109,10 @@ public:
 
     void InvalidateStagingRange(VkDeviceSize Offset, VkDeviceSize Size);
 
+    // Returns the id of the initial data upload, see InitialDataUploader::GetUploadFenceValue()
+    Uint64 GetInitialDataUploadId() const { return m_InitialDataUploadId; }
+    void   SetInitialDataUploadId(Uint64 UploadId) { m_InitialDataUploadId = UploadId; }
+
 protected:
     void CreateViewInternal(const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView) override;
     //void PrepareVkInitData(const TextureData &InitData, Uint32 NumSubresources, std::vector<Vk_SUBRESOURCE_DATA> &VkInitData);
@@ -114,6 +126,7 @@ protected:
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
     VkDeviceSize                            m_StagingDataAlignedOffset;
     bool                                    m_bCSBasedMipGenerationSupported = false;
+    Uint64                                  m_InitialDataUploadId            = 0;
 };
 
 } // namespace Diligent
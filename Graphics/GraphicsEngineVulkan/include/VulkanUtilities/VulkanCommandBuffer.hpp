@@ -36,8 +36,12 @@ namespace VulkanUtilities
 class VulkanCommandBuffer
 {
 public:
-    VulkanCommandBuffer(VkPipelineStageFlags EnabledGraphicsShaderStages) noexcept :
-        m_EnabledGraphicsShaderStages{EnabledGraphicsShaderStages}
+    VulkanCommandBuffer(VkPipelineStageFlags                 EnabledGraphicsShaderStages,
+                        PFN_vkCmdDrawIndirectCountKHR        CmdDrawIndirectCount        = nullptr,
+                        PFN_vkCmdDrawIndexedIndirectCountKHR CmdDrawIndexedIndirectCount = nullptr) noexcept :
+        m_EnabledGraphicsShaderStages{EnabledGraphicsShaderStages},
+        m_vkCmdDrawIndirectCount{CmdDrawIndirectCount},
+        m_vkCmdDrawIndexedIndirectCount{CmdDrawIndexedIndirectCount}
     {}
 
     // clang-format off
@@ -138,6 +142,27 @@ public:
         vkCmdDrawIndexedIndirect(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
     }
 
+    __forceinline void DrawIndirectCount(VkBuffer Buffer, VkDeviceSize Offset, VkBuffer CountBuffer, VkDeviceSize CountBufferOffset, uint32_t MaxDrawCount, uint32_t Stride)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirectCountKHR() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+        VERIFY(m_vkCmdDrawIndirectCount != nullptr, "VK_KHR_draw_indirect_count extension is not enabled");
+
+        m_vkCmdDrawIndirectCount(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
+    }
+
+    __forceinline void DrawIndexedIndirectCount(VkBuffer Buffer, VkDeviceSize Offset, VkBuffer CountBuffer, VkDeviceSize CountBufferOffset, uint32_t MaxDrawCount, uint32_t Stride)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndexedIndirectCountKHR() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+        VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
+        VERIFY(m_vkCmdDrawIndexedIndirectCount != nullptr, "VK_KHR_draw_indirect_count extension is not enabled");
+
+        m_vkCmdDrawIndexedIndirectCount(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
+    }
+
     __forceinline void Dispatch(uint32_t GroupCountX, uint32_t GroupCountY, uint32_t GroupCountZ)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
@@ -561,6 +586,9 @@ private:
     StateCache                 m_State;
     VkCommandBuffer            m_VkCmdBuffer = VK_NULL_HANDLE;
     const VkPipelineStageFlags m_EnabledGraphicsShaderStages;
+
+    const PFN_vkCmdDrawIndirectCountKHR        m_vkCmdDrawIndirectCount;
+    const PFN_vkCmdDrawIndexedIndirectCountKHR m_vkCmdDrawIndexedIndirectCount;
 };
 
 } // namespace VulkanUtilities
@@ -209,6 +209,10 @@ public:
 
     VkPipelineStageFlags GetEnabledGraphicsShaderStages() const { return m_EnabledGraphicsShaderStages; }
 
+    // Entry points of VK_KHR_draw_indirect_count extension. Null if the extension is not enabled.
+    PFN_vkCmdDrawIndirectCountKHR        GetCmdDrawIndirectCountProc() const { return m_vkCmdDrawIndirectCountKHR; }
+    PFN_vkCmdDrawIndexedIndirectCountKHR GetCmdDrawIndexedIndirectCountProc() const { return m_vkCmdDrawIndexedIndirectCountKHR; }
+
 private:
     VulkanLogicalDevice(VkPhysicalDevice             vkPhysicalDevice,
                         const VkDeviceCreateInfo&    DeviceCI,
@@ -226,6 +230,9 @@ private:
     VkDevice                           m_VkDevice = VK_NULL_HANDLE;
     const VkAllocationCallbacks* const m_VkAllocator;
     VkPipelineStageFlags               m_EnabledGraphicsShaderStages = 0;
+
+    PFN_vkCmdDrawIndirectCountKHR        m_vkCmdDrawIndirectCountKHR        = nullptr;
+    PFN_vkCmdDrawIndexedIndirectCountKHR m_vkCmdDrawIndexedIndirectCountKHR = nullptr;
 };
 
 } // namespace VulkanUtilities
@@ -57,9 +57,10 @@ public:
 
     uint32_t GetMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
 
-    const VkPhysicalDeviceProperties& GetProperties() const { return m_Properties; }
-    const VkPhysicalDeviceFeatures&   GetFeatures() const { return m_Features; }
-    VkFormatProperties                GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const;
+    const VkPhysicalDeviceProperties&           GetProperties() const { return m_Properties; }
+    const VkPhysicalDeviceFeatures&             GetFeatures() const { return m_Features; }
+    const std::vector<VkQueueFamilyProperties>& GetQueueFamilyProperties() const { return m_QueueFamilyProperties; }
+    VkFormatProperties                          GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const;
 
 private:
     VulkanPhysicalDevice(VkPhysicalDevice vkDevice);
@@ -31,6 +31,7 @@
 /// Definition of the Diligent::IRenderDeviceVk interface
 
 #include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
@@ -38,6 +39,39 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_RenderDeviceVk =
     {0xab8cf3a6, 0xd959, 0x41c1, {0xae, 0x0, 0xa5, 0x8a, 0xe9, 0x82, 0xe, 0x6a}};
 
+// clang-format off
+
+/// Statistics of the queue that executes initial data uploads and transfer queue copies
+struct TransferQueueStatsVk
+{
+    /// Index of the command queue that executes the uploads, or 0 if the device
+    /// does not have a dedicated transfer queue.
+    Uint32 QueueIndex            DEFAULT_INITIALIZER(0);
+
+    /// Number of command buffers submitted to the transfer queue.
+    Uint32 NumBatches            DEFAULT_INITIALIZER(0);
+
+    /// Number of uploads and copies executed by the transfer queue.
+    Uint64 NumUploads            DEFAULT_INITIALIZER(0);
+
+    /// Total size of the data uploaded through the transfer queue, in bytes.
+    Uint64 BytesUploaded         DEFAULT_INITIALIZER(0);
+
+    /// Number of buffers and textures whose ownership was transferred from the transfer
+    /// queue family to the graphics queue family.
+    Uint64 NumOwnershipTransfers DEFAULT_INITIALIZER(0);
+
+    /// Total time, in seconds, during which the transfer queue had work in flight.
+    /// Completion of the work is detected on the CPU, so this value is an upper bound.
+    double BusyTime              DEFAULT_INITIALIZER(0);
+
+    /// Time, in seconds, elapsed since the device was created.
+    double ElapsedTime           DEFAULT_INITIALIZER(0);
+};
+typedef struct TransferQueueStatsVk TransferQueueStatsVk;
+
+// clang-format on
+
 #define DILIGENT_INTERFACE_NAME IRenderDeviceVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -73,6 +107,61 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                          Uint32 QueueIndex, 
                                          Uint64 FenceValue) PURE;
 
+    /// Submits pending initial data uploads of buffers and textures to the GPU
+
+    /// \return     The fence value that command queue 0 will signal when initial data of
+    ///             all resources created so far has been uploaded to the GPU memory.
+    ///
+    /// \remarks    Initial data uploads and initial clears of buffers and textures are batched
+    ///             and submitted when the batch size or time limit is reached (see
+    ///             EngineVkCreateInfo::InitialDataUploadBatchSize and EngineVkCreateInfo::InitialDataUploadMaxDelay),
+    ///             or when the immediate context submits its commands. An application that submits
+    ///             its own command buffers that use engine resources through the command queue must
+    ///             call this method first.
+    VIRTUAL Uint64 METHOD(FlushInitialDataUploads)(THIS) PURE;
+
+    /// Returns the fence value that command queue 0 will signal when initial data of the buffer or texture
+    /// has been uploaded to the GPU memory
+
+    /// \param [in] pResource - Buffer or texture created by this device.
+    ///
+    /// \return     The fence value to pass to IsFenceSignaled(0, ...), or 0 if the resource has no
+    ///             initial data upload, or the upload is known to be complete.
+    ///
+    /// \remarks    If the upload of the resource is still pending, the batch containing it is submitted.
+    VIRTUAL Uint64 METHOD(GetInitialDataFenceValue)(THIS_
+                                                    IDeviceObject* pResource) PURE;
+
+    /// Records a copy from a staging texture into a texture on the dedicated transfer queue
+
+    /// \param [in] CopyAttribs - Copy attributes. The source texture must be a staging texture created with
+    ///                           CPU_ACCESS_WRITE flag, the destination texture must not be a staging texture.
+    ///                           State transition modes are ignored.
+    ///
+    /// \return     True if the copy has been recorded, and false if the device has no dedicated transfer
+    ///             queue (see EngineVkCreateInfo::EnableTransferQueue), or the destination texture cannot be
+    ///             written by the transfer queue. In the latter case, the application should copy the data
+    ///             using a device context.
+    ///
+    /// \remarks    The transfer queue can only write textures that have not been used by the graphics queue, i.e.
+    ///             textures in RESOURCE_STATE_UNDEFINED state (see MISC_TEXTURE_FLAG_NO_INITIAL_CLEAR), and textures
+    ///             whose previous copies are still pending in the current transfer batch.
+    ///             The copy is submitted together with initial data uploads and is guaranteed to complete before
+    ///             any command buffer subsequently submitted to the graphics queue is executed. The texture is
+    ///             left in RESOURCE_STATE_COPY_DEST state. GetInitialDataFenceValue() returns the fence value of the copy.
+    ///
+    ///             The method must not be called while the destination texture is used by a device context in another thread.
+    VIRTUAL Bool METHOD(CopyTextureOnTransferQueue)(THIS_
+                                                    const CopyTextureAttribs REF CopyAttribs) PURE;
+
+    /// Returns statistics of the transfer queue, see Diligent::TransferQueueStatsVk.
+
+    /// \remarks    All values are accumulated since the device was created. To compute transfer queue
+    ///             utilization over a period of time, divide the difference of BusyTime values
+    ///             by the difference of ElapsedTime values.
+    VIRTUAL void METHOD(GetTransferQueueStats)(THIS_
+                                               TransferQueueStatsVk REF Stats) PURE;
+
     /// Creates a texture object from native Vulkan image
 
     /// \param [in]  vkImage      - Vulkan image handle
@@ -127,6 +216,10 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_GetNextFenceValue(This, ...)              CALL_IFACE_METHOD(RenderDeviceVk, GetNextFenceValue,              This, __VA_ARGS__)
 #    define IRenderDeviceVk_GetCompletedFenceValue(This, ...)         CALL_IFACE_METHOD(RenderDeviceVk, GetCompletedFenceValue,         This, __VA_ARGS__)
 #    define IRenderDeviceVk_IsFenceSignaled(This, ...)                CALL_IFACE_METHOD(RenderDeviceVk, IsFenceSignaled,                This, __VA_ARGS__)
+#    define IRenderDeviceVk_FlushInitialDataUploads(This)             CALL_IFACE_METHOD(RenderDeviceVk, FlushInitialDataUploads,        This)
+#    define IRenderDeviceVk_GetInitialDataFenceValue(This, ...)       CALL_IFACE_METHOD(RenderDeviceVk, GetInitialDataFenceValue,       This, __VA_ARGS__)
+#    define IRenderDeviceVk_CopyTextureOnTransferQueue(This, ...)     CALL_IFACE_METHOD(RenderDeviceVk, CopyTextureOnTransferQueue,     This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetTransferQueueStats(This, ...)          CALL_IFACE_METHOD(RenderDeviceVk, GetTransferQueueStats,          This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateTextureFromVulkanImage(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTextureFromVulkanImage,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateBufferFromVulkanResource(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, CreateBufferFromVulkanResource, This, __VA_ARGS__)
 
@@ -230,55 +230,32 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
             err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
             CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
 
-            VulkanUtilities::CommandPoolWrapper CmdPool;
-            VkCommandBuffer                     vkCmdBuff;
-            pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
-
             auto EnabledGraphicsShaderStages = LogicalDevice.GetEnabledGraphicsShaderStages();
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledGraphicsShaderStages);
-            InitialState              = RESOURCE_STATE_COPY_DEST;
-            VkAccessFlags AccessFlags = ResourceStateFlagsToVkAccessFlags(InitialState);
+            InitialState                     = RESOURCE_STATE_COPY_DEST;
+            VkAccessFlags AccessFlags        = ResourceStateFlagsToVkAccessFlags(InitialState);
             VERIFY_EXPR(AccessFlags == VK_ACCESS_TRANSFER_WRITE_BIT);
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, m_VulkanBuffer, 0, AccessFlags, EnabledGraphicsShaderStages);
-
-            // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-            // as copy will be the only command in the cmd buffer
-            VkBufferCopy BuffCopy = {};
-            BuffCopy.srcOffset    = 0;
-            BuffCopy.dstOffset    = 0;
-            BuffCopy.size         = VkBuffCI.size;
-            vkCmdCopyBuffer(vkCmdBuff, StagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
-
-            Uint32 QueueIndex = 0;
-            pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
-
-
-            // After command buffer is submitted, safe-release staging resources. This strategy
-            // is little overconservative as the resources will only be released after the
-            // first command buffer submitted through the immediate context is complete
-
-            // Next Cmd Buff| Next Fence |               This Thread                      |           Immediate Context
-            //              |            |                                                |
-            //      N       |     F      |                                                |
-            //              |            |                                                |
-            //              |            |  ExecuteAndDisposeTransientCmdBuff(vkCmdBuff)  |
-            //              |            |  - SubmittedCmdBuffNumber = N                  |
-            //              |            |  - SubmittedFenceValue = F                     |
-            //     N+1 -  - | -  F+1  -  |                                                |
-            //              |            |  Release(StagingBuffer)                        |
-            //              |            |  - {N+1, StagingBuffer} -> Stale Objects       |
-            //              |            |                                                |
-            //              |            |                                                |
-            //              |            |                                                | ExecuteCommandBuffer()
-            //              |            |                                                | - SubmittedCmdBuffNumber = N+1
-            //              |            |                                                | - SubmittedFenceValue = F+1
-            //     N+2 -  - | -  F+2  -  |  -   -   -   -   -   -   -   -   -   -   -   - |
-            //              |            |                                                | - DiscardStaleVkObjects(N+1, F+1)
-            //              |            |                                                |   - {F+1, StagingBuffer} -> Release Queue
-            //              |            |                                                |
-
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{QueueIndex});
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
+
+            // The copy is recorded into a command buffer shared with other resources and submitted
+            // by the initial data uploader. It must be submitted before any command buffer that uses
+            // the buffer, which is guaranteed as the uploader is flushed before the immediate context
+            // submits its commands. Staging resources are released once the GPU has executed the batch.
+            const VkBuffer vkStagingBuffer = StagingBuffer;
+            m_InitialDataUploadId          = pRenderDeviceVk->GetInitialDataUploader().RecordUpload(
+                InitialDataUploader::UploadTarget::Buffer(m_VulkanBuffer),
+                [&](VkCommandBuffer vkCmdBuff) //
+                {
+                    VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, vkStagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledGraphicsShaderStages);
+                    VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, m_VulkanBuffer, 0, AccessFlags, EnabledGraphicsShaderStages);
+
+                    // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+                    // as the uploader never begins render passes
+                    VkBufferCopy BuffCopy = {};
+                    BuffCopy.srcOffset    = 0;
+                    BuffCopy.dstOffset    = 0;
+                    BuffCopy.size         = VkBuffCI.size;
+                    vkCmdCopyBuffer(vkCmdBuff, vkStagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
+                },
+                VkBuffCI.size, std::move(StagingBuffer), std::move(StagingMemoryAllocation));
         }
 
         SetState(InitialState);
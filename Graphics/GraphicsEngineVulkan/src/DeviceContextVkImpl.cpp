@@ -36,6 +36,7 @@
 #include "CommandListVkImpl.hpp"
 #include "FenceVkImpl.hpp"
 #include "GraphicsAccessories.hpp"
+#include "VulkanUtilities/VulkanDebug.hpp"
 
 namespace Diligent
 {
@@ -68,7 +69,12 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   p
         bIsDeferred ? std::numeric_limits<decltype(m_NumCommandsToFlush)>::max() : EngineCI.NumCommandsToFlushCmdBuffer,
         bIsDeferred
     },
-    m_CommandBuffer { pDeviceVkImpl->GetLogicalDevice().GetEnabledGraphicsShaderStages() },
+    m_CommandBuffer
+    {
+        pDeviceVkImpl->GetLogicalDevice().GetEnabledGraphicsShaderStages(),
+        pDeviceVkImpl->GetLogicalDevice().GetCmdDrawIndirectCountProc(),
+        pDeviceVkImpl->GetLogicalDevice().GetCmdDrawIndexedIndirectCountProc()
+    },
     m_CmdListAllocator { GetRawAllocator(), sizeof(CommandListVkImpl), 64 },
     // Command pools must be thread safe because command buffers are returned into pools by release queues
     // potentially running in another thread
@@ -301,6 +307,10 @@ void DeviceContextVkImpl::TransitionShaderResources(IPipelineState* pPipelineSta
 
 void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    // Descriptor sets stay bound to the command buffer until the pipeline state is changed
+    if (IsRedundantShaderResourceCommit(pShaderResourceBinding, StateTransitionMode))
+        return;
+
     if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
         return;
 
@@ -509,6 +519,7 @@ void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
     PrepareForDraw(Attribs.Flags);
 
     m_CommandBuffer.Draw(Attribs.NumVertices, Attribs.NumInstances, Attribs.StartVertexLocation, Attribs.FirstInstanceLocation);
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
     ++m_State.NumCommands;
 }
 
@@ -520,6 +531,7 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
     m_CommandBuffer.DrawIndexed(Attribs.NumIndices, Attribs.NumInstances, Attribs.FirstIndexLocation, Attribs.BaseVertex, Attribs.FirstInstanceLocation);
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
     ++m_State.NumCommands;
 }
 
@@ -535,6 +547,7 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuff
     PrepareForDraw(Attribs.Flags);
 
     m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset, 1, 0);
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
     ++m_State.NumCommands;
 }
 
@@ -550,6 +563,87 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
     m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset, 1, 0);
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    const auto& Features = m_pDevice->GetDeviceCaps().Features;
+    if (Attribs.pCountBuffer == nullptr && Attribs.DrawCount > 1 && !Features.MultiDrawIndirect)
+    {
+        // Execute the draws one by one
+        TDeviceContextBase::MultiDrawIndirect(Attribs, pAttribsBuffer);
+        return;
+    }
+
+    if (!DvpVerifyMultiDrawIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    if (Attribs.pCountBuffer != nullptr && !Features.IndirectDrawCount)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndirect: indirect draw count is not supported by this device.");
+        return;
+    }
+
+    // Both buffers must be transitioned outside of render pass
+    BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectDrawAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode);
+    BufferVkImpl* pCountBufferVk         = Attribs.pCountBuffer != nullptr ? PrepareIndirectDrawAttribsBuffer(Attribs.pCountBuffer, Attribs.CountBufferStateTransitionMode) : nullptr;
+
+    PrepareForDraw(Attribs.Flags);
+
+    const auto ArgsOffset = pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset;
+    const auto Stride     = GetIndirectDrawArgsStride(Attribs.IndirectDrawArgsStride, false);
+    if (pCountBufferVk != nullptr)
+    {
+        m_CommandBuffer.DrawIndirectCount(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset,
+                                          pCountBufferVk->GetVkBuffer(), pCountBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.CountBufferOffset,
+                                          Attribs.DrawCount, Stride);
+    }
+    else
+    {
+        m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset, Attribs.DrawCount, Stride);
+    }
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    const auto& Features = m_pDevice->GetDeviceCaps().Features;
+    if (Attribs.pCountBuffer == nullptr && Attribs.DrawCount > 1 && !Features.MultiDrawIndirect)
+    {
+        TDeviceContextBase::MultiDrawIndexedIndirect(Attribs, pAttribsBuffer);
+        return;
+    }
+
+    if (!DvpVerifyMultiDrawIndexedIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    if (Attribs.pCountBuffer != nullptr && !Features.IndirectDrawCount)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexedIndirect: indirect draw count is not supported by this device.");
+        return;
+    }
+
+    BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectDrawAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode);
+    BufferVkImpl* pCountBufferVk         = Attribs.pCountBuffer != nullptr ? PrepareIndirectDrawAttribsBuffer(Attribs.pCountBuffer, Attribs.CountBufferStateTransitionMode) : nullptr;
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+
+    const auto ArgsOffset = pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset;
+    const auto Stride     = GetIndirectDrawArgsStride(Attribs.IndirectDrawArgsStride, true);
+    if (pCountBufferVk != nullptr)
+    {
+        m_CommandBuffer.DrawIndexedIndirectCount(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset,
+                                                 pCountBufferVk->GetVkBuffer(), pCountBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.CountBufferOffset,
+                                                 Attribs.DrawCount, Stride);
+    }
+    else
+    {
+        m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset, Attribs.DrawCount, Stride);
+    }
+    UpdateStats(&DeviceContextStats::NumDrawCommands);
     ++m_State.NumCommands;
 }
 
@@ -587,6 +681,7 @@ void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
     PrepareForDispatchCompute();
     m_CommandBuffer.Dispatch(Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ);
+    UpdateStats(&DeviceContextStats::NumDispatchCommands);
     ++m_State.NumCommands;
 }
 
@@ -609,6 +704,7 @@ void DeviceContextVkImpl::DispatchComputeIndirect(const DispatchComputeIndirectA
                                   VK_ACCESS_INDIRECT_COMMAND_READ_BIT, "Indirect dispatch (DeviceContextVkImpl::DispatchCompute)");
 
     m_CommandBuffer.DispatchIndirect(pBufferVk->GetVkBuffer(), pBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.DispatchArgsByteOffset);
+    UpdateStats(&DeviceContextStats::NumDispatchCommands);
     ++m_State.NumCommands;
 }
 
@@ -943,6 +1039,9 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsRedundantVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
     {
@@ -972,6 +1071,9 @@ void DeviceContextVkImpl::InvalidateState()
 
 void DeviceContextVkImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsRedundantIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     if (m_pIndexBuffer)
     {
@@ -1030,6 +1132,9 @@ void DeviceContextVkImpl::CommitViewports()
 
 void DeviceContextVkImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsRedundantViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
+
     TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
 
@@ -1059,6 +1164,9 @@ void DeviceContextVkImpl::CommitScissorRects()
 
 void DeviceContextVkImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsRedundantScissorRects(NumRects, pRects))
+        return;
+
     TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
 
     // Only commit scissor rects if scissor test is enabled in the rasterizer state.
@@ -1114,6 +1222,7 @@ void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
             }
 #endif
             m_CommandBuffer.BeginRenderPass(m_RenderPass, m_Framebuffer, m_FramebufferWidth, m_FramebufferHeight);
+            UpdateStats(&DeviceContextStats::NumRenderPasses);
         }
     }
 }
@@ -1675,66 +1784,6 @@ void DeviceContextVkImpl::GenerateMips(ITextureView* pTexView)
     m_GenerateMipsHelper->GenerateMips(*ValidatedCast<TextureViewVkImpl>(pTexView), *this, *m_GenerateMipsSRB);
 }
 
-static VkBufferImageCopy GetBufferImageCopyInfo(Uint32             BufferOffset,
-                                                Uint32             BufferRowStrideInTexels,
-                                                const TextureDesc& TexDesc,
-                                                const Box&         Region,
-                                                Uint32             MipLevel,
-                                                Uint32             ArraySlice)
-{
-    VkBufferImageCopy CopyRegion = {};
-    VERIFY((BufferOffset % 4) == 0, "Source buffer offset must be multiple of 4 (18.4)");
-    CopyRegion.bufferOffset = BufferOffset; // must be a multiple of 4 (18.4)
-
-    // bufferRowLength and bufferImageHeight specify the data in buffer memory as a subregion of a larger two- or
-    // three-dimensional image, and control the addressing calculations of data in buffer memory. If either of these
-    // values is zero, that aspect of the buffer memory is considered to be tightly packed according to the imageExtent (18.4).
-    CopyRegion.bufferRowLength   = BufferRowStrideInTexels;
-    CopyRegion.bufferImageHeight = 0;
-
-    const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
-    // The aspectMask member of imageSubresource must only have a single bit set (18.4)
-    if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
-        CopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-    else if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
-    {
-        UNSUPPORTED("Updating depth-stencil texture is not currently supported");
-        // When copying to or from a depth or stencil aspect, the data in buffer memory uses a layout
-        // that is a (mostly) tightly packed representation of the depth or stencil data.
-        // To copy both the depth and stencil aspects of a depth/stencil format, two entries in
-        // pRegions can be used, where one specifies the depth aspect in imageSubresource, and the
-        // other specifies the stencil aspect (18.4)
-    }
-    else
-        CopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-
-    CopyRegion.imageSubresource.baseArrayLayer = ArraySlice;
-    CopyRegion.imageSubresource.layerCount     = 1;
-    CopyRegion.imageSubresource.mipLevel       = MipLevel;
-    // - imageOffset.x and (imageExtent.width + imageOffset.x) must both be greater than or equal to 0 and
-    //   less than or equal to the image subresource width (18.4)
-    // - imageOffset.y and (imageExtent.height + imageOffset.y) must both be greater than or equal to 0 and
-    //   less than or equal to the image subresource height (18.4)
-    CopyRegion.imageOffset =
-        VkOffset3D //
-        {
-            static_cast<int32_t>(Region.MinX),
-            static_cast<int32_t>(Region.MinY),
-            static_cast<int32_t>(Region.MinZ) //
-        };
-    VERIFY(Region.MaxX > Region.MinX && Region.MaxY - Region.MinY && Region.MaxZ > Region.MinZ,
-           "[", Region.MinX, " .. ", Region.MaxX, ") x [", Region.MinY, " .. ", Region.MaxY, ") x [", Region.MinZ, " .. ", Region.MaxZ, ") is not a vaild region");
-    CopyRegion.imageExtent =
-        VkExtent3D //
-        {
-            static_cast<uint32_t>(Region.MaxX - Region.MinX),
-            static_cast<uint32_t>(Region.MaxY - Region.MinY),
-            static_cast<uint32_t>(Region.MaxZ - Region.MinZ) //
-        };
-
-    return CopyRegion;
-}
-
 void DeviceContextVkImpl::CopyBufferToTexture(VkBuffer                       vkSrcBuffer,
                                               Uint32                         SrcBufferOffset,
                                               Uint32                         SrcBufferRowStrideInTexels,
@@ -2181,6 +2230,7 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
     auto OldLayout = ResourceStateToVkImageLayout(OldState);
     auto NewLayout = ResourceStateToVkImageLayout(NewState);
     m_CommandBuffer.TransitionImageLayout(vkImg, OldLayout, NewLayout, *pSubresRange);
+    UpdateStats(&DeviceContextStats::NumBarriers);
     if (UpdateTextureState)
     {
         TextureVk.SetState(NewState);
@@ -2223,6 +2273,7 @@ void DeviceContextVkImpl::TransitionImageLayout(TextureVkImpl& TextureVk, VkImag
     EnsureVkCmdBuffer();
     auto vkImg = TextureVk.GetVkImage();
     m_CommandBuffer.TransitionImageLayout(vkImg, OldLayout, NewLayout, SubresRange);
+    UpdateStats(&DeviceContextStats::NumBarriers);
 }
 
 void DeviceContextVkImpl::BufferMemoryBarrier(IBuffer* pBuffer, VkAccessFlags NewAccessFlags)
@@ -2277,6 +2328,7 @@ void DeviceContextVkImpl::TransitionBufferState(BufferVkImpl& BufferVk, RESOURCE
         auto OldAccessFlags = ResourceStateFlagsToVkAccessFlags(OldState);
         auto NewAccessFlags = ResourceStateFlagsToVkAccessFlags(NewState);
         m_CommandBuffer.BufferMemoryBarrier(vkBuff, OldAccessFlags, NewAccessFlags);
+        UpdateStats(&DeviceContextStats::NumBarriers);
         if (UpdateBufferState)
         {
             BufferVk.SetState(NewState);
@@ -2312,6 +2364,7 @@ void DeviceContextVkImpl::TransitionOrVerifyBufferState(BufferVkImpl&
 VulkanDynamicAllocation DeviceContextVkImpl::AllocateDynamicSpace(Uint32 SizeInBytes, Uint32 Alignment)
 {
     auto DynAlloc = m_DynamicHeap.Allocate(SizeInBytes, Alignment);
+    UpdateStats(&DeviceContextStats::DynamicHeapBytes, Uint64{SizeInBytes});
 #ifdef DILIGENT_DEVELOPMENT
     DynAlloc.dvpFrameNumber = m_ContextFrameNumber;
 #endif
@@ -2415,4 +2468,29 @@ void DeviceContextVkImpl::ResolveTextureSubresource(ITexture*
                                  1, &ResolveRegion);
 }
 
+void DeviceContextVkImpl::BeginDebugGroup(const Char* Name, const float* pColor)
+{
+    if (!TDeviceContextBase::BeginDebugGroup(Name, 0))
+        return;
+
+    EnsureVkCmdBuffer();
+    VulkanUtilities::BeginCmdBufferLabelRegion(m_CommandBuffer.GetVkCmdBuffer(), Name, pColor);
+}
+
+void DeviceContextVkImpl::EndDebugGroup()
+{
+    if (!TDeviceContextBase::EndDebugGroup(0))
+        return;
+
+    EnsureVkCmdBuffer();
+    VulkanUtilities::EndCmdBufferLabelRegion(m_CommandBuffer.GetVkCmdBuffer());
+}
+
+void DeviceContextVkImpl::InsertDebugLabel(const Char* Label, const float* pColor)
+{
+    VERIFY(Label != nullptr, "Label must not be null");
+    EnsureVkCmdBuffer();
+    VulkanUtilities::InsertCmdBufferLabel(m_CommandBuffer.GetVkCmdBuffer(), Label, pColor);
+}
+
 } // namespace Diligent
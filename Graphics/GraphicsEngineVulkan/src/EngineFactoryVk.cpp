@@ -158,10 +158,53 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         // queue that supports either graphics or compute operations.Thus, if the capabilities of a queue family
         // include VK_QUEUE_GRAPHICS_BIT or VK_QUEUE_COMPUTE_BIT, then reporting the VK_QUEUE_TRANSFER_BIT
         // capability separately for that queue family is optional (4.1).
-        QueueInfo.queueFamilyIndex       = PhysicalDevice->FindQueueFamily(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
-        QueueInfo.queueCount             = 1;
-        const float defaultQueuePriority = 1.0f; // Ask for highest priority for our queue. (range [0,1])
-        QueueInfo.pQueuePriorities       = &defaultQueuePriority;
+        QueueInfo.queueFamilyIndex = PhysicalDevice->FindQueueFamily(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+        QueueInfo.queueCount       = 1;
+        // Ask for highest priority for the graphics queue and lower priority for the transfer queue. (range [0,1])
+        const float QueuePriorities[] = {1.0f, 0.5f};
+        QueueInfo.pQueuePriorities    = QueuePriorities;
+
+        std::vector<VkDeviceQueueCreateInfo> QueueInfos = {QueueInfo};
+
+        // Family and index of the transfer queue, if one is created
+        uint32_t TransferQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        uint32_t TransferQueueIndex       = 0;
+        if (EngineCI.EnableTransferQueue)
+        {
+            // Prefer a transfer-only queue family (typically backed by dedicated DMA engines)
+            const auto& QueueFamilyProperties = PhysicalDevice->GetQueueFamilyProperties();
+            for (uint32_t family = 0; family < QueueFamilyProperties.size(); ++family)
+            {
+                const auto& Props = QueueFamilyProperties[family];
+                if ((Props.queueFlags & VK_QUEUE_TRANSFER_BIT) != 0 &&
+                    (Props.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0 &&
+                    Props.queueCount > 0)
+                {
+                    TransferQueueFamilyIndex = family;
+                    break;
+                }
+            }
+
+            if (TransferQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED)
+            {
+                VkDeviceQueueCreateInfo TransferQueueInfo = QueueInfo;
+                TransferQueueInfo.queueFamilyIndex        = TransferQueueFamilyIndex;
+                TransferQueueInfo.queueCount              = 1;
+                TransferQueueInfo.pQueuePriorities        = &QueuePriorities[1];
+                QueueInfos.push_back(TransferQueueInfo);
+            }
+            else if (QueueFamilyProperties[QueueInfo.queueFamilyIndex].queueCount > 1)
+            {
+                // Use the second queue of the graphics queue family
+                TransferQueueFamilyIndex = QueueInfo.queueFamilyIndex;
+                TransferQueueIndex       = 1;
+                QueueInfos[0].queueCount = 2;
+            }
+            else
+            {
+                LOG_INFO_MESSAGE("The device does not expose a separate transfer queue. All uploads will be executed by the graphics queue.");
+            }
+        }
 
         VkDeviceCreateInfo DeviceCreateInfo = {};
         DeviceCreateInfo.sType              = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -169,8 +212,8 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         // https://www.khronos.org/registry/vulkan/specs/1.0/html/vkspec.html#extended-functionality-device-layer-deprecation
         DeviceCreateInfo.enabledLayerCount      = 0;       // Deprecated and ignored.
         DeviceCreateInfo.ppEnabledLayerNames    = nullptr; // Deprecated and ignored
-        DeviceCreateInfo.queueCreateInfoCount   = 1;
-        DeviceCreateInfo.pQueueCreateInfos      = &QueueInfo;
+        DeviceCreateInfo.queueCreateInfoCount   = static_cast<uint32_t>(QueueInfos.size());
+        DeviceCreateInfo.pQueueCreateInfos      = QueueInfos.data();
         VkPhysicalDeviceFeatures DeviceFeatures = {};
 
 #define ENABLE_FEATURE(Feature) DeviceFeatures.Feature = PhysicalDeviceFeatures.Feature
@@ -190,6 +233,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         ENABLE_FEATURE(vertexPipelineStoresAndAtomics);
         ENABLE_FEATURE(fragmentStoresAndAtomics);
         ENABLE_FEATURE(shaderStorageImageExtendedFormats);
+        ENABLE_FEATURE(multiDrawIndirect);
 #undef ENABLE_FEATURE
 
         DeviceCreateInfo.pEnabledFeatures = &DeviceFeatures; // NULL or a pointer to a VkPhysicalDeviceFeatures structure that contains
@@ -200,6 +244,8 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 VK_KHR_SWAPCHAIN_EXTENSION_NAME,
                 VK_KHR_MAINTENANCE1_EXTENSION_NAME // To allow negative viewport height
             };
+        if (PhysicalDevice->IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
+            DeviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME); // To read multi-draw indirect count from a buffer
         DeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
         DeviceCreateInfo.enabledExtensionCount   = static_cast<uint32_t>(DeviceExtensions.size());
 
@@ -209,22 +255,33 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
 
         auto& RawMemAllocator = GetRawAllocator();
 
-        RefCntAutoPtr<CommandQueueVkImpl> pCmdQueueVk{
-            NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, QueueInfo.queueFamilyIndex)};
+        std::vector<RefCntAutoPtr<CommandQueueVkImpl>> pCmdQueuesVk;
+        pCmdQueuesVk.emplace_back(
+            NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, QueueInfo.queueFamilyIndex));
+        if (TransferQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED)
+        {
+            pCmdQueuesVk.emplace_back(
+                NEW_RC_OBJ(RawMemAllocator, "Transfer CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, TransferQueueFamilyIndex, TransferQueueIndex));
+        }
 
         OnRenderDeviceCreated = [&](RenderDeviceVkImpl* pRenderDeviceVk) //
         {
-            FenceDesc Desc;
-            Desc.Name = "Command queue internal fence";
-            // Render device owns command queue that in turn owns the fence, so it is an internal device object
-            constexpr bool IsDeviceInternal = true;
-
-            RefCntAutoPtr<FenceVkImpl> pFenceVk{
-                NEW_RC_OBJ(RawMemAllocator, "FenceVkImpl instance", FenceVkImpl)(pRenderDeviceVk, Desc, IsDeviceInternal)};
-            pCmdQueueVk->SetFence(std::move(pFenceVk));
+            for (auto& pCmdQueueVk : pCmdQueuesVk)
+            {
+                FenceDesc Desc;
+                Desc.Name = "Command queue internal fence";
+                // Render device owns command queue that in turn owns the fence, so it is an internal device object
+                constexpr bool IsDeviceInternal = true;
+
+                RefCntAutoPtr<FenceVkImpl> pFenceVk{
+                    NEW_RC_OBJ(RawMemAllocator, "FenceVkImpl instance", FenceVkImpl)(pRenderDeviceVk, Desc, IsDeviceInternal)};
+                pCmdQueueVk->SetFence(std::move(pFenceVk));
+            }
         };
 
-        std::array<ICommandQueueVk*, 1> CommandQueues = {{pCmdQueueVk}};
+        std::vector<ICommandQueueVk*> CommandQueues;
+        for (auto& pCmdQueueVk : pCmdQueuesVk)
+            CommandQueues.push_back(pCmdQueueVk);
         AttachToVulkanDevice(Instance, std::move(PhysicalDevice), LogicalDevice, CommandQueues.size(), CommandQueues.data(), EngineCI, ppDevice, ppContexts);
     }
     catch (std::runtime_error&)
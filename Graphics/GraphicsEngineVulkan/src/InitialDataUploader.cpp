@@ -0,0 +1,320 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "InitialDataUploader.hpp"
+#include "RenderDeviceVkImpl.hpp"
+
+namespace Diligent
+{
+
+InitialDataUploader::InitialDataUploader(RenderDeviceVkImpl& DeviceVkImpl,
+                                         Uint32              CmdQueueIndex,
+                                         Uint32              TransferQueueIndex,
+                                         Uint64              MaxBatchSize,
+                                         Uint32              MaxBatchDelay) noexcept :
+    // clang-format off
+    m_DeviceVkImpl            {DeviceVkImpl      },
+    m_CmdQueueIndex           {CmdQueueIndex     },
+    m_TransferQueueIndex      {TransferQueueIndex},
+    m_MaxBatchSize            {MaxBatchSize      },
+    m_MaxBatchDelay           {MaxBatchDelay     },
+    m_QueueFamilyIndex        {DeviceVkImpl.GetCommandQueue(CmdQueueIndex).GetQueueFamilyIndex()     },
+    m_TransferQueueFamilyIndex{DeviceVkImpl.GetCommandQueue(TransferQueueIndex).GetQueueFamilyIndex()},
+    m_TransferQueueFlags      {DeviceVkImpl.GetPhysicalDevice().GetQueueFamilyProperties()[m_TransferQueueFamilyIndex].queueFlags},
+    m_CreationTime            {std::chrono::steady_clock::now()}
+// clang-format on
+{
+    m_TransferStats.QueueIndex = HasTransferQueue() ? m_TransferQueueIndex : 0;
+}
+
+InitialDataUploader::~InitialDataUploader()
+{
+    for (const auto& CmdBuff : m_CmdBuffs)
+        VERIFY(CmdBuff.vkCmdBuff == VK_NULL_HANDLE, "Pending initial data uploads must be flushed before the uploader is destroyed");
+}
+
+InitialDataUploader::BATCH_QUEUE InitialDataUploader::SelectQueue(VkQueueFlags RequiredQueueFlags) const
+{
+    // All commands allowed on a transfer queue are also allowed on graphics and compute queues,
+    // even if the queue family does not report VK_QUEUE_TRANSFER_BIT (4.1)
+    auto TransferQueueFlags = m_TransferQueueFlags;
+    if ((TransferQueueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) != 0)
+        TransferQueueFlags |= VK_QUEUE_TRANSFER_BIT;
+
+    return HasTransferQueue() && (TransferQueueFlags & RequiredQueueFlags) != 0 ?
+        BATCH_QUEUE_TRANSFER :
+        BATCH_QUEUE_GRAPHICS;
+}
+
+VkCommandBuffer InitialDataUploader::GetBatchCommandBuffer(BATCH_QUEUE QueueId)
+{
+    auto& CmdBuff = m_CmdBuffs[QueueId];
+    if (CmdBuff.vkCmdBuff == VK_NULL_HANDLE)
+    {
+        if (m_CmdBuffs[BATCH_QUEUE_GRAPHICS].vkCmdBuff == VK_NULL_HANDLE && m_CmdBuffs[BATCH_QUEUE_TRANSFER].vkCmdBuff == VK_NULL_HANDLE)
+            m_BatchStartTime = std::chrono::steady_clock::now();
+
+        const auto QueueIndex = QueueId == BATCH_QUEUE_TRANSFER ? m_TransferQueueIndex : m_CmdQueueIndex;
+        m_DeviceVkImpl.AllocateTransientCmdPool(CmdBuff.CmdPool, CmdBuff.vkCmdBuff, "Transient command pool to upload initial resource data", QueueIndex);
+    }
+    return CmdBuff.vkCmdBuff;
+}
+
+bool InitialDataUploader::IsPendingOnTransferQueue(VkImage vkImage) const
+{
+    // Copies into the same image are usually recorded one after another, so search from the end
+    for (auto it = m_TransferImageBarriers.rbegin(); it != m_TransferImageBarriers.rend(); ++it)
+    {
+        if (it->image == vkImage)
+            return true;
+    }
+    return false;
+}
+
+void InitialDataUploader::AddTransferQueueTarget(const UploadTarget& Target)
+{
+    VERIFY_EXPR(HasTransferQueue());
+
+    // Images are left in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL layout that is kept by the ownership transfer.
+    // Access masks are set by SubmitBatch() for the release and acquire barriers.
+    if (Target.vkImage != VK_NULL_HANDLE)
+    {
+        VkImageMemoryBarrier ImgBarrier = {};
+
+        ImgBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        ImgBarrier.oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        ImgBarrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        ImgBarrier.srcQueueFamilyIndex             = m_TransferQueueFamilyIndex;
+        ImgBarrier.dstQueueFamilyIndex             = m_QueueFamilyIndex;
+        ImgBarrier.image                           = Target.vkImage;
+        ImgBarrier.subresourceRange.aspectMask     = Target.AspectMask;
+        ImgBarrier.subresourceRange.baseMipLevel   = 0;
+        ImgBarrier.subresourceRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+        ImgBarrier.subresourceRange.baseArrayLayer = 0;
+        ImgBarrier.subresourceRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+        m_TransferImageBarriers.push_back(ImgBarrier);
+    }
+
+    if (Target.vkBuffer != VK_NULL_HANDLE)
+    {
+        VkBufferMemoryBarrier BuffBarrier = {};
+
+        BuffBarrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        BuffBarrier.srcQueueFamilyIndex = m_TransferQueueFamilyIndex;
+        BuffBarrier.dstQueueFamilyIndex = m_QueueFamilyIndex;
+        BuffBarrier.buffer              = Target.vkBuffer;
+        BuffBarrier.offset              = 0;
+        BuffBarrier.size                = VK_WHOLE_SIZE;
+        m_TransferBufferBarriers.push_back(BuffBarrier);
+    }
+}
+
+Uint64 InitialDataUploader::AddUpload(BATCH_QUEUE QueueId, Uint64 UploadSize, VulkanUtilities::BufferWrapper&& StagingBuffer, VulkanUtilities::VulkanMemoryAllocation&& StagingMemory)
+{
+    VERIFY_EXPR(m_CmdBuffs[BATCH_QUEUE_GRAPHICS].vkCmdBuff != VK_NULL_HANDLE || m_CmdBuffs[BATCH_QUEUE_TRANSFER].vkCmdBuff != VK_NULL_HANDLE);
+
+    if (StagingBuffer != VK_NULL_HANDLE)
+        m_StagingBuffers.emplace_back(std::move(StagingBuffer));
+    if (StagingMemory.Page != nullptr)
+        m_StagingMemory.emplace_back(std::move(StagingMemory));
+
+    m_BatchSize += UploadSize;
+    if (QueueId == BATCH_QUEUE_TRANSFER)
+    {
+        m_TransferStats.NumUploads += 1;
+        m_TransferStats.BytesUploaded += UploadSize;
+    }
+
+    const auto UploadId = m_BatchId;
+    if (m_BatchSize >= m_MaxBatchSize || std::chrono::steady_clock::now() - m_BatchStartTime >= m_MaxBatchDelay)
+        SubmitBatch();
+
+    return UploadId;
+}
+
+void InitialDataUploader::SubmitBatch()
+{
+    auto& GraphicsCmdBuff = m_CmdBuffs[BATCH_QUEUE_GRAPHICS];
+    auto& TransferCmdBuff = m_CmdBuffs[BATCH_QUEUE_TRANSFER];
+    if (GraphicsCmdBuff.vkCmdBuff == VK_NULL_HANDLE && TransferCmdBuff.vkCmdBuff == VK_NULL_HANDLE)
+        return;
+
+    VulkanUtilities::SemaphoreWrapper TransferCompleteSemaphore;
+    if (TransferCmdBuff.vkCmdBuff != VK_NULL_HANDLE)
+    {
+        // Resources are only transferred between queue families. Resources written by a queue of
+        // the same family only need the execution and memory dependency established below.
+        const bool NeedsOwnershipTransfer = m_TransferQueueFamilyIndex != m_QueueFamilyIndex;
+        const auto NumImageBarriers       = static_cast<uint32_t>(NeedsOwnershipTransfer ? m_TransferImageBarriers.size() : 0);
+        const auto NumBufferBarriers      = static_cast<uint32_t>(NeedsOwnershipTransfer ? m_TransferBufferBarriers.size() : 0);
+
+        if (NumImageBarriers != 0 || NumBufferBarriers != 0)
+        {
+            // Release ownership on the transfer queue (7.7.4). dstAccessMask is ignored by release operations.
+            for (auto& ImgBarrier : m_TransferImageBarriers)
+            {
+                ImgBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                ImgBarrier.dstAccessMask = 0;
+            }
+            for (auto& BuffBarrier : m_TransferBufferBarriers)
+            {
+                BuffBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                BuffBarrier.dstAccessMask = 0;
+            }
+            vkCmdPipelineBarrier(TransferCmdBuff.vkCmdBuff, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                                 0, nullptr, NumBufferBarriers, m_TransferBufferBarriers.data(), NumImageBarriers, m_TransferImageBarriers.data());
+        }
+
+        VkSemaphoreCreateInfo SemaphoreCI = {};
+        SemaphoreCI.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        TransferCompleteSemaphore         = m_DeviceVkImpl.GetLogicalDevice().CreateSemaphore(SemaphoreCI, "Transfer queue upload semaphore");
+
+        const auto TransferFenceValue = m_DeviceVkImpl.ExecuteAndDisposeTransientCmdBuff(m_TransferQueueIndex, TransferCmdBuff.vkCmdBuff, std::move(TransferCmdBuff.CmdPool),
+                                                                                         VK_NULL_HANDLE, TransferCompleteSemaphore);
+        TransferCmdBuff.vkCmdBuff     = VK_NULL_HANDLE;
+
+        const auto Now = std::chrono::steady_clock::now();
+        UpdateTransferQueueBusyTime(Now);
+        if (!m_IsTransferQueueBusy)
+        {
+            m_IsTransferQueueBusy   = true;
+            m_TransferBusyStartTime = Now;
+        }
+        m_LastTransferFenceValue = TransferFenceValue;
+        m_TransferStats.NumBatches += 1;
+        m_TransferStats.NumOwnershipTransfers += NumImageBarriers + NumBufferBarriers;
+
+        // Acquire ownership on the graphics queue. The global memory barrier makes the writes available
+        // to all subsequent commands when the queue families are the same.
+        for (auto& ImgBarrier : m_TransferImageBarriers)
+        {
+            ImgBarrier.srcAccessMask = 0;
+            ImgBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        }
+        for (auto& BuffBarrier : m_TransferBufferBarriers)
+        {
+            BuffBarrier.srcAccessMask = 0;
+            BuffBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        }
+
+        VkMemoryBarrier MemBarrier = {};
+        MemBarrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        MemBarrier.srcAccessMask   = VK_ACCESS_MEMORY_WRITE_BIT;
+        MemBarrier.dstAccessMask   = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+        // A semaphore wait only orders the commands of the batch that waits for it, so the graphics queue
+        // must also execute a barrier that orders all subsequently submitted commands after the transfer.
+        vkCmdPipelineBarrier(GetBatchCommandBuffer(BATCH_QUEUE_GRAPHICS), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                             1, &MemBarrier, NumBufferBarriers, m_TransferBufferBarriers.data(), NumImageBarriers, m_TransferImageBarriers.data());
+
+        m_TransferImageBarriers.clear();
+        m_TransferBufferBarriers.clear();
+    }
+
+    const auto FenceValue = m_DeviceVkImpl.ExecuteAndDisposeTransientCmdBuff(m_CmdQueueIndex, GraphicsCmdBuff.vkCmdBuff, std::move(GraphicsCmdBuff.CmdPool),
+                                                                             TransferCompleteSemaphore, VK_NULL_HANDLE);
+
+    // Staging resources can be released as soon as the batch has been executed. The graphics queue
+    // batch waits for the transfer queue batch, so its fence value covers both.
+    auto& ReleaseQueue = m_DeviceVkImpl.GetReleaseQueue(m_CmdQueueIndex);
+    for (auto& StagingBuffer : m_StagingBuffers)
+        ReleaseQueue.DiscardResource(std::move(StagingBuffer), FenceValue);
+    for (auto& StagingMemory : m_StagingMemory)
+        ReleaseQueue.DiscardResource(std::move(StagingMemory), FenceValue);
+    if (TransferCompleteSemaphore != VK_NULL_HANDLE)
+        ReleaseQueue.DiscardResource(std::move(TransferCompleteSemaphore), FenceValue);
+    m_StagingBuffers.clear();
+    m_StagingMemory.clear();
+
+    const auto CompletedFenceValue = m_DeviceVkImpl.GetCompletedFenceValue(m_CmdQueueIndex);
+    while (!m_SubmittedBatches.empty() && m_SubmittedBatches.front().second <= CompletedFenceValue)
+        m_SubmittedBatches.pop_front();
+    m_SubmittedBatches.emplace_back(m_BatchId, FenceValue);
+
+    GraphicsCmdBuff.vkCmdBuff = VK_NULL_HANDLE;
+    m_BatchSize               = 0;
+    m_LastSubmittedFenceValue = FenceValue;
+    ++m_BatchId;
+}
+
+Uint64 InitialDataUploader::Flush()
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    SubmitBatch();
+    return m_LastSubmittedFenceValue;
+}
+
+Uint64 InitialDataUploader::GetUploadFenceValue(Uint64 UploadId)
+{
+    if (UploadId == 0)
+        return 0;
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    VERIFY(UploadId <= m_BatchId, "Upload id ", UploadId, " has not been issued yet");
+    if (UploadId == m_BatchId)
+        SubmitBatch();
+
+    // Batches are submitted in the order of their ids
+    auto it = std::lower_bound(m_SubmittedBatches.begin(), m_SubmittedBatches.end(), UploadId,
+                               [](const std::pair<Uint64, Uint64>& Batch, Uint64 Id) //
+                               {
+                                   return Batch.first < Id;
+                               });
+    // Batches that are not in the list have been completed by the GPU
+    return (it != m_SubmittedBatches.end() && it->first == UploadId) ? it->second : 0;
+}
+
+void InitialDataUploader::UpdateTransferQueueBusyTime(std::chrono::steady_clock::time_point Now)
+{
+    // The queue is considered busy from the submission of a batch to an idle queue until
+    // the CPU observes that all submitted batches have been completed
+    if (m_IsTransferQueueBusy && m_DeviceVkImpl.GetCompletedFenceValue(m_TransferQueueIndex) >= m_LastTransferFenceValue)
+    {
+        m_TransferBusyTime += Now - m_TransferBusyStartTime;
+        m_IsTransferQueueBusy = false;
+    }
+}
+
+void InitialDataUploader::GetTransferQueueStats(TransferQueueStatsVk& Stats)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    const auto Now = std::chrono::steady_clock::now();
+    if (HasTransferQueue())
+        UpdateTransferQueueBusyTime(Now);
+
+    Stats = m_TransferStats;
+
+    auto BusyTime = m_TransferBusyTime;
+    if (m_IsTransferQueueBusy)
+        BusyTime += Now - m_TransferBusyStartTime;
+    Stats.BusyTime    = BusyTime.count();
+    Stats.ElapsedTime = std::chrono::duration<double>{Now - m_CreationTime}.count();
+}
+
+} // namespace Diligent
@@ -42,6 +42,12 @@
 namespace Diligent
 {
 
+static Uint32 SelectTransferQueueIndex(const EngineVkCreateInfo& EngineCI, size_t CommandQueueCount)
+{
+    // The transfer queue, if requested, is the second command queue
+    return (EngineCI.EnableTransferQueue && CommandQueueCount > 1) ? 1 : 0;
+}
+
 RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*                                    pRefCounters,
                                        IMemoryAllocator&                                      RawMemAllocator,
                                        IEngineFactory*                                        pEngineFactory,
@@ -78,6 +84,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     m_PhysicalDevice    {std::move(PhysicalDevice)},
     m_LogicalVkDevice   {std::move(LogicalDevice) },
     m_EngineAttribs     {EngineCI                 },
+    m_TransferQueueIndex{SelectTransferQueueIndex(EngineCI, CommandQueueCount)},
     m_FramebufferCache  {*this                    },
     m_RenderPassCache   {*this                    },
     m_DescriptorSetAllocator
@@ -127,6 +134,13 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         CmdQueues[0]->GetQueueFamilyIndex(),
         VK_COMMAND_POOL_CREATE_TRANSIENT_BIT
     },
+    m_TransferCmdPoolMgr
+    {
+        *this,
+        "Transfer queue command buffer pool manager",
+        CmdQueues[m_TransferQueueIndex]->GetQueueFamilyIndex(),
+        VK_COMMAND_POOL_CREATE_TRANSIENT_BIT
+    },
     m_MemoryMgr
     {
         "Global resource memory manager",
@@ -144,6 +158,14 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         *this,
         EngineCI.DynamicHeapSize,
         ~Uint64{0}
+    },
+    m_InitialDataUploader
+    {
+        *this,
+        0,
+        m_TransferQueueIndex,
+        EngineCI.InitialDataUploadBatchSize,
+        EngineCI.InitialDataUploadMaxDelay
     }
 // clang-format on
 {
@@ -178,6 +200,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     Features.VertexPipelineUAVWritesAndAtomics = vkDeviceFeatures.vertexPipelineStoresAndAtomics != VK_FALSE;
     Features.PixelUAVWritesAndAtomics          = vkDeviceFeatures.fragmentStoresAndAtomics != VK_FALSE;
     Features.TextureUAVExtendedFormats         = vkDeviceFeatures.shaderStorageImageExtendedFormats != VK_FALSE;
+    Features.MultiDrawIndirect                 = vkDeviceFeatures.multiDrawIndirect != VK_FALSE;
+    Features.IndirectDrawCount                 = m_LogicalVkDevice->GetCmdDrawIndirectCountProc() != nullptr;
 
     const auto& vkDeviceLimits = m_PhysicalDevice->GetProperties().limits;
     auto&       TexCaps        = m_DeviceCaps.TexCaps;
@@ -203,6 +227,9 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
 {
+    // Submit pending initial data uploads so that their staging resources are released
+    m_InitialDataUploader.Flush();
+
     // Explicitly destroy dynamic heap. This will move resources owned by
     // the heap into release queues
     m_DynamicMemoryManager.Destroy();
@@ -214,11 +241,13 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
 
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
     DEV_CHECK_ERR(m_TransientCmdPoolMgr.GetAllocatedPoolCount() == 0, "All allocated transient command pools must have been released now. If there are outstanding references to the pools in release queues, the app will crash when CommandPoolManager::FreeCommandPool() is called.");
+    DEV_CHECK_ERR(m_TransferCmdPoolMgr.GetAllocatedPoolCount() == 0, "All allocated transfer queue command pools must have been released now.");
     DEV_CHECK_ERR(m_DynamicDescriptorPool.GetAllocatedPoolCounter() == 0, "All allocated dynamic descriptor pools must have been released now.");
     DEV_CHECK_ERR(m_DynamicMemoryManager.GetMasterBlockCounter() == 0, "All allocated dynamic master blocks must have been returned to the pool.");
 
     // Immediately destroys all command pools
     m_TransientCmdPoolMgr.DestroyPools();
+    m_TransferCmdPoolMgr.DestroyPools();
 
     // We must destroy command queues explicitly prior to releasing Vulkan device
     DestroyCommandQueues();
@@ -232,9 +261,9 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
 }
 
 
-void RenderDeviceVkImpl::AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName)
+void RenderDeviceVkImpl::AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName, Uint32 QueueIndex)
 {
-    CmdPool = m_TransientCmdPoolMgr.AllocateCommandPool(DebugPoolName);
+    CmdPool = GetTransientCmdPoolMgr(QueueIndex).AllocateCommandPool(DebugPoolName);
 
     // Allocate command buffer from the cmd pool
     VkCommandBufferAllocateInfo BuffAllocInfo = {};
@@ -264,7 +293,11 @@ void RenderDeviceVkImpl::AllocateTransientCmdPool(VulkanUtilities::CommandPoolWr
 }
 
 
-void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(Uint32 QueueIndex, VkCommandBuffer vkCmdBuff, VulkanUtilities::CommandPoolWrapper&& CmdPool)
+Uint64 RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(Uint32                                QueueIndex,
+                                                             VkCommandBuffer                       vkCmdBuff,
+                                                             VulkanUtilities::CommandPoolWrapper&& CmdPool,
+                                                             VkSemaphore                           WaitSemaphore,
+                                                             VkSemaphore                           SignalSemaphore)
 {
     VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
 
@@ -278,6 +311,20 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(Uint32 QueueIndex, Vk
     SubmitInfo.commandBufferCount = 1;
     SubmitInfo.pCommandBuffers    = &vkCmdBuff;
 
+    // Transfer queue batches are waited for by the graphics queue before any subsequent command is executed
+    const VkPipelineStageFlags WaitDstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    if (WaitSemaphore != VK_NULL_HANDLE)
+    {
+        SubmitInfo.waitSemaphoreCount = 1;
+        SubmitInfo.pWaitSemaphores    = &WaitSemaphore;
+        SubmitInfo.pWaitDstStageMask  = &WaitDstStageMask;
+    }
+    if (SignalSemaphore != VK_NULL_HANDLE)
+    {
+        SubmitInfo.signalSemaphoreCount = 1;
+        SubmitInfo.pSignalSemaphores    = &SignalSemaphore;
+    }
+
     // We MUST NOT discard stale objects when executing transient command buffer,
     // otherwise a resource can be destroyed while still being used by the GPU:
     //
@@ -303,14 +350,25 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(Uint32 QueueIndex, Vk
     //
     // Since transient command buffers do not count as real command buffers, submit them directly to the queue
     // to avoid interference with the command buffer counter
+    //
+    // No device context records commands for the transfer queue, so its stale objects can always be discarded.
     Uint64 FenceValue = 0;
-    LockCmdQueueAndRun(QueueIndex,
-                       [&](ICommandQueueVk* pCmdQueueVk) //
-                       {
-                           FenceValue = pCmdQueueVk->Submit(SubmitInfo);
-                       } //
-    );
-    m_TransientCmdPoolMgr.SafeReleaseCommandPool(std::move(CmdPool), QueueIndex, FenceValue);
+    if (QueueIndex != 0 && QueueIndex == m_TransferQueueIndex)
+    {
+        FenceValue = TRenderDeviceBase::SubmitCommandBuffer(QueueIndex, SubmitInfo, true).FenceValue;
+    }
+    else
+    {
+        LockCmdQueueAndRun(QueueIndex,
+                           [&](ICommandQueueVk* pCmdQueueVk) //
+                           {
+                               FenceValue = pCmdQueueVk->Submit(SubmitInfo);
+                           } //
+        );
+    }
+    GetTransientCmdPoolMgr(QueueIndex).SafeReleaseCommandPool(std::move(CmdPool), QueueIndex, FenceValue);
+
+    return FenceValue;
 }
 
 void RenderDeviceVkImpl::SubmitCommandBuffer(Uint32                                                 QueueIndex,
@@ -342,19 +400,145 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmi
     // Stale objects MUST only be discarded when submitting cmd list from the immediate context
     VERIFY(!pImmediateCtx->IsDeferred(), "Command buffers must be submitted from immediate context only");
 
+    // Resources used by the command buffer may have pending initial data uploads that must be
+    // submitted first. Commands in the same queue are executed in submission order.
+    m_InitialDataUploader.Flush();
+
     Uint64 SubmittedFenceValue    = 0;
     Uint64 SubmittedCmdBuffNumber = 0;
     SubmitCommandBuffer(QueueIndex, SubmitInfo, SubmittedCmdBuffNumber, SubmittedFenceValue, pSignalFences);
 
     m_MemoryMgr.ShrinkMemory();
     PurgeReleaseQueue(QueueIndex);
+    if (m_TransferQueueIndex != 0 && m_TransferQueueIndex != QueueIndex)
+        PurgeReleaseQueue(m_TransferQueueIndex);
 
     return SubmittedFenceValue;
 }
 
 
+Uint64 RenderDeviceVkImpl::FlushInitialDataUploads()
+{
+    return m_InitialDataUploader.Flush();
+}
+
+Uint64 RenderDeviceVkImpl::GetInitialDataFenceValue(IDeviceObject* pResource)
+{
+    DEV_CHECK_ERR(pResource != nullptr, "Resource must not be null");
+
+    Uint64 UploadId = 0;
+    if (RefCntAutoPtr<IBufferVk> pBufferVk{pResource, IID_BufferVk})
+        UploadId = pBufferVk.RawPtr<BufferVkImpl>()->GetInitialDataUploadId();
+    else if (RefCntAutoPtr<ITextureVk> pTextureVk{pResource, IID_TextureVk})
+        UploadId = pTextureVk.RawPtr<TextureVkImpl>()->GetInitialDataUploadId();
+    else
+        LOG_ERROR_MESSAGE("Resource must be a buffer or a texture");
+
+    return m_InitialDataUploader.GetUploadFenceValue(UploadId);
+}
+
+Bool RenderDeviceVkImpl::CopyTextureOnTransferQueue(const CopyTextureAttribs& CopyAttribs)
+{
+    if (!m_InitialDataUploader.HasTransferQueue())
+        return False;
+
+    DEV_CHECK_ERR(CopyAttribs.pSrcTexture != nullptr && CopyAttribs.pDstTexture != nullptr, "Source and destination textures must not be null");
+
+    auto* pSrcTexVk = ValidatedCast<TextureVkImpl>(CopyAttribs.pSrcTexture);
+    auto* pDstTexVk = ValidatedCast<TextureVkImpl>(CopyAttribs.pDstTexture);
+
+    const auto& SrcTexDesc = pSrcTexVk->GetDesc();
+    const auto& DstTexDesc = pDstTexVk->GetDesc();
+    if (SrcTexDesc.Usage != USAGE_STAGING || (SrcTexDesc.CPUAccessFlags & CPU_ACCESS_WRITE) == 0 || DstTexDesc.Usage == USAGE_STAGING)
+    {
+        LOG_ERROR_MESSAGE("Transfer queue copies require a staging source texture created with CPU_ACCESS_WRITE flag and a non-staging destination texture");
+        return False;
+    }
+
+    const auto& SrcFmtAttribs = GetTextureFormatAttribs(SrcTexDesc.Format);
+    if (GetTextureFormatAttribs(DstTexDesc.Format).ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+        return False;
+
+    Box SrcBox;
+    if (CopyAttribs.pSrcBox != nullptr)
+    {
+        SrcBox = *CopyAttribs.pSrcBox;
+    }
+    else
+    {
+        auto MipLevelAttribs = GetMipLevelProperties(SrcTexDesc, CopyAttribs.SrcMipLevel);
+        SrcBox.MaxX          = MipLevelAttribs.LogicalWidth;
+        SrcBox.MaxY          = MipLevelAttribs.LogicalHeight;
+        SrcBox.MaxZ          = MipLevelAttribs.Depth;
+    }
+
+    // Same addressing as in DeviceContextVkImpl::CopyTexture()
+    auto SrcBufferOffset    = GetStagingDataOffset(SrcTexDesc, CopyAttribs.SrcSlice, CopyAttribs.SrcMipLevel);
+    auto SrcMipLevelAttribs = GetMipLevelProperties(SrcTexDesc, CopyAttribs.SrcMipLevel);
+    SrcBufferOffset +=
+        (SrcBox.MinZ * SrcMipLevelAttribs.StorageHeight + SrcBox.MinY) / SrcFmtAttribs.BlockHeight * SrcMipLevelAttribs.RowSize +
+        (SrcBox.MinX / SrcFmtAttribs.BlockWidth) * SrcFmtAttribs.GetElementSize();
+
+    Box DstBox;
+    DstBox.MinX = CopyAttribs.DstX;
+    DstBox.MinY = CopyAttribs.DstY;
+    DstBox.MinZ = CopyAttribs.DstZ;
+    DstBox.MaxX = DstBox.MinX + SrcBox.MaxX - SrcBox.MinX;
+    DstBox.MaxY = DstBox.MinY + SrcBox.MaxY - SrcBox.MinY;
+    DstBox.MaxZ = DstBox.MinZ + SrcBox.MaxZ - SrcBox.MinZ;
+
+    const auto CopyRegion = GetBufferImageCopyInfo(SrcBufferOffset, SrcMipLevelAttribs.StorageWidth, DstTexDesc, DstBox, CopyAttribs.DstMipLevel, CopyAttribs.DstSlice);
+
+    const auto RowSize    = (SrcBox.MaxX - SrcBox.MinX + SrcFmtAttribs.BlockWidth - 1) / SrcFmtAttribs.BlockWidth * SrcFmtAttribs.GetElementSize();
+    const auto NumRows    = (SrcBox.MaxY - SrcBox.MinY + SrcFmtAttribs.BlockHeight - 1) / SrcFmtAttribs.BlockHeight;
+    const auto UploadSize = Uint64{RowSize} * NumRows * (SrcBox.MaxZ - SrcBox.MinZ);
+
+    const auto vkSrcBuffer     = pSrcTexVk->GetVkStagingBuffer();
+    const auto vkDstImage      = pDstTexVk->GetVkImage();
+    const auto AspectMask      = CopyRegion.imageSubresource.aspectMask;
+    const bool IsUninitialized = pDstTexVk->GetState() == RESOURCE_STATE_UNDEFINED;
+
+    const auto UploadId = m_InitialDataUploader.RecordTransferQueueCopy(
+        vkDstImage, AspectMask, IsUninitialized,
+        [&](VkCommandBuffer vkCmdBuff, bool InitializeLayout) //
+        {
+            if (InitializeLayout)
+            {
+                VkImageSubresourceRange SubresRange = {};
+
+                SubresRange.aspectMask     = AspectMask;
+                SubresRange.baseMipLevel   = 0;
+                SubresRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+                SubresRange.baseArrayLayer = 0;
+                SubresRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+                VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, vkDstImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                                            SubresRange, m_LogicalVkDevice->GetEnabledGraphicsShaderStages());
+            }
+            vkCmdCopyBufferToImage(vkCmdBuff, vkSrcBuffer, vkDstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &CopyRegion);
+        },
+        UploadSize);
+
+    if (UploadId == 0)
+        return False;
+
+    if (IsUninitialized)
+        pDstTexVk->SetState(RESOURCE_STATE_COPY_DEST);
+    pDstTexVk->SetInitialDataUploadId(UploadId);
+
+    return True;
+}
+
+void RenderDeviceVkImpl::GetTransferQueueStats(TransferQueueStatsVk& Stats)
+{
+    m_InitialDataUploader.GetTransferQueueStats(Stats);
+}
+
 void RenderDeviceVkImpl::IdleGPU()
 {
+    m_InitialDataUploader.Flush();
+    // Graphics queue batches of the uploader wait for the transfer queue, so idle it first
+    if (m_TransferQueueIndex != 0)
+        IdleCommandQueue(m_TransferQueueIndex, true);
     IdleAllCommandQueues(true);
     m_LogicalVkDevice->WaitIdle();
     ReleaseStaleResources();
@@ -362,6 +546,10 @@ void RenderDeviceVkImpl::IdleGPU()
 
 void RenderDeviceVkImpl::FlushStaleResources(Uint32 CmdQueueIndex)
 {
+    // Pending uploads must be submitted before stale resources are discarded, as the
+    // command buffers of the uploader may reference them
+    m_InitialDataUploader.Flush();
+
     // Submit empty command buffer to the queue. This will effectively signal the fence and
     // discard all resources
     VkSubmitInfo DummySumbitInfo = {};
@@ -29,6 +29,7 @@
 
 #include "ShaderVariableVk.hpp"
 #include "ShaderResourceVariableBase.hpp"
+#include "StringInternTable.hpp"
 
 namespace Diligent
 {
@@ -189,9 +190,11 @@ void ShaderVariableManagerVk::BindResources(IResourceMapping* pResourceMapping,
     if ((Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0)
         Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
 
+    // Look up all resources in the resource mapping at once
+    ResourceMappingBatch Batch;
     for (Uint32 v = 0; v < m_NumVariables; ++v)
     {
-        auto&       Var = m_pVariables[v];
+        const auto& Var = m_pVariables[v];
         const auto& Res = Var.m_Resource;
 
         // There should be no immutable separate samplers
@@ -201,14 +204,33 @@ void ShaderVariableManagerVk::BindResources(IResourceMapping* pResourceMapping,
         if ((Flags & (1 << Res.GetVariableType())) == 0)
             continue;
 
+        const auto* VarName = Res.SpirvAttribs.Name;
+        // Resource names are interned by SPIRVShaderResources, so their hashes have been computed in advance
+        const auto NameHash = StringInternTable::GetInternedHash(VarName);
         for (Uint32 ArrInd = 0; ArrInd < Res.SpirvAttribs.ArraySize; ++ArrInd)
         {
             if ((Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) && Res.IsBound(ArrInd, m_ResourceCache))
                 continue;
 
-            const auto*                  VarName = Res.SpirvAttribs.Name;
-            RefCntAutoPtr<IDeviceObject> pObj;
-            pResourceMapping->GetResource(VarName, &pObj, ArrInd);
+            Batch.AddLookup(&Var, VarName, NameHash, ArrInd);
+        }
+    }
+    Batch.Resolve(*pResourceMapping);
+
+    for (Uint32 v = 0; v < m_NumVariables; ++v)
+    {
+        const auto& Var = m_pVariables[v];
+        const auto& Res = Var.m_Resource;
+
+        if ((Flags & (1 << Res.GetVariableType())) == 0)
+            continue;
+
+        for (Uint32 ArrInd = 0; ArrInd < Res.SpirvAttribs.ArraySize; ++ArrInd)
+        {
+            IDeviceObject* pObj = nullptr;
+            if (!Batch.ConsumeNext(&Var, ArrInd, pObj))
+                continue;
+
             if (pObj)
             {
                 Res.BindResource(pObj, ArrInd, m_ResourceCache);
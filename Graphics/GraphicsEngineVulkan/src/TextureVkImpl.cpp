@@ -196,11 +196,11 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
 
 
         // Vulkan validation layers do not like uninitialized memory, so if no initial data
-        // is provided, we will clear the memory
-
-        VulkanUtilities::CommandPoolWrapper CmdPool;
-        VkCommandBuffer                     vkCmdBuff;
-        pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
+        // is provided, we will clear the memory unless the application opted out
+        const bool bClearTexture =
+            !bInitializeTexture &&
+            (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_NO_INITIAL_CLEAR) == 0 &&
+            pRenderDeviceVk->GetEngineAttribs().ClearUninitializedTextures;
 
         VkImageAspectFlags aspectMask = 0;
         if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
@@ -225,11 +225,14 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         SubresRange.baseMipLevel         = 0;
         SubresRange.levelCount           = VK_REMAINING_MIP_LEVELS;
         auto EnabledGraphicsShaderStages = LogicalDevice.GetEnabledGraphicsShaderStages();
-        VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, ImageCI.initialLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange, EnabledGraphicsShaderStages);
         SetState(RESOURCE_STATE_COPY_DEST);
         const auto CurrentLayout = GetLayout();
         VERIFY_EXPR(CurrentLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
+        // Initial layout transition and copy or clear commands are recorded into a command buffer
+        // shared with other resources and submitted by the initial data uploader
+        auto& Uploader = pRenderDeviceVk->GetInitialDataUploader();
+
         if (bInitializeTexture)
         {
             Uint32 ExpectedNumSubresources = ImageCI.mipLevels * ImageCI.arrayLayers;
@@ -346,24 +349,24 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
             err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
             CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
 
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledGraphicsShaderStages);
-
-            // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-            // as copy will be the only command in the cmd buffer
-            vkCmdCopyBufferToImage(vkCmdBuff, StagingBuffer, m_VulkanImage,
-                                   CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
-                                   static_cast<uint32_t>(Regions.size()), Regions.data());
-
-            Uint32 QueueIndex = 0;
-            pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
-
-            // After command buffer is submitted, safe-release resources. This strategy
-            // is little overconservative as the resources will be released after the first
-            // command buffer submitted through the immediate context will be completed
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{QueueIndex});
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
+            const VkBuffer vkStagingBuffer = StagingBuffer;
+            // The uploader releases staging resources once the GPU has executed the batch
+            m_InitialDataUploadId = Uploader.RecordUpload(
+                InitialDataUploader::UploadTarget::Image(m_VulkanImage, aspectMask),
+                [&](VkCommandBuffer vkCmdBuff) //
+                {
+                    VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, ImageCI.initialLayout, CurrentLayout, SubresRange, EnabledGraphicsShaderStages);
+                    VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, vkStagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledGraphicsShaderStages);
+
+                    // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+                    // as the uploader never begins render passes
+                    vkCmdCopyBufferToImage(vkCmdBuff, vkStagingBuffer, m_VulkanImage,
+                                           CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+                                           static_cast<uint32_t>(Regions.size()), Regions.data());
+                },
+                uploadBufferSize, std::move(StagingBuffer), std::move(StagingMemoryAllocation));
         }
-        else
+        else if (bClearTexture)
         {
             VkImageSubresourceRange Subresource;
             Subresource.aspectMask     = aspectMask;
@@ -371,30 +374,45 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
             Subresource.levelCount     = VK_REMAINING_MIP_LEVELS;
             Subresource.baseArrayLayer = 0;
             Subresource.layerCount     = VK_REMAINING_ARRAY_LAYERS;
-            if (aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
-            {
-                if (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+            VERIFY(aspectMask == VK_IMAGE_ASPECT_COLOR_BIT || aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT || aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT),
+                   "Unexpected aspect mask");
+
+            // Color images can be cleared by graphics and compute queues, depth-stencil images only by graphics queues
+            const VkQueueFlags ClearQueueFlags = aspectMask == VK_IMAGE_ASPECT_COLOR_BIT ?
+                VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT :
+                VK_QUEUE_GRAPHICS_BIT;
+
+            m_InitialDataUploadId = Uploader.RecordUpload(
+                InitialDataUploader::UploadTarget::Image(m_VulkanImage, aspectMask, ClearQueueFlags),
+                [&](VkCommandBuffer vkCmdBuff) //
                 {
-                    VkClearColorValue ClearColor = {};
-                    vkCmdClearColorImage(vkCmdBuff, m_VulkanImage,
-                                         CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                                         &ClearColor, 1, &Subresource);
-                }
-            }
-            else if (aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT ||
-                     aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
-            {
-                VkClearDepthStencilValue ClearValue = {};
-                vkCmdClearDepthStencilImage(vkCmdBuff, m_VulkanImage,
-                                            CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                                            &ClearValue, 1, &Subresource);
-            }
-            else
-            {
-                UNEXPECTED("Unexpected aspect mask");
-            }
-            Uint32 QueueIndex = 0;
-            pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
+                    VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, ImageCI.initialLayout, CurrentLayout, SubresRange, EnabledGraphicsShaderStages);
+                    if (aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
+                    {
+                        if (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+                        {
+                            VkClearColorValue ClearColor = {};
+                            vkCmdClearColorImage(vkCmdBuff, m_VulkanImage,
+                                                 CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                                 &ClearColor, 1, &Subresource);
+                        }
+                    }
+                    else
+                    {
+                        VkClearDepthStencilValue ClearValue = {};
+                        vkCmdClearDepthStencilImage(vkCmdBuff, m_VulkanImage,
+                                                    CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                                    &ClearValue, 1, &Subresource);
+                    }
+                },
+                0, VulkanUtilities::BufferWrapper{}, VulkanUtilities::VulkanMemoryAllocation{});
+        }
+        else
+        {
+            // Nothing is submitted to the GPU. The image stays in VK_IMAGE_LAYOUT_UNDEFINED layout
+            // and is transitioned by the device context when it is used for the first time.
+            SetState(RESOURCE_STATE_UNDEFINED);
+            VERIFY_EXPR(GetLayout() == VK_IMAGE_LAYOUT_UNDEFINED);
         }
     }
     else if (m_Desc.Usage == USAGE_STAGING)
@@ -440,6 +458,22 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         VkStagingBuffCI.queueFamilyIndexCount = 0;
         VkStagingBuffCI.pQueueFamilyIndices   = nullptr;
 
+        // Staging textures can be read by the graphics queue and the transfer queue (see
+        // IRenderDeviceVk::CopyTextureOnTransferQueue()), which requires concurrent sharing
+        // if the queues belong to different families.
+        uint32_t QueueFamilyIndices[2] = {};
+        if (const auto TransferQueueIndex = pRenderDeviceVk->GetTransferQueueIndex())
+        {
+            QueueFamilyIndices[0] = pRenderDeviceVk->GetCommandQueue(0).GetQueueFamilyIndex();
+            QueueFamilyIndices[1] = pRenderDeviceVk->GetCommandQueue(TransferQueueIndex).GetQueueFamilyIndex();
+            if (QueueFamilyIndices[0] != QueueFamilyIndices[1])
+            {
+                VkStagingBuffCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+                VkStagingBuffCI.queueFamilyIndexCount = 2;
+                VkStagingBuffCI.pQueueFamilyIndices   = QueueFamilyIndices;
+            }
+        }
+
         std::string StagingBufferName = "Staging buffer for '";
         StagingBufferName += m_Desc.Name;
         StagingBufferName += '\'';
@@ -502,6 +536,66 @@ Uint32 GetStagingDataOffset(const TextureDesc& TexDesc, Uint32 ArraySlice, Uint3
     return Offset;
 }
 
+VkBufferImageCopy GetBufferImageCopyInfo(Uint32             BufferOffset,
+                                         Uint32             BufferRowStrideInTexels,
+                                         const TextureDesc& TexDesc,
+                                         const Box&         Region,
+                                         Uint32             MipLevel,
+                                         Uint32             ArraySlice)
+{
+    VkBufferImageCopy CopyRegion = {};
+    VERIFY((BufferOffset % 4) == 0, "Source buffer offset must be multiple of 4 (18.4)");
+    CopyRegion.bufferOffset = BufferOffset; // must be a multiple of 4 (18.4)
+
+    // bufferRowLength and bufferImageHeight specify the data in buffer memory as a subregion of a larger two- or
+    // three-dimensional image, and control the addressing calculations of data in buffer memory. If either of these
+    // values is zero, that aspect of the buffer memory is considered to be tightly packed according to the imageExtent (18.4).
+    CopyRegion.bufferRowLength   = BufferRowStrideInTexels;
+    CopyRegion.bufferImageHeight = 0;
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+    // The aspectMask member of imageSubresource must only have a single bit set (18.4)
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
+        CopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    else if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+    {
+        UNSUPPORTED("Updating depth-stencil texture is not currently supported");
+        // When copying to or from a depth or stencil aspect, the data in buffer memory uses a layout
+        // that is a (mostly) tightly packed representation of the depth or stencil data.
+        // To copy both the depth and stencil aspects of a depth/stencil format, two entries in
+        // pRegions can be used, where one specifies the depth aspect in imageSubresource, and the
+        // other specifies the stencil aspect (18.4)
+    }
+    else
+        CopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+    CopyRegion.imageSubresource.baseArrayLayer = ArraySlice;
+    CopyRegion.imageSubresource.layerCount     = 1;
+    CopyRegion.imageSubresource.mipLevel       = MipLevel;
+    // - imageOffset.x and (imageExtent.width + imageOffset.x) must both be greater than or equal to 0 and
+    //   less than or equal to the image subresource width (18.4)
+    // - imageOffset.y and (imageExtent.height + imageOffset.y) must both be greater than or equal to 0 and
+    //   less than or equal to the image subresource height (18.4)
+    CopyRegion.imageOffset =
+        VkOffset3D //
+        {
+            static_cast<int32_t>(Region.MinX),
+            static_cast<int32_t>(Region.MinY),
+            static_cast<int32_t>(Region.MinZ) //
+        };
+    VERIFY(Region.MaxX > Region.MinX && Region.MaxY - Region.MinY && Region.MaxZ > Region.MinZ,
+           "[", Region.MinX, " .. ", Region.MaxX, ") x [", Region.MinY, " .. ", Region.MaxY, ") x [", Region.MinZ, " .. ", Region.MaxZ, ") is not a vaild region");
+    CopyRegion.imageExtent =
+        VkExtent3D //
+        {
+            static_cast<uint32_t>(Region.MaxX - Region.MinX),
+            static_cast<uint32_t>(Region.MaxY - Region.MinY),
+            static_cast<uint32_t>(Region.MaxZ - Region.MinZ) //
+        };
+
+    return CopyRegion;
+}
+
 TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
                              FixedBlockMemoryAllocator& TexViewObjAllocator,
                              RenderDeviceVkImpl*        pDeviceVk,
@@ -228,32 +228,42 @@ void EndCmdQueueLabelRegion(VkQueue cmdQueue)
 // Start a new label region
 void BeginCmdBufferLabelRegion(VkCommandBuffer cmdBuffer, const char* pLabelName, const float* color)
 {
+    // Function pointers are only loaded when debugging is set up
+    if (CmdBeginDebugUtilsLabelEXT == nullptr)
+        return;
+
     VkDebugUtilsLabelEXT Label = {};
 
     Label.sType      = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
     Label.pNext      = nullptr;
     Label.pLabelName = pLabelName;
     for (int i = 0; i < 4; ++i)
-        Label.color[i] = color[i];
+        Label.color[i] = color != nullptr ? color[i] : 0.f;
     CmdBeginDebugUtilsLabelEXT(cmdBuffer, &Label);
 }
 
 // End the label region
 void EndCmdBufferLabelRegion(VkCommandBuffer cmdBuffer)
 {
+    if (CmdEndDebugUtilsLabelEXT == nullptr)
+        return;
+
     CmdEndDebugUtilsLabelEXT(cmdBuffer);
 }
 
 // Start a single label
 void InsertCmdBufferLabel(VkCommandBuffer cmdBuffer, const char* pLabelName, const float* color)
 {
+    if (CmdInsertDebugUtilsLabelEXT == nullptr)
+        return;
+
     VkDebugUtilsLabelEXT Label = {};
 
     Label.sType      = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
     Label.pNext      = nullptr;
     Label.pLabelName = pLabelName;
     for (int i = 0; i < 4; ++i)
-        Label.color[i] = color[i];
+        Label.color[i] = color != nullptr ? color[i] : 0.f;
     CmdInsertDebugUtilsLabelEXT(cmdBuffer, &Label);
 }
 
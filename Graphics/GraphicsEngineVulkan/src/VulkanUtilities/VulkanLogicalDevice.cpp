@@ -26,6 +26,7 @@
  */
 
 #include <limits>
+#include <cstring>
 #include "VulkanErrors.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanDebug.hpp"
@@ -60,6 +61,16 @@ VulkanLogicalDevice::VulkanLogicalDevice(VkPhysicalDevice             vkPhysical
         m_EnabledGraphicsShaderStages |= VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT;
     if (DeviceCI.pEnabledFeatures->tessellationShader)
         m_EnabledGraphicsShaderStages |= VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT | VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT;
+
+    for (uint32_t ext = 0; ext < DeviceCI.enabledExtensionCount; ++ext)
+    {
+        if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) == 0)
+        {
+            // Extension commands are not exported by the loader and must be queried from the device
+            m_vkCmdDrawIndirectCountKHR        = reinterpret_cast<PFN_vkCmdDrawIndirectCountKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkCmdDrawIndirectCountKHR"));
+            m_vkCmdDrawIndexedIndirectCountKHR = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkCmdDrawIndexedIndirectCountKHR"));
+        }
+    }
 }
 
 VkQueue VulkanLogicalDevice::GetQueue(uint32_t queueFamilyIndex, uint32_t queueIndex)
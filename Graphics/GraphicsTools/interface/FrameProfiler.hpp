@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <ostream>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Query.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/Timer.hpp"
+
+namespace Diligent
+{
+
+/// Hierarchical CPU/GPU frame profiler.
+
+/// The profiler records nested named scopes. For every scope, it captures CPU timestamps and,
+/// if the device supports timestamp queries, GPU timestamps taken from a pool of queries.
+/// GPU results are resolved without stalling several frames after the frame they were recorded in.
+/// Every scope is also emitted as a debug group so that it is visible in external graphics
+/// debugging tools.
+///
+/// \remarks    The profiler is not thread-safe. GPU timestamps can only be recorded in the immediate
+///             context; for deferred contexts set RecordGPUTime to false in BeginScope().
+class FrameProfiler
+{
+public:
+    /// Profiling results of a single scope.
+    struct ScopeResult
+    {
+        /// Scope name.
+        String Name;
+
+        /// Nesting depth of the scope, top-level scopes have zero depth.
+        Uint32 Depth = 0;
+
+        /// Index of the parent scope in FrameResult::Scopes, or -1 for top-level scopes.
+        Int32 Parent = -1;
+
+        /// CPU time, in seconds, when the scope began, relative to the profiler creation.
+        double CPUStart = 0;
+
+        /// CPU time, in seconds, when the scope ended, relative to the profiler creation.
+        double CPUEnd = 0;
+
+        /// GPU time, in seconds, when the scope began. Only valid if HasGPUTime is true.
+        double GPUStart = 0;
+
+        /// GPU time, in seconds, when the scope ended. Only valid if HasGPUTime is true.
+        double GPUEnd = 0;
+
+        /// Indicates if GPU timestamps are available for this scope.
+        bool HasGPUTime = false;
+    };
+
+    /// Profiling results of a single frame.
+    struct FrameResult
+    {
+        /// Frame number as counted by the profiler.
+        Uint64 FrameNumber = 0;
+
+        /// CPU time, in seconds, when the frame began, relative to the profiler creation.
+        double CPUStart = 0;
+
+        /// CPU time, in seconds, when the frame ended, relative to the profiler creation.
+        double CPUEnd = 0;
+
+        /// All scopes of the frame in the order in which they were begun.
+        std::vector<ScopeResult> Scopes;
+    };
+
+
+    /// Creates the frame profiler.
+
+    /// \param [in] pDevice           - Render device that will be used to create timestamp queries.
+    /// \param [in] MaxFramesInFlight - Maximum number of frames whose GPU results may be pending.
+    ///                                 Pending frames are kept until their results are available.
+    ///                                 While this many frames are pending, new frames are recorded
+    ///                                 without GPU timestamps.
+    /// \param [in] NumScopesToReserve - Number of scopes to reserve timestamp queries for.
+    FrameProfiler(IRenderDevice* pDevice,
+                  Uint32         MaxFramesInFlight  = 4,
+                  Uint32         NumScopesToReserve = 32);
+
+    // clang-format off
+    FrameProfiler           (const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+    FrameProfiler           (FrameProfiler&&)      = default;
+    FrameProfiler& operator=(FrameProfiler&&)      = delete;
+    // clang-format on
+
+
+    /// Begins a new frame. All scopes must be recorded between BeginFrame() and EndFrame().
+    void BeginFrame();
+
+
+    /// Ends the current frame and resolves the results of previous frames that are ready.
+
+    /// \remarks    All scopes begun in the frame must be ended before this method is called.
+    void EndFrame();
+
+
+    /// Begins a named scope.
+
+    /// \param [in] pCtx          - Context to record timestamp query and debug group commands.
+    /// \param [in] Name          - Scope name. The string is copied.
+    /// \param [in] pColor        - Optional debug group color, see IDeviceContext::BeginDebugGroup().
+    /// \param [in] RecordGPUTime - Whether to record GPU timestamps for this scope.
+    ///
+    /// \remarks    There must be exactly one matching EndScope() for every BeginScope() call.
+    void BeginScope(IDeviceContext* pCtx,
+                    const Char*     Name,
+                    const float*    pColor        = nullptr,
+                    bool            RecordGPUTime = true);
+
+
+    /// Ends the scope that was last begun in the current frame.
+
+    /// \param [in] pCtx - Context to record timestamp query and debug group commands.
+    ///                    Must be the same context that was used to begin the scope.
+    void EndScope(IDeviceContext* pCtx);
+
+
+    /// Returns the results of the most recent frame that has been fully resolved,
+    /// or nullptr if no frame has been resolved yet.
+    const FrameResult* GetLastResolvedFrame() const
+    {
+        return m_HasResolvedFrame ? &m_LastResolvedFrame : nullptr;
+    }
+
+    /// Returns the number of frames that have been resolved so far.
+    Uint64 GetNumResolvedFrames() const { return m_NumResolvedFrames; }
+
+    /// Returns the number of frames that were recorded without GPU timestamps because
+    /// MaxFramesInFlight frames were waiting for their GPU results.
+    Uint64 GetNumFramesWithoutGPUTime() const { return m_NumFramesWithoutGPUTime; }
+
+
+    /// Writes frame results in Chrome trace event format (chrome://tracing, Perfetto).
+
+    /// \param [in] Frame  - Frame results to write.
+    /// \param [in] Stream - Output stream.
+    ///
+    /// \remarks    CPU scopes are written to thread 1 and GPU scopes to thread 2 of the same process.
+    ///             GPU clock is not synchronized with CPU clock, so GPU scopes are aligned so that
+    ///             the earliest GPU timestamp of the frame coincides with the start of the frame.
+    static void WriteChromeTrace(const FrameResult& Frame, std::ostream& Stream);
+
+
+    /// Helper class that begins a scope in the constructor and ends it in the destructor.
+    class ScopedProfile
+    {
+    public:
+        ScopedProfile(FrameProfiler&  Profiler,
+                      IDeviceContext* pCtx,
+                      const Char*     Name,
+                      const float*    pColor        = nullptr,
+                      bool            RecordGPUTime = true) :
+            m_Profiler{Profiler},
+            m_pCtx{pCtx}
+        {
+            m_Profiler.BeginScope(m_pCtx, Name, pColor, RecordGPUTime);
+        }
+
+        ~ScopedProfile()
+        {
+            m_Profiler.EndScope(m_pCtx);
+        }
+
+        // clang-format off
+        ScopedProfile           (const ScopedProfile&) = delete;
+        ScopedProfile& operator=(const ScopedProfile&) = delete;
+        ScopedProfile           (ScopedProfile&&)      = delete;
+        ScopedProfile& operator=(ScopedProfile&&)      = delete;
+        // clang-format on
+
+    private:
+        FrameProfiler&  m_Profiler;
+        IDeviceContext* m_pCtx;
+    };
+
+private:
+    struct ScopeQueries
+    {
+        RefCntAutoPtr<IQuery> Start;
+        RefCntAutoPtr<IQuery> End;
+    };
+
+    struct PendingFrame
+    {
+        FrameResult Result;
+
+        // Timestamp queries for every scope in Result.Scopes (null if GPU time is not recorded)
+        std::vector<ScopeQueries> Queries;
+    };
+
+    RefCntAutoPtr<IQuery> AllocateQuery();
+    void                  RecycleQueries(PendingFrame& Frame);
+    bool                  TryResolveFrame(PendingFrame& Frame);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const Uint32 m_MaxFramesInFlight;
+    const bool   m_TimestampsSupported;
+
+    Timer  m_Timer;
+    Uint64 m_FrameNumber = 0;
+    bool   m_InsideFrame = false;
+
+    // Whether GPU timestamps are recorded in the current frame
+    bool m_RecordGPUTimeInFrame = false;
+
+    PendingFrame        m_CurrentFrame;
+    std::vector<Uint32> m_ScopeStack;
+
+    std::deque<PendingFrame>           m_PendingFrames;
+    std::vector<RefCntAutoPtr<IQuery>> m_AvailableQueries;
+
+    FrameResult m_LastResolvedFrame;
+    bool        m_HasResolvedFrame        = false;
+    Uint64      m_NumResolvedFrames       = 0;
+    Uint64      m_NumFramesWithoutGPUTime = 0;
+};
+
+} // namespace Diligent
@@ -30,6 +30,11 @@
 #include <mutex>
 #include <vector>
 #include <deque>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
 
 #include "../../GraphicsEngine/interface/SwapChain.h"
 #include "../../GraphicsEngine/interface/RenderDevice.h"
@@ -39,12 +44,84 @@
 namespace Diligent
 {
 
+class FileWrapper;
+
+/// Screen capture encoding
+enum SCREEN_CAPTURE_ENCODING : Uint8
+{
+    /// Captured frames are not written to files and are only passed to the frame callback.
+    SCREEN_CAPTURE_ENCODING_NONE = 0,
+
+    /// Every frame is written to a separate file as tightly packed pixels in the swap chain format.
+    SCREEN_CAPTURE_ENCODING_RAW,
+
+    /// Every frame is written to a separate PNG file.
+    SCREEN_CAPTURE_ENCODING_PNG,
+
+    /// All frames are appended in the capture order to a single uncompressed video stream
+    /// of tightly packed pixels in the swap chain format that can be played e.g. with
+    /// ffplay -f rawvideo -pixel_format rgba -video_size <width>x<height> <file>.
+    SCREEN_CAPTURE_ENCODING_RAW_VIDEO
+};
+
+/// CPU copy of a captured frame
+struct CapturedFrame
+{
+    /// Frame id passed to ScreenCapture::Capture()
+    Uint32 Id = 0;
+
+    Uint32         Width  = 0;
+    Uint32         Height = 0;
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// Row stride, in bytes
+    Uint32 Stride = 0;
+
+    /// Pixel data. The pointer is only valid during the callback.
+    const Uint8* pData = nullptr;
+};
+
+/// Screen capture create info
+struct ScreenCaptureCreateInfo
+{
+    /// The number of staging textures in the capture ring. When all textures are in use,
+    /// new frames are dropped instead of stalling the render thread.
+    /// 0 means that new staging textures are created on demand.
+    Uint32 NumStagingTextures = 0;
+
+    /// The number of worker threads that encode frames read back by ProcessCompletedCaptures().
+    /// If 0, frames are encoded by the thread that calls ProcessCompletedCaptures().
+    Uint32 NumEncoderThreads = 1;
+
+    /// Frame encoding, see Diligent::SCREEN_CAPTURE_ENCODING.
+    SCREEN_CAPTURE_ENCODING Encoding = SCREEN_CAPTURE_ENCODING_NONE;
+
+    /// For SCREEN_CAPTURE_ENCODING_RAW and SCREEN_CAPTURE_ENCODING_PNG, the prefix of the
+    /// frame file names, which are formed as <OutputPath><6-digit frame id>.raw/.png.
+    /// For SCREEN_CAPTURE_ENCODING_RAW_VIDEO, the path to the video file.
+    const Char* OutputPath = nullptr;
+
+    /// Optional callback that is called for every frame on the encoder thread after the frame
+    /// has been encoded. When there are multiple encoder threads, the callback may be called
+    /// concurrently and out of the capture order.
+    std::function<void(const CapturedFrame&)> FrameCallback;
+};
+
 class ScreenCapture
 {
 public:
     ScreenCapture(IRenderDevice* pDevice);
+    ScreenCapture(IRenderDevice* pDevice, const ScreenCaptureCreateInfo& CI);
+    ~ScreenCapture();
 
-    void Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId);
+    // clang-format off
+    ScreenCapture           (const ScreenCapture&) = delete;
+    ScreenCapture& operator=(const ScreenCapture&) = delete;
+    // clang-format on
+
+    /// Copies the current back buffer to a staging texture. Never waits for the GPU.
+    /// Returns false if the frame was dropped because all staging textures of the ring are in use.
+    bool Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId);
 
     struct CaptureInfo
     {
@@ -68,12 +145,47 @@ public:
         return m_PendingTextures.size();
     }
 
+    /// Reads back all captures whose copies have been completed by the GPU, recycles their staging
+    /// textures and hands the frames over to the encoder threads. Never waits for the GPU.
+    /// Must be called from the thread that owns the immediate context.
+    /// Returns the number of frames that were read back.
+    Uint32 ProcessCompletedCaptures(IDeviceContext* pContext);
+
+    /// Waits until all pending captures are read back and encoded.
+    void Flush(IDeviceContext* pContext);
+
+    /// Returns the number of frames that were dropped by Capture().
+    Uint32 GetNumDroppedFrames() const
+    {
+        return m_NumDroppedFrames.load();
+    }
+
+    /// Returns the number of frames that have been encoded.
+    Uint32 GetNumEncodedFrames() const
+    {
+        return m_NumEncodedFrames.load();
+    }
+
 private:
+    struct EncodingJob
+    {
+        CapturedFrame      Frame;
+        std::vector<Uint8> Data;
+        Uint64             SequenceNumber = 0;
+    };
+
+    void EncodeFrame(EncodingJob& Job, std::vector<Uint8>& ScratchBuffer);
+    void EncoderThreadProc();
+
+    ScreenCaptureCreateInfo m_CreateInfo;
+    String                  m_OutputPath;
+
     RefCntAutoPtr<IFence>        m_pFence;
     RefCntAutoPtr<IRenderDevice> m_pDevice;
 
     std::mutex                           m_AvailableTexturesMtx;
     std::vector<RefCntAutoPtr<ITexture>> m_AvailableTextures;
+    Uint32                               m_NumStagingTextures = 0;
 
     std::mutex m_PendingTexturesMtx;
     struct PendingTextureInfo
@@ -94,6 +206,26 @@ private:
     std::deque<PendingTextureInfo> m_PendingTextures;
 
     Uint64 m_CurrentFenceValue = 1;
+
+    std::atomic<Uint32> m_NumDroppedFrames{0};
+    std::atomic<Uint32> m_NumEncodedFrames{0};
+
+    // Encoder threads
+    std::vector<std::thread>        m_EncoderThreads;
+    std::mutex                      m_JobsMtx;
+    std::condition_variable         m_JobsCV;
+    std::condition_variable         m_JobsDoneCV;
+    std::deque<EncodingJob>         m_Jobs;
+    std::vector<std::vector<Uint8>> m_FreeFrameBuffers;
+    Uint32                          m_NumJobsInFlight    = 0;
+    Uint64                          m_NextSequenceNumber = 0;
+    bool                            m_StopEncoders       = false;
+
+    // Video frames are written in the capture order
+    std::mutex                   m_VideoMtx;
+    std::condition_variable      m_VideoCV;
+    Uint64                       m_NextVideoFrame = 0;
+    std::unique_ptr<FileWrapper> m_pVideoFile;
 };
 
 } // namespace Diligent
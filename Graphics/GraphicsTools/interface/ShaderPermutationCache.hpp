@@ -0,0 +1,251 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ShaderPermutationKey and Diligent::ShaderPermutationCache classes
+
+#include <cstdio>
+#include <sstream>
+#include <vector>
+#include <unordered_map>
+
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/AdaptiveLock.hpp"
+
+namespace Diligent
+{
+
+/// Compact shader permutation key.
+
+/// The key is a set of shader macros whose names and definitions are interned in the global
+/// StringInternTable, so that keys compare macro strings by pointer, and a 64-bit hash that is
+/// updated incrementally as macros are added or removed. The hash only depends on the macro
+/// strings, and not on the order in which the macros were added or on the string addresses.
+/// Macros are kept sorted by name, so equal keys always produce the same shader source.
+///
+/// Unlike ShaderMacroHelper, the key does not keep a per-instance string pool and
+/// formats common numeric definitions without string streams. Definitions are formatted
+/// exactly as ShaderMacroHelper does.
+class ShaderPermutationKey
+{
+public:
+    /// Interned shader macro.
+    struct Macro
+    {
+        const Char* Name       = nullptr;
+        const Char* Definition = nullptr;
+        Uint64      Hash       = 0;
+    };
+
+    /// Adds the macro to the key. If the macro with the same name is already
+    /// present in the key, its definition is replaced.
+    ShaderPermutationKey& AddMacro(const Char* Name, const Char* Definition);
+
+    template <typename DefinitionType>
+    ShaderPermutationKey& AddMacro(const Char* Name, DefinitionType Definition)
+    {
+        std::ostringstream ss;
+        ss << Definition;
+        return AddMacro(Name, ss.str().c_str());
+    }
+
+    /// Removes the macro from the key. Returns false if the key has no macro with this name.
+    bool RemoveMacro(const Char* Name);
+
+    void Clear()
+    {
+        m_Macros.clear();
+        m_Hash = 0;
+    }
+
+    Uint64 GetHash() const { return m_Hash; }
+
+    size_t GetNumMacros() const { return m_Macros.size(); }
+
+    const Macro& GetMacro(size_t i) const
+    {
+        VERIFY_EXPR(i < m_Macros.size());
+        return m_Macros[i];
+    }
+
+    /// Writes null-terminated array of shader macros, sorted by name, that can be used in ShaderCreateInfo::Macros.
+    /// The strings are owned by the global StringInternTable and remain valid until the process terminates.
+    void GetShaderMacros(std::vector<ShaderMacro>& Macros) const;
+
+    bool operator==(const ShaderPermutationKey& rhs) const
+    {
+        if (m_Hash != rhs.m_Hash || m_Macros.size() != rhs.m_Macros.size())
+            return false;
+
+        // Macros are sorted by name, and interned strings are compared by pointers
+        for (size_t i = 0; i < m_Macros.size(); ++i)
+        {
+            if (m_Macros[i].Name != rhs.m_Macros[i].Name || m_Macros[i].Definition != rhs.m_Macros[i].Definition)
+                return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const ShaderPermutationKey& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const ShaderPermutationKey& Key) const
+        {
+            return static_cast<size_t>(Key.GetHash());
+        }
+    };
+
+    /// Returns the interned copy of the string and, optionally, its hash.
+    /// Interned strings are never released.
+    static const Char* InternString(const Char* Str, Uint64* pHash = nullptr);
+
+private:
+    std::vector<Macro> m_Macros;
+    Uint64             m_Hash = 0;
+};
+
+template <>
+inline ShaderPermutationKey& ShaderPermutationKey::AddMacro(const Char* Name, bool Definition)
+{
+    return AddMacro(Name, Definition ? "1" : "0");
+}
+
+template <>
+inline ShaderPermutationKey& ShaderPermutationKey::AddMacro(const Char* Name, Int32 Definition)
+{
+    char Buffer[16];
+    snprintf(Buffer, sizeof(Buffer), "%d", Definition);
+    return AddMacro(Name, static_cast<const Char*>(Buffer));
+}
+
+template <>
+inline ShaderPermutationKey& ShaderPermutationKey::AddMacro(const Char* Name, Uint32 Definition)
+{
+    // Make sure that uint constants have the 'u' suffix to avoid problems in GLES.
+    char Buffer[16];
+    snprintf(Buffer, sizeof(Buffer), "%uu", Definition);
+    return AddMacro(Name, static_cast<const Char*>(Buffer));
+}
+
+template <>
+inline ShaderPermutationKey& ShaderPermutationKey::AddMacro(const Char* Name, Uint8 Definition)
+{
+    return AddMacro(Name, Uint32{Definition});
+}
+
+template <>
+inline ShaderPermutationKey& ShaderPermutationKey::AddMacro(const Char* Name, float Definition)
+{
+    // Same as in ShaderMacroHelper: floats that represent integers are still written as floats.
+    char Buffer[64];
+    if (Definition == static_cast<float>(static_cast<int>(Definition)))
+        snprintf(Buffer, sizeof(Buffer), "%.1f", Definition);
+    else
+        snprintf(Buffer, sizeof(Buffer), "%g", Definition);
+    return AddMacro(Name, static_cast<const Char*>(Buffer));
+}
+
+
+/// Thread-safe cache of shader or pipeline state permutations keyed by Diligent::ShaderPermutationKey.
+
+/// \tparam ValueType - Cached value type, typically RefCntAutoPtr<IShader> or RefCntAutoPtr<IPipelineState>.
+///                     Must be default-constructible and copyable, and convertible to bool to tell
+///                     if the value is valid.
+///
+/// The cache is read-mostly: lookups only take a shared lock.
+template <typename ValueType>
+class ShaderPermutationCache
+{
+public:
+    /// Returns the cached value, or a default-constructed value if the key is not in the cache.
+    ValueType Get(const ShaderPermutationKey& Key) const
+    {
+        ThreadingTools::SharedLockGuard Lock{m_Lock};
+
+        auto it = m_Cache.find(Key);
+        return it != m_Cache.end() ? it->second : ValueType{};
+    }
+
+    /// Returns the cached value or creates a new one.
+
+    /// \param [in] Key    - Permutation key.
+    /// \param [in] Create - Function that creates the value for the key, for instance
+    ///                      void Create(const ShaderPermutationKey& Key, ValueType& Value).
+    ///                      It is called without holding the lock, so expensive operations such as
+    ///                      shader compilation do not block other threads. If several threads create
+    ///                      the same permutation simultaneously, the value created first is kept.
+    template <typename CreateFuncType>
+    ValueType GetOrCreate(const ShaderPermutationKey& Key, CreateFuncType&& Create)
+    {
+        {
+            ThreadingTools::SharedLockGuard Lock{m_Lock};
+
+            auto it = m_Cache.find(Key);
+            if (it != m_Cache.end())
+                return it->second;
+        }
+
+        ValueType Value{};
+        Create(Key, Value);
+        if (!Value)
+            return Value;
+
+        ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveRWLock> Lock{m_Lock};
+        return m_Cache.emplace(Key, std::move(Value)).first->second;
+    }
+
+    /// Removes the key from the cache. Returns false if the key was not found.
+    bool Remove(const ShaderPermutationKey& Key)
+    {
+        ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveRWLock> Lock{m_Lock};
+        return m_Cache.erase(Key) != 0;
+    }
+
+    void Clear()
+    {
+        ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveRWLock> Lock{m_Lock};
+        m_Cache.clear();
+    }
+
+    size_t GetSize() const
+    {
+        ThreadingTools::SharedLockGuard Lock{m_Lock};
+        return m_Cache.size();
+    }
+
+private:
+    mutable ThreadingTools::AdaptiveRWLock                                            m_Lock;
+    std::unordered_map<ShaderPermutationKey, ValueType, ShaderPermutationKey::Hasher> m_Cache;
+};
+
+} // namespace Diligent
@@ -0,0 +1,219 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <functional>
+
+#include "TextureUploader.hpp"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/Timer.hpp"
+
+namespace Diligent
+{
+
+/// Texture streaming scheduler description.
+struct TextureStreamingSchedulerDesc
+{
+    /// The maximum number of bytes that may be uploaded in one frame. 0 means no limit.
+    Uint64 MaxBytesPerFrame = 32 << 20;
+
+    /// The maximum number of subresource copy commands that may be issued in one frame. 0 means no limit.
+    Uint32 MaxCopyCommandsPerFrame = 256;
+};
+
+/// Texture streaming request.
+struct TextureStreamingRequest
+{
+    /// Destination texture.
+    RefCntAutoPtr<ITexture> pDstTexture;
+
+    /// Destination array slice. When multiple slices are uploaded, the starting slice.
+    Uint32 DstArraySlice = 0;
+
+    /// Destination mip level. When multiple mip levels are uploaded, the starting mip level.
+    Uint32 DstMipLevel = 0;
+
+    /// Upload buffer description. Width, height and depth are the dimensions of the first uploaded mip level.
+    UploadBufferDesc UploadDesc;
+
+    /// Request priority. Requests with higher priority are uploaded first; requests with
+    /// equal priority are uploaded in the submission order.
+    /// The priority is typically derived from the mip level and the screen-space importance
+    /// of the texture, see ComputeStreamingPriority().
+    float Priority = 0;
+
+    /// Callback that writes texture data to the mapped upload buffer. It is called by the
+    /// render thread from TextureStreamingScheduler::Update() when the request is dispatched.
+    std::function<void(IUploadBuffer* pUploadBuffer)> WriteData;
+
+    /// Optional callback that is called from TextureStreamingScheduler::Update() after the
+    /// GPU copy has been scheduled.
+    std::function<void()> OnCopyScheduled;
+};
+
+/// Returns the streaming priority for the given mip level of a texture.
+
+/// \param [in] ScreenImportance - Screen-space importance of the texture, e.g. the
+///                                projected area of the objects that use it.
+/// \param [in] MipLevel         - Mip level being uploaded.
+/// \param [in] NumMipLevels     - Total number of mip levels in the texture.
+///
+/// \remarks    Coarse mip levels are small and are needed first, so every coarser level
+///             doubles the priority.
+inline float ComputeStreamingPriority(float ScreenImportance, Uint32 MipLevel, Uint32 NumMipLevels)
+{
+    const auto CoarseLevel = MipLevel < NumMipLevels ? MipLevel : NumMipLevels;
+    return ScreenImportance * static_cast<float>(1u << (CoarseLevel < 24 ? CoarseLevel : 24));
+}
+
+/// Texture streaming scheduler statistics.
+struct TextureStreamingStats
+{
+    /// The number of requests waiting in the queue.
+    Uint32 NumPendingRequests = 0;
+
+    /// The total size of the pending requests, in bytes.
+    Uint64 NumPendingBytes = 0;
+
+    /// The number of requests whose copies have been scheduled.
+    Uint64 NumCompletedRequests = 0;
+
+    /// The number of cancelled requests.
+    Uint64 NumCancelledRequests = 0;
+
+    /// The number of bytes uploaded during the last Update().
+    Uint64 NumBytesLastFrame = 0;
+
+    /// The number of copy commands issued during the last Update().
+    Uint32 NumCopyCommandsLastFrame = 0;
+
+    /// The number of requests dispatched during the last Update().
+    Uint32 NumRequestsLastFrame = 0;
+
+    /// Average latency, in seconds, between the submission of a request and scheduling of its copy.
+    double AverageLatency = 0;
+
+    /// Maximum latency, in seconds.
+    double MaxLatency = 0;
+
+    /// Average latency, in frames (calls to Update()).
+    double AverageLatencyFrames = 0;
+
+    /// Maximum latency, in frames.
+    Uint32 MaxLatencyFrames = 0;
+};
+
+/// Schedules prioritized texture uploads within a per-frame budget.
+
+/// The scheduler sits on top of ITextureUploader. Requests may be submitted, cancelled and
+/// re-prioritized from any thread. Every frame, the render thread calls Update(), which dispatches
+/// the highest-priority requests as long as they fit into the byte and copy command budget.
+/// Requests are dispatched in strict priority order: if the next request does not fit into the
+/// remaining budget of the frame, it waits for the next frame and no lower-priority request
+/// is allowed to overtake it.
+class TextureStreamingScheduler
+{
+public:
+    using RequestId = Uint64;
+
+    /// Invalid request id.
+    static constexpr RequestId InvalidRequestId = 0;
+
+    TextureStreamingScheduler(ITextureUploader* pUploader, const TextureStreamingSchedulerDesc& Desc);
+    ~TextureStreamingScheduler();
+
+    // clang-format off
+    TextureStreamingScheduler           (const TextureStreamingScheduler&) = delete;
+    TextureStreamingScheduler& operator=(const TextureStreamingScheduler&) = delete;
+    // clang-format on
+
+    /// Submits the request and returns its id. Returns InvalidRequestId if the request
+    /// is invalid or can never fit into the per-frame budget.
+    RequestId Submit(TextureStreamingRequest&& Request);
+
+    /// Cancels the request. Returns false if the request has already been dispatched or does not exist.
+    bool Cancel(RequestId Id);
+
+    /// Changes the priority of a pending request. Returns false if the request has already
+    /// been dispatched or does not exist.
+    bool SetPriority(RequestId Id, float Priority);
+
+    /// Dispatches the requests that fit into the per-frame budget. Must be called once per frame
+    /// by the render thread.
+    void Update(IDeviceContext* pContext);
+
+    /// Returns the size of the data uploaded by the request, in bytes.
+    static Uint64 GetRequestSize(const UploadBufferDesc& Desc);
+
+    TextureStreamingStats GetStats();
+
+    const TextureStreamingSchedulerDesc& GetDesc() const { return m_Desc; }
+
+private:
+    struct QueueKey
+    {
+        float     Priority;
+        RequestId Id;
+
+        bool operator<(const QueueKey& rhs) const
+        {
+            // Higher priority first, then in the submission order
+            return Priority != rhs.Priority ? Priority > rhs.Priority : Id < rhs.Id;
+        }
+    };
+
+    struct PendingRequest
+    {
+        TextureStreamingRequest Request;
+
+        Uint64 Size            = 0;
+        Uint32 NumCopyCommands = 0;
+        double SubmitTime      = 0;
+        Uint64 SubmitFrame     = 0;
+    };
+
+    RefCntAutoPtr<ITextureUploader>     m_pUploader;
+    const TextureStreamingSchedulerDesc m_Desc;
+
+    std::mutex                                    m_Mtx;
+    std::set<QueueKey>                            m_Queue;
+    std::unordered_map<RequestId, PendingRequest> m_Requests;
+    RequestId                                     m_NextRequestId = 1;
+    Uint64                                        m_FrameNumber   = 0;
+
+    TextureStreamingStats m_Stats;
+    double                m_TotalLatency       = 0;
+    Uint64                m_TotalLatencyFrames = 0;
+
+    Timer m_Timer;
+};
+
+} // namespace Diligent
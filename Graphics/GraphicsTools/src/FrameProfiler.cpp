@@ -0,0 +1,323 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "FrameProfiler.hpp"
+
+#include <iomanip>
+
+namespace Diligent
+{
+
+FrameProfiler::FrameProfiler(IRenderDevice* pDevice,
+                             Uint32         MaxFramesInFlight,
+                             Uint32         NumScopesToReserve) :
+    // clang-format off
+    m_pDevice            {pDevice},
+    m_MaxFramesInFlight  {std::max(MaxFramesInFlight, 1u)},
+    m_TimestampsSupported{pDevice->GetDeviceCaps().Features.TimestampQueries != False}
+// clang-format on
+{
+    m_CurrentFrame.Result.Scopes.reserve(NumScopesToReserve);
+    m_CurrentFrame.Queries.reserve(NumScopesToReserve);
+    m_ScopeStack.reserve(16);
+
+    if (m_TimestampsSupported)
+    {
+        m_AvailableQueries.reserve(size_t{NumScopesToReserve} * 2);
+        for (Uint32 i = 0; i < NumScopesToReserve * 2; ++i)
+            m_AvailableQueries.emplace_back(AllocateQuery());
+    }
+}
+
+RefCntAutoPtr<IQuery> FrameProfiler::AllocateQuery()
+{
+    if (!m_AvailableQueries.empty())
+    {
+        auto pQuery = std::move(m_AvailableQueries.back());
+        m_AvailableQueries.pop_back();
+        return pQuery;
+    }
+
+    QueryDesc queryDesc{QUERY_TYPE_TIMESTAMP};
+    queryDesc.Name = "Frame profiler timestamp query";
+
+    RefCntAutoPtr<IQuery> pQuery;
+    m_pDevice->CreateQuery(queryDesc, &pQuery);
+    VERIFY(pQuery, "Failed to create timestamp query");
+    return pQuery;
+}
+
+void FrameProfiler::BeginFrame()
+{
+    if (m_InsideFrame)
+    {
+        LOG_ERROR_MESSAGE("FrameProfiler::BeginFrame() is called twice without a matching EndFrame()");
+        return;
+    }
+
+    m_InsideFrame = true;
+
+    // Do not allocate more queries while too many frames are waiting for their results
+    m_RecordGPUTimeInFrame = m_TimestampsSupported && m_PendingFrames.size() < m_MaxFramesInFlight;
+    if (m_TimestampsSupported && !m_RecordGPUTimeInFrame)
+        ++m_NumFramesWithoutGPUTime;
+
+    auto& Result       = m_CurrentFrame.Result;
+    Result.FrameNumber = m_FrameNumber++;
+    Result.CPUStart    = m_Timer.GetElapsedTime();
+    Result.CPUEnd      = Result.CPUStart;
+}
+
+void FrameProfiler::BeginScope(IDeviceContext* pCtx, const Char* Name, const float* pColor, bool RecordGPUTime)
+{
+    VERIFY_EXPR(pCtx != nullptr && Name != nullptr);
+    if (!m_InsideFrame)
+    {
+        LOG_ERROR_MESSAGE("Scope '", Name, "' is begun outside of BeginFrame()/EndFrame()");
+        return;
+    }
+
+    pCtx->BeginDebugGroup(Name, pColor);
+
+    ScopeResult Scope;
+    Scope.Name     = Name;
+    Scope.Depth    = static_cast<Uint32>(m_ScopeStack.size());
+    Scope.Parent   = m_ScopeStack.empty() ? -1 : static_cast<Int32>(m_ScopeStack.back());
+    Scope.CPUStart = m_Timer.GetElapsedTime();
+
+    ScopeQueries Queries;
+    if (m_RecordGPUTimeInFrame && RecordGPUTime)
+    {
+        Queries.Start = AllocateQuery();
+        Queries.End   = AllocateQuery();
+        pCtx->EndQuery(Queries.Start);
+    }
+
+    m_ScopeStack.push_back(static_cast<Uint32>(m_CurrentFrame.Result.Scopes.size()));
+    m_CurrentFrame.Result.Scopes.emplace_back(std::move(Scope));
+    m_CurrentFrame.Queries.emplace_back(std::move(Queries));
+}
+
+void FrameProfiler::EndScope(IDeviceContext* pCtx)
+{
+    VERIFY_EXPR(pCtx != nullptr);
+    if (m_ScopeStack.empty())
+    {
+        LOG_ERROR_MESSAGE("There are no open scopes, which likely indicates inconsistent BeginScope()/EndScope() calls");
+        return;
+    }
+
+    const auto ScopeIdx = m_ScopeStack.back();
+    m_ScopeStack.pop_back();
+
+    auto& Queries = m_CurrentFrame.Queries[ScopeIdx];
+    if (Queries.End)
+        pCtx->EndQuery(Queries.End);
+
+    m_CurrentFrame.Result.Scopes[ScopeIdx].CPUEnd = m_Timer.GetElapsedTime();
+
+    pCtx->EndDebugGroup();
+}
+
+void FrameProfiler::EndFrame()
+{
+    if (!m_InsideFrame)
+    {
+        LOG_ERROR_MESSAGE("FrameProfiler::EndFrame() is called without a matching BeginFrame()");
+        return;
+    }
+
+    if (!m_ScopeStack.empty())
+    {
+        LOG_ERROR_MESSAGE(m_ScopeStack.size(), " scope(s) have not been ended in frame ", m_CurrentFrame.Result.FrameNumber,
+                          ", which likely indicates inconsistent BeginScope()/EndScope() calls");
+        const auto CPUTime = m_Timer.GetElapsedTime();
+        for (auto ScopeIdx : m_ScopeStack)
+            m_CurrentFrame.Result.Scopes[ScopeIdx].CPUEnd = CPUTime;
+        m_ScopeStack.clear();
+    }
+
+    m_InsideFrame                = false;
+    m_CurrentFrame.Result.CPUEnd = m_Timer.GetElapsedTime();
+
+    m_PendingFrames.emplace_back(std::move(m_CurrentFrame));
+    m_CurrentFrame = PendingFrame{};
+
+    // Resolve all frames whose results are ready. Frames are resolved in order, so
+    // a frame that is not ready blocks resolving the frames that follow it. Frames
+    // are never dropped: their queries may still be in flight and cannot be reused.
+    while (!m_PendingFrames.empty())
+    {
+        auto& OldestFrame = m_PendingFrames.front();
+        if (!TryResolveFrame(OldestFrame))
+            break;
+
+        // Swap rather than move to reuse the memory of the previous results
+        std::swap(m_LastResolvedFrame, OldestFrame.Result);
+        m_HasResolvedFrame = true;
+        ++m_NumResolvedFrames;
+
+        // The data of all queries has been read, so they can be reused
+        RecycleQueries(OldestFrame);
+        // Reuse the memory of the oldest frame for the next frame
+        m_CurrentFrame = std::move(OldestFrame);
+        m_CurrentFrame.Result.Scopes.clear();
+        m_CurrentFrame.Queries.clear();
+        m_PendingFrames.pop_front();
+    }
+}
+
+bool FrameProfiler::TryResolveFrame(PendingFrame& Frame)
+{
+    VERIFY_EXPR(Frame.Result.Scopes.size() == Frame.Queries.size());
+
+    // Do not invalidate the queries until data from all of them is available
+    for (auto& Queries : Frame.Queries)
+    {
+        if (!Queries.Start)
+            continue;
+
+        if (!Queries.Start->GetData(nullptr, 0, false) || !Queries.End->GetData(nullptr, 0, false))
+            return false;
+    }
+
+    for (size_t i = 0; i < Frame.Queries.size(); ++i)
+    {
+        auto& Queries = Frame.Queries[i];
+        if (!Queries.Start)
+            continue;
+
+        QueryDataTimestamp StartData, EndData;
+        Queries.Start->GetData(&StartData, sizeof(StartData), false);
+        Queries.End->GetData(&EndData, sizeof(EndData), false);
+
+        auto& Scope      = Frame.Result.Scopes[i];
+        Scope.GPUStart   = static_cast<double>(StartData.Counter) / static_cast<double>(StartData.Frequency);
+        Scope.GPUEnd     = static_cast<double>(EndData.Counter) / static_cast<double>(EndData.Frequency);
+        Scope.HasGPUTime = true;
+    }
+
+    return true;
+}
+
+void FrameProfiler::RecycleQueries(PendingFrame& Frame)
+{
+    for (auto& Queries : Frame.Queries)
+    {
+        if (!Queries.Start)
+            continue;
+
+        Queries.Start->Invalidate();
+        Queries.End->Invalidate();
+        m_AvailableQueries.emplace_back(std::move(Queries.Start));
+        m_AvailableQueries.emplace_back(std::move(Queries.End));
+    }
+    Frame.Queries.clear();
+}
+
+static void WriteJSONString(std::ostream& Stream, const String& Str)
+{
+    Stream << '"';
+    for (auto c : Str)
+    {
+        switch (c)
+        {
+            case '"': Stream << "\\\""; break;
+            case '\\': Stream << "\\\\"; break;
+            case '\n': Stream << "\\n"; break;
+            case '\r': Stream << "\\r"; break;
+            case '\t': Stream << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    Stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+                else
+                    Stream << c;
+        }
+    }
+    Stream << '"';
+}
+
+static void WriteTraceEvent(std::ostream& Stream, const String& Name, const char* Category, int ThreadId, double Start, double End, bool& First)
+{
+    if (!First)
+        Stream << ",\n";
+    First = false;
+
+    // Chrome trace timestamps are in microseconds
+    Stream << "{\"name\":";
+    WriteJSONString(Stream, Name);
+    Stream << ",\"cat\":\"" << Category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ThreadId
+           << ",\"ts\":" << Start * 1e+6 << ",\"dur\":" << std::max(End - Start, 0.0) * 1e+6 << "}";
+}
+
+void FrameProfiler::WriteChromeTrace(const FrameResult& Frame, std::ostream& Stream)
+{
+    const auto Flags     = Stream.flags();
+    const auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(3);
+
+    static constexpr int CPUThreadId = 1;
+    static constexpr int GPUThreadId = 2;
+
+    Stream << "{\"traceEvents\":[\n"
+           << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << CPUThreadId << ",\"args\":{\"name\":\"CPU\"}},\n"
+           << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GPUThreadId << ",\"args\":{\"name\":\"GPU\"}}";
+
+    bool First = false;
+    WriteTraceEvent(Stream, "Frame " + std::to_string(Frame.FrameNumber), "CPU", CPUThreadId, Frame.CPUStart, Frame.CPUEnd, First);
+    for (const auto& Scope : Frame.Scopes)
+        WriteTraceEvent(Stream, Scope.Name, "CPU", CPUThreadId, Scope.CPUStart, Scope.CPUEnd, First);
+
+    double GPUOrigin    = 0;
+    bool   HasGPUOrigin = false;
+    for (const auto& Scope : Frame.Scopes)
+    {
+        if (Scope.HasGPUTime && (!HasGPUOrigin || Scope.GPUStart < GPUOrigin))
+        {
+            GPUOrigin    = Scope.GPUStart;
+            HasGPUOrigin = true;
+        }
+    }
+
+    for (const auto& Scope : Frame.Scopes)
+    {
+        if (!Scope.HasGPUTime)
+            continue;
+
+        const auto Start = Frame.CPUStart + (Scope.GPUStart - GPUOrigin);
+        const auto End   = Frame.CPUStart + (Scope.GPUEnd - GPUOrigin);
+        WriteTraceEvent(Stream, Scope.Name, "GPU", GPUThreadId, Start, End, First);
+    }
+
+    Stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+} // namespace Diligent
@@ -28,18 +28,72 @@
 #include "pch.h"
 #include "ScreenCapture.hpp"
 
+#include <cstdio>
+
+#include "GraphicsAccessories.hpp"
+#include "ColorConversion.h"
+#include "FileWrapper.hpp"
+
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "../../../ThirdParty/stb/stb_image_write.h"
+
 namespace Diligent
 {
 
 ScreenCapture::ScreenCapture(IRenderDevice* pDevice) :
+    ScreenCapture{pDevice, ScreenCaptureCreateInfo{}}
+{
+}
+
+ScreenCapture::ScreenCapture(IRenderDevice* pDevice, const ScreenCaptureCreateInfo& CI) :
+    m_CreateInfo{CI},
+    m_OutputPath{CI.OutputPath != nullptr ? CI.OutputPath : ""},
     m_pDevice{pDevice}
 {
+    m_CreateInfo.OutputPath = nullptr;
+
     FenceDesc fenceDesc;
     fenceDesc.Name = "Screen capture fence";
     m_pDevice->CreateFence(fenceDesc, &m_pFence);
+
+    if (m_CreateInfo.Encoding != SCREEN_CAPTURE_ENCODING_NONE && m_OutputPath.empty())
+    {
+        LOG_ERROR_MESSAGE("Output path must not be empty when screen capture encoding is not SCREEN_CAPTURE_ENCODING_NONE. Frames will not be written.");
+        m_CreateInfo.Encoding = SCREEN_CAPTURE_ENCODING_NONE;
+    }
+
+    if (m_CreateInfo.Encoding == SCREEN_CAPTURE_ENCODING_RAW_VIDEO)
+    {
+        m_pVideoFile.reset(new FileWrapper{m_OutputPath.c_str(), EFileAccessMode::Overwrite});
+        if (*m_pVideoFile == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to open video file '", m_OutputPath, "'");
+            m_pVideoFile.reset();
+        }
+    }
+
+    // Encoder threads are only needed when there is something to do with the frames
+    if (m_CreateInfo.Encoding != SCREEN_CAPTURE_ENCODING_NONE || m_CreateInfo.FrameCallback)
+    {
+        m_EncoderThreads.reserve(m_CreateInfo.NumEncoderThreads);
+        for (Uint32 i = 0; i < m_CreateInfo.NumEncoderThreads; ++i)
+            m_EncoderThreads.emplace_back(&ScreenCapture::EncoderThreadProc, this);
+    }
+}
+
+ScreenCapture::~ScreenCapture()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_JobsMtx};
+        m_StopEncoders = true;
+    }
+    m_JobsCV.notify_all();
+    for (auto& Thread : m_EncoderThreads)
+        Thread.join();
 }
 
-void ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId)
+bool ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId)
 {
     auto*       pCurrentRTV        = pSwapChain->GetCurrentBackBufferRTV();
     auto*       pCurrentBackBuffer = pCurrentRTV->GetTexture();
@@ -59,8 +113,21 @@ void ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Ui
                   TexDesc.Format == SCDesc.ColorBufferFormat))
             {
                 pStagingTexture.Release();
+                VERIFY_EXPR(m_NumStagingTextures > 0);
+                --m_NumStagingTextures;
             }
         }
+
+        if (!pStagingTexture)
+        {
+            if (m_CreateInfo.NumStagingTextures != 0 && m_NumStagingTextures >= m_CreateInfo.NumStagingTextures)
+            {
+                // All textures of the ring are in flight. Drop the frame rather than stall the render thread.
+                m_NumDroppedFrames.fetch_add(1);
+                return false;
+            }
+            ++m_NumStagingTextures;
+        }
     }
 
     if (!pStagingTexture)
@@ -74,6 +141,13 @@ void ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Ui
         TexDesc.Usage          = USAGE_STAGING;
         TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
         m_pDevice->CreateTexture(TexDesc, nullptr, &pStagingTexture);
+        if (!pStagingTexture)
+        {
+            LOG_ERROR_MESSAGE("Failed to create staging texture for screen capture");
+            std::lock_guard<std::mutex> Lock{m_AvailableTexturesMtx};
+            --m_NumStagingTextures;
+            return false;
+        }
     }
 
     CopyTextureAttribs CopyAttribs(pCurrentBackBuffer, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
@@ -86,6 +160,8 @@ void ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Ui
     }
 
     ++m_CurrentFenceValue;
+
+    return true;
 }
 
 
@@ -129,4 +205,234 @@ void ScreenCapture::RecycleStagingTexture(RefCntAutoPtr<ITexture>&& pTexture)
     m_AvailableTextures.emplace_back(std::move(pTexture));
 }
 
+Uint32 ScreenCapture::ProcessCompletedCaptures(IDeviceContext* pContext)
+{
+    Uint32 NumProcessed = 0;
+    while (true)
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+        Uint32                  Id = 0;
+        {
+            std::lock_guard<std::mutex> Lock{m_PendingTexturesMtx};
+            if (m_PendingTextures.empty() || m_PendingTextures.front().Fence > m_pFence->GetCompletedValue())
+                break;
+
+            auto& OldestCapture = m_PendingTextures.front();
+            pTexture            = std::move(OldestCapture.pTex);
+            Id                  = OldestCapture.Id;
+            m_PendingTextures.pop_front();
+        }
+
+        const auto& TexDesc = pTexture->GetDesc();
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        if (MappedData.pData == nullptr)
+        {
+            // The copy has not been completed yet despite the fence, try again next time
+            std::lock_guard<std::mutex> Lock{m_PendingTexturesMtx};
+            m_PendingTextures.emplace_front(std::move(pTexture), Id, Uint64{0});
+            break;
+        }
+
+        const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+
+        EncodingJob Job;
+        Job.Frame.Id     = Id;
+        Job.Frame.Width  = TexDesc.Width;
+        Job.Frame.Height = TexDesc.Height;
+        Job.Frame.Format = TexDesc.Format;
+        Job.Frame.Stride = TexDesc.Width * Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+        {
+            std::lock_guard<std::mutex> Lock{m_JobsMtx};
+            if (!m_FreeFrameBuffers.empty())
+            {
+                Job.Data = std::move(m_FreeFrameBuffers.back());
+                m_FreeFrameBuffers.pop_back();
+            }
+            Job.SequenceNumber = m_NextSequenceNumber++;
+        }
+
+        // Copy tightly packed rows so that the staging texture can be reused right away
+        Job.Data.resize(size_t{Job.Frame.Stride} * size_t{Job.Frame.Height});
+        for (Uint32 row = 0; row < TexDesc.Height; ++row)
+        {
+            memcpy(Job.Data.data() + size_t{row} * Job.Frame.Stride,
+                   reinterpret_cast<const Uint8*>(MappedData.pData) + size_t{row} * MappedData.Stride,
+                   Job.Frame.Stride);
+        }
+        Job.Frame.pData = Job.Data.data();
+
+        pContext->UnmapTextureSubresource(pTexture, 0, 0);
+        RecycleStagingTexture(std::move(pTexture));
+        ++NumProcessed;
+
+        if (m_EncoderThreads.empty())
+        {
+            std::vector<Uint8> ScratchBuffer;
+            EncodeFrame(Job, ScratchBuffer);
+            std::lock_guard<std::mutex> Lock{m_JobsMtx};
+            m_FreeFrameBuffers.emplace_back(std::move(Job.Data));
+        }
+        else
+        {
+            {
+                std::lock_guard<std::mutex> Lock{m_JobsMtx};
+                m_Jobs.emplace_back(std::move(Job));
+                ++m_NumJobsInFlight;
+            }
+            m_JobsCV.notify_one();
+        }
+    }
+
+    return NumProcessed;
+}
+
+void ScreenCapture::Flush(IDeviceContext* pContext)
+{
+    if (m_CurrentFenceValue > 1)
+        pContext->WaitForFence(m_pFence, m_CurrentFenceValue - 1, true);
+
+    while (GetNumPendingCaptures() > 0)
+    {
+        if (ProcessCompletedCaptures(pContext) == 0)
+            std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> Lock{m_JobsMtx};
+    m_JobsDoneCV.wait(Lock, [this] { return m_NumJobsInFlight == 0; });
+}
+
+void ScreenCapture::EncoderThreadProc()
+{
+    std::vector<Uint8> ScratchBuffer;
+    while (true)
+    {
+        EncodingJob Job;
+        {
+            std::unique_lock<std::mutex> Lock{m_JobsMtx};
+            // Remaining jobs are always completed before the thread exits
+            m_JobsCV.wait(Lock, [this] { return m_StopEncoders || !m_Jobs.empty(); });
+            if (m_Jobs.empty())
+                break;
+
+            Job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+        }
+
+        EncodeFrame(Job, ScratchBuffer);
+
+        {
+            std::lock_guard<std::mutex> Lock{m_JobsMtx};
+            m_FreeFrameBuffers.emplace_back(std::move(Job.Data));
+            VERIFY_EXPR(m_NumJobsInFlight > 0);
+            --m_NumJobsInFlight;
+        }
+        m_JobsDoneCV.notify_all();
+    }
+}
+
+namespace
+{
+
+void WritePNGData(void* pContext, void* pData, int Size)
+{
+    auto* pFile = reinterpret_cast<FileWrapper*>(pContext);
+    (*pFile)->Write(pData, static_cast<size_t>(Size));
+}
+
+String GetFrameFileName(const String& Prefix, Uint32 Id, const char* Extension)
+{
+    char IdStr[16];
+    snprintf(IdStr, sizeof(IdStr), "%06u", Id);
+    return Prefix + IdStr + Extension;
+}
+
+} // namespace
+
+void ScreenCapture::EncodeFrame(EncodingJob& Job, std::vector<Uint8>& ScratchBuffer)
+{
+    const auto& Frame = Job.Frame;
+    switch (m_CreateInfo.Encoding)
+    {
+        case SCREEN_CAPTURE_ENCODING_NONE:
+            break;
+
+        case SCREEN_CAPTURE_ENCODING_RAW:
+        {
+            const auto  FileName = GetFrameFileName(m_OutputPath, Frame.Id, ".raw");
+            FileWrapper File{FileName.c_str(), EFileAccessMode::Overwrite};
+            if (!File || !File->Write(Frame.pData, size_t{Frame.Stride} * size_t{Frame.Height}))
+                LOG_ERROR_MESSAGE("Failed to write captured frame to file '", FileName, "'");
+            break;
+        }
+
+        case SCREEN_CAPTURE_ENCODING_PNG:
+        {
+            const Uint8* pRGBAData  = Frame.pData;
+            Uint32       RGBAStride = Frame.Stride;
+            if (Frame.Format != TEX_FORMAT_RGBA8_UNORM && Frame.Format != TEX_FORMAT_RGBA8_UNORM_SRGB)
+            {
+                // Floating-point formats are converted to sRGB for display
+                const auto DstFormat = (Frame.Format == TEX_FORMAT_BGRA8_UNORM) ? TEX_FORMAT_RGBA8_UNORM : TEX_FORMAT_RGBA8_UNORM_SRGB;
+                if (!IsColorConversionSupported(Frame.Format, DstFormat))
+                {
+                    LOG_ERROR_MESSAGE("Frames in ", GetTextureFormatAttribs(Frame.Format).Name, " format can't be encoded to PNG");
+                    break;
+                }
+
+                RGBAStride = Frame.Width * 4;
+                ScratchBuffer.resize(size_t{RGBAStride} * size_t{Frame.Height});
+
+                ColorConversionAttribs ConvAttribs;
+                ConvAttribs.pSrcData  = Frame.pData;
+                ConvAttribs.SrcStride = Frame.Stride;
+                ConvAttribs.SrcFormat = Frame.Format;
+                ConvAttribs.pDstData  = ScratchBuffer.data();
+                ConvAttribs.DstStride = RGBAStride;
+                ConvAttribs.DstFormat = DstFormat;
+                ConvAttribs.Width     = Frame.Width;
+                ConvAttribs.Height    = Frame.Height;
+                // Frames are already encoded in parallel
+                ConvAttribs.MaxThreads = 1;
+                ConvertImage(ConvAttribs);
+                pRGBAData = ScratchBuffer.data();
+            }
+
+            const auto  FileName = GetFrameFileName(m_OutputPath, Frame.Id, ".png");
+            FileWrapper File{FileName.c_str(), EFileAccessMode::Overwrite};
+            if (!File ||
+                stbi_write_png_to_func(WritePNGData, &File, static_cast<int>(Frame.Width), static_cast<int>(Frame.Height), 4, pRGBAData, static_cast<int>(RGBAStride)) == 0)
+            {
+                LOG_ERROR_MESSAGE("Failed to write captured frame to file '", FileName, "'");
+            }
+            break;
+        }
+
+        case SCREEN_CAPTURE_ENCODING_RAW_VIDEO:
+        {
+            // Frames may be encoded by multiple threads, but must be written in the capture order
+            std::unique_lock<std::mutex> Lock{m_VideoMtx};
+            m_VideoCV.wait(Lock, [&] { return m_NextVideoFrame == Job.SequenceNumber; });
+            if (m_pVideoFile)
+            {
+                if (!(*m_pVideoFile)->Write(Frame.pData, size_t{Frame.Stride} * size_t{Frame.Height}))
+                    LOG_ERROR_MESSAGE("Failed to write frame ", Frame.Id, " to video file '", m_OutputPath, "'");
+            }
+            ++m_NextVideoFrame;
+            Lock.unlock();
+            m_VideoCV.notify_all();
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected screen capture encoding");
+    }
+
+    if (m_CreateInfo.FrameCallback)
+        m_CreateInfo.FrameCallback(Frame);
+
+    m_NumEncodedFrames.fetch_add(1);
+}
+
 } // namespace Diligent
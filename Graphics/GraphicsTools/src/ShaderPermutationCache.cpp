@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ShaderPermutationCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "StringInternTable.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Finalizer of the SplitMix64 generator
+inline Uint64 MixHash(Uint64 h)
+{
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+}
+
+// Macros are sorted by the name contents rather than by the interned pointers, so that the
+// order of macros, and thus the shader source, does not depend on the string addresses.
+inline std::vector<ShaderPermutationKey::Macro>::iterator FindMacro(std::vector<ShaderPermutationKey::Macro>& Macros, const Char* Name)
+{
+    return std::lower_bound(Macros.begin(), Macros.end(), Name,
+                            [](const ShaderPermutationKey::Macro& M, const Char* Name) { return strcmp(M.Name, Name) < 0; });
+}
+
+} // namespace
+
+const Char* ShaderPermutationKey::InternString(const Char* Str, Uint64* pHash)
+{
+    VERIFY(Str != nullptr, "String must not be null");
+    const auto InternedStr = StringInternTable::GetGlobal().Intern(Str);
+    if (pHash != nullptr)
+        *pHash = InternedStr.GetHash();
+    return InternedStr.GetStr();
+}
+
+ShaderPermutationKey& ShaderPermutationKey::AddMacro(const Char* Name, const Char* Definition)
+{
+    Macro NewMacro;
+
+    Uint64 NameHash = 0, DefinitionHash = 0;
+    NewMacro.Name       = InternString(Name, &NameHash);
+    NewMacro.Definition = InternString(Definition, &DefinitionHash);
+    NewMacro.Hash       = MixHash(NameHash * 0x9e3779b97f4a7c15ull + DefinitionHash);
+
+    auto it = FindMacro(m_Macros, NewMacro.Name);
+    if (it != m_Macros.end() && it->Name == NewMacro.Name)
+    {
+        m_Hash -= it->Hash;
+        *it = NewMacro;
+    }
+    else
+    {
+        m_Macros.insert(it, NewMacro);
+    }
+
+    // Sum of macro hashes does not depend on the order of macros
+    m_Hash += NewMacro.Hash;
+
+    return *this;
+}
+
+bool ShaderPermutationKey::RemoveMacro(const Char* Name)
+{
+    VERIFY(Name != nullptr, "Macro name must not be null");
+
+    // Do not intern the name: if it has never been interned, the key can't contain it
+    const auto InternedName = StringInternTable::GetGlobal().Find(Name);
+    if (!InternedName)
+        return false;
+
+    auto it = FindMacro(m_Macros, InternedName.GetStr());
+    if (it == m_Macros.end() || it->Name != InternedName.GetStr())
+        return false;
+
+    m_Hash -= it->Hash;
+    m_Macros.erase(it);
+    return true;
+}
+
+void ShaderPermutationKey::GetShaderMacros(std::vector<ShaderMacro>& Macros) const
+{
+    Macros.clear();
+    Macros.reserve(m_Macros.size() + 1);
+    for (const auto& M : m_Macros)
+        Macros.emplace_back(M.Name, M.Definition);
+    Macros.emplace_back(nullptr, nullptr);
+}
+
+} // namespace Diligent
@@ -0,0 +1,235 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "TextureStreamingScheduler.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+constexpr TextureStreamingScheduler::RequestId TextureStreamingScheduler::InvalidRequestId;
+
+TextureStreamingScheduler::TextureStreamingScheduler(ITextureUploader* pUploader, const TextureStreamingSchedulerDesc& Desc) :
+    m_pUploader{pUploader},
+    m_Desc{Desc}
+{
+    VERIFY(m_pUploader, "Texture uploader must not be null");
+}
+
+TextureStreamingScheduler::~TextureStreamingScheduler()
+{
+    if (!m_Requests.empty())
+    {
+        LOG_INFO_MESSAGE("TextureStreamingScheduler: discarding ", m_Requests.size(), " pending request", (m_Requests.size() > 1 ? "s" : ""));
+    }
+}
+
+Uint64 TextureStreamingScheduler::GetRequestSize(const UploadBufferDesc& Desc)
+{
+    TextureDesc TexDesc;
+    TexDesc.Type   = Desc.Depth > 1 ? RESOURCE_DIM_TEX_3D : RESOURCE_DIM_TEX_2D;
+    TexDesc.Width  = Desc.Width;
+    TexDesc.Height = Desc.Height;
+    TexDesc.Format = Desc.Format;
+    if (TexDesc.Type == RESOURCE_DIM_TEX_3D)
+        TexDesc.Depth = Desc.Depth;
+
+    Uint64 Size = 0;
+    for (Uint32 Mip = 0; Mip < Desc.MipLevels; ++Mip)
+        Size += GetMipLevelProperties(TexDesc, Mip).MipSize;
+
+    return Size * Desc.ArraySize;
+}
+
+TextureStreamingScheduler::RequestId TextureStreamingScheduler::Submit(TextureStreamingRequest&& Request)
+{
+    if (!Request.pDstTexture)
+    {
+        LOG_ERROR_MESSAGE("Destination texture of the streaming request must not be null");
+        return InvalidRequestId;
+    }
+
+    const auto& Desc = Request.UploadDesc;
+    if (Desc.Width == 0 || Desc.Height == 0 || Desc.MipLevels == 0 || Desc.ArraySize == 0 || Desc.Format == TEX_FORMAT_UNKNOWN)
+    {
+        LOG_ERROR_MESSAGE("Invalid upload buffer description of the streaming request to texture '", Request.pDstTexture->GetDesc().Name, "'");
+        return InvalidRequestId;
+    }
+
+    PendingRequest Pending;
+    Pending.Size            = GetRequestSize(Desc);
+    Pending.NumCopyCommands = Desc.MipLevels * Desc.ArraySize;
+    if ((m_Desc.MaxBytesPerFrame != 0 && Pending.Size > m_Desc.MaxBytesPerFrame) ||
+        (m_Desc.MaxCopyCommandsPerFrame != 0 && Pending.NumCopyCommands > m_Desc.MaxCopyCommandsPerFrame))
+    {
+        LOG_ERROR_MESSAGE("Streaming request to texture '", Request.pDstTexture->GetDesc().Name, "' (", Pending.Size, " bytes, ",
+                          Pending.NumCopyCommands, " copies) exceeds the per-frame budget. Split the request into smaller ones.");
+        return InvalidRequestId;
+    }
+    Pending.Request = std::move(Request);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    Pending.SubmitTime  = m_Timer.GetElapsedTime();
+    Pending.SubmitFrame = m_FrameNumber;
+
+    const auto Id       = m_NextRequestId++;
+    const auto Priority = Pending.Request.Priority;
+    m_Stats.NumPendingBytes += Pending.Size;
+    m_Requests.emplace(Id, std::move(Pending));
+    m_Queue.insert(QueueKey{Priority, Id});
+
+    return Id;
+}
+
+bool TextureStreamingScheduler::Cancel(RequestId Id)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Requests.find(Id);
+    if (it == m_Requests.end())
+        return false;
+
+    m_Queue.erase(QueueKey{it->second.Request.Priority, Id});
+    m_Stats.NumPendingBytes -= it->second.Size;
+    ++m_Stats.NumCancelledRequests;
+    m_Requests.erase(it);
+
+    return true;
+}
+
+bool TextureStreamingScheduler::SetPriority(RequestId Id, float Priority)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Requests.find(Id);
+    if (it == m_Requests.end())
+        return false;
+
+    auto& Request = it->second.Request;
+    if (Request.Priority != Priority)
+    {
+        // Re-inserting the key keeps the submission order among requests with equal priority
+        m_Queue.erase(QueueKey{Request.Priority, Id});
+        Request.Priority = Priority;
+        m_Queue.insert(QueueKey{Priority, Id});
+    }
+
+    return true;
+}
+
+void TextureStreamingScheduler::Update(IDeviceContext* pContext)
+{
+    std::vector<PendingRequest> Dispatched;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        ++m_FrameNumber;
+        const auto CurrTime = m_Timer.GetElapsedTime();
+
+        Uint64 NumBytes        = 0;
+        Uint32 NumCopyCommands = 0;
+        while (!m_Queue.empty())
+        {
+            auto QueueIt   = m_Queue.begin();
+            auto RequestIt = m_Requests.find(QueueIt->Id);
+            VERIFY_EXPR(RequestIt != m_Requests.end());
+            auto& Request = RequestIt->second;
+
+            // Lower-priority requests are never allowed to overtake the request that does not fit
+            if (m_Desc.MaxBytesPerFrame != 0 && NumBytes + Request.Size > m_Desc.MaxBytesPerFrame)
+                break;
+            if (m_Desc.MaxCopyCommandsPerFrame != 0 && NumCopyCommands + Request.NumCopyCommands > m_Desc.MaxCopyCommandsPerFrame)
+                break;
+
+            NumBytes += Request.Size;
+            NumCopyCommands += Request.NumCopyCommands;
+
+            const auto Latency       = CurrTime - Request.SubmitTime;
+            const auto LatencyFrames = static_cast<Uint32>(m_FrameNumber - Request.SubmitFrame);
+            m_TotalLatency += Latency;
+            m_TotalLatencyFrames += LatencyFrames;
+            m_Stats.MaxLatency       = std::max(m_Stats.MaxLatency, Latency);
+            m_Stats.MaxLatencyFrames = std::max(m_Stats.MaxLatencyFrames, LatencyFrames);
+
+            m_Stats.NumPendingBytes -= Request.Size;
+            Dispatched.emplace_back(std::move(Request));
+            m_Requests.erase(RequestIt);
+            m_Queue.erase(QueueIt);
+        }
+
+        m_Stats.NumBytesLastFrame        = NumBytes;
+        m_Stats.NumCopyCommandsLastFrame = NumCopyCommands;
+        m_Stats.NumRequestsLastFrame     = static_cast<Uint32>(Dispatched.size());
+        m_Stats.NumCompletedRequests += Dispatched.size();
+        if (m_Stats.NumCompletedRequests != 0)
+        {
+            m_Stats.AverageLatency       = m_TotalLatency / static_cast<double>(m_Stats.NumCompletedRequests);
+            m_Stats.AverageLatencyFrames = static_cast<double>(m_TotalLatencyFrames) / static_cast<double>(m_Stats.NumCompletedRequests);
+        }
+    }
+
+    // Uploads are executed outside of the lock so that other threads can keep submitting requests
+    for (auto& Pending : Dispatched)
+    {
+        auto& Request = Pending.Request;
+
+        RefCntAutoPtr<IUploadBuffer> pUploadBuffer;
+        m_pUploader->AllocateUploadBuffer(pContext, Request.UploadDesc, &pUploadBuffer);
+        if (!pUploadBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to allocate upload buffer for texture '", Request.pDstTexture->GetDesc().Name, "'");
+            continue;
+        }
+
+        if (Request.WriteData)
+            Request.WriteData(pUploadBuffer);
+
+        m_pUploader->ScheduleGPUCopy(pContext, Request.pDstTexture, Request.DstArraySlice, Request.DstMipLevel, pUploadBuffer);
+        // When the context is provided, the copy is scheduled immediately and the buffer can be recycled right away
+        m_pUploader->RecycleBuffer(pUploadBuffer);
+
+        if (Request.OnCopyScheduled)
+            Request.OnCopyScheduled();
+    }
+}
+
+TextureStreamingStats TextureStreamingScheduler::GetStats()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto Stats               = m_Stats;
+    Stats.NumPendingRequests = static_cast<Uint32>(m_Requests.size());
+    return Stats;
+}
+
+} // namespace Diligent
@@ -34,6 +34,12 @@
 #include "ThreadSignal.hpp"
 #include "GraphicsAccessories.hpp"
 
+#if VULKAN_SUPPORTED
+#    define VK_NO_PROTOTYPES
+#    include "vulkan/vulkan.h"
+#    include "RenderDeviceVk.h"
+#endif
+
 namespace Diligent
 {
 
@@ -171,6 +177,11 @@ struct TextureUploaderD3D12_Vk::InternalData
         FenceDesc fenceDesc;
         fenceDesc.Name = "Texture uploader sync fence";
         pDevice->CreateFence(fenceDesc, &m_pFence);
+
+#if VULKAN_SUPPORTED
+        // Copies are executed by the dedicated transfer queue when the device has one
+        pDevice->QueryInterface(IID_RenderDeviceVk, reinterpret_cast<IObject**>(static_cast<IRenderDeviceVk**>(&m_pDeviceVk)));
+#endif
     }
 
     ~InternalData()
@@ -269,6 +280,10 @@ private:
     std::mutex                                                                     m_UploadTexturesCacheMtx;
     std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadTexture>>> m_UploadTexturesCache;
 
+#if VULKAN_SUPPORTED
+    RefCntAutoPtr<IRenderDeviceVk> m_pDeviceVk;
+#endif
+
     RefCntAutoPtr<IFence> m_pFence;
     Uint64                m_NextFenceValue      = 1;
     Uint64                m_CompletedFenceValue = 0;
@@ -367,6 +382,11 @@ void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pCon
                     CopyInfo.SrcSlice    = Slice;
                     CopyInfo.DstMipLevel = OperationInfo.DstMip + Mip;
                     CopyInfo.DstSlice    = OperationInfo.DstSlice + Slice;
+#if VULKAN_SUPPORTED
+                    // The transfer queue only accepts textures that have not been used by the graphics queue yet
+                    if (m_pDeviceVk && m_pDeviceVk->CopyTextureOnTransferQueue(CopyInfo))
+                        continue;
+#endif
                     pContext->CopyTexture(CopyInfo);
                 }
             }
@@ -103,6 +103,21 @@ public:
 
     static bool IsPathAbsolute(const Diligent::Char* strPath);
 
+    /// Maps the entire file into memory for reading.
+
+    /// \param [in]  strFilePath - Path to the file.
+    /// \param [out] pData       - Address of the mapped memory. Pages are mapped copy-on-write,
+    ///                            so writing to the memory does not modify the file.
+    /// \param [out] Size        - Size of the file.
+    /// \return     true if the file has been mapped, and false if the file could not be opened
+    ///             or the platform does not support memory-mapped files.
+    ///
+    /// \remarks    Empty files are not mapped: the function returns true, and pData is null.
+    static bool MapFile(const Diligent::Char* strFilePath, void*& pData, size_t& Size);
+
+    /// Unmaps the memory returned by MapFile.
+    static void UnmapFile(void* pData, size_t Size);
+
 protected:
     static Diligent::String m_strWorkingDirectory;
 };
@@ -92,6 +92,18 @@ bool BasicFileSystem::FileExists(const Diligent::Char* strFilePath)
     return false;
 }
 
+bool BasicFileSystem::MapFile(const Diligent::Char* strFilePath, void*& pData, size_t& Size)
+{
+    pData = nullptr;
+    Size  = 0;
+    return false;
+}
+
+void BasicFileSystem::UnmapFile(void* pData, size_t Size)
+{
+    VERIFY(pData == nullptr, "Memory-mapped files are not supported on this platform");
+}
+
 Diligent::Char BasicFileSystem::GetSlashSymbol()
 {
     UNSUPPORTED("Unsupported");
@@ -46,4 +46,7 @@ public:
     static void DeleteFile(const Diligent::Char* strPath);
 
     static std::vector<std::unique_ptr<FindFileData>> Search(const Diligent::Char* SearchPattern);
+
+    static bool MapFile(const Diligent::Char* strFilePath, void*& pData, size_t& Size);
+    static void UnmapFile(void* pData, size_t Size);
 };
@@ -25,6 +25,13 @@
 #include <unistd.h>
 #include <cstdio>
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
 #include "LinuxFileSystem.hpp"
 #include "Errors.hpp"
 #include "DebugUtilities.hpp"
@@ -83,3 +90,68 @@ std::vector<std::unique_ptr<FindFileData>> LinuxFileSystem::Search(const Diligen
     UNSUPPORTED("Not implemented");
     return std::vector<std::unique_ptr<FindFileData>>();
 }
+
+bool LinuxFileSystem::MapFile(const Diligent::Char* strFilePath, void*& pData, size_t& Size)
+{
+    pData = nullptr;
+    Size  = 0;
+
+    FileOpenAttribs OpenAttribs;
+    OpenAttribs.strFilePath = strFilePath;
+    BasicFile   DummyFile(OpenAttribs, LinuxFileSystem::GetSlashSymbol());
+    const auto& Path = DummyFile.GetPath(); // This is necessary to correct slashes
+
+    int fd = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    bool        Mapped = false;
+    struct stat FileStat;
+    if (fstat(fd, &FileStat) == 0)
+    {
+        if (!S_ISREG(FileStat.st_mode))
+        {
+            // Only regular files can be mapped
+        }
+        else if (FileStat.st_size == 0)
+        {
+            // Zero-length mappings are not allowed
+            Mapped = true;
+        }
+        else
+        {
+            // Private mapping makes the pages copy-on-write, so that the memory can be
+            // exposed as writable data blob without affecting the file
+            void* pMapping = mmap(nullptr, static_cast<size_t>(FileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (pMapping != MAP_FAILED)
+            {
+                // Files are typically consumed front to back right after they have been mapped
+                madvise(pMapping, static_cast<size_t>(FileStat.st_size), MADV_SEQUENTIAL);
+                madvise(pMapping, static_cast<size_t>(FileStat.st_size), MADV_WILLNEED);
+
+                pData  = pMapping;
+                Size   = static_cast<size_t>(FileStat.st_size);
+                Mapped = true;
+            }
+            else
+            {
+                LOG_ERROR_MESSAGE("Failed to map file ", Path, "\nThe following error occured: ", strerror(errno));
+            }
+        }
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Failed to query the size of file ", Path, "\nThe following error occured: ", strerror(errno));
+    }
+
+    // The mapping keeps a reference to the file
+    close(fd);
+
+    return Mapped;
+}
+
+void LinuxFileSystem::UnmapFile(void* pData, size_t Size)
+{
+    if (pData != nullptr)
+        munmap(pData, Size);
+}
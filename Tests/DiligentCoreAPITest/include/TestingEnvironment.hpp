@@ -28,6 +28,7 @@
 #pragma once
 
 #include <atomic>
+#include <vector>
 
 #include "RenderDevice.h"
 #include "DeviceContext.h"
@@ -87,6 +88,9 @@ public:
     IDeviceContext* GetDeviceContext() { return m_pDeviceContext; }
     ISwapChain*     GetSwapChain() { return m_pSwapChain; }
 
+    Uint32          GetNumDeferredContexts() const { return static_cast<Uint32>(m_pDeferredContexts.size()); }
+    IDeviceContext* GetDeferredContext(Uint32 ctx) { return m_pDeferredContexts[ctx]; }
+
     static TestingEnvironment* GetInstance() { return m_pTheEnvironment; }
 
     RefCntAutoPtr<ITexture> CreateTexture(const char* Name, TEXTURE_FORMAT Fmt, BIND_FLAGS BindFlags, Uint32 Width, Uint32 Height);
@@ -112,6 +116,8 @@ protected:
     RefCntAutoPtr<IDeviceContext> m_pDeviceContext;
     RefCntAutoPtr<ISwapChain>     m_pSwapChain;
 
+    std::vector<RefCntAutoPtr<IDeviceContext>> m_pDeferredContexts;
+
     static std::atomic_int m_NumAllowedErrors;
 };
 
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(DeviceContextStatsTest, BufferTraffic)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = "Stats test default buffer";
+    BuffDesc.Usage         = USAGE_DEFAULT;
+    BuffDesc.uiSizeInBytes = 256;
+    BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+
+    RefCntAutoPtr<IBuffer> pDefaultBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pDefaultBuffer);
+    ASSERT_NE(pDefaultBuffer, nullptr);
+
+    BuffDesc.Name           = "Stats test dynamic buffer";
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+    RefCntAutoPtr<IBuffer> pDynamicBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pDynamicBuffer);
+    ASSERT_NE(pDynamicBuffer, nullptr);
+
+    pContext->ResetStats();
+
+    const Uint8 Data[64] = {};
+    pContext->UpdateBuffer(pDefaultBuffer, 0, sizeof(Data), Data, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    void* pMappedData = nullptr;
+    pContext->MapBuffer(pDynamicBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pMappedData);
+    ASSERT_NE(pMappedData, nullptr);
+    pContext->UnmapBuffer(pDynamicBuffer, MAP_WRITE);
+
+    const auto& Stats = pContext->GetStats();
+#if DILIGENT_CONTEXT_STATS
+    EXPECT_EQ(Stats.UploadBytes, Uint64{sizeof(Data)});
+    const auto& DevCaps = pDevice->GetDeviceCaps();
+    if (DevCaps.IsVulkanDevice() || DevCaps.IsGLDevice())
+    {
+        EXPECT_GE(Stats.DynamicHeapBytes, Uint64{BuffDesc.uiSizeInBytes});
+    }
+#else
+    EXPECT_EQ(Stats.UploadBytes, Uint64{0});
+#endif
+    EXPECT_EQ(Stats.NumDrawCommands, 0u);
+    EXPECT_EQ(Stats.NumDispatchCommands, 0u);
+
+    pContext->ResetStats();
+    EXPECT_EQ(Stats.UploadBytes, Uint64{0});
+    EXPECT_EQ(Stats.DynamicHeapBytes, Uint64{0});
+    EXPECT_EQ(Stats.NumBarriers, 0u);
+    EXPECT_EQ(Stats.NumRenderPasses, 0u);
+}
+
+} // namespace
@@ -121,6 +121,35 @@ void main(in  VSInput VSIn,
 }
 )"
 };
+
+
+const std::string DrawTest_VSDynamicOffset{
+R"(
+cbuffer Constants
+{
+    float4 g_Offset;
+};
+
+struct PSInput 
+{ 
+    float4 Pos   : SV_POSITION; 
+    float3 Color : COLOR; 
+};
+
+struct VSInput
+{
+    float4 Pos   : ATTRIB0;
+    float3 Color : ATTRIB1; 
+};
+
+void main(in  VSInput VSIn,
+          out PSInput PSIn) 
+{
+    PSIn.Pos   = VSIn.Pos + g_Offset;
+    PSIn.Color = VSIn.Color;
+}
+)"
+};
 // clang-format on
 
 } // namespace HLSL
@@ -306,6 +335,30 @@ protected:
 
         Elems[0].Stride = sizeof(Vertex) * 2;
         pDevice->CreatePipelineState(PSOCreateInfo, &sm_pDraw_2xStride_PSO);
+        Elems[0].Stride = 0;
+
+
+        RefCntAutoPtr<IShader> pDynamicOffsetVS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+            ShaderCI.EntryPoint      = "main";
+            ShaderCI.Desc.Name       = "Draw command test dynamic offset vertex shader";
+            ShaderCI.Source          = HLSL::DrawTest_VSDynamicOffset.c_str();
+            pDevice->CreateShader(ShaderCI, &pDynamicOffsetVS);
+            ASSERT_NE(pDynamicOffsetVS, nullptr);
+        }
+
+        PSODesc.Name = "Draw command test - dynamic constant buffer";
+
+        PSODesc.GraphicsPipeline.pVS               = pDynamicOffsetVS;
+        PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        pDevice->CreatePipelineState(PSOCreateInfo, &sm_pDrawDynamicCBPSO);
+
+        PSODesc.Name = "Draw command test - dynamic variable";
+
+        PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+        pDevice->CreatePipelineState(PSOCreateInfo, &sm_pDrawDynamicVarPSO);
+        PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
 
 
         PSODesc.Name = "Instanced draw command test";
@@ -329,6 +382,8 @@ protected:
         sm_pDrawPSO.Release();
         sm_pDraw_2xStride_PSO.Release();
         sm_pDrawInstancedPSO.Release();
+        sm_pDrawDynamicCBPSO.Release();
+        sm_pDrawDynamicVarPSO.Release();
 
         auto* pEnv = TestingEnvironment::GetInstance();
         pEnv->Reset();
@@ -424,12 +479,16 @@ protected:
     static RefCntAutoPtr<IPipelineState> sm_pDrawPSO;
     static RefCntAutoPtr<IPipelineState> sm_pDraw_2xStride_PSO;
     static RefCntAutoPtr<IPipelineState> sm_pDrawInstancedPSO;
+    static RefCntAutoPtr<IPipelineState> sm_pDrawDynamicCBPSO;
+    static RefCntAutoPtr<IPipelineState> sm_pDrawDynamicVarPSO;
 };
 
 RefCntAutoPtr<IPipelineState> DrawCommandTest::sm_pDrawProceduralPSO;
 RefCntAutoPtr<IPipelineState> DrawCommandTest::sm_pDrawPSO;
 RefCntAutoPtr<IPipelineState> DrawCommandTest::sm_pDraw_2xStride_PSO;
 RefCntAutoPtr<IPipelineState> DrawCommandTest::sm_pDrawInstancedPSO;
+RefCntAutoPtr<IPipelineState> DrawCommandTest::sm_pDrawDynamicCBPSO;
+RefCntAutoPtr<IPipelineState> DrawCommandTest::sm_pDrawDynamicVarPSO;
 
 TEST_F(DrawCommandTest, DrawProcedural)
 {
@@ -1466,4 +1525,515 @@ TEST_F(DrawCommandTest, DrawIndexedInstancedIndirect_FirstInstance_BaseVertex_Fi
     Present();
 }
 
+
+// Multi-draw indirect
+
+TEST_F(DrawCommandTest, MultiDrawIndirect)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().Features.IndirectRendering)
+        GTEST_SKIP() << "Indirect rendering is not supported on this device";
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        {}, {},
+        Vert[3], Vert[4], Vert[5]
+    };
+    // clang-format on
+
+    auto     pVB       = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    // Draw commands are separated by two padding elements
+    Uint32 IndirectDrawData[] =
+        {
+            0, 0, 0, 0, // Offset
+
+            3, 1, 0, 0, // NumVertices, NumInstances, StartVertexLocation, FirstInstanceLocation
+            0, 0,       // Padding
+            3, 1, 5, 0,
+            0, 0 //
+        };
+    auto pIndirectArgsBuff = CreateIndirectDrawArgsBuffer(IndirectDrawData, sizeof(IndirectDrawData));
+
+    MultiDrawIndirectAttribs drawAttrs{DRAW_FLAG_VERIFY_ALL, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, 2, 6 * sizeof(Uint32), 4 * sizeof(Uint32)};
+    pContext->MultiDrawIndirect(drawAttrs, pIndirectArgsBuff);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, MultiDrawIndexedIndirect)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().Features.IndirectRendering)
+        GTEST_SKIP() << "Indirect rendering is not supported on this device";
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        {}, {},
+        Vert[0], {}, Vert[1], {}, {}, Vert[2],
+        Vert[3], {}, {}, Vert[5], Vert[4]
+    };
+    Uint32 Indices[] = {2,4,7, 0, 8,12,11};
+    // clang-format on
+
+    auto pVB = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pIB = CreateIndexBuffer(Indices, _countof(Indices));
+
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    Uint32 IndirectDrawData[] =
+        {
+            3, 1, 0, 0, 0, // NumIndices, NumInstances, FirstIndexLocation, BaseVertex, FirstInstanceLocation
+            0,             // Padding
+            3, 1, 4, 0, 0,
+            0 //
+        };
+    auto pIndirectArgsBuff = CreateIndirectDrawArgsBuffer(IndirectDrawData, sizeof(IndirectDrawData));
+
+    MultiDrawIndexedIndirectAttribs drawAttrs{VT_UINT32, DRAW_FLAG_VERIFY_ALL, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, 2, 6 * sizeof(Uint32)};
+    pContext->MultiDrawIndexedIndirect(drawAttrs, pIndirectArgsBuff);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, MultiDrawIndirectCount)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().Features.IndirectDrawCount)
+        GTEST_SKIP() << "Indirect draw count is not supported on this device";
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        Vert[3], Vert[4], Vert[5]
+    };
+    // clang-format on
+
+    auto     pVB       = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    // The last command must not be executed as the count buffer limits the number of draws to 2
+    Uint32 IndirectDrawData[] =
+        {
+            3, 1, 0, 0,
+            3, 1, 3, 0,
+            3, 1, 1, 0 //
+        };
+    auto pIndirectArgsBuff = CreateIndirectDrawArgsBuffer(IndirectDrawData, sizeof(IndirectDrawData));
+
+    Uint32 CountData[]  = {0, 2};
+    auto   pCountBuffer = CreateIndirectDrawArgsBuffer(CountData, sizeof(CountData));
+
+    MultiDrawIndirectAttribs drawAttrs{DRAW_FLAG_VERIFY_ALL, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, 3};
+    drawAttrs.pCountBuffer                   = pCountBuffer;
+    drawAttrs.CountBufferOffset              = sizeof(Uint32);
+    drawAttrs.CountBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    pContext->MultiDrawIndirect(drawAttrs, pIndirectArgsBuff);
+
+    Present();
+}
+
+
+// Draw packets
+
+TEST_F(DrawCommandTest, DrawPackets)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangle0[] = {Vert[0], Vert[1], Vert[2]};
+    const Vertex Triangle1[] = {Vert[3], Vert[4], Vert[5]};
+    Uint32 Indices[] = {0, 1, 2};
+    // clang-format on
+
+    auto pVB0 = CreateVertexBuffer(Triangle0, sizeof(Triangle0));
+    auto pVB1 = CreateVertexBuffer(Triangle1, sizeof(Triangle1));
+    auto pIB  = CreateIndexBuffer(Indices, _countof(Indices));
+
+    // Transition all buffers up front so that the packets can be submitted
+    // without transitions and redundant states can be filtered out
+    StateTransitionDesc Barriers[] =
+        {
+            {pVB0, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, true},
+            {pVB1, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, true},
+            {pIB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, true}};
+    pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+
+    IBuffer* pVBs0[] = {pVB0};
+    IBuffer* pVBs1[] = {pVB1};
+
+    DrawPacket Packets[3];
+    Packets[0].pPipelineState   = sm_pDrawPSO;
+    Packets[0].NumVertexBuffers = 1;
+    Packets[0].ppVertexBuffers  = pVBs1;
+    Packets[0].pIndexBuffer     = pIB;
+    Packets[0].IndexedAttribs   = DrawIndexedAttribs{3, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+
+    Packets[1].pPipelineState    = sm_pDrawPSO;
+    Packets[1].NumVertexBuffers  = 1;
+    Packets[1].ppVertexBuffers   = pVBs0;
+    Packets[1].NonIndexedAttribs = DrawAttribs{3, DRAW_FLAG_VERIFY_ALL};
+
+    // The same state as in the first packet
+    Packets[2] = Packets[0];
+
+    SubmitDrawPacketsAttribs SubmitAttribs;
+    SubmitAttribs.pPackets            = Packets;
+    SubmitAttribs.NumPackets          = _countof(Packets);
+    SubmitAttribs.StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+    SubmitAttribs.SortByState         = true;
+
+    pContext->ResetStats();
+    pContext->SubmitDrawPackets(SubmitAttribs);
+
+#if DILIGENT_CONTEXT_STATS
+    const auto& Stats   = pContext->GetStats();
+    const auto& DevCaps = pDevice->GetDeviceCaps();
+    EXPECT_EQ(Stats.NumPipelineStateChanges, 0u);
+    if (DevCaps.IsVulkanDevice() || DevCaps.IsGLDevice())
+    {
+        EXPECT_EQ(Stats.NumShaderResourceCommits, 1u);
+        EXPECT_EQ(Stats.NumDrawCommands, 3u);
+    }
+#else
+    (void)pDevice;
+#endif
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, Draw_DynamicConstantBuffer)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Draw command test dynamic constant buffer";
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.uiSizeInBytes  = sizeof(float4);
+    BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+    RefCntAutoPtr<IBuffer> pCB;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pCB);
+    ASSERT_NE(pCB, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pDrawDynamicCBPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "Constants")->Set(pCB);
+
+    SetRenderTargets(sm_pDrawDynamicCBPSO);
+
+    const Vertex Triangle[] = {Vert[0], Vert[1], Vert[2]};
+
+    auto     pVB       = CreateVertexBuffer(Triangle, sizeof(Triangle));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    // Resources are committed once, and the buffer is then mapped with MAP_FLAG_DISCARD before
+    // every draw. Every draw must use the constants written by the preceding map.
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    // The second triangle is the first one shifted to the right by 1
+    const float4 TriangleOffsets[] = {float4{0, 0, 0, 0}, float4{1, 0, 0, 0}};
+    for (const auto& Offset : TriangleOffsets)
+    {
+        void* pData = nullptr;
+        pContext->MapBuffer(pCB, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        ASSERT_NE(pData, nullptr);
+        memcpy(pData, &Offset, sizeof(Offset));
+        pContext->UnmapBuffer(pCB, MAP_WRITE);
+
+        DrawAttribs drawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+        pContext->Draw(drawAttrs);
+    }
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, Draw_DeferredContext)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+
+    auto* pDevice       = pEnv->GetDevice();
+    auto* pContext      = pEnv->GetDeviceContext();
+    auto* pDeferredCtx  = pEnv->GetDeferredContext(0);
+    auto* pSwapChain    = pEnv->GetSwapChain();
+    auto* pRTV          = pSwapChain->GetCurrentBackBufferRTV();
+    auto  UpdateDynamic = [&](IBuffer* pCB, const float4& Offset) {
+        void* pData = nullptr;
+        pDeferredCtx->MapBuffer(pCB, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        ASSERT_NE(pData, nullptr);
+        memcpy(pData, &Offset, sizeof(Offset));
+        pDeferredCtx->UnmapBuffer(pCB, MAP_WRITE);
+    };
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Deferred context test dynamic constant buffer";
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.uiSizeInBytes  = sizeof(float4);
+    BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+    RefCntAutoPtr<IBuffer> pCB;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pCB);
+    ASSERT_NE(pCB, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pDrawDynamicCBPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "Constants")->Set(pCB);
+
+    const Vertex Triangle[] = {Vert[0], Vert[1], Vert[2]};
+
+    auto     pVB       = CreateVertexBuffer(Triangle, sizeof(Triangle));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+
+    // Record a command list that is released without being executed. It must release
+    // all objects it references, and it must not affect the contents of the buffer.
+    {
+        RefCntAutoPtr<IBuffer> pUnusedVB = CreateVertexBuffer(Triangle, sizeof(Triangle));
+        RefCntWeakPtr<IBuffer> pWeakUnusedVB{pUnusedVB};
+
+        IBuffer* pUnusedVBs[] = {pUnusedVB};
+        pDeferredCtx->SetVertexBuffers(0, 1, pUnusedVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+        UpdateDynamic(pCB, float4{-10, -10, 0, 0});
+
+        RefCntAutoPtr<ICommandList> pUnusedCmdList;
+        pDeferredCtx->FinishCommandList(&pUnusedCmdList);
+        ASSERT_NE(pUnusedCmdList, nullptr);
+        pDeferredCtx->FinishFrame();
+
+        pUnusedVB.Release();
+        EXPECT_TRUE(pWeakUnusedVB.IsValid());
+        pUnusedCmdList.Release();
+        EXPECT_FALSE(pWeakUnusedVB.IsValid());
+    }
+
+    ITextureView* pRTVs[] = {pRTV};
+    pDeferredCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pDeferredCtx->SetViewports(1, nullptr, 0, 0);
+
+    const float ClearColor[] = {0.f, 0.f, 0.f, 0.0f};
+    pDeferredCtx->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    pDeferredCtx->SetPipelineState(sm_pDrawDynamicCBPSO);
+    pDeferredCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pDeferredCtx->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    // Every draw must use the constants written by the preceding map. The second
+    // triangle is the first one shifted to the right by 1.
+    const float4 TriangleOffsets[] = {float4{0, 0, 0, 0}, float4{1, 0, 0, 0}};
+    for (const auto& Offset : TriangleOffsets)
+    {
+        UpdateDynamic(pCB, Offset);
+
+        DrawAttribs drawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+        pDeferredCtx->Draw(drawAttrs);
+    }
+
+    RefCntAutoPtr<ICommandList> pCmdList;
+    pDeferredCtx->FinishCommandList(&pCmdList);
+    ASSERT_NE(pCmdList, nullptr);
+
+    // The command list must keep the objects alive until it is executed
+    RefCntWeakPtr<IBuffer> pWeakVB{pVB};
+    pVBs[0] = nullptr;
+    pVB.Release();
+    pSRB.Release();
+    EXPECT_TRUE(pWeakVB.IsValid());
+
+    pContext->ExecuteCommandList(pCmdList);
+    pCmdList.Release();
+    pDeferredCtx->FinishFrame();
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, Draw_StateFiltering)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    pContext->SetStateFilteringEnabled(true);
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        Vert[3], Vert[4], Vert[5]
+    };
+    // clang-format on
+
+    auto     pVB       = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    DrawAttribs drawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+    pContext->Draw(drawAttrs);
+
+    // Rebind identical states. The calls are filtered out, but the second triangle
+    // must still be rendered correctly.
+    pContext->SetPipelineState(sm_pDrawPSO);
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->CommitShaderResources(nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->SetViewports(1, nullptr, 0, 0);
+
+    drawAttrs.StartVertexLocation = 3;
+    pContext->Draw(drawAttrs);
+
+    pContext->SetStateFilteringEnabled(false);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, Draw_StateFiltering_DynamicVariable)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    // The second triangle is the first one shifted to the right by 1
+    const float4 TriangleOffsets[] = {float4{0, 0, 0, 0}, float4{1, 0, 0, 0}};
+
+    RefCntAutoPtr<IBuffer> pCBs[2];
+    for (Uint32 i = 0; i < _countof(pCBs); ++i)
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Draw command test constant buffer";
+        BuffDesc.uiSizeInBytes = sizeof(float4);
+        BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+
+        BufferData InitialData{&TriangleOffsets[i], sizeof(TriangleOffsets[i])};
+        pDevice->CreateBuffer(BuffDesc, &InitialData, &pCBs[i]);
+        ASSERT_NE(pCBs[i], nullptr);
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pDrawDynamicVarPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    auto* pConstants = pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "Constants");
+    ASSERT_NE(pConstants, nullptr);
+
+    pContext->SetStateFilteringEnabled(true);
+    SetRenderTargets(sm_pDrawDynamicVarPSO);
+
+    const Vertex Triangle[] = {Vert[0], Vert[1], Vert[2]};
+
+    auto     pVB       = CreateVertexBuffer(Triangle, sizeof(Triangle));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    for (Uint32 i = 0; i < _countof(pCBs); ++i)
+    {
+        StateTransitionDesc Barrier{pCBs[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER, true};
+        pContext->TransitionResourceStates(1, &Barrier);
+    }
+
+    // The same SRB is committed twice, but the dynamic variable changes in between,
+    // so the second commit must not be filtered out
+    for (auto& pCB : pCBs)
+    {
+        pConstants->Set(pCB);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        DrawAttribs drawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+        pContext->Draw(drawAttrs);
+    }
+
+    pContext->SetStateFilteringEnabled(false);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, Draw_FrameRetainedBindings)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    pContext->SetFrameRetainedBindingsEnabled(true);
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        Vert[3], Vert[4], Vert[5]
+    };
+    // clang-format on
+
+    Uint32                 Offsets[] = {0};
+    RefCntWeakPtr<IBuffer> pWeakVB;
+    {
+        auto     pVB    = CreateVertexBuffer(Triangles, sizeof(Triangles));
+        IBuffer* pVBs[] = {pVB};
+        pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+        pWeakVB = RefCntWeakPtr<IBuffer>{pVB};
+        // The buffer is released here, but the context must keep it alive until the end of the frame
+    }
+    EXPECT_TRUE(pWeakVB.Lock()) << "The bound buffer was destroyed when the application released it";
+
+    DrawAttribs drawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+    pContext->Draw(drawAttrs);
+
+    drawAttrs.StartVertexLocation = 3;
+    pContext->Draw(drawAttrs);
+
+    // Unbinding the buffer must not release it either, as it has been used by the draw commands of this frame
+    auto     pOtherVB    = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pOtherVBs[] = {pOtherVB};
+    pContext->SetVertexBuffers(0, 1, pOtherVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    EXPECT_TRUE(pWeakVB.Lock()) << "The buffer was destroyed before the end of the frame it was used in";
+
+    pContext->SetFrameRetainedBindingsEnabled(false);
+
+    Present();
+
+    // Once the frame is finished and the GPU is idle, the last reference to the buffer must be released
+    pEnv->Reset();
+    EXPECT_FALSE(pWeakVB.Lock()) << "The buffer was not released after the end of the frame";
+}
+
 } // namespace
@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <sstream>
+
+#include "FrameProfiler.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(FrameProfilerTest, NestedScopes)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const bool TimestampsSupported = pDevice->GetDeviceCaps().Features.TimestampQueries;
+
+    FrameProfiler Profiler{pDevice};
+    EXPECT_EQ(Profiler.GetLastResolvedFrame(), nullptr);
+
+    constexpr Uint32 NumFrames = 3;
+    for (Uint32 frame = 0; frame < NumFrames; ++frame)
+    {
+        Profiler.BeginFrame();
+        {
+            FrameProfiler::ScopedProfile OuterScope{Profiler, pContext, "Outer scope"};
+            {
+                const float Color[] = {1, 0, 0, 1};
+
+                FrameProfiler::ScopedProfile InnerScope{Profiler, pContext, "Inner scope", Color};
+                pContext->InsertDebugLabel("Frame profiler test label");
+            }
+        }
+        Profiler.EndFrame();
+
+        // Make sure that the results of the previous frame are available when
+        // the next frame ends
+        pContext->Flush();
+        pContext->WaitForIdle();
+    }
+
+    EXPECT_EQ(Profiler.GetNumFramesWithoutGPUTime(), Uint64{0});
+    EXPECT_EQ(Profiler.GetNumResolvedFrames(), Uint64{NumFrames});
+
+    const auto* pFrame = Profiler.GetLastResolvedFrame();
+    ASSERT_NE(pFrame, nullptr);
+    EXPECT_LT(pFrame->FrameNumber, Uint64{NumFrames});
+    EXPECT_LE(pFrame->CPUStart, pFrame->CPUEnd);
+
+    ASSERT_EQ(pFrame->Scopes.size(), size_t{2});
+
+    const auto& Outer = pFrame->Scopes[0];
+    const auto& Inner = pFrame->Scopes[1];
+    EXPECT_EQ(Outer.Name, "Outer scope");
+    EXPECT_EQ(Outer.Depth, 0u);
+    EXPECT_EQ(Outer.Parent, -1);
+    EXPECT_EQ(Inner.Name, "Inner scope");
+    EXPECT_EQ(Inner.Depth, 1u);
+    EXPECT_EQ(Inner.Parent, 0);
+
+    EXPECT_LE(pFrame->CPUStart, Outer.CPUStart);
+    EXPECT_LE(Outer.CPUStart, Inner.CPUStart);
+    EXPECT_LE(Inner.CPUStart, Inner.CPUEnd);
+    EXPECT_LE(Inner.CPUEnd, Outer.CPUEnd);
+    EXPECT_LE(Outer.CPUEnd, pFrame->CPUEnd);
+
+    EXPECT_EQ(Outer.HasGPUTime, TimestampsSupported);
+    EXPECT_EQ(Inner.HasGPUTime, TimestampsSupported);
+    if (TimestampsSupported)
+    {
+        EXPECT_LE(Outer.GPUStart, Inner.GPUStart);
+        EXPECT_LE(Inner.GPUStart, Inner.GPUEnd);
+        EXPECT_LE(Inner.GPUEnd, Outer.GPUEnd);
+    }
+}
+
+TEST(FrameProfilerTest, PendingFrames)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const bool TimestampsSupported = pDevice->GetDeviceCaps().Features.TimestampQueries;
+
+    constexpr Uint32 MaxFramesInFlight = 2;
+    constexpr Uint32 NumFrames         = 8;
+
+    // Frames are ended back to back without waiting for the GPU
+    FrameProfiler Profiler{pDevice, MaxFramesInFlight};
+    for (Uint32 frame = 0; frame < NumFrames; ++frame)
+    {
+        Profiler.BeginFrame();
+        {
+            FrameProfiler::ScopedProfile Scope{Profiler, pContext, "Scope"};
+        }
+        Profiler.EndFrame();
+    }
+
+    // Frames that were recorded with GPU timestamps must not be dropped
+    // even if their results were not ready within MaxFramesInFlight frames
+    pContext->Flush();
+    pContext->WaitForIdle();
+    Profiler.BeginFrame();
+    Profiler.EndFrame();
+
+    EXPECT_EQ(Profiler.GetNumResolvedFrames(), Uint64{NumFrames + 1});
+
+    const auto* pFrame = Profiler.GetLastResolvedFrame();
+    ASSERT_NE(pFrame, nullptr);
+    EXPECT_EQ(pFrame->FrameNumber, Uint64{NumFrames});
+    EXPECT_TRUE(pFrame->Scopes.empty());
+    if (!TimestampsSupported)
+        EXPECT_EQ(Profiler.GetNumFramesWithoutGPUTime(), Uint64{0});
+    else
+        EXPECT_LE(Profiler.GetNumFramesWithoutGPUTime(), Uint64{NumFrames + 1 - MaxFramesInFlight});
+}
+
+TEST(FrameProfilerTest, ChromeTrace)
+{
+    FrameProfiler::FrameResult Frame;
+    Frame.FrameNumber = 7;
+    Frame.CPUStart    = 1.0;
+    Frame.CPUEnd      = 1.016;
+
+    FrameProfiler::ScopeResult Scope;
+    Scope.Name       = "Shadow \"pass\"";
+    Scope.CPUStart   = 1.001;
+    Scope.CPUEnd     = 1.002;
+    Scope.GPUStart   = 50.0;
+    Scope.GPUEnd     = 50.004;
+    Scope.HasGPUTime = true;
+    Frame.Scopes.push_back(Scope);
+
+    std::stringstream ss;
+    FrameProfiler::WriteChromeTrace(Frame, ss);
+    const auto Trace = ss.str();
+
+    EXPECT_NE(Trace.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"name\":\"Frame 7\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"name\":\"Shadow \\\"pass\\\"\""), std::string::npos);
+    // CPU event: starts 1 ms after the trace origin and lasts 1 ms
+    EXPECT_NE(Trace.find("\"tid\":1,\"ts\":1001000.000,\"dur\":1000.000"), std::string::npos);
+    // GPU event is aligned to the frame start and lasts 4 ms
+    EXPECT_NE(Trace.find("\"tid\":2,\"ts\":1000000.000,\"dur\":4000.000"), std::string::npos);
+}
+
+} // namespace
@@ -0,0 +1,239 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "GL/TestingEnvironmentGL.hpp"
+#include "../include/GLMultiBind.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumSlots = 16;
+
+struct GLBindingSet
+{
+    GLuint Textures[NumSlots];
+    GLuint Samplers[NumSlots];
+    GLuint Buffers[NumSlots];
+};
+
+// Mirrors the redundancy tracking of GLContextState: only the slots whose objects
+// have changed since the previous call are bound
+class GLBindingsTracker
+{
+public:
+    virtual ~GLBindingsTracker() {}
+
+    virtual void Bind(const GLBindingSet& Set) = 0;
+
+protected:
+    static bool UpdateSlot(std::vector<GLuint>& BoundObjects, Uint32 Slot, GLuint Object)
+    {
+        if (BoundObjects[Slot] == Object)
+            return false;
+        BoundObjects[Slot] = Object;
+        return true;
+    }
+
+    std::vector<GLuint> m_BoundTextures = std::vector<GLuint>(NumSlots, ~0u);
+    std::vector<GLuint> m_BoundSamplers = std::vector<GLuint>(NumSlots, ~0u);
+    std::vector<GLuint> m_BoundBuffers  = std::vector<GLuint>(NumSlots, ~0u);
+};
+
+class PerSlotBindings final : public GLBindingsTracker
+{
+public:
+    virtual void Bind(const GLBindingSet& Set) override final
+    {
+        for (Uint32 slot = 0; slot < NumSlots; ++slot)
+        {
+            if (UpdateSlot(m_BoundTextures, slot, Set.Textures[slot]))
+            {
+                glActiveTexture(GL_TEXTURE0 + slot);
+                glBindTexture(GL_TEXTURE_2D, Set.Textures[slot]);
+            }
+            if (UpdateSlot(m_BoundSamplers, slot, Set.Samplers[slot]))
+                glBindSampler(slot, Set.Samplers[slot]);
+            if (UpdateSlot(m_BoundBuffers, slot, Set.Buffers[slot]))
+                glBindBufferRange(GL_UNIFORM_BUFFER, slot, Set.Buffers[slot], 0, BufferSize);
+        }
+    }
+
+    static constexpr GLsizeiptr BufferSize = 256;
+};
+
+class MultiBindBindings final : public GLBindingsTracker
+{
+public:
+    MultiBindBindings()
+    {
+        for (auto& Offset : m_Offsets)
+            Offset = 0;
+        for (auto& Size : m_Sizes)
+            Size = PerSlotBindings::BufferSize;
+    }
+
+    virtual void Bind(const GLBindingSet& Set) override final
+    {
+        // Use the same range splitting as GLContextState
+        auto GetSlotState = [](std::vector<GLuint>& BoundObjects, const GLuint* Objects) {
+            return [&BoundObjects, Objects](Uint32 Slot) {
+                return UpdateSlot(BoundObjects, Slot, Objects[Slot]) ? MultiBindSlotState::Modified : MultiBindSlotState::Unchanged;
+            };
+        };
+        ProcessMultiBindSlots(0, NumSlots, GetSlotState(m_BoundTextures, Set.Textures),
+                              [&](Uint32 First, Uint32 Count) { glBindTextures(First, Count, &Set.Textures[First]); });
+        ProcessMultiBindSlots(0, NumSlots, GetSlotState(m_BoundSamplers, Set.Samplers),
+                              [&](Uint32 First, Uint32 Count) { glBindSamplers(First, Count, &Set.Samplers[First]); });
+        ProcessMultiBindSlots(0, NumSlots, GetSlotState(m_BoundBuffers, Set.Buffers),
+                              [&](Uint32 First, Uint32 Count) { glBindBuffersRange(GL_UNIFORM_BUFFER, First, Count, &Set.Buffers[First], &m_Offsets[First], &m_Sizes[First]); });
+    }
+
+private:
+    GLintptr   m_Offsets[NumSlots];
+    GLsizeiptr m_Sizes[NumSlots];
+};
+
+void VerifyGLBindings(const GLBindingSet& Set, const char* Path)
+{
+    for (Uint32 slot = 0; slot < NumSlots; ++slot)
+    {
+        glActiveTexture(GL_TEXTURE0 + slot);
+
+        GLint Texture = 0;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &Texture);
+        EXPECT_EQ(static_cast<GLuint>(Texture), Set.Textures[slot]) << Path << ": texture unit " << slot;
+
+        GLint Sampler = 0;
+        glGetIntegerv(GL_SAMPLER_BINDING, &Sampler);
+        EXPECT_EQ(static_cast<GLuint>(Sampler), Set.Samplers[slot]) << Path << ": sampler unit " << slot;
+
+        GLint Buffer = 0;
+        glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, slot, &Buffer);
+        EXPECT_EQ(static_cast<GLuint>(Buffer), Set.Buffers[slot]) << Path << ": uniform buffer slot " << slot;
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
+
+// Compares the CPU time of binding resources slot by slot with the multi-bind path
+// used by GLContextState when GL_ARB_multi_bind is available. The timings are reported
+// and are not compared, as they depend on the driver.
+TEST(GLMultiBindTest, CPUTime)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (!pEnv->GetDevice()->GetDeviceCaps().IsGLDevice())
+        GTEST_SKIP() << "This test requires OpenGL device";
+    if (!(GLEW_VERSION_4_4 || GLEW_ARB_multi_bind))
+        GTEST_SKIP() << "GL_ARB_multi_bind is not supported";
+
+    constexpr Uint32 NumObjects = NumSlots + 4;
+
+    GLuint Textures[NumObjects] = {};
+    GLuint Samplers[NumObjects] = {};
+    GLuint Buffers[NumObjects]  = {};
+    glGenTextures(NumObjects, Textures);
+    glGenSamplers(NumObjects, Samplers);
+    glGenBuffers(NumObjects, Buffers);
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        glBindTexture(GL_TEXTURE_2D, Textures[i]);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, 1, 1);
+        glBindBuffer(GL_UNIFORM_BUFFER, Buffers[i]);
+        glBufferData(GL_UNIFORM_BUFFER, PerSlotBindings::BufferSize, nullptr, GL_STATIC_DRAW);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    ASSERT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+
+    // The sets model two shader resource bindings that share most of the resources,
+    // including repeated ones, and differ in every fourth slot
+    GLBindingSet Sets[2];
+    for (Uint32 slot = 0; slot < NumSlots; ++slot)
+    {
+        const auto Obj0 = slot % (NumSlots - 2);
+        const auto Obj1 = (slot % 4 == 1) ? NumSlots + slot / 4 : Obj0;
+
+        Sets[0].Textures[slot] = Textures[Obj0];
+        Sets[0].Samplers[slot] = Samplers[Obj0];
+        Sets[0].Buffers[slot]  = Buffers[Obj0];
+        Sets[1].Textures[slot] = Textures[Obj1];
+        Sets[1].Samplers[slot] = Samplers[Obj1];
+        Sets[1].Buffers[slot]  = Buffers[Obj1];
+    }
+
+    constexpr Uint32 NumIterations = 4096;
+
+    auto MeasureCPUTime = [&](GLBindingsTracker& Tracker, const char* Path) {
+        glFinish();
+        Timer  T;
+        double StartTime = T.GetElapsedTime();
+        for (Uint32 i = 0; i < NumIterations; ++i)
+            Tracker.Bind(Sets[i % 2]);
+        const double Time = T.GetElapsedTime() - StartTime;
+
+        EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR)) << Path;
+        VerifyGLBindings(Sets[(NumIterations - 1) % 2], Path);
+
+        // Bind the first set again and make sure that all slots are restored
+        Tracker.Bind(Sets[0]);
+        VerifyGLBindings(Sets[0], Path);
+        return Time;
+    };
+
+    PerSlotBindings   PerSlot;
+    MultiBindBindings MultiBind;
+
+    const auto PerSlotTime   = MeasureCPUTime(PerSlot, "Per-slot bindings");
+    const auto MultiBindTime = MeasureCPUTime(MultiBind, "Multi-bind");
+
+    LOG_INFO_MESSAGE("Binding ", NumSlots, " textures, samplers and uniform buffers: per-slot path: ",
+                     PerSlotTime * 1e6 / NumIterations, " us; multi-bind path: ", MultiBindTime * 1e6 / NumIterations, " us");
+
+    for (Uint32 slot = 0; slot < NumSlots; ++slot)
+    {
+        glActiveTexture(GL_TEXTURE0 + slot);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindSampler(slot, 0);
+        glBindBufferBase(GL_UNIFORM_BUFFER, slot, 0);
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glDeleteTextures(NumObjects, Textures);
+    glDeleteSamplers(NumObjects, Samplers);
+    glDeleteBuffers(NumObjects, Buffers);
+
+    // GL state has been changed behind the context's back
+    pEnv->GetDeviceContext()->InvalidateState();
+}
+
+} // namespace
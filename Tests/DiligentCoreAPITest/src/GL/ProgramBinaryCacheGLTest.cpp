@@ -0,0 +1,223 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "GL/TestingEnvironmentGL.hpp"
+#include "EngineFactoryOpenGL.h"
+#include "GLSLSourceBuilder.hpp"
+#include "FileWrapper.hpp"
+#include "../include/GLProgramBinaryCache.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+const char* const CachedShaderSource = R"(
+uniform ProgramBinaryCacheTestCB
+{
+    vec4 g_Offset;
+};
+
+void main()
+{
+    gl_Position = vec4(0.0, 0.0, 0.0, 1.0) + g_Offset;
+}
+)";
+
+const char* const BrokenShaderSource = R"(
+void main()
+{
+    gl_Position = vec3(0.0, 0.0, 0.0, 1.0);
+}
+)";
+
+std::vector<Uint8> ReadFile(const String& Path)
+{
+    FileWrapper File{Path.c_str(), EFileAccessMode::Read};
+    if (!File)
+        return {};
+    std::vector<Uint8> Data(File->GetSize());
+    if (!Data.empty())
+        File->Read(Data.data(), Data.size());
+    return Data;
+}
+
+void WriteFile(const String& Path, const std::vector<Uint8>& Data)
+{
+    FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+    ASSERT_FALSE(!File) << "Failed to open " << Path;
+    File->Write(Data.data(), Data.size());
+}
+
+class ProgramBinaryCacheGLTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+        if (!pDevice->GetDeviceCaps().IsGLDevice())
+            GTEST_SKIP() << "Program binary cache is only available in OpenGL backend";
+
+        // Shader reflection links a separable program that goes through the cache
+        if (!pDevice->GetDeviceCaps().Features.SeparablePrograms)
+            GTEST_SKIP() << "Separable programs are not supported by this device";
+
+        GLint NumFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumFormats);
+        if (NumFormats == 0)
+            GTEST_SKIP() << "The driver does not support program binaries";
+
+        // Create another device on the same GL context with the binary cache enabled
+        RefCntAutoPtr<IEngineFactoryOpenGL> pFactoryGL{pDevice->GetEngineFactory(), IID_EngineFactoryOpenGL};
+        ASSERT_NE(pFactoryGL, nullptr);
+
+        EngineGLCreateInfo CreateInfo;
+        CreateInfo.ProgramBinaryCacheDir = ".";
+        pFactoryGL->AttachToActiveGLContext(CreateInfo, &m_pDevice, &m_pContext);
+        ASSERT_NE(m_pDevice, nullptr);
+        ASSERT_NE(m_pContext, nullptr);
+    }
+
+    void TearDown() override
+    {
+        if (!m_FilePath.empty())
+            FileSystem::DeleteFile(m_FilePath.c_str());
+
+        m_pContext.Release();
+        m_pDevice.Release();
+
+        // The device has changed the GL state
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    RefCntAutoPtr<IShader> CreateShader(const char* Source)
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Source          = Source;
+        ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.Desc.Name       = "Program binary cache test";
+
+        RefCntAutoPtr<IShader> pShader;
+        m_pDevice->CreateShader(ShaderCI, &pShader);
+        return pShader;
+    }
+
+    // Returns the path of the file in which the device caches the separable program of the shader
+    String GetFilePath(const char* Source)
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Source          = Source;
+        ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+
+        GLProgramBinaryCache::ProgramSignature Signature{true};
+        Signature.AddStage(SHADER_TYPE_VERTEX, BuildGLSLSourceString(ShaderCI, m_pDevice->GetDeviceCaps(), TargetGLSLCompiler::driver));
+        return GLProgramBinaryCache{".", GLProgramBinaryCache::GetDriverId()}.GetFilePath(Signature);
+    }
+
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+    String                        m_FilePath;
+};
+
+TEST_F(ProgramBinaryCacheGLTest, StoreAndReload)
+{
+    m_FilePath = GetFilePath(CachedShaderSource);
+    FileSystem::DeleteFile(m_FilePath.c_str());
+
+    // Cache miss: the program is linked from the source and stored in the cache
+    {
+        auto pShader = CreateShader(CachedShaderSource);
+        ASSERT_NE(pShader, nullptr);
+        EXPECT_EQ(pShader->GetResourceCount(), 1u);
+    }
+    ASSERT_TRUE(FileSystem::FileExists(m_FilePath.c_str()));
+    const auto StoredFile = ReadFile(m_FilePath);
+    ASSERT_FALSE(StoredFile.empty());
+
+    // Cache hit: the program is loaded from the binary and the file is not changed
+    {
+        auto pShader = CreateShader(CachedShaderSource);
+        ASSERT_NE(pShader, nullptr);
+        ASSERT_EQ(pShader->GetResourceCount(), 1u);
+
+        ShaderResourceDesc ResDesc;
+        pShader->GetResourceDesc(0, ResDesc);
+        EXPECT_STREQ(ResDesc.Name, "ProgramBinaryCacheTestCB");
+        EXPECT_EQ(ResDesc.Type, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER);
+    }
+    EXPECT_EQ(ReadFile(m_FilePath), StoredFile);
+}
+
+TEST_F(ProgramBinaryCacheGLTest, RejectedBinary)
+{
+    m_FilePath = GetFilePath(CachedShaderSource);
+    FileSystem::DeleteFile(m_FilePath.c_str());
+
+    {
+        auto pShader = CreateShader(CachedShaderSource);
+        ASSERT_NE(pShader, nullptr);
+    }
+    auto CorruptedFile = ReadFile(m_FilePath);
+    ASSERT_GT(CorruptedFile.size(), size_t{64});
+
+    // Corrupt the program binary at the end of the file while keeping the header, the driver
+    // id and the signature valid, so that the binary is submitted to the driver and rejected.
+    for (size_t i = CorruptedFile.size() - 32; i < CorruptedFile.size(); ++i)
+        CorruptedFile[i] ^= 0xA5;
+    WriteFile(m_FilePath, CorruptedFile);
+
+    // The program must be linked from the source and the cache entry replaced
+    {
+        auto pShader = CreateShader(CachedShaderSource);
+        ASSERT_NE(pShader, nullptr);
+        EXPECT_EQ(pShader->GetResourceCount(), 1u);
+    }
+    const auto ReplacedFile = ReadFile(m_FilePath);
+    EXPECT_FALSE(ReplacedFile.empty());
+    EXPECT_NE(ReplacedFile, CorruptedFile);
+}
+
+// CreateShader() must fail on invalid source when the cache is enabled
+TEST_F(ProgramBinaryCacheGLTest, CompilationFailure)
+{
+    m_FilePath = GetFilePath(BrokenShaderSource);
+
+    TestingEnvironment::SetErrorAllowance(2, "\n\nNo worries, testing broken shader...\n\n");
+    auto pShader = CreateShader(BrokenShaderSource);
+    EXPECT_EQ(pShader, nullptr);
+    EXPECT_FALSE(FileSystem::FileExists(m_FilePath.c_str()));
+}
+
+} // namespace
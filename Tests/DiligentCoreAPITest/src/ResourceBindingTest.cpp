@@ -0,0 +1,429 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "BasicMath.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Every pixel of the render target outputs one resource, see GetExpectedColor()
+const std::string ManyResources_VS{
+    R"(
+void main(in uint VertId : SV_VertexID, out float4 Pos : SV_Position)
+{
+    float2 Positions[3];
+    Positions[0] = float2(-1.0, -1.0);
+    Positions[1] = float2(-1.0, +3.0);
+    Positions[2] = float2(+3.0, -1.0);
+    Pos = float4(Positions[VertId], 0.0, 1.0);
+}
+)"};
+
+const std::string ManyResources_PS{
+    R"(
+Texture2D g_Tex0;
+Texture2D g_Tex1;
+Texture2D g_Tex2;
+Texture2D g_Tex3;
+Texture2D g_Tex4;
+Texture2D g_Tex5;
+Texture2D g_Tex6;
+Texture2D g_Tex7;
+
+SamplerState g_Tex0_sampler;
+SamplerState g_Tex1_sampler;
+SamplerState g_Tex2_sampler;
+SamplerState g_Tex3_sampler;
+SamplerState g_Tex4_sampler;
+SamplerState g_Tex5_sampler;
+
+cbuffer CB0 { float4 g_CB0Value; }
+cbuffer CB1 { float4 g_CB1Value; }
+cbuffer CB2 { float4 g_CB2Value; }
+cbuffer CB3 { float4 g_CB3Value; }
+
+#if USE_STRUCTURED_BUFFERS
+StructuredBuffer<float4> g_SB0;
+StructuredBuffer<float4> g_SB1;
+#endif
+
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    // With point filtering, u = 1.25 selects texel 0 in wrap mode and texel 1 in clamp mode
+    float2 UV = float2(1.25, 0.5);
+
+    int i = int(Pos.x);
+    if (i == 0) return g_Tex0.Sample(g_Tex0_sampler, UV);
+    if (i == 1) return g_Tex1.Sample(g_Tex1_sampler, UV);
+    if (i == 2) return g_Tex2.Sample(g_Tex2_sampler, UV);
+    if (i == 3) return g_Tex3.Sample(g_Tex3_sampler, UV);
+    if (i == 4) return g_Tex4.Sample(g_Tex4_sampler, UV);
+    if (i == 5) return g_Tex5.Sample(g_Tex5_sampler, UV);
+    if (i == 6) return g_Tex6.Load(int3(0, 0, 0));
+    if (i == 7) return g_Tex7.Load(int3(0, 0, 0));
+    if (i == 8) return g_CB0Value;
+    if (i == 9) return g_CB1Value;
+    if (i == 10) return g_CB2Value;
+    if (i == 11) return g_CB3Value;
+#if USE_STRUCTURED_BUFFERS
+    if (i == 12) return g_SB0[1];
+    if (i == 13) return g_SB1[1];
+#endif
+    return float4(0.0, 0.0, 0.0, 0.0);
+}
+)"};
+
+constexpr Uint32 NumTextureSlots   = 8;
+constexpr Uint32 NumSampledSlots   = 6;
+constexpr Uint32 NumCBSlots        = 4;
+constexpr Uint32 NumSBSlots        = 2;
+constexpr Uint32 RenderTargetWidth = NumTextureSlots + NumCBSlots + NumSBSlots;
+
+using Color = std::array<Uint8, 4>;
+
+Color GetTexelColor(Uint32 Tex, Uint32 Texel)
+{
+    return Color{
+        static_cast<Uint8>(10 + Tex * 40 + Texel * 20),
+        static_cast<Uint8>(200 - Tex * 30 - Texel * 10),
+        static_cast<Uint8>(64 + Texel * 128),
+        255 //
+    };
+}
+
+Color GetBufferColor(Uint32 Buff)
+{
+    return Color{
+        static_cast<Uint8>(25 + Buff * 50),
+        static_cast<Uint8>(230 - Buff * 20),
+        static_cast<Uint8>(Buff * 10),
+        static_cast<Uint8>(255 - Buff * 5) //
+    };
+}
+
+float4 ColorToFloat4(const Color& C)
+{
+    return float4{C[0] / 255.f, C[1] / 255.f, C[2] / 255.f, C[3] / 255.f};
+}
+
+struct BindingSet
+{
+    // Indices of the textures, constant buffers and structured buffers bound to every slot
+    Uint32 Textures[NumTextureSlots];
+    Uint32 CBs[NumCBSlots];
+    Uint32 SBs[NumSBSlots];
+};
+
+class ManyResourcesTest
+{
+public:
+    static constexpr Uint32 NumTextures = 6;
+    static constexpr Uint32 NumBuffers  = 6;
+
+    ManyResourcesTest()
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        UseStructuredBuffers = pDevice->GetDeviceCaps().Features.ComputeShaders;
+
+        SamplerDesc SamDesc;
+        SamDesc.MinFilter = FILTER_TYPE_POINT;
+        SamDesc.MagFilter = FILTER_TYPE_POINT;
+        SamDesc.MipFilter = FILTER_TYPE_POINT;
+        SamDesc.AddressU  = TEXTURE_ADDRESS_WRAP;
+        pDevice->CreateSampler(SamDesc, &pWrapSampler);
+        SamDesc.AddressU = TEXTURE_ADDRESS_CLAMP;
+        pDevice->CreateSampler(SamDesc, &pClampSampler);
+
+        for (Uint32 t = 0; t < NumTextures; ++t)
+        {
+            TextureDesc TexDesc;
+            TexDesc.Name      = "Many resources test texture";
+            TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+            TexDesc.Width     = 2;
+            TexDesc.Height    = 1;
+            TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+            TexDesc.Usage     = USAGE_STATIC;
+            TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+            Color Texels[] = {GetTexelColor(t, 0), GetTexelColor(t, 1)};
+
+            TextureSubResData SubResData{Texels, sizeof(Texels)};
+            TextureData       TexData{&SubResData, 1};
+            pDevice->CreateTexture(TexDesc, &TexData, &pTextures[t]);
+            if (pTextures[t])
+                pTextures[t]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE)->SetSampler(IsClampTexture(t) ? pClampSampler : pWrapSampler);
+        }
+
+        for (Uint32 b = 0; b < NumBuffers; ++b)
+        {
+            const auto Value = ColorToFloat4(GetBufferColor(b));
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name          = "Many resources test constant buffer";
+            BuffDesc.uiSizeInBytes = sizeof(Value);
+            BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+
+            BufferData InitData{&Value, sizeof(Value)};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &pCBs[b]);
+
+            if (UseStructuredBuffers)
+            {
+                const float4 Elements[] = {float4{0, 0, 0, 0}, Value};
+
+                BuffDesc.Name              = "Many resources test structured buffer";
+                BuffDesc.uiSizeInBytes     = sizeof(Elements);
+                BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+                BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+                BuffDesc.ElementByteStride = sizeof(float4);
+
+                InitData = BufferData{Elements, sizeof(Elements)};
+                pDevice->CreateBuffer(BuffDesc, &InitData, &pSBs[b]);
+            }
+        }
+
+        pRenderTarget = pEnv->CreateTexture("Many resources test render target", TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET, RenderTargetWidth, 1);
+
+        TextureDesc StagingDesc    = pRenderTarget->GetDesc();
+        StagingDesc.Name           = "Many resources test staging texture";
+        StagingDesc.Usage          = USAGE_STAGING;
+        StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        StagingDesc.BindFlags      = BIND_NONE;
+        pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTexture);
+
+        CreatePSO();
+    }
+
+    static bool IsClampTexture(Uint32 Tex) { return (Tex % 2) != 0; }
+
+    bool IsValid() const
+    {
+        for (const auto& pTex : pTextures)
+        {
+            if (!pTex)
+                return false;
+        }
+        for (Uint32 b = 0; b < NumBuffers; ++b)
+        {
+            if (!pCBs[b] || (UseStructuredBuffers && !pSBs[b]))
+                return false;
+        }
+        return pWrapSampler && pClampSampler && pRenderTarget && pStagingTexture && pPSO;
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> CreateSRB(const BindingSet& Set)
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB, true);
+        if (!pSRB)
+            return {};
+
+        for (Uint32 slot = 0; slot < NumTextureSlots; ++slot)
+        {
+            const auto Name = std::string{"g_Tex"} + std::to_string(slot);
+            pSRB->GetVariableByName(SHADER_TYPE_PIXEL, Name.c_str())->Set(pTextures[Set.Textures[slot]]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        }
+        for (Uint32 slot = 0; slot < NumCBSlots; ++slot)
+        {
+            const auto Name = std::string{"CB"} + std::to_string(slot);
+            pSRB->GetVariableByName(SHADER_TYPE_PIXEL, Name.c_str())->Set(pCBs[Set.CBs[slot]]);
+        }
+        if (UseStructuredBuffers)
+        {
+            for (Uint32 slot = 0; slot < NumSBSlots; ++slot)
+            {
+                const auto Name = std::string{"g_SB"} + std::to_string(slot);
+                pSRB->GetVariableByName(SHADER_TYPE_PIXEL, Name.c_str())->Set(pSBs[Set.SBs[slot]]->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+            }
+        }
+        return pSRB;
+    }
+
+    void Draw(IShaderResourceBinding* pSRB)
+    {
+        auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+        ITextureView* pRTVs[] = {pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const float ClearColor[] = {0, 0, 0, 0};
+        pContext->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        DrawAttribs drawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+        pContext->Draw(drawAttrs);
+    }
+
+    void Verify(const BindingSet& Set, const char* Pass)
+    {
+        auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+        CopyTextureAttribs CopyAttribs{pRenderTarget, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        pContext->CopyTexture(CopyAttribs);
+        pContext->WaitForIdle();
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pStagingTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+
+        const auto* Pixels = static_cast<const Uint8*>(MappedData.pData);
+        for (Uint32 x = 0; x < RenderTargetWidth; ++x)
+        {
+            Color Expected = {};
+            if (x < NumSampledSlots)
+            {
+                const auto Tex = Set.Textures[x];
+                Expected       = GetTexelColor(Tex, IsClampTexture(Tex) ? 1 : 0);
+            }
+            else if (x < NumTextureSlots)
+                Expected = GetTexelColor(Set.Textures[x], 0);
+            else if (x < NumTextureSlots + NumCBSlots)
+                Expected = GetBufferColor(Set.CBs[x - NumTextureSlots]);
+            else if (UseStructuredBuffers)
+                Expected = GetBufferColor(Set.SBs[x - NumTextureSlots - NumCBSlots]);
+
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                EXPECT_NEAR(Pixels[x * 4 + c], Expected[c], 1) << Pass << ": pixel " << x << ", channel " << c;
+            }
+        }
+
+        pContext->UnmapTextureSubresource(pStagingTexture, 0, 0);
+    }
+
+private:
+    void CreatePSO()
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+        ShaderMacro Macros[] = {{"USE_STRUCTURED_BUFFERS", UseStructuredBuffers ? "1" : "0"}, {}};
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.Macros                     = Macros;
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+            ShaderCI.EntryPoint      = "main";
+            ShaderCI.Desc.Name       = "Many resources test vertex shader";
+            ShaderCI.Source          = ManyResources_VS.c_str();
+            pDevice->CreateShader(ShaderCI, &pVS);
+            if (!pVS)
+                return;
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+            ShaderCI.EntryPoint      = "main";
+            ShaderCI.Desc.Name       = "Many resources test pixel shader";
+            ShaderCI.Source          = ManyResources_PS.c_str();
+            pDevice->CreateShader(ShaderCI, &pPS);
+            if (!pPS)
+                return;
+        }
+
+        PipelineStateCreateInfo PSOCreateInfo;
+        PipelineStateDesc&      PSODesc = PSOCreateInfo.PSODesc;
+
+        PSODesc.Name = "Many resources test";
+
+        PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+        PSODesc.GraphicsPipeline.NumRenderTargets             = 1;
+        PSODesc.GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+        PSODesc.GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        PSODesc.GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        PSODesc.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+        PSODesc.GraphicsPipeline.pVS                          = pVS;
+        PSODesc.GraphicsPipeline.pPS                          = pPS;
+        pDevice->CreatePipelineState(PSOCreateInfo, &pPSO);
+    }
+
+    bool UseStructuredBuffers = false;
+
+    RefCntAutoPtr<ISampler> pWrapSampler;
+    RefCntAutoPtr<ISampler> pClampSampler;
+    RefCntAutoPtr<ITexture> pTextures[NumTextures];
+    RefCntAutoPtr<IBuffer>  pCBs[NumBuffers];
+    RefCntAutoPtr<IBuffer>  pSBs[NumBuffers];
+    RefCntAutoPtr<ITexture> pRenderTarget;
+    RefCntAutoPtr<ITexture> pStagingTexture;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+};
+
+TEST(ResourceBindingTest, ManyResources)
+{
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ManyResourcesTest Test;
+    ASSERT_TRUE(Test.IsValid());
+
+    // Binding sets contain repeated resources. The second set differs from the first one
+    // in separate slots in the middle of the ranges, so that the context has to split or
+    // extend the batched bindings, and has to restore the first set afterwards.
+    // clang-format off
+    const BindingSet SetA = {{0, 1, 0, 2, 3, 3, 1, 2}, {0, 1, 0, 2}, {3, 3}};
+    const BindingSet SetB = {{0, 1, 4, 2, 3, 3, 0, 5}, {0, 4, 0, 2}, {5, 3}};
+    const BindingSet SetC = {{5, 1, 4, 2, 3, 4, 0, 5}, {1, 4, 0, 3}, {5, 4}};
+    // clang-format on
+
+    auto pSRBA = Test.CreateSRB(SetA);
+    auto pSRBB = Test.CreateSRB(SetB);
+    auto pSRBC = Test.CreateSRB(SetC);
+    ASSERT_TRUE(pSRBA && pSRBB && pSRBC);
+
+    const std::pair<IShaderResourceBinding*, const BindingSet*> Passes[] = {
+        {pSRBA, &SetA},
+        {pSRBB, &SetB},
+        {pSRBA, &SetA},
+        {pSRBC, &SetC},
+        {pSRBB, &SetB},
+    };
+    for (size_t pass = 0; pass < _countof(Passes); ++pass)
+    {
+        Test.Draw(Passes[pass].first);
+        Test.Verify(*Passes[pass].second, (std::string{"Pass "} + std::to_string(pass)).c_str());
+    }
+}
+
+} // namespace
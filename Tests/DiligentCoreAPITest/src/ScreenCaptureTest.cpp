@@ -0,0 +1,312 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+
+#include "TestingEnvironment.hpp"
+#include "ScreenCapture.hpp"
+#include "GraphicsAccessories.hpp"
+#include "FileWrapper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumTestFrames = 32;
+
+// Renders the test frames, where the red channel of the clear color encodes the frame id,
+// captures them and waits until all captures are encoded. Returns the ids of the frames
+// that were not dropped.
+std::vector<Uint32> RenderAndCaptureFrames(ScreenCapture& Capture)
+{
+    auto* pEnv       = TestingEnvironment::GetInstance();
+    auto* pSwapChain = pEnv->GetSwapChain();
+    auto* pContext   = pEnv->GetDeviceContext();
+
+    std::vector<Uint32> CapturedFrames;
+    for (Uint32 frame = 0; frame < NumTestFrames; ++frame)
+    {
+        ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        float ClearColor[] = {static_cast<float>(frame * 8) / 255.f, 0.5f, 0.75f, 1.0f};
+        pContext->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        if (Capture.Capture(pSwapChain, pContext, frame))
+            CapturedFrames.push_back(frame);
+        pContext->Flush();
+
+        // Never waits for the GPU
+        Capture.ProcessCompletedCaptures(pContext);
+    }
+
+    Capture.Flush(pContext);
+
+    EXPECT_EQ(Capture.GetNumPendingCaptures(), size_t{0});
+    EXPECT_EQ(Capture.GetNumDroppedFrames() + CapturedFrames.size(), NumTestFrames);
+    EXPECT_EQ(Capture.GetNumEncodedFrames(), CapturedFrames.size());
+
+    return CapturedFrames;
+}
+
+void RunScreenCaptureTest(Uint32 NumStagingTextures, Uint32 NumEncoderThreads)
+{
+    auto* pEnv       = TestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    const auto& SCDesc = pSwapChain->GetDesc();
+    // Only check the color of 8-bit UNORM formats that are not affected by sRGB conversion
+    const bool CheckColor = SCDesc.ColorBufferFormat == TEX_FORMAT_RGBA8_UNORM || SCDesc.ColorBufferFormat == TEX_FORMAT_BGRA8_UNORM;
+
+    std::mutex          FramesMtx;
+    std::vector<Uint32> ReceivedFrames;
+    Uint32              NumColorMismatches = 0;
+
+    ScreenCaptureCreateInfo CI;
+    CI.NumStagingTextures = NumStagingTextures;
+    CI.NumEncoderThreads  = NumEncoderThreads;
+    CI.FrameCallback      = [&](const CapturedFrame& Frame) {
+        EXPECT_EQ(Frame.Width, SCDesc.Width);
+        EXPECT_EQ(Frame.Height, SCDesc.Height);
+        EXPECT_EQ(Frame.Format, SCDesc.ColorBufferFormat);
+
+        std::lock_guard<std::mutex> Lock{FramesMtx};
+        ReceivedFrames.push_back(Frame.Id);
+        if (CheckColor)
+        {
+            // Red channel encodes the frame id
+            const auto Expected = static_cast<Uint8>(Frame.Id * 8);
+            const auto Actual   = Frame.pData[SCDesc.ColorBufferFormat == TEX_FORMAT_RGBA8_UNORM ? 0 : 2];
+            if (Actual != Expected)
+                ++NumColorMismatches;
+        }
+    };
+
+    ScreenCapture Capture{pDevice, CI};
+
+    const auto CapturedFrames = RenderAndCaptureFrames(Capture);
+    if (NumStagingTextures == 0)
+    {
+        EXPECT_EQ(Capture.GetNumDroppedFrames(), Uint32{0});
+    }
+
+    std::lock_guard<std::mutex> Lock{FramesMtx};
+    if (NumEncoderThreads <= 1)
+    {
+        // Frames are delivered in the capture order
+        EXPECT_EQ(ReceivedFrames, CapturedFrames);
+    }
+    else
+    {
+        std::sort(ReceivedFrames.begin(), ReceivedFrames.end());
+        EXPECT_EQ(ReceivedFrames, CapturedFrames);
+    }
+    EXPECT_EQ(NumColorMismatches, Uint32{0});
+}
+
+TEST(ScreenCaptureTest, UnlimitedRing)
+{
+    RunScreenCaptureTest(0, 1);
+}
+
+TEST(ScreenCaptureTest, StagingTextureRing)
+{
+    RunScreenCaptureTest(3, 1);
+}
+
+TEST(ScreenCaptureTest, InlineEncoding)
+{
+    RunScreenCaptureTest(3, 0);
+}
+
+TEST(ScreenCaptureTest, MultipleEncoderThreads)
+{
+    RunScreenCaptureTest(4, 4);
+}
+
+
+String GetFrameFileName(const String& Prefix, Uint32 Id, const char* Extension)
+{
+    char IdStr[16];
+    snprintf(IdStr, sizeof(IdStr), "%06u", Id);
+    return Prefix + IdStr + Extension;
+}
+
+std::vector<Uint8> ReadFileData(const String& Path)
+{
+    std::vector<Uint8> Data;
+    if (!FileSystem::FileExists(Path.c_str()))
+        return Data;
+
+    FileWrapper File{Path.c_str(), EFileAccessMode::Read};
+    if (File)
+    {
+        Data.resize(File->GetSize());
+        if (!Data.empty() && !File->Read(Data.data(), Data.size()))
+            Data.clear();
+    }
+    return Data;
+}
+
+Uint32 ReadBigEndianUint32(const Uint8* pData)
+{
+    return (Uint32{pData[0]} << 24u) | (Uint32{pData[1]} << 16u) | (Uint32{pData[2]} << 8u) | Uint32{pData[3]};
+}
+
+// Checks the tightly packed pixels of a frame written by SCREEN_CAPTURE_ENCODING_RAW or SCREEN_CAPTURE_ENCODING_RAW_VIDEO
+void VerifyRawFrame(const Uint8* pData, const SwapChainDesc& SCDesc, Uint32 FrameId)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(SCDesc.ColorBufferFormat);
+    const auto  PixelSize  = Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+
+    // The frame is cleared with a single color
+    Uint32 NumMismatchedPixels = 0;
+    for (Uint32 i = 1; i < SCDesc.Width * SCDesc.Height; ++i)
+    {
+        if (memcmp(pData + size_t{i} * PixelSize, pData, PixelSize) != 0)
+            ++NumMismatchedPixels;
+    }
+    EXPECT_EQ(NumMismatchedPixels, Uint32{0}) << "Frame " << FrameId;
+
+    // Red channel encodes the frame id
+    if (SCDesc.ColorBufferFormat == TEX_FORMAT_RGBA8_UNORM || SCDesc.ColorBufferFormat == TEX_FORMAT_BGRA8_UNORM)
+    {
+        EXPECT_EQ(pData[SCDesc.ColorBufferFormat == TEX_FORMAT_RGBA8_UNORM ? 0 : 2], static_cast<Uint8>(FrameId * 8)) << "Frame " << FrameId;
+    }
+}
+
+// Frame files are written to the working directory with a prefix that is unique to the test
+void RunScreenCaptureEncodingTest(SCREEN_CAPTURE_ENCODING Encoding, Uint32 NumEncoderThreads, const char* OutputPath)
+{
+    auto* pEnv       = TestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    const auto& SCDesc     = pSwapChain->GetDesc();
+    const auto& FmtAttribs = GetTextureFormatAttribs(SCDesc.ColorBufferFormat);
+    const auto  FrameSize  = size_t{SCDesc.Width} * size_t{SCDesc.Height} * size_t{FmtAttribs.ComponentSize} * size_t{FmtAttribs.NumComponents};
+
+    const char* Extension = Encoding == SCREEN_CAPTURE_ENCODING_PNG ? ".png" : ".raw";
+
+    std::vector<Uint32> CapturedFrames;
+    {
+        ScreenCaptureCreateInfo CI;
+        CI.NumEncoderThreads = NumEncoderThreads;
+        CI.Encoding          = Encoding;
+        CI.OutputPath        = OutputPath;
+
+        // The video file is closed when the screen capture is destroyed
+        ScreenCapture Capture{pDevice, CI};
+        CapturedFrames = RenderAndCaptureFrames(Capture);
+        EXPECT_EQ(Capture.GetNumDroppedFrames(), Uint32{0});
+    }
+    ASSERT_EQ(CapturedFrames.size(), size_t{NumTestFrames});
+
+    if (Encoding == SCREEN_CAPTURE_ENCODING_RAW_VIDEO)
+    {
+        const auto Data = ReadFileData(OutputPath);
+        // Frames must be appended in the capture order, even if they are encoded by multiple threads
+        ASSERT_EQ(Data.size(), FrameSize * CapturedFrames.size());
+        for (size_t i = 0; i < CapturedFrames.size(); ++i)
+            VerifyRawFrame(Data.data() + FrameSize * i, SCDesc, CapturedFrames[i]);
+
+        FileSystem::DeleteFile(OutputPath);
+        return;
+    }
+
+    Uint32 NumFiles = 0;
+    for (Uint32 frame = 0; frame < NumTestFrames; ++frame)
+    {
+        const auto FileName = GetFrameFileName(OutputPath, frame, Extension);
+        const auto Data     = ReadFileData(FileName);
+        if (Data.empty())
+        {
+            ADD_FAILURE() << "Frame file '" << FileName << "' is missing or empty";
+            continue;
+        }
+        ++NumFiles;
+
+        if (Encoding == SCREEN_CAPTURE_ENCODING_RAW)
+        {
+            EXPECT_EQ(Data.size(), FrameSize) << FileName;
+            if (Data.size() == FrameSize)
+                VerifyRawFrame(Data.data(), SCDesc, frame);
+        }
+        else
+        {
+            // PNG signature followed by the IHDR chunk
+            static constexpr Uint8 PNGSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+            if (Data.size() > 33 &&
+                memcmp(Data.data(), PNGSignature, sizeof(PNGSignature)) == 0 &&
+                memcmp(Data.data() + 12, "IHDR", 4) == 0)
+            {
+                EXPECT_EQ(ReadBigEndianUint32(Data.data() + 16), SCDesc.Width) << FileName;
+                EXPECT_EQ(ReadBigEndianUint32(Data.data() + 20), SCDesc.Height) << FileName;
+                EXPECT_EQ(Data[24], 8) << FileName << ": unexpected bit depth";
+                EXPECT_EQ(Data[25], 6) << FileName << ": unexpected color type (RGBA is expected)";
+            }
+            else
+            {
+                ADD_FAILURE() << FileName << " is not a valid PNG file";
+            }
+        }
+
+        FileSystem::DeleteFile(FileName.c_str());
+    }
+    EXPECT_EQ(NumFiles, NumTestFrames);
+}
+
+TEST(ScreenCaptureTest, RawEncoding)
+{
+    RunScreenCaptureEncodingTest(SCREEN_CAPTURE_ENCODING_RAW, 2, "ScreenCaptureTest_Raw_");
+}
+
+TEST(ScreenCaptureTest, PNGEncoding)
+{
+    RunScreenCaptureEncodingTest(SCREEN_CAPTURE_ENCODING_PNG, 2, "ScreenCaptureTest_PNG_");
+}
+
+TEST(ScreenCaptureTest, RawVideoEncoding)
+{
+    // Multiple encoder threads test that the frames are still written in the capture order
+    RunScreenCaptureEncodingTest(SCREEN_CAPTURE_ENCODING_RAW_VIDEO, 4, "ScreenCaptureTest_Video.raw");
+}
+
+} // namespace
@@ -99,7 +99,7 @@ TestingEnvironment::TestingEnvironment(RENDER_DEVICE_TYPE deviceType, ADAPTER_TY
     VERIFY(m_pTheEnvironment == nullptr, "Testing environment object has already been initialized!");
     m_pTheEnvironment = this;
 
-    Uint32 NumDeferredCtx = 0;
+    Uint32 NumDeferredCtx = 1;
 
     std::vector<IDeviceContext*> ppContexts;
     std::vector<AdapterAttribs>  Adapters;
@@ -278,12 +278,10 @@ TestingEnvironment::TestingEnvironment(RENDER_DEVICE_TYPE deviceType, ADAPTER_TY
             CreateInfo.DebugMessageCallback = MessageCallback;
             CreateInfo.Window               = Window;
             CreateInfo.CreateDebugContext   = true;
+            // Suballocate dynamic uniform buffers from the persistently mapped heap, if supported
+            CreateInfo.DynamicHeapSize = 4 << 20;
 
-            if (NumDeferredCtx != 0)
-            {
-                LOG_ERROR_MESSAGE("Deferred contexts are not supported in OpenGL mode");
-                NumDeferredCtx = 0;
-            }
+            CreateInfo.NumDeferredContexts = NumDeferredCtx;
             ppContexts.resize(1 + NumDeferredCtx);
             RefCntAutoPtr<ISwapChain> pSwapChain; // We will use testing swap chain instead
             pFactoryOpenGL->CreateDeviceAndSwapChainGL(
@@ -310,6 +308,8 @@ TestingEnvironment::TestingEnvironment(RENDER_DEVICE_TYPE deviceType, ADAPTER_TY
             CreateInfo.MainDescriptorPoolSize    = VulkanDescriptorPoolSize{64, 64, 256, 256, 64, 32, 32, 32, 32};
             CreateInfo.DynamicDescriptorPoolSize = VulkanDescriptorPoolSize{64, 64, 256, 256, 64, 32, 32, 32, 32};
             CreateInfo.UploadHeapPageSize        = 32 * 1024;
+            // Execute initial data uploads on the dedicated transfer queue, if the device has one
+            CreateInfo.EnableTransferQueue = true;
             //CreateInfo.DeviceLocalMemoryReserveSize = 32 << 20;
             //CreateInfo.HostVisibleMemoryReserveSize = 48 << 20;
 
@@ -340,6 +340,13 @@ TestingEnvironment::TestingEnvironment(RENDER_DEVICE_TYPE deviceType, ADAPTER_TY
             break;
     }
     m_pDeviceContext.Attach(ppContexts[0]);
+    for (Uint32 ctx = 0; ctx < NumDeferredCtx; ++ctx)
+    {
+        if (ppContexts[1 + ctx] == nullptr)
+            break;
+        m_pDeferredContexts.emplace_back();
+        m_pDeferredContexts.back().Attach(ppContexts[1 + ctx]);
+    }
 }
 
 TestingEnvironment::~TestingEnvironment()
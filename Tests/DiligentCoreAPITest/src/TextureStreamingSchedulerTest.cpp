@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <cstring>
+
+#include "TextureStreamingScheduler.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(TextureStreamingSchedulerTest, Budget)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    RefCntAutoPtr<ITextureUploader> pTexUploader;
+    CreateTextureUploader(pDevice, TextureUploaderDesc{}, &pTexUploader);
+    ASSERT_TRUE(pTexUploader);
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Texture streaming dst texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Width     = 256;
+    TexDesc.Height    = 256;
+    TexDesc.MipLevels = 0;
+    TexDesc.ArraySize = 4;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    RefCntAutoPtr<ITexture> pDstTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pDstTexture);
+    ASSERT_TRUE(pDstTexture);
+    const auto NumMips = pDstTexture->GetDesc().MipLevels;
+
+    TextureStreamingSchedulerDesc SchedulerDesc;
+    // The finest mip level of one slice
+    SchedulerDesc.MaxBytesPerFrame        = 256 * 256 * 4;
+    SchedulerDesc.MaxCopyCommandsPerFrame = 6;
+    TextureStreamingScheduler Scheduler{pTexUploader, SchedulerDesc};
+
+    std::vector<float> DispatchedPriorities;
+
+    std::vector<TextureStreamingScheduler::RequestId> Ids;
+    for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+    {
+        for (Uint32 mip = 0; mip < NumMips; ++mip)
+        {
+            TextureStreamingRequest Request;
+            Request.pDstTexture       = pDstTexture;
+            Request.DstArraySlice     = slice;
+            Request.DstMipLevel       = mip;
+            Request.UploadDesc.Width  = TexDesc.Width >> mip;
+            Request.UploadDesc.Height = TexDesc.Height >> mip;
+            Request.UploadDesc.Format = TexDesc.Format;
+            Request.Priority          = ComputeStreamingPriority(static_cast<float>(slice + 1), mip, NumMips);
+            const auto Priority       = Request.Priority;
+            const auto UploadDesc     = Request.UploadDesc;
+            Request.WriteData         = [UploadDesc](IUploadBuffer* pBuffer) {
+                auto MappedData = pBuffer->GetMappedData(0, 0);
+                for (Uint32 row = 0; row < UploadDesc.Height; ++row)
+                    memset(reinterpret_cast<Uint8*>(MappedData.pData) + row * MappedData.Stride, 0x7F, UploadDesc.Width * 4);
+            };
+            Request.OnCopyScheduled = [&DispatchedPriorities, Priority]() {
+                DispatchedPriorities.push_back(Priority);
+            };
+
+            auto Id = Scheduler.Submit(std::move(Request));
+            EXPECT_NE(Id, TextureStreamingScheduler::InvalidRequestId);
+            Ids.push_back(Id);
+        }
+    }
+
+    // A request that can never fit into the budget is rejected
+    {
+        TextureStreamingRequest Request;
+        Request.pDstTexture          = pDstTexture;
+        Request.UploadDesc.Width     = TexDesc.Width;
+        Request.UploadDesc.Height    = TexDesc.Height;
+        Request.UploadDesc.Format    = TexDesc.Format;
+        Request.UploadDesc.ArraySize = 2;
+        EXPECT_EQ(Scheduler.Submit(std::move(Request)), TextureStreamingScheduler::InvalidRequestId);
+    }
+
+    // Cancel the finest mip of the first slice
+    EXPECT_TRUE(Scheduler.Cancel(Ids[0]));
+    EXPECT_FALSE(Scheduler.Cancel(Ids[0]));
+
+    // Move the finest mip of the second slice to the front of the queue
+    EXPECT_TRUE(Scheduler.SetPriority(Ids[NumMips], 1e+10f));
+
+    const auto NumRequests = TexDesc.ArraySize * NumMips - 1;
+    EXPECT_EQ(Scheduler.GetStats().NumPendingRequests, NumRequests);
+
+    Uint32 NumFrames = 0;
+    while (Scheduler.GetStats().NumPendingRequests > 0)
+    {
+        Scheduler.Update(pContext);
+        pContext->Flush();
+        ++NumFrames;
+        ASSERT_LT(NumFrames, 1000u);
+
+        const auto Stats = Scheduler.GetStats();
+        EXPECT_LE(Stats.NumBytesLastFrame, SchedulerDesc.MaxBytesPerFrame);
+        EXPECT_LE(Stats.NumCopyCommandsLastFrame, SchedulerDesc.MaxCopyCommandsPerFrame);
+        EXPECT_GT(Stats.NumRequestsLastFrame, 0u);
+    }
+    pContext->WaitForIdle();
+
+    const auto Stats = Scheduler.GetStats();
+    EXPECT_EQ(Stats.NumCompletedRequests, NumRequests);
+    EXPECT_EQ(Stats.NumCancelledRequests, 1u);
+    EXPECT_EQ(Stats.NumPendingBytes, 0u);
+    EXPECT_EQ(Stats.MaxLatencyFrames, NumFrames);
+
+    // Requests are dispatched in strict priority order
+    ASSERT_EQ(DispatchedPriorities.size(), size_t{NumRequests});
+    EXPECT_EQ(DispatchedPriorities[0], ComputeStreamingPriority(2, 0, NumMips));
+    for (size_t i = 2; i < DispatchedPriorities.size(); ++i)
+        EXPECT_GE(DispatchedPriorities[i - 1], DispatchedPriorities[i]);
+}
+
+} // namespace
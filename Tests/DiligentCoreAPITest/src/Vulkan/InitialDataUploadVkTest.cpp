@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#define VK_NO_PROTOTYPES
+#include "vulkan/vulkan.h"
+
+#include "TestingEnvironment.hpp"
+#include "RenderDeviceVk.h"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(InitialDataUploadVk, CreateTexturesWithData)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    if (!pDeviceVk)
+    {
+        GTEST_SKIP() << "Initial data upload batching is only implemented in Vulkan backend";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumTextures = 256;
+#else
+    constexpr Uint32 NumTextures = 4096;
+#endif
+    constexpr Uint32 TexSize = 16;
+
+    std::vector<Uint32> TexData(TexSize * TexSize, 0xFF00FF00u);
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Initial data upload test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = TexSize;
+    TexDesc.Height    = TexSize;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    TextureSubResData SubresData{TexData.data(), TexSize * 4};
+    TextureData       InitData{&SubresData, 1};
+
+    std::vector<RefCntAutoPtr<ITexture>> Textures(NumTextures);
+
+    Timer T;
+    for (auto& pTexture : Textures)
+    {
+        pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+        ASSERT_NE(pTexture, nullptr);
+    }
+    const auto CreationTime = T.GetElapsedTime();
+
+    // The last texture is in the pending batch at most, so its fence value must be the last one
+    const auto LastFenceValue = pDeviceVk->GetInitialDataFenceValue(Textures.back());
+    const auto FenceValue     = pDeviceVk->FlushInitialDataUploads();
+    EXPECT_GE(FenceValue, LastFenceValue);
+    for (auto& pTexture : Textures)
+        EXPECT_LE(pDeviceVk->GetInitialDataFenceValue(pTexture), FenceValue);
+
+    pDevice->IdleGPU();
+    const auto TotalTime = T.GetElapsedTime();
+
+    EXPECT_TRUE(pDeviceVk->IsFenceSignaled(0, FenceValue));
+    EXPECT_TRUE(pDeviceVk->IsFenceSignaled(0, pDeviceVk->GetInitialDataFenceValue(Textures.front())));
+
+    LOG_INFO_MESSAGE("Created ", NumTextures, ' ', TexSize, 'x', TexSize, " textures with initial data in ",
+                     CreationTime * 1000.0, " ms (", CreationTime * 1e+6 / NumTextures, " us per texture); ",
+                     "uploads completed in ", TotalTime * 1000.0, " ms");
+}
+
+TEST(InitialDataUploadVk, CreateBuffersWithData)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    if (!pDeviceVk)
+    {
+        GTEST_SKIP() << "Initial data upload batching is only implemented in Vulkan backend";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    std::vector<float> Data(64, 1.f);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = "Initial data upload test buffer";
+    BuffDesc.uiSizeInBytes = static_cast<Uint32>(Data.size() * sizeof(Data[0]));
+    BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+    BuffDesc.Usage         = USAGE_DEFAULT;
+
+    BufferData InitData{Data.data(), BuffDesc.uiSizeInBytes};
+
+    RefCntAutoPtr<IBuffer> pBuffer0;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer0);
+    ASSERT_NE(pBuffer0, nullptr);
+
+    RefCntAutoPtr<IBuffer> pBuffer1;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer1);
+    ASSERT_NE(pBuffer1, nullptr);
+    // Buffers without initial data are not uploaded
+    EXPECT_EQ(pDeviceVk->GetInitialDataFenceValue(pBuffer1), Uint64{0});
+
+    const auto FenceValue = pDeviceVk->GetInitialDataFenceValue(pBuffer0);
+    // The upload must have been submitted
+    EXPECT_LT(FenceValue, pDeviceVk->GetNextFenceValue(0));
+
+    pDevice->IdleGPU();
+    EXPECT_TRUE(pDeviceVk->IsFenceSignaled(0, FenceValue));
+}
+
+} // namespace
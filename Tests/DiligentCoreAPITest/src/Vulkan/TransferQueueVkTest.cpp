@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+
+#define VK_NO_PROTOTYPES
+#include "vulkan/vulkan.h"
+
+#include "TestingEnvironment.hpp"
+#include "RenderDeviceVk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(TransferQueueVk, CopyTextureOnTransferQueue)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    if (!pDeviceVk)
+    {
+        GTEST_SKIP() << "Transfer queue is only supported in Vulkan backend";
+    }
+
+    TransferQueueStatsVk StatsBefore;
+    pDeviceVk->GetTransferQueueStats(StatsBefore);
+    if (StatsBefore.QueueIndex == 0)
+    {
+        GTEST_SKIP() << "The device does not have a dedicated transfer queue";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 64;
+
+    std::vector<Uint32> RefData(Width * Height);
+    for (Uint32 i = 0; i < RefData.size(); ++i)
+        RefData[i] = i * 2654435761u;
+
+    TextureDesc TexDesc;
+    TexDesc.Name           = "Transfer queue upload texture";
+    TexDesc.Type           = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width          = Width;
+    TexDesc.Height         = Height;
+    TexDesc.Format         = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Usage          = USAGE_STAGING;
+    TexDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+    RefCntAutoPtr<ITexture> pUploadTex;
+    pDevice->CreateTexture(TexDesc, nullptr, &pUploadTex);
+    ASSERT_NE(pUploadTex, nullptr);
+    {
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pUploadTex, 0, 0, MAP_WRITE, MAP_FLAG_NONE, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+        for (Uint32 row = 0; row < Height; ++row)
+            memcpy(reinterpret_cast<Uint8*>(MappedData.pData) + row * MappedData.Stride, &RefData[row * Width], Width * 4);
+        pContext->UnmapTextureSubresource(pUploadTex, 0, 0);
+    }
+
+    TexDesc.Name           = "Transfer queue destination texture";
+    TexDesc.Usage          = USAGE_DEFAULT;
+    TexDesc.CPUAccessFlags = CPU_ACCESS_NONE;
+    TexDesc.BindFlags      = BIND_SHADER_RESOURCE;
+    TexDesc.MiscFlags      = MISC_TEXTURE_FLAG_NO_INITIAL_CLEAR;
+
+    RefCntAutoPtr<ITexture> pDstTex;
+    pDevice->CreateTexture(TexDesc, nullptr, &pDstTex);
+    ASSERT_NE(pDstTex, nullptr);
+    ASSERT_EQ(pDstTex->GetState(), RESOURCE_STATE_UNDEFINED);
+
+    // Start a new batch so that it is not submitted between the copies below
+    pDeviceVk->FlushInitialDataUploads();
+
+    CopyTextureAttribs CopyAttribs{pUploadTex, RESOURCE_STATE_TRANSITION_MODE_NONE, pDstTex, RESOURCE_STATE_TRANSITION_MODE_NONE};
+    EXPECT_TRUE(pDeviceVk->CopyTextureOnTransferQueue(CopyAttribs));
+    EXPECT_EQ(pDstTex->GetState(), RESOURCE_STATE_COPY_DEST);
+
+    // A copy into the texture that is still pending in the current batch is recorded into the same batch
+    Box HalfBox{0, Width, 0, Height / 2};
+    CopyAttribs.pSrcBox = &HalfBox;
+    EXPECT_TRUE(pDeviceVk->CopyTextureOnTransferQueue(CopyAttribs));
+    CopyAttribs.pSrcBox = nullptr;
+
+    // The transfer queue must not write textures the graphics queue may have used
+    TexDesc.Name      = "Cleared texture";
+    TexDesc.MiscFlags = MISC_TEXTURE_FLAG_NONE;
+    RefCntAutoPtr<ITexture> pClearedTex;
+    pDevice->CreateTexture(TexDesc, nullptr, &pClearedTex);
+    ASSERT_NE(pClearedTex, nullptr);
+    pDeviceVk->FlushInitialDataUploads();
+    CopyAttribs.pDstTexture = pClearedTex;
+    EXPECT_FALSE(pDeviceVk->CopyTextureOnTransferQueue(CopyAttribs));
+
+    // Read the data back through the graphics queue
+    TexDesc.Name           = "Transfer queue readback texture";
+    TexDesc.Usage          = USAGE_STAGING;
+    TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    TexDesc.BindFlags      = BIND_NONE;
+    RefCntAutoPtr<ITexture> pReadbackTex;
+    pDevice->CreateTexture(TexDesc, nullptr, &pReadbackTex);
+    ASSERT_NE(pReadbackTex, nullptr);
+
+    CopyTextureAttribs ReadbackAttribs{pDstTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pReadbackTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    pContext->CopyTexture(ReadbackAttribs);
+    pContext->WaitForIdle();
+
+    {
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pReadbackTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+        for (Uint32 row = 0; row < Height; ++row)
+        {
+            EXPECT_EQ(memcmp(reinterpret_cast<const Uint8*>(MappedData.pData) + row * MappedData.Stride, &RefData[row * Width], Width * 4), 0)
+                << "Row " << row << " does not match the reference data";
+        }
+        pContext->UnmapTextureSubresource(pReadbackTex, 0, 0);
+    }
+
+    TransferQueueStatsVk StatsAfter;
+    pDeviceVk->GetTransferQueueStats(StatsAfter);
+    EXPECT_EQ(StatsAfter.QueueIndex, StatsBefore.QueueIndex);
+    EXPECT_GE(StatsAfter.NumBatches, StatsBefore.NumBatches + 1);
+    EXPECT_GE(StatsAfter.NumUploads, StatsBefore.NumUploads + 2);
+    EXPECT_GE(StatsAfter.BytesUploaded, StatsBefore.BytesUploaded + Width * Height * 4);
+    EXPECT_LE(StatsAfter.BusyTime, StatsAfter.ElapsedTime);
+
+    LOG_INFO_MESSAGE("Transfer queue ", StatsAfter.QueueIndex, ": ", StatsAfter.NumBatches, " batches, ",
+                     StatsAfter.NumUploads, " uploads, ", StatsAfter.BytesUploaded, " bytes, ",
+                     StatsAfter.NumOwnershipTransfers, " ownership transfers, ",
+                     StatsAfter.ElapsedTime > 0 ? StatsAfter.BusyTime / StatsAfter.ElapsedTime * 100.0 : 0.0, "% utilization");
+}
+
+} // namespace
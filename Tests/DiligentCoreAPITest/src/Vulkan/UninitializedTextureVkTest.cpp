@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#define VK_NO_PROTOTYPES
+#include "vulkan/vulkan.h"
+
+#include "TestingEnvironment.hpp"
+#include "RenderDeviceVk.h"
+#include "TextureVk.h"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+double CreateRenderTargetPool(IRenderDeviceVk* pDeviceVk, const TextureDesc& TexDesc, std::vector<RefCntAutoPtr<ITexture>>& Textures)
+{
+    Timer T;
+    for (auto& pTexture : Textures)
+    {
+        pDeviceVk->CreateTexture(TexDesc, nullptr, &pTexture);
+        if (!pTexture)
+            return 0;
+    }
+    pDeviceVk->FlushInitialDataUploads();
+    pDeviceVk->IdleGPU();
+    return T.GetElapsedTime();
+}
+
+TEST(UninitializedTextureVk, CreateRenderTargetPool)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    if (!pDeviceVk)
+    {
+        GTEST_SKIP() << "MISC_TEXTURE_FLAG_NO_INITIAL_CLEAR only affects Vulkan backend";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumTextures = 8;
+#else
+    constexpr Uint32 NumTextures = 32;
+#endif
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Uninitialized render target";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 2048;
+    TexDesc.Height    = 2048;
+    TexDesc.Format    = TEX_FORMAT_RGBA16_FLOAT;
+    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    std::vector<RefCntAutoPtr<ITexture>> ClearedTextures(NumTextures);
+    const auto                           ClearedTime = CreateRenderTargetPool(pDeviceVk, TexDesc, ClearedTextures);
+    ASSERT_NE(ClearedTextures.back(), nullptr);
+    EXPECT_NE(ClearedTextures.back()->GetState(), RESOURCE_STATE_UNDEFINED);
+
+    TexDesc.MiscFlags = MISC_TEXTURE_FLAG_NO_INITIAL_CLEAR;
+    std::vector<RefCntAutoPtr<ITexture>> UninitializedTextures(NumTextures);
+    const auto                           UninitializedTime = CreateRenderTargetPool(pDeviceVk, TexDesc, UninitializedTextures);
+    ASSERT_NE(UninitializedTextures.back(), nullptr);
+
+    for (auto& pTexture : UninitializedTextures)
+    {
+        EXPECT_EQ(pTexture->GetState(), RESOURCE_STATE_UNDEFINED);
+        EXPECT_EQ(pDeviceVk->GetInitialDataFenceValue(pTexture), Uint64{0});
+
+        RefCntAutoPtr<ITextureVk> pTextureVk{pTexture, IID_TextureVk};
+        ASSERT_NE(pTextureVk, nullptr);
+        EXPECT_EQ(pTextureVk->GetLayout(), VK_IMAGE_LAYOUT_UNDEFINED);
+    }
+
+    LOG_INFO_MESSAGE("Created ", NumTextures, ' ', TexDesc.Width, 'x', TexDesc.Height, " render targets in ",
+                     ClearedTime * 1000.0, " ms with the initial clear and in ",
+                     UninitializedTime * 1000.0, " ms without it");
+
+    // The texture must be transitioned out of the undefined layout on first use
+    auto* pContext = pEnv->GetDeviceContext();
+
+    ITextureView* pRTV = UninitializedTextures.front()->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+    pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    const float ClearColor[] = {0.25f, 0.5f, 0.75f, 1.f};
+    pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    EXPECT_EQ(UninitializedTextures.front()->GetState(), RESOURCE_STATE_RENDER_TARGET);
+
+    pContext->Flush();
+    pContext->FinishFrame();
+    pDevice->IdleGPU();
+}
+
+} // namespace
@@ -25,6 +25,8 @@
  *  of the possibility of such damages.
  */
 
+#include <string.h>
+
 #include "ResourceMapping.h"
 
 int TestObjectCInterface(struct IObject* pObject);
@@ -60,7 +62,9 @@ int TestResourceMappingCInterface(struct IResourceMapping* pResourceMapping)
 
 void TestResourceMappingC_API(struct IResourceMapping* pResourceMapping)
 {
-    IDeviceObject* pObject = NULL;
+    IDeviceObject*            pObject      = NULL;
+    IDeviceObject*            pFoundObject = NULL;
+    ResourceMappingLookupInfo LookupInfo;
 
     Uint32 ArraySize  = 4;
     Uint32 ArrayIndex = 6;
@@ -71,4 +75,9 @@ void TestResourceMappingC_API(struct IResourceMapping* pResourceMapping)
     IResourceMapping_RemoveResourceByName(pResourceMapping, "Resource Name", ArrayIndex);
     IResourceMapping_GetResource(pResourceMapping, "Resource Name", &pObject, ArrayIndex);
     Size = IResourceMapping_GetSize(pResourceMapping);
+
+    memset(&LookupInfo, 0, sizeof(LookupInfo));
+    LookupInfo.Name       = "Resource Name";
+    LookupInfo.ArrayIndex = ArrayIndex;
+    IResourceMapping_GetResources(pResourceMapping, 1, &LookupInfo, &pFoundObject);
 }
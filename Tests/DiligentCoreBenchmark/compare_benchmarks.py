@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""Compares two DiligentCoreBenchmark runs and reports performance regressions.
+
+The inputs are JSON files produced with --benchmark_out=<file> (or with
+--benchmark_format=json), which use the Google Benchmark output schema.
+When the runs have repetitions, the median aggregates are compared,
+otherwise the iterations of every benchmark are averaged.
+
+Usage:
+    compare_benchmarks.py baseline.json contender.json [--threshold 5] [--metric cpu_time]
+
+The script exits with code 1 if any benchmark is slower than the baseline
+by more than the threshold percentage.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+TIME_UNIT_TO_NS = {
+    "ns": 1.0,
+    "us": 1e3,
+    "ms": 1e6,
+    "s": 1e9,
+}
+
+
+def load_results(path, metric):
+    with open(path, "r") as f:
+        data = json.load(f)
+
+    iterations = {}
+    medians = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        name = bench.get("run_name", bench["name"])
+        value = float(bench[metric]) * TIME_UNIT_TO_NS[bench.get("time_unit", "ns")]
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[name] = value
+        else:
+            iterations.setdefault(name, []).append(value)
+
+    results = {}
+    for name, values in iterations.items():
+        results[name] = medians.get(name, sum(values) / len(values))
+    for name, value in medians.items():
+        results.setdefault(name, value)
+    return results
+
+
+def format_time(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return "{:.2f} {}".format(ns / scale, unit)
+    return "{:.1f} ns".format(ns)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compares two DiligentCoreBenchmark JSON outputs")
+    parser.add_argument("baseline", help="JSON output of the baseline run")
+    parser.add_argument("contender", help="JSON output of the run to compare against the baseline")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="slowdown, in percent, that is reported as a regression (default: 5)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time",
+                        help="time metric to compare (default: cpu_time)")
+    parser.add_argument("--filter", default=None,
+                        help="regular expression that selects the benchmarks to compare")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline, args.metric)
+    contender = load_results(args.contender, args.metric)
+    if args.filter:
+        name_filter = re.compile(args.filter)
+        baseline = {k: v for k, v in baseline.items() if name_filter.search(k)}
+        contender = {k: v for k, v in contender.items() if name_filter.search(k)}
+
+    common = [name for name in baseline if name in contender]
+    name_width = max([len(name) for name in common] + [len("Benchmark")])
+
+    print("{:<{w}}  {:>12}  {:>12}  {:>9}".format("Benchmark", "Baseline", "Contender", "Change", w=name_width))
+    print("-" * (name_width + 41))
+
+    regressions = []
+    for name in common:
+        old, new = baseline[name], contender[name]
+        change = (new - old) / old * 100.0 if old > 0 else 0.0
+        marker = ""
+        if change > args.threshold:
+            marker = "  REGRESSION"
+            regressions.append((name, change))
+        elif change < -args.threshold:
+            marker = "  improvement"
+        print("{:<{w}}  {:>12}  {:>12}  {:>+8.1f}%{}".format(
+            name, format_time(old), format_time(new), change, marker, w=name_width))
+
+    missing = sorted(name for name in baseline if name not in contender)
+    added = sorted(name for name in contender if name not in baseline)
+    if missing:
+        print("\nBenchmarks missing from the contender run:")
+        for name in missing:
+            print("  " + name)
+    if added:
+        print("\nNew benchmarks in the contender run:")
+        for name in added:
+            print("  " + name)
+
+    if regressions:
+        print("\n{} benchmark(s) regressed by more than {:.1f}% ({}):".format(
+            len(regressions), args.threshold, args.metric))
+        for name, change in sorted(regressions, key=lambda r: -r[1]):
+            print("  {} ({:+.1f}%)".format(name, change))
+        return 1
+
+    print("\nNo regressions above {:.1f}% ({}).".format(args.threshold, args.metric))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,256 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Minimal micro-benchmark harness modeled after Google Benchmark.
+///
+/// Benchmarks are registered with DILIGENT_BENCHMARK() and are written the same way as
+/// Google Benchmark functions:
+///
+///     static void BM_Example(BenchmarkState& State)
+///     {
+///         std::vector<int> Data(State.Range(0));
+///         for (auto _ : State)
+///             DoNotOptimize(std::accumulate(Data.begin(), Data.end(), 0));
+///         State.SetItemsProcessed(State.Iterations() * Data.size());
+///     }
+///     DILIGENT_BENCHMARK(BM_Example)->Arg(64)->Arg(4096);
+///
+/// The results are printed as a table, and can also be written in Google Benchmark JSON format,
+/// so that the same tools can be used to compare the runs (see compare_benchmarks.py).
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include <initializer_list>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+/// Prevents the compiler from optimizing away the computation of the value.
+template <typename T>
+inline void DoNotOptimize(const T& Value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile(""
+                 :
+                 : "r,m"(Value)
+                 : "memory");
+#else
+    // Reading the value through a volatile pointer forces it to be materialized
+    const volatile char* pValue = reinterpret_cast<const volatile char*>(&Value);
+    (void)*pValue;
+#endif
+}
+
+/// Forces all pending memory writes to be performed.
+inline void ClobberMemory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile(""
+                 :
+                 :
+                 : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/// The state of a running benchmark.
+class BenchmarkState
+{
+public:
+    BenchmarkState(Uint64 MaxIterations, const std::vector<Int64>& Args) :
+        m_MaxIterations{MaxIterations},
+        m_Args{Args}
+    {}
+
+    struct Iterator
+    {
+        BenchmarkState* pState;
+        Uint64          Remaining;
+
+        bool operator!=(const Iterator&)
+        {
+            if (Remaining != 0)
+                return true;
+            pState->FinishKeepRunning();
+            return false;
+        }
+        void operator++() { --Remaining; }
+        int  operator*() const { return 0; }
+    };
+
+    /// Starts the timer. Used by range-based for loops: for (auto _ : State)
+    Iterator begin()
+    {
+        StartKeepRunning();
+        return Iterator{this, m_MaxIterations};
+    }
+    Iterator end() { return Iterator{this, 0}; }
+
+    /// Returns true while the benchmark needs more iterations.
+    bool KeepRunning()
+    {
+        if (!m_Started)
+            StartKeepRunning();
+        if (m_NumKeepRunningCalls++ < m_MaxIterations)
+            return true;
+        FinishKeepRunning();
+        return false;
+    }
+
+    /// Stops the timer, e.g. to exclude per-iteration setup.
+    void PauseTiming();
+
+    /// Restarts the timer stopped by PauseTiming().
+    void ResumeTiming();
+
+    /// Returns the argument with the given index.
+    Int64 Range(size_t Idx = 0) const { return m_Args[Idx]; }
+
+    /// Returns the number of iterations of the benchmark loop.
+    Uint64 Iterations() const { return m_MaxIterations; }
+
+    void SetItemsProcessed(Int64 Items) { m_ItemsProcessed = Items; }
+    void SetBytesProcessed(Int64 Bytes) { m_BytesProcessed = Bytes; }
+    void SetLabel(const std::string& Label) { m_Label = Label; }
+
+    /// Sets a user counter that is reported with the results, e.g. memory usage.
+    void SetCounter(const std::string& Name, double Value) { m_Counters[Name] = Value; }
+
+    /// Stops the benchmark and reports the error instead of the results.
+    void SkipWithError(const char* Error)
+    {
+        m_Error         = Error;
+        m_MaxIterations = 0;
+    }
+
+private:
+    friend class BenchmarkRunner;
+
+    void StartKeepRunning();
+    void FinishKeepRunning();
+
+    using ClockType = std::chrono::steady_clock;
+
+    Uint64                   m_MaxIterations;
+    Uint64                   m_NumKeepRunningCalls = 0;
+    const std::vector<Int64> m_Args;
+
+    bool                  m_Started = false;
+    bool                  m_Running = false;
+    ClockType::time_point m_RealStart;
+    double                m_CPUStart    = 0;
+    double                m_RealSeconds = 0;
+    double                m_CPUSeconds  = 0;
+
+    Int64                         m_ItemsProcessed = 0;
+    Int64                         m_BytesProcessed = 0;
+    std::string                   m_Label;
+    std::string                   m_Error;
+    std::map<std::string, double> m_Counters;
+};
+
+using BenchmarkFunctionType = void (*)(BenchmarkState&);
+
+/// Registered benchmark. The methods return the pointer to the object, so that they can be chained.
+class RegisteredBenchmark
+{
+public:
+    RegisteredBenchmark(const char* Name, BenchmarkFunctionType Func) :
+        m_Name{Name},
+        m_Func{Func}
+    {}
+
+    /// Runs the benchmark with the argument.
+    RegisteredBenchmark* Arg(Int64 Value)
+    {
+        m_ArgSets.push_back({Value});
+        return this;
+    }
+
+    /// Runs the benchmark with the set of arguments.
+    RegisteredBenchmark* Args(std::initializer_list<Int64> Values)
+    {
+        m_ArgSets.emplace_back(Values);
+        return this;
+    }
+
+    /// Runs the benchmark with the powers of 8 in [Start, Limit], like Google Benchmark's Range().
+    RegisteredBenchmark* Range(Int64 Start, Int64 Limit)
+    {
+        for (Int64 Value = Start; Value < Limit; Value *= 8)
+            Arg(Value);
+        return Arg(Limit);
+    }
+
+    /// Overrides the minimum running time of the benchmark, in seconds.
+    RegisteredBenchmark* MinTime(double Seconds)
+    {
+        m_MinTime = Seconds;
+        return this;
+    }
+
+    const std::string&                     GetName() const { return m_Name; }
+    BenchmarkFunctionType                  GetFunction() const { return m_Func; }
+    const std::vector<std::vector<Int64>>& GetArgSets() const { return m_ArgSets; }
+    double                                 GetMinTime() const { return m_MinTime; }
+
+private:
+    const std::string               m_Name;
+    const BenchmarkFunctionType     m_Func;
+    std::vector<std::vector<Int64>> m_ArgSets;
+    double                          m_MinTime = 0;
+};
+
+/// Adds the benchmark to the global registry.
+RegisteredBenchmark* RegisterBenchmark(const char* Name, BenchmarkFunctionType Func);
+
+/// Runs the benchmarks selected by the command line arguments and returns the process exit code.
+int RunBenchmarks(int argc, char** argv);
+
+} // namespace Benchmark
+
+} // namespace Diligent
+
+#define DILIGENT_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define DILIGENT_BENCHMARK_CONCAT(a, b)      DILIGENT_BENCHMARK_CONCAT_IMPL(a, b)
+
+/// Registers the benchmark function.
+#define DILIGENT_BENCHMARK(Func)                                                                                  \
+    static ::Diligent::Benchmark::RegisteredBenchmark* DILIGENT_BENCHMARK_CONCAT(Func##_Registration, __LINE__) = \
+        ::Diligent::Benchmark::RegisterBenchmark(#Func, Func)
@@ -0,0 +1,583 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#include "DebugUtilities.hpp"
+
+#if PLATFORM_LINUX || PLATFORM_MACOS || PLATFORM_ANDROID || PLATFORM_IOS
+#    include <unistd.h>
+#endif
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+namespace
+{
+
+double GetProcessCPUTime()
+{
+#if defined(CLOCK_PROCESS_CPUTIME_ID)
+    timespec ts;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) == 0)
+        return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+#endif
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+std::vector<std::unique_ptr<RegisteredBenchmark>>& GetRegistry()
+{
+    static std::vector<std::unique_ptr<RegisteredBenchmark>> Registry;
+    return Registry;
+}
+
+struct RunSettings
+{
+    std::string Filter        = ".*";
+    double      MinTime       = 0.5;
+    Uint32      Repetitions   = 1;
+    bool        ListOnly      = false;
+    bool        JSONToConsole = false;
+    std::string OutFile;
+};
+
+struct RunResult
+{
+    std::string Name;
+    std::string RunName;
+    std::string AggregateName; // Empty for iteration runs
+    Uint32      RepetitionIndex = 0;
+    Uint32      NumRepetitions  = 1;
+
+    Uint64 Iterations = 0;
+    double RealTimeNs = 0; // Per iteration
+    double CPUTimeNs  = 0; // Per iteration
+
+    double BytesPerSecond = 0;
+    double ItemsPerSecond = 0;
+
+    std::string                   Label;
+    std::string                   Error;
+    std::map<std::string, double> Counters;
+};
+
+std::string EscapeJSON(const std::string& Str)
+{
+    std::string Escaped;
+    for (auto c : Str)
+    {
+        switch (c)
+        {
+            case '"': Escaped += "\\\""; break;
+            case '\\': Escaped += "\\\\"; break;
+            case '\n': Escaped += "\\n"; break;
+            case '\t': Escaped += "\\t"; break;
+            default: Escaped += c;
+        }
+    }
+    return Escaped;
+}
+
+std::string FormatDouble(double Value)
+{
+    char Buffer[64];
+    snprintf(Buffer, sizeof(Buffer), "%.10g", Value);
+    return Buffer;
+}
+
+std::string FormatRate(double Value, const char* Unit, bool Binary)
+{
+    static const char* Prefixes[] = {"", "k", "M", "G", "T"};
+
+    const double Base = Binary ? 1024.0 : 1000.0;
+
+    size_t Prefix = 0;
+    while (Value >= Base && Prefix + 1 < sizeof(Prefixes) / sizeof(Prefixes[0]))
+    {
+        Value /= Base;
+        ++Prefix;
+    }
+
+    char Buffer[64];
+    snprintf(Buffer, sizeof(Buffer), "%.4g %s%s%s/s", Value, Prefixes[Prefix], (Binary && Prefix > 0 ? "i" : ""), Unit);
+    return Buffer;
+}
+
+} // namespace
+
+
+void BenchmarkState::StartKeepRunning()
+{
+    VERIFY(!m_Started, "The benchmark loop may only be executed once");
+    m_Started = true;
+    ResumeTiming();
+}
+
+void BenchmarkState::FinishKeepRunning()
+{
+    if (m_Running)
+        PauseTiming();
+}
+
+void BenchmarkState::PauseTiming()
+{
+    VERIFY(m_Running, "The timer is not running");
+    m_RealSeconds += std::chrono::duration<double>(ClockType::now() - m_RealStart).count();
+    m_CPUSeconds += GetProcessCPUTime() - m_CPUStart;
+    m_Running = false;
+}
+
+void BenchmarkState::ResumeTiming()
+{
+    VERIFY(!m_Running, "The timer is already running");
+    m_Running   = true;
+    m_CPUStart  = GetProcessCPUTime();
+    m_RealStart = ClockType::now();
+}
+
+
+RegisteredBenchmark* RegisterBenchmark(const char* Name, BenchmarkFunctionType Func)
+{
+    auto& Registry = GetRegistry();
+    Registry.emplace_back(new RegisteredBenchmark{Name, Func});
+    return Registry.back().get();
+}
+
+
+class BenchmarkRunner
+{
+public:
+    explicit BenchmarkRunner(const RunSettings& Settings) :
+        m_Settings{Settings}
+    {}
+
+    // Runs the benchmark with the increasing number of iterations until it takes at least the minimum time.
+    // Like in Google Benchmark, the last run is reported.
+    RunResult Run(const RegisteredBenchmark& Bench, const std::vector<Int64>& Args, const std::string& Name) const
+    {
+        const double MinTime       = Bench.GetMinTime() > 0 ? Bench.GetMinTime() : m_Settings.MinTime;
+        const Uint64 MaxIterations = 1000000000;
+
+        Uint64 Iterations = 1;
+        while (true)
+        {
+            BenchmarkState State{Iterations, Args};
+            Bench.GetFunction()(State);
+
+            RunResult Result;
+            Result.Name       = Name;
+            Result.RunName    = Name;
+            Result.Iterations = Iterations;
+            Result.Error      = State.m_Error;
+            if (!Result.Error.empty())
+                return Result;
+
+            VERIFY(!State.m_Running, "The benchmark loop has not been completed");
+
+            // Use real time to decide if the benchmark ran long enough, as some benchmarks
+            // spend most of the time waiting for other threads
+            const double Seconds = State.m_RealSeconds;
+            if (Seconds >= MinTime || Iterations >= MaxIterations)
+            {
+                Result.RealTimeNs = State.m_RealSeconds * 1e9 / static_cast<double>(Iterations);
+                Result.CPUTimeNs  = State.m_CPUSeconds * 1e9 / static_cast<double>(Iterations);
+                if (State.m_RealSeconds > 0)
+                {
+                    Result.BytesPerSecond = static_cast<double>(State.m_BytesProcessed) / State.m_RealSeconds;
+                    Result.ItemsPerSecond = static_cast<double>(State.m_ItemsProcessed) / State.m_RealSeconds;
+                }
+                Result.Label    = State.m_Label;
+                Result.Counters = State.m_Counters;
+                return Result;
+            }
+
+            // Predict the number of iterations that is needed to reach the minimum time with 40% margin,
+            // but do not grow faster than 10x at a time
+            double Multiplier = Seconds > 0 ? MinTime * 1.4 / Seconds : 10.0;
+            Multiplier        = std::min(std::max(Multiplier, 2.0), 10.0);
+            Iterations        = std::min(static_cast<Uint64>(static_cast<double>(Iterations) * Multiplier), MaxIterations);
+        }
+    }
+
+private:
+    const RunSettings& m_Settings;
+};
+
+
+namespace
+{
+
+std::vector<RunResult> ComputeAggregates(const std::vector<RunResult>& Runs)
+{
+    std::vector<RunResult> Aggregates;
+    if (Runs.size() < 2 || !Runs[0].Error.empty())
+        return Aggregates;
+
+    const auto Aggregate = [&](const char* AggregateName, double (*Reduce)(std::vector<double>)) {
+        RunResult Result;
+        Result.Name           = Runs[0].RunName + "_" + AggregateName;
+        Result.RunName        = Runs[0].RunName;
+        Result.AggregateName  = AggregateName;
+        Result.NumRepetitions = static_cast<Uint32>(Runs.size());
+        Result.Iterations     = Runs.size();
+        Result.Label          = Runs[0].Label;
+
+        const auto Collect = [&](double RunResult::*Member) {
+            std::vector<double> Values;
+            for (const auto& Run : Runs)
+                Values.push_back(Run.*Member);
+            return Reduce(std::move(Values));
+        };
+        Result.RealTimeNs     = Collect(&RunResult::RealTimeNs);
+        Result.CPUTimeNs      = Collect(&RunResult::CPUTimeNs);
+        Result.BytesPerSecond = Collect(&RunResult::BytesPerSecond);
+        Result.ItemsPerSecond = Collect(&RunResult::ItemsPerSecond);
+        for (const auto& Counter : Runs[0].Counters)
+        {
+            std::vector<double> Values;
+            for (const auto& Run : Runs)
+                Values.push_back(Run.Counters.at(Counter.first));
+            Result.Counters[Counter.first] = Reduce(std::move(Values));
+        }
+        Aggregates.emplace_back(std::move(Result));
+    };
+
+    const auto Mean = [](std::vector<double> Values) {
+        return std::accumulate(Values.begin(), Values.end(), 0.0) / static_cast<double>(Values.size());
+    };
+    const auto Median = [](std::vector<double> Values) {
+        std::sort(Values.begin(), Values.end());
+        const auto Mid = Values.size() / 2;
+        return Values.size() % 2 != 0 ? Values[Mid] : (Values[Mid - 1] + Values[Mid]) * 0.5;
+    };
+    const auto StdDev = [](std::vector<double> Values) {
+        const auto MeanValue = std::accumulate(Values.begin(), Values.end(), 0.0) / static_cast<double>(Values.size());
+
+        double SumSq = 0;
+        for (auto Value : Values)
+            SumSq += (Value - MeanValue) * (Value - MeanValue);
+        return std::sqrt(SumSq / static_cast<double>(Values.size() - 1));
+    };
+
+    Aggregate("mean", Mean);
+    Aggregate("median", Median);
+    Aggregate("stddev", StdDev);
+
+    return Aggregates;
+}
+
+void PrintConsoleHeader()
+{
+    printf("%-64s %15s %15s %12s  %s\n", "Benchmark", "Time", "CPU", "Iterations", "UserCounters...");
+    printf("%s\n", std::string(120, '-').c_str());
+}
+
+void PrintConsoleResult(const RunResult& Result)
+{
+    if (!Result.Error.empty())
+    {
+        printf("%-64s ERROR OCCURRED: '%s'\n", Result.Name.c_str(), Result.Error.c_str());
+        return;
+    }
+
+    printf("%-64s %12.1f ns %12.1f ns %12llu", Result.Name.c_str(), Result.RealTimeNs, Result.CPUTimeNs, static_cast<unsigned long long>(Result.Iterations));
+    if (Result.BytesPerSecond > 0)
+        printf("  bytes_per_second=%s", FormatRate(Result.BytesPerSecond, "B", true).c_str());
+    if (Result.ItemsPerSecond > 0)
+        printf("  items_per_second=%s", FormatRate(Result.ItemsPerSecond, "", false).c_str());
+    for (const auto& Counter : Result.Counters)
+        printf("  %s=%.4g", Counter.first.c_str(), Counter.second);
+    if (!Result.Label.empty())
+        printf("  %s", Result.Label.c_str());
+    printf("\n");
+    fflush(stdout);
+}
+
+void WriteJSON(std::ostream& Stream, const std::vector<RunResult>& Results, const char* Executable)
+{
+    char DateStr[64] = {};
+    {
+        const auto Now = std::time(nullptr);
+        std::strftime(DateStr, sizeof(DateStr), "%Y-%m-%dT%H:%M:%S", std::localtime(&Now));
+    }
+
+    std::string HostName = "unknown";
+#if PLATFORM_LINUX || PLATFORM_MACOS || PLATFORM_ANDROID || PLATFORM_IOS
+    {
+        char Buffer[256] = {};
+        if (gethostname(Buffer, sizeof(Buffer) - 1) == 0)
+            HostName = Buffer;
+    }
+#endif
+
+    Stream << "{\n";
+    Stream << "  \"context\": {\n";
+    Stream << "    \"date\": \"" << DateStr << "\",\n";
+    Stream << "    \"host_name\": \"" << EscapeJSON(HostName) << "\",\n";
+    Stream << "    \"executable\": \"" << EscapeJSON(Executable) << "\",\n";
+    Stream << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef DILIGENT_DEBUG
+    Stream << "    \"library_build_type\": \"debug\"\n";
+#else
+    Stream << "    \"library_build_type\": \"release\"\n";
+#endif
+    Stream << "  },\n";
+    Stream << "  \"benchmarks\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        Stream << (i > 0 ? ",\n" : "\n") << "    {\n";
+        Stream << "      \"name\": \"" << EscapeJSON(Result.Name) << "\",\n";
+        Stream << "      \"run_name\": \"" << EscapeJSON(Result.RunName) << "\",\n";
+        if (Result.AggregateName.empty())
+        {
+            Stream << "      \"run_type\": \"iteration\",\n";
+            Stream << "      \"repetitions\": " << Result.NumRepetitions << ",\n";
+            Stream << "      \"repetition_index\": " << Result.RepetitionIndex << ",\n";
+        }
+        else
+        {
+            Stream << "      \"run_type\": \"aggregate\",\n";
+            Stream << "      \"repetitions\": " << Result.NumRepetitions << ",\n";
+            Stream << "      \"aggregate_name\": \"" << Result.AggregateName << "\",\n";
+        }
+        Stream << "      \"threads\": 1,\n";
+        if (!Result.Error.empty())
+        {
+            Stream << "      \"error_occurred\": true,\n";
+            Stream << "      \"error_message\": \"" << EscapeJSON(Result.Error) << "\"\n";
+            Stream << "    }";
+            continue;
+        }
+        Stream << "      \"iterations\": " << Result.Iterations << ",\n";
+        Stream << "      \"real_time\": " << FormatDouble(Result.RealTimeNs) << ",\n";
+        Stream << "      \"cpu_time\": " << FormatDouble(Result.CPUTimeNs) << ",\n";
+        Stream << "      \"time_unit\": \"ns\"";
+        if (Result.BytesPerSecond > 0)
+            Stream << ",\n      \"bytes_per_second\": " << FormatDouble(Result.BytesPerSecond);
+        if (Result.ItemsPerSecond > 0)
+            Stream << ",\n      \"items_per_second\": " << FormatDouble(Result.ItemsPerSecond);
+        for (const auto& Counter : Result.Counters)
+            Stream << ",\n      \"" << EscapeJSON(Counter.first) << "\": " << FormatDouble(Counter.second);
+        if (!Result.Label.empty())
+            Stream << ",\n      \"label\": \"" << EscapeJSON(Result.Label) << "\"";
+        Stream << "\n    }";
+    }
+    Stream << "\n  ]\n}\n";
+}
+
+void PrintUsage(const char* Executable)
+{
+    printf("Usage: %s [options]\n"
+           "  --benchmark_filter=<regex>       Run the benchmarks whose names match the regular expression\n"
+           "  --benchmark_min_time=<seconds>   Minimum running time of every benchmark (default: 0.5)\n"
+           "  --benchmark_repetitions=<n>      Run every benchmark n times and report mean, median and stddev\n"
+           "  --benchmark_format=<console|json> Output format of the standard output (default: console)\n"
+           "  --benchmark_out=<file>           Write the results in JSON format to the file\n"
+           "  --benchmark_list_tests           List the benchmarks without running them\n",
+           Executable);
+}
+
+bool ParseArgs(int argc, char** argv, RunSettings& Settings)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string Arg = argv[i];
+
+        const auto GetValue = [&](const char* Option, std::string& Value) {
+            const auto Len = strlen(Option);
+            if (Arg.compare(0, Len, Option) == 0 && Arg.length() > Len && Arg[Len] == '=')
+            {
+                Value = Arg.substr(Len + 1);
+                return true;
+            }
+            return false;
+        };
+
+        std::string Value;
+        if (GetValue("--benchmark_filter", Value))
+            Settings.Filter = Value;
+        else if (GetValue("--benchmark_min_time", Value))
+            Settings.MinTime = std::max(atof(Value.c_str()), 0.0);
+        else if (GetValue("--benchmark_repetitions", Value))
+            Settings.Repetitions = static_cast<Uint32>(std::max(atoi(Value.c_str()), 1));
+        else if (GetValue("--benchmark_format", Value))
+            Settings.JSONToConsole = Value == "json";
+        else if (GetValue("--benchmark_out", Value))
+            Settings.OutFile = Value;
+        else if (GetValue("--benchmark_out_format", Value))
+        {
+            if (Value != "json")
+                printf("Only JSON output format is supported for output files\n");
+        }
+        else if (Arg == "--benchmark_list_tests" || Arg == "--benchmark_list_tests=true")
+            Settings.ListOnly = true;
+        else
+        {
+            PrintUsage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string GetRunName(const RegisteredBenchmark& Bench, const std::vector<Int64>& Args)
+{
+    std::stringstream ss;
+    ss << Bench.GetName();
+    for (auto Arg : Args)
+        ss << '/' << Arg;
+    return ss.str();
+}
+
+} // namespace
+
+
+int RunBenchmarks(int argc, char** argv)
+{
+    RunSettings Settings;
+    if (!ParseArgs(argc, argv, Settings))
+        return 1;
+
+    std::regex Filter;
+    try
+    {
+        Filter = std::regex{Settings.Filter};
+    }
+    catch (const std::regex_error& err)
+    {
+        printf("Invalid benchmark filter '%s': %s\n", Settings.Filter.c_str(), err.what());
+        return 1;
+    }
+
+    struct Instance
+    {
+        const RegisteredBenchmark* pBench;
+        std::vector<Int64>         Args;
+        std::string                Name;
+    };
+    std::vector<Instance> Instances;
+    for (const auto& pBench : GetRegistry())
+    {
+        auto ArgSets = pBench->GetArgSets();
+        if (ArgSets.empty())
+            ArgSets.emplace_back();
+        for (const auto& Args : ArgSets)
+        {
+            auto Name = GetRunName(*pBench, Args);
+            if (std::regex_search(Name, Filter))
+                Instances.push_back({pBench.get(), Args, std::move(Name)});
+        }
+    }
+
+    if (Settings.ListOnly)
+    {
+        for (const auto& Inst : Instances)
+            printf("%s\n", Inst.Name.c_str());
+        return 0;
+    }
+
+    if (Instances.empty())
+    {
+        printf("No benchmarks match the filter '%s'\n", Settings.Filter.c_str());
+        return 1;
+    }
+
+    if (!Settings.JSONToConsole)
+    {
+#ifdef DILIGENT_DEBUG
+        printf("***WARNING*** The benchmarks are built in debug configuration, timings may not be representative\n");
+#endif
+        PrintConsoleHeader();
+    }
+
+    BenchmarkRunner        Runner{Settings};
+    std::vector<RunResult> AllResults;
+    bool                   ErrorOccurred = false;
+    for (const auto& Inst : Instances)
+    {
+        std::vector<RunResult> Runs;
+        for (Uint32 rep = 0; rep < Settings.Repetitions; ++rep)
+        {
+            auto Result            = Runner.Run(*Inst.pBench, Inst.Args, Inst.Name);
+            Result.RepetitionIndex = rep;
+            Result.NumRepetitions  = Settings.Repetitions;
+            ErrorOccurred          = ErrorOccurred || !Result.Error.empty();
+            if (!Settings.JSONToConsole)
+                PrintConsoleResult(Result);
+            Runs.emplace_back(std::move(Result));
+            if (!Runs.back().Error.empty())
+                break;
+        }
+
+        auto Aggregates = ComputeAggregates(Runs);
+        if (!Settings.JSONToConsole)
+        {
+            for (const auto& Aggregate : Aggregates)
+                PrintConsoleResult(Aggregate);
+        }
+
+        AllResults.insert(AllResults.end(), Runs.begin(), Runs.end());
+        AllResults.insert(AllResults.end(), Aggregates.begin(), Aggregates.end());
+    }
+
+    if (Settings.JSONToConsole)
+        WriteJSON(std::cout, AllResults, argv[0]);
+
+    if (!Settings.OutFile.empty())
+    {
+        std::ofstream OutFile{Settings.OutFile};
+        if (!OutFile)
+        {
+            printf("Failed to open output file '%s'\n", Settings.OutFile.c_str());
+            return 1;
+        }
+        WriteJSON(OutFile, AllResults, argv[0]);
+    }
+
+    return ErrorOccurred ? 1 : 0;
+}
+
+} // namespace Benchmark
+
+} // namespace Diligent
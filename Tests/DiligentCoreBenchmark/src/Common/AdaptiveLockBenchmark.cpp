@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AdaptiveLock.hpp"
+#include "LockHelper.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+using namespace ThreadingTools;
+
+namespace
+{
+
+class LockHelperAdapter
+{
+public:
+    void Lock() { LockHelper::UnsafeLock(m_Flag); }
+    void Unlock() { LockHelper::UnsafeUnlock(m_Flag); }
+
+private:
+    LockFlag m_Flag;
+};
+
+class StdMutexAdapter
+{
+public:
+    void Lock() { m_Mutex.lock(); }
+    void Unlock() { m_Mutex.unlock(); }
+
+private:
+    std::mutex m_Mutex;
+};
+
+// Every lock protects a short critical section that increments a shared counter.
+// When State.Range(0) is non-zero, the specified number of background threads
+// keep acquiring the same lock while the main thread is measured.
+template <typename LockType>
+void RunLockBenchmark(BenchmarkState& State)
+{
+    LockType Lock;
+    Uint64   Counter = 0;
+
+    std::atomic<bool>        Stop{false};
+    std::vector<std::thread> Threads;
+    for (Int64 t = 0; t < State.Range(0); ++t)
+    {
+        Threads.emplace_back([&]() {
+            while (!Stop.load(std::memory_order_relaxed))
+            {
+                Lock.Lock();
+                ++Counter;
+                Lock.Unlock();
+
+                // Work outside of the critical section, so that the threads do not monopolize the lock
+                for (int i = 0; i < 64; ++i)
+                    ClobberMemory();
+            }
+        });
+    }
+
+    for (auto _ : State)
+    {
+        Lock.Lock();
+        ++Counter;
+        Lock.Unlock();
+    }
+
+    Stop.store(true);
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    DoNotOptimize(Counter);
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations()));
+}
+
+void Common_AdaptiveLock_LockUnlock(BenchmarkState& State)
+{
+    RunLockBenchmark<AdaptiveLock>(State);
+}
+DILIGENT_BENCHMARK(Common_AdaptiveLock_LockUnlock)->Arg(0)->Arg(3);
+
+void Common_LockHelper_LockUnlock(BenchmarkState& State)
+{
+    RunLockBenchmark<LockHelperAdapter>(State);
+}
+DILIGENT_BENCHMARK(Common_LockHelper_LockUnlock)->Arg(0)->Arg(3);
+
+void Common_StdMutex_LockUnlock(BenchmarkState& State)
+{
+    RunLockBenchmark<StdMutexAdapter>(State);
+}
+DILIGENT_BENCHMARK(Common_StdMutex_LockUnlock)->Arg(0)->Arg(3);
+
+void Common_AdaptiveRWLock_LockShared(BenchmarkState& State)
+{
+    AdaptiveRWLock Lock;
+    Uint64         Counter = 0;
+    for (auto _ : State)
+    {
+        Lock.LockShared();
+        DoNotOptimize(Counter);
+        Lock.UnlockShared();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations()));
+}
+DILIGENT_BENCHMARK(Common_AdaptiveRWLock_LockShared);
+
+} // namespace
@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "FixedBlockMemoryAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+constexpr size_t NumAllocations = 1024;
+
+void Common_FixedBlockMemoryAllocator_AllocateFree(BenchmarkState& State)
+{
+    const auto BlockSize = static_cast<size_t>(State.Range(0));
+
+    FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), BlockSize, 256};
+    std::vector<void*>        Blocks(NumAllocations);
+    for (auto _ : State)
+    {
+        for (auto& pBlock : Blocks)
+            pBlock = Allocator.Allocate(BlockSize, "Benchmark", __FILE__, __LINE__);
+        DoNotOptimize(Blocks.data());
+        for (auto* pBlock : Blocks)
+            Allocator.Free(pBlock);
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumAllocations));
+}
+DILIGENT_BENCHMARK(Common_FixedBlockMemoryAllocator_AllocateFree)->Arg(16)->Arg(64)->Arg(256);
+
+// Frees the blocks in random order, which scatters the free lists across the pages
+void Common_FixedBlockMemoryAllocator_RandomFree(BenchmarkState& State)
+{
+    const auto BlockSize = static_cast<size_t>(State.Range(0));
+
+    FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), BlockSize, 256};
+    std::vector<void*>        Blocks(NumAllocations);
+    std::mt19937              Rnd{0};
+    for (auto _ : State)
+    {
+        for (auto& pBlock : Blocks)
+            pBlock = Allocator.Allocate(BlockSize, "Benchmark", __FILE__, __LINE__);
+        std::shuffle(Blocks.begin(), Blocks.end(), Rnd);
+        for (auto* pBlock : Blocks)
+            Allocator.Free(pBlock);
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumAllocations));
+}
+DILIGENT_BENCHMARK(Common_FixedBlockMemoryAllocator_RandomFree)->Arg(64);
+
+// Baseline for FixedBlockMemoryAllocator
+void Common_DefaultRawMemoryAllocator_AllocateFree(BenchmarkState& State)
+{
+    const auto BlockSize = static_cast<size_t>(State.Range(0));
+
+    auto&              Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    std::vector<void*> Blocks(NumAllocations);
+    for (auto _ : State)
+    {
+        for (auto& pBlock : Blocks)
+            pBlock = Allocator.Allocate(BlockSize, "Benchmark", __FILE__, __LINE__);
+        DoNotOptimize(Blocks.data());
+        for (auto* pBlock : Blocks)
+            Allocator.Free(pBlock);
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumAllocations));
+}
+DILIGENT_BENCHMARK(Common_DefaultRawMemoryAllocator_AllocateFree)->Arg(16)->Arg(64)->Arg(256);
+
+} // namespace
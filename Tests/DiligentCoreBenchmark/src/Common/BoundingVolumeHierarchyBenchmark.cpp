@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <random>
+#include <cfloat>
+
+#include "BoundingVolumeHierarchy.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+void MakeFrustum(ViewFrustum& Frustum)
+{
+    const auto View = float4x4::Translation(0, 0, 50);
+    const auto Proj = float4x4::Projection(PI_F / 4.f, 1.5f, 1.f, 200.f, false);
+    ExtractViewFrustumPlanesFromMatrix(View * Proj, Frustum, false);
+}
+
+std::vector<BoundBox> MakeBoxes(size_t NumBoxes)
+{
+    std::mt19937                          Rnd{0};
+    std::uniform_real_distribution<float> Pos{-150.f, 150.f};
+    std::uniform_real_distribution<float> Size{0.5f, 5.f};
+
+    std::vector<BoundBox> Boxes(NumBoxes);
+    for (auto& Box : Boxes)
+    {
+        Box.Min = float3{Pos(Rnd), Pos(Rnd), Pos(Rnd)};
+        Box.Max = Box.Min + float3{Size(Rnd), Size(Rnd), Size(Rnd)};
+    }
+    return Boxes;
+}
+
+// Random triangle soup with a triangle inside every box
+void MakeTriangles(const std::vector<BoundBox>& Boxes, std::vector<float3>& Vertices, std::vector<Uint32>& Indices, std::vector<BoundBox>& TriBoxes)
+{
+    for (const auto& Box : Boxes)
+    {
+        const auto BaseVert = static_cast<Uint32>(Vertices.size());
+        const auto V0       = Box.Min;
+        const auto V1       = float3{Box.Max.x, Box.Min.y, Box.Max.z};
+        const auto V2       = float3{Box.Min.x, Box.Max.y, Box.Max.z};
+        Vertices.push_back(V0);
+        Vertices.push_back(V1);
+        Vertices.push_back(V2);
+        Indices.push_back(BaseVert + 0);
+        Indices.push_back(BaseVert + 1);
+        Indices.push_back(BaseVert + 2);
+
+        BoundBox TriBox;
+        TriBox.Min = min(min(V0, V1), V2);
+        TriBox.Max = max(max(V0, V1), V2);
+        TriBoxes.push_back(TriBox);
+    }
+}
+
+std::vector<float3> MakeRayDirections(size_t NumRays)
+{
+    std::mt19937                          Rnd{1};
+    std::uniform_real_distribution<float> Distr{-1.f, 1.f};
+
+    std::vector<float3> Dirs(NumRays);
+    for (auto& Dir : Dirs)
+        Dir = normalize(float3{Distr(Rnd), Distr(Rnd), Distr(Rnd)} + float3{0, 0, 0.01f});
+    return Dirs;
+}
+
+void Common_BVH_Build(BenchmarkState& State)
+{
+    const auto              Boxes = MakeBoxes(static_cast<size_t>(State.Range(0)));
+    BoundingVolumeHierarchy BVH;
+    for (auto _ : State)
+    {
+        BVH.Build(Boxes.data(), static_cast<Uint32>(Boxes.size()));
+        DoNotOptimize(BVH.GetNodes().data());
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Boxes.size()));
+}
+DILIGENT_BENCHMARK(Common_BVH_Build)->Arg(16384);
+
+void Common_BVH_QueryFrustum(BenchmarkState& State)
+{
+    const auto              Boxes = MakeBoxes(static_cast<size_t>(State.Range(0)));
+    BoundingVolumeHierarchy BVH;
+    BVH.Build(Boxes.data(), static_cast<Uint32>(Boxes.size()));
+
+    ViewFrustum Frustum;
+    MakeFrustum(Frustum);
+
+    std::vector<Uint32> Visible;
+    Visible.reserve(Boxes.size());
+    for (auto _ : State)
+    {
+        Visible.clear();
+        BVH.GetVisiblePrimitives(Frustum, Visible);
+        DoNotOptimize(Visible.data());
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Boxes.size()));
+    State.SetCounter("Visible", static_cast<double>(Visible.size()));
+}
+DILIGENT_BENCHMARK(Common_BVH_QueryFrustum)->Arg(16384)->Arg(262144);
+
+void Common_BVH_QueryFrustumBruteForce(BenchmarkState& State)
+{
+    const auto Boxes = MakeBoxes(static_cast<size_t>(State.Range(0)));
+
+    ViewFrustum Frustum;
+    MakeFrustum(Frustum);
+
+    std::vector<Uint32> Visible;
+    Visible.reserve(Boxes.size());
+    for (auto _ : State)
+    {
+        Visible.clear();
+        for (Uint32 i = 0; i < Boxes.size(); ++i)
+        {
+            if (GetBoxVisibility(Frustum, Boxes[i]) != BoxVisibility::Invisible)
+                Visible.push_back(i);
+        }
+        DoNotOptimize(Visible.data());
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Boxes.size()));
+    State.SetCounter("Visible", static_cast<double>(Visible.size()));
+}
+DILIGENT_BENCHMARK(Common_BVH_QueryFrustumBruteForce)->Arg(16384)->Arg(262144);
+
+void Common_BVH_IntersectRayTriangles(BenchmarkState& State)
+{
+    std::vector<float3>   Vertices;
+    std::vector<Uint32>   Indices;
+    std::vector<BoundBox> TriBoxes;
+    MakeTriangles(MakeBoxes(static_cast<size_t>(State.Range(0))), Vertices, Indices, TriBoxes);
+
+    BoundingVolumeHierarchy BVH;
+    BVH.Build(TriBoxes.data(), static_cast<Uint32>(TriBoxes.size()));
+
+    const auto Dirs = MakeRayDirections(256);
+    for (auto _ : State)
+    {
+        for (const auto& Dir : Dirs)
+        {
+            float  HitDist = 0;
+            Uint32 HitTri  = 0;
+            DoNotOptimize(BVH.IntersectRayTriangles(float3{0, 0, 0}, Dir, Vertices.data(), Indices.data(), HitDist, HitTri));
+            DoNotOptimize(HitTri);
+        }
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Dirs.size()));
+}
+DILIGENT_BENCHMARK(Common_BVH_IntersectRayTriangles)->Arg(16384);
+
+void Common_BVH_IntersectRayTrianglesBruteForce(BenchmarkState& State)
+{
+    std::vector<float3>   Vertices;
+    std::vector<Uint32>   Indices;
+    std::vector<BoundBox> TriBoxes;
+    MakeTriangles(MakeBoxes(static_cast<size_t>(State.Range(0))), Vertices, Indices, TriBoxes);
+
+    const auto Dirs = MakeRayDirections(256);
+    for (auto _ : State)
+    {
+        for (const auto& Dir : Dirs)
+        {
+            float  HitDist = FLT_MAX;
+            Uint32 HitTri  = BoundingVolumeHierarchy::InvalidIndex;
+            for (Uint32 t = 0; t < TriBoxes.size(); ++t)
+            {
+                const auto Dist = IntersectRayTriangle(Vertices[Indices[t * 3 + 0]], Vertices[Indices[t * 3 + 1]], Vertices[Indices[t * 3 + 2]], float3{0, 0, 0}, Dir);
+                if (Dist >= 0 && Dist < HitDist)
+                {
+                    HitDist = Dist;
+                    HitTri  = t;
+                }
+            }
+            DoNotOptimize(HitTri);
+        }
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Dirs.size()));
+}
+DILIGENT_BENCHMARK(Common_BVH_IntersectRayTrianglesBruteForce)->Arg(16384);
+
+} // namespace
@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "MappedFileStream.hpp"
+#include "BasicFileStream.hpp"
+#include "AsyncFileReader.hpp"
+#include "FileWrapper.hpp"
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Creates a set of files in the working directory and deletes them when destroyed.
+// Note that the files are likely to stay in the OS page cache, so the benchmarks
+// measure the read path overhead rather than the storage throughput.
+class TestFileSet
+{
+public:
+    TestFileSet(Uint32 NumFiles, size_t FileSize) :
+        m_FileSize{FileSize}
+    {
+        std::vector<Uint8> Data(FileSize);
+        for (size_t i = 0; i < FileSize; ++i)
+            Data[i] = static_cast<Uint8>(i * 31);
+
+        for (Uint32 i = 0; i < NumFiles; ++i)
+        {
+            m_Paths.emplace_back("FileStreamBenchmark" + std::to_string(i) + ".bin");
+            FileWrapper File{m_Paths.back().c_str(), EFileAccessMode::Overwrite};
+            if (File != nullptr)
+                File->Write(Data.data(), Data.size());
+        }
+        for (const auto& Path : m_Paths)
+            m_PathPtrs.push_back(Path.c_str());
+    }
+
+    ~TestFileSet()
+    {
+        for (const auto& Path : m_Paths)
+            FileSystem::DeleteFile(Path.c_str());
+    }
+
+    Uint32       GetNumFiles() const { return static_cast<Uint32>(m_Paths.size()); }
+    const Char*  GetPath(Uint32 i) const { return m_PathPtrs[i]; }
+    const Char** GetPaths() { return m_PathPtrs.data(); }
+    Int64        GetTotalSize() const { return static_cast<Int64>(m_FileSize * m_Paths.size()); }
+
+private:
+    const size_t             m_FileSize;
+    std::vector<std::string> m_Paths;
+    std::vector<const Char*> m_PathPtrs;
+};
+
+void Common_FileStream_BasicFileStreamReadBlob(BenchmarkState& State)
+{
+    TestFileSet Files{16, static_cast<size_t>(State.Range(0)) << 10};
+    for (auto _ : State)
+    {
+        for (Uint32 i = 0; i < Files.GetNumFiles(); ++i)
+        {
+            RefCntAutoPtr<BasicFileStream> pStream{MakeNewRCObj<BasicFileStream>()(Files.GetPath(i), EFileAccessMode::Read)};
+            RefCntAutoPtr<DataBlobImpl>    pData{MakeNewRCObj<DataBlobImpl>()(0)};
+            pStream->ReadBlob(pData);
+            DoNotOptimize(pData->GetDataPtr());
+        }
+    }
+    State.SetBytesProcessed(static_cast<Int64>(State.Iterations()) * Files.GetTotalSize());
+}
+DILIGENT_BENCHMARK(Common_FileStream_BasicFileStreamReadBlob)->Arg(64)->Arg(4096);
+
+void Common_FileStream_MappedFileStream(BenchmarkState& State)
+{
+    TestFileSet Files{16, static_cast<size_t>(State.Range(0)) << 10};
+    for (auto _ : State)
+    {
+        for (Uint32 i = 0; i < Files.GetNumFiles(); ++i)
+        {
+            RefCntAutoPtr<MappedFileStream> pStream{MakeNewRCObj<MappedFileStream>()(Files.GetPath(i))};
+
+            // Touch every page so that the cost of page faults is included
+            auto* pData = pStream->GetDataBlob();
+            if (pData == nullptr)
+                continue;
+            const auto* pBytes = static_cast<const Uint8*>(pData->GetDataPtr());
+            Uint32      Sum    = 0;
+            for (size_t Offset = 0; Offset < pData->GetSize(); Offset += 4096)
+                Sum += pBytes[Offset];
+            DoNotOptimize(Sum);
+        }
+    }
+    State.SetBytesProcessed(static_cast<Int64>(State.Iterations()) * Files.GetTotalSize());
+}
+DILIGENT_BENCHMARK(Common_FileStream_MappedFileStream)->Arg(64)->Arg(4096);
+
+void Common_FileStream_FileWrapperSequential(BenchmarkState& State)
+{
+    TestFileSet        Files{64, static_cast<size_t>(State.Range(0)) << 10};
+    std::vector<Uint8> Buffer(static_cast<size_t>(State.Range(0)) << 10);
+    for (auto _ : State)
+    {
+        for (Uint32 i = 0; i < Files.GetNumFiles(); ++i)
+        {
+            FileWrapper File{Files.GetPath(i), EFileAccessMode::Read};
+            if (File != nullptr)
+                File->Read(Buffer.data(), Buffer.size());
+            DoNotOptimize(Buffer.data());
+        }
+    }
+    State.SetBytesProcessed(static_cast<Int64>(State.Iterations()) * Files.GetTotalSize());
+}
+DILIGENT_BENCHMARK(Common_FileStream_FileWrapperSequential)->Arg(64);
+
+void RunAsyncFileReaderBenchmark(BenchmarkState& State, bool UseIOUring)
+{
+    AsyncFileReaderCreateInfo CI;
+    CI.UseIOUring = UseIOUring;
+    AsyncFileReader Reader{CI};
+    if (UseIOUring && !Reader.IsUsingIOUring())
+    {
+        State.SkipWithError("io_uring is not available");
+        return;
+    }
+
+    TestFileSet         Files{64, static_cast<size_t>(State.Range(0)) << 10};
+    std::atomic<Uint32> NumRead{0};
+    for (auto _ : State)
+    {
+        Reader.ReadFiles(Files.GetPaths(), Files.GetNumFiles(),
+                         [&](Uint32 FileIndex, const Char* Path, IDataBlob* pData) {
+                             if (pData != nullptr)
+                                 NumRead.fetch_add(1);
+                         });
+        Reader.WaitIdle();
+    }
+    DoNotOptimize(NumRead);
+    State.SetBytesProcessed(static_cast<Int64>(State.Iterations()) * Files.GetTotalSize());
+}
+
+void Common_FileStream_AsyncFileReaderIOUring(BenchmarkState& State)
+{
+    RunAsyncFileReaderBenchmark(State, true);
+}
+DILIGENT_BENCHMARK(Common_FileStream_AsyncFileReaderIOUring)->Arg(64);
+
+void Common_FileStream_AsyncFileReaderThreadPool(BenchmarkState& State)
+{
+    RunAsyncFileReaderBenchmark(State, false);
+}
+DILIGENT_BENCHMARK(Common_FileStream_AsyncFileReaderThreadPool)->Arg(64);
+
+} // namespace
@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "HashUtils.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+std::vector<std::string> MakeNames(size_t NumNames, size_t Length)
+{
+    std::vector<std::string> Names(NumNames);
+    for (size_t i = 0; i < NumNames; ++i)
+    {
+        auto& Name = Names[i];
+        Name       = "g_Resource" + std::to_string(i) + "_";
+        while (Name.length() < Length)
+            Name += static_cast<char>('a' + (Name.length() * 7 + i) % 26);
+    }
+    return Names;
+}
+
+void Common_HashUtils_CStringHash(BenchmarkState& State)
+{
+    const auto Names = MakeNames(256, static_cast<size_t>(State.Range(0)));
+
+    size_t Bytes = 0;
+    for (const auto& Name : Names)
+        Bytes += Name.length();
+
+    CStringHash<Char> Hasher;
+    for (auto _ : State)
+    {
+        for (const auto& Name : Names)
+            DoNotOptimize(Hasher(Name.c_str()));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Names.size()));
+    State.SetBytesProcessed(static_cast<Int64>(State.Iterations() * Bytes));
+}
+DILIGENT_BENCHMARK(Common_HashUtils_CStringHash)->Arg(8)->Arg(32)->Arg(128);
+
+void Common_HashUtils_ComputeHash(BenchmarkState& State)
+{
+    struct Desc
+    {
+        Uint32 Width;
+        Uint32 Height;
+        float  Bias;
+        Uint8  Format;
+        bool   Flag;
+    };
+    std::vector<Desc> Descs(256);
+    for (size_t i = 0; i < Descs.size(); ++i)
+        Descs[i] = Desc{static_cast<Uint32>(i), static_cast<Uint32>(i * 3), static_cast<float>(i) * 0.5f, static_cast<Uint8>(i), i % 2 == 0};
+
+    for (auto _ : State)
+    {
+        for (const auto& d : Descs)
+            DoNotOptimize(ComputeHash(d.Width, d.Height, d.Bias, d.Format, d.Flag));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Descs.size()));
+}
+DILIGENT_BENCHMARK(Common_HashUtils_ComputeHash);
+
+// Looks up raw string pointers in a hash map with HashMapStringKey keys, which avoids string copies
+void Common_HashUtils_HashMapStringKeyLookup(BenchmarkState& State)
+{
+    const auto Names = MakeNames(static_cast<size_t>(State.Range(0)), 24);
+
+    std::unordered_map<HashMapStringKey, size_t, HashMapStringKey::Hasher> Map;
+    for (size_t i = 0; i < Names.size(); ++i)
+        Map.emplace(HashMapStringKey{Names[i].c_str(), true}, i);
+
+    // Use different string pointers to force string comparison
+    const auto Queries = Names;
+    for (auto _ : State)
+    {
+        for (const auto& Query : Queries)
+            DoNotOptimize(Map.find(Query.c_str()));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Queries.size()));
+}
+DILIGENT_BENCHMARK(Common_HashUtils_HashMapStringKeyLookup)->Arg(64)->Arg(4096);
+
+// Baseline for HashMapStringKey: every lookup constructs std::string from the raw pointer
+void Common_HashUtils_StdStringLookup(BenchmarkState& State)
+{
+    const auto Names = MakeNames(static_cast<size_t>(State.Range(0)), 24);
+
+    std::unordered_map<std::string, size_t> Map;
+    for (size_t i = 0; i < Names.size(); ++i)
+        Map.emplace(Names[i], i);
+
+    const auto Queries = Names;
+    for (auto _ : State)
+    {
+        for (const auto& Query : Queries)
+            DoNotOptimize(Map.find(Query.c_str()));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Queries.size()));
+}
+DILIGENT_BENCHMARK(Common_HashUtils_StdStringLookup)->Arg(64)->Arg(4096);
+
+} // namespace
@@ -0,0 +1,287 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <random>
+
+#include "BasicMath.hpp"
+#include "AdvancedMath.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+float4x4 MakeMatrix(std::mt19937& Rnd)
+{
+    std::uniform_real_distribution<float> Distr{-1.f, 1.f};
+    const auto                            Scale = 1.f + Distr(Rnd) * 0.5f;
+    return float4x4::RotationY(Distr(Rnd) * PI_F) *
+        float4x4::Scale(Scale, Scale, Scale) *
+        float4x4::Translation(Distr(Rnd) * 10.f, Distr(Rnd) * 10.f, Distr(Rnd) * 10.f);
+}
+
+// Reference implementation that does not use SIMD
+float4 TransformScalar(const float4& v, const float4x4& m)
+{
+    return float4{
+        v.x * m._11 + v.y * m._21 + v.z * m._31 + v.w * m._41,
+        v.x * m._12 + v.y * m._22 + v.z * m._32 + v.w * m._42,
+        v.x * m._13 + v.y * m._23 + v.z * m._33 + v.w * m._43,
+        v.x * m._14 + v.y * m._24 + v.z * m._34 + v.w * m._44};
+}
+
+void Common_BasicMath_MatrixMul(BenchmarkState& State)
+{
+    std::mt19937          Rnd{0};
+    std::vector<float4x4> Matrices(256);
+    for (auto& m : Matrices)
+        m = MakeMatrix(Rnd);
+
+    for (auto _ : State)
+    {
+        float4x4 Result = float4x4::Identity();
+        for (const auto& m : Matrices)
+            Result = Result * m;
+        DoNotOptimize(Result);
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Matrices.size()));
+}
+DILIGENT_BENCHMARK(Common_BasicMath_MatrixMul);
+
+void Common_BasicMath_MultiplyMatrices(BenchmarkState& State)
+{
+    std::mt19937          Rnd{0};
+    std::vector<float4x4> LHS(256), RHS(256), Dst(256);
+    for (size_t i = 0; i < LHS.size(); ++i)
+    {
+        LHS[i] = MakeMatrix(Rnd);
+        RHS[i] = MakeMatrix(Rnd);
+    }
+
+    for (auto _ : State)
+    {
+        MultiplyMatrices(LHS.data(), RHS.data(), Dst.data(), Dst.size());
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Dst.size()));
+}
+DILIGENT_BENCHMARK(Common_BasicMath_MultiplyMatrices);
+
+void Common_BasicMath_MatrixInverse(BenchmarkState& State)
+{
+    std::mt19937          Rnd{0};
+    std::vector<float4x4> Matrices(256);
+    for (auto& m : Matrices)
+        m = MakeMatrix(Rnd);
+
+    for (auto _ : State)
+    {
+        for (const auto& m : Matrices)
+            DoNotOptimize(m.Inverse());
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Matrices.size()));
+}
+DILIGENT_BENCHMARK(Common_BasicMath_MatrixInverse);
+
+void Common_BasicMath_TransformVectors(BenchmarkState& State)
+{
+    std::mt19937        Rnd{0};
+    const auto          m = MakeMatrix(Rnd);
+    std::vector<float4> Src(static_cast<size_t>(State.Range(0))), Dst(Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = float4{static_cast<float>(i), 1.f, -static_cast<float>(i), 1.f};
+
+    for (auto _ : State)
+    {
+        TransformVectors(Src.data(), Dst.data(), Src.size(), m);
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Src.size()));
+}
+DILIGENT_BENCHMARK(Common_BasicMath_TransformVectors)->Arg(1024)->Arg(65536);
+
+void Common_BasicMath_TransformVectorsOperator(BenchmarkState& State)
+{
+    std::mt19937        Rnd{0};
+    const auto          m = MakeMatrix(Rnd);
+    std::vector<float4> Src(static_cast<size_t>(State.Range(0))), Dst(Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = float4{static_cast<float>(i), 1.f, -static_cast<float>(i), 1.f};
+
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < Src.size(); ++i)
+            Dst[i] = Src[i] * m;
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Src.size()));
+}
+DILIGENT_BENCHMARK(Common_BasicMath_TransformVectorsOperator)->Arg(1024)->Arg(65536);
+
+void Common_BasicMath_TransformVectorsScalar(BenchmarkState& State)
+{
+    std::mt19937        Rnd{0};
+    const auto          m = MakeMatrix(Rnd);
+    std::vector<float4> Src(static_cast<size_t>(State.Range(0))), Dst(Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = float4{static_cast<float>(i), 1.f, -static_cast<float>(i), 1.f};
+
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < Src.size(); ++i)
+            Dst[i] = TransformScalar(Src[i], m);
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Src.size()));
+}
+DILIGENT_BENCHMARK(Common_BasicMath_TransformVectorsScalar)->Arg(1024)->Arg(65536);
+
+void Common_BasicMath_TransformPoints(BenchmarkState& State)
+{
+    std::mt19937        Rnd{0};
+    const auto          m = float4x4::Projection(PI_F / 4.f, 1.5f, 0.1f, 100.f, false) * MakeMatrix(Rnd);
+    std::vector<float3> Src(static_cast<size_t>(State.Range(0))), Dst(Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = float3{static_cast<float>(i % 17), static_cast<float>(i % 5), 1.f + static_cast<float>(i % 31)};
+
+    for (auto _ : State)
+    {
+        TransformPoints(Src.data(), Dst.data(), Src.size(), m);
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Src.size()));
+}
+DILIGENT_BENCHMARK(Common_BasicMath_TransformPoints)->Arg(65536);
+
+void Common_BasicMath_TransformPointsOperator(BenchmarkState& State)
+{
+    std::mt19937        Rnd{0};
+    const auto          m = float4x4::Projection(PI_F / 4.f, 1.5f, 0.1f, 100.f, false) * MakeMatrix(Rnd);
+    std::vector<float3> Src(static_cast<size_t>(State.Range(0))), Dst(Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = float3{static_cast<float>(i % 17), static_cast<float>(i % 5), 1.f + static_cast<float>(i % 31)};
+
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < Src.size(); ++i)
+            Dst[i] = Src[i] * m;
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Src.size()));
+}
+DILIGENT_BENCHMARK(Common_BasicMath_TransformPointsOperator)->Arg(65536);
+
+
+struct CullingScene
+{
+    ViewFrustum           Frustum;
+    std::vector<BoundBox> Boxes;
+
+    // Structure-of-arrays copy of the boxes
+    std::vector<float> MinX, MinY, MinZ, MaxX, MaxY, MaxZ;
+
+    explicit CullingScene(size_t NumBoxes)
+    {
+        const auto View = float4x4::Translation(0, 0, 50);
+        const auto Proj = float4x4::Projection(PI_F / 4.f, 1.5f, 1.f, 200.f, false);
+        ExtractViewFrustumPlanesFromMatrix(View * Proj, Frustum, false);
+
+        std::mt19937                          Rnd{0};
+        std::uniform_real_distribution<float> Pos{-150.f, 150.f};
+        std::uniform_real_distribution<float> Size{0.5f, 5.f};
+        Boxes.resize(NumBoxes);
+        for (auto& Box : Boxes)
+        {
+            Box.Min = float3{Pos(Rnd), Pos(Rnd), Pos(Rnd)};
+            Box.Max = Box.Min + float3{Size(Rnd), Size(Rnd), Size(Rnd)};
+
+            MinX.push_back(Box.Min.x);
+            MinY.push_back(Box.Min.y);
+            MinZ.push_back(Box.Min.z);
+            MaxX.push_back(Box.Max.x);
+            MaxY.push_back(Box.Max.y);
+            MaxZ.push_back(Box.Max.z);
+        }
+    }
+};
+
+void Common_AdvancedMath_GetBoxVisibility(BenchmarkState& State)
+{
+    CullingScene               Scene{static_cast<size_t>(State.Range(0))};
+    std::vector<BoxVisibility> Visibilities(Scene.Boxes.size());
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < Scene.Boxes.size(); ++i)
+            Visibilities[i] = GetBoxVisibility(Scene.Frustum, Scene.Boxes[i]);
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Scene.Boxes.size()));
+}
+DILIGENT_BENCHMARK(Common_AdvancedMath_GetBoxVisibility)->Arg(16384);
+
+void Common_AdvancedMath_GetBoxesVisibility(BenchmarkState& State)
+{
+    CullingScene               Scene{static_cast<size_t>(State.Range(0))};
+    std::vector<BoxVisibility> Visibilities(Scene.Boxes.size());
+    for (auto _ : State)
+    {
+        GetBoxesVisibility(Scene.Frustum, Scene.Boxes.data(), Scene.Boxes.size(), Visibilities.data());
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Scene.Boxes.size()));
+}
+DILIGENT_BENCHMARK(Common_AdvancedMath_GetBoxesVisibility)->Arg(16384);
+
+void Common_AdvancedMath_GetBoxesVisibilitySoA(BenchmarkState& State)
+{
+    CullingScene Scene{static_cast<size_t>(State.Range(0))};
+
+    BoundBoxArraySoA Boxes;
+    Boxes.MinX     = Scene.MinX.data();
+    Boxes.MinY     = Scene.MinY.data();
+    Boxes.MinZ     = Scene.MinZ.data();
+    Boxes.MaxX     = Scene.MaxX.data();
+    Boxes.MaxY     = Scene.MaxY.data();
+    Boxes.MaxZ     = Scene.MaxZ.data();
+    Boxes.NumBoxes = Scene.Boxes.size();
+
+    std::vector<Uint32> VisibleMask((Boxes.NumBoxes + 31) / 32);
+    std::vector<Uint32> FullyVisibleMask(VisibleMask.size());
+    for (auto _ : State)
+    {
+        GetBoxesVisibility(Scene.Frustum, Boxes, VisibleMask.data(), FullyVisibleMask.data());
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Boxes.NumBoxes));
+}
+DILIGENT_BENCHMARK(Common_AdvancedMath_GetBoxesVisibilitySoA)->Arg(16384);
+
+} // namespace
@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+
+#include "StringInternTable.hpp"
+#include "HashUtils.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Resource-like names, every name is repeated 4 times
+std::vector<std::string> MakeNames(size_t NumUniqueNames)
+{
+    std::vector<std::string> Names;
+    for (size_t r = 0; r < 4; ++r)
+    {
+        for (size_t i = 0; i < NumUniqueNames; ++i)
+            Names.emplace_back("g_MaterialTexture_" + std::to_string(i));
+    }
+    return Names;
+}
+
+void Common_StringInternTable_Intern(BenchmarkState& State)
+{
+    const auto Names = MakeNames(static_cast<size_t>(State.Range(0)));
+
+    size_t MemorySize = 0;
+    for (auto _ : State)
+    {
+        StringInternTable Table;
+        for (const auto& Name : Names)
+            DoNotOptimize(Table.Intern(Name.c_str()));
+
+        State.PauseTiming();
+        MemorySize = Table.GetMemorySize();
+        State.ResumeTiming();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Names.size()));
+    State.SetCounter("MemoryBytes", static_cast<double>(MemorySize));
+}
+DILIGENT_BENCHMARK(Common_StringInternTable_Intern)->Arg(1024);
+
+void Common_StringInternTable_StdUnorderedSetInsert(BenchmarkState& State)
+{
+    const auto Names = MakeNames(static_cast<size_t>(State.Range(0)));
+
+    size_t MemorySize = 0;
+    for (auto _ : State)
+    {
+        std::unordered_set<std::string> Set;
+        for (const auto& Name : Names)
+            DoNotOptimize(Set.insert(Name).first->c_str());
+
+        State.PauseTiming();
+        // Approximate memory usage: one node per string plus the bucket array
+        MemorySize = Set.bucket_count() * sizeof(void*);
+        for (const auto& Str : Set)
+            MemorySize += sizeof(std::string) + sizeof(void*) + sizeof(size_t) + (Str.capacity() >= sizeof(std::string) ? Str.capacity() + 1 : 0);
+        State.ResumeTiming();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Names.size()));
+    State.SetCounter("MemoryBytes", static_cast<double>(MemorySize));
+}
+DILIGENT_BENCHMARK(Common_StringInternTable_StdUnorderedSetInsert)->Arg(1024);
+
+void Common_StringInternTable_Find(BenchmarkState& State)
+{
+    const auto        Names = MakeNames(static_cast<size_t>(State.Range(0)));
+    StringInternTable Table;
+    for (const auto& Name : Names)
+        Table.Intern(Name.c_str());
+
+    for (auto _ : State)
+    {
+        for (const auto& Name : Names)
+            DoNotOptimize(Table.Find(Name.c_str()));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Names.size()));
+}
+DILIGENT_BENCHMARK(Common_StringInternTable_Find)->Arg(1024);
+
+void Common_StringInternTable_HashMapStringKeyFind(BenchmarkState& State)
+{
+    const auto Names = MakeNames(static_cast<size_t>(State.Range(0)));
+
+    std::unordered_map<HashMapStringKey, Uint32, HashMapStringKey::Hasher> Map;
+    for (const auto& Name : Names)
+        Map.emplace(HashMapStringKey{Name.c_str(), true}, 0u);
+
+    for (auto _ : State)
+    {
+        for (const auto& Name : Names)
+            DoNotOptimize(Map.find(Name.c_str()));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Names.size()));
+}
+DILIGENT_BENCHMARK(Common_StringInternTable_HashMapStringKeyFind)->Arg(1024);
+
+// Once the strings are interned, maps keyed by the handle hash and compare pointers only
+void Common_StringInternTable_InternedKeyFind(BenchmarkState& State)
+{
+    const auto        Names = MakeNames(static_cast<size_t>(State.Range(0)));
+    StringInternTable Table;
+
+    std::vector<InternedString> Keys;
+    for (const auto& Name : Names)
+        Keys.push_back(Table.Intern(Name.c_str()));
+
+    std::unordered_map<InternedString, Uint32, InternedString::Hasher> Map;
+    for (const auto& Key : Keys)
+        Map.emplace(Key, 0u);
+
+    for (auto _ : State)
+    {
+        for (const auto& Key : Keys)
+            DoNotOptimize(Map.find(Key));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Keys.size()));
+}
+DILIGENT_BENCHMARK(Common_StringInternTable_InternedKeyFind)->Arg(1024);
+
+} // namespace
@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "StringTools.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+const std::vector<std::string>& GetIdentifiers()
+{
+    static const std::vector<std::string> Identifiers = []() {
+        std::vector<std::string> Ids;
+        const char*              Prefixes[] = {"g_Texture", "g_tex2DAlbedo", "g_Sampler", "cbCameraAttribs", "g_BufferData"};
+        for (size_t i = 0; i < 256; ++i)
+            Ids.emplace_back(std::string{Prefixes[i % (sizeof(Prefixes) / sizeof(Prefixes[0]))]} + std::to_string(i));
+        return Ids;
+    }();
+    return Identifiers;
+}
+
+void Common_StringTools_StrCmpNoCase(BenchmarkState& State)
+{
+    const auto& Ids = GetIdentifiers();
+
+    std::vector<std::string> UpperIds;
+    for (const auto& Id : Ids)
+    {
+        UpperIds.push_back(Id);
+        for (auto& c : UpperIds.back())
+            c = static_cast<char>(toupper(c));
+    }
+
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < Ids.size(); ++i)
+            DoNotOptimize(StrCmpNoCase(Ids[i].c_str(), UpperIds[i].c_str()));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Ids.size()));
+}
+DILIGENT_BENCHMARK(Common_StringTools_StrCmpNoCase);
+
+void Common_StringTools_StreqSuff(BenchmarkState& State)
+{
+    const auto& Ids = GetIdentifiers();
+
+    std::vector<std::string> Combined;
+    for (const auto& Id : Ids)
+        Combined.push_back(Id + "_sampler");
+
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < Ids.size(); ++i)
+            DoNotOptimize(StreqSuff(Combined[i].c_str(), Ids[i].c_str(), "_sampler"));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Ids.size()));
+}
+DILIGENT_BENCHMARK(Common_StringTools_StreqSuff);
+
+void Common_StringTools_StrToLower(BenchmarkState& State)
+{
+    const auto& Ids = GetIdentifiers();
+    for (auto _ : State)
+    {
+        for (const auto& Id : Ids)
+            DoNotOptimize(StrToLower(Id));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Ids.size()));
+}
+DILIGENT_BENCHMARK(Common_StringTools_StrToLower);
+
+void Common_StringTools_WidenNarrowString(BenchmarkState& State)
+{
+    const auto& Ids = GetIdentifiers();
+    for (auto _ : State)
+    {
+        for (const auto& Id : Ids)
+            DoNotOptimize(NarrowString(WidenString(Id)));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * Ids.size()));
+}
+DILIGENT_BENCHMARK(Common_StringTools_WidenNarrowString);
+
+void Common_StringTools_CountFloatNumberChars(BenchmarkState& State)
+{
+    const char* Numbers[] = {"0", "1.5", "-3.25e+10", "12345.678f", ".5E-3", "+100", "3.14159265358979", "not a number"};
+    for (auto _ : State)
+    {
+        for (const auto* Number : Numbers)
+            DoNotOptimize(CountFloatNumberChars(Number));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * (sizeof(Numbers) / sizeof(Numbers[0]))));
+}
+DILIGENT_BENCHMARK(Common_StringTools_CountFloatNumberChars);
+
+} // namespace
@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+std::vector<Uint8> MakeRGBA8Image(size_t NumPixels)
+{
+    std::vector<Uint8> Pixels(NumPixels * 4);
+    for (size_t i = 0; i < Pixels.size(); ++i)
+        Pixels[i] = static_cast<Uint8>((i * 7) ^ (i >> 5));
+    return Pixels;
+}
+
+void GraphicsAccessories_ColorConversion_ConvertPixels(BenchmarkState& State)
+{
+    const auto SrcFmt    = static_cast<TEXTURE_FORMAT>(State.Range(0));
+    const auto DstFmt    = static_cast<TEXTURE_FORMAT>(State.Range(1));
+    const auto NumPixels = size_t{512 * 512};
+
+    const auto         Src = MakeRGBA8Image(NumPixels);
+    std::vector<Uint8> Dst(NumPixels * GetTextureFormatAttribs(DstFmt).GetElementSize());
+
+    State.SetLabel(std::string{GetTextureFormatAttribs(SrcFmt).Name} + " -> " + GetTextureFormatAttribs(DstFmt).Name);
+    for (auto _ : State)
+    {
+        ConvertPixels(Src.data(), SrcFmt, Dst.data(), DstFmt, static_cast<Uint32>(NumPixels));
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumPixels));
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_ColorConversion_ConvertPixels)
+    ->Args({TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA16_FLOAT})
+    ->Args({TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA32_FLOAT})
+    ->Args({TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_BGRA8_UNORM})
+    ->Args({TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA8_UNORM});
+
+// Per-pixel conversion using the scalar helper functions, which is what
+// the code had to do before ConvertPixels() was available
+void GraphicsAccessories_ColorConversion_ScalarSRGBToHalf(BenchmarkState& State)
+{
+    const auto NumPixels = size_t{512 * 512};
+
+    const auto          Src = MakeRGBA8Image(NumPixels);
+    std::vector<Uint16> Dst(NumPixels * 4);
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < NumPixels; ++i)
+        {
+            for (size_t c = 0; c < 3; ++c)
+                Dst[i * 4 + c] = FloatToHalf(SRGBToLinear(static_cast<float>(Src[i * 4 + c]) / 255.f));
+            Dst[i * 4 + 3] = FloatToHalf(static_cast<float>(Src[i * 4 + 3]) / 255.f);
+        }
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumPixels));
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_ColorConversion_ScalarSRGBToHalf);
+
+void GraphicsAccessories_ColorConversion_ConvertImage(BenchmarkState& State)
+{
+    const Uint32 Width  = 2048;
+    const Uint32 Height = 2048;
+
+    const auto          Src = MakeRGBA8Image(size_t{Width} * Height);
+    std::vector<Uint16> Dst(size_t{Width} * Height * 4);
+
+    ColorConversionAttribs Attribs;
+    Attribs.pSrcData   = Src.data();
+    Attribs.SrcStride  = Width * 4;
+    Attribs.SrcFormat  = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    Attribs.pDstData   = Dst.data();
+    Attribs.DstStride  = Width * 8;
+    Attribs.DstFormat  = TEX_FORMAT_RGBA16_FLOAT;
+    Attribs.Width      = Width;
+    Attribs.Height     = Height;
+    Attribs.MaxThreads = static_cast<Uint32>(State.Range(0));
+    for (auto _ : State)
+    {
+        ConvertImage(Attribs);
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations()) * Width * Height);
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_ColorConversion_ConvertImage)->Arg(1)->Arg(0);
+
+} // namespace
@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "ImageResampling.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+std::vector<Uint8> MakeRGBA8Image(Uint32 Width, Uint32 Height)
+{
+    std::vector<Uint8> Pixels(size_t{Width} * Height * 4);
+    for (size_t i = 0; i < Pixels.size(); ++i)
+        Pixels[i] = static_cast<Uint8>((i * 7) ^ (i >> 5));
+    return Pixels;
+}
+
+const char* GetFilterName(IMAGE_FILTER_TYPE Filter)
+{
+    switch (Filter)
+    {
+        case IMAGE_FILTER_BOX: return "box";
+        case IMAGE_FILTER_KAISER: return "kaiser";
+        case IMAGE_FILTER_LANCZOS: return "lanczos";
+        default: return "unknown";
+    }
+}
+
+// Downsamples 2048x2048 image to 2048/Range(1) x 2048/Range(1) with the filter given by Range(0)
+void GraphicsAccessories_ImageResampling_ResampleImage(BenchmarkState& State)
+{
+    const auto   Filter    = static_cast<IMAGE_FILTER_TYPE>(State.Range(0));
+    const Uint32 SrcWidth  = 2048;
+    const Uint32 SrcHeight = 2048;
+    const Uint32 DstWidth  = SrcWidth / static_cast<Uint32>(State.Range(1));
+    const Uint32 DstHeight = SrcHeight / static_cast<Uint32>(State.Range(1));
+
+    const auto         Src = MakeRGBA8Image(SrcWidth, SrcHeight);
+    std::vector<Uint8> Dst(size_t{DstWidth} * DstHeight * 4);
+
+    ImageResamplingAttribs Attribs;
+    Attribs.pSrcData  = Src.data();
+    Attribs.SrcStride = SrcWidth * 4;
+    Attribs.SrcWidth  = SrcWidth;
+    Attribs.SrcHeight = SrcHeight;
+    Attribs.pDstData  = Dst.data();
+    Attribs.DstStride = DstWidth * 4;
+    Attribs.DstWidth  = DstWidth;
+    Attribs.DstHeight = DstHeight;
+    Attribs.Format    = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    Attribs.Filter    = Filter;
+    Attribs.Flags     = IMAGE_RESAMPLING_FLAG_SRGB;
+
+    State.SetLabel(GetFilterName(Filter));
+    for (auto _ : State)
+    {
+        if (!ResampleImage(Attribs))
+        {
+            State.SkipWithError("Failed to resample the image");
+            break;
+        }
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations()) * DstWidth * DstHeight);
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_ImageResampling_ResampleImage)
+    ->Args({IMAGE_FILTER_BOX, 2})
+    ->Args({IMAGE_FILTER_KAISER, 2})
+    ->Args({IMAGE_FILTER_LANCZOS, 2})
+    ->Args({IMAGE_FILTER_LANCZOS, 3});
+
+void GraphicsAccessories_ImageResampling_GenerateMipChain(BenchmarkState& State)
+{
+    const auto   Filter = static_cast<IMAGE_FILTER_TYPE>(State.Range(0));
+    const Uint32 Width  = 2048;
+    const Uint32 Height = 2048;
+
+    const auto Src = MakeRGBA8Image(Width, Height);
+
+    std::vector<std::vector<Uint8>> MipData;
+    std::vector<MipLevelData>       MipLevels;
+    Uint64                          NumMipPixels = 0;
+    for (Uint32 w = Width / 2, h = Height / 2; w > 0 && h > 0; w /= 2, h /= 2)
+    {
+        MipData.emplace_back(size_t{w} * h * 4);
+        MipLevelData Level;
+        Level.pData  = MipData.back().data();
+        Level.Stride = w * 4;
+        MipLevels.push_back(Level);
+        NumMipPixels += size_t{w} * h;
+    }
+
+    MipChainGenerationAttribs Attribs;
+    Attribs.pSrcData     = Src.data();
+    Attribs.SrcStride    = Width * 4;
+    Attribs.Width        = Width;
+    Attribs.Height       = Height;
+    Attribs.Format       = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    Attribs.NumMipLevels = static_cast<Uint32>(MipLevels.size());
+    Attribs.pMipLevels   = MipLevels.data();
+    Attribs.Filter       = Filter;
+    Attribs.Flags        = IMAGE_RESAMPLING_FLAG_SRGB;
+
+    State.SetLabel(GetFilterName(Filter));
+    for (auto _ : State)
+    {
+        if (!GenerateMipChain(Attribs))
+        {
+            State.SkipWithError("Failed to generate the mip chain");
+            break;
+        }
+        ClobberMemory();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumMipPixels));
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_ImageResampling_GenerateMipChain)->Arg(IMAGE_FILTER_BOX)->Arg(IMAGE_FILTER_KAISER);
+
+} // namespace
@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ResourceReleaseQueue.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+struct StaleResource
+{
+    Uint64 Data[4] = {};
+};
+
+template <typename WrapperType>
+void ReleaseBatch(ResourceReleaseQueue<WrapperType>& Queue, Uint32 NumResources, Uint64 CmdListNumber)
+{
+    for (Uint32 i = 0; i < NumResources; ++i)
+        Queue.SafeReleaseResource(std::unique_ptr<StaleResource>{new StaleResource}, CmdListNumber);
+}
+
+// Every iteration releases a batch of resources, moves them into the release queue and
+// purges the queue, like the device does for every submitted command list
+void GraphicsAccessories_ResourceReleaseQueue_DynamicWrapper(BenchmarkState& State)
+{
+    const auto NumResources = static_cast<Uint32>(State.Range(0));
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue{DefaultRawMemoryAllocator::GetAllocator()};
+
+    Uint64 CmdListNumber = 0;
+    for (auto _ : State)
+    {
+        ReleaseBatch(Queue, NumResources, CmdListNumber);
+        Queue.DiscardStaleResources(CmdListNumber, CmdListNumber);
+        Queue.Purge(CmdListNumber);
+        ++CmdListNumber;
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumResources));
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_ResourceReleaseQueue_DynamicWrapper)->Arg(16)->Arg(1024);
+
+void GraphicsAccessories_ResourceReleaseQueue_StaticWrapper(BenchmarkState& State)
+{
+    const auto NumResources = static_cast<Uint32>(State.Range(0));
+
+    ResourceReleaseQueue<StaticStaleResourceWrapper<std::unique_ptr<StaleResource>>> Queue{DefaultRawMemoryAllocator::GetAllocator()};
+
+    Uint64 CmdListNumber = 0;
+    for (auto _ : State)
+    {
+        ReleaseBatch(Queue, NumResources, CmdListNumber);
+        Queue.DiscardStaleResources(CmdListNumber, CmdListNumber);
+        Queue.Purge(CmdListNumber);
+        ++CmdListNumber;
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumResources));
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_ResourceReleaseQueue_StaticWrapper)->Arg(16)->Arg(1024);
+
+// Measures SafeReleaseResource() on the main thread while State.Range(0) other threads
+// keep releasing resources into the same queue and purging it
+void GraphicsAccessories_ResourceReleaseQueue_ConcurrentRelease(BenchmarkState& State)
+{
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue{DefaultRawMemoryAllocator::GetAllocator()};
+
+    std::atomic<bool>        Stop{false};
+    std::vector<std::thread> Threads;
+    for (Int64 t = 0; t < State.Range(0); ++t)
+    {
+        Threads.emplace_back([&]() {
+            while (!Stop.load(std::memory_order_relaxed))
+            {
+                ReleaseBatch(Queue, 16, 0);
+                Queue.DiscardStaleResources(0, 0);
+                Queue.Purge(0);
+            }
+        });
+    }
+
+    Uint32 NumReleased = 0;
+    for (auto _ : State)
+    {
+        ReleaseBatch(Queue, 1, 0);
+        if (++NumReleased % 64 == 0)
+        {
+            Queue.DiscardStaleResources(0, 0);
+            Queue.Purge(0);
+        }
+    }
+
+    Stop.store(true);
+    for (auto& Thread : Threads)
+        Thread.join();
+    Queue.DiscardStaleResources(0, 0);
+    Queue.Purge(0);
+
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations()));
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_ResourceReleaseQueue_ConcurrentRelease)->Arg(0)->Arg(3);
+
+} // namespace
@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "RingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Simulates dynamic upload heap usage: every frame makes a number of small aligned
+// allocations, and the frames that are three frames behind are released.
+void GraphicsAccessories_RingBuffer_AllocateFrame(BenchmarkState& State)
+{
+    const auto AllocationsPerFrame = static_cast<Uint32>(State.Range(0));
+    const auto MaxFramesInFlight   = 3;
+
+    RingBuffer Ring{AllocationsPerFrame * 256 * (MaxFramesInFlight + 1), DefaultRawMemoryAllocator::GetAllocator()};
+
+    Uint64 FrameNumber = 0;
+    for (auto _ : State)
+    {
+        for (Uint32 i = 0; i < AllocationsPerFrame; ++i)
+            DoNotOptimize(Ring.Allocate(64 + (i & 3) * 32, 16));
+        Ring.FinishCurrentFrame(FrameNumber);
+        if (FrameNumber >= MaxFramesInFlight)
+            Ring.ReleaseCompletedFrames(FrameNumber - MaxFramesInFlight);
+        ++FrameNumber;
+    }
+    Ring.ReleaseCompletedFrames(FrameNumber);
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * AllocationsPerFrame));
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_RingBuffer_AllocateFrame)->Arg(64)->Arg(1024);
+
+} // namespace
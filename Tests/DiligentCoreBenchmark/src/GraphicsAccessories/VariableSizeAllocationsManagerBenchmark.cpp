@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <vector>
+#include <random>
+
+#include "VariableSizeAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Allocates a batch of blocks of random sizes and frees them in random order
+void GraphicsAccessories_VariableSizeAllocationsManager_AllocateFree(BenchmarkState& State)
+{
+    const size_t NumAllocations = static_cast<size_t>(State.Range(0));
+
+    std::mt19937                          Rnd{0};
+    std::uniform_int_distribution<size_t> SizeDistr{16, 4096};
+    std::vector<size_t>                   Sizes(NumAllocations);
+    for (auto& Size : Sizes)
+        Size = SizeDistr(Rnd);
+
+    std::vector<size_t> FreeOrder(NumAllocations);
+    for (size_t i = 0; i < FreeOrder.size(); ++i)
+        FreeOrder[i] = i;
+    std::shuffle(FreeOrder.begin(), FreeOrder.end(), Rnd);
+
+    VariableSizeAllocationsManager ListMgr{NumAllocations * 8192, DefaultRawMemoryAllocator::GetAllocator()};
+
+    std::vector<VariableSizeAllocationsManager::Allocation> Allocations(NumAllocations);
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < NumAllocations; ++i)
+            Allocations[i] = ListMgr.Allocate(Sizes[i], 16);
+        for (auto i : FreeOrder)
+            ListMgr.Free(std::move(Allocations[i]));
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumAllocations));
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_VariableSizeAllocationsManager_AllocateFree)->Arg(64)->Arg(1024);
+
+// Steady state of a fragmented heap: every iteration frees a random block and allocates a new one
+void GraphicsAccessories_VariableSizeAllocationsManager_Fragmented(BenchmarkState& State)
+{
+    const size_t NumAllocations = static_cast<size_t>(State.Range(0));
+
+    VariableSizeAllocationsManager ListMgr{NumAllocations * 4096, DefaultRawMemoryAllocator::GetAllocator()};
+
+    std::mt19937                          Rnd{0};
+    std::uniform_int_distribution<size_t> SizeDistr{16, 4096};
+    std::uniform_int_distribution<size_t> IdxDistr{0, NumAllocations - 1};
+
+    std::vector<VariableSizeAllocationsManager::Allocation> Allocations(NumAllocations);
+    for (auto& Allocation : Allocations)
+        Allocation = ListMgr.Allocate(SizeDistr(Rnd), 16);
+
+    for (auto _ : State)
+    {
+        State.PauseTiming();
+        const auto Idx  = IdxDistr(Rnd);
+        const auto Size = SizeDistr(Rnd);
+        State.ResumeTiming();
+
+        if (Allocations[Idx].IsValid())
+            ListMgr.Free(std::move(Allocations[Idx]));
+        Allocations[Idx] = ListMgr.Allocate(Size, 16);
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations()));
+    State.SetCounter("FreeBlocks", static_cast<double>(ListMgr.GetNumFreeBlocks()));
+
+    for (auto& Allocation : Allocations)
+    {
+        if (Allocation.IsValid())
+            ListMgr.Free(std::move(Allocation));
+    }
+}
+DILIGENT_BENCHMARK(GraphicsAccessories_VariableSizeAllocationsManager_Fragmented)->Arg(4096);
+
+} // namespace
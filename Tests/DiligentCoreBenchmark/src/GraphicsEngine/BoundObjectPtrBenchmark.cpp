@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "BoundObjectPtr.hpp"
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Objects that are bound to the context in a typical frame: every draw call rebinds
+// one of a small set of objects, so most bindings are repeated many times per frame.
+std::vector<RefCntAutoPtr<IDataBlob>> MakeObjects(size_t NumObjects)
+{
+    std::vector<RefCntAutoPtr<IDataBlob>> Objects;
+    for (size_t i = 0; i < NumObjects; ++i)
+        Objects.emplace_back(MakeNewRCObj<DataBlobImpl>()(0));
+    return Objects;
+}
+
+constexpr size_t NumBindingsPerFrame = 1024;
+
+// Strong binding: every rebinding releases the old object and adds a reference to the new one
+void GraphicsEngine_BoundObjectPtr_RefCntAutoPtrRebind(BenchmarkState& State)
+{
+    const auto Objects = MakeObjects(static_cast<size_t>(State.Range(0)));
+
+    RefCntAutoPtr<IDataBlob> pBound;
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < NumBindingsPerFrame; ++i)
+            pBound = Objects[i % Objects.size()];
+        pBound.Release();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumBindingsPerFrame));
+}
+DILIGENT_BENCHMARK(GraphicsEngine_BoundObjectPtr_RefCntAutoPtrRebind)->Arg(16);
+
+// Weak binding: objects are retained once per frame by the frame retention list,
+// which is released at the end of the frame
+void GraphicsEngine_BoundObjectPtr_FrameRetainedRebind(BenchmarkState& State)
+{
+    auto Objects = MakeObjects(static_cast<size_t>(State.Range(0)));
+
+    BoundObjectPtr<IDataBlob>        pBound;
+    FrameRetainedObjects             Retained;
+    FrameRetainedObjects::ObjectList FrameObjects;
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < NumBindingsPerFrame; ++i)
+        {
+            auto* pObject = Objects[i % Objects.size()].RawPtr();
+            Retained.Retain(pObject);
+            pBound.Set(pObject, false);
+        }
+        pBound.Release();
+
+        Retained.ExtractObjects(FrameObjects);
+        FrameObjects.clear();
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * NumBindingsPerFrame));
+}
+DILIGENT_BENCHMARK(GraphicsEngine_BoundObjectPtr_FrameRetainedRebind)->Arg(16);
+
+} // namespace
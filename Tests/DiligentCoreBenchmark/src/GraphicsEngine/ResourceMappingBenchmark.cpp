@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "ResourceMappingImpl.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "HashUtils.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Minimal device object that can be added to the resource mapping without a render device
+class DummyDeviceObject final : public ObjectBase<IDeviceObject>
+{
+public:
+    using TBase = ObjectBase<IDeviceObject>;
+
+    DummyDeviceObject(IReferenceCounters* pRefCounters, Int32 UniqueID) :
+        TBase{pRefCounters},
+        m_UniqueID{UniqueID}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceObject, TBase)
+
+    virtual const DeviceObjectAttribs& DILIGENT_CALL_TYPE GetDesc() const override final { return m_Desc; }
+
+    virtual Int32 DILIGENT_CALL_TYPE GetUniqueID() const override final { return m_UniqueID; }
+
+private:
+    DeviceObjectAttribs m_Desc;
+    const Int32         m_UniqueID;
+};
+
+// Resource mapping with State.Range(0) objects and the list of names of the resources
+// that a typical SRB binds: 16 lookups per iteration
+class ResourceMappingBenchmark
+{
+public:
+    explicit ResourceMappingBenchmark(size_t NumResources) :
+        m_pMapping{MakeNewRCObj<ResourceMappingImpl>()(DefaultRawMemoryAllocator::GetAllocator())}
+    {
+        for (size_t i = 0; i < NumResources; ++i)
+        {
+            m_Names.emplace_back("g_Resource" + std::to_string(i));
+            RefCntAutoPtr<DummyDeviceObject> pObject{MakeNewRCObj<DummyDeviceObject>()(static_cast<Int32>(i))};
+            m_pMapping->AddResource(m_Names.back().c_str(), pObject, false);
+        }
+
+        for (size_t i = 0; i < NumLookups; ++i)
+        {
+            const auto& Name     = m_Names[(i * 7919) % m_Names.size()];
+            m_LookupInfo[i].Name = Name.c_str();
+        }
+    }
+
+    static constexpr size_t NumLookups = 16;
+
+    RefCntAutoPtr<ResourceMappingImpl> m_pMapping;
+    std::vector<std::string>           m_Names;
+    ResourceMappingLookupInfo          m_LookupInfo[NumLookups];
+};
+
+void GraphicsEngine_ResourceMapping_GetResource(BenchmarkState& State)
+{
+    ResourceMappingBenchmark Bench{static_cast<size_t>(State.Range(0))};
+    for (auto _ : State)
+    {
+        for (const auto& Info : Bench.m_LookupInfo)
+        {
+            IDeviceObject* pObject = nullptr;
+            Bench.m_pMapping->GetResource(Info.Name, &pObject, 0);
+            DoNotOptimize(pObject);
+            if (pObject != nullptr)
+                pObject->Release();
+        }
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * ResourceMappingBenchmark::NumLookups));
+}
+DILIGENT_BENCHMARK(GraphicsEngine_ResourceMapping_GetResource)->Arg(64)->Arg(4096);
+
+// Batched lookup. When State.Range(1) is non-zero, the name hashes are computed in advance.
+void GraphicsEngine_ResourceMapping_GetResources(BenchmarkState& State)
+{
+    ResourceMappingBenchmark Bench{static_cast<size_t>(State.Range(0))};
+    if (State.Range(1) != 0)
+    {
+        for (auto& Info : Bench.m_LookupInfo)
+            Info.NameHash = CStringHash<Char>{}(Info.Name);
+    }
+
+    IDeviceObject* ppObjects[ResourceMappingBenchmark::NumLookups] = {};
+    for (auto _ : State)
+    {
+        Bench.m_pMapping->GetResources(ResourceMappingBenchmark::NumLookups, Bench.m_LookupInfo, ppObjects);
+        for (auto*& pObject : ppObjects)
+        {
+            DoNotOptimize(pObject);
+            if (pObject != nullptr)
+            {
+                pObject->Release();
+                pObject = nullptr;
+            }
+        }
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations() * ResourceMappingBenchmark::NumLookups));
+}
+DILIGENT_BENCHMARK(GraphicsEngine_ResourceMapping_GetResources)->Args({64, 0})->Args({64, 1})->Args({4096, 0})->Args({4096, 1});
+
+} // namespace
@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <map>
+#include <vector>
+#include <string>
+
+#include "ShaderPermutationCache.hpp"
+#include "ShaderMacroHelper.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Permutation is selected by the bits of the permutation index, like material or
+// light type flags that are evaluated every time the pipeline is selected for a draw call
+constexpr Uint32 NumPermutations = 256;
+
+void BuildPermutationKey(Uint32 Permutation, ShaderPermutationKey& Key)
+{
+    Key.Clear();
+    Key.AddMacro("USE_NORMAL_MAP", (Permutation & 0x01) != 0);
+    Key.AddMacro("USE_EMISSIVE", (Permutation & 0x02) != 0);
+    Key.AddMacro("USE_OCCLUSION", (Permutation & 0x04) != 0);
+    Key.AddMacro("USE_IBL", (Permutation & 0x08) != 0);
+    Key.AddMacro("ALPHA_MODE", Uint32{(Permutation >> 4) & 0x03});
+    Key.AddMacro("NUM_LIGHTS", Uint32{(Permutation >> 6) & 0x03} * 4);
+    Key.AddMacro("TONE_MAPPING_MODE", "TONE_MAPPING_MODE_UNCHARTED2");
+}
+
+void BuildShaderMacros(Uint32 Permutation, ShaderMacroHelper& Macros)
+{
+    Macros.Clear();
+    Macros.AddShaderMacro("USE_NORMAL_MAP", (Permutation & 0x01) != 0);
+    Macros.AddShaderMacro("USE_EMISSIVE", (Permutation & 0x02) != 0);
+    Macros.AddShaderMacro("USE_OCCLUSION", (Permutation & 0x04) != 0);
+    Macros.AddShaderMacro("USE_IBL", (Permutation & 0x08) != 0);
+    Macros.AddShaderMacro("ALPHA_MODE", Uint32{(Permutation >> 4) & 0x03});
+    Macros.AddShaderMacro("NUM_LIGHTS", Uint32{(Permutation >> 6) & 0x03} * 4);
+    Macros.AddShaderMacro("TONE_MAPPING_MODE", "TONE_MAPPING_MODE_UNCHARTED2");
+    Macros.Finalize();
+}
+
+// String key made of all macros, which is how permutations are usually looked up without ShaderPermutationKey
+std::string MakeStringKey(const ShaderMacro* pMacros)
+{
+    std::string Key;
+    for (; pMacros != nullptr && pMacros->Name != nullptr; ++pMacros)
+    {
+        Key += pMacros->Name;
+        Key += '=';
+        Key += pMacros->Definition;
+        Key += ';';
+    }
+    return Key;
+}
+
+void GraphicsTools_ShaderPermutationCache_KeyLookup(BenchmarkState& State)
+{
+    ShaderPermutationCache<Uint32> Cache;
+    ShaderPermutationKey           Key;
+    for (Uint32 p = 0; p < NumPermutations; ++p)
+    {
+        BuildPermutationKey(p, Key);
+        Cache.GetOrCreate(Key, [p](const ShaderPermutationKey&, Uint32& Value) { Value = p + 1; });
+    }
+
+    Uint32 Permutation = 0;
+    for (auto _ : State)
+    {
+        BuildPermutationKey(Permutation, Key);
+        DoNotOptimize(Cache.Get(Key));
+        Permutation = (Permutation + 37) % NumPermutations;
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations()));
+}
+DILIGENT_BENCHMARK(GraphicsTools_ShaderPermutationCache_KeyLookup);
+
+void GraphicsTools_ShaderPermutationCache_MacroHelperStdMapLookup(BenchmarkState& State)
+{
+    std::map<std::string, Uint32> Cache;
+    ShaderMacroHelper             Macros;
+    for (Uint32 p = 0; p < NumPermutations; ++p)
+    {
+        BuildShaderMacros(p, Macros);
+        Cache.emplace(MakeStringKey(Macros), p + 1);
+    }
+
+    Uint32 Permutation = 0;
+    for (auto _ : State)
+    {
+        BuildShaderMacros(Permutation, Macros);
+        auto it = Cache.find(MakeStringKey(Macros));
+        DoNotOptimize(it->second);
+        Permutation = (Permutation + 37) % NumPermutations;
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations()));
+}
+DILIGENT_BENCHMARK(GraphicsTools_ShaderPermutationCache_MacroHelperStdMapLookup);
+
+// Lookup with a prebuilt key measures the cache alone
+void GraphicsTools_ShaderPermutationCache_Get(BenchmarkState& State)
+{
+    ShaderPermutationCache<Uint32>    Cache;
+    std::vector<ShaderPermutationKey> Keys(NumPermutations);
+    for (Uint32 p = 0; p < NumPermutations; ++p)
+    {
+        BuildPermutationKey(p, Keys[p]);
+        Cache.GetOrCreate(Keys[p], [p](const ShaderPermutationKey&, Uint32& Value) { Value = p + 1; });
+    }
+
+    Uint32 Permutation = 0;
+    for (auto _ : State)
+    {
+        DoNotOptimize(Cache.Get(Keys[Permutation]));
+        Permutation = (Permutation + 37) % NumPermutations;
+    }
+    State.SetItemsProcessed(static_cast<Int64>(State.Iterations()));
+}
+DILIGENT_BENCHMARK(GraphicsTools_ShaderPermutationCache_Get);
+
+} // namespace
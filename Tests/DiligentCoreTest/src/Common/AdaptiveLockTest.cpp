@@ -0,0 +1,186 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "AdaptiveLock.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace ThreadingTools;
+
+namespace
+{
+
+TEST(Common_AdaptiveLock, LockUnlock)
+{
+    AdaptiveLock Lock;
+    EXPECT_FALSE(Lock.IsLocked());
+
+    Lock.Lock();
+    EXPECT_TRUE(Lock.IsLocked());
+    EXPECT_FALSE(Lock.TryLock());
+    Lock.Unlock();
+    EXPECT_FALSE(Lock.IsLocked());
+
+    EXPECT_TRUE(Lock.TryLock());
+    Lock.Unlock();
+
+    {
+        ExclusiveLockGuard<AdaptiveLock> Guard{Lock};
+        EXPECT_TRUE(Lock.IsLocked());
+    }
+    EXPECT_FALSE(Lock.IsLocked());
+
+    auto Stats = Lock.GetStats();
+    EXPECT_EQ(Stats.NumAcquisitions, 3u);
+    EXPECT_EQ(Stats.NumSpins, 0u);
+    EXPECT_EQ(Stats.NumParks, 0u);
+
+    Lock.ResetStats();
+    EXPECT_EQ(Lock.GetStats().NumAcquisitions, 0u);
+}
+
+template <typename LockType>
+void TestMutualExclusion(LockType& Lock)
+{
+    const int NumThreads    = std::max(static_cast<int>(std::thread::hardware_concurrency()), 4);
+    const int NumIterations = 20000;
+
+    int Counter = 0;
+
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&]() {
+            for (int i = 0; i < NumIterations; ++i)
+            {
+                ExclusiveLockGuard<LockType> Guard{Lock};
+                ++Counter;
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Counter, NumThreads * NumIterations);
+    EXPECT_EQ(Lock.GetStats().NumAcquisitions, static_cast<Diligent::Uint64>(NumThreads * NumIterations));
+}
+
+TEST(Common_AdaptiveLock, MultithreadedCounter)
+{
+    {
+        AdaptiveLock Lock;
+        TestMutualExclusion(Lock);
+    }
+
+    {
+        // Force the threads to be parked almost immediately
+        AdaptiveLock Lock{1};
+        TestMutualExclusion(Lock);
+    }
+}
+
+TEST(Common_AdaptiveRWLock, LockUnlock)
+{
+    AdaptiveRWLock Lock;
+
+    Lock.LockShared();
+    EXPECT_TRUE(Lock.TryLockShared());
+    EXPECT_FALSE(Lock.TryLock());
+    Lock.UnlockShared();
+    EXPECT_FALSE(Lock.TryLock());
+    Lock.UnlockShared();
+
+    Lock.Lock();
+    EXPECT_FALSE(Lock.TryLock());
+    EXPECT_FALSE(Lock.TryLockShared());
+    Lock.Unlock();
+
+    {
+        SharedLockGuard Guard0{Lock};
+        SharedLockGuard Guard1{Lock};
+    }
+    EXPECT_TRUE(Lock.TryLock());
+    Lock.Unlock();
+
+    EXPECT_EQ(Lock.GetStats().NumAcquisitions, 6u);
+}
+
+TEST(Common_AdaptiveRWLock, MultithreadedReadersWriters)
+{
+    {
+        AdaptiveRWLock Lock;
+        TestMutualExclusion(Lock);
+    }
+
+    AdaptiveRWLock Lock{4};
+
+    // Writers keep both values equal; readers must never observe them being different.
+    int Value0 = 0;
+    int Value1 = 0;
+
+    const int NumWriters    = 2;
+    const int NumReaders    = 4;
+    const int NumIterations = 10000;
+
+    std::atomic_int NumErrors{0};
+
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumWriters; ++t)
+    {
+        Threads.emplace_back([&]() {
+            for (int i = 0; i < NumIterations; ++i)
+            {
+                ExclusiveLockGuard<AdaptiveRWLock> Guard{Lock};
+                ++Value0;
+                ++Value1;
+            }
+        });
+    }
+    for (int t = 0; t < NumReaders; ++t)
+    {
+        Threads.emplace_back([&]() {
+            for (int i = 0; i < NumIterations; ++i)
+            {
+                SharedLockGuard Guard{Lock};
+                if (Value0 != Value1)
+                    ++NumErrors;
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumErrors, 0);
+    EXPECT_EQ(Value0, NumWriters * NumIterations);
+    EXPECT_EQ(Value1, NumWriters * NumIterations);
+    EXPECT_EQ(Lock.GetStats().NumAcquisitions, static_cast<Diligent::Uint64>((NumWriters + NumReaders) * NumIterations));
+}
+
+} // namespace
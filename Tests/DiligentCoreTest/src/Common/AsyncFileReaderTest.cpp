@@ -0,0 +1,206 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <mutex>
+
+#include "AsyncFileReader.hpp"
+#include "FileWrapper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class AsyncFileReaderTest : public ::testing::TestWithParam<bool>
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        for (Uint32 i = 0; i < NumFiles; ++i)
+        {
+            auto Path = GetFilePath(i);
+
+            // Include empty files and files larger than a single read
+            std::vector<Uint8> Data(i % 5 == 0 ? 0 : i * 4099 + 1);
+            for (size_t j = 0; j < Data.size(); ++j)
+                Data[j] = static_cast<Uint8>(i + j * 7);
+
+            FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+            ASSERT_TRUE(File != nullptr);
+            if (!Data.empty())
+                File->Write(Data.data(), Data.size());
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        for (Uint32 i = 0; i < NumFiles; ++i)
+            FileSystem::DeleteFile(GetFilePath(i).c_str());
+    }
+
+    static std::string GetFilePath(Uint32 i)
+    {
+        return "AsyncFileReaderTest" + std::to_string(i) + ".bin";
+    }
+
+    static bool CheckData(Uint32 i, IDataBlob* pData)
+    {
+        const size_t Size = i % 5 == 0 ? 0 : i * 4099 + 1;
+        if (pData == nullptr || pData->GetSize() != Size)
+            return false;
+
+        const auto* pBytes = static_cast<const Uint8*>(pData->GetConstDataPtr());
+        for (size_t j = 0; j < Size; ++j)
+        {
+            if (pBytes[j] != static_cast<Uint8>(i + j * 7))
+                return false;
+        }
+        return true;
+    }
+
+    static constexpr Uint32 NumFiles = 64;
+};
+
+constexpr Uint32 AsyncFileReaderTest::NumFiles;
+
+TEST_P(AsyncFileReaderTest, ReadFiles)
+{
+    AsyncFileReaderCreateInfo CI;
+    CI.NumThreads = 3;
+    CI.QueueDepth = 8;
+    CI.UseIOUring = GetParam();
+    AsyncFileReader Reader{CI};
+    if (GetParam() && !Reader.IsUsingIOUring())
+        GTEST_SKIP() << "io_uring is not available";
+
+    std::vector<std::string> Paths(NumFiles);
+    std::vector<const Char*> PathPtrs(NumFiles);
+    for (Uint32 i = 0; i < NumFiles; ++i)
+    {
+        Paths[i]    = GetFilePath(i);
+        PathPtrs[i] = Paths[i].c_str();
+    }
+
+    std::vector<int>   NumCalls(NumFiles);
+    std::vector<bool>  DataValid(NumFiles);
+    std::mutex         Mtx;
+    std::atomic<Int32> NumCallbacks{0};
+
+    const auto Callback = [&](Uint32 FileIndex, const Char* Path, IDataBlob* pData) {
+        EXPECT_LT(FileIndex, NumFiles);
+        EXPECT_STREQ(Path, GetFilePath(FileIndex).c_str());
+        const auto IsValid = CheckData(FileIndex, pData);
+
+        std::lock_guard<std::mutex> Lock{Mtx};
+        ++NumCalls[FileIndex];
+        DataValid[FileIndex] = IsValid;
+        NumCallbacks.fetch_add(1);
+    };
+
+    // Two batches in flight at the same time
+    Reader.ReadFiles(PathPtrs.data(), NumFiles / 2, Callback);
+    Reader.ReadFiles(PathPtrs.data() + NumFiles / 2, NumFiles / 2,
+                     [&](Uint32 FileIndex, const Char* Path, IDataBlob* pData) {
+                         Callback(FileIndex + NumFiles / 2, Path, pData);
+                     });
+    Reader.WaitIdle();
+
+    EXPECT_EQ(Reader.GetNumPendingReads(), 0u);
+    EXPECT_EQ(NumCallbacks.load(), static_cast<Int32>(NumFiles));
+    for (Uint32 i = 0; i < NumFiles; ++i)
+    {
+        EXPECT_EQ(NumCalls[i], 1) << "File " << i;
+        EXPECT_TRUE(DataValid[i]) << "File " << i;
+    }
+}
+
+TEST_P(AsyncFileReaderTest, MissingFile)
+{
+    AsyncFileReaderCreateInfo CI;
+    CI.NumThreads = 1;
+    CI.UseIOUring = GetParam();
+    AsyncFileReader Reader{CI};
+
+    const auto  ExistingPath = GetFilePath(1);
+    const Char* Paths[]      = {"AsyncFileReaderTest_NonExistentFile.bin", ExistingPath.c_str()};
+
+    bool MissingFileFailed = false;
+    bool ExistingFileRead  = false;
+    Reader.ReadFiles(Paths, 2, [&](Uint32 FileIndex, const Char* Path, IDataBlob* pData) {
+        if (FileIndex == 0)
+            MissingFileFailed = pData == nullptr;
+        else
+            ExistingFileRead = CheckData(1, pData);
+    });
+    Reader.WaitIdle();
+
+    EXPECT_TRUE(MissingFileFailed);
+    EXPECT_TRUE(ExistingFileRead);
+}
+
+TEST_P(AsyncFileReaderTest, ReadFromCallback)
+{
+    AsyncFileReaderCreateInfo CI;
+    CI.NumThreads = 2;
+    CI.UseIOUring = GetParam();
+
+    std::atomic<Int32> NumValid{0};
+    {
+        AsyncFileReader Reader{CI};
+
+        const auto  Path0   = GetFilePath(2);
+        const Char* Paths[] = {Path0.c_str()};
+        Reader.ReadFiles(Paths, 1, [&](Uint32, const Char*, IDataBlob* pData) {
+            if (CheckData(2, pData))
+                NumValid.fetch_add(1);
+
+            // Dependent read enqueued from the callback
+            const auto  Path1    = GetFilePath(3);
+            const Char* Paths1[] = {Path1.c_str()};
+            Reader.ReadFiles(Paths1, 1, [&](Uint32, const Char*, IDataBlob* pData1) {
+                if (CheckData(3, pData1))
+                    NumValid.fetch_add(1);
+            });
+        });
+        // The destructor waits for all reads, including the ones enqueued by the callbacks
+    }
+    EXPECT_EQ(NumValid.load(), 2);
+}
+
+INSTANTIATE_TEST_SUITE_P(Common_AsyncFileReader,
+                         AsyncFileReaderTest,
+                         ::testing::Values(false, true),
+                         [](const testing::TestParamInfo<bool>& info) {
+                             return info.param ? std::string{"IOUring"} : std::string{"ThreadPool"};
+                         });
+
+} // namespace
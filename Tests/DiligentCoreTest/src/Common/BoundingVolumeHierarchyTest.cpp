@@ -0,0 +1,208 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "BoundingVolumeHierarchy.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::vector<BoundBox> GenerateRandomBoxes(size_t NumBoxes, Uint32 Seed)
+{
+    std::mt19937                          gen{Seed};
+    std::uniform_real_distribution<float> pos_dist{-50.f, 50.f};
+    std::uniform_real_distribution<float> size_dist{0.f, 5.f};
+
+    std::vector<BoundBox> Boxes(NumBoxes);
+    for (auto& Box : Boxes)
+    {
+        Box.Min = float3{pos_dist(gen), pos_dist(gen), pos_dist(gen)};
+        Box.Max = Box.Min + float3{size_dist(gen), size_dist(gen), size_dist(gen)};
+    }
+    return Boxes;
+}
+
+ViewFrustum GetTestFrustum()
+{
+    const auto ViewProj = float4x4::RotationY(0.3f) * float4x4::Translation(0, 0, 20) * float4x4::Projection(1.f, 1.5f, 1.f, 60.f, false);
+
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+    return Frustum;
+}
+
+TEST(Common_BoundingVolumeHierarchy, Build)
+{
+    BoundingVolumeHierarchy BVH;
+    BVH.Build(nullptr, 0);
+    EXPECT_TRUE(BVH.GetNodes().empty());
+
+    const auto Boxes = GenerateRandomBoxes(5000, 1);
+    BVH.Build(Boxes.data(), static_cast<Uint32>(Boxes.size()));
+
+    const auto& Nodes   = BVH.GetNodes();
+    const auto& Indices = BVH.GetPrimitiveIndices();
+    ASSERT_FALSE(Nodes.empty());
+    ASSERT_EQ(Indices.size(), Boxes.size());
+
+    // Every primitive must be referenced by exactly one leaf, and every
+    // node box must contain the boxes of its children and primitives
+    std::vector<int> PrimRefs(Boxes.size());
+
+    const auto Contains = [](const BoundBox& Outer, const BoundBox& Inner) {
+        return Outer.Min.x <= Inner.Min.x && Outer.Min.y <= Inner.Min.y && Outer.Min.z <= Inner.Min.z &&
+            Outer.Max.x >= Inner.Max.x && Outer.Max.y >= Inner.Max.y && Outer.Max.z >= Inner.Max.z;
+    };
+    for (size_t i = 0; i < Nodes.size(); ++i)
+    {
+        const auto& N = Nodes[i];
+        if (N.IsLeaf())
+        {
+            EXPECT_LE(N.NumPrimitives, 4);
+            for (Uint32 p = N.Offset; p < N.Offset + N.NumPrimitives; ++p)
+            {
+                ++PrimRefs[Indices[p]];
+                EXPECT_TRUE(Contains(N.Box, Boxes[Indices[p]]));
+            }
+        }
+        else
+        {
+            ASSERT_LT(i + 1, Nodes.size());
+            ASSERT_LT(N.Offset, Nodes.size());
+            EXPECT_GT(N.Offset, i + 1);
+            EXPECT_TRUE(Contains(N.Box, Nodes[i + 1].Box));
+            EXPECT_TRUE(Contains(N.Box, Nodes[N.Offset].Box));
+        }
+    }
+    for (auto Refs : PrimRefs)
+        EXPECT_EQ(Refs, 1);
+
+    // Degenerate case: all boxes are the same
+    std::vector<BoundBox> SameBoxes(100, BoundBox{float3{1, 2, 3}, float3{4, 5, 6}});
+    BVH.Build(SameBoxes.data(), static_cast<Uint32>(SameBoxes.size()), 2);
+    std::vector<Uint32> Visible;
+    BVH.GetVisiblePrimitives(ViewFrustum{}, Visible, FRUSTUM_PLANE_FLAG_NONE);
+    EXPECT_EQ(Visible.size(), SameBoxes.size());
+}
+
+TEST(Common_BoundingVolumeHierarchy, QueryFrustum)
+{
+    const auto Boxes = GenerateRandomBoxes(5000, 2);
+
+    BoundingVolumeHierarchy BVH;
+    BVH.Build(Boxes.data(), static_cast<Uint32>(Boxes.size()));
+
+    const auto Frustum = GetTestFrustum();
+    for (auto Flags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR})
+    {
+        std::vector<BoxVisibility> Visibility(Boxes.size(), BoxVisibility::Invisible);
+        BVH.QueryFrustum(
+            Frustum,
+            [&](Uint32 PrimIdx, BoxVisibility Vis) {
+                EXPECT_EQ(Visibility[PrimIdx], BoxVisibility::Invisible) << "Primitive " << PrimIdx << " is reported twice";
+                Visibility[PrimIdx] = Vis;
+            },
+            Flags);
+
+        size_t NumVisible = 0;
+        for (size_t i = 0; i < Boxes.size(); ++i)
+        {
+            EXPECT_EQ(Visibility[i], GetBoxVisibility(Frustum, Boxes[i], Flags)) << "Primitive " << i;
+            NumVisible += Visibility[i] != BoxVisibility::Invisible ? 1 : 0;
+        }
+        EXPECT_GT(NumVisible, size_t{0});
+        EXPECT_LT(NumVisible, Boxes.size());
+    }
+}
+
+TEST(Common_BoundingVolumeHierarchy, IntersectRay)
+{
+    std::mt19937                          gen{3};
+    std::uniform_real_distribution<float> pos_dist{-20.f, 20.f};
+    std::uniform_real_distribution<float> offset_dist{-2.f, 2.f};
+
+    constexpr Uint32      NumTriangles = 2000;
+    std::vector<float3>   Vertices;
+    std::vector<Uint32>   Indices;
+    std::vector<BoundBox> TriBoxes;
+    for (Uint32 t = 0; t < NumTriangles; ++t)
+    {
+        const float3 Center{pos_dist(gen), pos_dist(gen), pos_dist(gen)};
+
+        BoundBox Box{Center, Center};
+        for (int v = 0; v < 3; ++v)
+        {
+            const float3 Vert = Center + float3{offset_dist(gen), offset_dist(gen), offset_dist(gen)};
+            Indices.push_back(static_cast<Uint32>(Vertices.size()));
+            Vertices.push_back(Vert);
+            Box.Min = std::min(Box.Min, Vert);
+            Box.Max = std::max(Box.Max, Vert);
+        }
+        TriBoxes.push_back(Box);
+    }
+
+    BoundingVolumeHierarchy BVH;
+    BVH.Build(TriBoxes.data(), NumTriangles);
+
+    Uint32 NumHits = 0;
+    for (int r = 0; r < 200; ++r)
+    {
+        const float3 Origin{pos_dist(gen), pos_dist(gen), -30};
+        const float3 Target{pos_dist(gen) * 0.5f, pos_dist(gen) * 0.5f, 0};
+        const float3 Dir = normalize(Target - Origin);
+
+        float  RefDist = +FLT_MAX;
+        Uint32 RefTri  = BoundingVolumeHierarchy::InvalidIndex;
+        for (Uint32 t = 0; t < NumTriangles; ++t)
+        {
+            const float Dist = IntersectRayTriangle(Vertices[Indices[t * 3 + 0]], Vertices[Indices[t * 3 + 1]], Vertices[Indices[t * 3 + 2]], Origin, Dir);
+            if (Dist >= 0 && Dist < RefDist)
+            {
+                RefDist = Dist;
+                RefTri  = t;
+            }
+        }
+
+        float      HitDist = 0;
+        Uint32     HitTri  = 0;
+        const bool IsHit   = BVH.IntersectRayTriangles(Origin, Dir, Vertices.data(), Indices.data(), HitDist, HitTri);
+        EXPECT_EQ(IsHit, RefTri != BoundingVolumeHierarchy::InvalidIndex);
+        EXPECT_EQ(HitTri, RefTri);
+        EXPECT_EQ(HitDist, RefDist);
+        NumHits += IsHit ? 1 : 0;
+    }
+    EXPECT_GT(NumHits, 0u);
+}
+
+} // namespace
@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <string>
+
+#include "MappedFileStream.hpp"
+#include "MappedFileDataBlob.hpp"
+#include "FileWrapper.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "DataBlobImpl.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void WriteTestFile(const Char* Path, const std::vector<Uint8>& Data)
+{
+    FileWrapper File{Path, EFileAccessMode::Overwrite};
+    ASSERT_TRUE(File != nullptr);
+    if (!Data.empty())
+        EXPECT_TRUE(File->Write(Data.data(), Data.size()));
+}
+
+std::vector<Uint8> MakeTestData(size_t Size)
+{
+    std::vector<Uint8> Data(Size);
+    for (size_t i = 0; i < Size; ++i)
+        Data[i] = static_cast<Uint8>((i * 31) ^ (i >> 8));
+    return Data;
+}
+
+TEST(Common_MappedFileStream, Read)
+{
+    const Char* Path = "MappedFileStreamTest.bin";
+    const auto  Data = MakeTestData(100000);
+    WriteTestFile(Path, Data);
+
+    {
+        RefCntAutoPtr<MappedFileStream> pStream{MakeNewRCObj<MappedFileStream>()(Path)};
+        ASSERT_TRUE(pStream->IsValid());
+        EXPECT_EQ(pStream->GetSize(), Data.size());
+
+        auto* pBlob = pStream->GetDataBlob();
+        ASSERT_NE(pBlob, nullptr);
+        ASSERT_EQ(pBlob->GetSize(), Data.size());
+        EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), Data.data(), Data.size()), 0);
+
+        std::vector<Uint8> Header(1000);
+        EXPECT_TRUE(pStream->Read(Header.data(), Header.size()));
+        EXPECT_EQ(memcmp(Header.data(), Data.data(), Header.size()), 0);
+
+        RefCntAutoPtr<IDataBlob> pRest{MakeNewRCObj<DataBlobImpl>()(0)};
+        pStream->ReadBlob(pRest);
+        ASSERT_EQ(pRest->GetSize(), Data.size() - Header.size());
+        EXPECT_EQ(memcmp(pRest->GetConstDataPtr(), Data.data() + Header.size(), pRest->GetSize()), 0);
+
+        Uint8 Byte = 0;
+        EXPECT_FALSE(pStream->Read(&Byte, 1));
+    }
+
+    FileSystem::DeleteFile(Path);
+}
+
+TEST(Common_MappedFileDataBlob, CopyOnWrite)
+{
+    const Char* Path = "MappedFileDataBlobTest.bin";
+    const auto  Data = MakeTestData(5000);
+    WriteTestFile(Path, Data);
+
+    {
+        RefCntAutoPtr<MappedFileDataBlob> pBlob{MakeNewRCObj<MappedFileDataBlob>()(Path)};
+        ASSERT_TRUE(pBlob->IsValid());
+#if PLATFORM_LINUX
+        EXPECT_TRUE(pBlob->IsMapped());
+#endif
+
+        // Writing to the blob must not modify the file
+        auto* pData = static_cast<Uint8*>(pBlob->GetDataPtr());
+        pData[0]    = static_cast<Uint8>(~Data[0]);
+
+        RefCntAutoPtr<MappedFileDataBlob> pBlob2{MakeNewRCObj<MappedFileDataBlob>()(Path)};
+        ASSERT_EQ(pBlob2->GetSize(), Data.size());
+        EXPECT_EQ(memcmp(pBlob2->GetConstDataPtr(), Data.data(), Data.size()), 0);
+
+        // Resizing copies the data and releases the mapping
+        pBlob->Resize(Data.size() + 10);
+        EXPECT_FALSE(pBlob->IsMapped());
+        ASSERT_EQ(pBlob->GetSize(), Data.size() + 10);
+        pData = static_cast<Uint8*>(pBlob->GetDataPtr());
+        EXPECT_EQ(pData[0], static_cast<Uint8>(~Data[0]));
+        EXPECT_EQ(memcmp(pData + 1, Data.data() + 1, Data.size() - 1), 0);
+    }
+
+    FileSystem::DeleteFile(Path);
+}
+
+TEST(Common_MappedFileDataBlob, EmptyFile)
+{
+    const Char* Path = "MappedFileDataBlobEmptyTest.bin";
+    WriteTestFile(Path, {});
+
+    {
+        RefCntAutoPtr<MappedFileDataBlob> pBlob{MakeNewRCObj<MappedFileDataBlob>()(Path)};
+        EXPECT_TRUE(pBlob->IsValid());
+        EXPECT_EQ(pBlob->GetSize(), 0u);
+    }
+
+    FileSystem::DeleteFile(Path);
+}
+
+} // namespace
@@ -25,6 +25,9 @@
  *  of the possibility of such damages.
  */
 
+#include <random>
+#include <vector>
+
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
 
@@ -1083,6 +1086,125 @@ TEST(Common_BasicMath, MatrixMultiply)
     }
 }
 
+// Compares SIMD implementations of the core float4x4 operations with the reference scalar code
+TEST(Common_BasicMath, Float4x4Operations)
+{
+    std::mt19937                          gen{0};
+    std::uniform_real_distribution<float> dist{-10.f, 10.f};
+
+    auto RandomMatrix = [&]() {
+        float4x4 m;
+        for (int i = 0; i < 16; ++i)
+            m.Data()[i] = dist(gen);
+        return m;
+    };
+
+    for (int test = 0; test < 32; ++test)
+    {
+        const auto m1 = RandomMatrix();
+        const auto m2 = RandomMatrix();
+        const auto v  = float4{dist(gen), dist(gen), dist(gen), dist(gen)};
+
+        const auto m = m1 * m2;
+        const auto t = m1.Transpose();
+
+        const auto vm = v * m1;
+        const auto mv = m1 * v;
+        for (int i = 0; i < 4; ++i)
+        {
+            // Reference values are computed in double precision
+            double RefVM = 0, RefMV = 0;
+            for (int k = 0; k < 4; ++k)
+            {
+                RefVM += double{v[k]} * double{m1[k][i]};
+                RefMV += double{m1[i][k]} * double{v[k]};
+            }
+            EXPECT_NEAR(vm[i], RefVM, 1e-3);
+            EXPECT_NEAR(mv[i], RefMV, 1e-3);
+
+            for (int j = 0; j < 4; ++j)
+            {
+                double Ref = 0;
+                for (int k = 0; k < 4; ++k)
+                    Ref += double{m1[i][k]} * double{m2[k][j]};
+                EXPECT_NEAR(m[i][j], Ref, 1e-3);
+                EXPECT_EQ(t[i][j], m1[j][i]);
+            }
+        }
+
+        // Compare with the double-precision scalar implementation
+        const auto inv    = m1.Inverse();
+        const auto RefInv = double4x4::MakeMatrix(m1.Data()).Inverse();
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+                EXPECT_NEAR(inv[i][j], RefInv[i][j], 1e-4 * std::max(1.0, std::abs(RefInv[i][j])));
+        }
+    }
+}
+
+TEST(Common_BasicMath, BatchedOperations)
+{
+    std::mt19937                          gen{0};
+    std::uniform_real_distribution<float> dist{-10.f, 10.f};
+
+    float4x4 m = float4x4::RotationY(0.5f) * float4x4::Translation(1, 2, 3) * float4x4::Projection(1.f, 1.5f, 1.f, 100.f, false);
+
+    // Use odd count to test the remainder processing
+    constexpr size_t Count = 37;
+
+    std::vector<float4> Vectors(Count);
+    std::vector<float3> Points(Count);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        Vectors[i] = float4{dist(gen), dist(gen), dist(gen), dist(gen)};
+        Points[i]  = float3{dist(gen), dist(gen), dist(gen)};
+    }
+
+    {
+        std::vector<float4> Res(Count);
+        TransformVectors(Vectors.data(), Res.data(), Count, m);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(Res[i], Vectors[i] * m);
+
+        // In-place transform
+        Res = Vectors;
+        TransformVectors(Res.data(), Res.data(), Count, m);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(Res[i], Vectors[i] * m);
+    }
+
+    {
+        std::vector<float3> Res(Count);
+        TransformPoints(Points.data(), Res.data(), Count, m);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(Res[i], Points[i] * m);
+    }
+
+    {
+        std::vector<float4x4> LHS(Count), RHS(Count), Res(Count);
+        for (size_t i = 0; i < Count; ++i)
+        {
+            LHS[i] = float4x4::RotationX(dist(gen)) * float4x4::Translation(dist(gen), dist(gen), dist(gen));
+            RHS[i] = float4x4::RotationZ(dist(gen)) * float4x4::Scale(dist(gen));
+        }
+
+        MultiplyMatrices(LHS.data(), RHS.data(), Res.data(), Count);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(Res[i], LHS[i] * RHS[i]);
+
+        MultiplyMatrices(LHS.data(), m, Res.data(), Count);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(Res[i], LHS[i] * m);
+
+        // In-place multiplication
+        Res = LHS;
+        MultiplyMatrices(Res.data(), m, Res.data(), Count);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(Res[i], LHS[i] * m);
+    }
+}
+
 TEST(Common_BasicMath, VectorRecast)
 {
     EXPECT_EQ(float2(1, 2).Recast<int>(), Vector2<int>(1, 2));
@@ -1124,6 +1246,118 @@ TEST(Common_AdvancedMath, Planes)
     EXPECT_NE(std::hash<ViewFrustumExt>{}(frustm_ext), size_t{0});
 }
 
+TEST(Common_AdvancedMath, GetBoxesVisibility)
+{
+    std::mt19937                          gen{0};
+    std::uniform_real_distribution<float> pos_dist{-50.f, 50.f};
+    std::uniform_real_distribution<float> size_dist{0.f, 20.f};
+
+    constexpr size_t      NumBoxes = 1000;
+    std::vector<BoundBox> Boxes(NumBoxes);
+    for (auto& Box : Boxes)
+    {
+        Box.Min = float3{pos_dist(gen), pos_dist(gen), pos_dist(gen)};
+        Box.Max = Box.Min + float3{size_dist(gen), size_dist(gen), size_dist(gen)};
+    }
+
+    const auto ViewProj = float4x4::RotationY(0.3f) * float4x4::Translation(0, 0, 20) * float4x4::Projection(1.f, 1.5f, 1.f, 60.f, false);
+
+    ViewFrustumExt Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+    std::vector<BoxVisibility> Visibilities(NumBoxes);
+    for (auto Flags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_LEFT_PLANE | FRUSTUM_PLANE_FLAG_TOP_PLANE})
+    {
+        size_t NumVisibleBoxes = 0;
+
+        GetBoxesVisibility(static_cast<const ViewFrustum&>(Frustum), Boxes.data(), NumBoxes, Visibilities.data(), Flags);
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            EXPECT_EQ(Visibilities[i], GetBoxVisibility(static_cast<const ViewFrustum&>(Frustum), Boxes[i], Flags));
+            if (Visibilities[i] != BoxVisibility::Invisible)
+                ++NumVisibleBoxes;
+        }
+        // Make sure that the test is not trivial
+        EXPECT_GT(NumVisibleBoxes, size_t{0});
+        EXPECT_LT(NumVisibleBoxes, NumBoxes);
+
+        GetBoxesVisibility(Frustum, Boxes.data(), NumBoxes, Visibilities.data(), Flags);
+        for (size_t i = 0; i < NumBoxes; ++i)
+            EXPECT_EQ(Visibilities[i], GetBoxVisibility(Frustum, Boxes[i], Flags));
+    }
+}
+
+TEST(Common_AdvancedMath, GetBoxesVisibilitySoA)
+{
+    std::mt19937                          gen{0};
+    std::uniform_real_distribution<float> pos_dist{-50.f, 50.f};
+    std::uniform_real_distribution<float> size_dist{0.f, 20.f};
+
+    // Use odd number of boxes to test the remainder processing
+    std::vector<BoundBox> Boxes(1001);
+    for (auto& Box : Boxes)
+    {
+        Box.Min = float3{pos_dist(gen), pos_dist(gen), pos_dist(gen)};
+        Box.Max = Box.Min + float3{size_dist(gen), size_dist(gen), size_dist(gen)};
+    }
+
+    std::vector<float> MinX, MinY, MinZ, MaxX, MaxY, MaxZ;
+    for (const auto& Box : Boxes)
+    {
+        MinX.push_back(Box.Min.x);
+        MinY.push_back(Box.Min.y);
+        MinZ.push_back(Box.Min.z);
+        MaxX.push_back(Box.Max.x);
+        MaxY.push_back(Box.Max.y);
+        MaxZ.push_back(Box.Max.z);
+    }
+
+    BoundBoxArraySoA BoxesSoA;
+    BoxesSoA.MinX     = MinX.data();
+    BoxesSoA.MinY     = MinY.data();
+    BoxesSoA.MinZ     = MinZ.data();
+    BoxesSoA.MaxX     = MaxX.data();
+    BoxesSoA.MaxY     = MaxY.data();
+    BoxesSoA.MaxZ     = MaxZ.data();
+    BoxesSoA.NumBoxes = Boxes.size();
+
+    const auto ViewProj = float4x4::RotationY(0.3f) * float4x4::Translation(0, 0, 20) * float4x4::Projection(1.f, 1.5f, 1.f, 60.f, false);
+
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+    std::vector<Uint32> VisibleMask((Boxes.size() + 31) / 32);
+    std::vector<Uint32> FullyVisibleMask(VisibleMask.size());
+    for (auto Flags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_NONE})
+    {
+        GetBoxesVisibility(Frustum, BoxesSoA, VisibleMask.data(), FullyVisibleMask.data(), Flags);
+
+        size_t NumVisible = 0;
+        for (size_t i = 0; i < Boxes.size(); ++i)
+        {
+            const auto RefVisibility  = GetBoxVisibility(Frustum, Boxes[i], Flags);
+            const bool IsVisible      = (VisibleMask[i / 32] & (1u << (i % 32))) != 0;
+            const bool IsFullyVisible = (FullyVisibleMask[i / 32] & (1u << (i % 32))) != 0;
+            EXPECT_EQ(IsVisible, RefVisibility != BoxVisibility::Invisible) << "Box " << i;
+            EXPECT_EQ(IsFullyVisible, RefVisibility == BoxVisibility::FullyVisible) << "Box " << i;
+            NumVisible += IsVisible ? 1 : 0;
+        }
+        if (Flags == FRUSTUM_PLANE_FLAG_NONE)
+            EXPECT_EQ(NumVisible, Boxes.size());
+        else
+            EXPECT_LT(NumVisible, Boxes.size());
+        EXPECT_GT(NumVisible, size_t{0});
+
+        // Unused bits of the last mask element must be zero
+        EXPECT_EQ(VisibleMask.back() >> (Boxes.size() % 32), 0u);
+    }
+
+    // Visible mask only
+    GetBoxesVisibility(Frustum, BoxesSoA, VisibleMask.data());
+    for (size_t i = 0; i < Boxes.size(); ++i)
+        EXPECT_EQ((VisibleMask[i / 32] & (1u << (i % 32))) != 0, GetBoxVisibility(Frustum, Boxes[i]) != BoxVisibility::Invisible);
+}
+
 TEST(Common_AdvancedMath, HermiteSpline)
 {
     EXPECT_NE(HermiteSpline(float3(1, 2, 3), float3(4, 5, 6), float3(7, 8, 9), float3(10, 11, 12), 0.1f), float3(0, 0, 0));
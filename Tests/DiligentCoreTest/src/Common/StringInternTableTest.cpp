@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "StringInternTable.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_StringInternTable, Intern)
+{
+    StringInternTable Table{256};
+
+    std::string Name1{"g_Texture"};
+    std::string Name2{"g_Texture"};
+
+    auto Str1 = Table.Intern(Name1.c_str());
+    auto Str2 = Table.Intern(Name2.c_str());
+    EXPECT_TRUE(Str1);
+    EXPECT_EQ(Str1, Str2);
+    EXPECT_EQ(Str1.GetStr(), Str2.GetStr());
+    EXPECT_NE(Str1.GetStr(), Name1.c_str());
+    EXPECT_STREQ(Str1.GetStr(), "g_Texture");
+    EXPECT_EQ(Str1.GetHash(), CStringHash<Char>{}("g_Texture"));
+    EXPECT_EQ(StringInternTable::GetInternedHash(Str1.GetStr()), Str1.GetHash());
+
+    auto Str3 = Table.Intern("g_Sampler", CStringHash<Char>{}("g_Sampler"));
+    EXPECT_NE(Str1, Str3);
+    EXPECT_STREQ(Str3.GetStr(), "g_Sampler");
+    EXPECT_EQ(Table.GetNumStrings(), 2u);
+
+    auto Empty = Table.Intern("");
+    EXPECT_TRUE(Empty);
+    EXPECT_STREQ(Empty.GetStr(), "");
+    EXPECT_EQ(Empty, Table.Intern(""));
+    EXPECT_EQ(Table.GetNumStrings(), 3u);
+
+    InternedString Null;
+    EXPECT_FALSE(Null);
+    EXPECT_EQ(Null.GetHash(), 0u);
+}
+
+TEST(Common_StringInternTable, Find)
+{
+    StringInternTable Table;
+
+    EXPECT_FALSE(Table.Find("g_Buffer"));
+    auto Str = Table.Intern("g_Buffer");
+    EXPECT_EQ(Table.Find("g_Buffer"), Str);
+    EXPECT_FALSE(Table.Find("g_Buffer2"));
+    EXPECT_EQ(Table.GetNumStrings(), 1u);
+}
+
+TEST(Common_StringInternTable, LongStrings)
+{
+    StringInternTable Table{64};
+
+    std::vector<std::string>    Strings;
+    std::vector<InternedString> Handles;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        Strings.emplace_back(i * 7 + 1, static_cast<char>('a' + i % 26));
+        Strings.back() += std::to_string(i);
+        Handles.emplace_back(Table.Intern(Strings.back().c_str()));
+    }
+    EXPECT_EQ(Table.GetNumStrings(), Strings.size());
+    EXPECT_GE(Table.GetMemorySize(), Strings.back().length());
+
+    // Strings must not move when new pages are allocated
+    for (size_t i = 0; i < Strings.size(); ++i)
+    {
+        EXPECT_STREQ(Handles[i].GetStr(), Strings[i].c_str());
+        EXPECT_EQ(Handles[i].GetHash(), CStringHash<Char>{}(Strings[i].c_str()));
+        EXPECT_EQ(Table.Intern(Strings[i].c_str()), Handles[i]);
+    }
+}
+
+TEST(Common_StringInternTable, Multithreading)
+{
+    StringInternTable Table{512};
+
+    const size_t NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+    const size_t NumStrings = 1000;
+
+    std::vector<std::vector<InternedString>> Handles(NumThreads);
+
+    std::vector<std::thread> Threads;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            auto& ThreadHandles = Handles[t];
+            ThreadHandles.resize(NumStrings);
+            // Every thread interns the same strings in a different order
+            for (size_t i = 0; i < NumStrings; ++i)
+            {
+                const auto Idx     = (i + t * 37) % NumStrings;
+                const auto Str     = "Resource_" + std::to_string(Idx);
+                ThreadHandles[Idx] = Table.Intern(Str.c_str());
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Table.GetNumStrings(), NumStrings);
+    for (size_t i = 0; i < NumStrings; ++i)
+    {
+        EXPECT_EQ(Handles[0][i].GetStr(), ("Resource_" + std::to_string(i)));
+        for (size_t t = 1; t < NumThreads; ++t)
+            EXPECT_EQ(Handles[t][i], Handles[0][i]);
+    }
+}
+
+TEST(Common_StringInternTable, Global)
+{
+    auto& Table = StringInternTable::GetGlobal();
+    EXPECT_EQ(&Table, &StringInternTable::GetGlobal());
+    EXPECT_EQ(Table.Intern("StringInternTableTest"), Table.Intern("StringInternTableTest"));
+}
+
+} // namespace
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "WorkerThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_WorkerThreadPool, ParallelFor)
+{
+    WorkerThreadPool Pool{3};
+    EXPECT_EQ(Pool.GetNumThreads(), 3u);
+
+    Pool.ParallelFor(0, [](Uint32) { ADD_FAILURE() << "No tasks must run"; });
+
+    for (Uint32 NumTasks : {1u, 2u, 4u, 17u, 1000u})
+    {
+        std::vector<std::atomic<int>> NumRuns(NumTasks);
+        for (auto& Runs : NumRuns)
+            Runs.store(0);
+
+        Pool.ParallelFor(NumTasks, [&](Uint32 Task) { NumRuns[Task].fetch_add(1); });
+        for (Uint32 Task = 0; Task < NumTasks; ++Task)
+            EXPECT_EQ(NumRuns[Task].load(), 1) << "Task " << Task;
+    }
+}
+
+TEST(Common_WorkerThreadPool, ReusesThreads)
+{
+    constexpr Uint32 NumThreads = 3;
+
+    WorkerThreadPool Pool{NumThreads};
+
+    std::mutex                Mtx;
+    std::set<std::thread::id> ThreadIds;
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        // Every task waits until all tasks have started, so all pool threads must participate
+        std::atomic<Uint32> NumStarted{0};
+        Pool.ParallelFor(NumThreads + 1, [&](Uint32) {
+            NumStarted.fetch_add(1);
+            while (NumStarted.load() < NumThreads + 1)
+                std::this_thread::yield();
+
+            std::lock_guard<std::mutex> Lock{Mtx};
+            ThreadIds.insert(std::this_thread::get_id());
+        });
+    }
+
+    // The calling thread and the same worker threads run the tasks of all loops
+    EXPECT_EQ(ThreadIds.size(), size_t{NumThreads + 1});
+    EXPECT_EQ(ThreadIds.count(std::this_thread::get_id()), 1u);
+}
+
+TEST(Common_WorkerThreadPool, Nested)
+{
+    // The calling thread runs the tasks itself, so nested loops complete even when all workers are busy
+    for (Uint32 NumThreads : {0u, 1u, 4u})
+    {
+        WorkerThreadPool Pool{NumThreads};
+
+        std::atomic<Uint32> Sum{0};
+        Pool.ParallelFor(8, [&](Uint32 Outer) {
+            Pool.ParallelFor(8, [&](Uint32 Inner) { Sum.fetch_add(Outer * 8 + Inner); });
+        });
+        EXPECT_EQ(Sum.load(), 64u * 63u / 2u);
+    }
+}
+
+} // namespace
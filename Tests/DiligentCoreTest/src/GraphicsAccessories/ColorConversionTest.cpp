@@ -0,0 +1,328 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "BasicMath.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+Uint8 ToUnorm8(float x)
+{
+    return static_cast<Uint8>(clamp(x, 0.f, 1.f) * 255.f + 0.5f);
+}
+
+// Scalar reference conversion of a single RGBA pixel
+void DecodeReference(const void* pSrc, TEXTURE_FORMAT Format, float Color[4])
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_RGBA8_UNORM:
+        case TEX_FORMAT_BGRA8_UNORM:
+        case TEX_FORMAT_RGBA8_UNORM_SRGB:
+        case TEX_FORMAT_BGRA8_UNORM_SRGB:
+        {
+            const auto* pBytes = static_cast<const Uint8*>(pSrc);
+            const bool  IsSRGB = Format == TEX_FORMAT_RGBA8_UNORM_SRGB || Format == TEX_FORMAT_BGRA8_UNORM_SRGB;
+            for (int c = 0; c < 4; ++c)
+                Color[c] = (IsSRGB && c < 3) ? SRGBToLinear(pBytes[c]) : static_cast<float>(pBytes[c]) / 255.f;
+            if (Format == TEX_FORMAT_BGRA8_UNORM || Format == TEX_FORMAT_BGRA8_UNORM_SRGB)
+                std::swap(Color[0], Color[2]);
+            break;
+        }
+
+        case TEX_FORMAT_RGBA16_FLOAT:
+            for (int c = 0; c < 4; ++c)
+                Color[c] = HalfToFloat(static_cast<const Uint16*>(pSrc)[c]);
+            break;
+
+        case TEX_FORMAT_RGBA32_FLOAT:
+            memcpy(Color, pSrc, 16);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected format");
+    }
+}
+
+const TEXTURE_FORMAT TestFormats[] =
+    {
+        TEX_FORMAT_RGBA8_UNORM,
+        TEX_FORMAT_RGBA8_UNORM_SRGB,
+        TEX_FORMAT_BGRA8_UNORM,
+        TEX_FORMAT_BGRA8_UNORM_SRGB,
+        TEX_FORMAT_RGBA16_FLOAT,
+        TEX_FORMAT_RGBA32_FLOAT //
+};
+
+std::vector<Uint8> MakeRandomPixels(TEXTURE_FORMAT Format, Uint32 NumPixels)
+{
+    std::mt19937                          Gen{0};
+    std::uniform_int_distribution<Uint32> ByteDistr{0, 255};
+    std::uniform_real_distribution<float> FloatDistr{-0.25f, 1.25f};
+
+    std::vector<Uint8> Pixels;
+    if (Format == TEX_FORMAT_RGBA16_FLOAT || Format == TEX_FORMAT_RGBA32_FLOAT)
+    {
+        std::vector<float> Values(NumPixels * 4);
+        for (auto& Val : Values)
+            Val = FloatDistr(Gen);
+        if (Format == TEX_FORMAT_RGBA32_FLOAT)
+        {
+            Pixels.resize(Values.size() * 4);
+            memcpy(Pixels.data(), Values.data(), Pixels.size());
+        }
+        else
+        {
+            Pixels.resize(Values.size() * 2);
+            auto* pHalfs = reinterpret_cast<Uint16*>(Pixels.data());
+            for (size_t i = 0; i < Values.size(); ++i)
+                pHalfs[i] = FloatToHalf(Values[i]);
+        }
+    }
+    else
+    {
+        Pixels.resize(NumPixels * 4);
+        for (auto& Byte : Pixels)
+            Byte = static_cast<Uint8>(ByteDistr(Gen));
+    }
+    return Pixels;
+}
+
+Uint32 GetPixelSize(TEXTURE_FORMAT Format)
+{
+    return Format == TEX_FORMAT_RGBA32_FLOAT ? 16 : (Format == TEX_FORMAT_RGBA16_FLOAT ? 8 : 4);
+}
+
+TEST(GraphicsAccessories_ColorConversion, HalfFloat)
+{
+    EXPECT_EQ(FloatToHalf(0.f), 0x0000);
+    EXPECT_EQ(FloatToHalf(-0.f), 0x8000);
+    EXPECT_EQ(FloatToHalf(1.f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(-2.f), 0xC000);
+    EXPECT_EQ(FloatToHalf(65504.f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(65520.f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(1e10f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(std::pow(2.f, -24.f)), 0x0001);
+    EXPECT_EQ(FloatToHalf(std::pow(2.f, -26.f)), 0x0000);
+    EXPECT_EQ(FloatToHalf(std::pow(2.f, -14.f)), 0x0400);
+    // 1 + 2^-11 is halfway between 1 and the next half value and rounds to even
+    EXPECT_EQ(FloatToHalf(1.f + std::pow(2.f, -11.f)), 0x3C00);
+    EXPECT_EQ(FloatToHalf(1.f + 3.f * std::pow(2.f, -11.f)), 0x3C02);
+
+    EXPECT_EQ(HalfToFloat(0x3C00), 1.f);
+    EXPECT_EQ(HalfToFloat(0xC000), -2.f);
+    EXPECT_EQ(HalfToFloat(0x0001), std::pow(2.f, -24.f));
+    EXPECT_EQ(HalfToFloat(0x7BFF), 65504.f);
+    EXPECT_TRUE(std::isinf(HalfToFloat(0x7C00)));
+    EXPECT_TRUE(std::isnan(HalfToFloat(0x7E00)));
+    EXPECT_TRUE(std::isnan(HalfToFloat(FloatToHalf(std::nanf("")))));
+
+    // All finite half values must survive the round trip
+    for (Uint32 h = 0; h < 0x10000; ++h)
+    {
+        if ((h & 0x7C00) == 0x7C00)
+            continue;
+        EXPECT_EQ(FloatToHalf(HalfToFloat(static_cast<Uint16>(h))), h);
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, IsColorConversionSupported)
+{
+    for (auto SrcFmt : TestFormats)
+    {
+        for (auto DstFmt : TestFormats)
+            EXPECT_TRUE(IsColorConversionSupported(SrcFmt, DstFmt));
+    }
+    EXPECT_FALSE(IsColorConversionSupported(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_TYPELESS));
+    EXPECT_FALSE(IsColorConversionSupported(TEX_FORMAT_RG8_UNORM, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_FALSE(IsColorConversionSupported(TEX_FORMAT_BGRX8_UNORM, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_FALSE(IsColorConversionSupported(TEX_FORMAT_RGBA8_UINT, TEX_FORMAT_RGBA8_UNORM));
+}
+
+TEST(GraphicsAccessories_ColorConversion, ConvertPixels)
+{
+    // Odd number of pixels to exercise vectorized loops as well as the remainders
+    constexpr Uint32 NumPixels = 1027;
+
+    for (auto SrcFmt : TestFormats)
+    {
+        const auto SrcPixels = MakeRandomPixels(SrcFmt, NumPixels);
+        for (auto DstFmt : TestFormats)
+        {
+            const auto         DstPixelSize = GetPixelSize(DstFmt);
+            std::vector<Uint8> DstPixels(NumPixels * DstPixelSize);
+            EXPECT_TRUE(ConvertPixels(SrcPixels.data(), SrcFmt, DstPixels.data(), DstFmt, NumPixels));
+
+            for (Uint32 i = 0; i < NumPixels; ++i)
+            {
+                float Color[4];
+                DecodeReference(&SrcPixels[i * GetPixelSize(SrcFmt)], SrcFmt, Color);
+                const auto* pDst = &DstPixels[i * DstPixelSize];
+                if (DstFmt == TEX_FORMAT_RGBA32_FLOAT || DstFmt == TEX_FORMAT_RGBA16_FLOAT)
+                {
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        const float Ref = DstFmt == TEX_FORMAT_RGBA32_FLOAT ? Color[c] : HalfToFloat(FloatToHalf(Color[c]));
+                        const float Val = DstFmt == TEX_FORMAT_RGBA32_FLOAT ? reinterpret_cast<const float*>(pDst)[c] : HalfToFloat(reinterpret_cast<const Uint16*>(pDst)[c]);
+                        ASSERT_EQ(Val, Ref) << GetTextureFormatAttribs(SrcFmt).Name << " -> " << GetTextureFormatAttribs(DstFmt).Name << ", pixel " << i << ", component " << c;
+                    }
+                }
+                else
+                {
+                    const bool IsSRGB = DstFmt == TEX_FORMAT_RGBA8_UNORM_SRGB || DstFmt == TEX_FORMAT_BGRA8_UNORM_SRGB;
+                    if (DstFmt == TEX_FORMAT_BGRA8_UNORM || DstFmt == TEX_FORMAT_BGRA8_UNORM_SRGB)
+                        std::swap(Color[0], Color[2]);
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        const float Val = (IsSRGB && c < 3) ? LinearToSRGB(clamp(Color[c], 0.f, 1.f)) : Color[c];
+                        // Allow one unit difference for values that are close to the rounding boundary
+                        ASSERT_NEAR(pDst[c], ToUnorm8(Val), 1) << GetTextureFormatAttribs(SrcFmt).Name << " -> " << GetTextureFormatAttribs(DstFmt).Name << ", pixel " << i << ", component " << c;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, SRGBRoundTrip)
+{
+    std::vector<Uint8> Pixels(256 * 4);
+    for (Uint32 i = 0; i < 256; ++i)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            Pixels[i * 4 + c] = static_cast<Uint8>(i);
+    }
+
+    for (auto Fmt : {TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_RGBA16_FLOAT})
+    {
+        std::vector<Uint8> Linear(256 * GetPixelSize(Fmt));
+        std::vector<Uint8> SRGB(Pixels.size());
+        EXPECT_TRUE(ConvertPixels(Pixels.data(), TEX_FORMAT_RGBA8_UNORM_SRGB, Linear.data(), Fmt, 256));
+        EXPECT_TRUE(ConvertPixels(Linear.data(), Fmt, SRGB.data(), TEX_FORMAT_BGRA8_UNORM_SRGB, 256));
+        for (Uint32 i = 0; i < 256; ++i)
+        {
+            EXPECT_EQ(SRGB[i * 4 + 0], i);
+            EXPECT_EQ(SRGB[i * 4 + 3], i);
+        }
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, PremultiplyAlpha)
+{
+    constexpr Uint32 NumPixels = 259;
+
+    const auto         SrcPixels = MakeRandomPixels(TEX_FORMAT_RGBA8_UNORM, NumPixels);
+    std::vector<Uint8> DstPixels(SrcPixels.size());
+    EXPECT_TRUE(ConvertPixels(SrcPixels.data(), TEX_FORMAT_RGBA8_UNORM, DstPixels.data(), TEX_FORMAT_BGRA8_UNORM, NumPixels, COLOR_CONVERSION_FLAG_PREMULTIPLY_ALPHA));
+    for (Uint32 i = 0; i < NumPixels; ++i)
+    {
+        const Uint32 A = SrcPixels[i * 4 + 3];
+        EXPECT_EQ(DstPixels[i * 4 + 0], (SrcPixels[i * 4 + 2] * A + 127) / 255);
+        EXPECT_EQ(DstPixels[i * 4 + 1], (SrcPixels[i * 4 + 1] * A + 127) / 255);
+        EXPECT_EQ(DstPixels[i * 4 + 2], (SrcPixels[i * 4 + 0] * A + 127) / 255);
+        EXPECT_EQ(DstPixels[i * 4 + 3], A);
+    }
+
+    std::vector<float> FloatPixels(NumPixels * 4);
+    EXPECT_TRUE(ConvertPixels(SrcPixels.data(), TEX_FORMAT_RGBA8_UNORM_SRGB, FloatPixels.data(), TEX_FORMAT_RGBA32_FLOAT, NumPixels, COLOR_CONVERSION_FLAG_PREMULTIPLY_ALPHA));
+    for (Uint32 i = 0; i < NumPixels; ++i)
+    {
+        const float A = static_cast<float>(SrcPixels[i * 4 + 3]) / 255.f;
+        for (Uint32 c = 0; c < 3; ++c)
+            EXPECT_FLOAT_EQ(FloatPixels[i * 4 + c], SRGBToLinear(SrcPixels[i * 4 + c]) * A);
+        EXPECT_FLOAT_EQ(FloatPixels[i * 4 + 3], A);
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, InPlace)
+{
+    constexpr Uint32 NumPixels = 131;
+
+    auto Pixels = MakeRandomPixels(TEX_FORMAT_RGBA8_UNORM_SRGB, NumPixels);
+
+    std::vector<Uint8> RefPixels(Pixels.size());
+    EXPECT_TRUE(ConvertPixels(Pixels.data(), TEX_FORMAT_RGBA8_UNORM_SRGB, RefPixels.data(), TEX_FORMAT_BGRA8_UNORM, NumPixels));
+    EXPECT_TRUE(ConvertPixels(Pixels.data(), TEX_FORMAT_RGBA8_UNORM_SRGB, Pixels.data(), TEX_FORMAT_BGRA8_UNORM, NumPixels));
+    EXPECT_EQ(Pixels, RefPixels);
+}
+
+TEST(GraphicsAccessories_ColorConversion, ConvertImage)
+{
+    constexpr Uint32 Width     = 517;
+    constexpr Uint32 Height    = 1031;
+    constexpr Uint32 DstStride = Width * 8 + 24;
+
+    const auto SrcPixels = MakeRandomPixels(TEX_FORMAT_BGRA8_UNORM_SRGB, Width * Height);
+
+    ColorConversionAttribs Attribs;
+    Attribs.pSrcData  = SrcPixels.data();
+    Attribs.SrcStride = Width * 4;
+    Attribs.SrcFormat = TEX_FORMAT_BGRA8_UNORM_SRGB;
+    Attribs.DstStride = DstStride;
+    Attribs.DstFormat = TEX_FORMAT_RGBA16_FLOAT;
+    Attribs.Width     = Width;
+    Attribs.Height    = Height;
+    Attribs.Flags     = COLOR_CONVERSION_FLAG_PREMULTIPLY_ALPHA;
+
+    std::vector<Uint8> RefPixels(DstStride * Height);
+    Attribs.pDstData   = RefPixels.data();
+    Attribs.MaxThreads = 1;
+    EXPECT_TRUE(ConvertImage(Attribs));
+
+    std::vector<Uint8> DstPixels(DstStride * Height);
+    Attribs.pDstData   = DstPixels.data();
+    Attribs.MaxThreads = 4;
+    EXPECT_TRUE(ConvertImage(Attribs));
+
+    EXPECT_EQ(DstPixels, RefPixels);
+
+    for (Uint32 row = 0; row < Height; row += 97)
+    {
+        std::vector<Uint8> RowPixels(Width * 8);
+        EXPECT_TRUE(ConvertPixels(&SrcPixels[row * Width * 4], TEX_FORMAT_BGRA8_UNORM_SRGB, RowPixels.data(), TEX_FORMAT_RGBA16_FLOAT, Width, COLOR_CONVERSION_FLAG_PREMULTIPLY_ALPHA));
+        EXPECT_EQ(memcmp(RowPixels.data(), &RefPixels[row * DstStride], RowPixels.size()), 0);
+    }
+
+    // Row sizes that do not fit into 32 bits must be rejected rather than wrap around
+    Attribs.Width     = 0x40000001u;
+    Attribs.Height    = 2;
+    Attribs.SrcStride = 16;
+    Attribs.DstStride = 16;
+    EXPECT_FALSE(ConvertImage(Attribs));
+}
+
+} // namespace
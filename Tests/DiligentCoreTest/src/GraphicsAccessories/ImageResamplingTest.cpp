@@ -0,0 +1,553 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "ImageResampling.hpp"
+#include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "BasicMath.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::vector<Uint8> GenerateRandomImage(Uint32 Width, Uint32 Height, Uint32 PixelSize, Uint32 Seed)
+{
+    std::mt19937                          Gen{Seed};
+    std::uniform_int_distribution<Uint32> ByteDistr{0, 255};
+
+    std::vector<Uint8> Data(size_t{Width} * Height * PixelSize);
+    for (auto& Byte : Data)
+        Byte = static_cast<Uint8>(ByteDistr(Gen));
+    return Data;
+}
+
+// Scalar reference 2x box downsampling of an RGBA8_UNORM image that performs the
+// same floating-point operations as the separable filter.
+std::vector<Uint8> BoxDownsampleReference(const std::vector<Uint8>& Src, Uint32 Width, Uint32 Height)
+{
+    const Uint32 DstWidth  = std::max(Width / 2, 1u);
+    const Uint32 DstHeight = std::max(Height / 2, 1u);
+
+    const auto Fetch = [&](Uint32 x, Uint32 y, Uint32 c) {
+        x = std::min(x, Width - 1);
+        y = std::min(y, Height - 1);
+        return static_cast<float>(Src[(size_t{y} * Width + x) * 4 + c]) / 255.f;
+    };
+
+    const float wx = Width > 1 ? 0.5f : 1.f;
+    const float wy = Height > 1 ? 0.5f : 1.f;
+
+    std::vector<Uint8> Dst(size_t{DstWidth} * DstHeight * 4);
+    for (Uint32 y = 0; y < DstHeight; ++y)
+    {
+        for (Uint32 x = 0; x < DstWidth; ++x)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                float h0 = 0, h1 = 0;
+                h0 = h0 + wx * Fetch(x * 2, y * 2, c);
+                h1 = h1 + wx * Fetch(x * 2, y * 2 + 1, c);
+                if (Width > 1)
+                {
+                    h0 = h0 + wx * Fetch(x * 2 + 1, y * 2, c);
+                    h1 = h1 + wx * Fetch(x * 2 + 1, y * 2 + 1, c);
+                }
+                float v = 0;
+                v       = v + wy * h0;
+                if (Height > 1)
+                    v = v + wy * h1;
+
+                Dst[(size_t{y} * DstWidth + x) * 4 + c] = static_cast<Uint8>(clamp(v, 0.f, 1.f) * 255.f + 0.5f);
+            }
+        }
+    }
+    return Dst;
+}
+
+// Double-precision reference implementation of the Kaiser and Lanczos filters with clamp addressing
+double RefSinc(double x)
+{
+    if (std::abs(x) < 1e-6)
+        return 1.0;
+    x *= PI;
+    return std::sin(x) / x;
+}
+
+double RefBesselI0(double x)
+{
+    double Sum  = 1.0;
+    double Term = 1.0;
+    for (int k = 1; k < 64; ++k)
+    {
+        Term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        Sum += Term;
+    }
+    return Sum;
+}
+
+double RefKernel(IMAGE_FILTER_TYPE Filter, double x)
+{
+    // Both filters have the radius of 3 pixels; Kaiser window uses alpha = 4
+    if (std::abs(x) >= 3.0)
+        return 0.0;
+    if (Filter == IMAGE_FILTER_KAISER)
+        return RefSinc(x) * RefBesselI0(4.0 * std::sqrt(1.0 - (x / 3.0) * (x / 3.0))) / RefBesselI0(4.0);
+    else
+        return RefSinc(x) * RefSinc(x / 3.0);
+}
+
+// Resamples a single-channel image without clamping or quantizing the result
+std::vector<double> RefResample(const std::vector<double>& Src, Uint32 SrcWidth, Uint32 SrcHeight, Uint32 DstWidth, Uint32 DstHeight, IMAGE_FILTER_TYPE Filter)
+{
+    // Returns (index, weight) pairs of the source pixels that contribute to destination pixel x
+    const auto ComputeTaps = [Filter](Uint32 SrcSize, Uint32 DstSize, Uint32 x) {
+        const double Scale       = static_cast<double>(SrcSize) / DstSize;
+        const double FilterScale = std::max(Scale, 1.0);
+        const double Radius      = 3.0 * FilterScale;
+        const double Center      = (x + 0.5) * Scale;
+
+        std::vector<std::pair<Uint32, double>> Taps;
+        double                                 TotalWeight = 0;
+        for (int i = static_cast<int>(std::floor(Center - Radius)); i <= static_cast<int>(std::ceil(Center + Radius)); ++i)
+        {
+            const double Weight = RefKernel(Filter, (i + 0.5 - Center) / FilterScale);
+            Taps.emplace_back(static_cast<Uint32>(clamp(i, 0, static_cast<int>(SrcSize) - 1)), Weight);
+            TotalWeight += Weight;
+        }
+        for (auto& Tap : Taps)
+            Tap.second /= TotalWeight;
+        return Taps;
+    };
+
+    std::vector<double> Horz(size_t{DstWidth} * SrcHeight);
+    for (Uint32 x = 0; x < DstWidth; ++x)
+    {
+        for (const auto& Tap : ComputeTaps(SrcWidth, DstWidth, x))
+        {
+            for (Uint32 y = 0; y < SrcHeight; ++y)
+                Horz[size_t{y} * DstWidth + x] += Tap.second * Src[size_t{y} * SrcWidth + Tap.first];
+        }
+    }
+
+    std::vector<double> Dst(size_t{DstWidth} * DstHeight);
+    for (Uint32 y = 0; y < DstHeight; ++y)
+    {
+        for (const auto& Tap : ComputeTaps(SrcHeight, DstHeight, y))
+        {
+            for (Uint32 x = 0; x < DstWidth; ++x)
+                Dst[size_t{y} * DstWidth + x] += Tap.second * Horz[size_t{Tap.first} * DstWidth + x];
+        }
+    }
+    return Dst;
+}
+
+TEST(GraphicsAccessories_ImageResampling, IsImageResamplingSupported)
+{
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_BGRA8_UNORM_SRGB));
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_RG16_FLOAT));
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_RGB32_FLOAT));
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_R16_SNORM));
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_R32_UINT));
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_D16_UNORM));
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_D32_FLOAT));
+
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_UNKNOWN));
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_RGBA8_TYPELESS));
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_BC1_UNORM));
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_RGB10A2_UNORM));
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_D24_UNORM_S8_UINT));
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_R1_UNORM));
+}
+
+TEST(GraphicsAccessories_ImageResampling, BoxMipChain)
+{
+    // Non-square image whose width reaches 1 before the height
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 256;
+
+    const auto Src = GenerateRandomImage(Width, Height, 4, 0);
+
+    const Uint32 NumMips = ComputeMipLevelsCount(Width, Height) - 1;
+
+    std::vector<std::vector<Uint8>> Mips(NumMips);
+    std::vector<MipLevelData>       MipData(NumMips);
+    for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+    {
+        const Uint32 MipWidth  = std::max(Width >> (Mip + 1), 1u);
+        const Uint32 MipHeight = std::max(Height >> (Mip + 1), 1u);
+        Mips[Mip].resize(size_t{MipWidth} * MipHeight * 4);
+        MipData[Mip].pData  = Mips[Mip].data();
+        MipData[Mip].Stride = MipWidth * 4;
+    }
+
+    MipChainGenerationAttribs Attribs;
+    Attribs.pSrcData     = Src.data();
+    Attribs.SrcStride    = Width * 4;
+    Attribs.Width        = Width;
+    Attribs.Height       = Height;
+    Attribs.Format       = TEX_FORMAT_RGBA8_UNORM;
+    Attribs.NumMipLevels = NumMips;
+    Attribs.pMipLevels   = MipData.data();
+    Attribs.Filter       = IMAGE_FILTER_BOX;
+    ASSERT_TRUE(GenerateMipChain(Attribs));
+
+    // The results must be bit-exact with the scalar reference
+    const std::vector<Uint8>* pPrevLevel = &Src;
+    for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+    {
+        const auto Ref = BoxDownsampleReference(*pPrevLevel, std::max(Width >> Mip, 1u), std::max(Height >> Mip, 1u));
+        EXPECT_EQ(Ref, Mips[Mip]) << "Mip level " << Mip + 1;
+        pPrevLevel = &Mips[Mip];
+    }
+}
+
+TEST(GraphicsAccessories_ImageResampling, FilteredMipChain)
+{
+    constexpr Uint32 Width  = 96;
+    constexpr Uint32 Height = 64;
+
+    // Random blocks of black and white pixels. Sharp edges produce strong ringing that
+    // is clipped when the levels are quantized.
+    std::mt19937                          Gen{2};
+    std::uniform_int_distribution<Uint32> BitDistr{0, 1};
+
+    constexpr Uint32   BlockSize = 5;
+    std::vector<Uint8> Blocks(size_t{Width / BlockSize + 1} * (Height / BlockSize + 1));
+    for (auto& Block : Blocks)
+        Block = static_cast<Uint8>(BitDistr(Gen) * 255);
+
+    std::vector<Uint8>  Src(size_t{Width} * Height);
+    std::vector<double> RefSrc(Src.size());
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            const auto Value      = Blocks[(y / BlockSize) * (Width / BlockSize + 1) + x / BlockSize];
+            Src[y * Width + x]    = Value;
+            RefSrc[y * Width + x] = Value / 255.0;
+        }
+    }
+
+    const Uint32 NumMips = ComputeMipLevelsCount(Width, Height) - 1;
+    for (auto Filter : {IMAGE_FILTER_KAISER, IMAGE_FILTER_LANCZOS})
+    {
+        std::vector<std::vector<Uint8>> Mips(NumMips);
+        std::vector<MipLevelData>       MipData(NumMips);
+        for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+        {
+            const Uint32 MipWidth = std::max(Width >> (Mip + 1), 1u);
+            Mips[Mip].resize(size_t{MipWidth} * std::max(Height >> (Mip + 1), 1u));
+            MipData[Mip].pData  = Mips[Mip].data();
+            MipData[Mip].Stride = MipWidth;
+        }
+
+        MipChainGenerationAttribs Attribs;
+        Attribs.pSrcData     = Src.data();
+        Attribs.SrcStride    = Width;
+        Attribs.Width        = Width;
+        Attribs.Height       = Height;
+        Attribs.Format       = TEX_FORMAT_R8_UNORM;
+        Attribs.NumMipLevels = NumMips;
+        Attribs.pMipLevels   = MipData.data();
+        Attribs.Filter       = Filter;
+        ASSERT_TRUE(GenerateMipChain(Attribs));
+
+        // Every level must match the reference that is computed from the unquantized previous level
+        auto RefLevel = RefSrc;
+        for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+        {
+            const Uint32 SrcWidth  = std::max(Width >> Mip, 1u);
+            const Uint32 SrcHeight = std::max(Height >> Mip, 1u);
+            const Uint32 DstWidth  = std::max(Width >> (Mip + 1), 1u);
+            const Uint32 DstHeight = std::max(Height >> (Mip + 1), 1u);
+            RefLevel               = RefResample(RefLevel, SrcWidth, SrcHeight, DstWidth, DstHeight, Filter);
+
+            int MaxError = 0;
+            for (size_t i = 0; i < RefLevel.size(); ++i)
+            {
+                const int Ref = static_cast<int>(clamp(RefLevel[i], 0.0, 1.0) * 255.0 + 0.5);
+                MaxError      = std::max(MaxError, std::abs(Ref - static_cast<int>(Mips[Mip][i])));
+            }
+            EXPECT_LE(MaxError, 1) << "Filter " << static_cast<Uint32>(Filter) << ", mip level " << Mip + 1;
+        }
+    }
+}
+
+TEST(GraphicsAccessories_ImageResampling, InvalidMipLevelCount)
+{
+    const Uint8 Src[4 * 2] = {};
+
+    Uint8 Mip1[2] = {};
+    Uint8 Mip2[1] = {};
+
+    MipLevelData MipData[3];
+    MipData[0].pData  = Mip1;
+    MipData[0].Stride = 2;
+    MipData[1].pData  = Mip2;
+    MipData[1].Stride = 1;
+    MipData[2]        = MipData[1];
+
+    MipChainGenerationAttribs Attribs;
+    Attribs.pSrcData     = Src;
+    Attribs.SrcStride    = 4;
+    Attribs.Width        = 4;
+    Attribs.Height       = 2;
+    Attribs.Format       = TEX_FORMAT_R8_UNORM;
+    Attribs.pMipLevels   = MipData;
+    Attribs.NumMipLevels = 2;
+    EXPECT_TRUE(GenerateMipChain(Attribs));
+
+    // A 4x2 image has only two mip levels below the most detailed one
+    Attribs.NumMipLevels = 3;
+    EXPECT_FALSE(GenerateMipChain(Attribs));
+    Attribs.NumMipLevels = 40;
+    EXPECT_FALSE(GenerateMipChain(Attribs));
+}
+
+TEST(GraphicsAccessories_ImageResampling, ConstantImage)
+{
+    // Filter weights are normalized, so a constant image must remain constant for all filters and formats
+    constexpr Uint32 SrcWidth  = 37;
+    constexpr Uint32 SrcHeight = 21;
+
+    constexpr TEXTURE_FORMAT Formats[] = {
+        TEX_FORMAT_RGBA8_UNORM,
+        TEX_FORMAT_RGBA8_UNORM_SRGB,
+        TEX_FORMAT_RGBA8_SNORM,
+        TEX_FORMAT_R8_UNORM,
+        TEX_FORMAT_RG16_UNORM,
+        TEX_FORMAT_RGBA16_FLOAT,
+        TEX_FORMAT_RGB32_FLOAT,
+        TEX_FORMAT_R16_SINT,
+        TEX_FORMAT_R32_UINT,
+        TEX_FORMAT_D16_UNORM,
+    };
+
+    for (auto Format : Formats)
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+        const auto  PixelSize  = FmtAttribs.GetElementSize();
+
+        // Use a pixel value that is representable in all formats
+        std::vector<Uint8> Pixel(PixelSize);
+        for (Uint32 c = 0; c < FmtAttribs.NumComponents; ++c)
+        {
+            auto* pComp = &Pixel[c * FmtAttribs.ComponentSize];
+            if (FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT)
+            {
+                if (FmtAttribs.ComponentSize == 2)
+                    *reinterpret_cast<Uint16*>(pComp) = FloatToHalf(0.375f);
+                else
+                    *reinterpret_cast<float*>(pComp) = 0.375f;
+            }
+            else if (FmtAttribs.ComponentSize == 4)
+            {
+                // 32-bit integers are filtered with single precision
+                *reinterpret_cast<Uint32*>(pComp) = 0x6060;
+            }
+            else
+            {
+                // 0x60 or 0x6060
+                memset(pComp, 0x60, FmtAttribs.ComponentSize);
+            }
+        }
+
+        std::vector<Uint8> Src(size_t{SrcWidth} * SrcHeight * PixelSize);
+        for (size_t i = 0; i < Src.size(); i += PixelSize)
+            memcpy(&Src[i], Pixel.data(), PixelSize);
+
+        for (Uint32 Filter = 0; Filter < IMAGE_FILTER_COUNT; ++Filter)
+        {
+            for (auto AddressMode : {TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_MIRROR})
+            {
+                // Minification and magnification
+                for (Uint32 DstWidth : {SrcWidth / 3, SrcWidth * 2})
+                {
+                    const Uint32 DstHeight = DstWidth / 2;
+
+                    std::vector<Uint8> Dst(size_t{DstWidth} * DstHeight * PixelSize);
+
+                    ImageResamplingAttribs Attribs;
+                    Attribs.pSrcData    = Src.data();
+                    Attribs.SrcStride   = SrcWidth * PixelSize;
+                    Attribs.SrcWidth    = SrcWidth;
+                    Attribs.SrcHeight   = SrcHeight;
+                    Attribs.pDstData    = Dst.data();
+                    Attribs.DstStride   = DstWidth * PixelSize;
+                    Attribs.DstWidth    = DstWidth;
+                    Attribs.DstHeight   = DstHeight;
+                    Attribs.Format      = Format;
+                    Attribs.Filter      = static_cast<IMAGE_FILTER_TYPE>(Filter);
+                    Attribs.AddressMode = AddressMode;
+                    ASSERT_TRUE(ResampleImage(Attribs));
+
+                    for (size_t i = 0; i < Dst.size(); i += PixelSize)
+                    {
+                        if (FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT && FmtAttribs.ComponentSize == 4)
+                        {
+                            // Normalized weights do not sum exactly to one
+                            for (Uint32 c = 0; c < FmtAttribs.NumComponents; ++c)
+                                ASSERT_NEAR(reinterpret_cast<const float*>(&Dst[i])[c], 0.375f, 1e-6f);
+                        }
+                        else
+                        {
+                            ASSERT_EQ(memcmp(&Dst[i], Pixel.data(), PixelSize), 0)
+                                << FmtAttribs.Name << ", filter " << Filter << ", address mode " << Uint32{AddressMode} << ", pixel " << i / PixelSize;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(GraphicsAccessories_ImageResampling, SRGB)
+{
+    // Checkerboard of black and white pixels must be averaged to 50% gray in linear space
+    const Uint8 Src[] = {
+        0, 0, 0, 255, /**/ 255, 255, 255, 255, //
+        255, 255, 255, 255, /**/ 0, 0, 0, 255  //
+    };
+
+    const auto Resample = [&](TEXTURE_FORMAT Format, IMAGE_RESAMPLING_FLAGS Flags) {
+        Uint8                  Dst[4] = {};
+        ImageResamplingAttribs Attribs;
+        Attribs.pSrcData  = Src;
+        Attribs.SrcStride = 8;
+        Attribs.SrcWidth  = 2;
+        Attribs.SrcHeight = 2;
+        Attribs.pDstData  = Dst;
+        Attribs.DstStride = 4;
+        Attribs.DstWidth  = 1;
+        Attribs.DstHeight = 1;
+        Attribs.Format    = Format;
+        Attribs.Flags     = Flags;
+        EXPECT_TRUE(ResampleImage(Attribs));
+        return Dst[0];
+    };
+
+    const auto SRGBGray = static_cast<Uint8>(LinearToSRGB(0.5f) * 255.f + 0.5f);
+    EXPECT_EQ(Resample(TEX_FORMAT_RGBA8_UNORM_SRGB, IMAGE_RESAMPLING_FLAG_NONE), SRGBGray);
+    EXPECT_EQ(Resample(TEX_FORMAT_RGBA8_UNORM, IMAGE_RESAMPLING_FLAG_SRGB), SRGBGray);
+    EXPECT_EQ(Resample(TEX_FORMAT_RGBA8_UNORM, IMAGE_RESAMPLING_FLAG_NONE), 128);
+
+    // sRGB encoding must match the scalar reference
+    for (Uint32 i = 0; i < 256; ++i)
+    {
+        const Uint8 SrcPixel[] = {static_cast<Uint8>(i), static_cast<Uint8>(i), static_cast<Uint8>(i), 255};
+        Uint8       DstPixel[] = {0, 0, 0, 0};
+
+        ImageResamplingAttribs Attribs;
+        Attribs.pSrcData  = SrcPixel;
+        Attribs.SrcStride = 4;
+        Attribs.SrcWidth  = 1;
+        Attribs.SrcHeight = 1;
+        Attribs.pDstData  = DstPixel;
+        Attribs.DstStride = 4;
+        Attribs.DstWidth  = 1;
+        Attribs.DstHeight = 1;
+        Attribs.Format    = TEX_FORMAT_RGBA8_UNORM_SRGB;
+        EXPECT_TRUE(ResampleImage(Attribs));
+        EXPECT_EQ(DstPixel[0], i);
+    }
+}
+
+TEST(GraphicsAccessories_ImageResampling, PremultipliedAlpha)
+{
+    // Opaque red and transparent green
+    const Uint8 Src[] = {
+        255, 0, 0, 255, /**/ 0, 255, 0, 0 //
+    };
+
+    const auto Resample = [&](IMAGE_RESAMPLING_FLAGS Flags) {
+        std::array<Uint8, 4>   Dst = {};
+        ImageResamplingAttribs Attribs;
+        Attribs.pSrcData  = Src;
+        Attribs.SrcStride = 8;
+        Attribs.SrcWidth  = 2;
+        Attribs.SrcHeight = 1;
+        Attribs.pDstData  = Dst.data();
+        Attribs.DstStride = 4;
+        Attribs.DstWidth  = 1;
+        Attribs.DstHeight = 1;
+        Attribs.Format    = TEX_FORMAT_RGBA8_UNORM;
+        Attribs.Flags     = Flags;
+        EXPECT_TRUE(ResampleImage(Attribs));
+        return Dst;
+    };
+
+    EXPECT_EQ(Resample(IMAGE_RESAMPLING_FLAG_NONE), (std::array<Uint8, 4>{128, 128, 0, 128}));
+    EXPECT_EQ(Resample(IMAGE_RESAMPLING_FLAG_PREMULTIPLY_ALPHA), (std::array<Uint8, 4>{255, 0, 0, 128}));
+}
+
+TEST(GraphicsAccessories_ImageResampling, Multithreaded)
+{
+    constexpr Uint32 SrcWidth  = 731;
+    constexpr Uint32 SrcHeight = 1023;
+    constexpr Uint32 DstWidth  = 320;
+    constexpr Uint32 DstHeight = 450;
+
+    const auto Src = GenerateRandomImage(SrcWidth, SrcHeight, 4, 1);
+
+    for (Uint32 Filter = 0; Filter < IMAGE_FILTER_COUNT; ++Filter)
+    {
+        std::vector<Uint8> Dst[2];
+        for (Uint32 i = 0; i < 2; ++i)
+        {
+            Dst[i].resize(size_t{DstWidth} * DstHeight * 4);
+
+            ImageResamplingAttribs Attribs;
+            Attribs.pSrcData    = Src.data();
+            Attribs.SrcStride   = SrcWidth * 4;
+            Attribs.SrcWidth    = SrcWidth;
+            Attribs.SrcHeight   = SrcHeight;
+            Attribs.pDstData    = Dst[i].data();
+            Attribs.DstStride   = DstWidth * 4;
+            Attribs.DstWidth    = DstWidth;
+            Attribs.DstHeight   = DstHeight;
+            Attribs.Format      = TEX_FORMAT_RGBA8_UNORM_SRGB;
+            Attribs.Filter      = static_cast<IMAGE_FILTER_TYPE>(Filter);
+            Attribs.AddressMode = TEXTURE_ADDRESS_WRAP;
+            Attribs.Flags       = IMAGE_RESAMPLING_FLAG_PREMULTIPLY_ALPHA;
+            Attribs.MaxThreads  = i == 0 ? 1 : 8;
+            ASSERT_TRUE(ResampleImage(Attribs));
+        }
+        EXPECT_EQ(Dst[0], Dst[1]) << "Filter " << Filter;
+    }
+}
+
+} // namespace
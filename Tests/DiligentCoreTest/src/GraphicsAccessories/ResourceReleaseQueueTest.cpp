@@ -26,9 +26,13 @@
  */
 
 #include <memory>
+#include <thread>
+#include <vector>
+#include <atomic>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "Timer.hpp"
 
 #include "gtest/gtest.h"
 
@@ -128,4 +132,142 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+struct CountedResource
+{
+    explicit CountedResource(std::atomic<int>* _pCounter) :
+        pCounter{_pCounter}
+    {
+        pCounter->fetch_add(1);
+    }
+
+    CountedResource(CountedResource&& rhs) noexcept :
+        pCounter{rhs.pCounter}
+    {
+        rhs.pCounter = nullptr;
+    }
+
+    // clang-format off
+    CountedResource           (const CountedResource&) = delete;
+    CountedResource& operator=(const CountedResource&) = delete;
+    CountedResource& operator=(CountedResource&&)      = delete;
+    // clang-format on
+
+    ~CountedResource()
+    {
+        if (pCounter != nullptr)
+            pCounter->fetch_sub(1);
+    }
+
+    std::atomic<int>* pCounter;
+};
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, ReleaseOrder)
+{
+    std::atomic<int> NumAlive{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    Queue.SafeReleaseResource(CountedResource{&NumAlive}, 2);
+    Queue.SafeReleaseResource(CountedResource{&NumAlive}, 1);
+    Queue.DiscardResource(CountedResource{&NumAlive}, 5);
+    EXPECT_EQ(NumAlive, 3);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 2u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 1u);
+
+    // Only the resource released before command list 1 must be moved to the release queue
+    Queue.DiscardStaleResources(1, 3);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 1u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 2u);
+
+    Queue.DiscardStaleResources(2, 4);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 0u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 3u);
+
+    Queue.Purge(2);
+    EXPECT_EQ(NumAlive, 3);
+
+    Queue.Purge(4);
+    EXPECT_EQ(NumAlive, 1);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 1u);
+
+    Queue.Purge(5);
+    EXPECT_EQ(NumAlive, 0);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+
+    // Shared wrapper must only be destroyed when the last reference is released
+    auto Wrapper = ResourceReleaseQueue<DynamicStaleResourceWrapper>::CreateWrapper(CountedResource{&NumAlive}, 2);
+    Queue.DiscardResource(Wrapper, 1);
+    Queue.DiscardResource(std::move(Wrapper), 2);
+    Queue.Purge(1);
+    EXPECT_EQ(NumAlive, 1);
+    Queue.Purge(2);
+    EXPECT_EQ(NumAlive, 0);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, MultithreadedRelease)
+{
+    constexpr Uint32 NumIterations = 16;
+    constexpr Uint32 NumResources  = 4096;
+
+    auto NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::atomic<int> NumAlive{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    double TotalTime = 0;
+    for (Uint32 Iter = 0; Iter < NumIterations; ++Iter)
+    {
+        const Uint64 CmdListNumber = Iter;
+
+        Timer                    T;
+        std::vector<std::thread> Threads;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back(
+                [&Queue, &NumAlive, CmdListNumber, t]() //
+                {
+                    for (Uint32 r = 0; r < NumResources; ++r)
+                    {
+                        if ((r + t) % 4 == 0)
+                            Queue.DiscardResource(CountedResource{&NumAlive}, CmdListNumber);
+                        else
+                            Queue.SafeReleaseResource(CountedResource{&NumAlive}, CmdListNumber);
+                    }
+                });
+        }
+
+        // Submit and purge concurrently with the worker threads.
+        // The counters must never wrap around while resources are being merged.
+        const size_t MaxCount = size_t{NumThreads} * NumResources * (Iter + 1);
+        for (Uint32 i = 0; i < 64; ++i)
+        {
+            if (CmdListNumber > 0)
+            {
+                Queue.DiscardStaleResources(CmdListNumber - 1, CmdListNumber - 1);
+                Queue.Purge(CmdListNumber - 1);
+            }
+            EXPECT_LE(Queue.GetStaleResourceCount(), MaxCount);
+            EXPECT_LE(Queue.GetPendingReleaseResourceCount(), MaxCount);
+            std::this_thread::yield();
+        }
+
+        for (auto& Thread : Threads)
+            Thread.join();
+        TotalTime += T.GetElapsedTime();
+
+        Queue.DiscardStaleResources(CmdListNumber, CmdListNumber);
+        EXPECT_EQ(Queue.GetStaleResourceCount(), 0u);
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), static_cast<size_t>(NumAlive.load()));
+    }
+
+    Queue.Purge(NumIterations);
+    EXPECT_EQ(NumAlive, 0);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+
+    const auto NumReleased = double{NumIterations} * NumResources * NumThreads;
+    LOG_INFO_MESSAGE("Released ", NumReleased, " resources on ", NumThreads, " threads in ", TotalTime * 1000.0,
+                     " ms (", NumReleased / TotalTime * 1e-6, " M/s)");
+}
+
 } // namespace
@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ResourceMappingImpl.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "HashUtils.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class TestDeviceObject final : public ObjectBase<IDeviceObject>
+{
+public:
+    using TBase = ObjectBase<IDeviceObject>;
+
+    TestDeviceObject(IReferenceCounters* pRefCounters, Int32 UniqueID) :
+        TBase{pRefCounters},
+        m_UniqueID{UniqueID}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceObject, TBase)
+
+    virtual const DeviceObjectAttribs& DILIGENT_CALL_TYPE GetDesc() const override final { return m_Desc; }
+
+    virtual Int32 DILIGENT_CALL_TYPE GetUniqueID() const override final { return m_UniqueID; }
+
+private:
+    DeviceObjectAttribs m_Desc;
+    const Int32         m_UniqueID;
+};
+
+RefCntAutoPtr<IDeviceObject> CreateObject(Int32 UniqueID)
+{
+    return RefCntAutoPtr<IDeviceObject>{MakeNewRCObj<TestDeviceObject>()(UniqueID)};
+}
+
+TEST(GraphicsEngine_ResourceMapping, GetResources)
+{
+    RefCntAutoPtr<ResourceMappingImpl> pMapping{MakeNewRCObj<ResourceMappingImpl>()(DefaultRawMemoryAllocator::GetAllocator())};
+
+    auto pTex = CreateObject(1);
+    auto pBuf = CreateObject(2);
+    pMapping->AddResource("g_Texture", pTex, false);
+    pMapping->AddResource("g_Buffer", pBuf, false);
+
+    RefCntAutoPtr<IDeviceObject> pArrayElems[]  = {CreateObject(10), CreateObject(11), CreateObject(12)};
+    IDeviceObject*               ppArrayElems[] = {pArrayElems[0], pArrayElems[1], pArrayElems[2]};
+    pMapping->AddResourceArray("g_Array", 0, ppArrayElems, _countof(ppArrayElems), false);
+
+    ResourceMappingLookupInfo LookupInfo[7];
+    LookupInfo[0].Name       = "g_Texture";
+    LookupInfo[1].Name       = "g_Missing";
+    LookupInfo[2].Name       = "g_Buffer";
+    LookupInfo[2].NameHash   = CStringHash<Char>{}("g_Buffer");
+    LookupInfo[3].Name       = "g_Array";
+    LookupInfo[3].ArrayIndex = 2;
+    LookupInfo[4].Name       = "g_Array";
+    LookupInfo[4].ArrayIndex = 3; // Out of range
+    LookupInfo[5].Name       = "g_Texture";
+    LookupInfo[5].ArrayIndex = 1; // Not an array
+    LookupInfo[6].Name       = "";
+
+    IDeviceObject* ppObjects[_countof(LookupInfo)] = {};
+    pMapping->GetResources(_countof(LookupInfo), LookupInfo, ppObjects);
+
+    EXPECT_EQ(ppObjects[0], pTex.RawPtr());
+    EXPECT_EQ(ppObjects[1], nullptr);
+    EXPECT_EQ(ppObjects[2], pBuf.RawPtr());
+    EXPECT_EQ(ppObjects[3], pArrayElems[2].RawPtr());
+    EXPECT_EQ(ppObjects[4], nullptr);
+    EXPECT_EQ(ppObjects[5], nullptr);
+    EXPECT_EQ(ppObjects[6], nullptr);
+
+    // The results must match GetResource()
+    for (size_t i = 0; i < _countof(LookupInfo); ++i)
+    {
+        if (*LookupInfo[i].Name == 0)
+            continue;
+
+        RefCntAutoPtr<IDeviceObject> pObject;
+        pMapping->GetResource(LookupInfo[i].Name, &pObject, LookupInfo[i].ArrayIndex);
+        EXPECT_EQ(pObject.RawPtr(), ppObjects[i]) << "Lookup " << i;
+    }
+
+    // Every returned object is referenced
+    for (auto* pObject : ppObjects)
+    {
+        if (pObject != nullptr)
+        {
+            EXPECT_GE(pObject->Release(), 1);
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,355 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <string>
+
+#include "GLCommandStream.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Allocator that counts the chunks requested by the command stream
+class ChunkAllocatorMock final : public IMemoryAllocator
+{
+public:
+    ~ChunkAllocatorMock()
+    {
+        EXPECT_EQ(NumAllocations, NumFrees);
+    }
+
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final
+    {
+        EXPECT_EQ(Size, GLCommandStream::ChunkSize);
+        ++NumAllocations;
+        return DefaultRawMemoryAllocator::GetAllocator().Allocate(Size, dbgDescription, dbgFileName, dbgLineNumber);
+    }
+
+    virtual void Free(void* Ptr) override final
+    {
+        ++NumFrees;
+        DefaultRawMemoryAllocator::GetAllocator().Free(Ptr);
+    }
+
+    Uint32 GetNumLiveChunks() const { return NumAllocations - NumFrees; }
+
+    Uint32 NumAllocations = 0;
+    Uint32 NumFrees       = 0;
+};
+
+class TestObject final : public ObjectBase<IObject>
+{
+public:
+    using TBase = ObjectBase<IObject>;
+
+    TestObject(IReferenceCounters* pRefCounters) :
+        TBase{pRefCounters}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Unknown, TBase)
+};
+
+// Records the commands processed by the stream
+struct CommandRecorder
+{
+    std::vector<GLCommandType> Types;
+    std::vector<Uint32>        DrawVertices;
+    std::vector<Viewport>      Viewports;
+    std::vector<std::string>   Labels;
+    std::vector<Uint8>         BufferData;
+
+    // Command types are passed by value to avoid odr-using the static members
+    void AddType(GLCommandType Type)
+    {
+        Types.push_back(Type);
+    }
+
+    void operator()(const GLCommands::Draw& Cmd)
+    {
+        AddType(Cmd.Type);
+        DrawVertices.push_back(Cmd.Attribs.NumVertices);
+    }
+
+    void operator()(const GLCommands::SetViewports& Cmd)
+    {
+        AddType(Cmd.Type);
+        Viewports.insert(Viewports.end(), Cmd.pViewports, Cmd.pViewports + Cmd.NumViewports);
+        EXPECT_EQ(Cmd.RTWidth, 640u);
+        EXPECT_EQ(Cmd.RTHeight, 480u);
+    }
+
+    void operator()(const GLCommands::BeginDebugGroup& Cmd)
+    {
+        AddType(Cmd.Type);
+        Labels.emplace_back(Cmd.Name);
+        EXPECT_EQ(Cmd.pColor, nullptr);
+    }
+
+    void operator()(const GLCommands::UpdateBuffer& Cmd)
+    {
+        AddType(Cmd.Type);
+        const auto* pData = static_cast<const Uint8*>(Cmd.pData);
+        BufferData.insert(BufferData.end(), pData, pData + Cmd.Size);
+        EXPECT_EQ(Cmd.Offset, 16u);
+        EXPECT_EQ(Cmd.Mode, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    }
+
+    template <typename CommandType>
+    void operator()(const CommandType& Cmd)
+    {
+        AddType(Cmd.Type);
+    }
+};
+
+TEST(GraphicsEngineOpenGL_GLCommandStream, EmptyStream)
+{
+    ChunkAllocatorMock Allocator;
+    {
+        GLCommandStream Stream{Allocator};
+        EXPECT_TRUE(Stream.IsEmpty());
+        EXPECT_EQ(Stream.GetNumCommands(), 0u);
+
+        CommandRecorder Recorder;
+        Stream.ProcessCommands(Recorder);
+        EXPECT_TRUE(Recorder.Types.empty());
+
+        EXPECT_EQ(Stream.CopyArray<Uint32>(nullptr, 4), nullptr);
+        Stream.Clear();
+    }
+    EXPECT_EQ(Allocator.NumAllocations, 0u);
+}
+
+TEST(GraphicsEngineOpenGL_GLCommandStream, PacketRoundTrip)
+{
+    ChunkAllocatorMock Allocator;
+
+    GLCommandStream Stream{Allocator};
+
+    const Viewport Viewports[] = {Viewport{0, 0, 320, 240}, Viewport{320, 240, 320, 240}};
+    {
+        auto& Cmd        = Stream.AddCommand<GLCommands::SetViewports>();
+        Cmd.NumViewports = _countof(Viewports);
+        Cmd.pViewports   = Stream.CopyArray(Viewports, _countof(Viewports));
+        Cmd.RTWidth      = 640;
+        Cmd.RTHeight     = 480;
+        EXPECT_NE(Cmd.pViewports, Viewports);
+    }
+
+    std::string Label = "Debug group";
+    {
+        auto& Cmd  = Stream.AddCommand<GLCommands::BeginDebugGroup>();
+        Cmd.Name   = Stream.CopyString(Label.c_str());
+        Cmd.pColor = nullptr;
+    }
+    // The stream must own a copy of the string
+    Label[0] = 'X';
+
+    Stream.AddCommand<GLCommands::Draw>().Attribs.NumVertices = 3;
+    Stream.AddCommand<GLCommands::EndDebugGroup>();
+
+    std::vector<Uint8> Data(100);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 7);
+    {
+        auto& Cmd   = Stream.AddCommand<GLCommands::UpdateBuffer>();
+        Cmd.Offset  = 16;
+        Cmd.Size    = static_cast<Uint32>(Data.size());
+        Cmd.pData   = Stream.CopyArray(Data.data(), Data.size());
+        Cmd.Mode    = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+        Cmd.pBuffer = nullptr;
+    }
+    const auto RecordedData = Data;
+    Data.assign(Data.size(), 0);
+
+    Stream.AddCommand<GLCommands::Draw>().Attribs.NumVertices = 6;
+
+    EXPECT_FALSE(Stream.IsEmpty());
+    EXPECT_EQ(Stream.GetNumCommands(), 6u);
+
+    CommandRecorder Recorder;
+    Stream.ProcessCommands(Recorder);
+
+    const std::vector<GLCommandType> ExpectedTypes = {
+        GLCommandType::SetViewports,
+        GLCommandType::BeginDebugGroup,
+        GLCommandType::Draw,
+        GLCommandType::EndDebugGroup,
+        GLCommandType::UpdateBuffer,
+        GLCommandType::Draw,
+    };
+    EXPECT_EQ(Recorder.Types, ExpectedTypes);
+    EXPECT_EQ(Recorder.DrawVertices, (std::vector<Uint32>{3, 6}));
+    ASSERT_EQ(Recorder.Viewports.size(), 2u);
+    EXPECT_EQ(Recorder.Viewports[0], Viewports[0]);
+    EXPECT_EQ(Recorder.Viewports[1], Viewports[1]);
+    EXPECT_EQ(Recorder.Labels, (std::vector<std::string>{"Debug group"}));
+    EXPECT_EQ(Recorder.BufferData, RecordedData);
+
+    // Commands can be processed multiple times
+    CommandRecorder Recorder2;
+    Stream.ProcessCommands(Recorder2);
+    EXPECT_EQ(Recorder2.Types, ExpectedTypes);
+
+    Stream.Clear();
+    EXPECT_TRUE(Stream.IsEmpty());
+    EXPECT_EQ(Allocator.GetNumLiveChunks(), 0u);
+
+    CommandRecorder Recorder3;
+    Stream.ProcessCommands(Recorder3);
+    EXPECT_TRUE(Recorder3.Types.empty());
+}
+
+TEST(GraphicsEngineOpenGL_GLCommandStream, ChunkRollover)
+{
+    ChunkAllocatorMock Allocator;
+    {
+        GLCommandStream Stream{Allocator};
+
+        // Enough commands to fill several chunks
+        constexpr Uint32 NumDraws = GLCommandStream::ChunkSize / sizeof(DrawAttribs) * 3;
+        for (Uint32 i = 0; i < NumDraws; ++i)
+        {
+            Stream.AddCommand<GLCommands::Draw>().Attribs.NumVertices = i;
+
+            // Data arena rolls over at different points than the command arena
+            auto&          Cmd = Stream.AddCommand<GLCommands::SetViewports>();
+            const Viewport VP{static_cast<float>(i), 0, 1, 1};
+            Cmd.NumViewports = 1;
+            Cmd.pViewports   = Stream.CopyArray(&VP, 1);
+            Cmd.RTWidth      = 640;
+            Cmd.RTHeight     = 480;
+        }
+        EXPECT_EQ(Stream.GetNumCommands(), NumDraws * 2);
+        EXPECT_GT(Allocator.GetNumLiveChunks(), 4u);
+
+        // Data that does not fit into a chunk goes to a dedicated allocation
+        const auto LiveChunks = Allocator.GetNumLiveChunks();
+
+        std::vector<Uint8> LargeData(GLCommandStream::ChunkSize * 2 + 3);
+        for (size_t i = 0; i < LargeData.size(); ++i)
+            LargeData[i] = static_cast<Uint8>(i % 251);
+        {
+            auto& Cmd   = Stream.AddCommand<GLCommands::UpdateBuffer>();
+            Cmd.Offset  = 16;
+            Cmd.Size    = static_cast<Uint32>(LargeData.size());
+            Cmd.pData   = Stream.CopyArray(LargeData.data(), LargeData.size());
+            Cmd.Mode    = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+            Cmd.pBuffer = nullptr;
+        }
+        // Regular chunks are still used after the large one
+        Stream.AddCommand<GLCommands::Draw>().Attribs.NumVertices = NumDraws;
+        EXPECT_LE(Allocator.GetNumLiveChunks(), LiveChunks + 1);
+
+        CommandRecorder Recorder;
+        Stream.ProcessCommands(Recorder);
+
+        ASSERT_EQ(Recorder.Types.size(), size_t{NumDraws} * 2 + 2);
+        ASSERT_EQ(Recorder.DrawVertices.size(), size_t{NumDraws} + 1);
+        ASSERT_EQ(Recorder.Viewports.size(), size_t{NumDraws});
+        for (Uint32 i = 0; i < NumDraws; ++i)
+        {
+            EXPECT_EQ(Recorder.Types[i * 2], GLCommandType::Draw);
+            EXPECT_EQ(Recorder.Types[i * 2 + 1], GLCommandType::SetViewports);
+            EXPECT_EQ(Recorder.DrawVertices[i], i);
+            EXPECT_EQ(Recorder.Viewports[i].TopLeftX, static_cast<float>(i));
+        }
+        EXPECT_EQ(Recorder.Types[NumDraws * 2], GLCommandType::UpdateBuffer);
+        EXPECT_EQ(Recorder.DrawVertices.back(), NumDraws);
+        EXPECT_EQ(Recorder.BufferData, LargeData);
+
+        Stream.Clear();
+        EXPECT_EQ(Allocator.GetNumLiveChunks(), 0u);
+
+        // The stream can be reused after it has been cleared
+        Stream.AddCommand<GLCommands::Draw>().Attribs.NumVertices = 1;
+        EXPECT_EQ(Stream.GetNumCommands(), 1u);
+        EXPECT_EQ(Allocator.GetNumLiveChunks(), 1u);
+    }
+    // The destructor must return all chunks
+    EXPECT_EQ(Allocator.GetNumLiveChunks(), 0u);
+}
+
+TEST(GraphicsEngineOpenGL_GLCommandStream, ObjectReferences)
+{
+    ChunkAllocatorMock Allocator;
+
+    RefCntAutoPtr<IObject> pObj0{MakeNewRCObj<TestObject>()()};
+    RefCntAutoPtr<IObject> pObj1{MakeNewRCObj<TestObject>()()};
+
+    auto GetNumRefs = [](IObject* pObj) {
+        return pObj->GetReferenceCounters()->GetNumStrongRefs();
+    };
+
+    {
+        GLCommandStream Stream{Allocator};
+        EXPECT_EQ(Stream.RetainObject<IObject>(nullptr), nullptr);
+
+        // Enough references to spill over several chunks
+        constexpr size_t NumRefs = GLCommandStream::ChunkSize / sizeof(IObject*) * 2;
+        for (size_t i = 0; i < NumRefs; ++i)
+            EXPECT_EQ(Stream.RetainObject(pObj0.RawPtr()), pObj0.RawPtr());
+        Stream.RetainObject(pObj1.RawPtr());
+        EXPECT_EQ(GetNumRefs(pObj0), static_cast<long>(NumRefs + 1));
+        EXPECT_EQ(GetNumRefs(pObj1), 2);
+
+        Stream.Clear();
+        EXPECT_EQ(GetNumRefs(pObj0), 1);
+        EXPECT_EQ(GetNumRefs(pObj1), 1);
+
+        // Objects retained by the stream must be released when the stream is destroyed
+        Stream.RetainObject(pObj0.RawPtr());
+        Stream.RetainObject(pObj1.RawPtr());
+
+        // Moving the stream transfers the references
+        GLCommandStream Stream2{std::move(Stream)};
+        EXPECT_EQ(GetNumRefs(pObj0), 2);
+        Stream.Clear();
+        EXPECT_EQ(GetNumRefs(pObj0), 2);
+        EXPECT_EQ(GetNumRefs(pObj1), 2);
+    }
+    EXPECT_EQ(GetNumRefs(pObj0), 1);
+    EXPECT_EQ(GetNumRefs(pObj1), 1);
+
+    // The objects must be destroyed when the last reference is released
+    RefCntWeakPtr<IObject> pWeakObj{pObj0};
+    {
+        GLCommandStream Stream{Allocator};
+        Stream.RetainObject(pObj0.RawPtr());
+        pObj0.Release();
+        EXPECT_TRUE(pWeakObj.IsValid());
+    }
+    EXPECT_FALSE(pWeakObj.IsValid());
+}
+
+} // namespace
@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <utility>
+
+#include "GLMultiBind.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using BindRanges = std::vector<std::pair<Uint32, Uint32>>;
+
+BindRanges GetBindRanges(Uint32 First, const std::vector<MultiBindSlotState>& States)
+{
+    const auto Count = static_cast<Uint32>(States.size());
+
+    BindRanges          Ranges;
+    std::vector<Uint32> VisitedSlots;
+    ProcessMultiBindSlots(
+        First, Count,
+        [&](Uint32 Slot) //
+        {
+            VisitedSlots.push_back(Slot);
+            return States[Slot - First];
+        },
+        [&](Uint32 RangeFirst, Uint32 RangeCount) //
+        {
+            EXPECT_GT(RangeCount, 0u);
+            EXPECT_GE(RangeFirst, First);
+            EXPECT_LE(RangeFirst + RangeCount, First + Count);
+            Ranges.emplace_back(RangeFirst, RangeCount);
+        });
+
+    // Every slot must be updated exactly once and in order
+    EXPECT_EQ(VisitedSlots.size(), States.size());
+    for (size_t i = 0; i < VisitedSlots.size(); ++i)
+        EXPECT_EQ(VisitedSlots[i], First + i);
+
+    return Ranges;
+}
+
+constexpr auto S = MultiBindSlotState::Skipped;
+constexpr auto U = MultiBindSlotState::Unchanged;
+constexpr auto M = MultiBindSlotState::Modified;
+
+TEST(GraphicsEngineOpenGL_MultiBind, EmptyRange)
+{
+    EXPECT_TRUE(GetBindRanges(0, {}).empty());
+    EXPECT_TRUE(GetBindRanges(7, {}).empty());
+}
+
+TEST(GraphicsEngineOpenGL_MultiBind, AllModified)
+{
+    EXPECT_EQ(GetBindRanges(0, {M, M, M, M}), (BindRanges{{0, 4}}));
+    EXPECT_EQ(GetBindRanges(3, {M}), (BindRanges{{3, 1}}));
+}
+
+TEST(GraphicsEngineOpenGL_MultiBind, RedundantBindings)
+{
+    // Slots that are already bound must not generate any calls
+    EXPECT_TRUE(GetBindRanges(0, {U, U, U, U}).empty());
+    EXPECT_TRUE(GetBindRanges(2, {U, S, U, S}).empty());
+    EXPECT_TRUE(GetBindRanges(0, {S, S, S}).empty());
+}
+
+TEST(GraphicsEngineOpenGL_MultiBind, UnchangedSlots)
+{
+    // Unchanged slots at the ends of a run are not rebound
+    EXPECT_EQ(GetBindRanges(0, {U, U, M, M, U}), (BindRanges{{2, 2}}));
+    // Unchanged slots between modified slots are rebound to avoid splitting the call
+    EXPECT_EQ(GetBindRanges(0, {M, U, U, M}), (BindRanges{{0, 4}}));
+    EXPECT_EQ(GetBindRanges(4, {U, M, U, U, M, U}), (BindRanges{{5, 4}}));
+}
+
+TEST(GraphicsEngineOpenGL_MultiBind, Gaps)
+{
+    // Skipped slots split the runs
+    EXPECT_EQ(GetBindRanges(0, {M, M, S, M}), (BindRanges{{0, 2}, {3, 1}}));
+    EXPECT_EQ(GetBindRanges(1, {M, S, S, M, U, M, S, U, M}), (BindRanges{{1, 1}, {4, 3}, {9, 1}}));
+    EXPECT_EQ(GetBindRanges(0, {S, M, U, S, U, U, S, M, S}), (BindRanges{{1, 1}, {7, 1}}));
+}
+
+TEST(GraphicsEngineOpenGL_MultiBind, RebindWithRepeats)
+{
+    // Emulate the redundancy tracking of the context state: bind a set of objects with
+    // repeated entries, then bind another set that only differs in a few slots
+    constexpr int Null = 0;
+
+    std::vector<int> BoundObjects;
+
+    auto Bind = [&](Uint32 First, const std::vector<int>& Objects) {
+        if (BoundObjects.size() < First + Objects.size())
+            BoundObjects.resize(First + Objects.size(), -1);
+
+        BindRanges       Ranges;
+        std::vector<int> NewBindings = BoundObjects;
+        ProcessMultiBindSlots(
+            First, static_cast<Uint32>(Objects.size()),
+            [&](Uint32 Slot) //
+            {
+                const auto Obj = Objects[Slot - First];
+                if (Obj == Null)
+                    return MultiBindSlotState::Skipped;
+                if (BoundObjects[Slot] == Obj)
+                    return MultiBindSlotState::Unchanged;
+                BoundObjects[Slot] = Obj;
+                return MultiBindSlotState::Modified;
+            },
+            [&](Uint32 RangeFirst, Uint32 RangeCount) //
+            {
+                Ranges.emplace_back(RangeFirst, RangeCount);
+                for (Uint32 Slot = RangeFirst; Slot < RangeFirst + RangeCount; ++Slot)
+                    NewBindings[Slot] = Objects[Slot - First];
+            });
+        // The bindings issued by the ranges must match the tracked state
+        EXPECT_EQ(NewBindings, BoundObjects);
+        return Ranges;
+    };
+
+    EXPECT_EQ(Bind(0, {1, 2, 1, 1, Null, 3, 3, 2}), (BindRanges{{0, 4}, {5, 3}}));
+    EXPECT_TRUE(Bind(0, {1, 2, 1, 1, Null, 3, 3, 2}).empty());
+    EXPECT_EQ(Bind(0, {1, 2, 4, 1, Null, 3, 3, 5}), (BindRanges{{2, 1}, {7, 1}}));
+    EXPECT_EQ(Bind(0, {1, 4, 4, 4, 1, 3, Null, 5}), (BindRanges{{1, 4}}));
+    EXPECT_EQ(Bind(6, {2, 5, 6}), (BindRanges{{6, 3}}));
+    EXPECT_EQ(Bind(6, {Null, 5, 7}), (BindRanges{{8, 1}}));
+}
+
+} // namespace
@@ -0,0 +1,230 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#ifndef GLEW_STATIC
+#    define GLEW_STATIC // Must be defined to use static version of glew
+#endif
+#ifndef GLEW_NO_GLU
+#    define GLEW_NO_GLU
+#endif
+
+#include "GL/glew.h"
+
+#include "GLProgramBinaryCache.hpp"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const char* const TestDriverId = "GLProgramBinaryCacheTest vendor\nrenderer\n4.6";
+
+GLProgramBinaryCache::ProgramSignature MakeSignature(const char* VSSource, const char* PSSource)
+{
+    GLProgramBinaryCache::ProgramSignature Signature{false};
+    Signature.AddStage(SHADER_TYPE_VERTEX, VSSource);
+    Signature.AddStage(SHADER_TYPE_PIXEL, PSSource);
+    return Signature;
+}
+
+GLProgramBinaryCache::ProgramBinary MakeBinary(GLenum Format, size_t Size, Uint8 Seed)
+{
+    GLProgramBinaryCache::ProgramBinary Binary;
+    Binary.Format = Format;
+    Binary.Data.resize(Size);
+    for (size_t i = 0; i < Size; ++i)
+        Binary.Data[i] = static_cast<Uint8>(Seed + i * 13);
+    return Binary;
+}
+
+std::vector<Uint8> ReadFile(const String& Path)
+{
+    FileWrapper File{Path.c_str(), EFileAccessMode::Read};
+    if (!File)
+        return {};
+    std::vector<Uint8> Data(File->GetSize());
+    File->Read(Data.data(), Data.size());
+    return Data;
+}
+
+void WriteFile(const String& Path, const std::vector<Uint8>& Data)
+{
+    FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+    ASSERT_FALSE(!File) << "Failed to open " << Path;
+    File->Write(Data.data(), Data.size());
+}
+
+class GraphicsEngineOpenGL_ProgramBinaryCache : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        for (const auto& Path : m_Files)
+            FileSystem::DeleteFile(Path.c_str());
+    }
+
+    // Files are written to the working directory and are deleted when the test completes
+    String TrackFile(const String& Path)
+    {
+        m_Files.push_back(Path);
+        FileSystem::DeleteFile(Path.c_str());
+        return Path;
+    }
+
+private:
+    std::vector<String> m_Files;
+};
+
+TEST_F(GraphicsEngineOpenGL_ProgramBinaryCache, StoreAndReload)
+{
+    GLProgramBinaryCache Cache{".", TestDriverId};
+
+    const auto Signature = MakeSignature("void main(){gl_Position = vec4(0.0);}", "void main(){}");
+    const auto FilePath  = TrackFile(Cache.GetFilePath(Signature));
+
+    // Cache miss
+    GLProgramBinaryCache::ProgramBinary Binary;
+    EXPECT_FALSE(Cache.ReadBinary(Signature, Binary));
+
+    const auto RefBinary = MakeBinary(0x8741, 1000, 7);
+    ASSERT_TRUE(Cache.WriteBinary(Signature, RefBinary));
+    EXPECT_TRUE(FileSystem::FileExists(FilePath.c_str()));
+
+    ASSERT_TRUE(Cache.ReadBinary(Signature, Binary));
+    EXPECT_EQ(Binary.Format, RefBinary.Format);
+    EXPECT_EQ(Binary.Data, RefBinary.Data);
+
+    // The binary is found by another cache instance with the same driver
+    {
+        GLProgramBinaryCache Cache2{".", TestDriverId};
+        EXPECT_EQ(Cache2.GetFilePath(Signature), FilePath);
+
+        GLProgramBinaryCache::ProgramBinary Binary2;
+        ASSERT_TRUE(Cache2.ReadBinary(Signature, Binary2));
+        EXPECT_EQ(Binary2.Data, RefBinary.Data);
+    }
+
+    // The binary is overwritten when the program is stored again
+    const auto RefBinary2 = MakeBinary(0x8741, 500, 3);
+    ASSERT_TRUE(Cache.WriteBinary(Signature, RefBinary2));
+    ASSERT_TRUE(Cache.ReadBinary(Signature, Binary));
+    EXPECT_EQ(Binary.Data, RefBinary2.Data);
+}
+
+TEST_F(GraphicsEngineOpenGL_ProgramBinaryCache, Signature)
+{
+    GLProgramBinaryCache Cache{".", TestDriverId};
+
+    // Stage boundaries are part of the signature
+    const auto Signature0 = MakeSignature("ab", "c");
+    const auto Signature1 = MakeSignature("a", "bc");
+    EXPECT_NE(Signature0.GetString(), Signature1.GetString());
+
+    GLProgramBinaryCache::ProgramSignature Signature2{true};
+    Signature2.AddStage(SHADER_TYPE_VERTEX, "ab");
+    GLProgramBinaryCache::ProgramSignature Signature3{false};
+    Signature3.AddStage(SHADER_TYPE_VERTEX, "ab");
+    GLProgramBinaryCache::ProgramSignature Signature4{false};
+    Signature4.AddStage(SHADER_TYPE_PIXEL, "ab");
+    EXPECT_NE(Signature2.GetString(), Signature3.GetString());
+    EXPECT_NE(Signature3.GetString(), Signature4.GetString());
+
+    // File names are deterministic and differ for different programs and drivers
+    GLProgramBinaryCache OtherDriverCache{".", "Other driver"};
+    EXPECT_EQ(Cache.GetFilePath(Signature0), Cache.GetFilePath(MakeSignature("ab", "c")));
+    EXPECT_NE(Cache.GetFilePath(Signature0), Cache.GetFilePath(Signature1));
+    EXPECT_NE(Cache.GetFilePath(Signature0), OtherDriverCache.GetFilePath(Signature0));
+
+    GLProgramBinaryCache SlashCache{"./", TestDriverId};
+    EXPECT_EQ(Cache.GetFilePath(Signature0), SlashCache.GetFilePath(Signature0));
+}
+
+// A file whose name collides with the name of another program must not be loaded
+TEST_F(GraphicsEngineOpenGL_ProgramBinaryCache, Collision)
+{
+    GLProgramBinaryCache Cache{".", TestDriverId};
+
+    const auto Signature0 = MakeSignature("void main(){gl_Position = vec4(1.0);}", "void main(){}");
+    const auto Signature1 = MakeSignature("void main(){gl_Position = vec4(2.0);}", "void main(){}");
+    const auto FilePath0  = TrackFile(Cache.GetFilePath(Signature0));
+    const auto FilePath1  = TrackFile(Cache.GetFilePath(Signature1));
+
+    ASSERT_TRUE(Cache.WriteBinary(Signature0, MakeBinary(0x8741, 100, 1)));
+
+    // Simulate the collision by copying the file of the first program to the file of the second one
+    WriteFile(FilePath1, ReadFile(FilePath0));
+
+    GLProgramBinaryCache::ProgramBinary Binary;
+    EXPECT_FALSE(Cache.ReadBinary(Signature1, Binary));
+    EXPECT_TRUE(Cache.ReadBinary(Signature0, Binary));
+
+    // Binaries written by another driver are not loaded either
+    GLProgramBinaryCache OtherDriverCache{".", "GLProgramBinaryCacheTest vendor\nrenderer\n4.5"};
+    const auto           OtherDriverPath = TrackFile(OtherDriverCache.GetFilePath(Signature0));
+    WriteFile(OtherDriverPath, ReadFile(FilePath0));
+    EXPECT_FALSE(OtherDriverCache.ReadBinary(Signature0, Binary));
+}
+
+TEST_F(GraphicsEngineOpenGL_ProgramBinaryCache, CorruptedFile)
+{
+    GLProgramBinaryCache Cache{".", TestDriverId};
+
+    const auto Signature = MakeSignature("void main(){gl_Position = vec4(3.0);}", "void main(){}");
+    const auto FilePath  = TrackFile(Cache.GetFilePath(Signature));
+
+    ASSERT_TRUE(Cache.WriteBinary(Signature, MakeBinary(0x8741, 100, 5)));
+    const auto FileData = ReadFile(FilePath);
+    ASSERT_FALSE(FileData.empty());
+
+    GLProgramBinaryCache::ProgramBinary Binary;
+
+    // Truncated file
+    WriteFile(FilePath, std::vector<Uint8>{FileData.begin(), FileData.end() - 1});
+    EXPECT_FALSE(Cache.ReadBinary(Signature, Binary));
+
+    // Header only
+    WriteFile(FilePath, std::vector<Uint8>{FileData.begin(), FileData.begin() + 8});
+    EXPECT_FALSE(Cache.ReadBinary(Signature, Binary));
+
+    // Wrong magic
+    auto BadMagic = FileData;
+    BadMagic[0] ^= 0xFF;
+    WriteFile(FilePath, BadMagic);
+    EXPECT_FALSE(Cache.ReadBinary(Signature, Binary));
+
+    // The file is replaced when the program is stored
+    ASSERT_TRUE(Cache.WriteBinary(Signature, MakeBinary(0x8741, 100, 5)));
+    EXPECT_TRUE(Cache.ReadBinary(Signature, Binary));
+}
+
+} // namespace
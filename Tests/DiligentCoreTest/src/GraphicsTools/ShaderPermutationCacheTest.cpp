@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+
+#include "ShaderPermutationCache.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "StringInternTable.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsTools_ShaderPermutationKey, InternString)
+{
+    const Char* Str1 = ShaderPermutationKey::InternString("MACRO");
+    std::string Copy{"MACRO"};
+    const Char* Str2 = ShaderPermutationKey::InternString(Copy.c_str());
+    EXPECT_EQ(Str1, Str2);
+    EXPECT_STREQ(Str1, "MACRO");
+    EXPECT_NE(Str1, ShaderPermutationKey::InternString("MACRO2"));
+}
+
+TEST(GraphicsTools_ShaderPermutationKey, Equality)
+{
+    ShaderPermutationKey Key1;
+    Key1.AddMacro("USE_NORMAL_MAP", true).AddMacro("NUM_LIGHTS", Uint32{4}).AddMacro("SCALE", 2.f);
+
+    // Different order of macros
+    ShaderPermutationKey Key2;
+    std::string          Name{"NUM_LIGHTS"};
+    Key2.AddMacro("SCALE", "2.0").AddMacro(Name.c_str(), "4u").AddMacro("USE_NORMAL_MAP", "1");
+
+    EXPECT_EQ(Key1.GetHash(), Key2.GetHash());
+    EXPECT_EQ(Key1, Key2);
+
+    Key2.AddMacro("USE_NORMAL_MAP", false);
+    EXPECT_EQ(Key2.GetNumMacros(), size_t{3});
+    EXPECT_NE(Key1.GetHash(), Key2.GetHash());
+    EXPECT_NE(Key1, Key2);
+
+    Key2.AddMacro("USE_NORMAL_MAP", true);
+    EXPECT_EQ(Key1, Key2);
+
+    EXPECT_TRUE(Key2.RemoveMacro("SCALE"));
+    EXPECT_FALSE(Key2.RemoveMacro("SCALE"));
+    EXPECT_NE(Key1, Key2);
+    Key2.AddMacro("SCALE", 2.f);
+    EXPECT_EQ(Key1, Key2);
+
+    Key2.Clear();
+    EXPECT_EQ(Key2.GetHash(), Uint64{0});
+    EXPECT_EQ(Key2.GetNumMacros(), size_t{0});
+}
+
+TEST(GraphicsTools_ShaderPermutationKey, MatchesShaderMacroHelper)
+{
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("BOOL_VAL", true);
+    Macros.AddShaderMacro("INT_VAL", -15);
+    Macros.AddShaderMacro("UINT_VAL", Uint32{17});
+    Macros.AddShaderMacro("UINT8_VAL", Uint8{3});
+    Macros.AddShaderMacro("FLOAT_VAL", 0.125f);
+    Macros.AddShaderMacro("FLOAT_INT_VAL", 1024.f);
+
+    ShaderPermutationKey Key;
+    Key.AddMacro("BOOL_VAL", true);
+    Key.AddMacro("INT_VAL", -15);
+    Key.AddMacro("UINT_VAL", Uint32{17});
+    Key.AddMacro("UINT8_VAL", Uint8{3});
+    Key.AddMacro("FLOAT_VAL", 0.125f);
+    Key.AddMacro("FLOAT_INT_VAL", 1024.f);
+
+    std::vector<ShaderMacro> KeyMacros;
+    Key.GetShaderMacros(KeyMacros);
+    ASSERT_EQ(KeyMacros.size(), size_t{7});
+    EXPECT_EQ(KeyMacros.back().Name, nullptr);
+
+    const ShaderMacro* pHelperMacros = Macros;
+    for (const auto* pMacro = pHelperMacros; pMacro->Name != nullptr; ++pMacro)
+    {
+        auto it = std::find_if(KeyMacros.begin(), KeyMacros.end() - 1,
+                               [pMacro](const ShaderMacro& M) { return strcmp(M.Name, pMacro->Name) == 0; });
+        ASSERT_NE(it, KeyMacros.end() - 1) << pMacro->Name;
+        EXPECT_STREQ(it->Definition, pMacro->Definition) << pMacro->Name;
+    }
+}
+
+TEST(GraphicsTools_ShaderPermutationKey, MacroOrder)
+{
+    ShaderPermutationKey Key1;
+    Key1.AddMacro("USE_SHADOWS", true).AddMacro("NUM_LIGHTS", 4).AddMacro("ALPHA_CUTOFF", 0.5f).AddMacro("MAX_BONES", Uint32{64});
+
+    ShaderPermutationKey Key2;
+    Key2.AddMacro("MAX_BONES", Uint32{64}).AddMacro("ALPHA_CUTOFF", 0.5f).AddMacro("USE_SHADOWS", true).AddMacro("NUM_LIGHTS", 4);
+
+    // Macros are emitted sorted by name regardless of the order in which they were added
+    std::vector<ShaderMacro> Macros1, Macros2;
+    Key1.GetShaderMacros(Macros1);
+    Key2.GetShaderMacros(Macros2);
+    ASSERT_EQ(Macros1.size(), size_t{5});
+    ASSERT_EQ(Macros1.size(), Macros2.size());
+    const char* ExpectedNames[] = {"ALPHA_CUTOFF", "MAX_BONES", "NUM_LIGHTS", "USE_SHADOWS"};
+    for (size_t i = 0; i < Macros1.size() - 1; ++i)
+    {
+        EXPECT_STREQ(Macros1[i].Name, ExpectedNames[i]);
+        EXPECT_EQ(Macros1[i].Name, Macros2[i].Name);
+        EXPECT_EQ(Macros1[i].Definition, Macros2[i].Definition);
+    }
+}
+
+TEST(GraphicsTools_ShaderPermutationKey, GenericDefinition)
+{
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("INT64_VAL", Int64{-5000000000ll});
+    Macros.AddShaderMacro("DOUBLE_VAL", 0.25);
+
+    ShaderPermutationKey Key;
+    Key.AddMacro("INT64_VAL", Int64{-5000000000ll});
+    Key.AddMacro("DOUBLE_VAL", 0.25);
+
+    std::vector<ShaderMacro> KeyMacros;
+    Key.GetShaderMacros(KeyMacros);
+    ASSERT_EQ(KeyMacros.size(), size_t{3});
+
+    const ShaderMacro* pHelperMacros = Macros;
+    EXPECT_STREQ(KeyMacros[0].Name, "DOUBLE_VAL");
+    EXPECT_STREQ(KeyMacros[0].Definition, pHelperMacros[1].Definition);
+    EXPECT_STREQ(KeyMacros[1].Name, "INT64_VAL");
+    EXPECT_STREQ(KeyMacros[1].Definition, pHelperMacros[0].Definition);
+}
+
+TEST(GraphicsTools_ShaderPermutationKey, RemoveUnknownMacro)
+{
+    ShaderPermutationKey Key;
+    Key.AddMacro("NUM_LIGHTS", 4);
+
+    // Removing a macro the key does not contain must not intern its name
+    const Char* UnknownName = "GraphicsTools_ShaderPermutationKey_RemoveUnknownMacro";
+    EXPECT_FALSE(Key.RemoveMacro(UnknownName));
+    EXPECT_FALSE(StringInternTable::GetGlobal().Find(UnknownName));
+    EXPECT_EQ(Key.GetNumMacros(), size_t{1});
+}
+
+struct CachedValue
+{
+    int Value = 0;
+
+    explicit operator bool() const { return Value != 0; }
+};
+
+TEST(GraphicsTools_ShaderPermutationCache, GetOrCreate)
+{
+    ShaderPermutationCache<CachedValue> Cache;
+
+    ShaderPermutationKey Key;
+    Key.AddMacro("NUM_LIGHTS", 4);
+    EXPECT_FALSE(Cache.Get(Key));
+
+    int NumCreated = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto Value = Cache.GetOrCreate(Key, [&](const ShaderPermutationKey&, CachedValue& Val) {
+            ++NumCreated;
+            Val.Value = 42;
+        });
+        EXPECT_EQ(Value.Value, 42);
+    }
+    EXPECT_EQ(NumCreated, 1);
+    EXPECT_EQ(Cache.Get(Key).Value, 42);
+    EXPECT_EQ(Cache.GetSize(), size_t{1});
+
+    // Failed creation is not cached
+    ShaderPermutationKey Key2;
+    Key2.AddMacro("NUM_LIGHTS", 8);
+    EXPECT_FALSE(Cache.GetOrCreate(Key2, [](const ShaderPermutationKey&, CachedValue&) {}));
+    EXPECT_EQ(Cache.GetSize(), size_t{1});
+
+    EXPECT_TRUE(Cache.Remove(Key));
+    EXPECT_FALSE(Cache.Remove(Key));
+    EXPECT_EQ(Cache.GetSize(), size_t{0});
+}
+
+TEST(GraphicsTools_ShaderPermutationCache, Multithreaded)
+{
+    ShaderPermutationCache<CachedValue> Cache;
+
+    constexpr int NumThreads      = 4;
+    constexpr int NumPermutations = 64;
+
+    std::atomic<int> NumErrors{0};
+
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&]() {
+            for (int i = 0; i < NumPermutations * 4; ++i)
+            {
+                const int Permutation = i % NumPermutations;
+
+                ShaderPermutationKey Key;
+                Key.AddMacro("PERMUTATION", Permutation).AddMacro("USE_SHADOWS", (Permutation & 1) != 0);
+                auto Value = Cache.GetOrCreate(Key, [Permutation](const ShaderPermutationKey&, CachedValue& Val) {
+                    Val.Value = Permutation + 1;
+                });
+                if (Value.Value != Permutation + 1)
+                    ++NumErrors;
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumErrors, 0);
+    EXPECT_EQ(Cache.GetSize(), size_t{NumPermutations});
+}
+
+} // namespace
@@ -29,16 +29,32 @@
 
 void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
 {
-    struct IPipelineState*            pPSO                       = NULL;
-    struct DrawAttribs                drawAttribs                = {0};
-    struct DrawIndexedAttribs         drawIndexedAttribs         = {0};
-    struct DrawIndirectAttribs        drawIndirectAttribs        = {0};
-    struct DrawIndexedIndirectAttribs drawIndexedIndirectAttribs = {0};
-    struct IBuffer*                   pIndirectBuffer            = NULL;
+    struct IPipelineState*                 pPSO                            = NULL;
+    struct DrawAttribs                     drawAttribs                     = {0};
+    struct DrawIndexedAttribs              drawIndexedAttribs              = {0};
+    struct DrawIndirectAttribs             drawIndirectAttribs             = {0};
+    struct DrawIndexedIndirectAttribs      drawIndexedIndirectAttribs      = {0};
+    struct MultiDrawIndirectAttribs        multiDrawIndirectAttribs        = {0};
+    struct MultiDrawIndexedIndirectAttribs multiDrawIndexedIndirectAttribs = {0};
+    struct IBuffer*                        pIndirectBuffer                 = NULL;
 
     IDeviceContext_SetPipelineState(pCtx, pPSO);
     IDeviceContext_Draw(pCtx, &drawAttribs);
     IDeviceContext_DrawIndexed(pCtx, &drawIndexedAttribs);
     IDeviceContext_DrawIndirect(pCtx, &drawIndirectAttribs, pIndirectBuffer);
     IDeviceContext_DrawIndexedIndirect(pCtx, &drawIndexedIndirectAttribs, pIndirectBuffer);
+    IDeviceContext_MultiDrawIndirect(pCtx, &multiDrawIndirectAttribs, pIndirectBuffer);
+    IDeviceContext_MultiDrawIndexedIndirect(pCtx, &multiDrawIndexedIndirectAttribs, pIndirectBuffer);
+    IDeviceContext_BeginDebugGroup(pCtx, "Group", NULL);
+    IDeviceContext_InsertDebugLabel(pCtx, "Label", NULL);
+    IDeviceContext_EndDebugGroup(pCtx);
+
+    struct DeviceContextStats stats = *IDeviceContext_GetStats(pCtx);
+    (void)stats;
+    IDeviceContext_ResetStats(pCtx);
+
+    struct SubmitDrawPacketsAttribs submitAttribs = {0};
+    IDeviceContext_SetStateFilteringEnabled(pCtx, true);
+    IDeviceContext_SetFrameRetainedBindingsEnabled(pCtx, true);
+    IDeviceContext_SubmitDrawPackets(pCtx, &submitAttribs);
 }
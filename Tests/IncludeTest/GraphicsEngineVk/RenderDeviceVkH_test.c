@@ -47,6 +47,15 @@ void TestRenderDeviceVkCInterface(IRenderDeviceVk* pDevice)
     bool IsSignaled = IRenderDeviceVk_IsFenceSignaled(pDevice, (Uint32)0, (Uint64)0);
     (void)IsSignaled;
 
+    Fence = IRenderDeviceVk_FlushInitialDataUploads(pDevice);
+    Fence = IRenderDeviceVk_GetInitialDataFenceValue(pDevice, (IDeviceObject*)NULL);
+
+    bool Copied = IRenderDeviceVk_CopyTextureOnTransferQueue(pDevice, (CopyTextureAttribs*)NULL);
+    (void)Copied;
+
+    TransferQueueStatsVk Stats;
+    IRenderDeviceVk_GetTransferQueueStats(pDevice, &Stats);
+
     IRenderDeviceVk_CreateTextureFromVulkanImage(pDevice, (VkImage)NULL, (TextureDesc*)NULL, RESOURCE_STATE_SHADER_RESOURCE, (ITexture**)NULL);
     IRenderDeviceVk_CreateBufferFromVulkanResource(pDevice, (VkBuffer)NULL, (BufferDesc*)NULL, RESOURCE_STATE_CONSTANT_BUFFER, (IBuffer**)NULL);
 }